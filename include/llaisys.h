@@ -54,6 +54,8 @@ typedef enum {
 // Runtime Types
 // Stream
 typedef void *llaisysStream_t;
+// Event: a point in a stream's work that other streams or the host can wait for
+typedef void *llaisysEvent_t;
 
 // Memory Copy Directions
 typedef enum {
@@ -0,0 +1,27 @@
+#ifndef LLAISYS_GRAMMAR_H
+#define LLAISYS_GRAMMAR_H
+
+#include "tokenizer.h"
+
+__C {
+    // Output constraint for sampling, compiled against a tokenizer's vocabulary: a byte automaton plus a precomputed
+    // bitset of allowed tokens for each of its states. Pass it in LlaisysQwen2SamplingParams::grammar; the sampler
+    // masks forbidden tokens before top-k/top-p and allows `end_token` only once the output is complete. One grammar
+    // may be shared by any number of concurrent generations.
+    struct LlaisysGrammar;
+
+    // Output matches `pattern` as a whole, a regular expression over UTF-8 text: literals, classes, groups,
+    // alternation and the * + ? {m,n} quantifiers.
+    __export struct LlaisysGrammar *llaisysGrammarCreateRegex(struct LlaisysTokenizer * tokenizer, const char *pattern,
+                                                              int64_t end_token);
+
+    // Output is a JSON value valid under the JSON schema `schema` (a JSON document). "{}" accepts any JSON value.
+    __export struct LlaisysGrammar *llaisysGrammarCreateJsonSchema(struct LlaisysTokenizer * tokenizer,
+                                                                   const char *schema, int64_t end_token);
+
+    __export void llaisysGrammarDestroy(struct LlaisysGrammar * grammar);
+
+    __export size_t llaisysGrammarNumStates(struct LlaisysGrammar * grammar);
+}
+
+#endif // LLAISYS_GRAMMAR_H
@@ -1,6 +1,7 @@
 #ifndef LLAISYS_MODELS_QWEN2_H
 #define LLAISYS_MODELS_QWEN2_H
 
+#include "../grammar.h"
 #include "../tensor.h"
 
 __C {
@@ -27,16 +28,151 @@ __C {
         llaisysTensor_t *mlp_gate_w;
         llaisysTensor_t *mlp_up_w;
         llaisysTensor_t *mlp_down_w;
+        // LoRA slots, NULL until llaisysQwen2ModelEnableLoRA. A is [max_adapters, max_rank, In] and
+        // B is [max_adapters, Out, max_rank] per layer; fold alpha / r into B and zero-pad smaller ranks.
+        llaisysTensor_t *attn_q_lora_a;
+        llaisysTensor_t *attn_q_lora_b;
+        llaisysTensor_t *attn_k_lora_a;
+        llaisysTensor_t *attn_k_lora_b;
+        llaisysTensor_t *attn_v_lora_a;
+        llaisysTensor_t *attn_v_lora_b;
+        llaisysTensor_t *attn_o_lora_a;
+        llaisysTensor_t *attn_o_lora_b;
+        llaisysTensor_t *mlp_gate_lora_a;
+        llaisysTensor_t *mlp_gate_lora_b;
+        llaisysTensor_t *mlp_up_lora_a;
+        llaisysTensor_t *mlp_up_lora_b;
+        llaisysTensor_t *mlp_down_lora_a;
+        llaisysTensor_t *mlp_down_lora_b;
     };
 
+    struct LlaisysQwen2SamplingParams {
+        int top_k;         // <= 0 disables top-k, 1 is greedy
+        float top_p;       // >= 1 disables nucleus sampling
+        float temperature; // <= 0 is greedy
+        uint64_t seed;
+        struct LlaisysGrammar *grammar; // constrains the output when not NULL
+    };
+
+    // Called for every generated token. Return 0 to stop generation.
+    typedef int (*llaisysQwen2TokenCallback)(int64_t token, void *userdata);
+    // Called for every token of an n-way generation. Return 0 to stop that branch.
+    typedef int (*llaisysQwen2BranchTokenCallback)(size_t branch, int64_t token, void *userdata);
+
     struct LlaisysQwen2Model;
 
+    // How a CPU model with several device ids is split across them.
+    typedef enum {
+        LLAISYS_QWEN2_TENSOR_PARALLEL = 0,   // every layer sharded by heads
+        LLAISYS_QWEN2_PIPELINE_PARALLEL = 1, // one contiguous range of layers per id
+    } llaisysQwen2Parallel_t;
+
+    // With more than one CPU device id the model runs tensor-parallel over one worker
+    // process per id, each pinned to the NUMA node of that id.
     __export struct LlaisysQwen2Model *llaisysQwen2ModelCreate(const LlaisysQwen2Meta *meta, llaisysDeviceType_t device, int *device_ids, int ndevice);
 
+    // Like llaisysQwen2ModelCreate, choosing how several device ids are used. With
+    // pipeline parallelism, id i is the NUMA node of stage i.
+    __export struct LlaisysQwen2Model *llaisysQwen2ModelCreateParallel(const LlaisysQwen2Meta *meta, llaisysDeviceType_t device, int *device_ids, int ndevice,
+                                                                       llaisysQwen2Parallel_t parallel);
+
+    // Single-CPU model for checkpoints larger than memory: layer weights live in a scratch file created at
+    // `offload_path` (unlinked right away) and are streamed through memory, `prefetch` layers read ahead of
+    // compute and each dropped once used. Load weights as usual; about prefetch + 1 layers stay resident.
+    __export struct LlaisysQwen2Model *llaisysQwen2ModelCreateOffload(const LlaisysQwen2Meta *meta, const char *offload_path, size_t prefetch);
+
     __export void llaisysQwen2ModelDestroy(struct LlaisysQwen2Model * model);
 
     __export struct LlaisysQwen2Weights *llaisysQwen2ModelWeights(struct LlaisysQwen2Model * model);
 
+    // Append tokens to the model's default sequence and return the argmax next token, or -1 (appending
+    // nothing) if the KV pool is full or the sequence would exceed maxseq.
     __export int64_t llaisysQwen2ModelInfer(struct LlaisysQwen2Model * model, int64_t * token_ids, size_t ntoken);
+
+    // Clear the default sequence used by llaisysQwen2ModelInfer.
+    __export void llaisysQwen2ModelReset(struct LlaisysQwen2Model * model);
+
+    // Explicit sequences over the model's paged KV cache, e.g. for beam search and n-best sampling.
+    // Forked sequences share the parent's KV blocks and copy a block only when writing into it. All sequences
+    // share one KV pool of maxseq tokens unless SetKVCapacity raises it; each one is still bounded by maxseq
+    // unless the cache evicts.
+    __export int64_t llaisysQwen2ModelSeqCreate(struct LlaisysQwen2Model * model);
+    __export int64_t llaisysQwen2ModelSeqFork(struct LlaisysQwen2Model * model, int64_t seq);
+    __export void llaisysQwen2ModelSeqTruncate(struct LlaisysQwen2Model * model, int64_t seq, size_t len);
+    __export void llaisysQwen2ModelSeqFree(struct LlaisysQwen2Model * model, int64_t seq);
+    __export size_t llaisysQwen2ModelSeqLength(struct LlaisysQwen2Model * model, int64_t seq);
+    // Raise the KV pool to hold `ntoken` tokens over all sequences. Blocks are still allocated on demand.
+    __export void llaisysQwen2ModelSetKVCapacity(struct LlaisysQwen2Model * model, size_t ntoken);
+
+    // Move an idle sequence's KV blocks out to host memory (or the spill file) and back, returning its blocks to
+    // the pool meanwhile. A swapped-out sequence keeps its length but must be swapped in before SeqInfer or SeqFork.
+    // Both return 0, leaving the sequence where it is, if the spill file or the pool is too full.
+    __export uint8_t llaisysQwen2ModelSeqSwapOut(struct LlaisysQwen2Model * model, int64_t seq);
+    __export uint8_t llaisysQwen2ModelSeqSwapIn(struct LlaisysQwen2Model * model, int64_t seq);
+    __export uint8_t llaisysQwen2ModelSeqIsSwapped(struct LlaisysQwen2Model * model, int64_t seq);
+    // Spill swapped blocks into a scratch file of up to `capacity` bytes instead of host memory. The file is
+    // unlinked once mapped. Only while no sequence is swapped out.
+    __export void llaisysQwen2ModelSetSpillFile(struct LlaisysQwen2Model * model, const char *path, size_t capacity);
+
+    // Append tokens to `seq` and return the argmax next token. If `logits` is not NULL, the float logits
+    // of the last token (voc entries) are written to it. Returns -1, appending nothing, if the KV pool is
+    // full or the sequence would exceed maxseq; swap out or free other sequences and retry.
+    __export int64_t llaisysQwen2ModelSeqInfer(struct LlaisysQwen2Model * model, int64_t seq, int64_t *token_ids, size_t ntoken, float *logits);
+
+    // Prefill `prompt` and decode up to `max_new_tokens` tokens into `out_tokens`, stopping at end_token.
+    // `params` may be NULL for greedy decoding and `callback` may be NULL. Returns the number of tokens generated.
+    __export size_t llaisysQwen2ModelGenerate(struct LlaisysQwen2Model * model, const int64_t *prompt, size_t nprompt,
+                                              int64_t *out_tokens, size_t max_new_tokens,
+                                              const struct LlaisysQwen2SamplingParams *params,
+                                              llaisysQwen2TokenCallback callback, void *userdata);
+
+    // Streaming generation: Generate runs on a background thread and tokens are handed over through a
+    // lock-free ring, so a slow reader never stalls decoding. The model (and the grammar in `params`) must
+    // not be used or freed until the stream is destroyed.
+    struct LlaisysQwen2Stream;
+
+    __export struct LlaisysQwen2Stream *llaisysQwen2ModelGenerateStream(struct LlaisysQwen2Model * model, const int64_t *prompt, size_t nprompt,
+                                                                        size_t max_new_tokens, const struct LlaisysQwen2SamplingParams *params);
+
+    // Block until tokens are available and copy up to `capacity` of them to `out`. Returns 0 once generation
+    // has finished and every token was read.
+    __export size_t llaisysQwen2StreamRead(struct LlaisysQwen2Stream * stream, int64_t *out, size_t capacity);
+
+    // Why generation failed, or NULL; valid once llaisysQwen2StreamRead has returned 0.
+    __export const char *llaisysQwen2StreamError(struct LlaisysQwen2Stream * stream);
+
+    // Stop generating after the current token.
+    __export void llaisysQwen2StreamCancel(struct LlaisysQwen2Stream * stream);
+
+    // Cancel, wait for the generation thread and free the stream.
+    __export void llaisysQwen2StreamDestroy(struct LlaisysQwen2Stream * stream);
+
+    // Sample `n` completions from a single prefill: the prompt's KV is shared by all branches, which decode as one
+    // batch with independent RNG streams. Branch i writes to out_tokens[i * max_new_tokens ...] and its length to
+    // out_lengths[i]. Speculative decoding is not used. Returns the total number of tokens generated.
+    __export size_t llaisysQwen2ModelGenerateN(struct LlaisysQwen2Model * model, const int64_t *prompt, size_t nprompt,
+                                               size_t n, int64_t *out_tokens, size_t *out_lengths, size_t max_new_tokens,
+                                               const struct LlaisysQwen2SamplingParams *params,
+                                               llaisysQwen2BranchTokenCallback callback, void *userdata);
+
+    // Sliding-window attention for layers >= first_layer: each token attends to the last `window` tokens plus the
+    // first `sink` tokens ("attention sinks"). With first_layer 0 the KV cache evicts what no token can see anymore,
+    // so memory stays constant and sequences may grow past maxseq. window 0 disables. Set it on an empty cache.
+    __export void llaisysQwen2ModelSetSlidingWindow(struct LlaisysQwen2Model * model, size_t window, size_t sink, size_t first_layer);
+
+    // Allocate zeroed LoRA slots for every projection (see LlaisysQwen2Weights), once per model. Adapters are
+    // loaded by writing into slot slices of the weight tensors.
+    __export void llaisysQwen2ModelEnableLoRA(struct LlaisysQwen2Model * model, size_t max_adapters, size_t max_rank);
+
+    // LoRA slot used by Infer, SeqInfer, Generate and GenerateN; -1 selects the base model.
+    __export void llaisysQwen2ModelSetAdapter(struct LlaisysQwen2Model * model, int64_t adapter);
+
+    // Speculative decoding: `draft` proposes `ndraft` tokens per step, verified by `model` in one forward.
+    // The draft must share the vocabulary and outlive its use. Pass NULL to disable.
+    __export void llaisysQwen2ModelSetDraftModel(struct LlaisysQwen2Model * model, struct LlaisysQwen2Model * draft, size_t ndraft);
+
+    // Speculative decoding without a draft model: propose up to `ndraft` tokens that followed the latest earlier
+    // occurrence of the trailing n-gram (n <= max_ngram) in the prompt and generated text. `ndraft` 0 disables.
+    __export void llaisysQwen2ModelSetPromptLookup(struct LlaisysQwen2Model * model, size_t max_ngram, size_t ndraft);
 }
 #endif // LLAISYS_MODELS_QWEN2_H
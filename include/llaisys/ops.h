@@ -4,15 +4,72 @@
 #include "tensor.h"
 
 __C {
+    // Functions of the vectorized float32 math library, for accuracy tests.
+    typedef enum {
+        LLAISYS_VMATH_EXP = 0,
+        LLAISYS_VMATH_SIGMOID = 1,
+        LLAISYS_VMATH_SILU = 2,
+        LLAISYS_VMATH_TANH = 3,
+        LLAISYS_VMATH_RSQRT = 4,
+    } llaisysVMathFunction_t;
+    // Instruction sets of the vectorized math library.
+    typedef enum {
+        LLAISYS_VMATH_SCALAR = 0,
+        LLAISYS_VMATH_AVX2 = 1,
+        LLAISYS_VMATH_AVX512 = 2,
+        LLAISYS_VMATH_AVX512_BF16 = 3,
+        LLAISYS_VMATH_AVX2_VNNI = 4,
+        LLAISYS_VMATH_AVX512_VNNI = 5,
+    } llaisysVMathIsa_t;
+    // Accumulation of linear's dot products: blocked float FMA (fast default),
+    // or compensated double for validation.
+    typedef enum {
+        LLAISYS_LINEAR_ACCUMULATION_F32 = 0,
+        LLAISYS_LINEAR_ACCUMULATION_KAHAN = 1,
+    } llaisysLinearAccumulation_t;
+
     __export void llaisysAdd(llaisysTensor_t c, llaisysTensor_t a, llaisysTensor_t b);
     __export void llaisysArgmax(llaisysTensor_t max_idx, llaisysTensor_t max_val, llaisysTensor_t vals);
     __export void llaisysEmbedding(llaisysTensor_t out, llaisysTensor_t index, llaisysTensor_t weight);
     __export void llaisysLinear(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t weight, llaisysTensor_t bias);
+    // Linear with an explicit accumulation mode instead of the process-wide one.
+    __export void llaisysLinearAccumulate(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t weight, llaisysTensor_t bias,
+                                          llaisysLinearAccumulation_t mode);
+    // Process-wide accumulation mode of linear (and of the models built on it).
+    __export void llaisysSetLinearAccumulation(llaisysLinearAccumulation_t mode);
+    __export llaisysLinearAccumulation_t llaisysGetLinearAccumulation();
+    // Linear plus per-row LoRA deltas: lora_a [nadapter, rank, In], lora_b [nadapter, Out, rank] (scale folded in),
+    // adapter_ids I64 [B] with -1 for rows that use the base weights only.
+    __export void llaisysLinearLoRA(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t weight, llaisysTensor_t bias,
+                                    llaisysTensor_t lora_a, llaisysTensor_t lora_b, llaisysTensor_t adapter_ids);
+    // 2:4 structured sparse linear. values [Out, In / 2] holds the two kept weights of every
+    // aligned group of 4 inputs, indices U8 [Out, In / 8] their 2-bit positions in the group,
+    // four per byte from the low bits up. In must be a multiple of 8; bias may be null.
+    __export void llaisysLinearSparse24(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t values,
+                                        llaisysTensor_t indices, llaisysTensor_t bias);
+    // Compress a dense [Out, In] weight into that layout, keeping the two largest magnitudes per group.
+    __export void llaisysSparse24Compress(llaisysTensor_t values, llaisysTensor_t indices, llaisysTensor_t weight);
+    // W8A8 linear: qweight I8 [Out, In] and scales F32 [Out] from llaisysW8A8Quantize; each row of in is
+    // quantized to int8 per token, multiplied in int32 and rescaled in float. bias may be null.
+    __export void llaisysLinearW8A8(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t qweight,
+                                    llaisysTensor_t scales, llaisysTensor_t bias);
+    // Symmetric per-output-channel int8 quantization of a dense [Out, In] weight.
+    __export void llaisysW8A8Quantize(llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t weight);
     __export void llaisysRearrange(llaisysTensor_t out, llaisysTensor_t in);
     __export void llaisysRmsNorm(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t weight, float eps);
     __export void llaisysROPE(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t pos_ids, float theta);
     __export void llaisysSelfAttention(llaisysTensor_t attn_val, llaisysTensor_t q, llaisysTensor_t k, llaisysTensor_t v, float scale);
+    __export void llaisysSelfAttentionWindowed(llaisysTensor_t attn_val, llaisysTensor_t q, llaisysTensor_t k, llaisysTensor_t v, float scale, size_t window, size_t sink);
+    // Tree attention: parents I64 [qlen] holds each query's parent query (-1 for a root).
+    // The K/V rows before the queries' own are a prefix every query sees.
+    __export void llaisysSelfAttentionTree(llaisysTensor_t attn_val, llaisysTensor_t q, llaisysTensor_t k, llaisysTensor_t v,
+                                           llaisysTensor_t parents, float scale);
+    // pos_ids I64 [qlen] for a tree: start for roots, one past the parent otherwise.
+    __export void llaisysTreePositionIds(llaisysTensor_t pos_ids, llaisysTensor_t parents, int64_t start);
     __export void llaisysSwiGLU(llaisysTensor_t out, llaisysTensor_t gate, llaisysTensor_t up);
+    // out = fn(in) elementwise on contiguous CPU F32 tensors, through the given instruction set.
+    // Returns 0, leaving out untouched, if the host does not support it.
+    __export uint8_t llaisysVMath(llaisysTensor_t out, llaisysTensor_t in, llaisysVMathFunction_t fn, llaisysVMathIsa_t isa);
 }
 
 #endif
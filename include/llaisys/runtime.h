@@ -21,6 +21,16 @@ __C {
     // Memory copy
     typedef void (*memcpy_sync_api)(void *, const void *, size_t, llaisysMemcpyKind_t);
     typedef void (*memcpy_async_api)(void *, const void *, size_t, llaisysMemcpyKind_t, llaisysStream_t);
+    // Event
+    typedef llaisysEvent_t (*create_event_api)();
+    typedef void (*destroy_event_api)(llaisysEvent_t);
+    // Capture the work queued on the stream so far; the event completes when it has run.
+    typedef void (*event_record_api)(llaisysEvent_t, llaisysStream_t);
+    // Make later work on the stream wait for the event's last record, without blocking the host.
+    typedef void (*stream_wait_event_api)(llaisysStream_t, llaisysEvent_t);
+    // 1 if the event's last record has completed (or it was never recorded).
+    typedef uint8_t (*event_query_api)(llaisysEvent_t);
+    typedef void (*event_synchronize_api)(llaisysEvent_t);
 
     struct LlaisysRuntimeAPI {
         get_device_count_api get_device_count;
@@ -35,6 +45,12 @@ __C {
         free_host_api free_host;
         memcpy_sync_api memcpy_sync;
         memcpy_async_api memcpy_async;
+        create_event_api create_event;
+        destroy_event_api destroy_event;
+        event_record_api event_record;
+        stream_wait_event_api stream_wait_event;
+        event_query_api event_query;
+        event_synchronize_api event_synchronize;
     };
 
     // Llaisys API for getting the runtime APIs
@@ -42,6 +58,18 @@ __C {
 
     // Llaisys API for switching device context
     __export void llaisysSetContextRuntime(llaisysDeviceType_t, int);
+
+    // Host staging-buffer pool of a device type: at most `cache_limit` bytes of
+    // released buffers are kept for reuse, and new buffers are mlock()ed when
+    // `lock_pages` is set.
+    __export void llaisysHostPoolConfigure(llaisysDeviceType_t, size_t cache_limit, uint8_t lock_pages);
+    // Free every cached buffer of the pool.
+    __export void llaisysHostPoolTrim(llaisysDeviceType_t);
+
+    // Threads the CPU ops split their work across, the calling one included;
+    // 0 restores the default, the CPUs the process may run on.
+    __export void llaisysSetCpuThreads(size_t nthread);
+    __export size_t llaisysGetCpuThreads();
 }
 
 #endif // LLAISYS_RUNTIME_H
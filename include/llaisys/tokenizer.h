@@ -0,0 +1,55 @@
+#ifndef LLAISYS_TOKENIZER_H
+#define LLAISYS_TOKENIZER_H
+
+#include "../llaisys.h"
+
+__C {
+    // Byte-level BPE tokenizer loaded from a HuggingFace tokenizer.json.
+    struct LlaisysTokenizer;
+
+    // `path` is a tokenizer.json file or a model directory containing one (plus an optional tokenizer_config.json
+    // for the chat template).
+    __export struct LlaisysTokenizer *llaisysTokenizerCreate(const char *path);
+
+    __export void llaisysTokenizerDestroy(struct LlaisysTokenizer * tokenizer);
+
+    __export size_t llaisysTokenizerVocabSize(struct LlaisysTokenizer * tokenizer);
+
+    // Id of a token by its tokenizer.json spelling (e.g. "<|im_end|>"), or -1.
+    __export int64_t llaisysTokenizerTokenId(struct LlaisysTokenizer * tokenizer, const char *token);
+
+    // Encode `len` bytes of UTF-8 text. Writes at most `max_tokens` ids to `out_tokens` and returns the full count,
+    // so a call with a too small buffer tells the caller how much to allocate.
+    __export size_t llaisysTokenizerEncode(struct LlaisysTokenizer * tokenizer, const char *text, size_t len,
+                                           int add_special_tokens, int64_t *out_tokens, size_t max_tokens);
+
+    // Decode tokens to UTF-8 bytes. Writes at most `max_bytes` bytes to `out` (not NUL-terminated) and returns the
+    // full length.
+    __export size_t llaisysTokenizerDecode(struct LlaisysTokenizer * tokenizer, const int64_t *tokens, size_t ntoken,
+                                           int skip_special_tokens, char *out, size_t max_bytes);
+
+    // Render `nmessage` chat messages with the model's chat template. Same output convention as Decode.
+    __export size_t llaisysTokenizerApplyChatTemplate(struct LlaisysTokenizer * tokenizer, const char *const *roles,
+                                                      const char *const *contents, size_t nmessage,
+                                                      int add_generation_prompt, char *out, size_t max_bytes);
+
+    // Incremental decoder for streaming generation, e.g. from a Qwen2 token callback. Each push returns only the
+    // UTF-8 text completed by that token: bytes of a character split across tokens are held back until the rest
+    // arrives, so every piece is valid UTF-8 and the pieces concatenate to Decode of the whole sequence.
+    struct LlaisysDetokenizer;
+
+    // The tokenizer must outlive the detokenizer.
+    __export struct LlaisysDetokenizer *llaisysDetokenizerCreate(struct LlaisysTokenizer * tokenizer,
+                                                                 int skip_special_tokens);
+
+    __export void llaisysDetokenizerDestroy(struct LlaisysDetokenizer * detokenizer);
+
+    // Feed one token. Returns the new text (not NUL-terminated, possibly empty) and stores its length in `len`; the
+    // buffer stays valid until the next call on this detokenizer.
+    __export const char *llaisysDetokenizerPush(struct LlaisysDetokenizer * detokenizer, int64_t token, size_t *len);
+
+    // End of sequence: returns held-back bytes of an unfinished character as U+FFFD and resets the state.
+    __export const char *llaisysDetokenizerFlush(struct LlaisysDetokenizer * detokenizer, size_t *len);
+}
+
+#endif // LLAISYS_TOKENIZER_H
@@ -5,6 +5,8 @@ from .libllaisys import MemcpyKind
 from .libllaisys import llaisysStream_t as Stream
 from .tensor import Tensor
 from .ops import Ops
+from .tokenizer import Detokenizer, Tokenizer
+from .grammar import Grammar
 from . import models
 from .models import *
 
@@ -16,5 +18,8 @@ __all__ = [
     "Stream",
     "Tensor",
     "Ops",
+    "Tokenizer",
+    "Detokenizer",
+    "Grammar",
     "models",
 ]
@@ -0,0 +1,38 @@
+import json
+
+from .libllaisys import LIB_LLAISYS, llaisysGrammar_t
+from .tokenizer import Tokenizer
+
+
+class Grammar:
+    """Output constraint for generate(), compiled against a tokenizer's vocabulary.
+
+    Tokens that would leave the language are masked inside the native sampler,
+    and `end_token` is only allowed once the output is complete.
+    """
+
+    def __init__(self, handle: llaisysGrammar_t):
+        self._grammar = handle
+
+    @classmethod
+    def regex(cls, tokenizer: Tokenizer, pattern: str, end_token: int) -> "Grammar":
+        return cls(
+            LIB_LLAISYS.llaisysGrammarCreateRegex(tokenizer._tokenizer, pattern.encode(), end_token)
+        )
+
+    @classmethod
+    def json_schema(cls, tokenizer: Tokenizer, schema, end_token: int) -> "Grammar":
+        """`schema` is a JSON schema as a dict or a JSON string; {} accepts any JSON value."""
+        if not isinstance(schema, str):
+            schema = json.dumps(schema)
+        return cls(
+            LIB_LLAISYS.llaisysGrammarCreateJsonSchema(tokenizer._tokenizer, schema.encode(), end_token)
+        )
+
+    def __del__(self):
+        if hasattr(self, "_grammar") and self._grammar is not None:
+            LIB_LLAISYS.llaisysGrammarDestroy(self._grammar)
+            self._grammar = None
+
+    def num_states(self) -> int:
+        return LIB_LLAISYS.llaisysGrammarNumStates(self._grammar)
@@ -8,10 +8,15 @@ from .runtime import LlaisysRuntimeAPI
 from .llaisys_types import llaisysDeviceType_t, DeviceType
 from .llaisys_types import llaisysDataType_t, DataType
 from .llaisys_types import llaisysMemcpyKind_t, MemcpyKind
-from .llaisys_types import llaisysStream_t
+from .llaisys_types import llaisysStream_t, llaisysEvent_t
 from .tensor import llaisysTensor_t
 from .tensor import load_tensor
 from .ops import load_ops
+from .qwen2 import load_qwen2
+from .qwen2 import LlaisysQwen2Meta, LlaisysQwen2Weights, LlaisysQwen2SamplingParams
+from .qwen2 import llaisysQwen2Model_t, llaisysQwen2TokenCallback, llaisysQwen2BranchTokenCallback
+from .tokenizer import load_tokenizer, llaisysTokenizer_t, llaisysDetokenizer_t
+from .grammar import load_grammar, llaisysGrammar_t
 
 
 def load_shared_library():
@@ -38,6 +43,9 @@ LIB_LLAISYS = load_shared_library()
 load_runtime(LIB_LLAISYS)
 load_tensor(LIB_LLAISYS)
 load_ops(LIB_LLAISYS)
+load_qwen2(LIB_LLAISYS)
+load_tokenizer(LIB_LLAISYS)
+load_grammar(LIB_LLAISYS)
 
 
 __all__ = [
@@ -52,4 +60,14 @@ __all__ = [
     "llaisysMemcpyKind_t",
     "MemcpyKind",
     "llaisysStream_t",
+    "llaisysEvent_t",
+    "LlaisysQwen2Meta",
+    "LlaisysQwen2Weights",
+    "LlaisysQwen2SamplingParams",
+    "llaisysQwen2Model_t",
+    "llaisysQwen2TokenCallback",
+    "llaisysQwen2BranchTokenCallback",
+    "llaisysTokenizer_t",
+    "llaisysDetokenizer_t",
+    "llaisysGrammar_t",
 ]
@@ -0,0 +1,20 @@
+from ctypes import c_char_p, c_int64, c_size_t, c_void_p
+
+from .tokenizer import llaisysTokenizer_t
+
+# Handle type
+llaisysGrammar_t = c_void_p
+
+
+def load_grammar(lib):
+    lib.llaisysGrammarCreateRegex.argtypes = [llaisysTokenizer_t, c_char_p, c_int64]
+    lib.llaisysGrammarCreateRegex.restype = llaisysGrammar_t
+
+    lib.llaisysGrammarCreateJsonSchema.argtypes = [llaisysTokenizer_t, c_char_p, c_int64]
+    lib.llaisysGrammarCreateJsonSchema.restype = llaisysGrammar_t
+
+    lib.llaisysGrammarDestroy.argtypes = [llaisysGrammar_t]
+    lib.llaisysGrammarDestroy.restype = None
+
+    lib.llaisysGrammarNumStates.argtypes = [llaisysGrammar_t]
+    lib.llaisysGrammarNumStates.restype = c_size_t
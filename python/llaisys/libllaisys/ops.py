@@ -1,5 +1,5 @@
 from .tensor import llaisysTensor_t
-from ctypes import c_float
+from ctypes import c_float, c_int, c_int64, c_size_t, c_uint8
 
 def load_ops(lib):
     lib.llaisysAdd.argtypes = [llaisysTensor_t, llaisysTensor_t, llaisysTensor_t]
@@ -14,6 +14,50 @@ def load_ops(lib):
     lib.llaisysLinear.argtypes = [llaisysTensor_t, llaisysTensor_t, llaisysTensor_t, llaisysTensor_t]
     lib.llaisysLinear.restype = None
 
+    lib.llaisysLinearAccumulate.argtypes = [llaisysTensor_t, llaisysTensor_t, llaisysTensor_t, llaisysTensor_t, c_int]
+    lib.llaisysLinearAccumulate.restype = None
+
+    lib.llaisysSetLinearAccumulation.argtypes = [c_int]
+    lib.llaisysSetLinearAccumulation.restype = None
+
+    lib.llaisysGetLinearAccumulation.argtypes = []
+    lib.llaisysGetLinearAccumulation.restype = c_int
+
+    lib.llaisysLinearLoRA.argtypes = [
+        llaisysTensor_t,  # out
+        llaisysTensor_t,  # in
+        llaisysTensor_t,  # weight
+        llaisysTensor_t,  # bias
+        llaisysTensor_t,  # lora_a
+        llaisysTensor_t,  # lora_b
+        llaisysTensor_t,  # adapter_ids
+    ]
+    lib.llaisysLinearLoRA.restype = None
+
+    lib.llaisysLinearSparse24.argtypes = [
+        llaisysTensor_t,  # out
+        llaisysTensor_t,  # in
+        llaisysTensor_t,  # values
+        llaisysTensor_t,  # indices
+        llaisysTensor_t,  # bias
+    ]
+    lib.llaisysLinearSparse24.restype = None
+
+    lib.llaisysSparse24Compress.argtypes = [llaisysTensor_t, llaisysTensor_t, llaisysTensor_t]
+    lib.llaisysSparse24Compress.restype = None
+
+    lib.llaisysLinearW8A8.argtypes = [
+        llaisysTensor_t,  # out
+        llaisysTensor_t,  # in
+        llaisysTensor_t,  # qweight
+        llaisysTensor_t,  # scales
+        llaisysTensor_t,  # bias
+    ]
+    lib.llaisysLinearW8A8.restype = None
+
+    lib.llaisysW8A8Quantize.argtypes = [llaisysTensor_t, llaisysTensor_t, llaisysTensor_t]
+    lib.llaisysW8A8Quantize.restype = None
+
     lib.llaisysRearrange.argtypes = [llaisysTensor_t, llaisysTensor_t]
     lib.llaisysRearrange.restype = None
 
@@ -32,5 +76,32 @@ def load_ops(lib):
     ]
     lib.llaisysSelfAttention.restype = None
 
+    lib.llaisysSelfAttentionWindowed.argtypes = [
+        llaisysTensor_t,  # attn_val
+        llaisysTensor_t,  # q
+        llaisysTensor_t,  # k
+        llaisysTensor_t,  # v
+        c_float,  # scale
+        c_size_t,  # window
+        c_size_t,  # sink
+    ]
+    lib.llaisysSelfAttentionWindowed.restype = None
+
+    lib.llaisysSelfAttentionTree.argtypes = [
+        llaisysTensor_t,  # attn_val
+        llaisysTensor_t,  # q
+        llaisysTensor_t,  # k
+        llaisysTensor_t,  # v
+        llaisysTensor_t,  # parents
+        c_float,  # scale
+    ]
+    lib.llaisysSelfAttentionTree.restype = None
+
+    lib.llaisysTreePositionIds.argtypes = [llaisysTensor_t, llaisysTensor_t, c_int64]
+    lib.llaisysTreePositionIds.restype = None
+
     lib.llaisysSwiGLU.argtypes = [llaisysTensor_t, llaisysTensor_t, llaisysTensor_t]
     lib.llaisysSwiGLU.restype = None
+
+    lib.llaisysVMath.argtypes = [llaisysTensor_t, llaisysTensor_t, c_int, c_int]
+    lib.llaisysVMath.restype = c_uint8
@@ -0,0 +1,241 @@
+from ctypes import (
+    POINTER,
+    CFUNCTYPE,
+    Structure,
+    c_char_p,
+    c_float,
+    c_int,
+    c_int64,
+    c_size_t,
+    c_uint8,
+    c_uint64,
+    c_void_p,
+)
+from .llaisys_types import llaisysDataType_t, llaisysDeviceType_t
+from .tensor import llaisysTensor_t
+
+
+class LlaisysQwen2Meta(Structure):
+    _fields_ = [
+        ("dtype", llaisysDataType_t),
+        ("nlayer", c_size_t),
+        ("hs", c_size_t),
+        ("nh", c_size_t),
+        ("nkvh", c_size_t),
+        ("dh", c_size_t),
+        ("di", c_size_t),
+        ("maxseq", c_size_t),
+        ("voc", c_size_t),
+        ("epsilon", c_float),
+        ("theta", c_float),
+        ("end_token", c_int64),
+    ]
+
+
+class LlaisysQwen2Weights(Structure):
+    _fields_ = [
+        ("in_embed", llaisysTensor_t),
+        ("out_embed", llaisysTensor_t),
+        ("out_norm_w", llaisysTensor_t),
+        ("attn_norm_w", POINTER(llaisysTensor_t)),
+        ("attn_q_w", POINTER(llaisysTensor_t)),
+        ("attn_q_b", POINTER(llaisysTensor_t)),
+        ("attn_k_w", POINTER(llaisysTensor_t)),
+        ("attn_k_b", POINTER(llaisysTensor_t)),
+        ("attn_v_w", POINTER(llaisysTensor_t)),
+        ("attn_v_b", POINTER(llaisysTensor_t)),
+        ("attn_o_w", POINTER(llaisysTensor_t)),
+        ("mlp_norm_w", POINTER(llaisysTensor_t)),
+        ("mlp_gate_w", POINTER(llaisysTensor_t)),
+        ("mlp_up_w", POINTER(llaisysTensor_t)),
+        ("mlp_down_w", POINTER(llaisysTensor_t)),
+        # LoRA slots, NULL until llaisysQwen2ModelEnableLoRA
+        ("attn_q_lora_a", POINTER(llaisysTensor_t)),
+        ("attn_q_lora_b", POINTER(llaisysTensor_t)),
+        ("attn_k_lora_a", POINTER(llaisysTensor_t)),
+        ("attn_k_lora_b", POINTER(llaisysTensor_t)),
+        ("attn_v_lora_a", POINTER(llaisysTensor_t)),
+        ("attn_v_lora_b", POINTER(llaisysTensor_t)),
+        ("attn_o_lora_a", POINTER(llaisysTensor_t)),
+        ("attn_o_lora_b", POINTER(llaisysTensor_t)),
+        ("mlp_gate_lora_a", POINTER(llaisysTensor_t)),
+        ("mlp_gate_lora_b", POINTER(llaisysTensor_t)),
+        ("mlp_up_lora_a", POINTER(llaisysTensor_t)),
+        ("mlp_up_lora_b", POINTER(llaisysTensor_t)),
+        ("mlp_down_lora_a", POINTER(llaisysTensor_t)),
+        ("mlp_down_lora_b", POINTER(llaisysTensor_t)),
+    ]
+
+
+class LlaisysQwen2SamplingParams(Structure):
+    _fields_ = [
+        ("top_k", c_int),
+        ("top_p", c_float),
+        ("temperature", c_float),
+        ("seed", c_uint64),
+        ("grammar", c_void_p),  # llaisysGrammar_t or None
+    ]
+
+
+# Handle type
+llaisysQwen2Model_t = c_void_p
+llaisysQwen2Stream_t = c_void_p
+
+llaisysQwen2TokenCallback = CFUNCTYPE(c_int, c_int64, c_void_p)
+llaisysQwen2BranchTokenCallback = CFUNCTYPE(c_int, c_size_t, c_int64, c_void_p)
+
+
+def load_qwen2(lib):
+    lib.llaisysQwen2ModelCreate.argtypes = [
+        POINTER(LlaisysQwen2Meta),
+        llaisysDeviceType_t,
+        POINTER(c_int),
+        c_int,
+    ]
+    lib.llaisysQwen2ModelCreate.restype = llaisysQwen2Model_t
+
+    lib.llaisysQwen2ModelCreateParallel.argtypes = [
+        POINTER(LlaisysQwen2Meta),
+        llaisysDeviceType_t,
+        POINTER(c_int),
+        c_int,
+        c_int,
+    ]
+    lib.llaisysQwen2ModelCreateParallel.restype = llaisysQwen2Model_t
+
+    lib.llaisysQwen2ModelCreateOffload.argtypes = [
+        POINTER(LlaisysQwen2Meta),
+        c_char_p,
+        c_size_t,
+    ]
+    lib.llaisysQwen2ModelCreateOffload.restype = llaisysQwen2Model_t
+
+    lib.llaisysQwen2ModelDestroy.argtypes = [llaisysQwen2Model_t]
+    lib.llaisysQwen2ModelDestroy.restype = None
+
+    lib.llaisysQwen2ModelWeights.argtypes = [llaisysQwen2Model_t]
+    lib.llaisysQwen2ModelWeights.restype = POINTER(LlaisysQwen2Weights)
+
+    lib.llaisysQwen2ModelInfer.argtypes = [llaisysQwen2Model_t, POINTER(c_int64), c_size_t]
+    lib.llaisysQwen2ModelInfer.restype = c_int64
+
+    lib.llaisysQwen2ModelReset.argtypes = [llaisysQwen2Model_t]
+    lib.llaisysQwen2ModelReset.restype = None
+
+    lib.llaisysQwen2ModelSeqCreate.argtypes = [llaisysQwen2Model_t]
+    lib.llaisysQwen2ModelSeqCreate.restype = c_int64
+
+    lib.llaisysQwen2ModelSeqFork.argtypes = [llaisysQwen2Model_t, c_int64]
+    lib.llaisysQwen2ModelSeqFork.restype = c_int64
+
+    lib.llaisysQwen2ModelSeqTruncate.argtypes = [llaisysQwen2Model_t, c_int64, c_size_t]
+    lib.llaisysQwen2ModelSeqTruncate.restype = None
+
+    lib.llaisysQwen2ModelSeqFree.argtypes = [llaisysQwen2Model_t, c_int64]
+    lib.llaisysQwen2ModelSeqFree.restype = None
+
+    lib.llaisysQwen2ModelSeqLength.argtypes = [llaisysQwen2Model_t, c_int64]
+    lib.llaisysQwen2ModelSeqLength.restype = c_size_t
+
+    lib.llaisysQwen2ModelSetKVCapacity.argtypes = [llaisysQwen2Model_t, c_size_t]
+    lib.llaisysQwen2ModelSetKVCapacity.restype = None
+
+    lib.llaisysQwen2ModelSeqSwapOut.argtypes = [llaisysQwen2Model_t, c_int64]
+    lib.llaisysQwen2ModelSeqSwapOut.restype = c_uint8
+
+    lib.llaisysQwen2ModelSeqSwapIn.argtypes = [llaisysQwen2Model_t, c_int64]
+    lib.llaisysQwen2ModelSeqSwapIn.restype = c_uint8
+
+    lib.llaisysQwen2ModelSeqIsSwapped.argtypes = [llaisysQwen2Model_t, c_int64]
+    lib.llaisysQwen2ModelSeqIsSwapped.restype = c_uint8
+
+    lib.llaisysQwen2ModelSetSpillFile.argtypes = [llaisysQwen2Model_t, c_char_p, c_size_t]
+    lib.llaisysQwen2ModelSetSpillFile.restype = None
+
+    lib.llaisysQwen2ModelSeqInfer.argtypes = [
+        llaisysQwen2Model_t,
+        c_int64,  # seq
+        POINTER(c_int64),  # token_ids
+        c_size_t,  # ntoken
+        POINTER(c_float),  # logits (optional)
+    ]
+    lib.llaisysQwen2ModelSeqInfer.restype = c_int64
+
+    lib.llaisysQwen2ModelGenerate.argtypes = [
+        llaisysQwen2Model_t,
+        POINTER(c_int64),  # prompt
+        c_size_t,  # nprompt
+        POINTER(c_int64),  # out_tokens
+        c_size_t,  # max_new_tokens
+        POINTER(LlaisysQwen2SamplingParams),
+        llaisysQwen2TokenCallback,
+        c_void_p,  # userdata
+    ]
+    lib.llaisysQwen2ModelGenerate.restype = c_size_t
+
+    lib.llaisysQwen2ModelGenerateStream.argtypes = [
+        llaisysQwen2Model_t,
+        POINTER(c_int64),  # prompt
+        c_size_t,  # nprompt
+        c_size_t,  # max_new_tokens
+        POINTER(LlaisysQwen2SamplingParams),
+    ]
+    lib.llaisysQwen2ModelGenerateStream.restype = llaisysQwen2Stream_t
+
+    lib.llaisysQwen2StreamRead.argtypes = [llaisysQwen2Stream_t, POINTER(c_int64), c_size_t]
+    lib.llaisysQwen2StreamRead.restype = c_size_t
+
+    lib.llaisysQwen2StreamError.argtypes = [llaisysQwen2Stream_t]
+    lib.llaisysQwen2StreamError.restype = c_char_p
+
+    lib.llaisysQwen2StreamCancel.argtypes = [llaisysQwen2Stream_t]
+    lib.llaisysQwen2StreamCancel.restype = None
+
+    lib.llaisysQwen2StreamDestroy.argtypes = [llaisysQwen2Stream_t]
+    lib.llaisysQwen2StreamDestroy.restype = None
+
+    lib.llaisysQwen2ModelGenerateN.argtypes = [
+        llaisysQwen2Model_t,
+        POINTER(c_int64),  # prompt
+        c_size_t,  # nprompt
+        c_size_t,  # n
+        POINTER(c_int64),  # out_tokens
+        POINTER(c_size_t),  # out_lengths
+        c_size_t,  # max_new_tokens
+        POINTER(LlaisysQwen2SamplingParams),
+        llaisysQwen2BranchTokenCallback,
+        c_void_p,  # userdata
+    ]
+    lib.llaisysQwen2ModelGenerateN.restype = c_size_t
+
+    lib.llaisysQwen2ModelSetSlidingWindow.argtypes = [
+        llaisysQwen2Model_t,
+        c_size_t,  # window
+        c_size_t,  # sink
+        c_size_t,  # first_layer
+    ]
+    lib.llaisysQwen2ModelSetSlidingWindow.restype = None
+
+    lib.llaisysQwen2ModelEnableLoRA.argtypes = [
+        llaisysQwen2Model_t,
+        c_size_t,  # max_adapters
+        c_size_t,  # max_rank
+    ]
+    lib.llaisysQwen2ModelEnableLoRA.restype = None
+
+    lib.llaisysQwen2ModelSetAdapter.argtypes = [llaisysQwen2Model_t, c_int64]
+    lib.llaisysQwen2ModelSetAdapter.restype = None
+
+    lib.llaisysQwen2ModelSetDraftModel.argtypes = [
+        llaisysQwen2Model_t,
+        llaisysQwen2Model_t,
+        c_size_t,
+    ]
+    lib.llaisysQwen2ModelSetDraftModel.restype = None
+
+    lib.llaisysQwen2ModelSetPromptLookup.argtypes = [
+        llaisysQwen2Model_t,
+        c_size_t,  # max_ngram
+        c_size_t,  # ndraft
+    ]
+    lib.llaisysQwen2ModelSetPromptLookup.restype = None
@@ -0,0 +1,62 @@
+from ctypes import POINTER, c_char, c_char_p, c_int, c_int64, c_size_t, c_void_p
+
+# Handle types
+llaisysTokenizer_t = c_void_p
+llaisysDetokenizer_t = c_void_p
+
+
+def load_tokenizer(lib):
+    lib.llaisysTokenizerCreate.argtypes = [c_char_p]
+    lib.llaisysTokenizerCreate.restype = llaisysTokenizer_t
+
+    lib.llaisysTokenizerDestroy.argtypes = [llaisysTokenizer_t]
+    lib.llaisysTokenizerDestroy.restype = None
+
+    lib.llaisysTokenizerVocabSize.argtypes = [llaisysTokenizer_t]
+    lib.llaisysTokenizerVocabSize.restype = c_size_t
+
+    lib.llaisysTokenizerTokenId.argtypes = [llaisysTokenizer_t, c_char_p]
+    lib.llaisysTokenizerTokenId.restype = c_int64
+
+    lib.llaisysTokenizerEncode.argtypes = [
+        llaisysTokenizer_t,
+        c_char_p,  # text
+        c_size_t,  # len
+        c_int,  # add_special_tokens
+        POINTER(c_int64),  # out_tokens
+        c_size_t,  # max_tokens
+    ]
+    lib.llaisysTokenizerEncode.restype = c_size_t
+
+    lib.llaisysTokenizerDecode.argtypes = [
+        llaisysTokenizer_t,
+        POINTER(c_int64),  # tokens
+        c_size_t,  # ntoken
+        c_int,  # skip_special_tokens
+        POINTER(c_char),  # out
+        c_size_t,  # max_bytes
+    ]
+    lib.llaisysTokenizerDecode.restype = c_size_t
+
+    lib.llaisysTokenizerApplyChatTemplate.argtypes = [
+        llaisysTokenizer_t,
+        POINTER(c_char_p),  # roles
+        POINTER(c_char_p),  # contents
+        c_size_t,  # nmessage
+        c_int,  # add_generation_prompt
+        POINTER(c_char),  # out
+        c_size_t,  # max_bytes
+    ]
+    lib.llaisysTokenizerApplyChatTemplate.restype = c_size_t
+
+    lib.llaisysDetokenizerCreate.argtypes = [llaisysTokenizer_t, c_int]
+    lib.llaisysDetokenizerCreate.restype = llaisysDetokenizer_t
+
+    lib.llaisysDetokenizerDestroy.argtypes = [llaisysDetokenizer_t]
+    lib.llaisysDetokenizerDestroy.restype = None
+
+    lib.llaisysDetokenizerPush.argtypes = [llaisysDetokenizer_t, c_int64, POINTER(c_size_t)]
+    lib.llaisysDetokenizerPush.restype = c_void_p
+
+    lib.llaisysDetokenizerFlush.argtypes = [llaisysDetokenizer_t, POINTER(c_size_t)]
+    lib.llaisysDetokenizerFlush.restype = c_void_p
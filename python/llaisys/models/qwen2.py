@@ -1,23 +1,307 @@
 from typing import Sequence
 from ..libllaisys import LIB_LLAISYS
-from ..libllaisys import DeviceType
+from ..libllaisys import DeviceType, DataType
+from ..libllaisys import (
+    LlaisysQwen2Meta,
+    LlaisysQwen2SamplingParams,
+    llaisysQwen2TokenCallback,
+    llaisysQwen2BranchTokenCallback,
+)
+from ..tokenizer import Detokenizer
 
+from ctypes import byref, c_float, c_int, c_int64, c_size_t
 from pathlib import Path
+import json
+import math
+import re
 import safetensors
+import torch
+
+
+_TORCH_DTYPES = {
+    "bfloat16": (DataType.BF16, torch.bfloat16),
+    "float16": (DataType.F16, torch.float16),
+    "float32": (DataType.F32, torch.float32),
+}
+
+def _text_callback(tokenizer, n, callback, on_text):
+    # Chains an incremental detokenizer per branch in front of the token callback.
+    detokenizers = [Detokenizer(tokenizer) for _ in range(n)]
+
+    def emit(branch, text):
+        if text:
+            on_text(*((branch, text) if n > 1 else (text,)))
+
+    def on_token(*args):
+        branch, token = args if n > 1 else (0, args[0])
+        emit(branch, detokenizers[branch].push(token))
+        return callback(*args) if callback is not None else True
+
+    def finish():
+        for branch, detokenizer in enumerate(detokenizers):
+            emit(branch, detokenizer.flush())
+
+    return on_token, finish
+
+
+_LAYER_WEIGHTS = {
+    "input_layernorm.weight": "attn_norm_w",
+    "self_attn.q_proj.weight": "attn_q_w",
+    "self_attn.q_proj.bias": "attn_q_b",
+    "self_attn.k_proj.weight": "attn_k_w",
+    "self_attn.k_proj.bias": "attn_k_b",
+    "self_attn.v_proj.weight": "attn_v_w",
+    "self_attn.v_proj.bias": "attn_v_b",
+    "self_attn.o_proj.weight": "attn_o_w",
+    "post_attention_layernorm.weight": "mlp_norm_w",
+    "mlp.gate_proj.weight": "mlp_gate_w",
+    "mlp.up_proj.weight": "mlp_up_w",
+    "mlp.down_proj.weight": "mlp_down_w",
+}
+
+# PEFT module name -> LlaisysQwen2Weights prefix of its *_lora_a / *_lora_b slots.
+_LORA_PROJECTIONS = {
+    "self_attn.q_proj": "attn_q",
+    "self_attn.k_proj": "attn_k",
+    "self_attn.v_proj": "attn_v",
+    "self_attn.o_proj": "attn_o",
+    "mlp.gate_proj": "mlp_gate",
+    "mlp.up_proj": "mlp_up",
+    "mlp.down_proj": "mlp_down",
+}
+
+_LORA_KEY = re.compile(r"layers\.(\d+)\.(\w+\.\w+)\.lora_([AB])(?:\.\w+)?\.weight$")
+
+# llaisysQwen2Parallel_t
+_PARALLEL_MODES = {"tensor": 0, "pipeline": 1}
 
 
 class Qwen2:
 
-    def __init__(self, model_path, device: DeviceType = DeviceType.CPU):
-        # TODO: Implement model constructor
+    def __init__(self, model_path, device: DeviceType = DeviceType.CPU, device_ids=None, parallel="tensor",
+                 offload=None, prefetch=2):
+        """`device_ids` with more than one entry runs a CPU model over one worker
+        process per entry pinned to that NUMA node: `parallel="tensor"` shards every
+        layer, `parallel="pipeline"` gives each entry a contiguous range of layers.
 
+        `offload` names a scratch file for checkpoints larger than memory: layer
+        weights are kept there and streamed through memory, `prefetch` layers ahead
+        of compute (single CPU device only)."""
         model_path = Path(model_path)
 
+        with open(model_path / "config.json") as f:
+            config = json.load(f)
+        dtype, self._torch_dtype = _TORCH_DTYPES[config.get("torch_dtype", "bfloat16")]
+        eos = config.get("eos_token_id", -1)
+
+        meta = LlaisysQwen2Meta()
+        meta.dtype = dtype
+        meta.nlayer = config["num_hidden_layers"]
+        meta.hs = config["hidden_size"]
+        meta.nh = config["num_attention_heads"]
+        meta.nkvh = config["num_key_value_heads"]
+        meta.dh = config["hidden_size"] // config["num_attention_heads"]
+        meta.di = config["intermediate_size"]
+        meta.maxseq = config["max_position_embeddings"]
+        meta.voc = config["vocab_size"]
+        meta.epsilon = config["rms_norm_eps"]
+        meta.theta = config.get("rope_theta", 10000.0)
+        meta.end_token = eos[0] if isinstance(eos, list) else eos
+        self.meta = meta
+
+        device_ids = list(device_ids) if device_ids else [0]
+        if parallel not in _PARALLEL_MODES:
+            raise ValueError(f"parallel must be one of {sorted(_PARALLEL_MODES)}")
+        if offload is not None:
+            if device != DeviceType.CPU or len(device_ids) > 1:
+                raise ValueError("offload needs a single CPU device")
+            self._model = LIB_LLAISYS.llaisysQwen2ModelCreateOffload(
+                byref(meta), str(offload).encode(), c_size_t(prefetch)
+            )
+        else:
+            self._model = LIB_LLAISYS.llaisysQwen2ModelCreateParallel(
+                byref(meta), device, (c_int * len(device_ids))(*device_ids), len(device_ids),
+                _PARALLEL_MODES[parallel],
+            )
+        weights = LIB_LLAISYS.llaisysQwen2ModelWeights(self._model).contents
+
+        if config.get("use_sliding_window", False):
+            self.set_sliding_window(
+                config["sliding_window"], 0, config.get("max_window_layers", 0)
+            )
+
+        tie_embeddings = config.get("tie_word_embeddings", False)
         for file in sorted(model_path.glob("*.safetensors")):
-            data_ = safetensors.safe_open(file, framework="numpy", device="cpu")
+            data_ = safetensors.safe_open(file, framework="pt", device="cpu")
             for name_ in data_.keys():
-                ## TODO: load the model weights
-                pass
+                handle = self._weight_handle(weights, name_)
+                if handle is None:
+                    continue
+                self._load(handle, data_.get_tensor(name_))
+                if name_ == "model.embed_tokens.weight" and tie_embeddings:
+                    self._load(weights.out_embed, data_.get_tensor(name_))
+
+    def __del__(self):
+        if hasattr(self, "_model") and self._model is not None:
+            LIB_LLAISYS.llaisysQwen2ModelDestroy(self._model)
+            self._model = None
+
+    @staticmethod
+    def _weight_handle(weights, name):
+        if name == "model.embed_tokens.weight":
+            return weights.in_embed
+        if name == "lm_head.weight":
+            return weights.out_embed
+        if name == "model.norm.weight":
+            return weights.out_norm_w
+        if name.startswith("model.layers."):
+            layer, suffix = name[len("model.layers.") :].split(".", 1)
+            field = _LAYER_WEIGHTS.get(suffix)
+            if field is not None:
+                return getattr(weights, field)[int(layer)]
+        return None
+
+    def _load(self, handle, tensor):
+        tensor = tensor.to(self._torch_dtype).contiguous()
+        LIB_LLAISYS.tensorLoad(handle, tensor.data_ptr())
+
+    # Sequences share KV blocks copy-on-write when forked.
+    def seq_create(self) -> int:
+        return LIB_LLAISYS.llaisysQwen2ModelSeqCreate(self._model)
+
+    def seq_fork(self, seq: int) -> int:
+        return LIB_LLAISYS.llaisysQwen2ModelSeqFork(self._model, c_int64(seq))
+
+    def seq_truncate(self, seq: int, length: int):
+        LIB_LLAISYS.llaisysQwen2ModelSeqTruncate(
+            self._model, c_int64(seq), c_size_t(length)
+        )
+
+    def seq_free(self, seq: int):
+        LIB_LLAISYS.llaisysQwen2ModelSeqFree(self._model, c_int64(seq))
+
+    def seq_length(self, seq: int) -> int:
+        return LIB_LLAISYS.llaisysQwen2ModelSeqLength(self._model, c_int64(seq))
+
+    def set_kv_capacity(self, ntoken: int):
+        """Let all sequences together hold up to `ntoken` KV rows (maxseq by default)."""
+        LIB_LLAISYS.llaisysQwen2ModelSetKVCapacity(self._model, c_size_t(ntoken))
+
+    # Idle sequences can hand their KV blocks back to the pool and page them in later.
+    # Both return False, leaving the sequence where it is, if there is no room.
+    def seq_swap_out(self, seq: int) -> bool:
+        return bool(LIB_LLAISYS.llaisysQwen2ModelSeqSwapOut(self._model, c_int64(seq)))
+
+    def seq_swap_in(self, seq: int) -> bool:
+        return bool(LIB_LLAISYS.llaisysQwen2ModelSeqSwapIn(self._model, c_int64(seq)))
+
+    def seq_is_swapped(self, seq: int) -> bool:
+        return bool(LIB_LLAISYS.llaisysQwen2ModelSeqIsSwapped(self._model, c_int64(seq)))
+
+    def set_spill_file(self, path, capacity: int):
+        """Spill swapped-out blocks into a scratch file of up to `capacity` bytes."""
+        LIB_LLAISYS.llaisysQwen2ModelSetSpillFile(
+            self._model, str(path).encode(), c_size_t(capacity)
+        )
+
+    def seq_infer(self, seq: int, tokens: Sequence[int], return_logits: bool = False):
+        """Append tokens to `seq`; returns the argmax next token (and its logits)."""
+        token_ids = (c_int64 * len(tokens))(*tokens)
+        logits = (c_float * self.meta.voc)() if return_logits else None
+        next_token = LIB_LLAISYS.llaisysQwen2ModelSeqInfer(
+            self._model, c_int64(seq), token_ids, c_size_t(len(tokens)), logits
+        )
+        if next_token < 0:
+            raise MemoryError("KV cache is full; swap out or free a sequence")
+        return (next_token, list(logits)) if return_logits else next_token
+
+    def set_sliding_window(self, window: int, sink: int = 4, first_layer: int = 0):
+        """Attend to the last `window` tokens plus `sink` attention-sink tokens.
+
+        With first_layer 0 the KV cache evicts invisible rows, so streams can run
+        past maxseq with constant memory. window 0 disables. Set it before any
+        sequence holds tokens.
+        """
+        LIB_LLAISYS.llaisysQwen2ModelSetSlidingWindow(
+            self._model, c_size_t(window), c_size_t(sink), c_size_t(first_layer)
+        )
+
+    def enable_lora(self, max_adapters: int, max_rank: int):
+        """Reserve `max_adapters` LoRA slots of rank up to `max_rank` on every projection."""
+        LIB_LLAISYS.llaisysQwen2ModelEnableLoRA(
+            self._model, c_size_t(max_adapters), c_size_t(max_rank)
+        )
+        self._lora_slots = (max_adapters, max_rank)
+
+    def load_lora(self, adapter_path, slot: int):
+        """Load a PEFT adapter (adapter_config.json + adapter_model.safetensors) into `slot`.
+
+        Projections the adapter does not target are cleared, so a slot can be reused.
+        """
+        if not hasattr(self, "_lora_slots"):
+            raise RuntimeError("call enable_lora() first")
+        max_adapters, max_rank = self._lora_slots
+        if not 0 <= slot < max_adapters:
+            raise ValueError(f"slot {slot} out of range [0, {max_adapters})")
+        adapter_path = Path(adapter_path)
+        with open(adapter_path / "adapter_config.json") as f:
+            config = json.load(f)
+        rank = config["r"]
+        if rank > max_rank:
+            raise ValueError(f"adapter rank {rank} exceeds max_rank {max_rank}")
+        alpha = config.get("lora_alpha", rank)
+        scale = alpha / math.sqrt(rank) if config.get("use_rslora", False) else alpha / rank
+
+        loaded = {}
+        data_ = safetensors.safe_open(
+            adapter_path / "adapter_model.safetensors", framework="pt", device="cpu"
+        )
+        for name_ in data_.keys():
+            match = _LORA_KEY.search(name_)
+            if match and match.group(2) in _LORA_PROJECTIONS:
+                layer, module, which = int(match.group(1)), match.group(2), match.group(3)
+                loaded[(layer, _LORA_PROJECTIONS[module], which)] = data_.get_tensor(name_).float()
+
+        weights = LIB_LLAISYS.llaisysQwen2ModelWeights(self._model).contents
+        for layer in range(self.meta.nlayer):
+            for prefix in _LORA_PROJECTIONS.values():
+                a_slots = getattr(weights, prefix + "_lora_a")[layer]
+                b_slots = getattr(weights, prefix + "_lora_b")[layer]
+                # A: [max_rank, In], B: [Out, max_rank], zero past the adapter's rank.
+                a = torch.zeros(self._lora_shape(a_slots)[1:])
+                b = torch.zeros(self._lora_shape(b_slots)[1:])
+                if (layer, prefix, "A") in loaded:
+                    a[:rank] = loaded[(layer, prefix, "A")]
+                    b[:, :rank] = loaded[(layer, prefix, "B")] * scale
+                for handle, tensor in ((a_slots, a), (b_slots, b)):
+                    view = LIB_LLAISYS.tensorSlice(handle, c_size_t(0), c_size_t(slot), c_size_t(slot + 1))
+                    try:
+                        self._load(view, tensor)
+                    finally:
+                        LIB_LLAISYS.tensorDestroy(view)
+
+    @staticmethod
+    def _lora_shape(handle):
+        shape = (c_size_t * 3)()
+        LIB_LLAISYS.tensorGetShape(handle, shape)
+        return tuple(shape)
+
+    def set_adapter(self, slot: int = -1):
+        """Decode with the LoRA adapter in `slot`; -1 returns to the base model."""
+        LIB_LLAISYS.llaisysQwen2ModelSetAdapter(self._model, c_int64(slot))
+
+    def set_draft_model(self, draft: "Qwen2", ndraft: int = 4):
+        """Enable speculative decoding with a smaller model sharing the tokenizer."""
+        self._draft = draft
+        LIB_LLAISYS.llaisysQwen2ModelSetDraftModel(
+            self._model, None if draft is None else draft._model, c_size_t(ndraft)
+        )
+
+    def set_prompt_lookup(self, max_ngram: int = 3, ndraft: int = 8):
+        """Enable speculative decoding with n-gram drafts looked up in the context."""
+        LIB_LLAISYS.llaisysQwen2ModelSetPromptLookup(
+            self._model, c_size_t(max_ngram), c_size_t(ndraft)
+        )
 
     def generate(
         self,
@@ -26,8 +310,125 @@ class Qwen2:
         top_k: int = 1,
         top_p: float = 0.8,
         temperature: float = 0.8,
+        seed: int = 0,
+        callback=None,
+        n: int = 1,
+        tokenizer=None,
+        on_text=None,
+        grammar=None,
     ):
+        """Returns prompt + generated tokens, or a list of n such lists when n > 1.
+
+        With n > 1 the prompt is prefilled once and the n samples are decoded as one
+        batch; `callback` then receives (branch, token).
 
-        # TODO: Implement generate function
+        `on_text` streams the output as text: given a `Tokenizer`, it receives each
+        newly completed piece of UTF-8 text (with a leading branch index when n > 1),
+        never half of a multi-byte character.
+
+        `grammar` (a `Grammar`) constrains the output to a regex or JSON schema;
+        speculative decoding is skipped while it is set.
+        """
+        if max_new_tokens is None:
+            max_new_tokens = self.meta.maxseq - len(inputs)
+        prompt = (c_int64 * len(inputs))(*inputs)
+        params = LlaisysQwen2SamplingParams(
+            top_k, top_p, temperature, seed, None if grammar is None else grammar._grammar
+        )
+        if on_text is not None:
+            if tokenizer is None:
+                raise ValueError("on_text needs a tokenizer")
+            callback, finish = _text_callback(tokenizer, n, callback, on_text)
+            try:
+                return self.generate(
+                    inputs, max_new_tokens, top_k, top_p, temperature, seed, callback, n, grammar=grammar
+                )
+            finally:
+                finish()
+        if n > 1:
+            return self._generate_n(inputs, prompt, n, max_new_tokens, params, callback)
+        if callback is not None:
+            # The callback runs here while decoding continues on the native thread.
+            tokens = []
+            stream = self.generate_stream(inputs, max_new_tokens, top_k, top_p, temperature, seed, grammar)
+            try:
+                for token in stream:
+                    tokens.append(token)
+                    if callback(token) is False:
+                        break
+            finally:
+                stream.close()
+            return list(inputs) + tokens
+        out = (c_int64 * max_new_tokens)()
+        n = LIB_LLAISYS.llaisysQwen2ModelGenerate(
+            self._model,
+            prompt,
+            c_size_t(len(inputs)),
+            out,
+            c_size_t(max_new_tokens),
+            byref(params),
+            llaisysQwen2TokenCallback(),  # NULL: callbacks go through generate_stream
+            None,
+        )
+        return list(inputs) + out[:n]
+
+    def generate_stream(
+        self,
+        inputs: Sequence[int],
+        max_new_tokens: int = None,
+        top_k: int = 1,
+        top_p: float = 0.8,
+        temperature: float = 0.8,
+        seed: int = 0,
+        grammar=None,
+    ):
+        """Yields generated tokens as they are decoded, with the sampling options of
+        `generate`. Decoding runs on a native thread that hands tokens over through a
+        lock-free ring, so a slow consumer never stalls it; closing the generator
+        early cancels generation. The model must not be used until then."""
+        if max_new_tokens is None:
+            max_new_tokens = self.meta.maxseq - len(inputs)
+        prompt = (c_int64 * len(inputs))(*inputs)
+        params = LlaisysQwen2SamplingParams(
+            top_k, top_p, temperature, seed, None if grammar is None else grammar._grammar
+        )
+        stream = LIB_LLAISYS.llaisysQwen2ModelGenerateStream(
+            self._model, prompt, c_size_t(len(inputs)), c_size_t(max_new_tokens), byref(params)
+        )
+        buffer = (c_int64 * 64)()
+        try:
+            while True:
+                count = LIB_LLAISYS.llaisysQwen2StreamRead(stream, buffer, c_size_t(len(buffer)))
+                if count == 0:
+                    break
+                yield from buffer[:count]
+            error = LIB_LLAISYS.llaisysQwen2StreamError(stream)
+            if error is not None:
+                raise RuntimeError(error.decode())
+        finally:
+            LIB_LLAISYS.llaisysQwen2StreamDestroy(stream)
 
-        return []
+    def _generate_n(self, inputs, prompt, n, max_new_tokens, params, callback):
+        out = (c_int64 * (n * max_new_tokens))()
+        lengths = (c_size_t * n)()
+        c_callback = llaisysQwen2BranchTokenCallback(
+            (lambda branch, token, _: int(callback(branch, token) is not False))
+            if callback is not None
+            else (lambda branch, token, _: 1)
+        )
+        LIB_LLAISYS.llaisysQwen2ModelGenerateN(
+            self._model,
+            prompt,
+            c_size_t(len(inputs)),
+            c_size_t(n),
+            out,
+            lengths,
+            c_size_t(max_new_tokens),
+            byref(params),
+            c_callback,
+            None,
+        )
+        return [
+            list(inputs) + out[i * max_new_tokens : i * max_new_tokens + lengths[i]]
+            for i in range(n)
+        ]
@@ -1,6 +1,6 @@
 from .libllaisys import LIB_LLAISYS
 from .tensor import Tensor
-from ctypes import c_float, c_int
+from ctypes import c_float, c_int, c_int64, c_size_t
 
 
 class Ops:
@@ -18,12 +18,67 @@ class Ops:
             out.lib_tensor(), index.lib_tensor(), weight.lib_tensor()
         )
 
+    LINEAR_ACCUMULATIONS = {"f32": 0, "kahan": 1}
+
+    @staticmethod
+    def linear(out: Tensor, inp: Tensor, weight: Tensor, bias: Tensor, accumulation: str = None):
+        """accumulation ("f32" or "kahan") overrides the process-wide mode for this call."""
+        if accumulation is None:
+            LIB_LLAISYS.llaisysLinear(
+                out.lib_tensor(), inp.lib_tensor(), weight.lib_tensor(),
+                bias.lib_tensor() if bias is not None else None,
+            )
+        else:
+            LIB_LLAISYS.llaisysLinearAccumulate(
+                out.lib_tensor(), inp.lib_tensor(), weight.lib_tensor(),
+                bias.lib_tensor() if bias is not None else None,
+                Ops.LINEAR_ACCUMULATIONS[accumulation],
+            )
+
+    @staticmethod
+    def set_linear_accumulation(accumulation: str):
+        LIB_LLAISYS.llaisysSetLinearAccumulation(Ops.LINEAR_ACCUMULATIONS[accumulation])
+
+    @staticmethod
+    def linear_accumulation() -> str:
+        mode = LIB_LLAISYS.llaisysGetLinearAccumulation()
+        return next(k for k, v in Ops.LINEAR_ACCUMULATIONS.items() if v == mode)
+
+    @staticmethod
+    def linear_lora(out: Tensor, inp: Tensor, weight: Tensor, bias: Tensor,
+                    lora_a: Tensor, lora_b: Tensor, adapter_ids: Tensor):
+        LIB_LLAISYS.llaisysLinearLoRA(
+            out.lib_tensor(), inp.lib_tensor(), weight.lib_tensor(),
+            bias.lib_tensor() if bias is not None else None,
+            lora_a.lib_tensor(), lora_b.lib_tensor(), adapter_ids.lib_tensor()
+        )
+
+    @staticmethod
+    def linear_sparse24(out: Tensor, inp: Tensor, values: Tensor, indices: Tensor, bias: Tensor):
+        """Linear over a 2:4 sparse weight in the layout sparse24_compress produces."""
+        LIB_LLAISYS.llaisysLinearSparse24(
+            out.lib_tensor(), inp.lib_tensor(), values.lib_tensor(), indices.lib_tensor(),
+            bias.lib_tensor() if bias is not None else None,
+        )
+
+    @staticmethod
+    def sparse24_compress(values: Tensor, indices: Tensor, weight: Tensor):
+        """values [Out, In / 2] and u8 indices [Out, In / 8] from a dense [Out, In] weight."""
+        LIB_LLAISYS.llaisysSparse24Compress(values.lib_tensor(), indices.lib_tensor(), weight.lib_tensor())
+
     @staticmethod
-    def linear(out: Tensor, inp: Tensor, weight: Tensor, bias: Tensor):
-        LIB_LLAISYS.llaisysLinear(
-            out.lib_tensor(), inp.lib_tensor(), weight.lib_tensor(), bias.lib_tensor()
+    def linear_w8a8(out: Tensor, inp: Tensor, qweight: Tensor, scales: Tensor, bias: Tensor):
+        """Linear over an int8 weight from w8a8_quantize, with inp quantized to int8 per token."""
+        LIB_LLAISYS.llaisysLinearW8A8(
+            out.lib_tensor(), inp.lib_tensor(), qweight.lib_tensor(), scales.lib_tensor(),
+            bias.lib_tensor() if bias is not None else None,
         )
 
+    @staticmethod
+    def w8a8_quantize(qweight: Tensor, scales: Tensor, weight: Tensor):
+        """i8 qweight [Out, In] and f32 per-channel scales [Out] from a dense [Out, In] weight."""
+        LIB_LLAISYS.llaisysW8A8Quantize(qweight.lib_tensor(), scales.lib_tensor(), weight.lib_tensor())
+
     @staticmethod
     def rearrange(out: Tensor, inp: Tensor):
         LIB_LLAISYS.llaisysRearrange(out.lib_tensor(), inp.lib_tensor())
@@ -41,15 +96,60 @@ class Ops:
         )
 
     @staticmethod
-    def self_attention(attn_val: Tensor, q: Tensor, k: Tensor, v: Tensor, scale: float):
-        LIB_LLAISYS.llaisysSelfAttention(
+    def self_attention(
+        attn_val: Tensor,
+        q: Tensor,
+        k: Tensor,
+        v: Tensor,
+        scale: float,
+        window: int = 0,
+        sink: int = 0,
+    ):
+        LIB_LLAISYS.llaisysSelfAttentionWindowed(
             attn_val.lib_tensor(),
             q.lib_tensor(),
             k.lib_tensor(),
             v.lib_tensor(),
             c_float(scale),
+            c_size_t(window),
+            c_size_t(sink),
         )
 
+    @staticmethod
+    def self_attention_tree(
+        attn_val: Tensor,
+        q: Tensor,
+        k: Tensor,
+        v: Tensor,
+        parents: Tensor,
+        scale: float,
+    ):
+        """parents (i64 [qlen]) holds each query's parent query, -1 for a root."""
+        LIB_LLAISYS.llaisysSelfAttentionTree(
+            attn_val.lib_tensor(),
+            q.lib_tensor(),
+            k.lib_tensor(),
+            v.lib_tensor(),
+            parents.lib_tensor(),
+            c_float(scale),
+        )
+
+    @staticmethod
+    def tree_position_ids(pos_ids: Tensor, parents: Tensor, start: int):
+        LIB_LLAISYS.llaisysTreePositionIds(pos_ids.lib_tensor(), parents.lib_tensor(), c_int64(start))
+
     @staticmethod
     def swiglu(out: Tensor, gate: Tensor, up: Tensor):
         LIB_LLAISYS.llaisysSwiGLU(out.lib_tensor(), gate.lib_tensor(), up.lib_tensor())
+
+    VMATH_FUNCTIONS = {"exp": 0, "sigmoid": 1, "silu": 2, "tanh": 3, "rsqrt": 4}
+    VMATH_ISAS = {"scalar": 0, "avx2": 1, "avx512": 2, "avx512_bf16": 3, "avx2_vnni": 4, "avx512_vnni": 5}
+
+    @staticmethod
+    def vmath(out: Tensor, inp: Tensor, fn: str, isa: str = "scalar") -> bool:
+        """out = fn(inp) through one instruction set; False if the host lacks it."""
+        return bool(
+            LIB_LLAISYS.llaisysVMath(
+                out.lib_tensor(), inp.lib_tensor(), Ops.VMATH_FUNCTIONS[fn], Ops.VMATH_ISAS[isa]
+            )
+        )
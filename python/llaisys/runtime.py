@@ -5,6 +5,7 @@ from ctypes import c_void_p
 
 class RuntimeAPI:
     def __init__(self, device_type: libllaisys.DeviceType):
+        self._device_type = device_type
         self._api = LIB_LLAISYS.llaisysGetRuntimeAPI(
             libllaisys.llaisysDeviceType_t(device_type)
         )
@@ -66,3 +67,42 @@ class RuntimeAPI:
         self._api.contents.memcpy_async(
             dst, src, size, libllaisys.llaisysMemcpyKind_t(kind), stream
         )
+
+    def create_event(self) -> libllaisys.llaisysEvent_t:
+        return self._api.contents.create_event()
+
+    def destroy_event(self, event: libllaisys.llaisysEvent_t) -> None:
+        self._api.contents.destroy_event(event)
+
+    def event_record(
+        self, event: libllaisys.llaisysEvent_t, stream: libllaisys.llaisysStream_t
+    ) -> None:
+        self._api.contents.event_record(event, stream)
+
+    def stream_wait_event(
+        self, stream: libllaisys.llaisysStream_t, event: libllaisys.llaisysEvent_t
+    ) -> None:
+        self._api.contents.stream_wait_event(stream, event)
+
+    def event_query(self, event: libllaisys.llaisysEvent_t) -> bool:
+        return bool(self._api.contents.event_query(event))
+
+    def event_synchronize(self, event: libllaisys.llaisysEvent_t) -> None:
+        self._api.contents.event_synchronize(event)
+
+    def configure_host_pool(self, cache_limit: int, lock_pages: bool = False) -> None:
+        LIB_LLAISYS.llaisysHostPoolConfigure(
+            libllaisys.llaisysDeviceType_t(self._device_type), cache_limit, int(lock_pages)
+        )
+
+    def trim_host_pool(self) -> None:
+        LIB_LLAISYS.llaisysHostPoolTrim(libllaisys.llaisysDeviceType_t(self._device_type))
+
+    @staticmethod
+    def set_cpu_threads(nthread: int) -> None:
+        """Threads the CPU ops use, the caller included; 0 restores the default."""
+        LIB_LLAISYS.llaisysSetCpuThreads(nthread)
+
+    @staticmethod
+    def cpu_threads() -> int:
+        return LIB_LLAISYS.llaisysGetCpuThreads()
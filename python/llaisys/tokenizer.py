@@ -0,0 +1,96 @@
+from typing import Dict, List, Sequence
+
+from .libllaisys import LIB_LLAISYS, llaisysTokenizer_t, llaisysDetokenizer_t
+from ctypes import byref, c_char, c_char_p, c_int64, c_size_t, string_at
+
+
+class Tokenizer:
+    """Native byte-level BPE tokenizer for a HuggingFace tokenizer.json."""
+
+    def __init__(self, path):
+        self._tokenizer: llaisysTokenizer_t = LIB_LLAISYS.llaisysTokenizerCreate(
+            str(path).encode()
+        )
+
+    def __del__(self):
+        if hasattr(self, "_tokenizer") and self._tokenizer is not None:
+            LIB_LLAISYS.llaisysTokenizerDestroy(self._tokenizer)
+            self._tokenizer = None
+
+    def vocab_size(self) -> int:
+        return LIB_LLAISYS.llaisysTokenizerVocabSize(self._tokenizer)
+
+    def token_id(self, token: str) -> int:
+        return LIB_LLAISYS.llaisysTokenizerTokenId(self._tokenizer, token.encode())
+
+    def encode(self, text: str, add_special_tokens: bool = True) -> List[int]:
+        data = text.encode()
+        capacity = len(data) + 8
+        while True:
+            out = (c_int64 * capacity)()
+            n = LIB_LLAISYS.llaisysTokenizerEncode(
+                self._tokenizer, data, len(data), int(add_special_tokens), out, capacity
+            )
+            if n <= capacity:
+                return out[:n]
+            capacity = n
+
+    def decode(self, tokens: Sequence[int], skip_special_tokens: bool = False) -> str:
+        ids = (c_int64 * len(tokens))(*tokens)
+        return self._read_string(
+            lambda out, cap: LIB_LLAISYS.llaisysTokenizerDecode(
+                self._tokenizer, ids, len(tokens), int(skip_special_tokens), out, cap
+            ),
+            16 * len(tokens),
+        )
+
+    def apply_chat_template(
+        self, messages: Sequence[Dict[str, str]], add_generation_prompt: bool = True
+    ) -> str:
+        roles = (c_char_p * len(messages))(*[m["role"].encode() for m in messages])
+        contents = (c_char_p * len(messages))(*[m["content"].encode() for m in messages])
+        return self._read_string(
+            lambda out, cap: LIB_LLAISYS.llaisysTokenizerApplyChatTemplate(
+                self._tokenizer, roles, contents, len(messages), int(add_generation_prompt), out, cap
+            ),
+            256 + sum(len(m["content"]) for m in messages),
+        )
+
+    @staticmethod
+    def _read_string(call, capacity: int) -> str:
+        while True:
+            out = (c_char * max(capacity, 1))()
+            n = call(out, capacity)
+            if n <= capacity:
+                return out.raw[:n].decode(errors="replace")
+            capacity = n
+
+
+class Detokenizer:
+    """Incremental decoder for streaming generation.
+
+    `push(token)` returns only the text completed by that token; bytes of a
+    character split across tokens are held back until it is whole. The pieces
+    from `push` and `flush` concatenate to `tokenizer.decode(tokens)`.
+    """
+
+    def __init__(self, tokenizer: Tokenizer, skip_special_tokens: bool = True):
+        self._tokenizer = tokenizer  # keeps the native tokenizer alive
+        self._detokenizer: llaisysDetokenizer_t = LIB_LLAISYS.llaisysDetokenizerCreate(
+            tokenizer._tokenizer, int(skip_special_tokens)
+        )
+
+    def __del__(self):
+        if hasattr(self, "_detokenizer") and self._detokenizer is not None:
+            LIB_LLAISYS.llaisysDetokenizerDestroy(self._detokenizer)
+            self._detokenizer = None
+
+    def push(self, token: int) -> str:
+        n = c_size_t()
+        data = LIB_LLAISYS.llaisysDetokenizerPush(self._detokenizer, c_int64(token), byref(n))
+        return string_at(data, n.value).decode() if n.value else ""
+
+    def flush(self) -> str:
+        n = c_size_t()
+        data = LIB_LLAISYS.llaisysDetokenizerFlush(self._detokenizer, byref(n))
+        return string_at(data, n.value).decode() if n.value else ""
@@ -0,0 +1,52 @@
+"""Generate src/tokenizer/unicode_data.cpp from Python's unicodedata."""
+
+import sys
+import unicodedata
+from pathlib import Path
+
+CATEGORIES = [
+    "Cn", "Lu", "Ll", "Lt", "Lm", "Lo", "Mn", "Mc", "Me", "Nd", "Nl", "No", "Pc", "Pd", "Ps",
+    "Pe", "Pi", "Pf", "Po", "Sm", "Sc", "Sk", "So", "Zs", "Zl", "Zp", "Cc", "Cf", "Cs", "Co",
+]
+
+
+def ranges():
+    first, current = 0, unicodedata.category("\0")
+    for cp in range(1, 0x110000):
+        cat = unicodedata.category(chr(cp))
+        if cat != current:
+            yield first, cp - 1, current
+            first, current = cp, cat
+    yield first, 0x10FFFF, current
+
+
+def main():
+    out = Path(__file__).resolve().parent.parent / "src" / "tokenizer" / "unicode_data.cpp"
+    entries = [f"{{0x{a:X}, 0x{b:X}, C::{c}}}," for a, b, c in ranges() if c != "Cn"]
+    lines = []
+    line = "   "
+    for entry in entries:
+        if len(line) + len(entry) + 1 > 100:
+            lines.append(line)
+            line = "   "
+        line += " " + entry
+    lines.append(line)
+    out.write_text(
+        "// Generated by scripts/gen_unicode_data.py from Unicode "
+        f"{unicodedata.unidata_version}. Do not edit.\n\n"
+        '#include "unicode.hpp"\n\n'
+        "namespace llaisys::tokenizer {\n\n"
+        "namespace {\n"
+        "using C = UnicodeCategory;\n"
+        "} // namespace\n\n"
+        "// Maximal runs of code points sharing a general category; gaps are unassigned (Cn).\n"
+        "const UnicodeRange UNICODE_RANGES[] = {\n" + "\n".join(lines) + "\n};\n\n"
+        "const size_t UNICODE_RANGE_COUNT = sizeof(UNICODE_RANGES) / sizeof(UNICODE_RANGES[0]);\n\n"
+        "} // namespace llaisys::tokenizer\n",
+        encoding="utf-8",
+    )
+    print(f"wrote {len(entries)} ranges to {out}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,123 @@
+#include "host_pool_allocator.hpp"
+
+#include "../../device/runtime_api.hpp"
+#include "../../utils.hpp"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+namespace llaisys::core::allocators {
+namespace {
+size_t sizeClass(size_t size) {
+    size_t cls = 0;
+    while ((HostPoolAllocator::MIN_CLASS_BYTES << cls) < size) {
+        cls++;
+    }
+    return cls;
+}
+} // namespace
+
+HostPoolAllocator::HostPoolAllocator(const LlaisysRuntimeAPI *runtime_api)
+    : MemoryAllocator(runtime_api), _free(sizeClass(MAX_CLASS_BYTES) + 1) {}
+
+HostPoolAllocator::~HostPoolAllocator() {
+    trim();
+}
+
+std::shared_ptr<HostPoolAllocator> HostPoolAllocator::shared(llaisysDeviceType_t device_type) {
+    static std::mutex mutex;
+    static std::unordered_map<int, std::shared_ptr<HostPoolAllocator>> pools;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &pool = pools[device_type];
+    if (!pool) {
+        pool = std::make_shared<HostPoolAllocator>(llaisys::device::getRuntimeAPI(device_type));
+    }
+    return pool;
+}
+
+std::byte *HostPoolAllocator::allocate(size_t size) {
+    const bool pooled = size <= MAX_CLASS_BYTES;
+    const size_t cls = pooled ? sizeClass(size) : 0;
+    bool lock_pages;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (pooled && !_free[cls].empty()) {
+            std::byte *memory = _free[cls].back();
+            _free[cls].pop_back();
+            _cached_bytes -= MIN_CLASS_BYTES << cls;
+            return memory;
+        }
+        lock_pages = _lock_pages;
+    }
+    Block block{pooled ? MIN_CLASS_BYTES << cls : size, false};
+    auto *memory = static_cast<std::byte *>(_api->malloc_host(block.bytes));
+    ASSERT(memory != nullptr, "HostPoolAllocator: out of host memory");
+#ifndef _WIN32
+    block.locked = lock_pages && mlock(memory, block.bytes) == 0;
+#else
+    (void)lock_pages;
+#endif
+    std::lock_guard<std::mutex> lock(_mutex);
+    _blocks.emplace(memory, block);
+    return memory;
+}
+
+void HostPoolAllocator::release(std::byte *memory) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto it = _blocks.find(memory);
+    ASSERT(it != _blocks.end(), "HostPoolAllocator: releasing a buffer it does not own");
+    const Block block = it->second;
+    if (block.bytes <= MAX_CLASS_BYTES && _cached_bytes + block.bytes <= _cache_limit) {
+        _free[sizeClass(block.bytes)].push_back(memory);
+        _cached_bytes += block.bytes;
+        return;
+    }
+    _blocks.erase(it);
+    lock.unlock();
+    _freeBlock(memory, block);
+}
+
+void HostPoolAllocator::setCacheLimit(size_t bytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cache_limit = bytes;
+}
+
+void HostPoolAllocator::setLockPages(bool lock_pages) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _lock_pages = lock_pages;
+}
+
+void HostPoolAllocator::trim() {
+    std::vector<std::pair<std::byte *, Block>> freed;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto &list : _free) {
+            for (std::byte *memory : list) {
+                auto it = _blocks.find(memory);
+                freed.emplace_back(memory, it->second);
+                _blocks.erase(it);
+            }
+            list.clear();
+        }
+        _cached_bytes = 0;
+    }
+    for (const auto &[memory, block] : freed) {
+        _freeBlock(memory, block);
+    }
+}
+
+size_t HostPoolAllocator::cachedBytes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _cached_bytes;
+}
+
+void HostPoolAllocator::_freeBlock(std::byte *memory, const Block &block) {
+#ifndef _WIN32
+    if (block.locked) {
+        munlock(memory, block.bytes);
+    }
+#endif
+    _api->free_host(memory);
+}
+} // namespace llaisys::core::allocators
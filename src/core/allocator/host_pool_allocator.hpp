@@ -0,0 +1,57 @@
+#pragma once
+
+#include "allocator.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace llaisys::core::allocators {
+// Reusable host staging memory (pinned where the device runtime pins
+// malloc_host). Requests are rounded up to power-of-two size classes of at
+// least a page, and released buffers are kept per class for the next request
+// of that class, so transfer-heavy paths (host storages, loaders, KV swap)
+// stop paying for allocation and first-touch page faults on every copy.
+// Buffers above MAX_CLASS_BYTES are not pooled.
+//
+// One pool per device type is shared by all threads and runtimes.
+class HostPoolAllocator : public MemoryAllocator {
+public:
+    static constexpr size_t MIN_CLASS_BYTES = size_t(4) << 10;
+    static constexpr size_t MAX_CLASS_BYTES = size_t(256) << 20;
+    static constexpr size_t DEFAULT_CACHE_LIMIT = size_t(1) << 30;
+
+    HostPoolAllocator(const LlaisysRuntimeAPI *runtime_api);
+    ~HostPoolAllocator();
+
+    static std::shared_ptr<HostPoolAllocator> shared(llaisysDeviceType_t device_type);
+
+    std::byte *allocate(size_t size) override;
+    void release(std::byte *memory) override;
+
+    // Bytes kept in the free lists; releases beyond the limit are freed.
+    void setCacheLimit(size_t bytes);
+    // mlock() buffers allocated from now on, so they are never paged out
+    // (best effort: a buffer that cannot be locked is used unlocked).
+    void setLockPages(bool lock);
+    // Free every cached buffer.
+    void trim();
+
+    size_t cachedBytes() const;
+
+private:
+    struct Block {
+        size_t bytes;
+        bool locked;
+    };
+
+    mutable std::mutex _mutex;
+    std::unordered_map<std::byte *, Block> _blocks; // every live or cached buffer
+    std::vector<std::vector<std::byte *>> _free;    // per size class
+    size_t _cached_bytes = 0;
+    size_t _cache_limit = DEFAULT_CACHE_LIMIT;
+    bool _lock_pages = false;
+
+    void _freeBlock(std::byte *memory, const Block &block);
+};
+} // namespace llaisys::core::allocators
@@ -1,4 +1,5 @@
 #include "context.hpp"
+#include "../../device/runtime_api.hpp"
 #include "../../utils.hpp"
 #include <thread>
 
@@ -15,7 +16,8 @@ Context::Context() {
     // Create runtimes for each device type.
     // Activate the first available device. If no other device is available, activate CPU runtime.
     for (auto device_type : device_typs) {
-        const LlaisysRuntimeAPI *api_ = llaisysGetRuntimeAPI(device_type);
+        // The device layer directly, not the C API: static users like the server do not link src/llaisys.
+        const LlaisysRuntimeAPI *api_ = llaisys::device::getRuntimeAPI(device_type);
         int device_count = api_->get_device_count();
         std::vector<Runtime *> runtimes_(device_count);
         for (int device_id = 0; device_id < device_count; device_id++) {
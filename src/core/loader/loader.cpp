@@ -0,0 +1,65 @@
+#include "loader.hpp"
+
+#include "../../device/runtime_api.hpp"
+#include "../allocator/host_pool_allocator.hpp"
+#include "../../utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace llaisys::core {
+DoubleBufferedLoader::DoubleBufferedLoader(llaisysDeviceType_t device_type, int device_id, size_t chunk_bytes)
+    : _device_type(device_type), _device_id(device_id), _chunk_bytes(chunk_bytes) {
+    CHECK_ARGUMENT(chunk_bytes > 0, "DoubleBufferedLoader: chunk_bytes must be positive");
+    _api = llaisys::device::getRuntimeAPI(device_type);
+    _pool = allocators::HostPoolAllocator::shared(device_type);
+    _api->set_device(device_id);
+    _stream = _api->create_stream();
+    for (auto &buffer : _buffers) {
+        buffer.data = _pool->allocate(chunk_bytes);
+        buffer.copied = _api->create_event();
+    }
+    _done = _api->create_event();
+}
+
+DoubleBufferedLoader::~DoubleBufferedLoader() {
+    _api->set_device(_device_id);
+    _api->stream_synchronize(_stream);
+    for (auto &buffer : _buffers) {
+        _api->destroy_event(buffer.copied);
+        _pool->release(buffer.data);
+    }
+    _api->destroy_event(_done);
+    _api->destroy_stream(_stream);
+}
+
+void DoubleBufferedLoader::load(std::byte *dst, size_t size, const Fill &fill) {
+    _api->set_device(_device_id);
+    const auto kind = _device_type == LLAISYS_DEVICE_CPU ? LLAISYS_MEMCPY_H2H : LLAISYS_MEMCPY_H2D;
+    for (size_t offset = 0; offset < size; offset += _chunk_bytes) {
+        const size_t n = std::min(_chunk_bytes, size - offset);
+        Buffer &buffer = _buffers[_next];
+        _next ^= 1;
+        // The copy issued from this buffer two chunks ago must be done reading it.
+        _api->event_synchronize(buffer.copied);
+        fill(buffer.data, offset, n);
+        _api->memcpy_async(dst + offset, buffer.data, n, kind, _stream);
+        _api->event_record(buffer.copied, _stream);
+    }
+}
+
+void DoubleBufferedLoader::load(std::byte *dst, const std::byte *src, size_t size) {
+    load(dst, size, [src](std::byte *staging, size_t offset, size_t n) { std::memcpy(staging, src + offset, n); });
+}
+
+void DoubleBufferedLoader::waitOn(llaisysStream_t stream) {
+    _api->set_device(_device_id);
+    _api->event_record(_done, _stream);
+    _api->stream_wait_event(stream, _done);
+}
+
+void DoubleBufferedLoader::synchronize() {
+    _api->set_device(_device_id);
+    _api->stream_synchronize(_stream);
+}
+} // namespace llaisys::core
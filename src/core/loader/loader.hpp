@@ -0,0 +1,59 @@
+#pragma once
+#include "llaisys/runtime.h"
+
+#include "../core.hpp"
+
+#include <functional>
+#include <memory>
+
+namespace llaisys::core {
+// Streams host data into device memory through two staging buffers borrowed
+// from the host pool (pinned where the device supports it), so filling one
+// chunk (reading a file, converting dtypes) overlaps with the copy of the
+// previous one on a dedicated copy stream. Each buffer has an
+// event recorded after its copy; a buffer is refilled only once that event
+// has completed.
+//
+// Loads are asynchronous: the destination is complete after synchronize(), or
+// for work queued on another stream after waitOn(stream).
+class DoubleBufferedLoader {
+public:
+    static constexpr size_t DEFAULT_CHUNK_BYTES = size_t(4) << 20;
+
+    // Fill `staging` with bytes [offset, offset + size) of the data to load.
+    using Fill = std::function<void(std::byte *staging, size_t offset, size_t size)>;
+
+    DoubleBufferedLoader(llaisysDeviceType_t device_type, int device_id,
+                         size_t chunk_bytes = DEFAULT_CHUNK_BYTES);
+    ~DoubleBufferedLoader();
+
+    DoubleBufferedLoader(const DoubleBufferedLoader &) = delete;
+    DoubleBufferedLoader &operator=(const DoubleBufferedLoader &) = delete;
+
+    void load(std::byte *dst, size_t size, const Fill &fill);
+    void load(std::byte *dst, const std::byte *src, size_t size);
+
+    // Make later work on `stream` wait for every load issued so far, without
+    // blocking the host.
+    void waitOn(llaisysStream_t stream);
+    void synchronize();
+
+    size_t chunkBytes() const { return _chunk_bytes; }
+
+private:
+    struct Buffer {
+        std::byte *data;
+        llaisysEvent_t copied;
+    };
+
+    llaisysDeviceType_t _device_type;
+    int _device_id;
+    const LlaisysRuntimeAPI *_api;
+    std::shared_ptr<MemoryAllocator> _pool;
+    size_t _chunk_bytes;
+    llaisysStream_t _stream;
+    Buffer _buffers[2];
+    size_t _next = 0;
+    llaisysEvent_t _done;
+};
+} // namespace llaisys::core
@@ -1,6 +1,7 @@
 #include "runtime.hpp"
 
 #include "../../device/runtime_api.hpp"
+#include "../allocator/host_pool_allocator.hpp"
 #include "../allocator/naive_allocator.hpp"
 
 namespace llaisys::core {
@@ -8,15 +9,16 @@ Runtime::Runtime(llaisysDeviceType_t device_type, int device_id)
     : _device_type(device_type), _device_id(device_id), _is_active(false) {
     _api = llaisys::device::getRuntimeAPI(_device_type);
     _stream = _api->create_stream();
-    _allocator = new allocators::NaiveAllocator(_api);
+    _allocator = std::make_shared<allocators::NaiveAllocator>(_api);
+    _host_allocator = allocators::HostPoolAllocator::shared(_device_type);
 }
 
 Runtime::~Runtime() {
     if (!_is_active) {
         std::cerr << "Mallicious destruction of inactive runtime." << std::endl;
     }
-    delete _allocator;
-    _allocator = nullptr;
+    _allocator.reset();
+    _host_allocator.reset();
     _api->destroy_stream(_stream);
     _api = nullptr;
 }
@@ -51,15 +53,11 @@ storage_t Runtime::allocateDeviceStorage(size_t size) {
 }
 
 storage_t Runtime::allocateHostStorage(size_t size) {
-    return std::shared_ptr<Storage>(new Storage((std::byte *)_api->malloc_host(size), size, *this, true));
+    return std::shared_ptr<Storage>(new Storage(_host_allocator->allocate(size), size, *this, true));
 }
 
-void Runtime::freeStorage(Storage *storage) {
-    if (storage->isHost()) {
-        _api->free_host(storage->memory());
-    } else {
-        _allocator->release(storage->memory());
-    }
+storage_t Runtime::wrapHostStorage(std::byte *memory, size_t size) {
+    return std::shared_ptr<Storage>(new Storage(memory, size, *this, true, true));
 }
 
 llaisysStream_t Runtime::stream() const {
@@ -10,7 +10,10 @@ private:
     llaisysDeviceType_t _device_type;
     int _device_id;
     const LlaisysRuntimeAPI *_api;
-    MemoryAllocator *_allocator;
+    // Shared with the storages it allocated, which may outlive this (thread-local) runtime.
+    std::shared_ptr<MemoryAllocator> _allocator;
+    // Process-wide pool of host staging buffers for this device type.
+    std::shared_ptr<MemoryAllocator> _host_allocator;
     bool _is_active;
     void _activate();
     void _deactivate();
@@ -19,6 +22,7 @@ private:
 
 public:
     friend class Context;
+    friend class Storage;
 
     ~Runtime();
 
@@ -38,8 +42,10 @@ public:
 
     storage_t allocateDeviceStorage(size_t size);
     ;
+    // Pooled (and, where the device supports it, pinned) host staging memory.
     storage_t allocateHostStorage(size_t size);
-    void freeStorage(Storage *storage);
+    // Host memory owned by the caller (e.g. a shared mapping); it must outlive the storage.
+    storage_t wrapHostStorage(std::byte *memory, size_t size);
 
     llaisysStream_t stream() const;
     void synchronize() const;
@@ -1,13 +1,18 @@
 #include "storage.hpp"
 
+#include "../allocator/allocator.hpp"
 #include "../runtime/runtime.hpp"
 
 namespace llaisys::core {
-Storage::Storage(std::byte *memory, size_t size, Runtime &runtime, bool is_host)
-    : _memory(memory), _size(size), _runtime(runtime), _is_host(is_host) {}
+Storage::Storage(std::byte *memory, size_t size, Runtime &runtime, bool is_host, bool borrowed)
+    : _memory(memory), _size(size), _device_type(runtime.deviceType()), _device_id(runtime.deviceId()),
+      _allocator(is_host ? runtime._host_allocator : runtime._allocator), _is_host(is_host), _borrowed(borrowed) {}
 
 Storage::~Storage() {
-    _runtime.freeStorage(this);
+    if (_borrowed) {
+        return;
+    }
+    _allocator->release(_memory);
 }
 
 std::byte *Storage::memory() const {
@@ -22,7 +27,7 @@ llaisysDeviceType_t Storage::deviceType() const {
     if (isHost()) {
         return LLAISYS_DEVICE_CPU;
     } else {
-        return _runtime.deviceType();
+        return _device_type;
     }
 }
 
@@ -30,11 +35,15 @@ int Storage::deviceId() const {
     if (isHost()) {
         return 0;
     } else {
-        return _runtime.deviceId();
+        return _device_id;
     }
 }
 
 bool Storage::isHost() const {
     return _is_host;
 }
+
+bool Storage::isBorrowed() const {
+    return _borrowed;
+}
 } // namespace llaisys::core
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "llaisys.h"
+#include "llaisys/runtime.h"
 
 #include "../core.hpp"
 
@@ -10,9 +11,14 @@ class Storage {
 private:
     std::byte *_memory;
     size_t _size;
-    Runtime &_runtime;
+    // Captured from the allocating runtime, which is thread-local and may be gone by the
+    // time the storage is freed (e.g. KV blocks allocated on a server worker thread).
+    llaisysDeviceType_t _device_type;
+    int _device_id;
+    std::shared_ptr<MemoryAllocator> _allocator; // the runtime's device allocator or host pool
     bool _is_host;
-    Storage(std::byte *memory, size_t size, Runtime &runtime, bool is_host);
+    bool _borrowed; // memory owned by someone else, never freed here
+    Storage(std::byte *memory, size_t size, Runtime &runtime, bool is_host, bool borrowed = false);
 
 public:
     friend class Runtime;
@@ -23,6 +29,7 @@ public:
     llaisysDeviceType_t deviceType() const;
     int deviceId() const;
     bool isHost() const;
+    bool isBorrowed() const;
 };
 
 }; // namespace llaisys::core
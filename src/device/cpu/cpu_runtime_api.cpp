@@ -1,4 +1,5 @@
 #include "../runtime_api.hpp"
+#include "cpu_stream.hpp"
 
 #include <cstdlib>
 #include <cstring>
@@ -15,18 +16,20 @@ void setDevice(int) {
 }
 
 void deviceSynchronize() {
-    // do nothing
+    Stream::synchronizeAll();
 }
 
 llaisysStream_t createStream() {
-    return (llaisysStream_t)0; // null stream
+    return new Stream();
 }
 
 void destroyStream(llaisysStream_t stream) {
-    // do nothing
+    delete static_cast<Stream *>(stream);
 }
 void streamSynchronize(llaisysStream_t stream) {
-    // do nothing
+    if (stream != nullptr) {
+        static_cast<Stream *>(stream)->synchronize();
+    }
 }
 
 void *mallocDevice(size_t size) {
@@ -37,12 +40,23 @@ void freeDevice(void *ptr) {
     std::free(ptr);
 }
 
+// Host buffers are page-aligned, so they can be mlock()ed and map whole pages.
 void *mallocHost(size_t size) {
-    return mallocDevice(size);
+    constexpr size_t PAGE = 4096;
+#ifdef _WIN32
+    return _aligned_malloc(size, PAGE);
+#else
+    void *ptr = nullptr;
+    return posix_memalign(&ptr, PAGE, size) == 0 ? ptr : nullptr;
+#endif
 }
 
 void freeHost(void *ptr) {
-    freeDevice(ptr);
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
 }
 
 void memcpySync(void *dst, const void *src, size_t size, llaisysMemcpyKind_t kind) {
@@ -50,7 +64,35 @@ void memcpySync(void *dst, const void *src, size_t size, llaisysMemcpyKind_t kin
 }
 
 void memcpyAsync(void *dst, const void *src, size_t size, llaisysMemcpyKind_t kind, llaisysStream_t stream) {
-    memcpySync(dst, src, size, kind);
+    if (stream == nullptr) {
+        memcpySync(dst, src, size, kind);
+        return;
+    }
+    static_cast<Stream *>(stream)->enqueue([dst, src, size] { std::memcpy(dst, src, size); });
+}
+
+llaisysEvent_t createEvent() {
+    return new Event();
+}
+
+void destroyEvent(llaisysEvent_t event) {
+    delete static_cast<Event *>(event);
+}
+
+void eventRecord(llaisysEvent_t event, llaisysStream_t stream) {
+    static_cast<Event *>(event)->record(static_cast<Stream *>(stream));
+}
+
+void streamWaitEvent(llaisysStream_t stream, llaisysEvent_t event) {
+    static_cast<Event *>(event)->wait(static_cast<Stream *>(stream));
+}
+
+uint8_t eventQuery(llaisysEvent_t event) {
+    return static_cast<Event *>(event)->query() ? 1 : 0;
+}
+
+void eventSynchronize(llaisysEvent_t event) {
+    static_cast<Event *>(event)->synchronize();
 }
 
 static const LlaisysRuntimeAPI RUNTIME_API = {
@@ -65,7 +107,13 @@ static const LlaisysRuntimeAPI RUNTIME_API = {
     &mallocHost,
     &freeHost,
     &memcpySync,
-    &memcpyAsync};
+    &memcpyAsync,
+    &createEvent,
+    &destroyEvent,
+    &eventRecord,
+    &streamWaitEvent,
+    &eventQuery,
+    &eventSynchronize};
 
 } // namespace runtime_api
 
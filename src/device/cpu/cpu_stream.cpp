@@ -0,0 +1,138 @@
+#include "cpu_stream.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace llaisys::device::cpu {
+
+namespace {
+std::mutex &registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::unordered_set<Stream *> &registry() {
+    static std::unordered_set<Stream *> streams;
+    return streams;
+}
+} // namespace
+
+Stream::Stream() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().insert(this);
+}
+
+Stream::~Stream() {
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        registry().erase(this);
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _cv.notify_all();
+    if (_worker.joinable()) {
+        _worker.join();
+    }
+}
+
+void Stream::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_worker.joinable()) {
+            _worker = std::thread([this] { _run(); });
+        }
+        _tasks.push_back(std::move(task));
+        _submitted++;
+    }
+    _cv.notify_all();
+}
+
+void Stream::synchronize() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    const uint64_t target = _submitted;
+    _cv.wait(lock, [&] { return _finished >= target; });
+}
+
+void Stream::synchronizeAll() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (Stream *stream : registry()) {
+        stream->synchronize();
+    }
+}
+
+// Drains the queue before stopping, so destroying a stream completes its work.
+void Stream::_run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        _cv.wait(lock, [&] { return _stopping || !_tasks.empty(); });
+        if (_tasks.empty()) {
+            return;
+        }
+        auto task = std::move(_tasks.front());
+        _tasks.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+        _finished++;
+        _cv.notify_all();
+    }
+}
+
+Event::Event() : _state(std::make_shared<State>()) {}
+
+void Event::record(Stream *stream) {
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        generation = ++_state->recorded;
+    }
+    if (stream == nullptr) {
+        _state->complete(generation);
+    } else {
+        stream->enqueue([state = _state, generation] { state->complete(generation); });
+    }
+}
+
+void Event::wait(Stream *stream) {
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        generation = _state->recorded;
+    }
+    if (stream == nullptr) {
+        _state->waitFor(generation);
+    } else {
+        stream->enqueue([state = _state, generation] { state->waitFor(generation); });
+    }
+}
+
+bool Event::query() const {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    return _state->completed >= _state->recorded;
+}
+
+void Event::synchronize() {
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        generation = _state->recorded;
+    }
+    _state->waitFor(generation);
+}
+
+void Event::State::complete(uint64_t generation) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        completed = std::max(completed, generation);
+    }
+    cv.notify_all();
+}
+
+void Event::State::waitFor(uint64_t generation) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return completed >= generation; });
+}
+
+} // namespace llaisys::device::cpu
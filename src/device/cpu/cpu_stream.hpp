@@ -0,0 +1,72 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace llaisys::device::cpu {
+
+// A CPU stream: host tasks (async copies, event records and waits) run in
+// submission order by a worker thread of its own, so they overlap with the
+// submitting thread the way device work overlaps with the host. The worker is
+// started on first use and does not survive fork(). The null stream
+// (llaisysStream_t 0) stays synchronous.
+class Stream {
+public:
+    Stream();
+    ~Stream();
+
+    Stream(const Stream &) = delete;
+    Stream &operator=(const Stream &) = delete;
+
+    void enqueue(std::function<void()> task);
+    // Block until every task enqueued so far has run.
+    void synchronize();
+
+    // Synchronize every live stream.
+    static void synchronizeAll();
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::deque<std::function<void()>> _tasks;
+    uint64_t _submitted = 0;
+    uint64_t _finished = 0;
+    bool _stopping = false;
+    std::thread _worker;
+
+    void _run();
+};
+
+// Completes once the work captured by its last record() has run. Waiting for
+// an older record returns once any later one completes. Queued tasks share
+// the state, so an event may be destroyed while streams still refer to it.
+class Event {
+public:
+    Event();
+
+    // Null stream: there is nothing in flight, the event completes at once.
+    void record(Stream *stream);
+    // Null stream: block the host instead.
+    void wait(Stream *stream);
+    bool query() const;
+    void synchronize();
+
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable cv;
+        uint64_t recorded = 0;
+        uint64_t completed = 0;
+
+        void complete(uint64_t generation);
+        void waitFor(uint64_t generation);
+    };
+    std::shared_ptr<State> _state;
+};
+
+} // namespace llaisys::device::cpu
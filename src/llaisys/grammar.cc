@@ -0,0 +1,40 @@
+#include "llaisys_grammar.hpp"
+#include "llaisys_tokenizer.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+// Bytes of every token id; special tokens stay empty so no grammar allows them.
+std::vector<std::string> tokenBytes(const llaisys::tokenizer::Tokenizer &tokenizer) {
+    std::vector<std::string> bytes(tokenizer.vocabSize());
+    for (size_t id = 0; id < bytes.size(); id++) {
+        if (!tokenizer.isSpecial(static_cast<int64_t>(id))) {
+            bytes[id] = tokenizer.tokenBytes(static_cast<int64_t>(id));
+        }
+    }
+    return bytes;
+}
+} // namespace
+
+__C {
+    struct LlaisysGrammar *llaisysGrammarCreateRegex(struct LlaisysTokenizer * tokenizer, const char *pattern,
+                                                     int64_t end_token) {
+        auto grammar = llaisys::models::Grammar::fromRegex(pattern, tokenBytes(*tokenizer->tokenizer), end_token);
+        return new LlaisysGrammar{std::move(grammar)};
+    }
+
+    struct LlaisysGrammar *llaisysGrammarCreateJsonSchema(struct LlaisysTokenizer * tokenizer, const char *schema,
+                                                          int64_t end_token) {
+        auto grammar = llaisys::models::Grammar::fromJsonSchema(schema, tokenBytes(*tokenizer->tokenizer), end_token);
+        return new LlaisysGrammar{std::move(grammar)};
+    }
+
+    void llaisysGrammarDestroy(struct LlaisysGrammar * grammar) {
+        delete grammar;
+    }
+
+    size_t llaisysGrammarNumStates(struct LlaisysGrammar * grammar) {
+        return grammar->grammar->numStates();
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "llaisys/grammar.h"
+
+#include "../models/sampling/grammar.hpp"
+
+#include <memory>
+
+__C {
+    struct LlaisysGrammar {
+        std::shared_ptr<const llaisys::models::Grammar> grammar;
+    };
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "llaisys/tokenizer.h"
+
+#include "../tokenizer/tokenizer.hpp"
+
+#include <memory>
+
+__C {
+    struct LlaisysTokenizer {
+        std::unique_ptr<llaisys::tokenizer::Tokenizer> tokenizer;
+    };
+}
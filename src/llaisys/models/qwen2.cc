@@ -0,0 +1,317 @@
+#include "llaisys/models/qwen2.h"
+
+#include "../llaisys_grammar.hpp"
+#include "../llaisys_tensor.hpp"
+
+#include "../../models/qwen2/qwen2.hpp"
+#include "../../models/qwen2/speculative.hpp"
+#include "../../utils/channel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+__C {
+    struct LlaisysQwen2Model {
+        std::unique_ptr<llaisys::models::Qwen2> model;
+        LlaisysQwen2Weights weights{};
+        std::vector<std::unique_ptr<LlaisysTensor>> handles;
+        std::vector<std::vector<llaisysTensor_t>> layer_handles;
+        llaisys::models::Qwen2::seq_t default_seq = -1;
+    };
+
+    struct LlaisysQwen2Stream {
+        llaisys::utils::SpscChannel<int64_t> tokens; // sized for max_new_tokens, never full
+        std::atomic<bool> cancelled{false};
+        std::string error; // published by closing `tokens`
+        std::thread thread;
+        // Reader side: drained tokens not yet returned.
+        std::vector<int64_t> pending;
+        size_t next = 0;
+
+        explicit LlaisysQwen2Stream(size_t capacity) : tokens(capacity) {}
+    };
+}
+
+namespace {
+llaisysTensor_t wrap(LlaisysQwen2Model *model, llaisys::tensor_t tensor) {
+    model->handles.push_back(std::make_unique<LlaisysTensor>(LlaisysTensor{tensor}));
+    return model->handles.back().get();
+}
+
+llaisysTensor_t *wrapLayers(LlaisysQwen2Model *model, const std::vector<llaisys::tensor_t> &tensors) {
+    std::vector<llaisysTensor_t> handles;
+    for (const auto &tensor : tensors) {
+        handles.push_back(wrap(model, tensor));
+    }
+    model->layer_handles.push_back(std::move(handles));
+    return model->layer_handles.back().data();
+}
+
+LlaisysQwen2Model *wrapModel(std::unique_ptr<llaisys::models::Qwen2> qwen2) {
+    auto *model = new LlaisysQwen2Model;
+    model->model = std::move(qwen2);
+
+    auto &w = model->model->weights();
+    model->weights.in_embed = wrap(model, w.in_embed);
+    model->weights.out_embed = wrap(model, w.out_embed);
+    model->weights.out_norm_w = wrap(model, w.out_norm_w);
+    model->weights.attn_norm_w = wrapLayers(model, w.attn_norm_w);
+    model->weights.attn_q_w = wrapLayers(model, w.attn_q_w);
+    model->weights.attn_q_b = wrapLayers(model, w.attn_q_b);
+    model->weights.attn_k_w = wrapLayers(model, w.attn_k_w);
+    model->weights.attn_k_b = wrapLayers(model, w.attn_k_b);
+    model->weights.attn_v_w = wrapLayers(model, w.attn_v_w);
+    model->weights.attn_v_b = wrapLayers(model, w.attn_v_b);
+    model->weights.attn_o_w = wrapLayers(model, w.attn_o_w);
+    model->weights.mlp_norm_w = wrapLayers(model, w.mlp_norm_w);
+    model->weights.mlp_gate_w = wrapLayers(model, w.mlp_gate_w);
+    model->weights.mlp_up_w = wrapLayers(model, w.mlp_up_w);
+    model->weights.mlp_down_w = wrapLayers(model, w.mlp_down_w);
+    return model;
+}
+
+llaisys::models::SamplingConfig toSamplingConfig(const LlaisysQwen2SamplingParams *params) {
+    llaisys::models::SamplingConfig config;
+    if (params != nullptr) {
+        config.top_k = params->top_k;
+        config.top_p = params->top_p;
+        config.temperature = params->temperature;
+        config.seed = params->seed;
+        if (params->grammar != nullptr) {
+            config.grammar = params->grammar->grammar;
+        }
+    }
+    return config;
+}
+} // namespace
+
+__C {
+    struct LlaisysQwen2Model *llaisysQwen2ModelCreate(const LlaisysQwen2Meta *meta, llaisysDeviceType_t device, int *device_ids, int ndevice) {
+        return llaisysQwen2ModelCreateParallel(meta, device, device_ids, ndevice, LLAISYS_QWEN2_TENSOR_PARALLEL);
+    }
+
+    struct LlaisysQwen2Model *llaisysQwen2ModelCreateParallel(const LlaisysQwen2Meta *meta, llaisysDeviceType_t device, int *device_ids, int ndevice,
+                                                              llaisysQwen2Parallel_t parallel) {
+        std::vector<int> ids{0};
+        if (device_ids != nullptr && ndevice > 0) {
+            ids.assign(device_ids, device_ids + ndevice);
+        }
+        return wrapModel(std::make_unique<llaisys::models::Qwen2>(
+            *meta, device, ids,
+            parallel == LLAISYS_QWEN2_PIPELINE_PARALLEL ? llaisys::models::Qwen2::Parallel::PIPELINE
+                                                        : llaisys::models::Qwen2::Parallel::TENSOR));
+    }
+
+    struct LlaisysQwen2Model *llaisysQwen2ModelCreateOffload(const LlaisysQwen2Meta *meta, const char *offload_path, size_t prefetch) {
+        llaisys::models::Qwen2::Offload offload;
+        offload.path = offload_path;
+        offload.prefetch = prefetch;
+        return wrapModel(std::make_unique<llaisys::models::Qwen2>(
+            *meta, LLAISYS_DEVICE_CPU, std::vector<int>{0}, llaisys::models::Qwen2::Parallel::TENSOR, offload));
+    }
+
+    void llaisysQwen2ModelDestroy(struct LlaisysQwen2Model * model) {
+        delete model;
+    }
+
+    struct LlaisysQwen2Weights *llaisysQwen2ModelWeights(struct LlaisysQwen2Model * model) {
+        return &model->weights;
+    }
+
+    int64_t llaisysQwen2ModelInfer(struct LlaisysQwen2Model * model, int64_t * token_ids, size_t ntoken) {
+        auto &cache = model->model->cache();
+        if (model->default_seq < 0) {
+            model->default_seq = cache.createSequence();
+        }
+        if (!model->model->reserve(model->default_seq, ntoken)) {
+            return -1;
+        }
+        auto logits = model->model->forward({{model->default_seq, token_ids, ntoken, false, model->model->adapter()}});
+        std::vector<float> row;
+        model->model->logitsRow(logits, 0, row);
+        return llaisys::models::argmax(row.data(), row.size());
+    }
+
+    void llaisysQwen2ModelReset(struct LlaisysQwen2Model * model) {
+        if (model->default_seq >= 0) {
+            model->model->cache().freeSequence(model->default_seq);
+            model->default_seq = -1;
+        }
+    }
+
+    int64_t llaisysQwen2ModelSeqCreate(struct LlaisysQwen2Model * model) {
+        return model->model->cache().createSequence();
+    }
+
+    int64_t llaisysQwen2ModelSeqFork(struct LlaisysQwen2Model * model, int64_t seq) {
+        return model->model->cache().fork(seq);
+    }
+
+    void llaisysQwen2ModelSeqTruncate(struct LlaisysQwen2Model * model, int64_t seq, size_t len) {
+        model->model->cache().truncate(seq, len);
+    }
+
+    void llaisysQwen2ModelSeqFree(struct LlaisysQwen2Model * model, int64_t seq) {
+        model->model->cache().freeSequence(seq);
+    }
+
+    size_t llaisysQwen2ModelSeqLength(struct LlaisysQwen2Model * model, int64_t seq) {
+        return model->model->cache().length(seq);
+    }
+
+    void llaisysQwen2ModelSetKVCapacity(struct LlaisysQwen2Model * model, size_t ntoken) {
+        auto &cache = model->model->cache();
+        cache.growMaxBlocks(cache.numBlocksFor(ntoken));
+    }
+
+    uint8_t llaisysQwen2ModelSeqSwapOut(struct LlaisysQwen2Model * model, int64_t seq) {
+        return model->model->cache().swapOut(seq);
+    }
+
+    uint8_t llaisysQwen2ModelSeqSwapIn(struct LlaisysQwen2Model * model, int64_t seq) {
+        return model->model->cache().swapIn(seq);
+    }
+
+    uint8_t llaisysQwen2ModelSeqIsSwapped(struct LlaisysQwen2Model * model, int64_t seq) {
+        return model->model->cache().isSwapped(seq);
+    }
+
+    void llaisysQwen2ModelSetSpillFile(struct LlaisysQwen2Model * model, const char *path, size_t capacity) {
+        model->model->cache().setSpillFile(path, capacity);
+    }
+
+    int64_t llaisysQwen2ModelSeqInfer(struct LlaisysQwen2Model * model, int64_t seq, int64_t *token_ids, size_t ntoken, float *logits) {
+        if (!model->model->reserve(seq, ntoken)) {
+            return -1;
+        }
+        auto out = model->model->forward({{seq, token_ids, ntoken, false, model->model->adapter()}});
+        std::vector<float> row;
+        model->model->logitsRow(out, 0, row);
+        if (logits != nullptr) {
+            std::copy(row.begin(), row.end(), logits);
+        }
+        return llaisys::models::argmax(row.data(), row.size());
+    }
+
+    size_t llaisysQwen2ModelGenerate(struct LlaisysQwen2Model * model, const int64_t *prompt, size_t nprompt,
+                                     int64_t *out_tokens, size_t max_new_tokens,
+                                     const struct LlaisysQwen2SamplingParams *params,
+                                     llaisysQwen2TokenCallback callback, void *userdata) {
+        size_t n = 0;
+        return model->model->generate(prompt, nprompt, max_new_tokens, toSamplingConfig(params),
+                                      [&](int64_t token) {
+                                          out_tokens[n++] = token;
+                                          return callback == nullptr || callback(token, userdata) != 0;
+                                      });
+    }
+
+    struct LlaisysQwen2Stream *llaisysQwen2ModelGenerateStream(struct LlaisysQwen2Model * model, const int64_t *prompt, size_t nprompt,
+                                                               size_t max_new_tokens, const struct LlaisysQwen2SamplingParams *params) {
+        auto *stream = new LlaisysQwen2Stream(std::max<size_t>(max_new_tokens, 1));
+        stream->thread = std::thread([stream, model, tokens = std::vector<int64_t>(prompt, prompt + nprompt), max_new_tokens,
+                                      config = toSamplingConfig(params)] {
+            try {
+                model->model->generate(tokens.data(), tokens.size(), max_new_tokens, config, [stream](int64_t token) {
+                    stream->tokens.tryPush(token);
+                    return !stream->cancelled.load(std::memory_order_relaxed);
+                });
+            } catch (const std::exception &e) {
+                stream->error = e.what();
+            }
+            stream->tokens.close();
+        });
+        return stream;
+    }
+
+    size_t llaisysQwen2StreamRead(struct LlaisysQwen2Stream * stream, int64_t *out, size_t capacity) {
+        if (stream->next == stream->pending.size()) {
+            stream->pending.clear();
+            stream->next = 0;
+            while (stream->pending.empty() && stream->tokens.wait(stream->pending)) {
+            }
+        }
+        const size_t n = std::min(capacity, stream->pending.size() - stream->next);
+        std::copy_n(stream->pending.begin() + stream->next, n, out);
+        stream->next += n;
+        return n;
+    }
+
+    const char *llaisysQwen2StreamError(struct LlaisysQwen2Stream * stream) {
+        return stream->error.empty() ? nullptr : stream->error.c_str();
+    }
+
+    void llaisysQwen2StreamCancel(struct LlaisysQwen2Stream * stream) {
+        stream->cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    void llaisysQwen2StreamDestroy(struct LlaisysQwen2Stream * stream) {
+        llaisysQwen2StreamCancel(stream);
+        stream->thread.join();
+        delete stream;
+    }
+
+    size_t llaisysQwen2ModelGenerateN(struct LlaisysQwen2Model * model, const int64_t *prompt, size_t nprompt,
+                                      size_t n, int64_t *out_tokens, size_t *out_lengths, size_t max_new_tokens,
+                                      const struct LlaisysQwen2SamplingParams *params,
+                                      llaisysQwen2BranchTokenCallback callback, void *userdata) {
+        std::fill(out_lengths, out_lengths + n, 0);
+        auto lengths = model->model->generate(prompt, nprompt, n, max_new_tokens, toSamplingConfig(params),
+                                              [&](size_t branch, int64_t token) {
+                                                  out_tokens[branch * max_new_tokens + out_lengths[branch]++] = token;
+                                                  return callback == nullptr || callback(branch, token, userdata) != 0;
+                                              });
+        size_t total = 0;
+        for (size_t len : lengths) {
+            total += len;
+        }
+        return total;
+    }
+
+    void llaisysQwen2ModelSetSlidingWindow(struct LlaisysQwen2Model * model, size_t window, size_t sink, size_t first_layer) {
+        model->model->setSlidingWindow(window, sink, first_layer);
+    }
+
+    void llaisysQwen2ModelEnableLoRA(struct LlaisysQwen2Model * model, size_t max_adapters, size_t max_rank) {
+        model->model->enableLoRA(max_adapters, max_rank);
+        auto &w = model->model->weights();
+        model->weights.attn_q_lora_a = wrapLayers(model, w.attn_q_lora_a);
+        model->weights.attn_q_lora_b = wrapLayers(model, w.attn_q_lora_b);
+        model->weights.attn_k_lora_a = wrapLayers(model, w.attn_k_lora_a);
+        model->weights.attn_k_lora_b = wrapLayers(model, w.attn_k_lora_b);
+        model->weights.attn_v_lora_a = wrapLayers(model, w.attn_v_lora_a);
+        model->weights.attn_v_lora_b = wrapLayers(model, w.attn_v_lora_b);
+        model->weights.attn_o_lora_a = wrapLayers(model, w.attn_o_lora_a);
+        model->weights.attn_o_lora_b = wrapLayers(model, w.attn_o_lora_b);
+        model->weights.mlp_gate_lora_a = wrapLayers(model, w.mlp_gate_lora_a);
+        model->weights.mlp_gate_lora_b = wrapLayers(model, w.mlp_gate_lora_b);
+        model->weights.mlp_up_lora_a = wrapLayers(model, w.mlp_up_lora_a);
+        model->weights.mlp_up_lora_b = wrapLayers(model, w.mlp_up_lora_b);
+        model->weights.mlp_down_lora_a = wrapLayers(model, w.mlp_down_lora_a);
+        model->weights.mlp_down_lora_b = wrapLayers(model, w.mlp_down_lora_b);
+    }
+
+    void llaisysQwen2ModelSetAdapter(struct LlaisysQwen2Model * model, int64_t adapter) {
+        model->model->setAdapter(adapter);
+    }
+
+    void llaisysQwen2ModelSetDraftModel(struct LlaisysQwen2Model * model, struct LlaisysQwen2Model * draft, size_t ndraft) {
+        if (draft == nullptr) {
+            model->model->setDrafter(nullptr, 0);
+            return;
+        }
+        CHECK_ARGUMENT(draft->model->meta().voc == model->model->meta().voc, "draft model must share the vocabulary");
+        model->model->setDrafter(std::make_unique<llaisys::models::DraftModelDrafter>(draft->model.get()), ndraft);
+    }
+
+    void llaisysQwen2ModelSetPromptLookup(struct LlaisysQwen2Model * model, size_t max_ngram, size_t ndraft) {
+        if (ndraft == 0) {
+            model->model->setDrafter(nullptr, 0);
+            return;
+        }
+        model->model->setDrafter(std::make_unique<llaisys::models::PromptLookupDrafter>(max_ngram), ndraft);
+    }
+}
@@ -11,6 +11,8 @@
 #include "../ops/rope/op.hpp"
 #include "../ops/self_attention/op.hpp"
 #include "../ops/swiglu/op.hpp"
+#include "../utils.hpp"
+#include "../utils/vmath.hpp"
 
 __C {
     void llaisysAdd(llaisysTensor_t c, llaisysTensor_t a, llaisysTensor_t b) {
@@ -23,7 +25,43 @@ __C {
         llaisys::ops::embedding(out->tensor, index->tensor, weight->tensor);
     }
     void llaisysLinear(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t weight, llaisysTensor_t bias) {
-        llaisys::ops::linear(out->tensor, in->tensor, weight->tensor, bias->tensor);
+        llaisys::ops::linear(out->tensor, in->tensor, weight->tensor, bias ? bias->tensor : nullptr);
+    }
+    void llaisysLinearAccumulate(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t weight, llaisysTensor_t bias,
+                                 llaisysLinearAccumulation_t mode) {
+        CHECK_ARGUMENT(mode == LLAISYS_LINEAR_ACCUMULATION_F32 || mode == LLAISYS_LINEAR_ACCUMULATION_KAHAN,
+                       "LinearAccumulate: unknown accumulation mode");
+        llaisys::ops::linear(out->tensor, in->tensor, weight->tensor, bias ? bias->tensor : nullptr,
+                             static_cast<llaisys::ops::LinearAccumulation>(mode));
+    }
+    void llaisysSetLinearAccumulation(llaisysLinearAccumulation_t mode) {
+        CHECK_ARGUMENT(mode == LLAISYS_LINEAR_ACCUMULATION_F32 || mode == LLAISYS_LINEAR_ACCUMULATION_KAHAN,
+                       "SetLinearAccumulation: unknown accumulation mode");
+        llaisys::ops::setLinearAccumulation(static_cast<llaisys::ops::LinearAccumulation>(mode));
+    }
+    llaisysLinearAccumulation_t llaisysGetLinearAccumulation() {
+        return static_cast<llaisysLinearAccumulation_t>(llaisys::ops::linearAccumulation());
+    }
+    void llaisysLinearLoRA(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t weight, llaisysTensor_t bias,
+                           llaisysTensor_t lora_a, llaisysTensor_t lora_b, llaisysTensor_t adapter_ids) {
+        llaisys::ops::linear_lora(out->tensor, in->tensor, weight->tensor, bias ? bias->tensor : nullptr,
+                                  lora_a->tensor, lora_b->tensor, adapter_ids->tensor);
+    }
+    void llaisysLinearSparse24(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t values,
+                               llaisysTensor_t indices, llaisysTensor_t bias) {
+        llaisys::ops::linear_sparse24(out->tensor, in->tensor, values->tensor, indices->tensor,
+                                      bias ? bias->tensor : nullptr);
+    }
+    void llaisysSparse24Compress(llaisysTensor_t values, llaisysTensor_t indices, llaisysTensor_t weight) {
+        llaisys::ops::sparse24_compress(values->tensor, indices->tensor, weight->tensor);
+    }
+    void llaisysLinearW8A8(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t qweight,
+                           llaisysTensor_t scales, llaisysTensor_t bias) {
+        llaisys::ops::linear_w8a8(out->tensor, in->tensor, qweight->tensor, scales->tensor,
+                                  bias ? bias->tensor : nullptr);
+    }
+    void llaisysW8A8Quantize(llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t weight) {
+        llaisys::ops::w8a8_quantize(qweight->tensor, scales->tensor, weight->tensor);
     }
     void llaisysRearrange(llaisysTensor_t out, llaisysTensor_t in) {
         llaisys::ops::rearrange(out->tensor, in->tensor);
@@ -37,7 +75,56 @@ __C {
     void llaisysSelfAttention(llaisysTensor_t attn_val, llaisysTensor_t q, llaisysTensor_t k, llaisysTensor_t v, float scale) {
         llaisys::ops::self_attention(attn_val->tensor, q->tensor, k->tensor, v->tensor, scale);
     }
+    void llaisysSelfAttentionWindowed(llaisysTensor_t attn_val, llaisysTensor_t q, llaisysTensor_t k, llaisysTensor_t v, float scale, size_t window, size_t sink) {
+        llaisys::ops::self_attention(attn_val->tensor, q->tensor, k->tensor, v->tensor, scale, window, sink);
+    }
+    void llaisysSelfAttentionTree(llaisysTensor_t attn_val, llaisysTensor_t q, llaisysTensor_t k, llaisysTensor_t v,
+                                  llaisysTensor_t parents, float scale) {
+        llaisys::ops::self_attention_tree(attn_val->tensor, q->tensor, k->tensor, v->tensor, parents->tensor, scale);
+    }
+    void llaisysTreePositionIds(llaisysTensor_t pos_ids, llaisysTensor_t parents, int64_t start) {
+        llaisys::ops::tree_position_ids(pos_ids->tensor, parents->tensor, start);
+    }
     void llaisysSwiGLU(llaisysTensor_t out, llaisysTensor_t gate, llaisysTensor_t up) {
         llaisys::ops::swiglu(out->tensor, gate->tensor, up->tensor);
     }
+    uint8_t llaisysVMath(llaisysTensor_t out, llaisysTensor_t in, llaisysVMathFunction_t fn, llaisysVMathIsa_t isa) {
+        namespace vmath = llaisys::utils::vmath;
+        auto &y = out->tensor;
+        auto &x = in->tensor;
+        CHECK_SAME_DEVICE(y, x);
+        CHECK_SAME_SHAPE(y->shape(), x->shape());
+        CHECK_SAME_DTYPE(y->dtype(), x->dtype(), LLAISYS_DTYPE_F32);
+        CHECK_ARGUMENT(y->deviceType() == LLAISYS_DEVICE_CPU, "VMath: tensors must be on the CPU");
+        CHECK_ARGUMENT(y->isContiguous() && x->isContiguous(), "VMath: tensors must be contiguous");
+        const auto previous = vmath::isa();
+        if (!vmath::setIsa(static_cast<vmath::Isa>(isa))) {
+            return 0;
+        }
+        auto *dst = reinterpret_cast<float *>(y->data());
+        const auto *src = reinterpret_cast<const float *>(x->data());
+        const size_t n = x->numel();
+        switch (fn) {
+        case LLAISYS_VMATH_EXP:
+            vmath::exp(dst, src, n);
+            break;
+        case LLAISYS_VMATH_SIGMOID:
+            vmath::sigmoid(dst, src, n);
+            break;
+        case LLAISYS_VMATH_SILU:
+            vmath::silu(dst, src, n);
+            break;
+        case LLAISYS_VMATH_TANH:
+            vmath::tanh(dst, src, n);
+            break;
+        case LLAISYS_VMATH_RSQRT:
+            vmath::rsqrt(dst, src, n);
+            break;
+        default:
+            vmath::setIsa(previous);
+            CHECK_ARGUMENT(false, "VMath: unknown function");
+        }
+        vmath::setIsa(previous);
+        return 1;
+    }
 }
@@ -1,6 +1,8 @@
 #include "llaisys/runtime.h"
+#include "../core/allocator/host_pool_allocator.hpp"
 #include "../core/context/context.hpp"
 #include "../device/runtime_api.hpp"
+#include "../utils/parallel.hpp"
 
 // Llaisys API for setting context runtime.
 __C void llaisysSetContextRuntime(llaisysDeviceType_t device_type, int device_id) {
@@ -10,4 +12,21 @@ __C void llaisysSetContextRuntime(llaisysDeviceType_t device_type, int device_id
 // Llaisys API for getting the runtime APIs
 __C const LlaisysRuntimeAPI *llaisysGetRuntimeAPI(llaisysDeviceType_t device_type) {
     return llaisys::device::getRuntimeAPI(device_type);
-}
\ No newline at end of file
+}
+__C void llaisysHostPoolConfigure(llaisysDeviceType_t device_type, size_t cache_limit, uint8_t lock_pages) {
+    auto pool = llaisys::core::allocators::HostPoolAllocator::shared(device_type);
+    pool->setCacheLimit(cache_limit);
+    pool->setLockPages(lock_pages != 0);
+}
+
+__C void llaisysHostPoolTrim(llaisysDeviceType_t device_type) {
+    llaisys::core::allocators::HostPoolAllocator::shared(device_type)->trim();
+}
+
+__C void llaisysSetCpuThreads(size_t nthread) {
+    llaisys::utils::setNumThreads(nthread);
+}
+
+__C size_t llaisysGetCpuThreads() {
+    return llaisys::utils::numThreads();
+}
@@ -0,0 +1,89 @@
+#include "llaisys_tokenizer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+__C {
+    struct LlaisysDetokenizer {
+        std::unique_ptr<llaisys::tokenizer::Detokenizer> detokenizer;
+    };
+}
+
+namespace {
+size_t copyOut(const std::string &s, char *out, size_t max_bytes) {
+    if (out != nullptr) {
+        std::memcpy(out, s.data(), std::min(s.size(), max_bytes));
+    }
+    return s.size();
+}
+} // namespace
+
+__C {
+    struct LlaisysTokenizer *llaisysTokenizerCreate(const char *path) {
+        auto *tokenizer = new LlaisysTokenizer;
+        tokenizer->tokenizer = std::make_unique<llaisys::tokenizer::Tokenizer>(path);
+        return tokenizer;
+    }
+
+    void llaisysTokenizerDestroy(struct LlaisysTokenizer * tokenizer) {
+        delete tokenizer;
+    }
+
+    size_t llaisysTokenizerVocabSize(struct LlaisysTokenizer * tokenizer) {
+        return tokenizer->tokenizer->vocabSize();
+    }
+
+    int64_t llaisysTokenizerTokenId(struct LlaisysTokenizer * tokenizer, const char *token) {
+        return tokenizer->tokenizer->tokenId(token);
+    }
+
+    size_t llaisysTokenizerEncode(struct LlaisysTokenizer * tokenizer, const char *text, size_t len,
+                                  int add_special_tokens, int64_t *out_tokens, size_t max_tokens) {
+        const auto ids = tokenizer->tokenizer->encode(std::string(text, len), add_special_tokens != 0);
+        if (out_tokens != nullptr) {
+            std::copy_n(ids.begin(), std::min(ids.size(), max_tokens), out_tokens);
+        }
+        return ids.size();
+    }
+
+    size_t llaisysTokenizerDecode(struct LlaisysTokenizer * tokenizer, const int64_t *tokens, size_t ntoken,
+                                  int skip_special_tokens, char *out, size_t max_bytes) {
+        return copyOut(tokenizer->tokenizer->decode(tokens, ntoken, skip_special_tokens != 0), out, max_bytes);
+    }
+
+    size_t llaisysTokenizerApplyChatTemplate(struct LlaisysTokenizer * tokenizer, const char *const *roles,
+                                             const char *const *contents, size_t nmessage,
+                                             int add_generation_prompt, char *out, size_t max_bytes) {
+        std::vector<llaisys::tokenizer::ChatMessage> messages(nmessage);
+        for (size_t i = 0; i < nmessage; i++) {
+            messages[i] = {roles[i], contents[i]};
+        }
+        return copyOut(tokenizer->tokenizer->applyChatTemplate(messages, add_generation_prompt != 0), out, max_bytes);
+    }
+
+    struct LlaisysDetokenizer *llaisysDetokenizerCreate(struct LlaisysTokenizer * tokenizer, int skip_special_tokens) {
+        auto *detokenizer = new LlaisysDetokenizer;
+        detokenizer->detokenizer = std::make_unique<llaisys::tokenizer::Detokenizer>(*tokenizer->tokenizer,
+                                                                                      skip_special_tokens != 0);
+        return detokenizer;
+    }
+
+    void llaisysDetokenizerDestroy(struct LlaisysDetokenizer * detokenizer) {
+        delete detokenizer;
+    }
+
+    const char *llaisysDetokenizerPush(struct LlaisysDetokenizer * detokenizer, int64_t token, size_t *len) {
+        const std::string &text = detokenizer->detokenizer->push(token);
+        *len = text.size();
+        return text.data();
+    }
+
+    const char *llaisysDetokenizerFlush(struct LlaisysDetokenizer * detokenizer, size_t *len) {
+        const std::string &text = detokenizer->detokenizer->flush();
+        *len = text.size();
+        return text.data();
+    }
+}
@@ -0,0 +1,468 @@
+#include "kv_cache.hpp"
+
+#include "../../utils.hpp"
+
+#include <algorithm>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace llaisys::models {
+
+KVCache::KVCache(const Config &config) : _config(config) {
+    CHECK_ARGUMENT(_config.block_size > 0, "KVCache: block_size must be positive");
+    CHECK_ARGUMENT(_config.max_blocks > 0, "KVCache: max_blocks must be positive");
+    core::context().setDevice(_config.device_type, _config.device_id);
+    _copy_stream = core::context().runtime().api()->create_stream();
+}
+
+KVCache::~KVCache() {
+    core::context().setDevice(_config.device_type, _config.device_id);
+    const auto *api = core::context().runtime().api();
+    api->stream_synchronize(_copy_stream);
+    api->destroy_stream(_copy_stream);
+    _seqs.clear();
+    _pending_free_slots.clear();
+    _closeSpillFile();
+}
+
+KVCache::Sequence &KVCache::_get(seq_t seq) {
+    auto it = _seqs.find(seq);
+    CHECK_ARGUMENT(it != _seqs.end(), "KVCache: unknown sequence");
+    return it->second;
+}
+
+const KVCache::Sequence &KVCache::_get(seq_t seq) const {
+    auto it = _seqs.find(seq);
+    CHECK_ARGUMENT(it != _seqs.end(), "KVCache: unknown sequence");
+    return it->second;
+}
+
+size_t KVCache::_rowBytes() const {
+    return _config.nkvh * _config.dh * utils::dsize(_config.dtype);
+}
+
+size_t KVCache::blockBytes() const {
+    return _config.nlayer * 2 * _config.block_size * _rowBytes();
+}
+
+std::byte *KVCache::_blockPtr(size_t block, size_t layer, size_t kv, size_t row) const {
+    return _blocks[block]->data() + ((layer * 2 + kv) * _config.block_size + row) * _rowBytes();
+}
+
+size_t KVCache::numFreeBlocks() const {
+    return _free_blocks.size() + _pending_free_blocks.size() + (_config.max_blocks - _blocks.size());
+}
+
+size_t KVCache::numBlocksFor(size_t ntoken) const {
+    return (ntoken + _config.block_size - 1) / _config.block_size;
+}
+
+void KVCache::growMaxBlocks(size_t max_blocks) {
+    _config.max_blocks = std::max(_config.max_blocks, max_blocks);
+}
+
+size_t KVCache::_allocateBlock() {
+    if (_free_blocks.empty() && _blocks.size() < _config.max_blocks) {
+        const std::vector<size_t> shape{_config.nlayer, 2, _config.block_size, _config.nkvh, _config.dh};
+        _blocks.push_back(_config.allocate_block ? _config.allocate_block(shape, _config.dtype)
+                                                 : Tensor::create(shape, _config.dtype, _config.device_type, _config.device_id));
+        _refs.push_back(1);
+        return _blocks.size() - 1;
+    }
+    if (_free_blocks.empty()) {
+        // Blocks still being read by swap-out copies become usable once those land.
+        synchronize();
+    }
+    ASSERT(!_free_blocks.empty(), "KVCache: out of blocks");
+    size_t block = _free_blocks.back();
+    _free_blocks.pop_back();
+    _refs[block] = 1;
+    return block;
+}
+
+void KVCache::_releaseBlock(size_t block, bool deferred) {
+    if (--_refs[block] > 0) {
+        return;
+    }
+    if (deferred) {
+        _pending_free_blocks.push_back(block);
+    } else {
+        _free_blocks.push_back(block);
+    }
+}
+
+KVCache::seq_t KVCache::createSequence() {
+    seq_t seq = _next_seq++;
+    _seqs.emplace(seq, Sequence{});
+    return seq;
+}
+
+void KVCache::freeSequence(seq_t seq) {
+    auto &s = _get(seq);
+    _waitCopies();
+    for (size_t block : s.blocks) {
+        _releaseBlock(block);
+    }
+    for (auto &slot : s.spilled) {
+        _releaseSlot(slot);
+    }
+    _seqs.erase(seq);
+}
+
+KVCache::seq_t KVCache::fork(seq_t seq) {
+    const auto &parent = _get(seq);
+    ASSERT(!parent.swapped, "KVCache: cannot fork a swapped-out sequence");
+    Sequence child;
+    child.blocks = parent.blocks;
+    child.length = parent.length;
+    child.evicted = parent.evicted;
+    for (size_t block : child.blocks) {
+        _refs[block]++;
+    }
+    seq_t id = _next_seq++;
+    _seqs.emplace(id, std::move(child));
+    return id;
+}
+
+bool KVCache::hasSequence(seq_t seq) const {
+    return _seqs.find(seq) != _seqs.end();
+}
+
+size_t KVCache::length(seq_t seq) const {
+    return _get(seq).length;
+}
+
+bool KVCache::empty() const {
+    for (const auto &entry : _seqs) {
+        if (entry.second.length > 0 || entry.second.evicted > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool KVCache::reserve(seq_t seq, size_t ntoken) {
+    auto &s = _get(seq);
+    ASSERT(!s.swapped, "KVCache: cannot grow a swapped-out sequence");
+    if (ntoken == 0) {
+        return true;
+    }
+    // Shared blocks in the range about to be written are copied first.
+    const size_t needed = numBlocksFor(s.length + ntoken);
+    const size_t first = s.length / _config.block_size;
+    const size_t last = std::min(needed, s.blocks.size());
+    size_t ncopy = 0;
+    for (size_t i = first; i < last; i++) {
+        ncopy += _refs[s.blocks[i]] > 1 ? 1 : 0;
+    }
+    const size_t ngrow = needed > s.blocks.size() ? needed - s.blocks.size() : 0;
+    if (ncopy + ngrow > numFreeBlocks()) {
+        return false;
+    }
+    if (ncopy > 0) {
+        _waitCopies();
+        core::context().setDevice(_config.device_type, _config.device_id);
+        const auto *api = core::context().runtime().api();
+        for (size_t i = first; i < last; i++) {
+            if (_refs[s.blocks[i]] > 1) {
+                size_t copy = _allocateBlock();
+                api->memcpy_sync(_blocks[copy]->data(), _blocks[s.blocks[i]]->data(), blockBytes(), LLAISYS_MEMCPY_D2D);
+                _releaseBlock(s.blocks[i]);
+                s.blocks[i] = copy;
+            }
+        }
+    }
+    while (s.blocks.size() < needed) {
+        s.blocks.push_back(_allocateBlock());
+    }
+    return true;
+}
+
+void KVCache::commit(seq_t seq, size_t ntoken) {
+    auto &s = _get(seq);
+    ASSERT(s.length + ntoken <= s.blocks.size() * _config.block_size, "KVCache: commit beyond reserved blocks");
+    s.length += ntoken;
+}
+
+void KVCache::truncate(seq_t seq, size_t len) {
+    auto &s = _get(seq);
+    ASSERT(!s.swapped, "KVCache: cannot truncate a swapped-out sequence");
+    CHECK_ARGUMENT(len <= s.length, "KVCache: truncate length exceeds sequence length");
+    _waitCopies();
+    s.length = len;
+    size_t keep = numBlocksFor(len);
+    while (s.blocks.size() > keep) {
+        _releaseBlock(s.blocks.back());
+        s.blocks.pop_back();
+    }
+}
+
+void KVCache::evict(seq_t seq, size_t begin, size_t count) {
+    auto &s = _get(seq);
+    ASSERT(!s.swapped, "KVCache: cannot evict from a swapped-out sequence");
+    CHECK_ARGUMENT(begin % _config.block_size == 0 && count % _config.block_size == 0,
+                   "KVCache: eviction must cover whole blocks");
+    CHECK_ARGUMENT(begin + count <= s.length, "KVCache: eviction beyond sequence length");
+    if (count == 0) {
+        return;
+    }
+    _waitCopies();
+    const auto first = s.blocks.begin() + begin / _config.block_size;
+    const auto last = first + count / _config.block_size;
+    for (auto it = first; it != last; ++it) {
+        _releaseBlock(*it);
+    }
+    s.blocks.erase(first, last);
+    s.length -= count;
+    s.evicted += count;
+}
+
+size_t KVCache::evicted(seq_t seq) const {
+    return _get(seq).evicted;
+}
+
+void KVCache::write(seq_t seq, size_t layer, size_t pos, tensor_t k, tensor_t v) {
+    auto &s = _get(seq);
+    ASSERT(!s.swapped, "KVCache: cannot write to a swapped-out sequence");
+    CHECK_SAME_DTYPE(_config.dtype, k->dtype(), v->dtype());
+    ASSERT(k->isContiguous() && v->isContiguous(), "KVCache: k and v must be contiguous");
+    const size_t n = k->shape()[0];
+    ASSERT(pos + n <= s.blocks.size() * _config.block_size, "KVCache: write beyond reserved blocks");
+    for (size_t t = pos; t < pos + n; t += _config.block_size - t % _config.block_size) {
+        ASSERT(_refs[s.blocks[t / _config.block_size]] == 1, "KVCache: write to a shared block, call reserve() first");
+    }
+    _waitCopies();
+
+    core::context().setDevice(_config.device_type, _config.device_id);
+    const auto *api = core::context().runtime().api();
+    const size_t row_bytes = _rowBytes();
+    for (size_t t = pos; t < pos + n;) {
+        size_t block = s.blocks[t / _config.block_size];
+        size_t row = t % _config.block_size;
+        size_t run = std::min(_config.block_size - row, pos + n - t);
+        api->memcpy_sync(_blockPtr(block, layer, 0, row), k->data() + (t - pos) * row_bytes, run * row_bytes, LLAISYS_MEMCPY_D2D);
+        api->memcpy_sync(_blockPtr(block, layer, 1, row), v->data() + (t - pos) * row_bytes, run * row_bytes, LLAISYS_MEMCPY_D2D);
+        t += run;
+    }
+}
+
+void KVCache::gather(seq_t seq, size_t layer, size_t len, tensor_t k, tensor_t v) {
+    auto &s = _get(seq);
+    ASSERT(!s.swapped, "KVCache: cannot read a swapped-out sequence");
+    ASSERT(len <= s.blocks.size() * _config.block_size, "KVCache: gather beyond reserved blocks");
+    ASSERT(k->shape()[0] >= len && v->shape()[0] >= len, "KVCache: gather destination too small");
+    _waitCopies();
+
+    core::context().setDevice(_config.device_type, _config.device_id);
+    const auto *api = core::context().runtime().api();
+    const size_t row_bytes = _rowBytes();
+    for (size_t t = 0; t < len;) {
+        size_t block = s.blocks[t / _config.block_size];
+        size_t run = std::min(_config.block_size, len - t);
+        api->memcpy_sync(k->data() + t * row_bytes, _blockPtr(block, layer, 0, 0), run * row_bytes, LLAISYS_MEMCPY_D2D);
+        api->memcpy_sync(v->data() + t * row_bytes, _blockPtr(block, layer, 1, 0), run * row_bytes, LLAISYS_MEMCPY_D2D);
+        t += run;
+    }
+}
+
+std::vector<std::byte *> KVCache::blockPointers(seq_t seq) {
+    auto &s = _get(seq);
+    ASSERT(!s.swapped, "KVCache: cannot access a swapped-out sequence");
+    _waitCopies();
+    std::vector<std::byte *> pointers;
+    for (size_t block : s.blocks) {
+        pointers.push_back(_blocks[block]->data());
+    }
+    return pointers;
+}
+
+// Spilled blocks are stored compacted as [nlayer, 2, ntoken, nkvh, dh], so the
+// unused tail of a partially filled block is never transferred.
+void KVCache::_copyRuns(size_t block, std::byte *compact, size_t ntoken, bool to_block) const {
+    const auto *api = core::context().runtime().api();
+    if (ntoken == _config.block_size) {
+        if (to_block) {
+            api->memcpy_async(_blocks[block]->data(), compact, blockBytes(), LLAISYS_MEMCPY_H2D, _copy_stream);
+        } else {
+            api->memcpy_async(compact, _blocks[block]->data(), blockBytes(), LLAISYS_MEMCPY_D2H, _copy_stream);
+        }
+        return;
+    }
+    const size_t run_bytes = ntoken * _rowBytes();
+    for (size_t layer = 0; layer < _config.nlayer; layer++) {
+        for (size_t kv = 0; kv < 2; kv++) {
+            std::byte *packed = compact + (layer * 2 + kv) * run_bytes;
+            if (to_block) {
+                api->memcpy_async(_blockPtr(block, layer, kv, 0), packed, run_bytes, LLAISYS_MEMCPY_H2D, _copy_stream);
+            } else {
+                api->memcpy_async(packed, _blockPtr(block, layer, kv, 0), run_bytes, LLAISYS_MEMCPY_D2H, _copy_stream);
+            }
+        }
+    }
+}
+
+std::byte *KVCache::_slotPtr(const SpillSlot &slot) const {
+    if (slot.host) {
+        return slot.host->data();
+    }
+    return _spill_base + slot.file_slot * blockBytes();
+}
+
+void KVCache::_releaseSlot(SpillSlot &slot) {
+    if (slot.host) {
+        slot.host.reset();
+    } else {
+        _free_spill_slots.push_back(slot.file_slot);
+    }
+}
+
+void KVCache::_waitCopies() {
+    if (_copies_in_flight) {
+        synchronize();
+    }
+}
+
+void KVCache::synchronize() {
+    core::context().setDevice(_config.device_type, _config.device_id);
+    core::context().runtime().api()->stream_synchronize(_copy_stream);
+    _copies_in_flight = false;
+    _free_blocks.insert(_free_blocks.end(), _pending_free_blocks.begin(), _pending_free_blocks.end());
+    _pending_free_blocks.clear();
+    for (auto &slot : _pending_free_slots) {
+        _releaseSlot(slot);
+    }
+    _pending_free_slots.clear();
+}
+
+bool KVCache::swapOut(seq_t seq) {
+    auto &s = _get(seq);
+    ASSERT(!s.swapped, "KVCache: sequence is already swapped out");
+    const size_t used_blocks = numBlocksFor(s.length);
+    if (_spill_base != nullptr && _free_spill_slots.size() < used_blocks) {
+        return false;
+    }
+
+    // Host spill buffers come from the runtime's staging pool, so repeated
+    // swaps reuse the same (pinned, already faulted-in) pages.
+    core::context().setDevice(_config.device_type, _config.device_id);
+    std::vector<SpillSlot> spilled;
+    spilled.reserve(used_blocks);
+    for (size_t i = 0; i < used_blocks; i++) {
+        SpillSlot slot{nullptr, 0, std::min(_config.block_size, s.length - i * _config.block_size)};
+        if (_spill_base != nullptr) {
+            slot.file_slot = _free_spill_slots.back();
+            _free_spill_slots.pop_back();
+        } else {
+            slot.host = Tensor::createHost({slot.ntoken * _config.nlayer * 2 * _rowBytes()}, LLAISYS_DTYPE_BYTE);
+        }
+        spilled.push_back(slot);
+    }
+
+    for (size_t i = 0; i < used_blocks; i++) {
+        _copyRuns(s.blocks[i], _slotPtr(spilled[i]), spilled[i].ntoken, false);
+    }
+    // Device blocks are recycled only after the copies reading them have finished.
+    for (size_t block : s.blocks) {
+        _releaseBlock(block, true);
+    }
+    _copies_in_flight = _copies_in_flight || used_blocks > 0;
+    s.blocks.clear();
+    s.spilled = std::move(spilled);
+    s.swapped = true;
+    return true;
+}
+
+bool KVCache::swapIn(seq_t seq) {
+    auto &s = _get(seq);
+    ASSERT(s.swapped, "KVCache: sequence is not swapped out");
+    if (s.spilled.size() > numFreeBlocks()) {
+        return false;
+    }
+
+    std::vector<size_t> blocks;
+    blocks.reserve(s.spilled.size());
+    for (size_t i = 0; i < s.spilled.size(); i++) {
+        blocks.push_back(_allocateBlock());
+    }
+
+    core::context().setDevice(_config.device_type, _config.device_id);
+#ifndef _WIN32
+    if (_spill_base != nullptr) {
+        for (const auto &slot : s.spilled) {
+            madvise(_slotPtr(slot), blockBytes(), MADV_WILLNEED);
+        }
+    }
+#endif
+    for (size_t i = 0; i < blocks.size(); i++) {
+        _copyRuns(blocks[i], _slotPtr(s.spilled[i]), s.spilled[i].ntoken, true);
+    }
+    // Spill slots stay alive until the copies reading them have finished.
+    _pending_free_slots.insert(_pending_free_slots.end(), s.spilled.begin(), s.spilled.end());
+    _copies_in_flight = _copies_in_flight || !blocks.empty();
+    s.spilled.clear();
+    s.blocks = std::move(blocks);
+    s.swapped = false;
+    return true;
+}
+
+bool KVCache::isSwapped(seq_t seq) const {
+    return _get(seq).swapped;
+}
+
+void KVCache::setSpillFile(const std::string &path, size_t capacity) {
+    for (const auto &entry : _seqs) {
+        ASSERT(!entry.second.swapped, "KVCache: cannot change spill target while sequences are swapped out");
+    }
+    _waitCopies();
+    _closeSpillFile();
+#ifdef _WIN32
+    (void)path;
+    (void)capacity;
+    throw std::runtime_error("KVCache: file spill is only supported on POSIX hosts");
+#else
+    const size_t nslots = capacity / blockBytes();
+    CHECK_ARGUMENT(nslots > 0, "KVCache: spill file capacity is smaller than one block");
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    ASSERT(fd >= 0, "KVCache: failed to open spill file");
+    const size_t bytes = nslots * blockBytes();
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        close(fd);
+        ASSERT(false, "KVCache: failed to size spill file");
+    }
+    void *base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        ASSERT(false, "KVCache: failed to mmap spill file");
+    }
+    // The spill file is scratch space; unlink it so nothing is left behind on exit.
+    unlink(path.c_str());
+    _spill_fd = fd;
+    _spill_path = path;
+    _spill_base = static_cast<std::byte *>(base);
+    _spill_capacity = bytes;
+    _free_spill_slots.clear();
+    for (size_t i = nslots; i-- > 0;) {
+        _free_spill_slots.push_back(i);
+    }
+#endif
+}
+
+void KVCache::_closeSpillFile() {
+#ifndef _WIN32
+    if (_spill_base != nullptr) {
+        munmap(_spill_base, _spill_capacity);
+        close(_spill_fd);
+    }
+#endif
+    _spill_base = nullptr;
+    _spill_capacity = 0;
+    _spill_fd = -1;
+    _spill_path.clear();
+    _free_spill_slots.clear();
+}
+
+} // namespace llaisys::models
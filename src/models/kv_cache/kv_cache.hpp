@@ -0,0 +1,151 @@
+#pragma once
+
+#include "../../tensor/tensor.hpp"
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace llaisys::models {
+
+// Block-paged key/value cache shared by all sequences of a model.
+//
+// Each block holds `block_size` tokens of K and V for every layer, laid out as
+// [nlayer, 2, block_size, nkvh, dh], so a whole block can be moved with a single
+// copy. Blocks are allocated lazily up to `max_blocks` and recycled through a
+// free list. Sequences own an ordered list of blocks (their block table).
+//
+// Blocks are reference counted: fork() shares all blocks of a sequence, and a
+// shared block is copied only when one of its owners writes into it (reserve()
+// performs the copy-on-write).
+//
+// Long-running streams can evict whole blocks from the middle of a sequence
+// (e.g. everything between the attention sinks and the recent window).
+//
+// When the pool runs dry, idle sequences can be swapped out: their blocks are
+// copied to a host spill area (or an mmap'd spill file) on a dedicated copy
+// stream and the device blocks are returned to the pool once the copies land.
+class KVCache {
+public:
+    using seq_t = int64_t;
+
+    struct Config {
+        size_t nlayer;
+        size_t nkvh;
+        size_t dh;
+        llaisysDataType_t dtype;
+        size_t block_size;
+        size_t max_blocks;
+        llaisysDeviceType_t device_type;
+        int device_id;
+        // Allocates block storage; Tensor::create on the device when empty.
+        std::function<tensor_t(const std::vector<size_t> &shape, llaisysDataType_t dtype)> allocate_block = nullptr;
+    };
+
+    KVCache(const Config &config);
+    ~KVCache();
+
+    KVCache(const KVCache &) = delete;
+    KVCache &operator=(const KVCache &) = delete;
+
+    const Config &config() const { return _config; }
+
+    // Sequence management
+    seq_t createSequence();
+    // New sequence sharing all of `seq`'s blocks copy-on-write.
+    seq_t fork(seq_t seq);
+    void freeSequence(seq_t seq);
+    bool hasSequence(seq_t seq) const;
+    size_t length(seq_t seq) const;
+    // True when no sequence holds or has evicted any token.
+    bool empty() const;
+
+    // Make sure `seq` has exclusively owned blocks for `ntoken` more tokens. Returns
+    // false and leaves the sequence untouched if the pool cannot satisfy the request.
+    bool reserve(seq_t seq, size_t ntoken);
+    // Advance the committed length of `seq` after all layers have been written.
+    void commit(seq_t seq, size_t ntoken);
+    // Drop everything after the first `len` tokens and release unused blocks.
+    void truncate(seq_t seq, size_t len);
+    // Streaming eviction: drop the `count` committed tokens starting at `begin` (both whole
+    // blocks) and shift the later tokens down. Only the block table changes.
+    void evict(seq_t seq, size_t begin, size_t count);
+    // Total number of tokens evicted from `seq`, i.e. the offset from cache rows to stream positions.
+    size_t evicted(seq_t seq) const;
+
+    // Write `k`/`v` ([n, nkvh, dh]) for `layer` starting at token `pos`.
+    void write(seq_t seq, size_t layer, size_t pos, tensor_t k, tensor_t v);
+    // Copy the first `len` tokens of `layer` into contiguous `k`/`v` ([>=len, nkvh, dh]).
+    void gather(seq_t seq, size_t layer, size_t len, tensor_t k, tensor_t v);
+    // Data of `seq`'s blocks in order, for readers and writers that address the block
+    // layout themselves (e.g. tensor-parallel ranks that each own a range of heads).
+    // Call reserve() first when writing.
+    std::vector<std::byte *> blockPointers(seq_t seq);
+
+    // Block pool accounting
+    size_t blockBytes() const;
+    size_t numFreeBlocks() const;
+    size_t numBlocksFor(size_t ntoken) const;
+    // Raise the allocation cap; blocks are still only allocated on demand.
+    void growMaxBlocks(size_t max_blocks);
+
+    // Swap out to host / disk
+    // Spill swapped blocks into an mmap'd file of `capacity` bytes instead of host memory.
+    void setSpillFile(const std::string &path, size_t capacity);
+    // Returns false if the spill file is full.
+    bool swapOut(seq_t seq);
+    // Page a swapped sequence back in. Returns false if the pool is too full.
+    bool swapIn(seq_t seq);
+    bool isSwapped(seq_t seq) const;
+    // Wait for outstanding swap copies and recycle blocks they were reading.
+    void synchronize();
+
+private:
+    struct SpillSlot {
+        tensor_t host;    // host spill buffer, or null when spilled to file
+        size_t file_slot; // slot index in the spill file
+        size_t ntoken;    // tokens of the block that are actually stored
+    };
+
+    struct Sequence {
+        std::vector<size_t> blocks;
+        std::vector<SpillSlot> spilled;
+        size_t length = 0;
+        size_t evicted = 0;
+        bool swapped = false;
+    };
+
+    Config _config;
+    std::vector<tensor_t> _blocks;
+    std::vector<size_t> _refs;
+    std::vector<size_t> _free_blocks;
+    std::vector<size_t> _pending_free_blocks;
+    std::vector<SpillSlot> _pending_free_slots;
+    bool _copies_in_flight = false;
+    std::unordered_map<seq_t, Sequence> _seqs;
+    seq_t _next_seq = 0;
+    llaisysStream_t _copy_stream;
+
+    // mmap'd spill file
+    std::string _spill_path;
+    std::byte *_spill_base = nullptr;
+    size_t _spill_capacity = 0;
+    std::vector<size_t> _free_spill_slots;
+    int _spill_fd = -1;
+
+    Sequence &_get(seq_t seq);
+    const Sequence &_get(seq_t seq) const;
+    size_t _rowBytes() const;
+    std::byte *_blockPtr(size_t block, size_t layer, size_t kv, size_t row) const;
+    size_t _allocateBlock();
+    // Drop one reference; `deferred` holds the block back until pending copies finish.
+    void _releaseBlock(size_t block, bool deferred = false);
+    void _copyRuns(size_t block, std::byte *compact, size_t ntoken, bool to_block) const;
+    std::byte *_slotPtr(const SpillSlot &slot) const;
+    void _releaseSlot(SpillSlot &slot);
+    void _waitCopies();
+    void _closeSpillFile();
+};
+
+} // namespace llaisys::models
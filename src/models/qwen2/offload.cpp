@@ -0,0 +1,64 @@
+#include "offload.hpp"
+
+#include <algorithm>
+
+namespace llaisys::models {
+
+namespace {
+size_t wholePages(size_t bytes) {
+    const size_t page = utils::MappedFile::pageSize();
+    return (bytes + page - 1) / page * page;
+}
+} // namespace
+
+WeightOffload::WeightOffload(const std::string &path, size_t nlayer, size_t layer_bytes, size_t prefetch)
+    : _file(path, nlayer * wholePages(layer_bytes)),
+      _nlayer(nlayer),
+      _layer_bytes(layer_bytes),
+      _stride(wholePages(layer_bytes)),
+      _prefetch(nlayer > 0 ? std::min(prefetch, nlayer - 1) : 0),
+      _thread([this] { _readAhead(); }) {}
+
+WeightOffload::~WeightOffload() {
+    _queue.close();
+    _thread.join();
+}
+
+void WeightOffload::beginLayer(size_t layer) {
+    if (!_started) {
+        // The weights were loaded through the mapping; written back, every
+        // release below can drop them from memory.
+        _file.release(0, _file.size());
+        _started = true;
+    } else if (layer == 0) {
+        _forward_base += _nlayer;
+    }
+    const size_t position = _forward_base + layer;
+    _position.store(position);
+    // The current layer too: read in by the thread while compute faults in its start.
+    for (size_t p = std::max(_requested, position); p <= position + _prefetch; p++) {
+        _queue.push(p);
+    }
+    _requested = std::max(_requested, position + _prefetch + 1);
+}
+
+void WeightOffload::endLayer(size_t layer) {
+    _file.release(layer * _stride, _layer_bytes);
+}
+
+void WeightOffload::_readAhead() {
+    size_t position;
+    for (;;) {
+        _queue.wait();
+        while (_queue.pop(position)) {
+            if (!_queue.closed() && position >= _position.load()) {
+                _file.prefetch(position % _nlayer * _stride, _layer_bytes);
+            }
+        }
+        if (_queue.closed()) {
+            return;
+        }
+    }
+}
+
+} // namespace llaisys::models
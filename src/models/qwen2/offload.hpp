@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../../utils/channel.hpp"
+#include "../../utils/mapped_file.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+
+namespace llaisys::models {
+
+// Layer-by-layer weight streaming for models larger than memory. The weights
+// of every layer live in a MappedFile, one page-aligned region per layer.
+// While layer i runs, a background thread reads layers i+1 .. i+prefetch in
+// from disk; each layer is dropped from memory as soon as the forward is done
+// with it. So about prefetch + 1 layers are resident at a time, and the reads
+// overlap with compute.
+//
+// Layers are streamed cyclically: near the last layer the first ones are read
+// for the next forward, which decode always follows with. Prefetch requests
+// the forward has already passed by the time the thread gets to them are
+// skipped, so a slow disk never builds up a backlog.
+class WeightOffload {
+public:
+    // `layer_bytes` per layer; `prefetch` is capped at nlayer - 1.
+    WeightOffload(const std::string &path, size_t nlayer, size_t layer_bytes, size_t prefetch);
+    ~WeightOffload();
+
+    WeightOffload(const WeightOffload &) = delete;
+    WeightOffload &operator=(const WeightOffload &) = delete;
+
+    // Start of layer `layer`'s region, page aligned.
+    std::byte *layer(size_t layer) const { return _file.data() + layer * _stride; }
+    size_t prefetchDepth() const { return _prefetch; }
+
+    // Forward hooks, called by the compute thread around each layer in order.
+    // The first beginLayer writes the loaded weights back and drops them all.
+    void beginLayer(size_t layer);
+    void endLayer(size_t layer);
+
+private:
+    utils::MappedFile _file;
+    size_t _nlayer;
+    size_t _layer_bytes;
+    size_t _stride; // layer_bytes rounded up to pages
+    size_t _prefetch;
+    bool _started = false;
+    // Positions count layers over all forwards: forward f, layer i is f * nlayer + i.
+    size_t _forward_base = 0;
+    size_t _requested = 0; // prefetches queued below this position
+    std::atomic<size_t> _position{0}; // layer being computed
+    utils::MpscQueue<size_t> _queue;  // positions to read in
+    std::thread _thread;
+
+    void _readAhead();
+};
+
+} // namespace llaisys::models
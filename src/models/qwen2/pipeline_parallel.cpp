@@ -0,0 +1,239 @@
+#include "pipeline_parallel.hpp"
+
+#include "../../ops/add/op.hpp"
+#include "../../ops/embedding/op.hpp"
+#include "../../utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace llaisys::models {
+
+namespace {
+// Pushed instead of a slot index to stop every stage in turn.
+constexpr uint32_t STOP = UINT32_MAX;
+} // namespace
+
+struct PipelineParallel::Header {
+    utils::ProcessBarrier ready; // parent and stages, once the weights are touched
+    // Sliding-window settings, which may change after the workers were forked.
+    size_t window = 0;
+    size_t sink = 0;
+    size_t first_layer = 0;
+
+    explicit Header(uint32_t nstage) : ready(nstage + 1) {}
+};
+
+struct PipelineParallel::MicroBatch {
+    size_t ntoken;
+    size_t nchunk;
+    size_t nrow;
+    int64_t tokens[MAX_MICRO_TOKENS];
+    int64_t positions[MAX_MICRO_TOKENS];
+    WorkerChunk chunks[MAX_MICRO_TOKENS];
+};
+
+static_assert(PipelineParallel::MAX_IN_FLIGHT <= utils::SpscRing::CAPACITY,
+              "PipelineParallel: pushes must never wait on a full ring");
+
+PipelineParallel::PipelineParallel(Qwen2 &model, utils::SharedRegion &region, const std::vector<int> &nodes)
+    : _model(model), _nodes(nodes) {
+    const auto &meta = model._meta;
+    const size_t n = nodes.size();
+    CHECK_ARGUMENT(n > 1, "PipelineParallel: needs at least two stages");
+    CHECK_ARGUMENT(model._device_type == LLAISYS_DEVICE_CPU, "PipelineParallel: only CPU models are supported");
+    CHECK_ARGUMENT(n <= meta.nlayer, "PipelineParallel: more stages than layers");
+    for (size_t s = 0; s <= n; s++) {
+        _layers.push_back(meta.nlayer * s / n);
+    }
+    const size_t esize = utils::dsize(meta.dtype);
+    const size_t max_blocks = (meta.maxseq + Qwen2::KV_BLOCK_SIZE - 1) / Qwen2::KV_BLOCK_SIZE;
+    _max_block_ptrs = std::max<size_t>(size_t(1) << 12, 2 * max_blocks);
+    _header = new (region.allocate(sizeof(Header))) Header(static_cast<uint32_t>(n));
+    _rings = reinterpret_cast<utils::SpscRing *>(region.allocate((n + 1) * sizeof(utils::SpscRing)));
+    for (size_t i = 0; i <= n; i++) {
+        new (&_rings[i]) utils::SpscRing();
+    }
+    _micro = reinterpret_cast<MicroBatch *>(region.allocate(MAX_IN_FLIGHT * sizeof(MicroBatch)));
+    _block_ptrs = reinterpret_cast<std::byte **>(region.allocate(MAX_IN_FLIGHT * _max_block_ptrs * sizeof(std::byte *)));
+    _activations = region.allocate(MAX_IN_FLIGHT * MAX_MICRO_TOKENS * meta.hs * esize);
+    _logits = region.allocate(MAX_IN_FLIGHT * MAX_MICRO_TOKENS * meta.voc * esize);
+
+    _workers.spawn(n, [this](size_t stage) { _stageMain(stage); });
+    _header->ready.wait([this] { _workers.check(); });
+}
+
+PipelineParallel::~PipelineParallel() {
+    _shutdown();
+}
+
+void PipelineParallel::_shutdown() {
+    if (!_workers.failed() && _workers.size() > 0) {
+        try {
+            auto check = [this] { _workers.check(); };
+            _rings[0].push(STOP, check);
+            while (_rings[size()].pop(check) != STOP) {
+            }
+        } catch (...) {
+        }
+    }
+    _workers.reap();
+}
+
+tensor_t PipelineParallel::forward(const std::vector<Qwen2::Chunk> &chunks) {
+    CHECK_ARGUMENT(!_workers.failed(), "PipelineParallel: a worker failed, the model is unusable");
+    const auto &meta = _model._meta;
+    const size_t n = size();
+    const size_t row_bytes = meta.voc * utils::dsize(meta.dtype);
+    _header->window = _model._window;
+    _header->sink = _model._sink;
+    _header->first_layer = _model._window_first_layer;
+
+    size_t ntoken = 0;
+    size_t nrows = 0;
+    for (const auto &chunk : chunks) {
+        ntoken += chunk.ntoken;
+        nrows += chunk.all_logits ? chunk.ntoken : 1;
+    }
+    auto logits = _model._tensor({nrows, meta.voc}, meta.dtype);
+    // About two micro-batches per stage keep every stage busy without making
+    // them so small that per-hop overhead dominates.
+    const size_t cap = std::clamp<size_t>((ntoken + 2 * n - 1) / (2 * n), 1, MAX_MICRO_TOKENS);
+
+    auto check = [this] { _workers.check(); };
+    // Slots are used round-robin and come back in order, so the next slot is
+    // free once the micro-batch MAX_IN_FLIGHT before it has been received.
+    std::vector<size_t> out_rows(MAX_IN_FLIGHT);
+    size_t submitted = 0;
+    size_t received = 0;
+    size_t out_row = 0;
+    auto receive = [&]() {
+        const uint32_t slot = _rings[n].pop(check);
+        const MicroBatch &mb = _micro[slot];
+        std::memcpy(logits->data() + out_rows[slot] * row_bytes, _logits + slot * MAX_MICRO_TOKENS * row_bytes,
+                    mb.nrow * row_bytes);
+        received++;
+    };
+    MicroBatch *mb = nullptr;
+    size_t nblock_ptrs = 0;
+    auto acquire = [&]() {
+        if (submitted - received == MAX_IN_FLIGHT) {
+            receive();
+        }
+        mb = &_micro[submitted % MAX_IN_FLIGHT];
+        mb->ntoken = 0;
+        mb->nchunk = 0;
+        mb->nrow = 0;
+        nblock_ptrs = 0;
+    };
+    auto submit = [&]() {
+        if (mb == nullptr || mb->ntoken == 0) {
+            return;
+        }
+        const uint32_t slot = static_cast<uint32_t>(submitted % MAX_IN_FLIGHT);
+        out_rows[slot] = out_row;
+        out_row += mb->nrow;
+        _rings[0].push(slot, check);
+        submitted++;
+        mb = nullptr;
+    };
+
+    for (const auto &chunk : chunks) {
+        const auto blocks = _model._cache->blockPointers(chunk.seq);
+        ASSERT(blocks.size() <= _max_block_ptrs, "PipelineParallel: sequence has too many KV blocks");
+        const size_t past = _model._cache->length(chunk.seq);
+        const size_t evicted = _model._cache->evicted(chunk.seq);
+        for (size_t done = 0; done < chunk.ntoken;) {
+            if (mb != nullptr && (mb->ntoken == cap || nblock_ptrs + blocks.size() > _max_block_ptrs)) {
+                submit();
+            }
+            if (mb == nullptr) {
+                acquire();
+            }
+            const size_t slot = submitted % MAX_IN_FLIGHT;
+            const size_t count = std::min(chunk.ntoken - done, cap - mb->ntoken);
+            const bool last = done + count == chunk.ntoken;
+            auto &desc = mb->chunks[mb->nchunk++];
+            desc.offset = mb->ntoken;
+            desc.ntoken = count;
+            desc.past = past + done;
+            desc.block_begin = nblock_ptrs;
+            desc.nrow = chunk.all_logits ? count : last ? 1 : 0;
+            std::copy(blocks.begin(), blocks.end(), _block_ptrs + slot * _max_block_ptrs + nblock_ptrs);
+            nblock_ptrs += blocks.size();
+            for (size_t i = 0; i < count; i++) {
+                mb->tokens[desc.offset + i] = chunk.tokens[done + i];
+                mb->positions[desc.offset + i] = static_cast<int64_t>(evicted + past + done + i);
+            }
+            mb->ntoken += count;
+            mb->nrow += desc.nrow;
+            done += count;
+        }
+    }
+    submit();
+    while (received < submitted) {
+        receive();
+    }
+    return logits;
+}
+
+void PipelineParallel::_stageMain(size_t stage) {
+    auto orphaned = [this] { _workers.exitIfOrphaned(); };
+    pinToNumaNode(_nodes[stage]);
+    // First touch places this stage's layers on its node.
+    const auto &w = _model._weights;
+    for (size_t layer = _layers[stage]; layer < _layers[stage + 1]; layer++) {
+        for (const auto *list : {&w.attn_norm_w, &w.attn_q_w, &w.attn_q_b, &w.attn_k_w, &w.attn_k_b, &w.attn_v_w,
+                                 &w.attn_v_b, &w.attn_o_w, &w.mlp_norm_w, &w.mlp_gate_w, &w.mlp_up_w, &w.mlp_down_w}) {
+            firstTouch((*list)[layer]);
+        }
+    }
+    if (stage == 0) {
+        firstTouch(w.in_embed);
+    }
+    if (stage + 1 == size()) {
+        firstTouch(w.out_norm_w);
+        firstTouch(w.out_embed);
+    }
+    _header->ready.wait(orphaned);
+
+    for (;;) {
+        const uint32_t slot = _rings[stage].pop(orphaned);
+        if (slot != STOP) {
+            _forwardStage(stage, slot);
+        }
+        _rings[stage + 1].push(slot, orphaned);
+        if (slot == STOP) {
+            return;
+        }
+    }
+}
+
+void PipelineParallel::_forwardStage(size_t stage, uint32_t slot) {
+    const auto &meta = _model._meta;
+    const auto &w = _model._weights;
+    const MicroBatch &mb = _micro[slot];
+    const Header &header = *_header;
+    const size_t hs = meta.hs;
+    const size_t esize = utils::dsize(meta.dtype);
+    const WorkerBatch batch{mb.ntoken, mb.nchunk, mb.positions, mb.chunks, _block_ptrs + slot * _max_block_ptrs,
+                            header.window, header.sink, header.first_layer};
+
+    // The activations stay in the slot and are updated in place by every stage.
+    auto x = Tensor::wrap({mb.ntoken, hs}, meta.dtype, _activations + slot * MAX_MICRO_TOKENS * hs * esize);
+    if (stage == 0) {
+        auto index = Tensor::wrap({mb.ntoken}, LLAISYS_DTYPE_I64,
+                                  reinterpret_cast<std::byte *>(const_cast<int64_t *>(mb.tokens)));
+        ops::embedding(x, index, w.in_embed);
+    }
+    auto partial = Tensor::create({mb.ntoken, hs}, meta.dtype);
+    forwardLayers(meta, w, batch, _layers[stage], _layers[stage + 1], 0, 1, x, partial,
+                  [&] { ops::add(x, x, partial); });
+    if (stage + 1 == size()) {
+        auto logits = Tensor::wrap({mb.nrow, meta.voc}, meta.dtype, _logits + slot * MAX_MICRO_TOKENS * meta.voc * esize);
+        forwardHead(meta, w, batch, x, 0, meta.voc, logits);
+    }
+}
+
+} // namespace llaisys::models
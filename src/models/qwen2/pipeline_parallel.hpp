@@ -0,0 +1,72 @@
+#pragma once
+
+#include "qwen2.hpp"
+#include "worker.hpp"
+
+#include "../../utils/shm.hpp"
+
+#include <vector>
+
+namespace llaisys::models {
+
+// Pipeline-parallel execution of a CPU Qwen2 across worker processes, one
+// stage per NUMA node, all sharing the weights and KV blocks through a
+// SharedRegion.
+//
+// Stage s of N owns layers [s*nlayer/N, (s+1)*nlayer/N); stage 0 also runs the
+// embedding and the last stage the final norm and LM head. A forward is cut
+// into micro-batches of at most MAX_MICRO_TOKENS tokens (a long chunk being
+// split causally) that flow down the stages, so all stages work at once on
+// different micro-batches. Activations stay in shared micro-batch slots and
+// only slot indices travel, through one lock-free SPSC ring per hop: parent ->
+// stage 0 -> ... -> stage N-1 -> parent. Unlike TensorParallel there is no
+// per-layer synchronization, only one hand-off per stage and micro-batch.
+//
+// The owning Qwen2 keeps the KV cache bookkeeping; each stage reads and writes
+// whole KV rows of its own layers. Pieces of one chunk go through every stage
+// in order, so a piece always sees the rows of the pieces before it.
+class PipelineParallel {
+public:
+    static constexpr size_t MAX_MICRO_TOKENS = 256;
+    // Micro-batch slots, and so micro-batches in flight; fits any SpscRing.
+    static constexpr size_t MAX_IN_FLIGHT = 16;
+
+    // `nodes[s]` is the NUMA node stage s is pinned to (ignored where the
+    // topology is not exposed). Forks the workers, which pre-fault their
+    // layers' weights on their own node before the weights are loaded.
+    PipelineParallel(Qwen2 &model, utils::SharedRegion &region, const std::vector<int> &nodes);
+    ~PipelineParallel();
+
+    PipelineParallel(const PipelineParallel &) = delete;
+    PipelineParallel &operator=(const PipelineParallel &) = delete;
+
+    size_t size() const { return _nodes.size(); }
+
+    // Same contract as Qwen2::forward, with the chunks already reserved in the
+    // cache; the caller commits them afterwards.
+    tensor_t forward(const std::vector<Qwen2::Chunk> &chunks);
+
+private:
+    struct Header;
+    struct MicroBatch;
+
+    Qwen2 &_model;
+    std::vector<int> _nodes;
+    std::vector<size_t> _layers; // stage s runs [_layers[s], _layers[s + 1])
+    WorkerProcesses _workers;
+
+    // Shared state, laid out once at construction.
+    Header *_header;
+    utils::SpscRing *_rings; // N + 1 hops
+    MicroBatch *_micro;      // MAX_IN_FLIGHT slots
+    std::byte **_block_ptrs; // MAX_IN_FLIGHT slots of _max_block_ptrs
+    size_t _max_block_ptrs;
+    std::byte *_activations; // MAX_IN_FLIGHT slots of [MAX_MICRO_TOKENS, hs]
+    std::byte *_logits;      // MAX_IN_FLIGHT slots of [MAX_MICRO_TOKENS, voc]
+
+    void _shutdown();
+    void _stageMain(size_t stage);
+    void _forwardStage(size_t stage, uint32_t slot);
+};
+
+} // namespace llaisys::models
@@ -0,0 +1,457 @@
+#include "qwen2.hpp"
+#include "offload.hpp"
+#include "pipeline_parallel.hpp"
+#include "speculative.hpp"
+#include "tensor_parallel.hpp"
+#include "worker.hpp"
+
+#include "../../ops/add/op.hpp"
+#include "../../ops/embedding/op.hpp"
+#include "../../utils.hpp"
+
+#include <tuple>
+
+namespace llaisys::models {
+
+Qwen2::Qwen2(const LlaisysQwen2Meta &meta, llaisysDeviceType_t device_type, int device_id)
+    : Qwen2(meta, device_type, std::vector<int>{device_id}) {}
+
+Qwen2::Qwen2(const LlaisysQwen2Meta &meta, llaisysDeviceType_t device_type, const std::vector<int> &device_ids,
+             Parallel mode)
+    : Qwen2(meta, device_type, device_ids, mode, Offload{}) {}
+
+Qwen2::Qwen2(const LlaisysQwen2Meta &meta, llaisysDeviceType_t device_type, const std::vector<int> &device_ids,
+             Parallel mode, const Offload &offload)
+    : _meta(meta), _device_type(device_type), _device_id(device_ids.empty() ? 0 : device_ids[0]) {
+    CHECK_ARGUMENT(meta.nh % meta.nkvh == 0, "Qwen2: nh must be a multiple of nkvh");
+    CHECK_ARGUMENT(meta.maxseq > 0, "Qwen2: maxseq must be positive");
+    CHECK_ARGUMENT(!device_ids.empty(), "Qwen2: no device ids");
+    const bool parallel = device_ids.size() > 1;
+    if (parallel) {
+        CHECK_ARGUMENT(device_type == LLAISYS_DEVICE_CPU, "Qwen2: multi-device parallelism is only supported on CPU");
+        if (mode == Parallel::TENSOR) {
+            CHECK_ARGUMENT(meta.nh % device_ids.size() == 0 && meta.nkvh % device_ids.size() == 0 && meta.di % device_ids.size() == 0,
+                           "Qwen2: nh, nkvh and di must be divisible by the number of devices");
+        } else {
+            CHECK_ARGUMENT(device_ids.size() <= meta.nlayer, "Qwen2: more pipeline stages than layers");
+        }
+        // Address space only; pages are committed as weights and KV blocks are touched.
+        _shared = std::make_unique<utils::SharedRegion>(utils::physicalMemory());
+        _device_id = 0;
+    }
+
+    const size_t nlayer = meta.nlayer;
+    const auto dtype = meta.dtype;
+    _weights.in_embed = _sharedTensor({meta.voc, meta.hs}, dtype);
+    _weights.out_embed = _sharedTensor({meta.voc, meta.hs}, dtype);
+    _weights.out_norm_w = _sharedTensor({meta.hs}, dtype);
+    // Every per-layer weight, in storage order.
+    const std::pair<std::vector<tensor_t> *, std::vector<size_t>> layer_weights[] = {
+        {&_weights.attn_norm_w, {meta.hs}},
+        {&_weights.attn_q_w, {meta.nh * meta.dh, meta.hs}},
+        {&_weights.attn_q_b, {meta.nh * meta.dh}},
+        {&_weights.attn_k_w, {meta.nkvh * meta.dh, meta.hs}},
+        {&_weights.attn_k_b, {meta.nkvh * meta.dh}},
+        {&_weights.attn_v_w, {meta.nkvh * meta.dh, meta.hs}},
+        {&_weights.attn_v_b, {meta.nkvh * meta.dh}},
+        {&_weights.attn_o_w, {meta.hs, meta.nh * meta.dh}},
+        {&_weights.mlp_norm_w, {meta.hs}},
+        {&_weights.mlp_gate_w, {meta.di, meta.hs}},
+        {&_weights.mlp_up_w, {meta.di, meta.hs}},
+        {&_weights.mlp_down_w, {meta.hs, meta.di}},
+    };
+    // Offloaded weights are laid out back to back in their layer's region.
+    auto offloadBytes = [&](const std::vector<size_t> &shape) {
+        size_t numel = 1;
+        for (size_t dim : shape) {
+            numel *= dim;
+        }
+        return (numel * utils::dsize(dtype) + 63) / 64 * 64;
+    };
+    if (!offload.path.empty()) {
+        CHECK_ARGUMENT(!parallel && device_type == LLAISYS_DEVICE_CPU, "Qwen2: weight offload needs a single CPU device");
+        size_t layer_bytes = 0;
+        for (const auto &[list, shape] : layer_weights) {
+            layer_bytes += offloadBytes(shape);
+        }
+        _offload = std::make_unique<WeightOffload>(offload.path, nlayer, layer_bytes, offload.prefetch);
+    }
+    for (size_t i = 0; i < nlayer; i++) {
+        size_t offset = 0;
+        for (const auto &[list, shape] : layer_weights) {
+            if (_offload) {
+                list->push_back(Tensor::wrap(shape, dtype, _offload->layer(i) + offset));
+                offset += offloadBytes(shape);
+            } else {
+                list->push_back(_sharedTensor(shape, dtype));
+            }
+        }
+    }
+
+    // Blocks are allocated on demand, so the cap only bounds the worst case.
+    KVCache::Config cache_config{nlayer, meta.nkvh, meta.dh, dtype, KV_BLOCK_SIZE,
+                                 (meta.maxseq + KV_BLOCK_SIZE - 1) / KV_BLOCK_SIZE,
+                                 device_type, _device_id};
+    if (_shared) {
+        cache_config.allocate_block = [this](const std::vector<size_t> &shape, llaisysDataType_t dtype) {
+            return _sharedTensor(shape, dtype);
+        };
+    }
+    _cache = std::make_unique<KVCache>(cache_config);
+    if (parallel && mode == Parallel::TENSOR) {
+        _tp = std::make_unique<TensorParallel>(*this, *_shared, device_ids);
+    } else if (parallel) {
+        _pp = std::make_unique<PipelineParallel>(*this, *_shared, device_ids);
+    }
+}
+
+Qwen2::~Qwen2() = default;
+
+void Qwen2::enableLoRA(size_t max_adapters, size_t max_rank) {
+    CHECK_ARGUMENT(max_adapters > 0 && max_rank > 0, "Qwen2: LoRA needs at least one adapter of rank >= 1");
+    CHECK_ARGUMENT(_lora_adapters == 0, "Qwen2: LoRA is already enabled");
+    CHECK_ARGUMENT(!_shared, "Qwen2: LoRA is not supported across worker processes");
+    const size_t q_dim = _meta.nh * _meta.dh;
+    const size_t kv_dim = _meta.nkvh * _meta.dh;
+    std::vector<std::byte> zeros;
+    auto zeroed = [&](size_t rows, size_t cols) {
+        auto t = _tensor({max_adapters, rows, cols}, _meta.dtype);
+        zeros.assign(t->numel() * t->elementSize(), std::byte{0});
+        t->load(zeros.data());
+        return t;
+    };
+    // (A list, B list, In, Out) per projection.
+    const std::tuple<std::vector<tensor_t> *, std::vector<tensor_t> *, size_t, size_t> projections[] = {
+        {&_weights.attn_q_lora_a, &_weights.attn_q_lora_b, _meta.hs, q_dim},
+        {&_weights.attn_k_lora_a, &_weights.attn_k_lora_b, _meta.hs, kv_dim},
+        {&_weights.attn_v_lora_a, &_weights.attn_v_lora_b, _meta.hs, kv_dim},
+        {&_weights.attn_o_lora_a, &_weights.attn_o_lora_b, q_dim, _meta.hs},
+        {&_weights.mlp_gate_lora_a, &_weights.mlp_gate_lora_b, _meta.hs, _meta.di},
+        {&_weights.mlp_up_lora_a, &_weights.mlp_up_lora_b, _meta.hs, _meta.di},
+        {&_weights.mlp_down_lora_a, &_weights.mlp_down_lora_b, _meta.di, _meta.hs},
+    };
+    for (const auto &[a, b, in, out] : projections) {
+        for (size_t i = 0; i < _meta.nlayer; i++) {
+            a->push_back(zeroed(max_rank, in));
+            b->push_back(zeroed(out, max_rank));
+        }
+    }
+    _lora_adapters = max_adapters;
+    _lora_rank = max_rank;
+}
+
+void Qwen2::setAdapter(int64_t adapter) {
+    CHECK_ARGUMENT(adapter < static_cast<int64_t>(_lora_adapters), "Qwen2: adapter slot out of range");
+    _adapter = adapter < 0 ? -1 : adapter;
+}
+
+tensor_t Qwen2::_tensor(const std::vector<size_t> &shape, llaisysDataType_t dtype) const {
+    return Tensor::create(shape, dtype, _device_type, _device_id);
+}
+
+tensor_t Qwen2::_sharedTensor(const std::vector<size_t> &shape, llaisysDataType_t dtype) const {
+    if (!_shared) {
+        return _tensor(shape, dtype);
+    }
+    size_t numel = 1;
+    for (size_t dim : shape) {
+        numel *= dim;
+    }
+    return Tensor::wrap(shape, dtype, _shared->allocate(numel * utils::dsize(dtype)));
+}
+
+size_t Qwen2::tensorParallelSize() const {
+    return _tp ? _tp->size() : 1;
+}
+
+size_t Qwen2::pipelineStages() const {
+    return _pp ? _pp->size() : 1;
+}
+
+Qwen2::Batch Qwen2::_prepare(const std::vector<Chunk> &chunks) {
+    CHECK_ARGUMENT(!chunks.empty(), "Qwen2: forward needs at least one chunk");
+    Batch batch;
+    for (size_t c = 0; c < chunks.size(); c++) {
+        const auto &chunk = chunks[c];
+        CHECK_ARGUMENT(chunk.ntoken > 0, "Qwen2: empty chunk");
+        CHECK_ARGUMENT(chunk.adapter < static_cast<int64_t>(_lora_adapters), "Qwen2: adapter slot out of range");
+        batch.adapter_ids.insert(batch.adapter_ids.end(), chunk.ntoken, chunk.adapter < 0 ? -1 : chunk.adapter);
+        batch.lora |= chunk.adapter >= 0;
+        if (_evicting()) {
+            _evict(chunk.seq);
+        }
+        const size_t past = _cache->length(chunk.seq);
+        const size_t evicted = _cache->evicted(chunk.seq);
+        ASSERT(past + chunk.ntoken <= _meta.maxseq, "Qwen2: sequence exceeds maxseq");
+        ASSERT(_cache->reserve(chunk.seq, chunk.ntoken), "Qwen2: KV cache is full");
+        batch.offsets.push_back(batch.token_ids.size());
+        for (size_t i = 0; i < chunk.ntoken; i++) {
+            batch.token_ids.push_back(chunk.tokens[i]);
+            batch.pos_ids.push_back(static_cast<int64_t>(evicted + past + i));
+        }
+        batch.nrows += chunk.all_logits ? chunk.ntoken : 1;
+    }
+    return batch;
+}
+
+bool Qwen2::reserve(seq_t seq, size_t ntoken) {
+    if (_evicting()) {
+        _evict(seq);
+    }
+    return _cache->length(seq) + ntoken <= _meta.maxseq && _cache->reserve(seq, ntoken);
+}
+
+tensor_t Qwen2::forward(const std::vector<Chunk> &chunks) {
+    // Token ids, positions and KV reservations for the whole batch.
+    const Batch batch = _prepare(chunks);
+    if (_tp || _pp) {
+        auto logits = _tp ? _tp->forward(chunks) : _pp->forward(chunks);
+        for (const auto &chunk : chunks) {
+            _cache->commit(chunk.seq, chunk.ntoken);
+        }
+        return logits;
+    }
+
+    // One process runs the shared layer loop as the only shard, in place on the cache blocks.
+    const size_t ntoken = batch.token_ids.size();
+    std::vector<WorkerChunk> worker_chunks;
+    std::vector<std::byte *> block_ptrs;
+    for (size_t c = 0; c < chunks.size(); c++) {
+        const auto &chunk = chunks[c];
+        const auto blocks = _cache->blockPointers(chunk.seq);
+        worker_chunks.push_back({batch.offsets[c], chunk.ntoken, _cache->length(chunk.seq), block_ptrs.size(),
+                                 chunk.all_logits ? chunk.ntoken : 1});
+        block_ptrs.insert(block_ptrs.end(), blocks.begin(), blocks.end());
+    }
+    const WorkerBatch worker_batch{ntoken, chunks.size(), batch.pos_ids.data(), worker_chunks.data(), block_ptrs.data(),
+                                   _window, _sink, _window_first_layer,
+                                   batch.lora ? batch.adapter_ids.data() : nullptr};
+
+    auto index = _tensor({ntoken}, LLAISYS_DTYPE_I64);
+    index->load(batch.token_ids.data());
+    auto x = _tensor({ntoken, _meta.hs}, _meta.dtype);
+    auto partial = _tensor({ntoken, _meta.hs}, _meta.dtype);
+    ops::embedding(x, index, _weights.in_embed);
+    auto reduce = [&] { ops::add(x, x, partial); };
+    if (_offload) {
+        for (size_t layer = 0; layer < _meta.nlayer; layer++) {
+            _offload->beginLayer(layer);
+            forwardLayers(_meta, _weights, worker_batch, layer, layer + 1, 0, 1, x, partial, reduce);
+            _offload->endLayer(layer);
+        }
+    } else {
+        forwardLayers(_meta, _weights, worker_batch, 0, _meta.nlayer, 0, 1, x, partial, reduce);
+    }
+
+    for (const auto &chunk : chunks) {
+        _cache->commit(chunk.seq, chunk.ntoken);
+    }
+
+    // Only the requested rows go through the final norm and the LM head.
+    auto logits = _tensor({batch.nrows, _meta.voc}, _meta.dtype);
+    forwardHead(_meta, _weights, worker_batch, x, 0, _meta.voc, logits);
+    return logits;
+}
+
+void Qwen2::logitsRow(tensor_t logits, size_t row, std::vector<float> &out) const {
+    const size_t voc = logits->shape()[1];
+    const size_t elem_size = logits->elementSize();
+    const std::byte *src = logits->data() + row * voc * elem_size;
+    std::vector<std::byte> host;
+    if (logits->deviceType() != LLAISYS_DEVICE_CPU) {
+        host.resize(voc * elem_size);
+        core::context().setDevice(logits->deviceType(), logits->deviceId());
+        core::context().runtime().api()->memcpy_sync(host.data(), src, voc * elem_size, LLAISYS_MEMCPY_D2H);
+        src = host.data();
+    }
+    out.resize(voc);
+    switch (logits->dtype()) {
+    case LLAISYS_DTYPE_F32:
+        for (size_t i = 0; i < voc; i++) {
+            out[i] = reinterpret_cast<const float *>(src)[i];
+        }
+        break;
+    case LLAISYS_DTYPE_F16:
+        for (size_t i = 0; i < voc; i++) {
+            out[i] = utils::cast<float>(reinterpret_cast<const fp16_t *>(src)[i]);
+        }
+        break;
+    case LLAISYS_DTYPE_BF16:
+        for (size_t i = 0; i < voc; i++) {
+            out[i] = utils::cast<float>(reinterpret_cast<const bf16_t *>(src)[i]);
+        }
+        break;
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(logits->dtype());
+    }
+}
+
+void Qwen2::setSlidingWindow(size_t window, size_t sink, size_t first_layer) {
+    CHECK_ARGUMENT(window > 0 || sink == 0, "Qwen2: attention sinks need a sliding window");
+    // Sink keys are stored differently once eviction is on, so only switch on an empty cache.
+    CHECK_ARGUMENT(_cache->empty(), "Qwen2: set the sliding window before any sequence holds tokens");
+    _window = window;
+    _sink = window > 0 ? sink : 0;
+    _window_first_layer = first_layer;
+}
+
+// Drop whole blocks between the sinks (rounded up to a block) and the oldest row the
+// next query can still see, i.e. rows [keep_front, length + 1 - window).
+void Qwen2::_evict(seq_t seq) {
+    const size_t keep_front = (_sink + KV_BLOCK_SIZE - 1) / KV_BLOCK_SIZE * KV_BLOCK_SIZE;
+    const size_t len = _cache->length(seq);
+    if (len + 1 < keep_front + _window + KV_BLOCK_SIZE) {
+        return;
+    }
+    const size_t count = (len + 1 - _window - keep_front) / KV_BLOCK_SIZE * KV_BLOCK_SIZE;
+    _cache->evict(seq, keep_front, count);
+}
+
+void Qwen2::setDrafter(std::unique_ptr<Drafter> drafter, size_t ndraft) {
+    CHECK_ARGUMENT(!drafter || ndraft > 0, "Qwen2: ndraft must be positive");
+    _drafter = std::move(drafter);
+    _ndraft = _drafter ? ndraft : 0;
+}
+
+size_t Qwen2::generate(const int64_t *prompt, size_t nprompt, size_t max_new_tokens,
+                       const SamplingConfig &sampling, const TokenCallback &callback) {
+    CHECK_ARGUMENT(nprompt > 0, "Qwen2: empty prompt");
+    if (max_new_tokens == 0) {
+        return 0;
+    }
+    Sampler sampler(sampling);
+    std::vector<float> row;
+    const seq_t seq = _cache->createSequence();
+    if (_drafter) {
+        _drafter->reset();
+    }
+
+    size_t ngenerated = 0;
+    try {
+        auto logits = forward({{seq, prompt, nprompt, false, _adapter}});
+        logitsRow(logits, 0, row);
+        int64_t next = sampler.sample(row.data(), row.size());
+        std::vector<int64_t> context(prompt, prompt + nprompt);
+        context.push_back(next);
+
+        std::vector<int64_t> emitted{next};
+        bool done = false;
+        while (!done) {
+            for (int64_t token : emitted) {
+                ngenerated++;
+                if (!callback(token) || token == _meta.end_token || ngenerated >= max_new_tokens) {
+                    done = true;
+                    break;
+                }
+            }
+            // The pending token still has to fit into the cache.
+            if (done || _cache->length(seq) + 1 >= _meta.maxseq) {
+                break;
+            }
+            emitted.clear();
+            // Drafts are not checked against a grammar, so constrained decoding
+            // runs one token per step.
+            if (_drafter && !sampling.grammar && _cache->length(seq) + 1 + _ndraft < _meta.maxseq) {
+                _speculativeStep(seq, context, sampler, emitted);
+            } else {
+                logits = forward({{seq, &context.back(), 1, false, _adapter}});
+                logitsRow(logits, 0, row);
+                next = sampler.sample(row.data(), row.size());
+                context.push_back(next);
+                emitted.push_back(next);
+            }
+        }
+    } catch (...) {
+        _cache->freeSequence(seq);
+        throw;
+    }
+    _cache->freeSequence(seq);
+    return ngenerated;
+}
+
+std::vector<size_t> Qwen2::generate(const int64_t *prompt, size_t nprompt, size_t n, size_t max_new_tokens,
+                                    const SamplingConfig &sampling, const BranchCallback &callback) {
+    CHECK_ARGUMENT(nprompt > 0, "Qwen2: empty prompt");
+    CHECK_ARGUMENT(n > 0, "Qwen2: n must be positive");
+    std::vector<size_t> ngenerated(n, 0);
+    if (max_new_tokens == 0) {
+        return ngenerated;
+    }
+
+    // Independent streams: branch i reseeds with a Weyl-sequence offset of the base seed.
+    std::vector<Sampler> samplers;
+    for (size_t i = 0; i < n; i++) {
+        SamplingConfig config = sampling;
+        config.seed = sampling.seed + i * 0x9E3779B97F4A7C15ull;
+        samplers.emplace_back(config);
+    }
+
+    // Shared prompt blocks plus every branch's private tail must fit into the pool.
+    const size_t max_len = std::min(nprompt + max_new_tokens, _meta.maxseq);
+    const size_t shared = nprompt / KV_BLOCK_SIZE;
+    const size_t needed = shared + n * (_cache->numBlocksFor(max_len) - shared);
+    const size_t free_blocks = _cache->numFreeBlocks();
+    if (needed > free_blocks) {
+        _cache->growMaxBlocks(_cache->config().max_blocks + needed - free_blocks);
+    }
+
+    std::vector<seq_t> seqs{_cache->createSequence()};
+    std::vector<int64_t> pending(n);
+    std::vector<float> row;
+    // Hand a token to its branch; returns whether the branch keeps decoding.
+    auto emit = [&](size_t i, int64_t token) {
+        pending[i] = token;
+        ngenerated[i]++;
+        bool live = callback(i, token) && token != _meta.end_token && ngenerated[i] < max_new_tokens
+                 && _cache->length(seqs[i]) + 1 < _meta.maxseq;
+        if (!live) {
+            // Return the branch's private blocks to the pool right away.
+            _cache->freeSequence(seqs[i]);
+            seqs[i] = -1;
+        }
+        return live;
+    };
+
+    try {
+        auto logits = forward({{seqs[0], prompt, nprompt, false, _adapter}});
+        logitsRow(logits, 0, row);
+        for (size_t i = 1; i < n; i++) {
+            seqs.push_back(_cache->fork(seqs[0]));
+        }
+
+        std::vector<size_t> active;
+        for (size_t i = 0; i < n; i++) {
+            if (emit(i, samplers[i].sample(row.data(), row.size()))) {
+                active.push_back(i);
+            }
+        }
+        std::vector<Chunk> chunks;
+        std::vector<size_t> still_active;
+        while (!active.empty()) {
+            chunks.clear();
+            for (size_t i : active) {
+                chunks.push_back({seqs[i], &pending[i], 1, false, _adapter});
+            }
+            logits = forward(chunks);
+            still_active.clear();
+            for (size_t r = 0; r < active.size(); r++) {
+                const size_t i = active[r];
+                logitsRow(logits, r, row);
+                if (emit(i, samplers[i].sample(row.data(), row.size()))) {
+                    still_active.push_back(i);
+                }
+            }
+            active.swap(still_active);
+        }
+    } catch (...) {
+        for (seq_t seq : seqs) {
+            if (seq >= 0) {
+                _cache->freeSequence(seq);
+            }
+        }
+        throw;
+    }
+    return ngenerated;
+}
+
+} // namespace llaisys::models
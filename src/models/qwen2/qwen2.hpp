@@ -0,0 +1,200 @@
+#pragma once
+
+#include "llaisys/models/qwen2.h"
+
+#include "../../tensor/tensor.hpp"
+#include "../kv_cache/kv_cache.hpp"
+#include "../sampling/sampler.hpp"
+
+#include "../../utils/shm.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace llaisys::models {
+
+struct Qwen2Weights {
+    tensor_t in_embed;
+    tensor_t out_embed;
+    tensor_t out_norm_w;
+    std::vector<tensor_t> attn_norm_w;
+    std::vector<tensor_t> attn_q_w;
+    std::vector<tensor_t> attn_q_b;
+    std::vector<tensor_t> attn_k_w;
+    std::vector<tensor_t> attn_k_b;
+    std::vector<tensor_t> attn_v_w;
+    std::vector<tensor_t> attn_v_b;
+    std::vector<tensor_t> attn_o_w;
+    std::vector<tensor_t> mlp_norm_w;
+    std::vector<tensor_t> mlp_gate_w;
+    std::vector<tensor_t> mlp_up_w;
+    std::vector<tensor_t> mlp_down_w;
+    // LoRA adapter slots, empty until Qwen2::enableLoRA. Per layer and projection:
+    // A [max_adapters, max_rank, In] and B [max_adapters, Out, max_rank], with the
+    // adapter's alpha / r folded into B and smaller ranks zero-padded.
+    std::vector<tensor_t> attn_q_lora_a;
+    std::vector<tensor_t> attn_q_lora_b;
+    std::vector<tensor_t> attn_k_lora_a;
+    std::vector<tensor_t> attn_k_lora_b;
+    std::vector<tensor_t> attn_v_lora_a;
+    std::vector<tensor_t> attn_v_lora_b;
+    std::vector<tensor_t> attn_o_lora_a;
+    std::vector<tensor_t> attn_o_lora_b;
+    std::vector<tensor_t> mlp_gate_lora_a;
+    std::vector<tensor_t> mlp_gate_lora_b;
+    std::vector<tensor_t> mlp_up_lora_a;
+    std::vector<tensor_t> mlp_up_lora_b;
+    std::vector<tensor_t> mlp_down_lora_a;
+    std::vector<tensor_t> mlp_down_lora_b;
+};
+
+class Drafter;
+class PipelineParallel;
+class TensorParallel;
+class WeightOffload;
+
+class Qwen2 {
+public:
+    using seq_t = KVCache::seq_t;
+    // Receives every generated token; returning false stops generation.
+    using TokenCallback = std::function<bool(int64_t)>;
+    // Receives (branch, token) for every token of an n-way generation; returning false stops that branch.
+    using BranchCallback = std::function<bool(size_t, int64_t)>;
+
+    // One sequence's slice of a batched forward.
+    struct Chunk {
+        seq_t seq;
+        const int64_t *tokens;
+        size_t ntoken;
+        bool all_logits; // logits for every token instead of only the last one
+        int64_t adapter = -1; // LoRA slot, -1 for the base model
+    };
+
+    // How a model with several device ids is split across them.
+    enum class Parallel {
+        TENSOR,   // every layer sharded by heads (see TensorParallel)
+        PIPELINE, // contiguous layer ranges as stages (see PipelineParallel)
+    };
+
+    // Layer weights kept on disk and streamed through memory (see WeightOffload)
+    // instead of held resident; single CPU device only.
+    struct Offload {
+        std::string path;    // scratch file for the weights; empty disables offload
+        size_t prefetch = 2; // layers read ahead of compute
+    };
+
+    static constexpr size_t KV_BLOCK_SIZE = 32;
+
+    Qwen2(const LlaisysQwen2Meta &meta, llaisysDeviceType_t device_type, int device_id);
+    // More than one CPU device id runs the model in parallel, one worker process per id,
+    // with each id naming the NUMA node its worker is pinned to. Weights and KV blocks
+    // then live in shared memory.
+    Qwen2(const LlaisysQwen2Meta &meta, llaisysDeviceType_t device_type, const std::vector<int> &device_ids,
+          Parallel parallel = Parallel::TENSOR);
+    // With `offload.path` set, a single-CPU model streaming its layer weights from disk.
+    Qwen2(const LlaisysQwen2Meta &meta, llaisysDeviceType_t device_type, const std::vector<int> &device_ids,
+          Parallel parallel, const Offload &offload);
+    ~Qwen2();
+
+    Qwen2(const Qwen2 &) = delete;
+    Qwen2 &operator=(const Qwen2 &) = delete;
+
+    const LlaisysQwen2Meta &meta() const { return _meta; }
+    Qwen2Weights &weights() { return _weights; }
+    KVCache &cache() { return *_cache; }
+    llaisysDeviceType_t deviceType() const { return _device_type; }
+    int deviceId() const { return _device_id; }
+    // Number of tensor-parallel ranks, 1 without tensor parallelism.
+    size_t tensorParallelSize() const;
+    // Number of pipeline stages, 1 without pipeline parallelism.
+    size_t pipelineStages() const;
+
+    // Run the chunks through the model, appending them to their sequences' KV cache.
+    // Returns logits [nrows, voc]: one row per chunk, or one per token for `all_logits` chunks.
+    tensor_t forward(const std::vector<Chunk> &chunks);
+    // Evict and reserve the KV rows for appending `ntoken` tokens to `seq`, as forward() would.
+    // Returns false, without throwing, if the sequence would exceed maxseq or the pool is full.
+    bool reserve(seq_t seq, size_t ntoken);
+    // Copy row `row` of `logits` to host as float.
+    void logitsRow(tensor_t logits, size_t row, std::vector<float> &out) const;
+
+    // Allocate zeroed LoRA slots for all seven projections of every layer. Chunks of one
+    // forward may use different adapters; rows are grouped per adapter inside linear_lora.
+    // Can be enabled once, before any adapter is loaded.
+    void enableLoRA(size_t max_adapters, size_t max_rank);
+    size_t loraAdapters() const { return _lora_adapters; }
+    size_t loraRank() const { return _lora_rank; }
+    // Adapter used by generate(); -1 for the base model.
+    void setAdapter(int64_t adapter);
+    int64_t adapter() const { return _adapter; }
+
+    // Sliding-window attention for layers >= `first_layer`: each token sees the last `window`
+    // tokens plus the first `sink` tokens of its sequence ("attention sinks"); window 0 disables.
+    // When every layer is windowed, the KV rows nobody can see anymore are evicted, so memory
+    // and per-token cost stay constant and streams may run past maxseq. Rope keeps stream
+    // positions; the sink keys are re-rotated for every query as if they sat right before its
+    // window, so the output does not depend on how the stream was chunked.
+    void setSlidingWindow(size_t window, size_t sink, size_t first_layer = 0);
+
+    // Enable speculative decoding in generate(). Pass null to disable.
+    void setDrafter(std::unique_ptr<Drafter> drafter, size_t ndraft);
+
+    // Prefill `prompt` into a fresh sequence and decode up to `max_new_tokens`,
+    // stopping at the end token. Returns the number of generated tokens.
+    size_t generate(const int64_t *prompt, size_t nprompt, size_t max_new_tokens,
+                    const SamplingConfig &sampling, const TokenCallback &callback);
+
+    // Sample `n` independent completions of `prompt`. The prompt is prefilled once and
+    // forked n ways sharing its KV blocks; live branches then decode together as one
+    // batched forward. Branch i samples with its own RNG stream (branch 0 reproduces
+    // generate() without a drafter). Returns the number of tokens of each branch.
+    std::vector<size_t> generate(const int64_t *prompt, size_t nprompt, size_t n, size_t max_new_tokens,
+                                 const SamplingConfig &sampling, const BranchCallback &callback);
+
+private:
+    friend class PipelineParallel;
+    friend class TensorParallel;
+
+    // Token ids, positions and per-chunk bookkeeping of one forward.
+    struct Batch {
+        std::vector<int64_t> token_ids;
+        std::vector<int64_t> pos_ids;
+        std::vector<size_t> offsets; // first token of each chunk
+        std::vector<int64_t> adapter_ids;
+        bool lora = false;
+        size_t nrows = 0;
+    };
+
+    LlaisysQwen2Meta _meta;
+    llaisysDeviceType_t _device_type;
+    int _device_id;
+    std::unique_ptr<utils::SharedRegion> _shared; // weights and KV blocks across worker processes
+    std::unique_ptr<WeightOffload> _offload;      // layer weights, when streamed from disk
+    Qwen2Weights _weights;
+    std::unique_ptr<KVCache> _cache;
+    // At most one is set; destroyed first, stopping the workers.
+    std::unique_ptr<TensorParallel> _tp;
+    std::unique_ptr<PipelineParallel> _pp;
+    std::unique_ptr<Drafter> _drafter;
+    size_t _ndraft = 0;
+    size_t _window = 0;
+    size_t _sink = 0;
+    size_t _window_first_layer = 0;
+    size_t _lora_adapters = 0;
+    size_t _lora_rank = 0;
+    int64_t _adapter = -1;
+
+    tensor_t _tensor(const std::vector<size_t> &shape, llaisysDataType_t dtype) const;
+    // Weight / KV block storage: shared memory with worker processes.
+    tensor_t _sharedTensor(const std::vector<size_t> &shape, llaisysDataType_t dtype) const;
+    // Evict, reserve and lay out the chunks of a forward.
+    Batch _prepare(const std::vector<Chunk> &chunks);
+    bool _evicting() const { return _window > 0 && _window_first_layer == 0; }
+    void _evict(seq_t seq);
+    size_t _speculativeStep(seq_t seq, std::vector<int64_t> &context, Sampler &sampler,
+                            std::vector<int64_t> &emitted);
+};
+
+} // namespace llaisys::models
@@ -0,0 +1,176 @@
+#include "speculative.hpp"
+
+#include "../../utils.hpp"
+
+#include <algorithm>
+
+namespace llaisys::models {
+
+DraftModelDrafter::DraftModelDrafter(Qwen2 *draft) : _draft(draft) {
+    CHECK_ARGUMENT(draft != nullptr, "DraftModelDrafter: draft model is null");
+}
+
+DraftModelDrafter::~DraftModelDrafter() {
+    reset();
+}
+
+void DraftModelDrafter::reset() {
+    if (_seq >= 0) {
+        _draft->cache().freeSequence(_seq);
+        _seq = -1;
+    }
+}
+
+size_t DraftModelDrafter::propose(const std::vector<int64_t> &context, size_t k, Sampler &sampler,
+                                  std::vector<int64_t> &tokens, std::vector<std::vector<float>> &q) {
+    if (_seq < 0) {
+        _seq = _draft->cache().createSequence();
+    }
+    auto &cache = _draft->cache();
+    const size_t maxseq = _draft->meta().maxseq;
+    std::vector<float> row;
+    tokens.clear();
+    q.clear();
+
+    // First catch up on everything the draft has not seen, then extend one token at a time.
+    size_t done = cache.evicted(_seq) + cache.length(_seq);
+    const int64_t *feed = context.data() + done;
+    size_t nfeed = context.size() - done;
+    while (tokens.size() < k && cache.length(_seq) + nfeed <= maxseq) {
+        auto logits = _draft->forward({{_seq, feed, nfeed, false, _draft->adapter()}});
+        _draft->logitsRow(logits, 0, row);
+        q.emplace_back();
+        sampler.distribution(row.data(), row.size(), q.back());
+        tokens.push_back(sampler.draw(q.back()));
+        done += nfeed;
+        feed = &tokens.back();
+        nfeed = 1;
+    }
+    return tokens.size();
+}
+
+void DraftModelDrafter::accept(const std::vector<int64_t> &context) {
+    // Everything the draft cached up to the new pending token matches `context`.
+    if (_seq >= 0) {
+        auto &cache = _draft->cache();
+        cache.truncate(_seq, std::min(cache.length(_seq), context.size() - 1 - cache.evicted(_seq)));
+    }
+}
+
+PromptLookupDrafter::PromptLookupDrafter(size_t max_ngram, size_t min_ngram)
+    : _max_ngram(max_ngram), _min_ngram(min_ngram), _index(max_ngram + 1) {
+    CHECK_ARGUMENT(min_ngram > 0 && min_ngram <= max_ngram, "PromptLookupDrafter: invalid n-gram range");
+}
+
+void PromptLookupDrafter::reset() {
+    for (auto &table : _index) {
+        table.clear();
+    }
+    _indexed = 0;
+}
+
+uint64_t PromptLookupDrafter::_hash(const int64_t *tokens, size_t n) {
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < n; i++) {
+        h = (h ^ static_cast<uint64_t>(tokens[i])) * 1099511628211ull;
+    }
+    return h;
+}
+
+// Index every n-gram that has a continuation, i.e. ends before the last token.
+void PromptLookupDrafter::_extend(const std::vector<int64_t> &context) {
+    if (context.size() < _indexed) {
+        reset();
+    }
+    for (; _indexed + 1 < context.size(); _indexed++) {
+        const size_t end = _indexed + 1;
+        for (size_t n = _min_ngram; n <= _max_ngram && n <= end; n++) {
+            _index[n][_hash(context.data() + end - n, n)] = end;
+        }
+    }
+}
+
+size_t PromptLookupDrafter::propose(const std::vector<int64_t> &context, size_t k, Sampler &,
+                                    std::vector<int64_t> &tokens, std::vector<std::vector<float>> &q) {
+    tokens.clear();
+    q.clear();
+    _extend(context);
+    const size_t len = context.size();
+    for (size_t n = std::min(_max_ngram, len); n >= _min_ngram; n--) {
+        const int64_t *suffix = context.data() + len - n;
+        auto it = _index[n].find(_hash(suffix, n));
+        // Guard against hash collisions before trusting the match.
+        if (it != _index[n].end() && std::equal(suffix, suffix + n, context.data() + it->second - n)) {
+            for (size_t pos = it->second; pos < len && tokens.size() < k; pos++) {
+                tokens.push_back(context[pos]);
+            }
+            break;
+        }
+    }
+    q.resize(tokens.size());
+    return tokens.size();
+}
+
+void PromptLookupDrafter::accept(const std::vector<int64_t> &context) {
+    _extend(context);
+}
+
+// Verify draft proposals with one multi-token forward of the target, using the
+// standard speculative sampling rule: accept draft x with probability
+// min(1, p(x) / q(x)), and on the first rejection resample from max(0, p - q).
+size_t Qwen2::_speculativeStep(seq_t seq, std::vector<int64_t> &context, Sampler &sampler,
+                               std::vector<int64_t> &emitted) {
+    std::vector<int64_t> drafts;
+    std::vector<std::vector<float>> q;
+    const size_t ndraft = _drafter->propose(context, _ndraft, sampler, drafts, q);
+
+    std::vector<int64_t> chunk{context.back()};
+    chunk.insert(chunk.end(), drafts.begin(), drafts.end());
+    auto logits = forward({{seq, chunk.data(), chunk.size(), true, _adapter}});
+
+    std::vector<float> row;
+    std::vector<float> p;
+    size_t accepted = 0;
+    int64_t next = -1;
+    for (; accepted < ndraft; accepted++) {
+        const int64_t x = drafts[accepted];
+        logitsRow(logits, accepted, row);
+        sampler.distribution(row.data(), row.size(), p);
+        const float qx = q[accepted].empty() ? 1.0f : q[accepted][x];
+        if (qx > 0.0f && sampler.uniform() < p[x] / qx) {
+            continue;
+        }
+        // Rejected: resample from the residual distribution.
+        if (q[accepted].empty()) {
+            p[x] = 0.0f;
+        } else {
+            for (size_t i = 0; i < p.size(); i++) {
+                p[i] = std::max(0.0f, p[i] - q[accepted][i]);
+            }
+        }
+        if (std::all_of(p.begin(), p.end(), [](float v) { return v <= 0.0f; })) {
+            sampler.distribution(row.data(), row.size(), p);
+        }
+        next = sampler.draw(p);
+        break;
+    }
+    if (next < 0) {
+        // Every draft was accepted; the last row yields a bonus token.
+        logitsRow(logits, ndraft, row);
+        next = sampler.sample(row.data(), row.size());
+    }
+
+    // Roll back the KV entries of rejected drafts. The forward may have evicted rows
+    // in front of the chunk, so count from the end.
+    _cache->truncate(seq, _cache->length(seq) - (ndraft - accepted));
+    for (size_t i = 0; i < accepted; i++) {
+        context.push_back(drafts[i]);
+        emitted.push_back(drafts[i]);
+    }
+    context.push_back(next);
+    emitted.push_back(next);
+    _drafter->accept(context);
+    return accepted;
+}
+
+} // namespace llaisys::models
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "qwen2.hpp"
+
+#include <unordered_map>
+
+namespace llaisys::models {
+
+// Source of draft tokens for speculative decoding.
+//
+// `context` is the committed token sequence; its last token has been sampled
+// but not yet run through the target model. Drafters keep whatever private
+// state they need and are told about the outcome of each verification step.
+class Drafter {
+public:
+    virtual ~Drafter() = default;
+
+    // Propose up to `k` tokens continuing `context`. For every proposal, `q`
+    // receives the distribution it was drawn from, or an empty vector when the
+    // proposal is deterministic. Returns the number of proposals.
+    virtual size_t propose(const std::vector<int64_t> &context, size_t k, Sampler &sampler,
+                           std::vector<int64_t> &tokens, std::vector<std::vector<float>> &q)
+        = 0;
+    // Called after verification with the updated context.
+    virtual void accept(const std::vector<int64_t> &context) = 0;
+    // Forget all state; the next context starts a new sequence.
+    virtual void reset() = 0;
+};
+
+// Drafts with a smaller Qwen2 model sharing the target's vocabulary. The draft
+// keeps its own sequence and rolls its KV cache back to the accepted prefix.
+class DraftModelDrafter : public Drafter {
+public:
+    DraftModelDrafter(Qwen2 *draft);
+    ~DraftModelDrafter();
+
+    size_t propose(const std::vector<int64_t> &context, size_t k, Sampler &sampler,
+                   std::vector<int64_t> &tokens, std::vector<std::vector<float>> &q) override;
+    void accept(const std::vector<int64_t> &context) override;
+    void reset() override;
+
+private:
+    Qwen2 *_draft;
+    Qwen2::seq_t _seq = -1;
+};
+
+// Prompt-lookup drafting: proposes the tokens that followed the most recent
+// earlier occurrence of the context's trailing n-gram (longest n first). The
+// index over prompt and generated tokens is extended incrementally, so each
+// step costs O(max_ngram) hash lookups regardless of context length.
+class PromptLookupDrafter : public Drafter {
+public:
+    PromptLookupDrafter(size_t max_ngram, size_t min_ngram = 1);
+
+    size_t propose(const std::vector<int64_t> &context, size_t k, Sampler &sampler,
+                   std::vector<int64_t> &tokens, std::vector<std::vector<float>> &q) override;
+    void accept(const std::vector<int64_t> &context) override;
+    void reset() override;
+
+private:
+    size_t _max_ngram;
+    size_t _min_ngram;
+    // Per n-gram length: hash of n tokens -> index right after their latest occurrence.
+    std::vector<std::unordered_map<uint64_t, size_t>> _index;
+    // Number of context positions whose continuations have been indexed.
+    size_t _indexed = 0;
+
+    static uint64_t _hash(const int64_t *tokens, size_t n);
+    void _extend(const std::vector<int64_t> &context);
+};
+
+} // namespace llaisys::models
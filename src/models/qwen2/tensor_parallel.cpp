@@ -0,0 +1,235 @@
+#include "tensor_parallel.hpp"
+
+#include "../../ops/add/op.hpp"
+#include "../../ops/embedding/op.hpp"
+#include "../../utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace llaisys::models {
+
+namespace {
+
+enum : uint32_t {
+    OP_FORWARD = 1,
+    OP_STOP = 2,
+};
+
+template <typename T>
+void reduceRange(T *out, const T *slots, size_t slot_stride, size_t nslot, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        float acc = 0.0f;
+        for (size_t s = 0; s < nslot; s++) {
+            acc += utils::cast<float>(slots[s * slot_stride + i]);
+        }
+        out[i] = utils::cast<T>(acc);
+    }
+}
+
+} // namespace
+
+struct TensorParallel::Header {
+    utils::ProcessBarrier control; // parent and ranks: start and end of a command
+    utils::ProcessBarrier ranks;   // ranks only: all-reduce phases
+    uint32_t op = 0;
+    size_t ntoken = 0;
+    size_t nchunk = 0;
+    size_t nrow = 0;
+    // Sliding-window settings, which may change after the workers were forked.
+    size_t window = 0;
+    size_t sink = 0;
+    size_t first_layer = 0;
+
+    explicit Header(uint32_t nrank) : control(nrank + 1), ranks(nrank) {}
+};
+
+TensorParallel::TensorParallel(Qwen2 &model, utils::SharedRegion &region, const std::vector<int> &nodes)
+    : _model(model), _nodes(nodes) {
+    const auto &meta = model._meta;
+    const size_t n = nodes.size();
+    CHECK_ARGUMENT(n > 1, "TensorParallel: needs at least two ranks");
+    CHECK_ARGUMENT(model._device_type == LLAISYS_DEVICE_CPU, "TensorParallel: only CPU models are supported");
+    CHECK_ARGUMENT(meta.nh % n == 0 && meta.nkvh % n == 0 && meta.di % n == 0,
+                   "TensorParallel: nh, nkvh and di must be divisible by the number of ranks");
+    const size_t esize = utils::dsize(meta.dtype);
+    const size_t max_blocks = (meta.maxseq + Qwen2::KV_BLOCK_SIZE - 1) / Qwen2::KV_BLOCK_SIZE;
+    _max_block_ptrs = std::max<size_t>(size_t(1) << 16, 2 * max_blocks);
+    _header = new (region.allocate(sizeof(Header))) Header(static_cast<uint32_t>(n));
+    _tokens = reinterpret_cast<int64_t *>(region.allocate(MAX_ROUND_TOKENS * sizeof(int64_t)));
+    _positions = reinterpret_cast<int64_t *>(region.allocate(MAX_ROUND_TOKENS * sizeof(int64_t)));
+    _chunks = reinterpret_cast<WorkerChunk *>(region.allocate(MAX_ROUND_TOKENS * sizeof(WorkerChunk)));
+    _block_ptrs = reinterpret_cast<std::byte **>(region.allocate(_max_block_ptrs * sizeof(std::byte *)));
+    _partials = region.allocate(n * MAX_ROUND_TOKENS * meta.hs * esize);
+    _reduced = region.allocate(MAX_ROUND_TOKENS * meta.hs * esize);
+    _logits = region.allocate(MAX_ROUND_TOKENS * meta.voc * esize);
+
+    _workers.spawn(n, [this](size_t rank) { _workerMain(rank); });
+    // Workers report in once their weight slices are faulted in.
+    _header->control.wait([this] { _workers.check(); });
+}
+
+TensorParallel::~TensorParallel() {
+    _shutdown();
+}
+
+void TensorParallel::_shutdown() {
+    if (!_workers.failed() && _workers.size() > 0) {
+        _header->op = OP_STOP;
+        try {
+            _header->control.wait([this] { _workers.check(); });
+        } catch (...) {
+        }
+    }
+    _workers.reap();
+}
+
+void TensorParallel::_run() {
+    CHECK_ARGUMENT(!_workers.failed(), "TensorParallel: a worker failed, the model is unusable");
+    _header->op = OP_FORWARD;
+    _header->control.wait([this] { _workers.check(); });
+    _header->control.wait([this] { _workers.check(); });
+}
+
+tensor_t TensorParallel::forward(const std::vector<Qwen2::Chunk> &chunks) {
+    const auto &meta = _model._meta;
+    const size_t row_bytes = meta.voc * utils::dsize(meta.dtype);
+    _header->window = _model._window;
+    _header->sink = _model._sink;
+    _header->first_layer = _model._window_first_layer;
+
+    size_t nrows = 0;
+    for (const auto &chunk : chunks) {
+        nrows += chunk.all_logits ? chunk.ntoken : 1;
+    }
+    auto logits = _model._tensor({nrows, meta.voc}, meta.dtype);
+    size_t out_row = 0;
+    size_t nblock_ptrs = 0;
+    auto flush = [&]() {
+        if (_header->ntoken == 0) {
+            return;
+        }
+        _run();
+        std::memcpy(logits->data() + out_row * row_bytes, _logits, _header->nrow * row_bytes);
+        out_row += _header->nrow;
+        _header->ntoken = 0;
+        _header->nchunk = 0;
+        _header->nrow = 0;
+        nblock_ptrs = 0;
+    };
+
+    for (const auto &chunk : chunks) {
+        const auto blocks = _model._cache->blockPointers(chunk.seq);
+        ASSERT(blocks.size() <= _max_block_ptrs, "TensorParallel: sequence has too many KV blocks");
+        const size_t past = _model._cache->length(chunk.seq);
+        const size_t evicted = _model._cache->evicted(chunk.seq);
+        for (size_t done = 0; done < chunk.ntoken;) {
+            if (_header->ntoken == MAX_ROUND_TOKENS || nblock_ptrs + blocks.size() > _max_block_ptrs) {
+                flush();
+            }
+            const size_t count = std::min(chunk.ntoken - done, MAX_ROUND_TOKENS - _header->ntoken);
+            const bool last = done + count == chunk.ntoken;
+            auto &desc = _chunks[_header->nchunk++];
+            desc.offset = _header->ntoken;
+            desc.ntoken = count;
+            desc.past = past + done;
+            desc.block_begin = nblock_ptrs;
+            desc.nrow = chunk.all_logits ? count : last ? 1 : 0;
+            std::copy(blocks.begin(), blocks.end(), _block_ptrs + nblock_ptrs);
+            nblock_ptrs += blocks.size();
+            for (size_t i = 0; i < count; i++) {
+                _tokens[desc.offset + i] = chunk.tokens[done + i];
+                _positions[desc.offset + i] = static_cast<int64_t>(evicted + past + done + i);
+            }
+            _header->ntoken += count;
+            _header->nrow += desc.nrow;
+            done += count;
+        }
+    }
+    flush();
+    return logits;
+}
+
+void TensorParallel::_workerMain(size_t rank) {
+    auto orphaned = [this] { _workers.exitIfOrphaned(); };
+    pinToNumaNode(_nodes[rank]);
+    // First touch places this rank's weight slices on its node.
+    const auto &meta = _model._meta;
+    const auto &w = _model._weights;
+    const size_t n = size();
+    const size_t q_dim = meta.nh / n * meta.dh;
+    const size_t kv_dim = meta.nkvh / n * meta.dh;
+    const size_t di = meta.di / n;
+    for (size_t layer = 0; layer < meta.nlayer; layer++) {
+        firstTouch(w.attn_q_w[layer]->slice(0, rank * q_dim, (rank + 1) * q_dim));
+        firstTouch(w.attn_k_w[layer]->slice(0, rank * kv_dim, (rank + 1) * kv_dim));
+        firstTouch(w.attn_v_w[layer]->slice(0, rank * kv_dim, (rank + 1) * kv_dim));
+        firstTouch(w.attn_o_w[layer]->slice(1, rank * q_dim, (rank + 1) * q_dim));
+        firstTouch(w.mlp_gate_w[layer]->slice(0, rank * di, (rank + 1) * di));
+        firstTouch(w.mlp_up_w[layer]->slice(0, rank * di, (rank + 1) * di));
+        firstTouch(w.mlp_down_w[layer]->slice(1, rank * di, (rank + 1) * di));
+    }
+    firstTouch(w.out_embed->slice(0, meta.voc * rank / n, meta.voc * (rank + 1) / n));
+    _header->control.wait(orphaned);
+
+    for (;;) {
+        _header->control.wait(orphaned);
+        if (_header->op == OP_STOP) {
+            return;
+        }
+        _forwardRank(rank);
+        _header->control.wait(orphaned);
+    }
+}
+
+void TensorParallel::_forwardRank(size_t rank) {
+    const auto &meta = _model._meta;
+    const Header &header = *_header;
+    const size_t hs = meta.hs;
+    const size_t ntoken = header.ntoken;
+    const size_t esize = utils::dsize(meta.dtype);
+    const WorkerBatch batch{ntoken, header.nchunk, _positions, _chunks, _block_ptrs,
+                            header.window, header.sink, header.first_layer};
+
+    auto index = Tensor::wrap({ntoken}, LLAISYS_DTYPE_I64, reinterpret_cast<std::byte *>(_tokens));
+    auto x = Tensor::create({ntoken, hs}, meta.dtype);
+    auto partial = Tensor::wrap({ntoken, hs}, meta.dtype, _partials + rank * MAX_ROUND_TOKENS * hs * esize);
+    ops::embedding(x, index, _model._weights.in_embed);
+    forwardLayers(meta, _model._weights, batch, 0, meta.nlayer, rank, size(), x, partial,
+                  [&] { _allReduce(rank, x); });
+    // This rank's vocabulary range of the LM head, written in place.
+    auto logits = Tensor::wrap({header.nrow, meta.voc}, meta.dtype, _logits);
+    forwardHead(meta, _model._weights, batch, x, meta.voc * rank / size(), meta.voc * (rank + 1) / size(), logits);
+}
+
+// x += sum of every rank's `partial`. Each rank reduces its own share of the
+// elements into the shared result, so the reduction is spread over all ranks.
+void TensorParallel::_allReduce(size_t rank, tensor_t x) {
+    auto orphaned = [this] { _workers.exitIfOrphaned(); };
+    const auto dtype = x->dtype();
+    const size_t n = size();
+    const size_t numel = x->numel();
+    const size_t begin = numel * rank / n;
+    const size_t end = numel * (rank + 1) / n;
+    const size_t slot = MAX_ROUND_TOKENS * _model._meta.hs;
+    _header->ranks.wait(orphaned);
+    switch (dtype) {
+    case LLAISYS_DTYPE_F32:
+        reduceRange(reinterpret_cast<float *>(_reduced), reinterpret_cast<const float *>(_partials), slot, n, begin, end);
+        break;
+    case LLAISYS_DTYPE_F16:
+        reduceRange(reinterpret_cast<fp16_t *>(_reduced), reinterpret_cast<const fp16_t *>(_partials), slot, n, begin, end);
+        break;
+    case LLAISYS_DTYPE_BF16:
+        reduceRange(reinterpret_cast<bf16_t *>(_reduced), reinterpret_cast<const bf16_t *>(_partials), slot, n, begin, end);
+        break;
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(dtype);
+    }
+    _header->ranks.wait(orphaned);
+    ops::add(x, x, Tensor::wrap(x->shape(), dtype, _reduced));
+}
+
+} // namespace llaisys::models
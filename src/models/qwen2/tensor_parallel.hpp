@@ -0,0 +1,70 @@
+#pragma once
+
+#include "qwen2.hpp"
+#include "worker.hpp"
+
+#include "../../utils/shm.hpp"
+
+#include <vector>
+
+namespace llaisys::models {
+
+// Tensor-parallel execution of a CPU Qwen2 across worker processes, one per
+// NUMA node, all sharing the weights and KV blocks through a SharedRegion.
+//
+// Rank r of N owns heads [r*nh/N, (r+1)*nh/N) (and the matching KV heads): the
+// Q/K/V and gate/up projections are split by output rows, o_proj and
+// down_proj by input columns, so each rank produces a partial [T, hs] sum that
+// is all-reduced through shared memory twice per layer. The LM head is split
+// by vocabulary rows and every rank writes its logit columns in place.
+// Embedding and the norms are cheap and replicated.
+//
+// The owning Qwen2 keeps the KV cache bookkeeping (reserve, eviction, swap,
+// fork); ranks only address the block layout directly, each writing and
+// reading the strip of its own KV heads. Batches are processed in rounds of at
+// most MAX_ROUND_TOKENS tokens, a long chunk being split causally.
+class TensorParallel {
+public:
+    static constexpr size_t MAX_ROUND_TOKENS = 512;
+
+    // `nodes[r]` is the NUMA node rank r is pinned to (ignored where the
+    // topology is not exposed). Forks the workers, which pre-fault their weight
+    // slices on their own node before the weights are loaded.
+    TensorParallel(Qwen2 &model, utils::SharedRegion &region, const std::vector<int> &nodes);
+    ~TensorParallel();
+
+    TensorParallel(const TensorParallel &) = delete;
+    TensorParallel &operator=(const TensorParallel &) = delete;
+
+    size_t size() const { return _nodes.size(); }
+
+    // Same contract as Qwen2::forward, with the chunks already reserved in the
+    // cache; the caller commits them afterwards.
+    tensor_t forward(const std::vector<Qwen2::Chunk> &chunks);
+
+private:
+    struct Header;
+
+    Qwen2 &_model;
+    std::vector<int> _nodes;
+    WorkerProcesses _workers;
+
+    // Shared scratch, laid out once at construction.
+    Header *_header;
+    int64_t *_tokens;
+    int64_t *_positions;
+    WorkerChunk *_chunks;
+    std::byte **_block_ptrs;
+    size_t _max_block_ptrs;
+    std::byte *_partials; // N slots of [MAX_ROUND_TOKENS, hs]
+    std::byte *_reduced;  // [MAX_ROUND_TOKENS, hs]
+    std::byte *_logits;   // [MAX_ROUND_TOKENS, voc]
+
+    void _run();
+    void _shutdown();
+    void _workerMain(size_t rank);
+    void _forwardRank(size_t rank);
+    void _allReduce(size_t rank, tensor_t x);
+};
+
+} // namespace llaisys::models
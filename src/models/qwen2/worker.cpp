@@ -0,0 +1,336 @@
+#include "worker.hpp"
+
+#include "../../ops/linear/op.hpp"
+#include "../../ops/rms_norm/op.hpp"
+#include "../../ops/rope/op.hpp"
+#include "../../ops/self_attention/op.hpp"
+#include "../../ops/swiglu/op.hpp"
+#include "../../utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace llaisys::models {
+
+void forwardLayers(const LlaisysQwen2Meta &meta, const Qwen2Weights &w, const WorkerBatch &batch,
+                   size_t first, size_t last, size_t rank, size_t nrank, tensor_t x, tensor_t partial,
+                   const std::function<void()> &reduce) {
+    const auto dtype = meta.dtype;
+    const size_t dh = meta.dh;
+    const size_t nh = meta.nh / nrank;
+    const size_t nkvh = meta.nkvh / nrank;
+    const size_t di = meta.di / nrank;
+    const size_t ntoken = batch.ntoken;
+    const size_t esize = utils::dsize(dtype);
+    CHECK_ARGUMENT(!batch.adapter_ids || nrank == 1, "forwardLayers: LoRA needs a single shard");
+
+    auto pos = Tensor::wrap({ntoken}, LLAISYS_DTYPE_I64, reinterpret_cast<std::byte *>(const_cast<int64_t *>(batch.positions)));
+    auto h = Tensor::create({ntoken, meta.hs}, dtype);
+    auto q = Tensor::create({ntoken, nh * dh}, dtype);
+    auto k = Tensor::create({ntoken, nkvh * dh}, dtype);
+    auto v = Tensor::create({ntoken, nkvh * dh}, dtype);
+    auto attn = Tensor::create({ntoken, nh * dh}, dtype);
+    auto gate = Tensor::create({ntoken, di}, dtype);
+    auto up = Tensor::create({ntoken, di}, dtype);
+    auto q3 = q->view({ntoken, nh, dh});
+    auto k3 = k->view({ntoken, nkvh, dh});
+    auto attn3 = attn->view({ntoken, nh, dh});
+    const float scale = 1.0f / std::sqrt(static_cast<float>(dh));
+
+    // This shard's strip of every KV row: its heads are contiguous within the row.
+    const size_t block_size = Qwen2::KV_BLOCK_SIZE;
+    const size_t kv_row_bytes = meta.nkvh * dh * esize;
+    const size_t strip_bytes = nkvh * dh * esize;
+    auto kv_row = [&](const WorkerChunk &c, size_t layer, size_t kv, size_t row) {
+        return batch.block_ptrs[c.block_begin + row / block_size]
+             + ((layer * 2 + kv) * block_size + row % block_size) * kv_row_bytes + rank * strip_bytes;
+    };
+    auto store = [&](const WorkerChunk &c, size_t layer, size_t begin, size_t end) {
+        for (size_t t = begin; t < end; t++) {
+            const size_t row = c.past + t - c.offset;
+            std::memcpy(kv_row(c, layer, 0, row), k->data() + t * strip_bytes, strip_bytes);
+            std::memcpy(kv_row(c, layer, 1, row), v->data() + t * strip_bytes, strip_bytes);
+        }
+    };
+    tensor_t k_buf;
+    tensor_t v_buf;
+    // Rows [begin, end) of a chunk into k_buf / v_buf; a single shard owns whole
+    // rows, so it copies a block's rows at once.
+    auto gather = [&](const WorkerChunk &c, size_t layer, size_t begin, size_t end) {
+        for (size_t row = begin; row < end;) {
+            const size_t run = nrank == 1 ? std::min(block_size - row % block_size, end - row) : 1;
+            std::memcpy(k_buf->data() + row * strip_bytes, kv_row(c, layer, 0, row), run * strip_bytes);
+            std::memcpy(v_buf->data() + row * strip_bytes, kv_row(c, layer, 1, row), run * strip_bytes);
+            row += run;
+        }
+    };
+
+    // With eviction, sink keys are cached unrotated. A query at stream position p
+    // sees sink j rotated to j + max(0, p + 1 - window - sink), right before its
+    // window: that depends on the stream only, not on how many rows were evicted,
+    // so chunking does not change the output. Queries of a chunk with the same
+    // rotation attend together; past the first window each query is its own group.
+    struct SinkGroup {
+        size_t begin; // batch tokens [begin, end)
+        size_t end;
+        tensor_t pos; // sink positions, null without raw sinks
+    };
+    const bool raw_sinks = batch.window > 0 && batch.first_layer == 0 && batch.sink > 0;
+    auto sink_shift = [&](size_t t) {
+        const size_t p = static_cast<size_t>(batch.positions[t]);
+        return p + 1 > batch.window + batch.sink ? p + 1 - batch.window - batch.sink : 0;
+    };
+    size_t max_kvlen = 0;
+    std::vector<size_t> nraw(batch.nchunk, 0);
+    std::vector<std::vector<SinkGroup>> groups(batch.nchunk);
+    for (size_t c = 0; c < batch.nchunk; c++) {
+        const auto &chunk = batch.chunks[c];
+        const size_t end = chunk.offset + chunk.ntoken;
+        max_kvlen = std::max(max_kvlen, chunk.past + chunk.ntoken);
+        if (!raw_sinks) {
+            groups[c].push_back({chunk.offset, end, nullptr});
+            continue;
+        }
+        nraw[c] = chunk.past < batch.sink ? std::min(batch.sink - chunk.past, chunk.ntoken) : 0;
+        for (size_t t = chunk.offset; t < end;) {
+            const size_t shift = sink_shift(t);
+            size_t group_end = t + 1;
+            while (group_end < end && sink_shift(group_end) == shift) {
+                group_end++;
+            }
+            std::vector<int64_t> ids(std::min(batch.sink, chunk.past + group_end - chunk.offset));
+            for (size_t i = 0; i < ids.size(); i++) {
+                ids[i] = static_cast<int64_t>(shift + i);
+            }
+            auto pos_ids = Tensor::create({ids.size()}, LLAISYS_DTYPE_I64);
+            pos_ids->load(ids.data());
+            groups[c].push_back({t, group_end, pos_ids});
+            t = group_end;
+        }
+    }
+    k_buf = Tensor::create({max_kvlen, nkvh, dh}, dtype);
+    v_buf = Tensor::create({max_kvlen, nkvh, dh}, dtype);
+
+    // Batches that use no adapter run the plain projections.
+    tensor_t adapters;
+    if (batch.adapter_ids) {
+        adapters = Tensor::wrap({ntoken}, LLAISYS_DTYPE_I64, reinterpret_cast<std::byte *>(const_cast<int64_t *>(batch.adapter_ids)));
+    }
+    auto project = [&](tensor_t out, tensor_t in, tensor_t weight, tensor_t bias,
+                       const std::vector<tensor_t> &lora_a, const std::vector<tensor_t> &lora_b, size_t layer) {
+        if (adapters) {
+            ops::linear_lora(out, in, weight, bias, lora_a[layer], lora_b[layer], adapters);
+        } else {
+            ops::linear(out, in, weight, bias);
+        }
+    };
+
+    const size_t q_lo = rank * nh * dh;
+    const size_t kv_lo = rank * nkvh * dh;
+    for (size_t layer = first; layer < last; layer++) {
+        ops::rms_norm(h, x, w.attn_norm_w[layer], meta.epsilon);
+        project(q, h, w.attn_q_w[layer]->slice(0, q_lo, q_lo + nh * dh), w.attn_q_b[layer]->slice(0, q_lo, q_lo + nh * dh),
+                w.attn_q_lora_a, w.attn_q_lora_b, layer);
+        project(k, h, w.attn_k_w[layer]->slice(0, kv_lo, kv_lo + nkvh * dh), w.attn_k_b[layer]->slice(0, kv_lo, kv_lo + nkvh * dh),
+                w.attn_k_lora_a, w.attn_k_lora_b, layer);
+        project(v, h, w.attn_v_w[layer]->slice(0, kv_lo, kv_lo + nkvh * dh), w.attn_v_b[layer]->slice(0, kv_lo, kv_lo + nkvh * dh),
+                w.attn_v_lora_a, w.attn_v_lora_b, layer);
+        for (size_t c = 0; c < batch.nchunk; c++) {
+            store(batch.chunks[c], layer, batch.chunks[c].offset, batch.chunks[c].offset + nraw[c]);
+        }
+        ops::rope(q3, q3, pos, meta.theta);
+        ops::rope(k3, k3, pos, meta.theta);
+
+        for (size_t c = 0; c < batch.nchunk; c++) {
+            const auto &chunk = batch.chunks[c];
+            store(chunk, layer, chunk.offset + nraw[c], chunk.offset + chunk.ntoken);
+            gather(chunk, layer, 0, chunk.past + chunk.ntoken);
+            for (const auto &group : groups[c]) {
+                const size_t kvlen = chunk.past + group.end - chunk.offset;
+                auto k_all = k_buf->slice(0, 0, kvlen);
+                auto v_all = v_buf->slice(0, 0, kvlen);
+                if (group.pos) {
+                    const size_t nsink = group.pos->shape()[0];
+                    if (group.begin != chunk.offset) {
+                        gather(chunk, layer, 0, nsink);
+                    }
+                    auto sinks = k_all->slice(0, 0, nsink);
+                    ops::rope(sinks, sinks, group.pos, meta.theta);
+                }
+                auto q_rows = q3->slice(0, group.begin, group.end);
+                auto attn_rows = attn3->slice(0, group.begin, group.end);
+                if (batch.window > 0 && layer >= batch.first_layer) {
+                    ops::self_attention(attn_rows, q_rows, k_all, v_all, scale, batch.window, batch.sink);
+                } else {
+                    ops::self_attention(attn_rows, q_rows, k_all, v_all, scale);
+                }
+            }
+        }
+        project(partial, attn, w.attn_o_w[layer]->slice(1, q_lo, q_lo + nh * dh), nullptr,
+                w.attn_o_lora_a, w.attn_o_lora_b, layer);
+        reduce();
+
+        ops::rms_norm(h, x, w.mlp_norm_w[layer], meta.epsilon);
+        project(gate, h, w.mlp_gate_w[layer]->slice(0, rank * di, (rank + 1) * di), nullptr,
+                w.mlp_gate_lora_a, w.mlp_gate_lora_b, layer);
+        project(up, h, w.mlp_up_w[layer]->slice(0, rank * di, (rank + 1) * di), nullptr,
+                w.mlp_up_lora_a, w.mlp_up_lora_b, layer);
+        ops::swiglu(gate, gate, up);
+        project(partial, gate, w.mlp_down_w[layer]->slice(1, rank * di, (rank + 1) * di), nullptr,
+                w.mlp_down_lora_a, w.mlp_down_lora_b, layer);
+        reduce();
+    }
+}
+
+void forwardHead(const LlaisysQwen2Meta &meta, const Qwen2Weights &w, const WorkerBatch &batch,
+                 tensor_t x, size_t voc_begin, size_t voc_end, tensor_t logits) {
+    size_t nrow = 0;
+    for (size_t c = 0; c < batch.nchunk; c++) {
+        nrow += batch.chunks[c].nrow;
+    }
+    const size_t row_bytes = meta.hs * utils::dsize(meta.dtype);
+    auto rows = Tensor::create({nrow, meta.hs}, meta.dtype);
+    size_t r = 0;
+    for (size_t c = 0; c < batch.nchunk; c++) {
+        const auto &chunk = batch.chunks[c];
+        const size_t first = chunk.offset + chunk.ntoken - chunk.nrow;
+        std::memcpy(rows->data() + r * row_bytes, x->data() + first * row_bytes, chunk.nrow * row_bytes);
+        r += chunk.nrow;
+    }
+    auto normed = Tensor::create({nrow, meta.hs}, meta.dtype);
+    ops::rms_norm(normed, rows, w.out_norm_w, meta.epsilon);
+    ops::linear(logits->slice(1, voc_begin, voc_end), normed, w.out_embed->slice(0, voc_begin, voc_end), nullptr);
+}
+
+WorkerProcesses::WorkerProcesses() {
+#ifndef _WIN32
+    _parent = static_cast<int>(getpid());
+#else
+    _parent = 0;
+#endif
+}
+
+WorkerProcesses::~WorkerProcesses() {
+    _failed |= !_pids.empty();
+    reap();
+}
+
+void WorkerProcesses::spawn(size_t nrank, const std::function<void(size_t)> &main) {
+#ifdef _WIN32
+    (void)nrank;
+    (void)main;
+    throw std::runtime_error("WorkerProcesses: worker processes need POSIX");
+#else
+    for (size_t rank = 0; rank < nrank; rank++) {
+        const pid_t pid = fork();
+        if (pid == 0) {
+            int status = 0;
+            try {
+                main(rank);
+            } catch (...) {
+                // The parent notices the exit on its next timeout.
+                status = 1;
+            }
+            _exit(status);
+        }
+        if (pid < 0) {
+            _failed = true;
+            reap();
+            throw std::runtime_error("WorkerProcesses: fork failed");
+        }
+        _pids.push_back(static_cast<int>(pid));
+    }
+#endif
+}
+
+void WorkerProcesses::check() {
+#ifndef _WIN32
+    for (int &pid : _pids) {
+        if (pid != 0 && waitpid(pid, nullptr, WNOHANG) == pid) {
+            pid = 0;
+            _failed = true;
+            throw std::runtime_error("WorkerProcesses: a worker process exited");
+        }
+    }
+#endif
+}
+
+void WorkerProcesses::exitIfOrphaned() const {
+#ifndef _WIN32
+    if (static_cast<int>(getppid()) != _parent) {
+        _exit(0);
+    }
+#endif
+}
+
+void WorkerProcesses::reap() {
+#ifndef _WIN32
+    for (int &pid : _pids) {
+        if (pid == 0) {
+            continue;
+        }
+        if (_failed) {
+            kill(pid, SIGKILL);
+        }
+        waitpid(pid, nullptr, 0);
+        pid = 0;
+    }
+#endif
+    _pids.clear();
+}
+
+void pinToNumaNode(int node) {
+#ifdef __linux__
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string list;
+    if (!file || !std::getline(file, list)) {
+        return;
+    }
+    // e.g. "0-3,8-11"
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    std::stringstream ranges(list);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        if (range.empty()) {
+            continue;
+        }
+        const size_t dash = range.find('-');
+        const int first = std::stoi(range.substr(0, dash));
+        const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; cpu++) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    sched_setaffinity(0, sizeof(set), &set);
+#else
+    (void)node;
+#endif
+}
+
+void firstTouch(const tensor_t &t) {
+    const size_t row_bytes = t->shape().back() * t->elementSize();
+    if (t->isContiguous()) {
+        std::memset(t->data(), 0, t->numel() * t->elementSize());
+        return;
+    }
+    for (size_t r = 0; r < t->shape()[0]; r++) {
+        std::memset(t->data() + r * t->strides()[0] * t->elementSize(), 0, row_bytes);
+    }
+}
+
+} // namespace llaisys::models
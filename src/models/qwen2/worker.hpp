@@ -0,0 +1,89 @@
+#pragma once
+
+#include "qwen2.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace llaisys::models {
+
+// The layer loop shared by every way of running the model. Forward passes that
+// run in worker processes (TensorParallel, PipelineParallel) cannot use the
+// owning Qwen2's KVCache object, whose block tables live in the parent, so the
+// loop gets each chunk's block pointers and addresses the block layout
+// [nlayer, 2, block_size, nkvh, dh] itself; a single-process Qwen2 runs it in
+// place as rank 0 of 1.
+
+// One chunk, or a causal piece of one, within a worker batch.
+struct WorkerChunk {
+    size_t offset;      // first token in the batch
+    size_t ntoken;
+    size_t past;        // cache rows before this piece
+    size_t block_begin; // first of the sequence's block pointers
+    size_t nrow;        // logits rows: 0, 1 (last token) or ntoken
+};
+
+struct WorkerBatch {
+    size_t ntoken;
+    size_t nchunk;
+    const int64_t *positions;
+    const WorkerChunk *chunks;
+    std::byte *const *block_ptrs;
+    // Sliding-window settings of the owning model.
+    size_t window;
+    size_t sink;
+    size_t first_layer;
+    // LoRA slot of every token, -1 for the base weights; null when no token uses an adapter.
+    const int64_t *adapter_ids = nullptr;
+};
+
+// Run layers [first, last) over x [ntoken, hs] in place, computing the heads
+// (and the intermediate slice) of shard `rank` of `nrank`. Shards write only
+// their strip of every KV row. The o_proj and down_proj outputs of a shard are
+// partial sums: they land in `partial` ([ntoken, hs]) and `reduce` must add the
+// full sum into x. LoRA adapters need nrank == 1.
+void forwardLayers(const LlaisysQwen2Meta &meta, const Qwen2Weights &weights, const WorkerBatch &batch,
+                   size_t first, size_t last, size_t rank, size_t nrank, tensor_t x, tensor_t partial,
+                   const std::function<void()> &reduce);
+
+// Final norm on each chunk's logits rows of x, then the LM head rows
+// [voc_begin, voc_end) into the matching columns of `logits` ([nrow, voc]).
+void forwardHead(const LlaisysQwen2Meta &meta, const Qwen2Weights &weights, const WorkerBatch &batch,
+                 tensor_t x, size_t voc_begin, size_t voc_end, tensor_t logits);
+
+// Forked worker processes of one model. The parent checks on them while it
+// waits (see check()) and workers exit on their own once orphaned.
+class WorkerProcesses {
+public:
+    WorkerProcesses();
+    ~WorkerProcesses();
+
+    WorkerProcesses(const WorkerProcesses &) = delete;
+    WorkerProcesses &operator=(const WorkerProcesses &) = delete;
+
+    // Fork one worker per rank running `main(rank)`, exiting when it returns (status
+    // 0) or throws (status 1). Throws when a fork fails.
+    void spawn(size_t nrank, const std::function<void(size_t)> &main);
+    size_t size() const { return _pids.size(); }
+    bool failed() const { return _failed; }
+    void markFailed() { _failed = true; }
+    // Parent side, e.g. from a barrier timeout: throws once a worker has exited.
+    void check();
+    // Worker side: exit quietly when the parent is gone.
+    void exitIfOrphaned() const;
+    // Wait for every worker to exit, killing them first after a failure.
+    void reap();
+
+private:
+    int _parent;
+    std::vector<int> _pids; // 0 once reaped
+    bool _failed = false;
+};
+
+// Pin the calling process to the CPUs of NUMA node `node`, when the topology is exposed.
+void pinToNumaNode(int node);
+// Zero a weight slice (contiguous, or the rows of a column slice) so its pages are
+// committed by, and therefore placed next to, the calling process.
+void firstTouch(const tensor_t &t);
+
+} // namespace llaisys::models
@@ -0,0 +1,668 @@
+#include "grammar.hpp"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace llaisys::models {
+
+namespace {
+
+constexpr uint32_t MAX_CODE_POINT = 0x10FFFF;
+
+using Ranges = std::vector<std::pair<uint32_t, uint32_t>>; // inclusive code point ranges
+
+Ranges normalize(Ranges ranges) {
+    std::sort(ranges.begin(), ranges.end());
+    Ranges out;
+    for (const auto &r : ranges) {
+        if (!out.empty() && r.first <= out.back().second + 1) {
+            out.back().second = std::max(out.back().second, r.second);
+        } else {
+            out.push_back(r);
+        }
+    }
+    return out;
+}
+
+Ranges complement(const Ranges &ranges) {
+    Ranges out;
+    uint32_t next = 0;
+    for (const auto &r : normalize(ranges)) {
+        if (r.first > next) {
+            out.push_back({next, r.first - 1});
+        }
+        next = r.second + 1;
+    }
+    if (next <= MAX_CODE_POINT) {
+        out.push_back({next, MAX_CODE_POINT});
+    }
+    return out;
+}
+
+const Ranges DIGIT = {{'0', '9'}};
+const Ranges WORD = {{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}};
+const Ranges SPACE = {{'\t', '\r'}, {' ', ' '}};
+
+struct Node {
+    enum class Kind {
+        Empty,
+        Class,
+        Concat,
+        Alt,
+        Repeat,
+    } kind;
+    Ranges ranges;
+    int min = 0, max = 0; // Repeat bounds; max < 0 is unbounded
+    std::vector<Node> children;
+};
+
+class Parser {
+public:
+    explicit Parser(const std::string &pattern) : _pattern(pattern) {
+        for (size_t i = 0; i < pattern.size();) {
+            _cps.push_back(_decode(i));
+        }
+    }
+
+    Node parse() {
+        if (_peek('^')) {
+            _pos++;
+        }
+        Node node = _alt();
+        if (_pos < _cps.size()) {
+            _fail("unmatched ')'");
+        }
+        return node;
+    }
+
+private:
+    const std::string &_pattern;
+    std::vector<uint32_t> _cps;
+    size_t _pos = 0;
+
+    [[noreturn]] void _fail(const std::string &what) const {
+        throw std::invalid_argument("grammar regex: " + what + " in pattern " + _pattern);
+    }
+
+    uint32_t _decode(size_t &i) const {
+        const auto *u = reinterpret_cast<const unsigned char *>(_pattern.data());
+        const size_t len = u[i] < 0x80 ? 1 : (u[i] >> 5) == 6 ? 2 : (u[i] >> 4) == 14 ? 3 : (u[i] >> 3) == 30 ? 4 : 0;
+        if (len == 0 || i + len > _pattern.size()) {
+            _fail("invalid UTF-8");
+        }
+        uint32_t cp = len == 1 ? u[i] : u[i] & (0x7F >> len);
+        for (size_t k = 1; k < len; k++) {
+            cp = (cp << 6) | (u[i + k] & 0x3F);
+        }
+        i += len;
+        return cp;
+    }
+
+    bool _peek(uint32_t cp) const { return _pos < _cps.size() && _cps[_pos] == cp; }
+
+    bool _atEnd() const {
+        // A trailing $ is the implicit end anchor.
+        return _pos >= _cps.size() || (_cps[_pos] == '$' && _pos + 1 == _cps.size());
+    }
+
+    Node _alt() {
+        Node node{Node::Kind::Alt};
+        node.children.push_back(_concat());
+        while (_peek('|')) {
+            _pos++;
+            node.children.push_back(_concat());
+        }
+        return node.children.size() == 1 ? std::move(node.children[0]) : std::move(node);
+    }
+
+    Node _concat() {
+        Node node{Node::Kind::Concat};
+        while (!_atEnd() && !_peek('|') && !_peek(')')) {
+            node.children.push_back(_repeat());
+        }
+        if (_pos + 1 == _cps.size() && _peek('$')) {
+            _pos++;
+        }
+        return node;
+    }
+
+    Node _repeat() {
+        Node atom = _atom();
+        while (_pos < _cps.size()) {
+            int min, max;
+            const uint32_t c = _cps[_pos];
+            if (c == '*') {
+                min = 0, max = -1, _pos++;
+            } else if (c == '+') {
+                min = 1, max = -1, _pos++;
+            } else if (c == '?') {
+                min = 0, max = 1, _pos++;
+            } else if (c == '{' && _pos + 1 < _cps.size() && _cps[_pos + 1] >= '0' && _cps[_pos + 1] <= '9') {
+                _pos++;
+                min = max = _number();
+                if (_peek(',')) {
+                    _pos++;
+                    max = _peek('}') ? -1 : _number();
+                }
+                if (!_peek('}') || (max >= 0 && max < min)) {
+                    _fail("bad {m,n} quantifier");
+                }
+                _pos++;
+            } else {
+                break;
+            }
+            if (_peek('?')) {
+                _pos++; // lazy; only the language matters here
+            }
+            Node node{Node::Kind::Repeat};
+            node.min = min;
+            node.max = max;
+            node.children.push_back(std::move(atom));
+            atom = std::move(node);
+        }
+        return atom;
+    }
+
+    int _number() {
+        int value = 0;
+        const size_t start = _pos;
+        while (_pos < _cps.size() && _cps[_pos] >= '0' && _cps[_pos] <= '9') {
+            value = value * 10 + static_cast<int>(_cps[_pos++] - '0');
+            if (value > 1000) {
+                _fail("repetition count above 1000");
+            }
+        }
+        if (_pos == start) {
+            _fail("expected a number");
+        }
+        return value;
+    }
+
+    static Node _class(Ranges ranges) {
+        Node node{Node::Kind::Class};
+        node.ranges = normalize(std::move(ranges));
+        return node;
+    }
+
+    Node _atom() {
+        const uint32_t c = _cps[_pos++];
+        switch (c) {
+        case '(': {
+            if (_peek('?')) {
+                if (_pos + 1 < _cps.size() && _cps[_pos + 1] == ':') {
+                    _pos += 2;
+                } else {
+                    _fail("unsupported group syntax");
+                }
+            }
+            Node node = _alt();
+            if (!_peek(')')) {
+                _fail("missing ')'");
+            }
+            _pos++;
+            return node;
+        }
+        case '[':
+            return _class(_bracket());
+        case '.':
+            return _class(complement({{'\n', '\n'}}));
+        case '\\':
+            return _class(_escape());
+        case '*':
+        case '+':
+        case '?':
+            _fail("nothing to repeat");
+        case '^':
+        case '$':
+            _fail("anchors are only supported at the ends");
+        default:
+            return _class({{c, c}});
+        }
+    }
+
+    uint32_t _hex(size_t ndigit) {
+        uint32_t value = 0;
+        for (size_t i = 0; i < ndigit; i++) {
+            if (_pos >= _cps.size()) {
+                _fail("truncated escape");
+            }
+            const uint32_t c = _cps[_pos++];
+            uint32_t digit;
+            if (c >= '0' && c <= '9') {
+                digit = c - '0';
+            } else if (c >= 'a' && c <= 'f') {
+                digit = c - 'a' + 10;
+            } else if (c >= 'A' && c <= 'F') {
+                digit = c - 'A' + 10;
+            } else {
+                _fail("bad hex escape");
+            }
+            value = value * 16 + digit;
+        }
+        return value;
+    }
+
+    // Escape after the backslash, as a set of code points.
+    Ranges _escape() {
+        if (_pos >= _cps.size()) {
+            _fail("trailing backslash");
+        }
+        const uint32_t c = _cps[_pos++];
+        auto single = [](uint32_t cp) { return Ranges{{cp, cp}}; };
+        switch (c) {
+        case 'd':
+            return DIGIT;
+        case 'D':
+            return complement(DIGIT);
+        case 'w':
+            return WORD;
+        case 'W':
+            return complement(WORD);
+        case 's':
+            return SPACE;
+        case 'S':
+            return complement(SPACE);
+        case 'n':
+            return single('\n');
+        case 'r':
+            return single('\r');
+        case 't':
+            return single('\t');
+        case 'f':
+            return single('\f');
+        case 'v':
+            return single('\v');
+        case '0':
+            return single(0);
+        case 'u':
+            return single(_hex(4));
+        case 'x':
+            if (_peek('{')) {
+                _pos++;
+                uint32_t value = 0;
+                while (!_peek('}')) {
+                    value = value * 16 + _hex(1);
+                    if (value > MAX_CODE_POINT) {
+                        _fail("code point out of range");
+                    }
+                }
+                _pos++;
+                return single(value);
+            }
+            return single(_hex(2));
+        default:
+            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+                _fail(std::string("unsupported escape \\") + static_cast<char>(c));
+            }
+            return single(c);
+        }
+    }
+
+    Ranges _bracket() {
+        bool negate = false;
+        if (_peek('^')) {
+            negate = true;
+            _pos++;
+        }
+        Ranges ranges;
+        bool first = true;
+        while (true) {
+            if (_pos >= _cps.size()) {
+                _fail("missing ']'");
+            }
+            if (_peek(']') && !first) {
+                _pos++;
+                break;
+            }
+            first = false;
+            Ranges item;
+            if (_peek('\\')) {
+                _pos++;
+                item = _escape();
+            } else {
+                const uint32_t cp = _cps[_pos++];
+                item = {{cp, cp}};
+            }
+            // A range needs single code points on both sides.
+            if (item.size() == 1 && item[0].first == item[0].second && _peek('-') && _pos + 1 < _cps.size()
+                && _cps[_pos + 1] != ']') {
+                _pos++;
+                uint32_t hi;
+                if (_peek('\\')) {
+                    _pos++;
+                    Ranges end = _escape();
+                    if (end.size() != 1 || end[0].first != end[0].second) {
+                        _fail("bad class range");
+                    }
+                    hi = end[0].first;
+                } else {
+                    hi = _cps[_pos++];
+                }
+                if (hi < item[0].first) {
+                    _fail("bad class range");
+                }
+                item[0].second = hi;
+            }
+            ranges.insert(ranges.end(), item.begin(), item.end());
+        }
+        return negate ? complement(ranges) : normalize(ranges);
+    }
+};
+
+struct Nfa {
+    struct Edge {
+        uint8_t lo, hi;
+        int32_t to;
+    };
+    struct State {
+        std::vector<int32_t> eps;
+        std::vector<Edge> edges;
+    };
+    std::vector<State> states;
+
+    int32_t add() {
+        states.emplace_back();
+        return static_cast<int32_t>(states.size() - 1);
+    }
+
+    void eps(int32_t from, int32_t to) { states[from].eps.push_back(to); }
+
+    void edge(int32_t from, int32_t to, uint8_t lo, uint8_t hi) { states[from].edges.push_back({lo, hi, to}); }
+
+    // Byte paths from `from` to `to` for every code point in [lo, hi], split
+    // so that each path is a sequence of byte ranges (the utf8-ranges scheme).
+    void codePoints(int32_t from, int32_t to, uint32_t lo, uint32_t hi) {
+        if (lo <= 0xDFFF && hi >= 0xD800) {
+            if (lo < 0xD800) {
+                codePoints(from, to, lo, 0xD7FF);
+            }
+            if (hi > 0xDFFF) {
+                codePoints(from, to, 0xE000, hi);
+            }
+            return;
+        }
+        for (uint32_t limit : {0x7Fu, 0x7FFu, 0xFFFFu}) {
+            if (lo <= limit && hi > limit) {
+                codePoints(from, to, lo, limit);
+                codePoints(from, to, limit + 1, hi);
+                return;
+            }
+        }
+        if (hi < 0x80) {
+            edge(from, to, static_cast<uint8_t>(lo), static_cast<uint8_t>(hi));
+            return;
+        }
+        const size_t len = hi < 0x800 ? 2 : hi < 0x10000 ? 3 : 4;
+        for (size_t i = 1; i < len; i++) {
+            const uint32_t m = (1u << (6 * i)) - 1;
+            if ((lo & ~m) != (hi & ~m)) {
+                if ((lo & m) != 0) {
+                    codePoints(from, to, lo, lo | m);
+                    codePoints(from, to, (lo | m) + 1, hi);
+                    return;
+                }
+                if ((hi & m) != m) {
+                    codePoints(from, to, lo, (hi & ~m) - 1);
+                    codePoints(from, to, hi & ~m, hi);
+                    return;
+                }
+            }
+        }
+        uint8_t a[4], b[4];
+        encode(lo, len, a);
+        encode(hi, len, b);
+        int32_t cur = from;
+        for (size_t i = 0; i < len; i++) {
+            const int32_t nxt = i + 1 == len ? to : add();
+            edge(cur, nxt, a[i], b[i]);
+            cur = nxt;
+        }
+    }
+
+    static void encode(uint32_t cp, size_t len, uint8_t *out) {
+        static const uint8_t lead[] = {0, 0, 0xC0, 0xE0, 0xF0};
+        for (size_t i = len - 1; i > 0; i--) {
+            out[i] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+            cp >>= 6;
+        }
+        out[0] = static_cast<uint8_t>(lead[len] | cp);
+    }
+
+    // Thompson construction; returns the state reached after `node`.
+    int32_t build(const Node &node, int32_t in) {
+        switch (node.kind) {
+        case Node::Kind::Empty:
+            return in;
+        case Node::Kind::Class: {
+            const int32_t out = add();
+            for (const auto &r : node.ranges) {
+                codePoints(in, out, r.first, r.second);
+            }
+            return out;
+        }
+        case Node::Kind::Concat:
+            for (const auto &child : node.children) {
+                in = build(child, in);
+            }
+            return in;
+        case Node::Kind::Alt: {
+            const int32_t out = add();
+            for (const auto &child : node.children) {
+                const int32_t start = add();
+                eps(in, start);
+                eps(build(child, start), out);
+            }
+            return out;
+        }
+        case Node::Kind::Repeat: {
+            const Node &child = node.children[0];
+            for (int i = 0; i < node.min; i++) {
+                in = build(child, in);
+            }
+            if (node.max < 0) {
+                const int32_t loop = add();
+                eps(in, loop);
+                eps(build(child, loop), loop);
+                return loop;
+            }
+            const int32_t out = add();
+            for (int i = node.min; i < node.max; i++) {
+                eps(in, out);
+                in = build(child, in);
+            }
+            eps(in, out);
+            return out;
+        }
+        }
+        return in;
+    }
+};
+
+struct VectorHash {
+    size_t operator()(const std::vector<int32_t> &v) const {
+        size_t h = v.size();
+        for (int32_t x : v) {
+            h = h * 0x9E3779B97F4A7C15ull + static_cast<size_t>(x);
+        }
+        return h;
+    }
+};
+
+} // namespace
+
+ByteDfa ByteDfa::fromRegex(const std::string &pattern, size_t max_states) {
+    const Node root = Parser(pattern).parse();
+    Nfa nfa;
+    const int32_t start = nfa.add();
+    const int32_t final_state = nfa.build(root, start);
+
+    // Subset construction over epsilon closures.
+    std::vector<char> seen(nfa.states.size(), 0);
+    auto closure = [&](std::vector<int32_t> &set) {
+        std::vector<int32_t> stack(set.begin(), set.end());
+        for (int32_t s : set) {
+            seen[s] = 1;
+        }
+        while (!stack.empty()) {
+            const int32_t s = stack.back();
+            stack.pop_back();
+            for (int32_t t : nfa.states[s].eps) {
+                if (!seen[t]) {
+                    seen[t] = 1;
+                    set.push_back(t);
+                    stack.push_back(t);
+                }
+            }
+        }
+        for (int32_t s : set) {
+            seen[s] = 0;
+        }
+        // Only states with byte edges (or the final state) distinguish subsets.
+        set.erase(std::remove_if(set.begin(), set.end(),
+                                 [&](int32_t s) { return nfa.states[s].edges.empty() && s != final_state; }),
+                  set.end());
+        std::sort(set.begin(), set.end());
+    };
+
+    ByteDfa dfa;
+    std::vector<std::vector<int32_t>> subsets;
+    std::unordered_map<std::vector<int32_t>, int32_t, VectorHash> ids;
+    auto intern = [&](std::vector<int32_t> set) -> int32_t {
+        if (set.empty()) {
+            return -1;
+        }
+        auto it = ids.find(set);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        if (subsets.size() >= max_states) {
+            throw std::invalid_argument("grammar regex: automaton exceeds " + std::to_string(max_states)
+                                        + " states in pattern " + pattern);
+        }
+        const int32_t id = static_cast<int32_t>(subsets.size());
+        ids.emplace(set, id);
+        subsets.push_back(std::move(set));
+        return id;
+    };
+
+    std::vector<int32_t> init{start};
+    closure(init);
+    intern(std::move(init));
+    std::array<std::vector<int32_t>, 256> buckets;
+    for (size_t d = 0; d < subsets.size(); d++) {
+        for (auto &bucket : buckets) {
+            bucket.clear();
+        }
+        bool accepting = false;
+        for (int32_t s : subsets[d]) {
+            accepting |= s == final_state;
+            for (const auto &e : nfa.states[s].edges) {
+                for (int b = e.lo; b <= e.hi; b++) {
+                    buckets[b].push_back(e.to);
+                }
+            }
+        }
+        std::array<int32_t, 256> row;
+        for (int b = 0; b < 256; b++) {
+            auto &bucket = buckets[b];
+            std::sort(bucket.begin(), bucket.end());
+            bucket.erase(std::unique(bucket.begin(), bucket.end()), bucket.end());
+            if (b > 0 && bucket == buckets[b - 1]) {
+                row[b] = row[b - 1];
+                continue;
+            }
+            std::vector<int32_t> set = bucket;
+            closure(set);
+            row[b] = intern(std::move(set));
+        }
+        dfa.next.push_back(row);
+        dfa.accept.push_back(accepting);
+    }
+
+    // Drop states that can no longer reach an accepting state.
+    const size_t n = dfa.size();
+    std::vector<std::vector<int32_t>> preds(n);
+    for (size_t s = 0; s < n; s++) {
+        for (int32_t t : dfa.next[s]) {
+            if (t >= 0 && (preds[t].empty() || preds[t].back() != static_cast<int32_t>(s))) {
+                preds[t].push_back(static_cast<int32_t>(s));
+            }
+        }
+    }
+    std::vector<char> live(n, 0);
+    std::vector<int32_t> stack;
+    for (size_t s = 0; s < n; s++) {
+        if (dfa.accept[s]) {
+            live[s] = 1;
+            stack.push_back(static_cast<int32_t>(s));
+        }
+    }
+    while (!stack.empty()) {
+        const int32_t s = stack.back();
+        stack.pop_back();
+        for (int32_t p : preds[s]) {
+            if (!live[p]) {
+                live[p] = 1;
+                stack.push_back(p);
+            }
+        }
+    }
+    if (!live[0]) {
+        throw std::invalid_argument("grammar regex: pattern matches nothing: " + pattern);
+    }
+
+    // Merge equivalent states (Moore's partition refinement): start from
+    // accepting vs. not, split by the blocks of the successors until stable.
+    // Dead states form block -1. The start state stays block 0.
+    std::vector<int32_t> block(n, -1);
+    for (size_t s = 0; s < n; s++) {
+        if (live[s]) {
+            block[s] = dfa.accept[s] ? 1 : 0;
+        }
+    }
+    size_t nblock = 0;
+    while (true) {
+        std::map<std::vector<int32_t>, int32_t> signatures;
+        std::vector<int32_t> refined(n, -1);
+        std::vector<int32_t> signature(257);
+        // Number blocks in order of first appearance so that state 0 gets block 0.
+        for (size_t s = 0; s < n; s++) {
+            if (block[s] < 0) {
+                continue;
+            }
+            signature[0] = block[s];
+            for (int b = 0; b < 256; b++) {
+                const int32_t t = dfa.next[s][b];
+                signature[b + 1] = t >= 0 ? block[t] : -1;
+            }
+            auto it = signatures.emplace(signature, static_cast<int32_t>(signatures.size())).first;
+            refined[s] = it->second;
+        }
+        block.swap(refined);
+        if (signatures.size() == nblock) {
+            break;
+        }
+        nblock = signatures.size();
+    }
+
+    ByteDfa minimal;
+    minimal.next.resize(nblock);
+    minimal.accept.resize(nblock);
+    for (size_t s = 0; s < n; s++) {
+        if (block[s] < 0) {
+            continue;
+        }
+        auto &row = minimal.next[block[s]];
+        for (int b = 0; b < 256; b++) {
+            const int32_t t = dfa.next[s][b];
+            row[b] = t >= 0 ? block[t] : -1;
+        }
+        minimal.accept[block[s]] = dfa.accept[s];
+    }
+    return minimal;
+}
+
+} // namespace llaisys::models
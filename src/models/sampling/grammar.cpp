@@ -0,0 +1,195 @@
+#include "grammar.hpp"
+
+#include "../../utils.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace llaisys::models {
+
+namespace {
+
+inline unsigned lowestBit(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return index;
+#else
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+}
+
+inline unsigned popcount(uint64_t x) {
+#ifdef _MSC_VER
+    return static_cast<unsigned>(__popcnt64(x));
+#else
+    return static_cast<unsigned>(__builtin_popcountll(x));
+#endif
+}
+
+} // namespace
+
+Grammar::Grammar(ByteDfa dfa, const std::vector<std::string> &token_bytes, int64_t end_token)
+    : _dfa(std::move(dfa)), _token_bytes(token_bytes), _end_token(end_token) {
+    CHECK_ARGUMENT(_dfa.size() > 0, "Grammar: empty automaton");
+    CHECK_ARGUMENT(end_token >= 0, "Grammar: end token must be set");
+    const size_t nbits = std::max(_token_bytes.size(), static_cast<size_t>(end_token) + 1);
+    _words = (nbits + 63) / 64;
+    _buildMasks();
+}
+
+std::shared_ptr<const Grammar> Grammar::fromRegex(const std::string &pattern,
+                                                  const std::vector<std::string> &token_bytes, int64_t end_token) {
+    return std::make_shared<const Grammar>(ByteDfa::fromRegex(pattern), token_bytes, end_token);
+}
+
+std::shared_ptr<const Grammar> Grammar::fromJsonSchema(const std::string &schema,
+                                                       const std::vector<std::string> &token_bytes,
+                                                       int64_t end_token) {
+    return fromRegex(jsonSchemaToRegex(schema), token_bytes, end_token);
+}
+
+// Walk every state over a byte trie of the vocabulary, laid out in preorder so
+// each state is one forward scan: a token is allowed when the walk reaches its
+// node alive, and a dead byte skips the whole subtree below it.
+void Grammar::_buildMasks() {
+    std::vector<int32_t> order;
+    for (size_t id = 0; id < _token_bytes.size(); id++) {
+        if (!_token_bytes[id].empty() && static_cast<int64_t>(id) != _end_token) {
+            order.push_back(static_cast<int32_t>(id));
+        }
+    }
+    std::sort(order.begin(), order.end(),
+              [this](int32_t a, int32_t b) { return _token_bytes[a] < _token_bytes[b]; });
+
+    std::vector<uint8_t> byte{0};
+    std::vector<uint32_t> depth{0};
+    std::vector<uint32_t> skip{1};
+    std::vector<uint32_t> first_token{0}; // tokens ending at node i: terminal[first_token[i], first_token[i + 1])
+    std::vector<int32_t> terminal;
+    const std::string *prev = nullptr;
+    for (int32_t id : order) {
+        const std::string &bytes = _token_bytes[id];
+        size_t common = 0;
+        if (prev != nullptr) {
+            while (common < prev->size() && common < bytes.size() && (*prev)[common] == bytes[common]) {
+                common++;
+            }
+        }
+        for (size_t k = common; k < bytes.size(); k++) {
+            byte.push_back(static_cast<uint8_t>(bytes[k]));
+            depth.push_back(static_cast<uint32_t>(k + 1));
+            skip.push_back(0);
+            first_token.push_back(static_cast<uint32_t>(terminal.size()));
+        }
+        terminal.push_back(id);
+        prev = &bytes;
+    }
+    const size_t nnode = byte.size();
+    first_token.push_back(static_cast<uint32_t>(terminal.size()));
+    // skip[i]: the first node after i's subtree.
+    std::vector<uint32_t> path;
+    for (size_t i = 1; i < nnode; i++) {
+        while (!path.empty() && depth[path.back()] >= depth[i]) {
+            skip[path.back()] = static_cast<uint32_t>(i);
+            path.pop_back();
+        }
+        path.push_back(static_cast<uint32_t>(i));
+    }
+    for (uint32_t i : path) {
+        skip[i] = static_cast<uint32_t>(nnode);
+    }
+
+    _masks.assign(_dfa.size() * _words, 0);
+    std::vector<int32_t> states(1);
+    for (size_t s = 0; s < _dfa.size(); s++) {
+        uint64_t *mask = _masks.data() + s * _words;
+        states.assign(states.size(), -1);
+        states[0] = static_cast<int32_t>(s);
+        for (size_t i = 1; i < nnode;) {
+            const int32_t next = _dfa.next[states[depth[i] - 1]][byte[i]];
+            if (next < 0) {
+                i = skip[i];
+                continue;
+            }
+            if (depth[i] >= states.size()) {
+                states.resize(depth[i] + 1);
+            }
+            states[depth[i]] = next;
+            for (uint32_t t = first_token[i]; t < first_token[i + 1]; t++) {
+                mask[terminal[t] / 64] |= 1ull << (terminal[t] % 64);
+            }
+            i++;
+        }
+        if (_dfa.accept[s]) {
+            mask[_end_token / 64] |= 1ull << (_end_token % 64);
+        }
+    }
+}
+
+bool Grammar::allows(int32_t state, int64_t token) const {
+    if (state < 0 || token < 0 || static_cast<size_t>(token) >= _words * 64) {
+        return false;
+    }
+    return (_masks[state * _words + token / 64] >> (token % 64)) & 1;
+}
+
+int32_t Grammar::advance(int32_t state, int64_t token) const {
+    if (!allows(state, token)) {
+        return -1;
+    }
+    if (token == _end_token) {
+        return state;
+    }
+    for (unsigned char c : _token_bytes[token]) {
+        state = _dfa.next[state][c];
+    }
+    return state;
+}
+
+void Grammar::applyMask(int32_t state, float *logits, size_t voc) const {
+    constexpr float NEG_INF = -std::numeric_limits<float>::infinity();
+    const uint64_t *mask = _masks.data() + static_cast<size_t>(state) * _words;
+    const size_t covered = std::min(voc, _words * 64);
+    // Whole words first: all-allowed words are skipped and all-forbidden ones
+    // filled, which covers most of the vocabulary in either kind of state.
+    size_t w = 0;
+    for (; (w + 1) * 64 <= covered; w++) {
+        const uint64_t bits = mask[w];
+        float *row = logits + w * 64;
+        if (bits == ~0ull) {
+            continue;
+        }
+        if (bits == 0) {
+            std::fill(row, row + 64, NEG_INF);
+            continue;
+        }
+        // Touch only the minority: forbidden slots, or the allowed ones after a fill.
+        if (popcount(bits) >= 32) {
+            for (uint64_t rest = ~bits; rest != 0; rest &= rest - 1) {
+                row[lowestBit(rest)] = NEG_INF;
+            }
+        } else {
+            float keep[64];
+            for (uint64_t rest = bits; rest != 0; rest &= rest - 1) {
+                keep[lowestBit(rest)] = row[lowestBit(rest)];
+            }
+            std::fill(row, row + 64, NEG_INF);
+            for (uint64_t rest = bits; rest != 0; rest &= rest - 1) {
+                row[lowestBit(rest)] = keep[lowestBit(rest)];
+            }
+        }
+    }
+    for (size_t i = w * 64; i < covered; i++) {
+        if (!((mask[w] >> (i - w * 64)) & 1)) {
+            logits[i] = NEG_INF;
+        }
+    }
+    std::fill(logits + covered, logits + voc, NEG_INF);
+}
+
+} // namespace llaisys::models
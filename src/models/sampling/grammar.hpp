@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace llaisys::models {
+
+// Deterministic automaton over UTF-8 bytes that recognizes a whole output.
+// State 0 is the start and -1 is dead. Construction keeps only states from
+// which an accepting state is still reachable, so any live state can be
+// completed.
+struct ByteDfa {
+    std::vector<std::array<int32_t, 256>> next;
+    std::vector<bool> accept;
+
+    size_t size() const { return next.size(); }
+
+    // Compile an anchored regular expression over code points: literals and
+    // escapes (\n \t \xHH \uHHHH \x{..}), `.`, classes with ranges and
+    // negation, ASCII \d \w \s and their negations, groups, alternation and the
+    // greedy or lazy quantifiers * + ? {m} {m,} {m,n}. A leading ^ and trailing
+    // $ are accepted and ignored. Throws std::invalid_argument on anything
+    // else, or when the automaton grows past `max_states`.
+    static ByteDfa fromRegex(const std::string &pattern, size_t max_states = 1 << 16);
+};
+
+// Translate a JSON schema to a regular expression for ByteDfa::fromRegex.
+// Covers type (including unions), enum, const, anyOf/oneOf, local $ref,
+// object properties/required (emitted in declaration order), array
+// items/minItems/maxItems, string minLength/maxLength/pattern/format and
+// integer/number/boolean/null. `{}`, or a schema without further constraints,
+// accepts any JSON value nested at most `max_depth` levels deep.
+std::string jsonSchemaToRegex(const std::string &schema, int max_depth = 3);
+
+// Grammar compiled against a vocabulary: the automaton plus, for every state,
+// a bitset of the tokens whose bytes keep the output inside the language. The
+// end token is allowed exactly in accepting states. Immutable and shared by
+// all sequences that decode with it; per-sequence progress is just a state id.
+class Grammar {
+public:
+    // token_bytes[id] is what token `id` decodes to; empty entries (special
+    // tokens) are never allowed.
+    Grammar(ByteDfa dfa, const std::vector<std::string> &token_bytes, int64_t end_token);
+
+    static std::shared_ptr<const Grammar> fromRegex(const std::string &pattern,
+                                                    const std::vector<std::string> &token_bytes, int64_t end_token);
+    static std::shared_ptr<const Grammar> fromJsonSchema(const std::string &schema,
+                                                         const std::vector<std::string> &token_bytes,
+                                                         int64_t end_token);
+
+    size_t numStates() const { return _dfa.size(); }
+    int64_t endToken() const { return _end_token; }
+    bool isAccepting(int32_t state) const { return _dfa.accept[state]; }
+    bool allows(int32_t state, int64_t token) const;
+    // State after emitting `token`, or -1 when the grammar forbids it. The end
+    // token leaves the state unchanged.
+    int32_t advance(int32_t state, int64_t token) const;
+
+    // Set the logits of every token `state` forbids to -inf, 64 tokens per
+    // mask word; ids past the grammar's vocabulary are always forbidden.
+    void applyMask(int32_t state, float *logits, size_t voc) const;
+
+private:
+    ByteDfa _dfa;
+    std::vector<std::string> _token_bytes;
+    int64_t _end_token;
+    size_t _words; // mask words per state
+    std::vector<uint64_t> _masks;
+
+    void _buildMasks();
+};
+
+} // namespace llaisys::models
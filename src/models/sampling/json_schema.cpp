@@ -0,0 +1,264 @@
+#include "grammar.hpp"
+
+#include "../../utils/json.hpp"
+
+#include <stdexcept>
+
+namespace llaisys::models {
+
+namespace {
+
+using utils::Json;
+
+const std::string WS = "[ \\t\\n]*";
+const std::string CHAR = "([^\"\\\\\\x00-\\x1F]|\\\\([\"\\\\/bfnrt]|u[0-9a-fA-F]{4}))";
+const std::string STRING = "\"" + CHAR + "*\"";
+const std::string INTEGER = "-?(0|[1-9][0-9]*)";
+const std::string NUMBER = INTEGER + "(\\.[0-9]+)?([eE][+-]?[0-9]+)?";
+const std::string DATE = "[0-9]{4}-(0[1-9]|1[0-2])-(0[1-9]|[12][0-9]|3[01])";
+const std::string TIME = "([01][0-9]|2[0-3]):[0-5][0-9]:[0-5][0-9](\\.[0-9]+)?(Z|[+-]([01][0-9]|2[0-3]):[0-5][0-9])?";
+const std::string UUID = "[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}";
+
+constexpr int MAX_REF_DEPTH = 16;
+
+std::string escape(const std::string &literal) {
+    std::string out;
+    for (char c : literal) {
+        if (std::string("\\.^$|?*+()[]{}-").find(c) != std::string::npos) {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+std::string alternation(const std::vector<std::string> &options) {
+    std::string out = "(";
+    for (size_t i = 0; i < options.size(); i++) {
+        out += (i ? "|" : "") + options[i];
+    }
+    return out + ")";
+}
+
+// `item`, separated by commas, repeated [min, max] times (max < 0: unbounded).
+std::string list(const std::string &item, int64_t min, int64_t max) {
+    if (max == 0) {
+        return "";
+    }
+    std::string more = "(" + WS + "," + WS + item + ")";
+    const int64_t lo = min > 0 ? min - 1 : 0;
+    more += max < 0 ? (lo == 0 ? "*" : "{" + std::to_string(lo) + ",}")
+                    : "{" + std::to_string(lo) + "," + std::to_string(max - 1) + "}";
+    const std::string body = item + more;
+    return min > 0 ? body : "(" + body + ")?";
+}
+
+class SchemaConverter {
+public:
+    SchemaConverter(const Json &root, int max_depth) : _root(root), _max_depth(max_depth) {}
+
+    std::string convert(const Json &schema, int ref_depth = 0) const {
+        if (schema.isBool()) {
+            if (!schema.asBool()) {
+                throw std::invalid_argument("json schema: 'false' accepts nothing");
+            }
+            return anyValue(_max_depth);
+        }
+        if (!schema.isObject()) {
+            throw std::invalid_argument("json schema: a schema must be an object or a boolean");
+        }
+        if (schema["$ref"].isString()) {
+            if (ref_depth >= MAX_REF_DEPTH) {
+                throw std::invalid_argument("json schema: $ref nesting too deep (recursive schemas are not supported)");
+            }
+            return convert(_resolve(schema["$ref"].asString()), ref_depth + 1);
+        }
+        if (schema.contains("const")) {
+            return escape(schema["const"].dump());
+        }
+        if (schema["enum"].isArray()) {
+            std::vector<std::string> options;
+            for (const auto &value : schema["enum"].asArray()) {
+                options.push_back(escape(value.dump()));
+            }
+            return alternation(options);
+        }
+        for (const char *key : {"anyOf", "oneOf"}) {
+            if (schema[key].isArray()) {
+                std::vector<std::string> options;
+                for (const auto &option : schema[key].asArray()) {
+                    options.push_back(convert(option, ref_depth));
+                }
+                return alternation(options);
+            }
+        }
+        if (schema["allOf"].isArray() && schema["allOf"].size() == 1) {
+            return convert(schema["allOf"][0], ref_depth);
+        }
+
+        const Json &type = schema["type"];
+        if (type.isArray()) {
+            std::vector<std::string> options;
+            for (const auto &t : type.asArray()) {
+                Json single = schema;
+                single["type"] = t;
+                options.push_back(convert(single, ref_depth));
+            }
+            return alternation(options);
+        }
+        std::string name = type.isString() ? type.asString() : "";
+        if (name.empty()) {
+            name = schema.contains("properties") ? "object" : schema.contains("items") ? "array" : "";
+        }
+        if (name == "string") {
+            return _string(schema);
+        } else if (name == "integer") {
+            return INTEGER;
+        } else if (name == "number") {
+            return NUMBER;
+        } else if (name == "boolean") {
+            return "(true|false)";
+        } else if (name == "null") {
+            return "null";
+        } else if (name == "array") {
+            const std::string item = schema.contains("items") ? convert(schema["items"], ref_depth) : anyValue(_max_depth - 1);
+            const int64_t min = schema["minItems"].isNumber() ? schema["minItems"].asInt() : 0;
+            const int64_t max = schema["maxItems"].isNumber() ? schema["maxItems"].asInt() : -1;
+            return "\\[" + WS + list(item, min, max) + WS + "\\]";
+        } else if (name == "object") {
+            return _object(schema, ref_depth);
+        } else if (name.empty()) {
+            return anyValue(_max_depth);
+        }
+        throw std::invalid_argument("json schema: unsupported type '" + name + "'");
+    }
+
+    // Any JSON value with at most `depth` levels of nested containers.
+    std::string anyValue(int depth) const {
+        const std::string scalar = STRING + "|" + NUMBER + "|true|false|null";
+        if (depth <= 0) {
+            return "(" + scalar + ")";
+        }
+        const std::string inner = anyValue(depth - 1);
+        return "(" + scalar + "|" + _array(inner) + "|" + _map(inner) + ")";
+    }
+
+private:
+    const Json &_root;
+    int _max_depth;
+
+    const Json &_resolve(const std::string &ref) const {
+        if (ref == "#") {
+            return _root;
+        }
+        if (ref.compare(0, 2, "#/") != 0) {
+            throw std::invalid_argument("json schema: only local $ref is supported: " + ref);
+        }
+        const Json *node = &_root;
+        size_t pos = 2;
+        while (pos <= ref.size()) {
+            size_t end = ref.find('/', pos);
+            if (end == std::string::npos) {
+                end = ref.size();
+            }
+            std::string key;
+            for (size_t i = pos; i < end; i++) {
+                if (ref[i] == '~' && i + 1 < end) {
+                    key += ref[++i] == '1' ? '/' : '~';
+                } else {
+                    key += ref[i];
+                }
+            }
+            if (!node->isObject() || !node->contains(key)) {
+                throw std::invalid_argument("json schema: unresolved $ref " + ref);
+            }
+            node = &(*node)[key];
+            pos = end + 1;
+        }
+        return *node;
+    }
+
+    std::string _string(const Json &schema) const {
+        if (schema["pattern"].isString()) {
+            std::string pattern = schema["pattern"].asString();
+            if (!pattern.empty() && pattern.front() == '^') {
+                pattern.erase(0, 1);
+            }
+            if (!pattern.empty() && pattern.back() == '$' && (pattern.size() < 2 || pattern[pattern.size() - 2] != '\\')) {
+                pattern.pop_back();
+            }
+            return "\"(" + pattern + ")\"";
+        }
+        const std::string format = schema["format"].isString() ? schema["format"].asString() : "";
+        if (format == "date") {
+            return "\"" + DATE + "\"";
+        } else if (format == "time") {
+            return "\"" + TIME + "\"";
+        } else if (format == "date-time") {
+            return "\"" + DATE + "T" + TIME + "\"";
+        } else if (format == "uuid") {
+            return "\"" + UUID + "\"";
+        }
+        const int64_t min = schema["minLength"].isNumber() ? schema["minLength"].asInt() : 0;
+        const int64_t max = schema["maxLength"].isNumber() ? schema["maxLength"].asInt() : -1;
+        if (min == 0 && max < 0) {
+            return STRING;
+        }
+        return "\"" + CHAR + "{" + std::to_string(min) + "," + (max < 0 ? "" : std::to_string(max)) + "}\"";
+    }
+
+    std::string _array(const std::string &item) const {
+        return "\\[" + WS + list(item, 0, -1) + WS + "\\]";
+    }
+
+    std::string _map(const std::string &value) const {
+        return "\\{" + WS + list(STRING + WS + ":" + WS + value, 0, -1) + WS + "\\}";
+    }
+
+    // Properties appear in declaration order; optional ones may be left out.
+    std::string _object(const Json &schema, int ref_depth) const {
+        if (!schema["properties"].isObject() || schema["properties"].size() == 0) {
+            const Json &extra = schema["additionalProperties"];
+            return _map(extra.isObject() ? convert(extra, ref_depth) : anyValue(_max_depth - 1));
+        }
+        std::vector<std::string> items;
+        std::vector<bool> required;
+        for (const auto &[key, value] : schema["properties"].items()) {
+            items.push_back(escape(Json(key).dump()) + WS + ":" + WS + convert(value, ref_depth));
+            bool needed = false;
+            if (schema["required"].isArray()) {
+                for (const auto &name : schema["required"].asArray()) {
+                    needed |= name.isString() && name.asString() == key;
+                }
+            }
+            required.push_back(needed);
+        }
+        // rest[j]: the properties after j-1, each preceded by a comma.
+        std::vector<std::string> rest(items.size() + 1);
+        for (size_t j = items.size(); j-- > 0;) {
+            const std::string item = "(" + WS + "," + WS + items[j] + ")";
+            rest[j] = (required[j] ? item : item + "?") + rest[j + 1];
+        }
+        // The first property present is either the first required one or an
+        // optional one before it.
+        std::vector<std::string> firsts;
+        bool all_optional = true;
+        for (size_t k = 0; k < items.size(); k++) {
+            firsts.push_back(items[k] + rest[k + 1]);
+            if (required[k]) {
+                all_optional = false;
+                break;
+            }
+        }
+        return "\\{" + WS + alternation(firsts) + (all_optional ? "?" : "") + WS + "\\}";
+    }
+};
+
+} // namespace
+
+std::string jsonSchemaToRegex(const std::string &schema, int max_depth) {
+    const Json root = Json::parse(schema);
+    return SchemaConverter(root, max_depth).convert(root);
+}
+
+} // namespace llaisys::models
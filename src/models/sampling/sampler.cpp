@@ -0,0 +1,138 @@
+#include "sampler.hpp"
+
+#include "../../utils.hpp"
+#include "../../utils/vmath.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace llaisys::models {
+
+int64_t argmax(const float *vals, size_t n) {
+    return static_cast<int64_t>(std::max_element(vals, vals + n) - vals);
+}
+
+Sampler::Sampler(const SamplingConfig &config) : _config(config), _rng(config.seed) {}
+
+bool Sampler::isGreedy() const {
+    return _config.top_k == 1 || _config.temperature <= 0.0f;
+}
+
+void Sampler::distribution(const float *logits, size_t voc, std::vector<float> &probs) const {
+    if (_config.grammar) {
+        std::vector<float> masked(logits, logits + voc);
+        _config.grammar->applyMask(_grammar_state, masked.data(), voc);
+        _filter(masked.data(), voc, probs);
+    } else {
+        _filter(logits, voc, probs);
+    }
+}
+
+void Sampler::_filter(const float *logits, size_t voc, std::vector<float> &probs) const {
+    probs.assign(voc, 0.0f);
+    if (isGreedy()) {
+        probs[argmax(logits, voc)] = 1.0f;
+        return;
+    }
+
+    // Candidates sorted by logit, restricted to the top-k when enabled.
+    std::vector<int64_t> candidates(voc);
+    std::iota(candidates.begin(), candidates.end(), 0);
+    auto by_logit = [logits](int64_t a, int64_t b) { return logits[a] > logits[b]; };
+    size_t ncand = voc;
+    if (_config.top_k > 0 && static_cast<size_t>(_config.top_k) < voc) {
+        ncand = static_cast<size_t>(_config.top_k);
+        std::nth_element(candidates.begin(), candidates.begin() + ncand, candidates.end(), by_logit);
+        candidates.resize(ncand);
+    }
+    std::sort(candidates.begin(), candidates.end(), by_logit);
+
+    const float inv_temp = 1.0f / _config.temperature;
+    const float max_logit = logits[candidates[0]];
+    std::vector<float> weights(ncand);
+    for (size_t i = 0; i < ncand; i++) {
+        weights[i] = logits[candidates[i]];
+    }
+    const double sum = utils::vmath::expSum(weights.data(), weights.data(), ncand, max_logit, inv_temp);
+    for (size_t i = 0; i < ncand; i++) {
+        probs[candidates[i]] = weights[i];
+    }
+
+    // Keep the smallest prefix whose mass reaches top_p (always at least one token).
+    double kept = 0.0;
+    size_t nkeep = 0;
+    while (nkeep < ncand) {
+        kept += probs[candidates[nkeep]] / sum;
+        nkeep++;
+        if (_config.top_p < 1.0f && kept >= _config.top_p) {
+            break;
+        }
+    }
+    double norm = 0.0;
+    for (size_t i = 0; i < ncand; i++) {
+        if (i < nkeep) {
+            norm += probs[candidates[i]];
+        } else {
+            probs[candidates[i]] = 0.0f;
+        }
+    }
+    for (size_t i = 0; i < nkeep; i++) {
+        probs[candidates[i]] = static_cast<float>(probs[candidates[i]] / norm);
+    }
+}
+
+int64_t Sampler::sample(const float *logits, size_t voc) {
+    const Grammar *grammar = _config.grammar.get();
+    if (grammar == nullptr) {
+        if (isGreedy()) {
+            return argmax(logits, voc);
+        }
+        std::vector<float> probs;
+        distribution(logits, voc, probs);
+        return draw(probs);
+    }
+
+    _masked.assign(logits, logits + voc);
+    grammar->applyMask(_grammar_state, _masked.data(), voc);
+    int64_t token;
+    if (isGreedy()) {
+        token = argmax(_masked.data(), voc);
+    } else {
+        std::vector<float> probs;
+        _filter(_masked.data(), voc, probs);
+        token = draw(probs);
+    }
+    const int32_t next = grammar->advance(_grammar_state, token);
+    // Only reachable if the vocabulary cannot continue the grammar at all.
+    CHECK_ARGUMENT(next >= 0, "Sampler: grammar allows no token in the current state");
+    _grammar_state = next;
+    return token;
+}
+
+int64_t Sampler::draw(const std::vector<float> &probs) {
+    double total = 0.0;
+    for (float p : probs) {
+        total += p;
+    }
+    double target = uniform() * total;
+    int64_t last_nonzero = 0;
+    double acc = 0.0;
+    for (size_t i = 0; i < probs.size(); i++) {
+        if (probs[i] <= 0.0f) {
+            continue;
+        }
+        acc += probs[i];
+        last_nonzero = static_cast<int64_t>(i);
+        if (acc > target) {
+            return last_nonzero;
+        }
+    }
+    return last_nonzero;
+}
+
+float Sampler::uniform() {
+    return std::uniform_real_distribution<float>(0.0f, 1.0f)(_rng);
+}
+
+} // namespace llaisys::models
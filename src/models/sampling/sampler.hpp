@@ -0,0 +1,58 @@
+#pragma once
+
+#include "llaisys.h"
+
+#include "grammar.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace llaisys::models {
+
+struct SamplingConfig {
+    int top_k = 1;           // <= 0 disables top-k filtering
+    float top_p = 1.0f;      // >= 1 disables nucleus filtering
+    float temperature = 1.0f; // <= 0 means greedy
+    uint64_t seed = 0;
+    std::shared_ptr<const Grammar> grammar; // constrains the output when set
+};
+
+// Turns logits into tokens following the HuggingFace processor order:
+// temperature, then top-k, then top-p. Greedy configs (top_k == 1 or
+// temperature <= 0) resolve to argmax and a one-hot distribution, which keeps
+// speculative acceptance exact for greedy decoding.
+//
+// With a grammar, tokens the grammar forbids in the current state are masked
+// to -inf before any of that, and sample() advances the state with the token
+// it returns. A sampler therefore follows one sequence.
+class Sampler {
+public:
+    Sampler(const SamplingConfig &config = SamplingConfig{});
+
+    const SamplingConfig &config() const { return _config; }
+    bool isGreedy() const;
+
+    // Filtered, normalized next-token distribution over the vocabulary.
+    void distribution(const float *logits, size_t voc, std::vector<float> &probs) const;
+    // Sample a token directly from a logits row and feed it to the grammar.
+    int64_t sample(const float *logits, size_t voc);
+    // Draw a token from a normalized (or unnormalized, non-negative) distribution.
+    int64_t draw(const std::vector<float> &probs);
+    // Uniform random number in [0, 1).
+    float uniform();
+
+private:
+    SamplingConfig _config;
+    std::mt19937_64 _rng;
+    int32_t _grammar_state = 0;
+    std::vector<float> _masked;
+
+    // distribution() without the grammar mask.
+    void _filter(const float *logits, size_t voc, std::vector<float> &probs) const;
+};
+
+int64_t argmax(const float *vals, size_t n);
+
+} // namespace llaisys::models
@@ -1,15 +1,30 @@
 #include "add_cpu.hpp"
 
 #include "../../../utils.hpp"
+#include "../../../utils/vmath.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 template <typename T>
 void add_(T *c, const T *a, const T *b, size_t numel) {
-    for (size_t i = 0; i < numel; i++) {
-        if constexpr (std::is_same_v<T, llaisys::bf16_t> || std::is_same_v<T, llaisys::fp16_t>) {
-            c[i] = llaisys::utils::cast<T>(llaisys::utils::cast<float>(a[i]) + llaisys::utils::cast<float>(b[i]));
-        } else {
+    if constexpr (std::is_same_v<T, llaisys::bf16_t> || std::is_same_v<T, llaisys::fp16_t>) {
+        // Through float a tile at a time; c may alias a or b.
+        namespace vmath = llaisys::utils::vmath;
+        constexpr size_t CHUNK = 256;
+        float fa[CHUNK];
+        float fb[CHUNK];
+        for (size_t begin = 0; begin < numel; begin += CHUNK) {
+            const size_t n = std::min(CHUNK, numel - begin);
+            vmath::toF32(fa, a + begin, n);
+            vmath::toF32(fb, b + begin, n);
+            for (size_t i = 0; i < n; i++) {
+                fa[i] += fb[i];
+            }
+            vmath::fromF32(c + begin, fa, n);
+        }
+    } else {
+        for (size_t i = 0; i < numel; i++) {
             c[i] = a[i] + b[i];
         }
     }
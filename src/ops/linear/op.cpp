@@ -1,60 +1,274 @@
 #include "op.hpp"
-#include "../../utils/types.hpp"
+#include "../../utils.hpp"
+#include "../../utils/vmath.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
 
 namespace llaisys::ops {
 
+namespace {
+std::atomic<LinearAccumulation> &globalAccumulation() {
+    static std::atomic<LinearAccumulation> mode{LinearAccumulation::F32};
+    return mode;
+}
+
+// Weight rows converted to float at a time, sized to stay in L2 while every
+// group of input rows runs against them.
+constexpr size_t W_TILE_BYTES = 256 * 1024;
+// Input rows per dots() call; the kernel reads each weight row once per call.
+constexpr size_t ROW_GROUP = 4;
+} // namespace
+
+void setLinearAccumulation(LinearAccumulation mode) {
+    globalAccumulation().store(mode);
+}
+
+LinearAccumulation linearAccumulation() {
+    return globalAccumulation().load();
+}
+
 // Compute Y = X * W^T + b
 // Shapes:
 //   X: [B, In]
 //   W: [Out, In]
 //   b (optional): [Out]
 //   Y: [B, Out]
-// Assumes no broadcasting beyond optional bias add.
+// Assumes no broadcasting beyond optional bias add. `addend`, if not null,
+// holds one float row pointer per batch row (null to skip the row) whose
+// terms are added to Y before it is rounded to the output type.
+//
+// High-precision path: every product is exact in double and the sum carries a
+// Kahan-Neumaier compensation term, so the result is the correctly rounded
+// float of the dot product in all but pathological cases. Integer outputs
+// stay in double until the final cast.
 template <typename T>
-void linear_impl(std::byte *out_base,
-                 const std::byte *in_base,
-                 const std::byte *w_base,
-                 const std::byte *bias_base,
-                 size_t batch_size,
-                 size_t out_features,
-                 size_t in_features,
-                 size_t elem_size,
-                 ptrdiff_t in_col_stride_bytes,
-                 ptrdiff_t in_batch_stride_bytes,
-                 ptrdiff_t w_row_stride_bytes,      // stride between rows (output neurons) in W
-                 ptrdiff_t out_col_stride_bytes,    // stride between output features
-                 ptrdiff_t out_batch_stride_bytes)  // stride between output batches
+void linear_kahan_impl(std::byte *out_base,
+                       const std::byte *in_base,
+                       const std::byte *w_base,
+                       const std::byte *bias_base,
+                       const float *const *addend,
+                       size_t batch_size,
+                       size_t out_features,
+                       size_t in_features,
+                       size_t elem_size,
+                       ptrdiff_t in_col_stride_bytes,
+                       ptrdiff_t in_batch_stride_bytes,
+                       ptrdiff_t w_row_stride_bytes,      // stride between rows (output neurons) in W
+                       ptrdiff_t out_col_stride_bytes,    // stride between output features
+                       ptrdiff_t out_batch_stride_bytes)  // stride between output batches
 {
     using llaisys::utils::cast;
+    using Acc = std::conditional_t<std::is_integral_v<T>, double, float>;
 
     for (size_t b = 0; b < batch_size; ++b) {
         for (size_t o = 0; o < out_features; ++o) {
-            double acc = 0.0;
+            double sum = 0.0;
+            double comp = 0.0;
             // Dot product of input row b with weight row o
             for (size_t i = 0; i < in_features; ++i) {
                 const auto in_offset = static_cast<ptrdiff_t>(b * in_batch_stride_bytes + i * in_col_stride_bytes);
                 const auto w_offset  = static_cast<ptrdiff_t>(o * w_row_stride_bytes + i * elem_size);
                 const T in_val = *reinterpret_cast<const T *>(in_base + in_offset);
                 const T w_val  = *reinterpret_cast<const T *>(w_base + w_offset);
-                acc += static_cast<double>(cast<float>(in_val)) * static_cast<double>(cast<float>(w_val));
+                const double p = cast<double>(in_val) * cast<double>(w_val);
+                const double t = sum + p;
+                comp += std::fabs(sum) >= std::fabs(p) ? (sum - t) + p : (p - t) + sum;
+                sum = t;
             }
 
-            float result = static_cast<float>(acc);
+            Acc result = static_cast<Acc>(sum + comp);
             if (bias_base) {
                 const auto bias_offset = static_cast<ptrdiff_t>(o * elem_size);
                 const T b_val = *reinterpret_cast<const T *>(bias_base + bias_offset);
-                result += cast<float>(b_val);
+                result += cast<Acc>(b_val);
+            }
+            if (addend && addend[b]) {
+                result += addend[b][o];
             }
 
             const auto out_offset = static_cast<ptrdiff_t>(b * out_batch_stride_bytes + o * out_col_stride_bytes);
-            // *reinterpret_cast<float *>(out_base + out_offset) = result; // Output stored as F32
             auto *dst = reinterpret_cast<T *>(out_base + out_offset);
             *dst = llaisys::utils::cast<T>(result);
         }
     }
 }
 
-void linear(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias) {
+// Fast path: X and tiles of W as contiguous float (in place for F32 inputs
+// that already are), dot products through vmath::dots.
+template <typename T>
+void linear_f32_impl(std::byte *out_base,
+                     const std::byte *in_base,
+                     const std::byte *w_base,
+                     const std::byte *bias_base,
+                     const float *const *addend,
+                     size_t batch_size,
+                     size_t out_features,
+                     size_t in_features,
+                     size_t elem_size,
+                     ptrdiff_t in_col_stride_bytes,
+                     ptrdiff_t in_batch_stride_bytes,
+                     ptrdiff_t w_row_stride_bytes,
+                     ptrdiff_t out_col_stride_bytes,
+                     ptrdiff_t out_batch_stride_bytes) {
+    using llaisys::utils::cast;
+    namespace vmath = llaisys::utils::vmath;
+
+    const float *x = nullptr;
+    size_t ldx = in_features;
+    std::vector<float> x_buf;
+    if constexpr (std::is_same_v<T, float>) {
+        if (in_col_stride_bytes == static_cast<ptrdiff_t>(sizeof(float)) && in_batch_stride_bytes >= 0) {
+            x = reinterpret_cast<const float *>(in_base);
+            ldx = static_cast<size_t>(in_batch_stride_bytes) / sizeof(float);
+        }
+    }
+    if (x == nullptr) {
+        x_buf.resize(batch_size * in_features);
+        for (size_t b = 0; b < batch_size; ++b) {
+            const std::byte *src = in_base + static_cast<ptrdiff_t>(b) * in_batch_stride_bytes;
+            for (size_t i = 0; i < in_features; ++i) {
+                x_buf[b * in_features + i] = cast<float>(*reinterpret_cast<const T *>(src + static_cast<ptrdiff_t>(i) * in_col_stride_bytes));
+            }
+        }
+        x = x_buf.data();
+    }
+
+    const size_t tile = std::max<size_t>(1, W_TILE_BYTES / (std::max<size_t>(1, in_features) * sizeof(float)));
+    std::vector<float> w_buf;
+    for (size_t o0 = 0; o0 < out_features; o0 += tile) {
+        const size_t o1 = std::min(out_features, o0 + tile);
+        const float *w = nullptr;
+        size_t ldw = in_features;
+        if constexpr (std::is_same_v<T, float>) {
+            if (w_row_stride_bytes >= 0) {
+                w = reinterpret_cast<const float *>(w_base + static_cast<ptrdiff_t>(o0) * w_row_stride_bytes);
+                ldw = static_cast<size_t>(w_row_stride_bytes) / sizeof(float);
+            }
+        }
+        if (w == nullptr) {
+            w_buf.resize((o1 - o0) * in_features);
+            for (size_t o = o0; o < o1; ++o) {
+                const T *src = reinterpret_cast<const T *>(w_base + static_cast<ptrdiff_t>(o) * w_row_stride_bytes);
+                for (size_t i = 0; i < in_features; ++i) {
+                    w_buf[(o - o0) * in_features + i] = cast<float>(src[i]);
+                }
+            }
+            w = w_buf.data();
+        }
+
+        for (size_t b0 = 0; b0 < batch_size; b0 += ROW_GROUP) {
+            const size_t rows = std::min(ROW_GROUP, batch_size - b0);
+            for (size_t o = o0; o < o1; ++o) {
+                float acc[ROW_GROUP];
+                vmath::dots(acc, w + (o - o0) * ldw, x + b0 * ldx, rows, ldx, in_features);
+                const float bias = bias_base ? cast<float>(*reinterpret_cast<const T *>(bias_base + o * elem_size)) : 0.0f;
+                for (size_t r = 0; r < rows; ++r) {
+                    auto *dst = reinterpret_cast<T *>(out_base + static_cast<ptrdiff_t>(b0 + r) * out_batch_stride_bytes
+                                                      + static_cast<ptrdiff_t>(o) * out_col_stride_bytes);
+                    const float extra = addend && addend[b0 + r] ? addend[b0 + r][o] : 0.0f;
+                    *dst = cast<T>(acc[r] + bias + extra);
+                }
+            }
+        }
+    }
+}
+
+// BF16 fast path: activations and weights stay bf16 and go straight into
+// vmath::dotsBf16 (vdpbf16ps where available), accumulating in float.
+void linear_bf16_impl(std::byte *out_base,
+                      const std::byte *in_base,
+                      const std::byte *w_base,
+                      const std::byte *bias_base,
+                      const float *const *addend,
+                      size_t batch_size,
+                      size_t out_features,
+                      size_t in_features,
+                      ptrdiff_t in_col_stride_bytes,
+                      ptrdiff_t in_batch_stride_bytes,
+                      ptrdiff_t w_row_stride_bytes,
+                      ptrdiff_t out_col_stride_bytes,
+                      ptrdiff_t out_batch_stride_bytes) {
+    using llaisys::utils::cast;
+    namespace vmath = llaisys::utils::vmath;
+
+    const bf16_t *x = nullptr;
+    size_t ldx = in_features;
+    std::vector<bf16_t> x_buf;
+    if (in_col_stride_bytes == static_cast<ptrdiff_t>(sizeof(bf16_t)) && in_batch_stride_bytes >= 0) {
+        x = reinterpret_cast<const bf16_t *>(in_base);
+        ldx = static_cast<size_t>(in_batch_stride_bytes) / sizeof(bf16_t);
+    } else {
+        x_buf.resize(batch_size * in_features);
+        for (size_t b = 0; b < batch_size; ++b) {
+            const std::byte *src = in_base + static_cast<ptrdiff_t>(b) * in_batch_stride_bytes;
+            for (size_t i = 0; i < in_features; ++i) {
+                x_buf[b * in_features + i] = *reinterpret_cast<const bf16_t *>(src + static_cast<ptrdiff_t>(i) * in_col_stride_bytes);
+            }
+        }
+        x = x_buf.data();
+    }
+
+    const size_t tile = std::max<size_t>(1, W_TILE_BYTES / (std::max<size_t>(1, in_features) * sizeof(bf16_t)));
+    for (size_t o0 = 0; o0 < out_features; o0 += tile) {
+        const size_t o1 = std::min(out_features, o0 + tile);
+        for (size_t b0 = 0; b0 < batch_size; b0 += ROW_GROUP) {
+            const size_t rows = std::min(ROW_GROUP, batch_size - b0);
+            for (size_t o = o0; o < o1; ++o) {
+                float acc[ROW_GROUP];
+                const auto *w = reinterpret_cast<const bf16_t *>(w_base + static_cast<ptrdiff_t>(o) * w_row_stride_bytes);
+                vmath::dotsBf16(acc, w, x + b0 * ldx, rows, ldx, in_features);
+                const float bias = bias_base ? cast<float>(reinterpret_cast<const bf16_t *>(bias_base)[o]) : 0.0f;
+                for (size_t r = 0; r < rows; ++r) {
+                    auto *dst = reinterpret_cast<bf16_t *>(out_base + static_cast<ptrdiff_t>(b0 + r) * out_batch_stride_bytes
+                                                           + static_cast<ptrdiff_t>(o) * out_col_stride_bytes);
+                    const float extra = addend && addend[b0 + r] ? addend[b0 + r][o] : 0.0f;
+                    *dst = cast<bf16_t>(acc[r] + bias + extra);
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void linear_impl(std::byte *out_base,
+                 const std::byte *in_base,
+                 const std::byte *w_base,
+                 const std::byte *bias_base,
+                 const float *const *addend,
+                 size_t batch_size,
+                 size_t out_features,
+                 size_t in_features,
+                 size_t elem_size,
+                 ptrdiff_t in_col_stride_bytes,
+                 ptrdiff_t in_batch_stride_bytes,
+                 ptrdiff_t w_row_stride_bytes,
+                 ptrdiff_t out_col_stride_bytes,
+                 ptrdiff_t out_batch_stride_bytes,
+                 LinearAccumulation mode) {
+    if (mode == LinearAccumulation::KAHAN || std::is_integral_v<T>) {
+        return linear_kahan_impl<T>(out_base, in_base, w_base, bias_base, addend, batch_size, out_features, in_features, elem_size,
+                                    in_col_stride_bytes, in_batch_stride_bytes,
+                                    w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+    }
+    if constexpr (std::is_same_v<T, bf16_t>) {
+        linear_bf16_impl(out_base, in_base, w_base, bias_base, addend, batch_size, out_features, in_features,
+                         in_col_stride_bytes, in_batch_stride_bytes,
+                         w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+    } else {
+        linear_f32_impl<T>(out_base, in_base, w_base, bias_base, addend, batch_size, out_features, in_features, elem_size,
+                           in_col_stride_bytes, in_batch_stride_bytes,
+                           w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+    }
+}
+
+namespace {
+void linear_dispatch(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias, LinearAccumulation mode,
+                     const float *const *addend) {
     const auto dtype = weight->dtype();
     const auto elem_size = static_cast<size_t>(weight->elementSize());
 
@@ -108,63 +322,528 @@ void linear(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias) {
 
     switch (dtype) {
     case LLAISYS_DTYPE_F32:
-        return linear_impl<float>(out_base, in_base, w_base, bias_base,
+        return linear_impl<float>(out_base, in_base, w_base, bias_base, addend,
                                   batch_size, out_features, in_features, elem_size,
                                   in_col_stride_bytes, in_batch_stride_bytes,
-                                  w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+                                  w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes, mode);
     case LLAISYS_DTYPE_F16:
-        return linear_impl<llaisys::fp16_t>(out_base, in_base, w_base, bias_base,
+        return linear_impl<llaisys::fp16_t>(out_base, in_base, w_base, bias_base, addend,
                                             batch_size, out_features, in_features, elem_size,
                                             in_col_stride_bytes, in_batch_stride_bytes,
-                                            w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+                                            w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes, mode);
     case LLAISYS_DTYPE_BF16:
-        return linear_impl<llaisys::bf16_t>(out_base, in_base, w_base, bias_base,
+        return linear_impl<llaisys::bf16_t>(out_base, in_base, w_base, bias_base, addend,
                                             batch_size, out_features, in_features, elem_size,
                                             in_col_stride_bytes, in_batch_stride_bytes,
-                                            w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+                                            w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes, mode);
     case LLAISYS_DTYPE_I8:
-        return linear_impl<int8_t>(out_base, in_base, w_base, bias_base,
+        return linear_impl<int8_t>(out_base, in_base, w_base, bias_base, addend,
                                    batch_size, out_features, in_features, elem_size,
                                    in_col_stride_bytes, in_batch_stride_bytes,
-                                   w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+                                   w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes, mode);
     case LLAISYS_DTYPE_I16:
-        return linear_impl<int16_t>(out_base, in_base, w_base, bias_base,
+        return linear_impl<int16_t>(out_base, in_base, w_base, bias_base, addend,
                                     batch_size, out_features, in_features, elem_size,
                                     in_col_stride_bytes, in_batch_stride_bytes,
-                                    w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+                                    w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes, mode);
     case LLAISYS_DTYPE_I32:
-        return linear_impl<int32_t>(out_base, in_base, w_base, bias_base,
+        return linear_impl<int32_t>(out_base, in_base, w_base, bias_base, addend,
                                     batch_size, out_features, in_features, elem_size,
                                     in_col_stride_bytes, in_batch_stride_bytes,
-                                    w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+                                    w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes, mode);
     case LLAISYS_DTYPE_I64:
-        return linear_impl<int64_t>(out_base, in_base, w_base, bias_base,
+        return linear_impl<int64_t>(out_base, in_base, w_base, bias_base, addend,
                                     batch_size, out_features, in_features, elem_size,
                                     in_col_stride_bytes, in_batch_stride_bytes,
-                                    w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+                                    w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes, mode);
     case LLAISYS_DTYPE_U8:
-        return linear_impl<uint8_t>(out_base, in_base, w_base, bias_base,
+        return linear_impl<uint8_t>(out_base, in_base, w_base, bias_base, addend,
                                     batch_size, out_features, in_features, elem_size,
                                     in_col_stride_bytes, in_batch_stride_bytes,
-                                    w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+                                    w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes, mode);
     case LLAISYS_DTYPE_U16:
-        return linear_impl<uint16_t>(out_base, in_base, w_base, bias_base,
+        return linear_impl<uint16_t>(out_base, in_base, w_base, bias_base, addend,
                                      batch_size, out_features, in_features, elem_size,
                                      in_col_stride_bytes, in_batch_stride_bytes,
-                                     w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+                                     w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes, mode);
     case LLAISYS_DTYPE_U32:
-        return linear_impl<uint32_t>(out_base, in_base, w_base, bias_base,
+        return linear_impl<uint32_t>(out_base, in_base, w_base, bias_base, addend,
                                      batch_size, out_features, in_features, elem_size,
                                      in_col_stride_bytes, in_batch_stride_bytes,
-                                     w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+                                     w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes, mode);
     case LLAISYS_DTYPE_U64:
-        return linear_impl<uint64_t>(out_base, in_base, w_base, bias_base,
+        return linear_impl<uint64_t>(out_base, in_base, w_base, bias_base, addend,
                                      batch_size, out_features, in_features, elem_size,
                                      in_col_stride_bytes, in_batch_stride_bytes,
-                                     w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes);
+                                     w_row_stride_bytes, out_col_stride_bytes, out_batch_stride_bytes, mode);
     default:
         throw std::runtime_error("linear: unsupported or non-numeric dtype");
     }
 }
+} // namespace
+
+void linear(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias) {
+    linear(out, in, weight, bias, linearAccumulation());
+}
+
+void linear(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias, LinearAccumulation mode) {
+    linear_dispatch(out, in, weight, bias, mode, nullptr);
+}
+
+// One adapter's term for the rows in `rows`, in float: T = X_rows * A^T
+// ([nrow, rank]), then delta = T * B^T ([nrow, Out]). Each A row and B row is
+// read once per ROW_GROUP rows by vmath::dots.
+template <typename T>
+void lora_segment_impl(float *delta,
+                       const std::byte *in_base,
+                       const T *a,
+                       const T *b,
+                       const std::vector<size_t> &rows,
+                       size_t out_features,
+                       size_t in_features,
+                       size_t rank,
+                       ptrdiff_t in_col_stride,
+                       ptrdiff_t in_batch_stride,
+                       std::vector<float> &x,
+                       std::vector<float> &t,
+                       std::vector<float> &w) {
+    using llaisys::utils::cast;
+    namespace vmath = llaisys::utils::vmath;
+
+    const size_t nrow = rows.size();
+    x.resize(nrow * in_features);
+    for (size_t r = 0; r < nrow; ++r) {
+        const std::byte *src = in_base + static_cast<ptrdiff_t>(rows[r]) * in_batch_stride;
+        for (size_t i = 0; i < in_features; ++i) {
+            x[r * in_features + i] = cast<float>(*reinterpret_cast<const T *>(src + static_cast<ptrdiff_t>(i) * in_col_stride));
+        }
+    }
+
+    // Row j of a (or o of b) as float: in place for F32, widened into w otherwise.
+    auto weightRow = [&](const T *row, size_t n) -> const float * {
+        if constexpr (std::is_same_v<T, float>) {
+            return row;
+        } else {
+            vmath::toF32(w.data(), row, n);
+            return w.data();
+        }
+    };
+    w.resize(std::max(in_features, rank));
+    t.resize(nrow * rank);
+    float acc[ROW_GROUP];
+    for (size_t j = 0; j < rank; ++j) {
+        const float *aj = weightRow(a + j * in_features, in_features);
+        for (size_t r0 = 0; r0 < nrow; r0 += ROW_GROUP) {
+            const size_t n = std::min(ROW_GROUP, nrow - r0);
+            vmath::dots(acc, aj, x.data() + r0 * in_features, n, in_features, in_features);
+            for (size_t r = 0; r < n; ++r) {
+                t[(r0 + r) * rank + j] = acc[r];
+            }
+        }
+    }
+    for (size_t o = 0; o < out_features; ++o) {
+        const float *bo = weightRow(b + o * rank, rank);
+        for (size_t r0 = 0; r0 < nrow; r0 += ROW_GROUP) {
+            const size_t n = std::min(ROW_GROUP, nrow - r0);
+            vmath::dots(acc, bo, t.data() + r0 * rank, n, rank, rank);
+            for (size_t r = 0; r < n; ++r) {
+                delta[(r0 + r) * out_features + o] = acc[r];
+            }
+        }
+    }
+}
+
+// The adapter terms go into the epilogue of linear, so each output is rounded
+// to T once, after the base and LoRA terms are summed in float.
+template <typename T>
+void linear_lora_impl(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias, tensor_t lora_a, tensor_t lora_b,
+                      const std::vector<std::vector<size_t>> &segments, size_t nrow) {
+    const size_t nadapter = lora_a->shape()[0];
+    const size_t rank = lora_a->shape()[1];
+    const size_t in_features = lora_a->shape()[2];
+    const size_t out_features = lora_b->shape()[1];
+    const auto elem_size = static_cast<ptrdiff_t>(sizeof(T));
+    const auto *a_base = reinterpret_cast<const T *>(lora_a->data());
+    const auto *b_base = reinterpret_cast<const T *>(lora_b->data());
+
+    std::vector<float> delta(nrow * out_features);
+    std::vector<const float *> addend(in->shape()[0], nullptr);
+    std::vector<float> x;
+    std::vector<float> t;
+    std::vector<float> w;
+    size_t offset = 0;
+    for (size_t id = 0; id < nadapter; ++id) {
+        const auto &rows = segments[id];
+        if (rows.empty()) {
+            continue;
+        }
+        float *segment = delta.data() + offset * out_features;
+        lora_segment_impl<T>(segment, in->data(),
+                             a_base + id * rank * in_features, b_base + id * out_features * rank,
+                             rows, out_features, in_features, rank,
+                             static_cast<ptrdiff_t>(in->strides()[1]) * elem_size,
+                             static_cast<ptrdiff_t>(in->strides()[0]) * elem_size,
+                             x, t, w);
+        for (size_t r = 0; r < rows.size(); ++r) {
+            addend[rows[r]] = segment + r * out_features;
+        }
+        offset += rows.size();
+    }
+    linear_dispatch(out, in, weight, bias, linearAccumulation(), addend.data());
+}
+
+void linear_lora(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias,
+                 tensor_t lora_a, tensor_t lora_b, tensor_t adapter_ids) {
+    CHECK_ARGUMENT(in->ndim() == 2 && weight->ndim() == 2, "linear_lora: input and weight must be 2D");
+    const size_t batch_size = in->shape()[0];
+    const size_t out_features = weight->shape()[0];
+    const size_t in_features = weight->shape()[1];
+    CHECK_ARGUMENT(lora_a->ndim() == 3 && lora_b->ndim() == 3, "linear_lora: lora_a and lora_b must be 3D");
+    const size_t nadapter = lora_a->shape()[0];
+    const size_t rank = lora_a->shape()[1];
+    CHECK_ARGUMENT(lora_a->shape()[2] == in_features, "linear_lora: lora_a must be [nadapter, rank, In]");
+    CHECK_ARGUMENT(lora_b->shape()[0] == nadapter && lora_b->shape()[1] == out_features && lora_b->shape()[2] == rank,
+                   "linear_lora: lora_b must be [nadapter, Out, rank]");
+    CHECK_ARGUMENT(lora_a->isContiguous() && lora_b->isContiguous(), "linear_lora: adapter weights must be contiguous");
+    CHECK_SAME_DTYPE(weight->dtype(), lora_a->dtype(), lora_b->dtype());
+    CHECK_ARGUMENT(adapter_ids->dtype() == LLAISYS_DTYPE_I64 && adapter_ids->ndim() == 1
+                       && adapter_ids->shape()[0] == batch_size,
+                   "linear_lora: adapter_ids must be I64 [B]");
+    ASSERT(adapter_ids->isContiguous(), "linear_lora: adapter_ids must be contiguous");
+
+    // One segment of row indices per adapter.
+    const auto *ids = reinterpret_cast<const int64_t *>(adapter_ids->data());
+    std::vector<std::vector<size_t>> segments(nadapter);
+    size_t nrow = 0;
+    for (size_t row = 0; row < batch_size; ++row) {
+        if (ids[row] < 0) {
+            continue;
+        }
+        CHECK_ARGUMENT(static_cast<size_t>(ids[row]) < nadapter, "linear_lora: adapter id out of range");
+        segments[ids[row]].push_back(row);
+        nrow++;
+    }
+    if (nrow == 0 || rank == 0) {
+        return linear(out, in, weight, bias);
+    }
+
+    switch (weight->dtype()) {
+    case LLAISYS_DTYPE_F32:
+        return linear_lora_impl<float>(out, in, weight, bias, lora_a, lora_b, segments, nrow);
+    case LLAISYS_DTYPE_F16:
+        return linear_lora_impl<llaisys::fp16_t>(out, in, weight, bias, lora_a, lora_b, segments, nrow);
+    case LLAISYS_DTYPE_BF16:
+        return linear_lora_impl<llaisys::bf16_t>(out, in, weight, bias, lora_a, lora_b, segments, nrow);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(weight->dtype());
+    }
+}
+
+// Weight rows are taken a tile at a time like linear_f32_impl; BF16 values go
+// to the kernel as they are, F16 tiles are widened to float first.
+template <typename T>
+void linear_sparse24_impl(T *out, const T *in, const T *values, const uint8_t *indices, const T *bias,
+                          size_t batch_size, size_t out_features, size_t in_features) {
+    using llaisys::utils::cast;
+    namespace vmath = llaisys::utils::vmath;
+
+    const size_t nvalue = in_features / 2;
+    const size_t nindex = in_features / 8;
+    const float *x = nullptr;
+    std::vector<float> x_buf;
+    if constexpr (std::is_same_v<T, float>) {
+        x = in;
+    } else {
+        x_buf.resize(batch_size * in_features);
+        vmath::toF32(x_buf.data(), in, x_buf.size());
+        x = x_buf.data();
+    }
+
+    const size_t row_bytes = std::max<size_t>(1, nvalue * sizeof(T) + nindex);
+    const size_t tile = std::max<size_t>(1, W_TILE_BYTES / row_bytes);
+    std::vector<float> w_buf;
+    for (size_t o0 = 0; o0 < out_features; o0 += tile) {
+        const size_t o1 = std::min(out_features, o0 + tile);
+        if constexpr (std::is_same_v<T, fp16_t>) {
+            w_buf.resize((o1 - o0) * nvalue);
+            vmath::toF32(w_buf.data(), values + o0 * nvalue, w_buf.size());
+        }
+        for (size_t b0 = 0; b0 < batch_size; b0 += ROW_GROUP) {
+            const size_t rows = std::min(ROW_GROUP, batch_size - b0);
+            for (size_t o = o0; o < o1; ++o) {
+                float acc[ROW_GROUP];
+                const uint8_t *idx = indices + o * nindex;
+                const float *xr = x + b0 * in_features;
+                if constexpr (std::is_same_v<T, float>) {
+                    vmath::sparse24Dots(acc, values + o * nvalue, idx, xr, rows, in_features, in_features);
+                } else if constexpr (std::is_same_v<T, bf16_t>) {
+                    vmath::sparse24DotsBf16(acc, values + o * nvalue, idx, xr, rows, in_features, in_features);
+                } else {
+                    vmath::sparse24Dots(acc, w_buf.data() + (o - o0) * nvalue, idx, xr, rows, in_features, in_features);
+                }
+                const float b = bias ? cast<float>(bias[o]) : 0.0f;
+                for (size_t r = 0; r < rows; ++r) {
+                    out[(b0 + r) * out_features + o] = cast<T>(acc[r] + b);
+                }
+            }
+        }
+    }
+}
+
+void linear_sparse24(tensor_t out, tensor_t in, tensor_t values, tensor_t indices, tensor_t bias) {
+    CHECK_ARGUMENT(in->ndim() == 2 && values->ndim() == 2 && out->ndim() == 2,
+                   "linear_sparse24: in, values and out must be 2D");
+    const size_t batch_size = in->shape()[0];
+    const size_t in_features = in->shape()[1];
+    const size_t out_features = values->shape()[0];
+    CHECK_ARGUMENT(in_features % 8 == 0, "linear_sparse24: In must be a multiple of 8");
+    CHECK_ARGUMENT(values->shape()[1] == in_features / 2, "linear_sparse24: values must be [Out, In / 2]");
+    CHECK_ARGUMENT(indices->dtype() == LLAISYS_DTYPE_U8 && indices->ndim() == 2 && indices->shape()[0] == out_features
+                       && indices->shape()[1] == in_features / 8,
+                   "linear_sparse24: indices must be U8 [Out, In / 8]");
+    CHECK_ARGUMENT(out->shape()[0] == batch_size && out->shape()[1] == out_features,
+                   "linear_sparse24: out must be [B, Out]");
+    CHECK_SAME_DTYPE(out->dtype(), in->dtype(), values->dtype());
+    if (bias) {
+        CHECK_ARGUMENT(bias->ndim() == 1 && bias->shape()[0] == out_features, "linear_sparse24: bias must be [Out]");
+        CHECK_SAME_DTYPE(bias->dtype(), values->dtype());
+    }
+    CHECK_ARGUMENT(out->isContiguous() && in->isContiguous() && values->isContiguous() && indices->isContiguous()
+                       && (!bias || bias->isContiguous()),
+                   "linear_sparse24: tensors must be contiguous");
+
+    const auto *idx = reinterpret_cast<const uint8_t *>(indices->data());
+    auto run = [&](auto *out_base) {
+        using T = std::remove_pointer_t<decltype(out_base)>;
+        linear_sparse24_impl<T>(out_base, reinterpret_cast<const T *>(in->data()),
+                                reinterpret_cast<const T *>(values->data()), idx,
+                                bias ? reinterpret_cast<const T *>(bias->data()) : nullptr,
+                                batch_size, out_features, in_features);
+    };
+    switch (values->dtype()) {
+    case LLAISYS_DTYPE_F32:
+        return run(reinterpret_cast<float *>(out->data()));
+    case LLAISYS_DTYPE_F16:
+        return run(reinterpret_cast<llaisys::fp16_t *>(out->data()));
+    case LLAISYS_DTYPE_BF16:
+        return run(reinterpret_cast<llaisys::bf16_t *>(out->data()));
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(values->dtype());
+    }
+}
+
+template <typename T>
+void sparse24_compress_impl(T *values, uint8_t *indices, const T *weight, size_t out_features, size_t in_features) {
+    using llaisys::utils::cast;
+
+    std::fill(indices, indices + out_features * (in_features / 8), uint8_t{0});
+    for (size_t o = 0; o < out_features; ++o) {
+        const T *w = weight + o * in_features;
+        T *v = values + o * (in_features / 2);
+        uint8_t *idx = indices + o * (in_features / 8);
+        for (size_t g = 0; g < in_features / 4; ++g) {
+            // The two largest magnitudes; strict comparisons keep the lower position on ties.
+            size_t first = 0;
+            for (size_t p = 1; p < 4; ++p) {
+                if (std::fabs(cast<float>(w[4 * g + p])) > std::fabs(cast<float>(w[4 * g + first]))) {
+                    first = p;
+                }
+            }
+            size_t second = first == 0 ? 1 : 0;
+            for (size_t p = 0; p < 4; ++p) {
+                if (p != first && std::fabs(cast<float>(w[4 * g + p])) > std::fabs(cast<float>(w[4 * g + second]))) {
+                    second = p;
+                }
+            }
+            const size_t lo = std::min(first, second);
+            const size_t hi = std::max(first, second);
+            v[2 * g] = w[4 * g + lo];
+            v[2 * g + 1] = w[4 * g + hi];
+            // Kept values 2g and 2g + 1 take bits 4g and 4g + 2 of the row's index stream.
+            idx[g / 2] |= static_cast<uint8_t>((lo | (hi << 2)) << (4 * (g % 2)));
+        }
+    }
+}
+
+void sparse24_compress(tensor_t values, tensor_t indices, tensor_t weight) {
+    CHECK_ARGUMENT(weight->ndim() == 2, "sparse24_compress: weight must be 2D");
+    const size_t out_features = weight->shape()[0];
+    const size_t in_features = weight->shape()[1];
+    CHECK_ARGUMENT(in_features % 8 == 0, "sparse24_compress: In must be a multiple of 8");
+    CHECK_ARGUMENT(values->ndim() == 2 && values->shape()[0] == out_features && values->shape()[1] == in_features / 2,
+                   "sparse24_compress: values must be [Out, In / 2]");
+    CHECK_ARGUMENT(indices->dtype() == LLAISYS_DTYPE_U8 && indices->ndim() == 2 && indices->shape()[0] == out_features
+                       && indices->shape()[1] == in_features / 8,
+                   "sparse24_compress: indices must be U8 [Out, In / 8]");
+    CHECK_SAME_DTYPE(values->dtype(), weight->dtype());
+    CHECK_ARGUMENT(values->isContiguous() && indices->isContiguous() && weight->isContiguous(),
+                   "sparse24_compress: tensors must be contiguous");
+
+    auto *idx = reinterpret_cast<uint8_t *>(indices->data());
+    switch (weight->dtype()) {
+    case LLAISYS_DTYPE_F32:
+        return sparse24_compress_impl(reinterpret_cast<float *>(values->data()), idx,
+                                      reinterpret_cast<const float *>(weight->data()), out_features, in_features);
+    case LLAISYS_DTYPE_F16:
+        return sparse24_compress_impl(reinterpret_cast<llaisys::fp16_t *>(values->data()), idx,
+                                      reinterpret_cast<const llaisys::fp16_t *>(weight->data()), out_features, in_features);
+    case LLAISYS_DTYPE_BF16:
+        return sparse24_compress_impl(reinterpret_cast<llaisys::bf16_t *>(values->data()), idx,
+                                      reinterpret_cast<const llaisys::bf16_t *>(weight->data()), out_features, in_features);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(weight->dtype());
+    }
+}
+
+
+namespace {
+// Longest rows whose int8 dot products are guaranteed to fit in int32.
+constexpr size_t W8A8_MAX_IN = INT32_MAX / (127 * 127);
+
+// Symmetric int8 quantization of a row: q = round(x * 127 / absmax), so that
+// x ~= q * scale. Returns the scale, absmax / 127 (0 for an all-zero row), and
+// the sum of q in `sum`.
+float quantize_i8(int8_t *q, const float *x, size_t n, int32_t &sum) {
+    float absmax = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        absmax = std::max(absmax, std::fabs(x[i]));
+    }
+    sum = 0;
+    if (absmax == 0.0f) {
+        std::fill(q, q + n, int8_t{0});
+        return 0.0f;
+    }
+    const float inv = 127.0f / absmax;
+    for (size_t i = 0; i < n; i++) {
+        const float v = std::min(std::max(std::nearbyint(x[i] * inv), -127.0f), 127.0f);
+        q[i] = static_cast<int8_t>(v);
+        sum += q[i];
+    }
+    return absmax / 127.0f;
+}
+} // namespace
+
+// The tokens are quantized once up front; weight rows are then taken a tile
+// at a time like linear_f32_impl, already int8, so a tile covers 4x the rows.
+template <typename T>
+void linear_w8a8_impl(T *out, const T *in, const int8_t *qweight, const float *scales, const T *bias,
+                      size_t batch_size, size_t out_features, size_t in_features) {
+    using llaisys::utils::cast;
+    namespace vmath = llaisys::utils::vmath;
+
+    std::vector<int8_t> xq(batch_size * in_features);
+    std::vector<float> x_scale(batch_size);
+    std::vector<int32_t> x_sum(batch_size);
+    std::vector<float> row;
+    for (size_t b = 0; b < batch_size; ++b) {
+        const float *x = nullptr;
+        if constexpr (std::is_same_v<T, float>) {
+            x = in + b * in_features;
+        } else {
+            row.resize(in_features);
+            vmath::toF32(row.data(), in + b * in_features, in_features);
+            x = row.data();
+        }
+        x_scale[b] = quantize_i8(xq.data() + b * in_features, x, in_features, x_sum[b]);
+    }
+
+    const size_t tile = std::max<size_t>(1, W_TILE_BYTES / std::max<size_t>(1, in_features));
+    for (size_t o0 = 0; o0 < out_features; o0 += tile) {
+        const size_t o1 = std::min(out_features, o0 + tile);
+        for (size_t b0 = 0; b0 < batch_size; b0 += ROW_GROUP) {
+            const size_t rows = std::min(ROW_GROUP, batch_size - b0);
+            for (size_t o = o0; o < o1; ++o) {
+                int32_t acc[ROW_GROUP];
+                vmath::dotsI8(acc, qweight + o * in_features, xq.data() + b0 * in_features, x_sum.data() + b0,
+                              rows, in_features, in_features);
+                const float b = bias ? cast<float>(bias[o]) : 0.0f;
+                for (size_t r = 0; r < rows; ++r) {
+                    const float scale = x_scale[b0 + r] * scales[o];
+                    out[(b0 + r) * out_features + o] = cast<T>(static_cast<float>(acc[r]) * scale + b);
+                }
+            }
+        }
+    }
+}
+
+void linear_w8a8(tensor_t out, tensor_t in, tensor_t qweight, tensor_t scales, tensor_t bias) {
+    CHECK_ARGUMENT(in->ndim() == 2 && qweight->ndim() == 2 && out->ndim() == 2,
+                   "linear_w8a8: in, qweight and out must be 2D");
+    const size_t batch_size = in->shape()[0];
+    const size_t in_features = in->shape()[1];
+    const size_t out_features = qweight->shape()[0];
+    CHECK_ARGUMENT(qweight->dtype() == LLAISYS_DTYPE_I8 && qweight->shape()[1] == in_features,
+                   "linear_w8a8: qweight must be I8 [Out, In]");
+    CHECK_ARGUMENT(scales->dtype() == LLAISYS_DTYPE_F32 && scales->ndim() == 1 && scales->shape()[0] == out_features,
+                   "linear_w8a8: scales must be F32 [Out]");
+    CHECK_ARGUMENT(in_features <= W8A8_MAX_IN, "linear_w8a8: In is too large for int32 accumulation");
+    CHECK_ARGUMENT(out->shape()[0] == batch_size && out->shape()[1] == out_features,
+                   "linear_w8a8: out must be [B, Out]");
+    CHECK_SAME_DTYPE(out->dtype(), in->dtype());
+    if (bias) {
+        CHECK_ARGUMENT(bias->ndim() == 1 && bias->shape()[0] == out_features, "linear_w8a8: bias must be [Out]");
+        CHECK_SAME_DTYPE(bias->dtype(), out->dtype());
+    }
+    CHECK_ARGUMENT(out->isContiguous() && in->isContiguous() && qweight->isContiguous() && scales->isContiguous()
+                       && (!bias || bias->isContiguous()),
+                   "linear_w8a8: tensors must be contiguous");
+
+    const auto *qw = reinterpret_cast<const int8_t *>(qweight->data());
+    const auto *sw = reinterpret_cast<const float *>(scales->data());
+    auto run = [&](auto *out_base) {
+        using T = std::remove_pointer_t<decltype(out_base)>;
+        linear_w8a8_impl<T>(out_base, reinterpret_cast<const T *>(in->data()), qw, sw,
+                            bias ? reinterpret_cast<const T *>(bias->data()) : nullptr,
+                            batch_size, out_features, in_features);
+    };
+    switch (out->dtype()) {
+    case LLAISYS_DTYPE_F32:
+        return run(reinterpret_cast<float *>(out->data()));
+    case LLAISYS_DTYPE_F16:
+        return run(reinterpret_cast<llaisys::fp16_t *>(out->data()));
+    case LLAISYS_DTYPE_BF16:
+        return run(reinterpret_cast<llaisys::bf16_t *>(out->data()));
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(out->dtype());
+    }
+}
+
+template <typename T>
+void w8a8_quantize_impl(int8_t *qweight, float *scales, const T *weight, size_t out_features, size_t in_features) {
+    std::vector<float> row(in_features);
+    int32_t sum;
+    for (size_t o = 0; o < out_features; ++o) {
+        llaisys::utils::vmath::toF32(row.data(), weight + o * in_features, in_features);
+        scales[o] = quantize_i8(qweight + o * in_features, row.data(), in_features, sum);
+    }
+}
+
+void w8a8_quantize(tensor_t qweight, tensor_t scales, tensor_t weight) {
+    CHECK_ARGUMENT(weight->ndim() == 2, "w8a8_quantize: weight must be 2D");
+    const size_t out_features = weight->shape()[0];
+    const size_t in_features = weight->shape()[1];
+    CHECK_ARGUMENT(qweight->dtype() == LLAISYS_DTYPE_I8 && qweight->ndim() == 2 && qweight->shape()[0] == out_features
+                       && qweight->shape()[1] == in_features,
+                   "w8a8_quantize: qweight must be I8 [Out, In]");
+    CHECK_ARGUMENT(scales->dtype() == LLAISYS_DTYPE_F32 && scales->ndim() == 1 && scales->shape()[0] == out_features,
+                   "w8a8_quantize: scales must be F32 [Out]");
+    CHECK_ARGUMENT(qweight->isContiguous() && scales->isContiguous() && weight->isContiguous(),
+                   "w8a8_quantize: tensors must be contiguous");
+
+    auto *qw = reinterpret_cast<int8_t *>(qweight->data());
+    auto *sw = reinterpret_cast<float *>(scales->data());
+    switch (weight->dtype()) {
+    case LLAISYS_DTYPE_F32:
+        return w8a8_quantize_impl(qw, sw, reinterpret_cast<const float *>(weight->data()), out_features, in_features);
+    case LLAISYS_DTYPE_F16:
+        return w8a8_quantize_impl(qw, sw, reinterpret_cast<const llaisys::fp16_t *>(weight->data()), out_features,
+                                  in_features);
+    case LLAISYS_DTYPE_BF16:
+        return w8a8_quantize_impl(qw, sw, reinterpret_cast<const llaisys::bf16_t *>(weight->data()), out_features,
+                                  in_features);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(weight->dtype());
+    }
+}
 
-}
\ No newline at end of file
+}
@@ -3,5 +3,57 @@
 #include "../../tensor/tensor.hpp"
 
 namespace llaisys::ops {
+// How linear accumulates its dot products.
+//   F32:   float FMA through the vectorized dots kernel, summed in blocks
+//          (utils::vmath::DOT_BLOCK), the fast default. BF16 operands are
+//          not widened first: they go to dotsBf16, still accumulating in
+//          float.
+//   KAHAN: products in double, Kahan-Neumaier compensated double sum, one
+//          scalar pass per output; for validation runs.
+// Integer dtypes always take the KAHAN path: float sums would drop the low
+// bits of large integer dot products.
+enum class LinearAccumulation {
+    F32,
+    KAHAN,
+};
+
+// Process-wide mode used by linear calls that do not pass one.
+void setLinearAccumulation(LinearAccumulation mode);
+LinearAccumulation linearAccumulation();
+
 void linear(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias);
+void linear(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias, LinearAccumulation mode);
+// Batched multi-LoRA linear: Y = X * W^T + b, plus (X * A[id]^T) * B[id]^T for
+// every row whose adapter id is >= 0 (-1 = base weights only).
+//   lora_a: [nadapter, rank, In], lora_b: [nadapter, Out, rank], adapter_ids: I64 [B]
+// Rows are grouped into one segment per adapter, so each adapter's A/B are read
+// once per call however the batch mixes them. The LoRA scale is expected to be
+// folded into B.
+void linear_lora(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias,
+                 tensor_t lora_a, tensor_t lora_b, tensor_t adapter_ids);
+
+// 2:4 structured sparse linear: Y = X * W^T + b with W stored compressed,
+// which halves the value bytes streamed per token.
+//   values:  [Out, In / 2], the 2 kept weights of every aligned group of 4
+//            inputs, in input order (zeros pad a group that keeps fewer)
+//   indices: U8 [Out, In / 8], each kept weight's 2-bit position in its
+//            group, four per byte from the low bits up
+// In must be a multiple of 8; values, X, Y and b share the dtype (F32, F16 or
+// BF16). Accumulates in float like the F32 mode of linear.
+void linear_sparse24(tensor_t out, tensor_t in, tensor_t values, tensor_t indices, tensor_t bias);
+// Compress a dense [Out, In] weight into that layout, keeping the two
+// largest-magnitude weights of each group (the lower position on ties): exact
+// for a 2:4 pruned checkpoint, magnitude pruning otherwise.
+void sparse24_compress(tensor_t values, tensor_t indices, tensor_t weight);
+
+// W8A8 linear: Y = X * W^T + b with int8 weights and activations multiplied
+// into int32 (utils::vmath::dotsI8, VNNI where the host has it).
+//   qweight: I8 [Out, In], scales: F32 [Out], from w8a8_quantize
+// Every row of X is quantized on the fly, symmetric per token: q = round(x *
+// 127 / absmax(row)). The epilogue rescales each int32 sum by the token and
+// channel scales and adds b in float. X, Y and b share the dtype (F32, F16 or
+// BF16); In is limited to 133144 so the int32 sums cannot overflow.
+void linear_w8a8(tensor_t out, tensor_t in, tensor_t qweight, tensor_t scales, tensor_t bias);
+// Quantize a dense [Out, In] weight the same way, symmetric per output channel.
+void w8a8_quantize(tensor_t qweight, tensor_t scales, tensor_t weight);
 }
@@ -1,5 +1,6 @@
 #include "op.hpp"
 #include "../../utils/types.hpp"
+#include "../../utils/vmath.hpp"
 #include <cmath>
 #include <vector>
 
@@ -17,28 +18,26 @@ void rms_norm_impl(
     size_t d,
     float eps
 ) {
+    namespace vmath = llaisys::utils::vmath;
     auto in_batch_stride_bytes = in_batch_stride * elem_size;
     std::vector<float> in_row_vals(in_col_num);
+    std::vector<float> w_vals(in_col_num);
+    vmath::toF32(w_vals.data(), reinterpret_cast<const T *>(w_base), in_col_num);
 
     for (size_t row = 0; row < in_row_num; ++row) {
+        const auto row_offset = static_cast<ptrdiff_t>(row * in_batch_stride_bytes);
+        vmath::toF32(in_row_vals.data(), reinterpret_cast<const T *>(in_base + row_offset), in_col_num);
 
         float acc_square = 0.0f;
         for (size_t col = 0; col < in_col_num; ++col) {
-            const auto in_offset = static_cast<ptrdiff_t>(row * in_batch_stride_bytes + col * elem_size);
-            const auto in_val = llaisys::utils::cast<float>(*reinterpret_cast<const T *>(in_base + in_offset));
-            in_row_vals[col] = in_val;
-            acc_square += in_val * in_val;
+            acc_square += in_row_vals[col] * in_row_vals[col];
         }
-        const float rsqrt_denominator = 1.0f / sqrt(acc_square / d + eps);
+        const float rsqrt_denominator = vmath::rsqrt(acc_square / d + eps);
 
         for (size_t col = 0; col < in_col_num; ++col) {
-            const auto w_offset     = static_cast<ptrdiff_t>(col * elem_size);
-            const auto o_offset     = static_cast<ptrdiff_t>(row * in_batch_stride_bytes + col * elem_size);
-            const auto w_val = llaisys::utils::cast<float>(*reinterpret_cast<const T *>(w_base + w_offset));
-            const float normalized_val = (in_row_vals[col] * rsqrt_denominator) * w_val;
-            auto *dst = reinterpret_cast<T *>(out_base + o_offset);
-            *dst = llaisys::utils::cast<T>(normalized_val);
+            in_row_vals[col] = (in_row_vals[col] * rsqrt_denominator) * w_vals[col];
         }
+        vmath::fromF32(reinterpret_cast<T *>(out_base + row_offset), in_row_vals.data(), in_col_num);
     }
 }
 
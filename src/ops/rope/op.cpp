@@ -4,52 +4,63 @@
 #include <vector>
 
 namespace llaisys::ops {
-template <typename T>
+// D != 0 fixes the head dim at compile time (constant strides, unrollable
+// rotation loop); D == 0 is the generic kernel.
+template <typename T, size_t D>
 void rope_impl(
-    std::byte *out_base,
-    const std::byte *in_base,
+    T *out_base,
+    const T *in_base,
     size_t seqlen,
     size_t nhead,
-    size_t d,
-    size_t elem_size,
+    size_t d_runtime,
     const int64_t *pos_ids_ptr,
     const std::vector<double>& inv_freq
 ) {
-    size_t half_d = d / 2;
+    const size_t d = D != 0 ? D : d_runtime;
+    const size_t half_d = d / 2;
+    // The rotation of each frequency at the current position, shared by all heads.
+    std::vector<std::complex<double>> rotation(half_d);
 
     for (size_t s = 0; s < seqlen; ++s) {
         int64_t pos = pos_ids_ptr[s];
+        for (size_t j = 0; j < half_d; ++j) {
+            rotation[j] = std::polar(1.0, pos * inv_freq[j]);
+        }
         for (size_t h = 0; h < nhead; ++h) {
-            // Get the base pointer for the current vector [s, h, :]
-            size_t vec_offset_bytes = elem_size * ((s * nhead * d) + (h * d));
-            auto* current_out_vec = out_base + vec_offset_bytes;
-            const auto* current_in_vec = in_base + vec_offset_bytes;
+            // The vector [s, h, :]
+            auto *current_out_vec = out_base + (s * nhead + h) * d;
+            const auto *current_in_vec = in_base + (s * nhead + h) * d;
 
-            // Loop through the first half of the dimensions
+            // Rotate each pair x_j, x_{j + d/2}
             for (size_t j = 0; j < half_d; ++j) {
-                // Calculate the angle on the fly
-                double angle = pos * inv_freq[j];
-
-                // Create the rotation complex number
-                auto rotation_complex = std::polar(1.0, angle);
-
-                // Get the correct pair of values: x_j and x_{j + d/2}
                 auto in_val_complex = std::complex<double>(
-                    llaisys::utils::cast<double>(*reinterpret_cast<const T *>(current_in_vec + j * elem_size)),
-                    llaisys::utils::cast<double>(*reinterpret_cast<const T *>(current_in_vec + (j + half_d) * elem_size))
+                    llaisys::utils::cast<double>(current_in_vec[j]),
+                    llaisys::utils::cast<double>(current_in_vec[j + half_d])
                 );
-
-                // Apply the rotation
-                auto mult_complex = in_val_complex * rotation_complex;
-
-                // Write the results back to their correct positions
-                *reinterpret_cast<T *>(current_out_vec + j * elem_size) = llaisys::utils::cast<T>(mult_complex.real());
-                *reinterpret_cast<T *>(current_out_vec + (j + half_d) * elem_size) = llaisys::utils::cast<T>(mult_complex.imag());
+                auto mult_complex = in_val_complex * rotation[j];
+                current_out_vec[j] = llaisys::utils::cast<T>(mult_complex.real());
+                current_out_vec[j + half_d] = llaisys::utils::cast<T>(mult_complex.imag());
             }
         }
     }
 }
 
+// Head dims 128 (Qwen2 1.5B/7B) and 64 (Qwen2 0.5B) get their own kernels.
+template <typename T>
+void rope_dispatch(std::byte *out, const std::byte *in, size_t seqlen, size_t nhead, size_t d,
+                   const int64_t *pos_ids_ptr, const std::vector<double> &inv_freq) {
+    auto *out_base = reinterpret_cast<T *>(out);
+    const auto *in_base = reinterpret_cast<const T *>(in);
+    switch (d) {
+    case 128:
+        return rope_impl<T, 128>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
+    case 64:
+        return rope_impl<T, 64>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
+    default:
+        return rope_impl<T, 0>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
+    }
+}
+
 
 void rope(tensor_t out, tensor_t in, tensor_t pos_ids, float theta) {
     auto *out_base = out->data();
@@ -59,7 +70,6 @@ void rope(tensor_t out, tensor_t in, tensor_t pos_ids, float theta) {
     auto seqlen = shape[0];
     auto nhead = shape[1];
     auto d = shape[2];
-    const auto elem_size = in->elementSize();
     
     // As confirmed before, pos_ids dtype must be handled correctly. Here we assume int64.
     const auto *pos_ids_ptr = reinterpret_cast<const int64_t *>(pos_ids->data());
@@ -74,27 +84,27 @@ void rope(tensor_t out, tensor_t in, tensor_t pos_ids, float theta) {
     const auto dtype = in->dtype();
     switch (dtype) {
     case LLAISYS_DTYPE_F32:
-        return rope_impl<float>(out_base, in_base, seqlen, nhead, d, elem_size, pos_ids_ptr, inv_freq);
+        return rope_dispatch<float>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
     case LLAISYS_DTYPE_F16:
-        return rope_impl<llaisys::fp16_t>(out_base, in_base, seqlen, nhead, d, elem_size, pos_ids_ptr, inv_freq);
+        return rope_dispatch<llaisys::fp16_t>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
     case LLAISYS_DTYPE_BF16:
-        return rope_impl<llaisys::bf16_t>(out_base, in_base, seqlen, nhead, d, elem_size, pos_ids_ptr, inv_freq);
+        return rope_dispatch<llaisys::bf16_t>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
     case LLAISYS_DTYPE_I8:
-        return rope_impl<int8_t>(out_base, in_base, seqlen, nhead, d, elem_size, pos_ids_ptr, inv_freq);
+        return rope_dispatch<int8_t>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
     case LLAISYS_DTYPE_I16:
-        return rope_impl<int16_t>(out_base, in_base, seqlen, nhead, d, elem_size, pos_ids_ptr, inv_freq);
+        return rope_dispatch<int16_t>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
     case LLAISYS_DTYPE_I32:
-        return rope_impl<int32_t>(out_base, in_base, seqlen, nhead, d, elem_size, pos_ids_ptr, inv_freq);
+        return rope_dispatch<int32_t>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
     case LLAISYS_DTYPE_I64:
-        return rope_impl<int64_t>(out_base, in_base, seqlen, nhead, d, elem_size, pos_ids_ptr, inv_freq);
+        return rope_dispatch<int64_t>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
     case LLAISYS_DTYPE_U8:
-        return rope_impl<uint8_t>(out_base, in_base, seqlen, nhead, d, elem_size, pos_ids_ptr, inv_freq);
+        return rope_dispatch<uint8_t>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
     case LLAISYS_DTYPE_U16:
-        return rope_impl<uint16_t>(out_base, in_base, seqlen, nhead, d, elem_size, pos_ids_ptr, inv_freq);
+        return rope_dispatch<uint16_t>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
     case LLAISYS_DTYPE_U32:
-        return rope_impl<uint32_t>(out_base, in_base, seqlen, nhead, d, elem_size, pos_ids_ptr, inv_freq);
+        return rope_dispatch<uint32_t>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
     case LLAISYS_DTYPE_U64:
-        return rope_impl<uint64_t>(out_base, in_base, seqlen, nhead, d, elem_size, pos_ids_ptr, inv_freq);
+        return rope_dispatch<uint64_t>(out_base, in_base, seqlen, nhead, d, pos_ids_ptr, inv_freq);
     default:
         throw std::runtime_error("rope: unsupported or non-numeric dtype");
     }
@@ -1,4 +1,7 @@
 #include "op.hpp"
+#include "../../utils.hpp"
+#include "../../utils/parallel.hpp"
+#include "../../utils/vmath.hpp"
 #include <cmath>
 #include <vector>
 #include <numeric>
@@ -6,97 +9,315 @@
 
 namespace llaisys::ops {
 
-// Helper function for numerically stable softmax
-void softmax(const std::vector<float> &v, std::vector<float> &v_exp) {
-    if (v.empty()) {
-        return;
+// Head geometry of one attention call. A nonzero template argument fixes that
+// dimension at compile time, so the row strides fold into constants and the
+// per-head loops get constant trip counts the compiler can unroll and
+// vectorize; 0 leaves it to the runtime value. D fixes both the query/key
+// and the value head dim.
+template <size_t D, size_t NHEAD, size_t NKVHEAD>
+struct AttnShape {
+    size_t d_;
+    size_t dv_;
+    size_t nhead_;
+    size_t nkvhead_;
+
+    constexpr size_t d() const {
+        if constexpr (D != 0) {
+            return D;
+        } else {
+            return d_;
+        }
     }
-    float max_val = *std::max_element(v.begin(), v.end());
-    float sum = 0.0;
-    for (size_t i = 0; i < v.size(); ++i) {
-        v_exp[i] = std::exp(v[i] - max_val);
-        sum += v_exp[i];
+    constexpr size_t dv() const {
+        if constexpr (D != 0) {
+            return D;
+        } else {
+            return dv_;
+        }
     }
-    for (size_t i = 0; i < v_exp.size(); ++i) {
-        v_exp[i] /= sum;
+    constexpr size_t nhead() const {
+        if constexpr (NHEAD != 0) {
+            return NHEAD;
+        } else {
+            return nhead_;
+        }
     }
-}
+    constexpr size_t nkvhead() const {
+        if constexpr (NKVHEAD != 0) {
+            return NKVHEAD;
+        } else {
+            return nkvhead_;
+        }
+    }
+};
+
+// Prefill is split into (query head, query block) tasks. A block's K/V rows
+// are read tile by tile, each tile once for all of the block's queries, and
+// tiles no query of the block can see are skipped.
+constexpr size_t Q_BLOCK = 16;
+constexpr size_t KV_TILE = 64;
+
+// Largest head dim whose per-block scratch lives on the stack.
+constexpr size_t MAX_STACK_HEAD_DIM = 256;
+
+// The keys a query at absolute_pos sees: [0, sink_end) and [window_begin, causal_end).
+// For causal attention, we only attend to keys up to the current absolute position.
+// With a sliding window, only the last `window` of those plus the first `sink` keys
+// ("attention sinks") are visible.
+struct VisibleKeys {
+    size_t sink_end;
+    size_t window_begin;
+    size_t causal_end;
+
+    VisibleKeys(size_t absolute_pos, size_t window, size_t sink) {
+        causal_end = absolute_pos + 1;
+        window_begin = window > 0 && causal_end > window ? causal_end - window : 0;
+        sink_end = std::min(sink, window_begin);
+    }
+
+    size_t span() const {
+        return sink_end + (causal_end - window_begin);
+    }
+
+    // One past the last visible key.
+    size_t end() const {
+        return causal_end;
+    }
+
+    // Calls fn(k, i) for every visible key k in [begin, end), in key order,
+    // with i its index among all visible keys.
+    template <typename Fn>
+    void forEach(size_t begin, size_t end, Fn &&fn) const {
+        for (size_t k = begin; k < std::min(end, sink_end); ++k) {
+            fn(k, k);
+        }
+        for (size_t k = std::max(begin, window_begin); k < std::min(end, causal_end); ++k) {
+            fn(k, sink_end + (k - window_begin));
+        }
+    }
+
+    bool any(size_t begin, size_t end) const {
+        return begin < sink_end || (begin < causal_end && end > window_begin);
+    }
+};
+
+struct CausalMask {
+    size_t kv_cache_len;
+    size_t window;
+    size_t sink;
+
+    VisibleKeys row(size_t s) const {
+        return VisibleKeys(kv_cache_len + s, window, sink);
+    }
+};
+
+// The keys of a query in a token tree: the whole cached prefix [0, prefix),
+// then the keys of its ancestors and itself, ascending.
+struct TreeKeys {
+    size_t prefix;
+    const size_t *path;
+    size_t depth;
+
+    size_t span() const {
+        return prefix + depth;
+    }
+
+    size_t end() const {
+        return path[depth - 1] + 1;
+    }
+
+    template <typename Fn>
+    void forEach(size_t begin, size_t end, Fn &&fn) const {
+        for (size_t k = begin; k < std::min(end, prefix); ++k) {
+            fn(k, k);
+        }
+        for (size_t i = std::lower_bound(path, path + depth, begin) - path; i < depth && path[i] < end; ++i) {
+            fn(path[i], prefix + i);
+        }
+    }
+
+    bool any(size_t begin, size_t end) const {
+        if (begin < prefix) {
+            return true;
+        }
+        const size_t *first = std::lower_bound(path, path + depth, begin);
+        return first != path + depth && *first < end;
+    }
+};
+
+struct TreeMask {
+    size_t prefix;
+    // Key paths of all queries back to back; query s's starts at offsets[s].
+    std::vector<size_t> paths;
+    std::vector<size_t> offsets;
+
+    // parents[s] is the query s's parent among the queries (< s), or -1 for a root.
+    TreeMask(size_t prefix_, const int64_t *parents, size_t qlen) : prefix(prefix_), offsets(qlen + 1) {
+        std::vector<size_t> depth(qlen);
+        for (size_t s = 0; s < qlen; ++s) {
+            depth[s] = parents[s] < 0 ? 1 : depth[parents[s]] + 1;
+            offsets[s + 1] = offsets[s] + depth[s];
+        }
+        paths.resize(offsets[qlen]);
+        for (size_t s = 0; s < qlen; ++s) {
+            // Walk up to the root, filling the path from its end.
+            size_t *path = paths.data() + offsets[s];
+            int64_t node = static_cast<int64_t>(s);
+            for (size_t i = depth[s]; i-- > 0; node = parents[node]) {
+                path[i] = prefix + static_cast<size_t>(node);
+            }
+        }
+    }
+
+    TreeKeys row(size_t s) const {
+        return TreeKeys{prefix, paths.data() + offsets[s], offsets[s + 1] - offsets[s]};
+    }
+};
 
-template <typename T>
+template <typename T, size_t D, size_t NHEAD, size_t NKVHEAD, typename Mask>
 void self_attn_impl(
     size_t qlen,
-    size_t kvlen, // total_len from the K/V cache
-    size_t nhead,
-    size_t nkvhead,
-    size_t d,
-    size_t dv,
-    size_t elem_size,
-    const std::byte *q_base,
-    const std::byte *k_base,
-    const std::byte *v_base,
-    std::byte *attn_base,
-    float scale) {
+    AttnShape<D, NHEAD, NKVHEAD> shape,
+    const T *q_base,
+    const T *k_base,
+    const T *v_base,
+    T *attn_base,
+    float scale,
+    const Mask &mask) {
+    namespace vmath = llaisys::utils::vmath;
+    using llaisys::utils::cast;
 
+    const size_t d = shape.d();
+    const size_t dv = shape.dv();
+    const size_t nhead = shape.nhead();
+    const size_t nkvhead = shape.nkvhead();
     const size_t heads_per_kv = nhead / nkvhead;
-    const size_t kv_cache_len = kvlen - qlen;
+    const size_t nblock = (qlen + Q_BLOCK - 1) / Q_BLOCK;
 
-    // Loop over each query token in the current batch
-    for (size_t s = 0; s < qlen; ++s) {
-        // The absolute position of the current query in the full sequence
-        const size_t absolute_pos = kv_cache_len + s;
-
-        // Loop over each query head
-        for (size_t h = 0; h < nhead; ++h) {
-            // Find the corresponding key/value head for the current query head (for GQA)
-            const size_t hk = h / heads_per_kv;
-
-            // --- 1. Calculate Attention Scores (Q * K^T * scale) ---
-            // For causal attention, we only attend to keys up to the current absolute position.
-            const size_t attention_span = absolute_pos + 1;
-            std::vector<float> qk_prod(attention_span);
-
-            auto q_offset_byte = static_cast<ptrdiff_t>(((s * nhead * d) + (h * d)) * elem_size);
-            
-            for (size_t s_k = 0; s_k < attention_span; ++s_k) {
-                auto k_offset_byte = static_cast<ptrdiff_t>(((s_k * nkvhead * d) + (hk * d)) * elem_size);
-                float current_qk_prod = 0.0f;
-                for (size_t j = 0; j < d; ++j) {
-                    auto q_val = llaisys::utils::cast<float>(*reinterpret_cast<const T *>(q_base + q_offset_byte + j * elem_size));
-                    auto k_val = llaisys::utils::cast<float>(*reinterpret_cast<const T *>(k_base + k_offset_byte + j * elem_size));
-                    current_qk_prod += q_val * k_val;
-                }
-                qk_prod[s_k] = current_qk_prod * scale;
+    // Later blocks see more keys, so they are handed out first.
+    llaisys::utils::parallelFor(nblock * nhead, [&](size_t task) {
+        const size_t block = nblock - 1 - task / nhead;
+        const size_t h = task % nhead;
+        // Find the corresponding key/value head for the current query head (for GQA)
+        const size_t hk = h / heads_per_kv;
+        const size_t s0 = block * Q_BLOCK;
+        const size_t nrow = std::min(Q_BLOCK, qlen - s0);
+
+        std::vector<decltype(mask.row(0))> visible;
+        size_t max_span = 0;
+        size_t key_end = 0;
+        for (size_t r = 0; r < nrow; ++r) {
+            visible.push_back(mask.row(s0 + r));
+            max_span = std::max(max_span, visible.back().span());
+            key_end = std::max(key_end, visible.back().end());
+        }
+        auto tileVisible = [&](size_t t0, size_t t1) {
+            return std::any_of(visible.begin(), visible.end(), [&](const auto &keys) { return keys.any(t0, t1); });
+        };
+        // Queries and outputs of the block's rows in float.
+        const bool on_stack = d <= MAX_STACK_HEAD_DIM && dv <= MAX_STACK_HEAD_DIM;
+        std::vector<float> heap_scratch(on_stack ? 0 : nrow * (d + dv));
+        float stack_scratch[Q_BLOCK * 2 * MAX_STACK_HEAD_DIM];
+        float *q_vec = on_stack ? stack_scratch : heap_scratch.data();
+        float *acc = q_vec + nrow * d;
+        std::fill(acc, acc + nrow * dv, 0.0f);
+        // Scores, then probabilities, of row r at [r * max_span, + span).
+        std::vector<float> scores(nrow * max_span);
+        for (size_t r = 0; r < nrow; ++r) {
+            vmath::toF32(q_vec + r * d, q_base + ((s0 + r) * nhead + h) * d, d);
+        }
+
+        // --- 1. Calculate Attention Scores (Q * K^T * scale) ---
+        for (size_t t0 = 0; t0 < key_end; t0 += KV_TILE) {
+            const size_t t1 = std::min(key_end, t0 + KV_TILE);
+            if (!tileVisible(t0, t1)) {
+                continue;
+            }
+            for (size_t r = 0; r < nrow; ++r) {
+                const float *q_row = q_vec + r * d;
+                float *score_row = scores.data() + r * max_span;
+                visible[r].forEach(t0, t1, [&](size_t key, size_t i) {
+                    const T *k_row = k_base + (key * nkvhead + hk) * d;
+                    float current_qk_prod = 0.0f;
+                    for (size_t j = 0; j < d; ++j) {
+                        current_qk_prod += q_row[j] * cast<float>(k_row[j]);
+                    }
+                    score_row[i] = current_qk_prod * scale;
+                });
             }
+        }
 
-            // --- 2. Apply Causal Softmax ---
-            std::vector<float> qk_logits(attention_span);
-            softmax(qk_prod, qk_logits);
-
-            // --- 3. Calculate Final Output (Softmax_Scores * V) ---
-            auto attn_offset_byte = static_cast<ptrdiff_t>(((s * nhead * dv) + (h * dv)) * elem_size);
-            
-            for (size_t j = 0; j < dv; ++j) {
-                float acc_val = 0.0;
-                for (size_t s_v = 0; s_v < attention_span; ++s_v) {
-                    auto v_offset_byte = static_cast<ptrdiff_t>(((s_v * nkvhead * dv) + (hk * dv)) * elem_size);
-                    auto v_val = llaisys::utils::cast<float>(*reinterpret_cast<const T *>(v_base + v_offset_byte + j * elem_size));
-                    acc_val += qk_logits[s_v] * v_val;
-                }
-                *reinterpret_cast<T *>(attn_base + attn_offset_byte + j * elem_size) = llaisys::utils::cast<T>(acc_val);
+        // --- 2. Apply Causal Softmax ---
+        for (size_t r = 0; r < nrow; ++r) {
+            float *score_row = scores.data() + r * max_span;
+            vmath::softmax(score_row, score_row, visible[r].span());
+        }
+
+        // --- 3. Calculate Final Output (Softmax_Scores * V) ---
+        // Each output element still sums in key order.
+        for (size_t t0 = 0; t0 < key_end; t0 += KV_TILE) {
+            const size_t t1 = std::min(key_end, t0 + KV_TILE);
+            if (!tileVisible(t0, t1)) {
+                continue;
+            }
+            for (size_t r = 0; r < nrow; ++r) {
+                const float *prob_row = scores.data() + r * max_span;
+                float *acc_row = acc + r * dv;
+                visible[r].forEach(t0, t1, [&](size_t key, size_t i) {
+                    const T *v_row = v_base + (key * nkvhead + hk) * dv;
+                    const float p = prob_row[i];
+                    for (size_t j = 0; j < dv; ++j) {
+                        acc_row[j] += p * cast<float>(v_row[j]);
+                    }
+                });
             }
         }
+        for (size_t r = 0; r < nrow; ++r) {
+            vmath::fromF32(attn_base + ((s0 + r) * nhead + h) * dv, acc + r * dv, dv);
+        }
+    });
+}
+
+// Picks the specialization for the shape: the full Qwen2 1.5B (hidden 1536,
+// 12 heads over 2 KV heads) and 7B (hidden 3584, 28 over 4) layouts, then head
+// dim 128 or 64 alone (other models, tensor-parallel head slices), then the
+// generic kernel.
+template <typename T, typename Mask>
+void self_attn_dispatch(size_t qlen, size_t nhead, size_t nkvhead, size_t d, size_t dv,
+                        const std::byte *q, const std::byte *k, const std::byte *v, std::byte *attn,
+                        float scale, const Mask &mask) {
+    const auto *q_base = reinterpret_cast<const T *>(q);
+    const auto *k_base = reinterpret_cast<const T *>(k);
+    const auto *v_base = reinterpret_cast<const T *>(v);
+    auto *attn_base = reinterpret_cast<T *>(attn);
+    auto run = [&](auto shape) {
+        self_attn_impl<T>(qlen, shape, q_base, k_base, v_base, attn_base, scale, mask);
+    };
+    if (d == dv) {
+        if (d == 128 && nhead == 12 && nkvhead == 2) {
+            return run(AttnShape<128, 12, 2>{});
+        }
+        if (d == 128 && nhead == 28 && nkvhead == 4) {
+            return run(AttnShape<128, 28, 4>{});
+        }
+        if (d == 128) {
+            return run(AttnShape<128, 0, 0>{0, 0, nhead, nkvhead});
+        }
+        if (d == 64) {
+            return run(AttnShape<64, 0, 0>{0, 0, nhead, nkvhead});
+        }
     }
+    run(AttnShape<0, 0, 0>{d, dv, nhead, nkvhead});
 }
 
-// Public-facing wrapper function
-void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float scale) {
+template <typename Mask>
+void self_attn_run(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float scale, const Mask &mask) {
     size_t qlen = q->shape()[0];
-    size_t kvlen = k->shape()[0]; // This is `total_len`
     size_t nhead = q->shape()[1];
     size_t nkvhead = k->shape()[1];
     size_t d = q->shape()[2];
     size_t dv = v->shape()[2];
-    size_t elem_size = q->elementSize();
+    CHECK_ARGUMENT(nkvhead > 0 && nhead % nkvhead == 0, "self_attention: query heads must be a multiple of KV heads");
     const auto *q_base = q->data();
     const auto *k_base = k->data();
     const auto *v_base = v->data();
@@ -106,13 +327,13 @@ void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float
     // Dispatch to the correct templated implementation based on data type
     switch (dtype) {
     case LLAISYS_DTYPE_F32:
-        self_attn_impl<float>(qlen, kvlen, nhead, nkvhead, d, dv, elem_size, q_base, k_base, v_base, attn_base, scale);
+        self_attn_dispatch<float>(qlen, nhead, nkvhead, d, dv, q_base, k_base, v_base, attn_base, scale, mask);
         break;
     case LLAISYS_DTYPE_F16:
-        self_attn_impl<llaisys::fp16_t>(qlen, kvlen, nhead, nkvhead, d, dv, elem_size, q_base, k_base, v_base, attn_base, scale);
+        self_attn_dispatch<llaisys::fp16_t>(qlen, nhead, nkvhead, d, dv, q_base, k_base, v_base, attn_base, scale, mask);
         break;
     case LLAISYS_DTYPE_BF16:
-        self_attn_impl<llaisys::bf16_t>(qlen, kvlen, nhead, nkvhead, d, dv, elem_size, q_base, k_base, v_base, attn_base, scale);
+        self_attn_dispatch<llaisys::bf16_t>(qlen, nhead, nkvhead, d, dv, q_base, k_base, v_base, attn_base, scale, mask);
         break;
 
     default:
@@ -120,4 +341,49 @@ void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float
     }
 }
 
-} // namespace llaisys::ops
\ No newline at end of file
+// Public-facing wrapper function
+void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float scale) {
+    self_attention(attn_val, q, k, v, scale, 0, 0);
+}
+
+void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float scale, size_t window, size_t sink) {
+    size_t qlen = q->shape()[0];
+    size_t kvlen = k->shape()[0]; // This is `total_len`
+    self_attn_run(attn_val, q, k, v, scale, CausalMask{kvlen - qlen, window, sink});
+}
+
+// Reads a parents tensor for qlen queries, checking that it describes a forest.
+const int64_t *tree_parents(tensor_t parents, size_t qlen, const char *op) {
+    CHECK_ARGUMENT(parents->dtype() == LLAISYS_DTYPE_I64 && parents->ndim() == 1 && parents->shape()[0] == qlen,
+                   std::string(op) + ": parents must be I64 [qlen]");
+    ASSERT(parents->isContiguous(), std::string(op) + ": parents must be contiguous");
+    const auto *parent_ids = reinterpret_cast<const int64_t *>(parents->data());
+    for (size_t s = 0; s < qlen; ++s) {
+        CHECK_ARGUMENT(parent_ids[s] >= -1 && parent_ids[s] < static_cast<int64_t>(s),
+                       std::string(op) + ": each parent must be -1 or an earlier query");
+    }
+    return parent_ids;
+}
+
+void self_attention_tree(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, tensor_t parents, float scale) {
+    size_t qlen = q->shape()[0];
+    size_t kvlen = k->shape()[0];
+    CHECK_ARGUMENT(kvlen >= qlen, "self_attention_tree: K/V must hold the queries' own keys");
+    const auto *parent_ids = tree_parents(parents, qlen, "self_attention_tree");
+    self_attn_run(attn_val, q, k, v, scale, TreeMask(kvlen - qlen, parent_ids, qlen));
+}
+
+void tree_position_ids(tensor_t pos_ids, tensor_t parents, int64_t start) {
+    CHECK_ARGUMENT(pos_ids->dtype() == LLAISYS_DTYPE_I64 && pos_ids->ndim() == 1,
+                   "tree_position_ids: pos_ids must be I64 [qlen]");
+    ASSERT(pos_ids->isContiguous(), "tree_position_ids: pos_ids must be contiguous");
+    const size_t qlen = pos_ids->shape()[0];
+    const auto *parent_ids = tree_parents(parents, qlen, "tree_position_ids");
+    auto *pos = reinterpret_cast<int64_t *>(pos_ids->data());
+    // A root sits right after the prefix; each child one past its parent.
+    for (size_t s = 0; s < qlen; ++s) {
+        pos[s] = parent_ids[s] < 0 ? start : pos[parent_ids[s]] + 1;
+    }
+}
+
+} // namespace llaisys::ops
@@ -4,4 +4,15 @@
 
 namespace llaisys::ops {
 void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float scale);
+// Sliding-window attention: each query sees at most the last `window` keys (0 = unlimited)
+// plus the first `sink` keys of the cache.
+void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float scale, size_t window, size_t sink);
+// Attention over a token tree, e.g. several draft branches verified in one
+// forward, or independent sequences packed into one batch. The last qlen
+// K/V rows belong to the queries; the rows before them are a shared prefix
+// every query sees. parents is I64 [qlen]: parents[s] < s is query s's parent,
+// or -1 for a root. Query s also sees itself and its ancestors, nothing else.
+void self_attention_tree(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, tensor_t parents, float scale);
+// Position ids for a tree: start for roots, one past the parent otherwise.
+void tree_position_ids(tensor_t pos_ids, tensor_t parents, int64_t start);
 }
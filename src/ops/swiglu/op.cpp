@@ -1,7 +1,49 @@
 #include "op.hpp"
+#include "../../utils.hpp"
+#include "../../utils/vmath.hpp"
+
+#include <algorithm>
 
 namespace llaisys::ops {
+
+template <typename T>
+void swiglu_impl(T *out, const T *gate, const T *up, size_t numel) {
+    // SiLU runs vectorized over float chunks; out may alias gate or up.
+    namespace vmath = llaisys::utils::vmath;
+    constexpr size_t CHUNK = 256;
+    float act[CHUNK];
+    float val[CHUNK];
+    for (size_t begin = 0; begin < numel; begin += CHUNK) {
+        const size_t n = std::min(CHUNK, numel - begin);
+        vmath::toF32(act, gate + begin, n);
+        vmath::silu(act, act, n);
+        vmath::toF32(val, up + begin, n);
+        for (size_t i = 0; i < n; ++i) {
+            val[i] *= act[i];
+        }
+        vmath::fromF32(out + begin, val, n);
+    }
+}
+
 void swiglu(tensor_t out, tensor_t gate, tensor_t up) {
-    TO_BE_IMPLEMENTED();
+    CHECK_SAME_DEVICE(out, gate, up);
+    CHECK_SAME_SHAPE(out->shape(), gate->shape(), up->shape());
+    CHECK_SAME_DTYPE(out->dtype(), gate->dtype(), up->dtype());
+    ASSERT(out->isContiguous() && gate->isContiguous() && up->isContiguous(), "SwiGLU: all tensors must be contiguous.");
+
+    const size_t numel = out->numel();
+    switch (out->dtype()) {
+    case LLAISYS_DTYPE_F32:
+        return swiglu_impl(reinterpret_cast<float *>(out->data()), reinterpret_cast<const float *>(gate->data()),
+                           reinterpret_cast<const float *>(up->data()), numel);
+    case LLAISYS_DTYPE_F16:
+        return swiglu_impl(reinterpret_cast<llaisys::fp16_t *>(out->data()), reinterpret_cast<const llaisys::fp16_t *>(gate->data()),
+                           reinterpret_cast<const llaisys::fp16_t *>(up->data()), numel);
+    case LLAISYS_DTYPE_BF16:
+        return swiglu_impl(reinterpret_cast<llaisys::bf16_t *>(out->data()), reinterpret_cast<const llaisys::bf16_t *>(gate->data()),
+                           reinterpret_cast<const llaisys::bf16_t *>(up->data()), numel);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(out->dtype());
+    }
 }
 } // namespace llaisys::ops
@@ -0,0 +1,243 @@
+#include "http.hpp"
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+namespace llaisys::server {
+
+namespace {
+constexpr size_t MAX_HEADER_BYTES = 64 * 1024;
+constexpr size_t MAX_BODY_BYTES = 16 * 1024 * 1024;
+
+std::string lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+std::string trim(const std::string &s) {
+    size_t begin = s.find_first_not_of(" \t");
+    size_t end = s.find_last_not_of(" \t\r");
+    return begin == std::string::npos ? std::string() : s.substr(begin, end - begin + 1);
+}
+
+// Read a full request from `fd`. Returns 0 once it is complete, otherwise the status to
+// answer with: 413 for an oversized body, 400 for malformed input or a closed socket.
+int readRequest(int fd, HttpRequest &request) {
+    std::string data;
+    char buf[8192];
+    size_t header_end;
+    while ((header_end = data.find("\r\n\r\n")) == std::string::npos) {
+        if (data.size() > MAX_HEADER_BYTES) {
+            return 400;
+        }
+        ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            return 400;
+        }
+        data.append(buf, static_cast<size_t>(n));
+    }
+
+    size_t line_end = data.find("\r\n");
+    std::string request_line = data.substr(0, line_end);
+    size_t sp1 = request_line.find(' ');
+    size_t sp2 = request_line.find(' ', sp1 + 1);
+    if (sp1 == std::string::npos || sp2 == std::string::npos) {
+        return 400;
+    }
+    request.method = request_line.substr(0, sp1);
+    request.path = request_line.substr(sp1 + 1, sp2 - sp1 - 1);
+    request.path = request.path.substr(0, request.path.find('?'));
+
+    size_t pos = line_end + 2;
+    while (pos < header_end) {
+        size_t eol = data.find("\r\n", pos);
+        std::string line = data.substr(pos, eol - pos);
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+            request.headers[lower(trim(line.substr(0, colon)))] = trim(line.substr(colon + 1));
+        }
+        pos = eol + 2;
+    }
+
+    size_t length = 0;
+    auto it = request.headers.find("content-length");
+    if (it != request.headers.end()) {
+        try {
+            length = std::stoul(it->second);
+        } catch (const std::exception &) {
+            return 400;
+        }
+    }
+    if (length > MAX_BODY_BYTES) {
+        return 413;
+    }
+    request.body = data.substr(header_end + 4);
+    while (request.body.size() < length) {
+        ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            return 400;
+        }
+        request.body.append(buf, static_cast<size_t>(n));
+    }
+    request.body.resize(length);
+    return 0;
+}
+} // namespace
+
+const char *httpStatusText(int status) {
+    switch (status) {
+    case 200: return "OK";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 413: return "Payload Too Large";
+    case 429: return "Too Many Requests";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default: return "Unknown";
+    }
+}
+
+bool HttpResponse::_write(const std::string &data) {
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t n = ::send(_fd, data.data() + done, data.size() - done, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void HttpResponse::send(int status, const std::string &content_type, const std::string &body) {
+    std::string head = "HTTP/1.1 " + std::to_string(status) + " " + httpStatusText(status) + "\r\n"
+                     + "Content-Type: " + content_type + "\r\n"
+                     + "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                     + "Connection: close\r\n\r\n";
+    _sent = true;
+    _write(head + body);
+}
+
+void HttpResponse::beginEvents() {
+    _sent = true;
+    _write("HTTP/1.1 200 OK\r\n"
+           "Content-Type: text/event-stream\r\n"
+           "Cache-Control: no-cache\r\n"
+           "Connection: close\r\n\r\n");
+}
+
+bool HttpResponse::sendEvent(const std::string &data) {
+    return _write("data: " + data + "\n\n");
+}
+
+HttpServer::~HttpServer() {
+    stop();
+}
+
+int HttpServer::listen(const std::string &host, int port) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo *addrs = nullptr;
+    const std::string service = std::to_string(port);
+    if (::getaddrinfo(host.c_str(), service.c_str(), &hints, &addrs) != 0 || addrs == nullptr) {
+        throw std::runtime_error("HttpServer: cannot resolve " + host);
+    }
+    for (addrinfo *ai = addrs; ai != nullptr && _fd < 0; ai = ai->ai_next) {
+        int fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        int one = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (::bind(fd, ai->ai_addr, ai->ai_addrlen) == 0 && ::listen(fd, 128) == 0) {
+            _fd = fd;
+        } else {
+            ::close(fd);
+        }
+    }
+    ::freeaddrinfo(addrs);
+    if (_fd < 0) {
+        throw std::runtime_error("HttpServer: cannot listen on " + host + ":" + service + ": " + std::strerror(errno));
+    }
+
+    sockaddr_storage addr{};
+    socklen_t len = sizeof(addr);
+    ::getsockname(_fd, reinterpret_cast<sockaddr *>(&addr), &len);
+    if (addr.ss_family == AF_INET6) {
+        return ntohs(reinterpret_cast<sockaddr_in6 *>(&addr)->sin6_port);
+    }
+    return ntohs(reinterpret_cast<sockaddr_in *>(&addr)->sin_port);
+}
+
+void HttpServer::serve() {
+    while (!_stopping) {
+        int fd = ::accept(_fd, nullptr, nullptr);
+        if (fd < 0) {
+            if (_stopping) {
+                break;
+            }
+            continue;
+        }
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _active++;
+        }
+        std::thread([this, fd] {
+            _handle(fd);
+            // Notify under the lock: serve() may return and destroy the server
+            // as soon as it can observe the count.
+            std::lock_guard<std::mutex> lock(_mutex);
+            _active--;
+            _idle.notify_all();
+        }).detach();
+    }
+    // Handlers use objects the caller destroys once serve() returns.
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this] { return _active == 0; });
+}
+
+void HttpServer::stop() {
+    if (!_stopping.exchange(true) && _fd >= 0) {
+        ::shutdown(_fd, SHUT_RDWR);
+        ::close(_fd);
+    }
+}
+
+void HttpServer::_handle(int fd) {
+    HttpRequest request;
+    HttpResponse response(fd);
+    if (const int status = readRequest(fd, request)) {
+        const char *message = status == 413 ? "request body too large" : "malformed request";
+        response.send(status, "application/json", std::string("{\"error\":{\"message\":\"") + message + "\"}}");
+    } else {
+        try {
+            _handler(request, response);
+        } catch (const std::exception &e) {
+            std::cerr << "[server] " << request.method << " " << request.path << " failed: " << e.what() << std::endl;
+            if (!response.sent()) {
+                response.send(500, "application/json", "{\"error\":{\"message\":\"internal error\"}}");
+            }
+        }
+    }
+    ::shutdown(fd, SHUT_WR);
+    ::close(fd);
+}
+
+} // namespace llaisys::server
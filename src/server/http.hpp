@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace llaisys::server {
+
+struct HttpRequest {
+    std::string method;
+    std::string path; // without the query string
+    std::map<std::string, std::string> headers; // lower-case names
+    std::string body;
+};
+
+// Response side of one connection. A handler either calls send() once, or
+// beginEvents() followed by any number of sendEvent() for a server-sent event
+// stream. Connections are closed after each request.
+class HttpResponse {
+public:
+    HttpResponse(int fd) : _fd(fd) {}
+
+    void send(int status, const std::string &content_type, const std::string &body);
+    void beginEvents();
+    // Returns false once the client has gone away.
+    bool sendEvent(const std::string &data);
+    bool sent() const { return _sent; }
+
+private:
+    int _fd;
+    bool _sent = false;
+
+    bool _write(const std::string &data);
+};
+
+// Small blocking HTTP/1.1 server: one thread per connection, Content-Length
+// bodies only. Good enough for a local inference endpoint.
+class HttpServer {
+public:
+    using Handler = std::function<void(const HttpRequest &, HttpResponse &)>;
+
+    HttpServer(Handler handler) : _handler(std::move(handler)) {}
+    ~HttpServer();
+
+    // Bind and listen; port 0 picks a free port. Returns the bound port.
+    int listen(const std::string &host, int port);
+    // Accept connections until stop() is called, then wait for the open ones to finish.
+    void serve();
+    void stop();
+
+private:
+    Handler _handler;
+    int _fd = -1;
+    std::atomic<bool> _stopping{false};
+    std::mutex _mutex;
+    std::condition_variable _idle;
+    size_t _active = 0; // connection threads still running
+
+    void _handle(int fd);
+};
+
+const char *httpStatusText(int status);
+
+} // namespace llaisys::server
@@ -0,0 +1,352 @@
+#include "loader.hpp"
+
+#include "../core/loader/loader.hpp"
+#include "../utils/json.hpp"
+
+#include "../utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <sstream>
+
+namespace llaisys::server {
+
+using utils::Json;
+
+namespace {
+
+std::string readFile(const std::filesystem::path &path) {
+    std::ifstream file(path, std::ios::binary);
+    CHECK_ARGUMENT(file.good(), "cannot open " + path.string());
+    std::stringstream buf;
+    buf << file.rdbuf();
+    return buf.str();
+}
+
+llaisysDataType_t parseTorchDtype(const std::string &name) {
+    if (name == "float32") {
+        return LLAISYS_DTYPE_F32;
+    }
+    if (name == "float16") {
+        return LLAISYS_DTYPE_F16;
+    }
+    CHECK_ARGUMENT(name == "bfloat16", "unsupported torch_dtype " + name);
+    return LLAISYS_DTYPE_BF16;
+}
+
+llaisysDataType_t parseSafetensorsDtype(const std::string &name) {
+    if (name == "F32") {
+        return LLAISYS_DTYPE_F32;
+    }
+    if (name == "F16") {
+        return LLAISYS_DTYPE_F16;
+    }
+    CHECK_ARGUMENT(name == "BF16", "unsupported safetensors dtype " + name);
+    return LLAISYS_DTYPE_BF16;
+}
+
+float loadFloat(const std::byte *src, llaisysDataType_t dtype, size_t i) {
+    switch (dtype) {
+    case LLAISYS_DTYPE_F32:
+        return reinterpret_cast<const float *>(src)[i];
+    case LLAISYS_DTYPE_F16:
+        return utils::cast<float>(reinterpret_cast<const fp16_t *>(src)[i]);
+    case LLAISYS_DTYPE_BF16:
+        return utils::cast<float>(reinterpret_cast<const bf16_t *>(src)[i]);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(dtype);
+    }
+}
+
+void storeFloat(std::byte *dst, llaisysDataType_t dtype, size_t i, float value) {
+    switch (dtype) {
+    case LLAISYS_DTYPE_F32:
+        reinterpret_cast<float *>(dst)[i] = value;
+        break;
+    case LLAISYS_DTYPE_F16:
+        reinterpret_cast<fp16_t *>(dst)[i] = utils::cast<fp16_t>(value);
+        break;
+    case LLAISYS_DTYPE_BF16:
+        reinterpret_cast<bf16_t *>(dst)[i] = utils::cast<bf16_t>(value);
+        break;
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(dtype);
+    }
+}
+
+// Same name mapping as python/llaisys/models/qwen2.py.
+tensor_t weightFor(models::Qwen2Weights &w, const std::string &name) {
+    if (name == "model.embed_tokens.weight") {
+        return w.in_embed;
+    }
+    if (name == "lm_head.weight") {
+        return w.out_embed;
+    }
+    if (name == "model.norm.weight") {
+        return w.out_norm_w;
+    }
+    const std::string prefix = "model.layers.";
+    if (name.compare(0, prefix.size(), prefix) != 0) {
+        return nullptr;
+    }
+    size_t dot = name.find('.', prefix.size());
+    if (dot == std::string::npos) {
+        return nullptr;
+    }
+    const size_t layer = std::stoul(name.substr(prefix.size(), dot - prefix.size()));
+    const std::string suffix = name.substr(dot + 1);
+    const std::pair<const char *, std::vector<tensor_t> *> table[] = {
+        {"input_layernorm.weight", &w.attn_norm_w},
+        {"self_attn.q_proj.weight", &w.attn_q_w},
+        {"self_attn.q_proj.bias", &w.attn_q_b},
+        {"self_attn.k_proj.weight", &w.attn_k_w},
+        {"self_attn.k_proj.bias", &w.attn_k_b},
+        {"self_attn.v_proj.weight", &w.attn_v_w},
+        {"self_attn.v_proj.bias", &w.attn_v_b},
+        {"self_attn.o_proj.weight", &w.attn_o_w},
+        {"post_attention_layernorm.weight", &w.mlp_norm_w},
+        {"mlp.gate_proj.weight", &w.mlp_gate_w},
+        {"mlp.up_proj.weight", &w.mlp_up_w},
+        {"mlp.down_proj.weight", &w.mlp_down_w},
+    };
+    for (const auto &entry : table) {
+        if (suffix == entry.first && layer < entry.second->size()) {
+            return (*entry.second)[layer];
+        }
+    }
+    return nullptr;
+}
+
+// Call fn(name, dtype, numel, file, offset) for every tensor of a .safetensors
+// file, where its data starts at `offset` in `file`.
+template <typename Fn>
+void forEachTensorEntry(const std::filesystem::path &path, Fn fn) {
+    std::ifstream file(path, std::ios::binary);
+    CHECK_ARGUMENT(file.good(), "cannot open " + path.string());
+    uint64_t header_len = 0;
+    file.read(reinterpret_cast<char *>(&header_len), sizeof(header_len));
+    std::string header(header_len, '\0');
+    file.read(header.data(), static_cast<std::streamsize>(header_len));
+    CHECK_ARGUMENT(file.good(), "truncated safetensors header in " + path.string());
+    const uint64_t data_begin = sizeof(header_len) + header_len;
+
+    const Json tensors = Json::parse(header);
+    for (const auto &[name, info] : tensors.items()) {
+        if (name == "__metadata__") {
+            continue;
+        }
+        const auto dtype = parseSafetensorsDtype(info["dtype"].asString());
+        const uint64_t begin = static_cast<uint64_t>(info["data_offsets"][0].asInt());
+        const uint64_t end = static_cast<uint64_t>(info["data_offsets"][1].asInt());
+        fn(name, dtype, (end - begin) / utils::dsize(dtype), file, data_begin + begin);
+    }
+}
+
+void readAt(std::ifstream &file, uint64_t offset, std::byte *dst, size_t size, const std::string &name) {
+    file.seekg(static_cast<std::streamoff>(offset));
+    file.read(reinterpret_cast<char *>(dst), static_cast<std::streamsize>(size));
+    CHECK_ARGUMENT(file.good(), "truncated tensor " + name);
+}
+
+// Call fn(name, dtype, numel, data) for every tensor of a .safetensors file.
+template <typename Fn>
+void forEachTensor(const std::filesystem::path &path, Fn fn) {
+    std::vector<std::byte> raw;
+    forEachTensorEntry(path, [&](const std::string &name, llaisysDataType_t dtype, size_t numel, std::ifstream &file,
+                                 uint64_t offset) {
+        raw.resize(numel * utils::dsize(dtype));
+        readAt(file, offset, raw.data(), raw.size(), name + " in " + path.string());
+        fn(name, dtype, numel, raw.data());
+    });
+}
+
+// Weights are read (and converted) chunk by chunk into the loader's staging
+// buffers, so disk reads overlap with the copies into the weight tensors.
+void loadSafetensors(const std::filesystem::path &path, models::Qwen2 &model, bool tie_embeddings) {
+    const auto &embed = model.weights().in_embed;
+    core::DoubleBufferedLoader loader(embed->deviceType(), embed->deviceId());
+    std::vector<std::byte> raw;
+    forEachTensorEntry(path, [&](const std::string &name, llaisysDataType_t src_dtype, size_t numel,
+                                 std::ifstream &file, uint64_t offset) {
+        std::vector<tensor_t> targets;
+        if (auto target = weightFor(model.weights(), name)) {
+            targets.push_back(target);
+        }
+        if (tie_embeddings && name == "model.embed_tokens.weight") {
+            targets.push_back(model.weights().out_embed);
+        }
+        const std::string where = name + " in " + path.string();
+        const size_t src_size = utils::dsize(src_dtype);
+        for (auto &target : targets) {
+            CHECK_ARGUMENT(target->numel() == numel, "shape mismatch for " + name);
+            const size_t dst_size = target->elementSize();
+            CHECK_ARGUMENT(loader.chunkBytes() % dst_size == 0, "loader chunk does not hold whole elements");
+            loader.load(target->data(), numel * dst_size, [&](std::byte *staging, size_t begin, size_t size) {
+                const size_t first = begin / dst_size;
+                const size_t count = size / dst_size;
+                if (target->dtype() == src_dtype) {
+                    readAt(file, offset + first * src_size, staging, size, where);
+                    return;
+                }
+                raw.resize(count * src_size);
+                readAt(file, offset + first * src_size, raw.data(), raw.size(), where);
+                for (size_t i = 0; i < count; i++) {
+                    storeFloat(staging, target->dtype(), i, loadFloat(raw.data(), src_dtype, i));
+                }
+            });
+        }
+    });
+    loader.synchronize();
+}
+
+// LoRA slot tensors (A, B) of a PEFT module name such as "self_attn.q_proj".
+std::pair<std::vector<tensor_t> *, std::vector<tensor_t> *> loraSlotsFor(models::Qwen2Weights &w,
+                                                                         const std::string &module) {
+    if (module == "self_attn.q_proj") {
+        return {&w.attn_q_lora_a, &w.attn_q_lora_b};
+    } else if (module == "self_attn.k_proj") {
+        return {&w.attn_k_lora_a, &w.attn_k_lora_b};
+    } else if (module == "self_attn.v_proj") {
+        return {&w.attn_v_lora_a, &w.attn_v_lora_b};
+    } else if (module == "self_attn.o_proj") {
+        return {&w.attn_o_lora_a, &w.attn_o_lora_b};
+    } else if (module == "mlp.gate_proj") {
+        return {&w.mlp_gate_lora_a, &w.mlp_gate_lora_b};
+    } else if (module == "mlp.up_proj") {
+        return {&w.mlp_up_lora_a, &w.mlp_up_lora_b};
+    } else if (module == "mlp.down_proj") {
+        return {&w.mlp_down_lora_a, &w.mlp_down_lora_b};
+    }
+    return {nullptr, nullptr};
+}
+
+} // namespace
+
+std::unique_ptr<models::Qwen2> loadQwen2(const std::string &model_dir, llaisysDeviceType_t device_type,
+                                         const std::vector<int> &device_ids, models::Qwen2::Parallel parallel,
+                                         const models::Qwen2::Offload &offload) {
+    const std::filesystem::path dir(model_dir);
+    const Json config = Json::parse(readFile(dir / "config.json"));
+
+    LlaisysQwen2Meta meta{};
+    meta.dtype = parseTorchDtype(config.contains("torch_dtype") ? config["torch_dtype"].asString() : "bfloat16");
+    meta.nlayer = static_cast<size_t>(config["num_hidden_layers"].asInt());
+    meta.hs = static_cast<size_t>(config["hidden_size"].asInt());
+    meta.nh = static_cast<size_t>(config["num_attention_heads"].asInt());
+    meta.nkvh = static_cast<size_t>(config["num_key_value_heads"].asInt());
+    meta.dh = meta.hs / meta.nh;
+    meta.di = static_cast<size_t>(config["intermediate_size"].asInt());
+    meta.maxseq = static_cast<size_t>(config["max_position_embeddings"].asInt());
+    meta.voc = static_cast<size_t>(config["vocab_size"].asInt());
+    meta.epsilon = static_cast<float>(config["rms_norm_eps"].asNumber());
+    meta.theta = config.contains("rope_theta") ? static_cast<float>(config["rope_theta"].asNumber()) : 10000.0f;
+    const Json &eos = config["eos_token_id"];
+    meta.end_token = eos.isArray() ? eos[0].asInt() : (eos.isNumber() ? eos.asInt() : -1);
+
+    auto model = std::make_unique<models::Qwen2>(meta, device_type, device_ids, parallel, offload);
+    if (config["use_sliding_window"].isBool() && config["use_sliding_window"].asBool()) {
+        const Json &first = config["max_window_layers"];
+        model->setSlidingWindow(static_cast<size_t>(config["sliding_window"].asInt()), 0,
+                                first.isNumber() ? static_cast<size_t>(first.asInt()) : 0);
+    }
+
+    const bool tie_embeddings = config["tie_word_embeddings"].isBool() && config["tie_word_embeddings"].asBool();
+    std::vector<std::filesystem::path> files;
+    for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+        if (entry.path().extension() == ".safetensors") {
+            files.push_back(entry.path());
+        }
+    }
+    CHECK_ARGUMENT(!files.empty(), "no .safetensors files in " + model_dir);
+    std::sort(files.begin(), files.end());
+    for (const auto &file : files) {
+        loadSafetensors(file, *model, tie_embeddings);
+    }
+    return model;
+}
+
+size_t loraRank(const std::string &adapter_dir) {
+    const Json config = Json::parse(readFile(std::filesystem::path(adapter_dir) / "adapter_config.json"));
+    CHECK_ARGUMENT(config["r"].isNumber() && config["r"].asInt() > 0, "adapter_config.json needs a positive 'r'");
+    return static_cast<size_t>(config["r"].asInt());
+}
+
+void loadLoRA(models::Qwen2 &model, const std::string &adapter_dir, size_t slot) {
+    const std::filesystem::path dir(adapter_dir);
+    const Json config = Json::parse(readFile(dir / "adapter_config.json"));
+    const size_t rank = loraRank(adapter_dir);
+    const size_t max_rank = model.loraRank();
+    CHECK_ARGUMENT(slot < model.loraAdapters(), "LoRA slot out of range");
+    CHECK_ARGUMENT(rank <= max_rank, "adapter rank exceeds the model's LoRA rank");
+    const double alpha = config["lora_alpha"].isNumber() ? config["lora_alpha"].asNumber() : static_cast<double>(rank);
+    const bool rslora = config["use_rslora"].isBool() && config["use_rslora"].asBool();
+    const float scale = static_cast<float>(rslora ? alpha / std::sqrt(static_cast<double>(rank)) : alpha / rank);
+
+    // Host copies of the slot, zero where the adapter has nothing.
+    auto &w = model.weights();
+    std::map<std::pair<size_t, std::string>, std::vector<float>> slots;
+    const std::string modules[] = {"self_attn.q_proj", "self_attn.k_proj", "self_attn.v_proj", "self_attn.o_proj",
+                                   "mlp.gate_proj", "mlp.up_proj", "mlp.down_proj"};
+    for (const auto &module : modules) {
+        const auto [a, b] = loraSlotsFor(w, module);
+        for (size_t layer = 0; layer < a->size(); layer++) {
+            slots[{layer, module + ".A"}].assign((*a)[layer]->numel() / model.loraAdapters(), 0.0f);
+            slots[{layer, module + ".B"}].assign((*b)[layer]->numel() / model.loraAdapters(), 0.0f);
+        }
+    }
+
+    // Keys look like base_model.model.model.layers.N.self_attn.q_proj.lora_A[.name].weight.
+    const std::regex key(R"(layers\.(\d+)\.(\w+\.\w+)\.lora_([AB])(?:\.\w+)?\.weight$)");
+    forEachTensor(dir / "adapter_model.safetensors",
+                  [&](const std::string &name, llaisysDataType_t dtype, size_t numel, const std::byte *raw) {
+                      std::smatch match;
+                      if (!std::regex_search(name, match, key)) {
+                          return;
+                      }
+                      const size_t layer = std::stoul(match[1]);
+                      auto it = slots.find({layer, match[2].str() + "." + match[3].str()});
+                      if (it == slots.end()) {
+                          return;
+                      }
+                      auto &dst = it->second;
+                      if (match[3] == "A") {
+                          // [r, In] into the first r rows of [max_rank, In].
+                          CHECK_ARGUMENT(numel * max_rank == dst.size() * rank, "shape mismatch for " + name);
+                          for (size_t i = 0; i < numel; i++) {
+                              dst[i] = loadFloat(raw, dtype, i);
+                          }
+                      } else {
+                          // [Out, r] into the first r columns of [Out, max_rank], scaled.
+                          const size_t out = dst.size() / max_rank;
+                          CHECK_ARGUMENT(numel == out * rank, "shape mismatch for " + name);
+                          for (size_t o = 0; o < out; o++) {
+                              for (size_t j = 0; j < rank; j++) {
+                                  dst[o * max_rank + j] = scale * loadFloat(raw, dtype, o * rank + j);
+                              }
+                          }
+                      }
+                  });
+
+    std::vector<std::byte> converted;
+    for (const auto &module : modules) {
+        const auto [a, b] = loraSlotsFor(w, module);
+        for (size_t layer = 0; layer < a->size(); layer++) {
+            for (const auto &[tensors, which] : {std::make_pair(a, ".A"), std::make_pair(b, ".B")}) {
+                const auto &src = slots[{layer, module + which}];
+                auto target = (*tensors)[layer]->slice(0, slot, slot + 1);
+                converted.resize(src.size() * target->elementSize());
+                for (size_t i = 0; i < src.size(); i++) {
+                    storeFloat(converted.data(), target->dtype(), i, src[i]);
+                }
+                target->load(converted.data());
+            }
+        }
+    }
+}
+
+} // namespace llaisys::server
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "../models/qwen2/qwen2.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace llaisys::server {
+
+// Build a Qwen2 model from a HuggingFace checkpoint directory (config.json and
+// *.safetensors). Weights are converted to the dtype named by torch_dtype.
+// Several CPU device ids run the model tensor- or pipeline-parallel, one NUMA
+// node per id. With `offload` set, layer weights are streamed from a scratch
+// file instead (see models::WeightOffload).
+std::unique_ptr<models::Qwen2> loadQwen2(const std::string &model_dir, llaisysDeviceType_t device_type,
+                                         const std::vector<int> &device_ids,
+                                         models::Qwen2::Parallel parallel = models::Qwen2::Parallel::TENSOR,
+                                         const models::Qwen2::Offload &offload = {});
+
+// LoRA rank `r` of a PEFT adapter directory (adapter_config.json).
+size_t loraRank(const std::string &adapter_dir);
+
+// Load a PEFT adapter (adapter_config.json and adapter_model.safetensors) into
+// LoRA slot `slot` of a model with LoRA enabled. alpha / r is folded into B and
+// projections the adapter does not target are cleared.
+void loadLoRA(models::Qwen2 &model, const std::string &adapter_dir, size_t slot);
+
+} // namespace llaisys::server
@@ -0,0 +1,143 @@
+#include "http.hpp"
+#include "loader.hpp"
+#include "openai.hpp"
+#include "scheduler.hpp"
+
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+llaisys::server::HttpServer *g_server = nullptr;
+
+void onSignal(int) {
+    if (g_server) {
+        g_server->stop();
+    }
+}
+
+void usage(const char *argv0) {
+    std::cerr << "usage: " << argv0 << " --model DIR [--host 127.0.0.1] [--port 8000] [--device cpu|nvidia]\n"
+              << "       [--device-ids 0,1]  (several CPU ids: parallel over those NUMA nodes)\n"
+              << "       [--parallel tensor|pipeline]\n"
+              << "       [--offload FILE] [--offload-prefetch 2]  (stream layer weights from a scratch file)\n"
+              << "       [--max-running 8] [--max-waiting 64] [--max-step-tokens 512] [--kv-blocks 0]\n"
+              << "       [--lora NAME=ADAPTER_DIR]...\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::string model_dir;
+    std::string host = "127.0.0.1";
+    std::string device = "cpu";
+    int port = 8000;
+    std::vector<int> device_ids{0};
+    std::string parallel = "tensor";
+    llaisys::models::Qwen2::Offload offload;
+    llaisys::server::Scheduler::Config config;
+    std::vector<std::pair<std::string, std::string>> loras; // (name, PEFT adapter dir)
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 2;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--model") {
+            model_dir = value;
+        } else if (arg == "--host") {
+            host = value;
+        } else if (arg == "--port") {
+            port = std::stoi(value);
+        } else if (arg == "--device") {
+            device = value;
+        } else if (arg == "--device-ids") {
+            device_ids.clear();
+            std::stringstream ids(value);
+            for (std::string id; std::getline(ids, id, ',');) {
+                device_ids.push_back(std::stoi(id));
+            }
+        } else if (arg == "--parallel") {
+            parallel = value;
+        } else if (arg == "--offload") {
+            offload.path = value;
+        } else if (arg == "--offload-prefetch") {
+            offload.prefetch = std::stoul(value);
+        } else if (arg == "--max-running") {
+            config.max_running = std::stoul(value);
+        } else if (arg == "--max-waiting") {
+            config.max_waiting = std::stoul(value);
+        } else if (arg == "--max-step-tokens") {
+            config.max_step_tokens = std::stoul(value);
+        } else if (arg == "--kv-blocks") {
+            config.kv_blocks = std::stoul(value);
+        } else if (arg == "--lora" && value.find('=') != std::string::npos && value.find('=') > 0) {
+            loras.emplace_back(value.substr(0, value.find('=')), value.substr(value.find('=') + 1));
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (model_dir.empty() || device_ids.empty() || (device != "cpu" && device != "nvidia")
+        || (parallel != "tensor" && parallel != "pipeline")) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    try {
+        auto model = llaisys::server::loadQwen2(model_dir, device == "cpu" ? LLAISYS_DEVICE_CPU : LLAISYS_DEVICE_NVIDIA, device_ids,
+                                                parallel == "pipeline" ? llaisys::models::Qwen2::Parallel::PIPELINE
+                                                                       : llaisys::models::Qwen2::Parallel::TENSOR,
+                                                offload);
+        // All adapters share one set of slots sized for the largest rank.
+        std::vector<std::string> adapter_names;
+        if (!loras.empty()) {
+            size_t max_rank = 0;
+            for (const auto &[name, dir] : loras) {
+                max_rank = std::max(max_rank, llaisys::server::loraRank(dir));
+            }
+            model->enableLoRA(loras.size(), max_rank);
+            for (size_t slot = 0; slot < loras.size(); slot++) {
+                llaisys::server::loadLoRA(*model, loras[slot].second, slot);
+                adapter_names.push_back(loras[slot].first);
+            }
+        }
+        llaisys::server::Scheduler scheduler(*model, config);
+        const std::string model_name = std::filesystem::path(model_dir).lexically_normal().filename().string();
+        std::unique_ptr<llaisys::server::TextCodec> codec;
+        if (std::filesystem::exists(std::filesystem::path(model_dir) / "tokenizer.json")) {
+            codec = std::make_unique<llaisys::server::TokenizerCodec>(model_dir);
+        } else {
+            std::cerr << "no tokenizer.json in " << model_dir << "; serving token ids only" << std::endl;
+        }
+        llaisys::server::OpenAIApi api(scheduler, model_name.empty() ? "llaisys" : model_name, std::move(codec),
+                                       adapter_names);
+        llaisys::server::HttpServer server(
+            [&api](const llaisys::server::HttpRequest &request, llaisys::server::HttpResponse &response) {
+                api.handle(request, response);
+            });
+
+        const int bound = server.listen(host, port);
+        g_server = &server;
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        std::cout << "llaisys server listening on http://" << host << ":" << bound << std::endl;
+        server.serve();
+        g_server = nullptr;
+        std::cout << "llaisys server stopped" << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << "llaisys server: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,426 @@
+#include "openai.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace llaisys::server {
+
+namespace {
+
+// Request-level failure reported to the client with an HTTP status.
+struct ApiError : std::runtime_error {
+    int status;
+    ApiError(int status_, const std::string &message) : std::runtime_error(message), status(status_) {}
+};
+
+std::string errorBody(const std::string &message, const char *type) {
+    Json error = Json::object();
+    error["message"] = message;
+    error["type"] = type;
+    Json body = Json::object();
+    body["error"] = std::move(error);
+    return body.dump();
+}
+
+Json tokenArray(const std::vector<int64_t> &tokens) {
+    Json arr = Json::array();
+    for (int64_t token : tokens) {
+        arr.push(token);
+    }
+    return arr;
+}
+
+std::vector<int64_t> parseTokenIds(const Json &value) {
+    std::vector<int64_t> tokens;
+    for (const auto &item : value.asArray()) {
+        tokens.push_back(item.asInt());
+    }
+    return tokens;
+}
+
+double numberOr(const Json &body, const char *key, double fallback) {
+    return body[key].isNumber() ? body[key].asNumber() : fallback;
+}
+
+Json metricsJson(const RequestMetrics &m) {
+    Json json = Json::object();
+    json["queue_ms"] = m.queueMs();
+    json["ttft_ms"] = m.ttftMs();
+    json["total_ms"] = m.totalMs();
+    json["decode_tokens_per_s"] = m.decodeTokensPerSecond();
+    return json;
+}
+
+Json usageJson(const RequestMetrics &m) {
+    Json usage = Json::object();
+    usage["prompt_tokens"] = static_cast<uint64_t>(m.prompt_tokens);
+    usage["completion_tokens"] = static_cast<uint64_t>(m.completion_tokens);
+    usage["total_tokens"] = static_cast<uint64_t>(m.prompt_tokens + m.completion_tokens);
+    return usage;
+}
+
+} // namespace
+
+TokenizerCodec::TokenizerCodec(const std::string &path) : _tokenizer(path), _vocabulary(_tokenizer.vocabSize()) {
+    for (size_t id = 0; id < _vocabulary.size(); id++) {
+        if (!_tokenizer.isSpecial(static_cast<int64_t>(id))) {
+            _vocabulary[id] = _tokenizer.tokenBytes(static_cast<int64_t>(id));
+        }
+    }
+}
+
+std::vector<int64_t> TokenizerCodec::encode(const std::string &text) {
+    return _tokenizer.encode(text);
+}
+
+std::string TokenizerCodec::decode(const std::vector<int64_t> &tokens) {
+    return _tokenizer.decode(tokens, true);
+}
+
+namespace {
+class DetokenizerStream : public TextStream {
+public:
+    explicit DetokenizerStream(const tokenizer::Tokenizer &tokenizer) : _detokenizer(tokenizer, true) {}
+
+    std::string push(const std::vector<int64_t> &tokens) override {
+        std::string text;
+        for (int64_t token : tokens) {
+            text += _detokenizer.push(token);
+        }
+        return text;
+    }
+
+    std::string flush() override {
+        return _detokenizer.flush();
+    }
+
+private:
+    tokenizer::Detokenizer _detokenizer;
+};
+} // namespace
+
+std::unique_ptr<TextStream> TokenizerCodec::stream() {
+    return std::make_unique<DetokenizerStream>(_tokenizer);
+}
+
+std::string TokenizerCodec::chatPrompt(const Json &messages) {
+    std::vector<tokenizer::ChatMessage> chat;
+    for (const auto &message : messages.asArray()) {
+        const Json &content = message["content"];
+        std::string text;
+        if (content.isString()) {
+            text = content.asString();
+        } else if (content.isArray()) {
+            // Content parts; only text parts are meaningful to this model.
+            for (const auto &part : content.asArray()) {
+                if (part["type"].isString() && part["type"].asString() == "text") {
+                    text += part["text"].asString();
+                }
+            }
+        } else {
+            throw std::invalid_argument("message content must be a string or an array of parts");
+        }
+        chat.push_back({message["role"].asString(), std::move(text)});
+    }
+    return _tokenizer.applyChatTemplate(chat, true);
+}
+
+OpenAIApi::OpenAIApi(Scheduler &scheduler, std::string model_name, std::unique_ptr<TextCodec> codec,
+                     std::vector<std::string> adapters)
+    : _scheduler(scheduler), _model_name(std::move(model_name)), _codec(std::move(codec)),
+      _adapters(std::move(adapters)) {}
+
+void OpenAIApi::handle(const HttpRequest &request, HttpResponse &response) {
+    try {
+        if (request.path == "/health") {
+            response.send(200, "application/json", "{\"status\":\"ok\"}");
+        } else if (request.path == "/metrics") {
+            response.send(200, "text/plain; version=0.0.4", _metricsText());
+        } else if (request.path == "/v1/models") {
+            Json body = Json::object();
+            body["object"] = "list";
+            body["data"] = Json::array();
+            std::vector<std::string> names{_model_name};
+            names.insert(names.end(), _adapters.begin(), _adapters.end());
+            for (const auto &name : names) {
+                Json model = Json::object();
+                model["id"] = name;
+                model["object"] = "model";
+                model["owned_by"] = "llaisys";
+                if (name != _model_name) {
+                    model["parent"] = _model_name;
+                }
+                body["data"].push(std::move(model));
+            }
+            response.send(200, "application/json", body.dump());
+        } else if (request.path == "/v1/completions" || request.path == "/v1/chat/completions") {
+            if (request.method != "POST") {
+                throw ApiError(405, "use POST");
+            }
+            Json body;
+            try {
+                body = Json::parse(request.body);
+            } catch (const std::invalid_argument &e) {
+                throw ApiError(400, e.what());
+            }
+            if (!body.isObject()) {
+                throw ApiError(400, "request body must be a JSON object");
+            }
+            _generate(body, request.path == "/v1/chat/completions", response);
+        } else {
+            throw ApiError(404, "no route for " + request.path);
+        }
+    } catch (const ApiError &e) {
+        if (!response.sent()) {
+            response.send(e.status, "application/json", errorBody(e.what(), "invalid_request_error"));
+        }
+    } catch (const std::invalid_argument &e) {
+        if (!response.sent()) {
+            response.send(400, "application/json", errorBody(e.what(), "invalid_request_error"));
+        }
+    }
+}
+
+std::shared_ptr<const models::Grammar> OpenAIApi::_grammar(const Json &body) {
+    std::string pattern;
+    const Json &format = body["response_format"];
+    const std::string type = format["type"].isString() ? format["type"].asString() : "text";
+    if (type == "json_object") {
+        pattern = models::jsonSchemaToRegex("{\"type\": \"object\"}");
+    } else if (type == "json_schema") {
+        const Json &schema = format["json_schema"]["schema"];
+        pattern = models::jsonSchemaToRegex(schema.isNull() ? "{}" : schema.dump());
+    } else if (type != "text") {
+        throw ApiError(400, "unsupported response_format type '" + type + "'");
+    } else if (body.contains("guided_json")) {
+        const Json &schema = body["guided_json"];
+        pattern = models::jsonSchemaToRegex(schema.isString() ? schema.asString() : schema.dump());
+    } else if (body["guided_regex"].isString()) {
+        pattern = body["guided_regex"].asString();
+    } else {
+        return nullptr;
+    }
+    if (!_codec) {
+        throw ApiError(400, "structured output needs a tokenizer.json in the model directory");
+    }
+
+    std::lock_guard<std::mutex> lock(_grammar_mutex);
+    for (auto it = _grammars.begin(); it != _grammars.end(); ++it) {
+        if (it->first == pattern) {
+            _grammars.splice(_grammars.begin(), _grammars, it);
+            return it->second;
+        }
+    }
+    auto grammar = models::Grammar::fromRegex(pattern, _codec->vocabulary(), _scheduler.meta().end_token);
+    _grammars.emplace_front(std::move(pattern), grammar);
+    if (_grammars.size() > GRAMMAR_CACHE_SIZE) {
+        _grammars.pop_back();
+    }
+    return grammar;
+}
+
+Json OpenAIApi::_choice(bool chat, const std::string &text, const std::vector<int64_t> &tokens, const char *finish_reason,
+                        bool delta) const {
+    Json choice = Json::object();
+    choice["index"] = 0;
+    if (!chat) {
+        choice["text"] = text;
+        choice["logprobs"] = nullptr;
+    } else if (delta) {
+        choice["delta"] = Json::object();
+        if (!tokens.empty() || !text.empty()) {
+            choice["delta"]["content"] = text;
+        }
+    } else {
+        choice["message"] = Json::object();
+        choice["message"]["role"] = "assistant";
+        choice["message"]["content"] = text;
+    }
+    choice["token_ids"] = tokenArray(tokens);
+    choice["finish_reason"] = finish_reason ? Json(finish_reason) : Json();
+    return choice;
+}
+
+void OpenAIApi::_generate(const Json &body, bool chat, HttpResponse &response) {
+    const auto &meta = _scheduler.meta();
+    GenerationParams params;
+    if (chat) {
+        if (!_codec) {
+            throw ApiError(400, "chat completions need a tokenizer.json in the model directory");
+        }
+        if (!body["messages"].isArray()) {
+            throw ApiError(400, "'messages' must be an array");
+        }
+        params.prompt = _codec->encode(_codec->chatPrompt(body["messages"]));
+    } else {
+        const Json &prompt = body["prompt"];
+        if (prompt.isString() || (prompt.isArray() && prompt.size() == 1 && prompt[0].isString())) {
+            if (!_codec) {
+                throw ApiError(400, "text prompts need a tokenizer; send 'prompt' as an array of token ids");
+            }
+            params.prompt = _codec->encode(prompt.isString() ? prompt.asString() : prompt[0].asString());
+        } else if (prompt.isArray() && (prompt.size() == 0 || prompt[0].isNumber())) {
+            params.prompt = parseTokenIds(prompt);
+        } else {
+            throw ApiError(400, "'prompt' must be a string or an array of token ids; send batches as separate requests");
+        }
+    }
+    for (int64_t token : params.prompt) {
+        if (token < 0 || static_cast<size_t>(token) >= meta.voc) {
+            throw ApiError(400, "prompt token id out of range");
+        }
+    }
+    if (body["n"].isNumber() && body["n"].asInt() != 1) {
+        throw ApiError(400, "only n = 1 is supported");
+    }
+
+    const char *max_key = chat && body.contains("max_completion_tokens") ? "max_completion_tokens" : "max_tokens";
+    const size_t room = params.prompt.size() < meta.maxseq ? meta.maxseq - params.prompt.size() : 0;
+    if (body[max_key].isNumber()) {
+        const int64_t max_tokens = body[max_key].asInt();
+        if (max_tokens <= 0) {
+            throw ApiError(400, std::string("'") + max_key + "' must be positive");
+        }
+        params.max_tokens = static_cast<size_t>(max_tokens);
+    } else {
+        params.max_tokens = chat ? room : 16;
+    }
+    params.sampling.temperature = static_cast<float>(numberOr(body, "temperature", 1.0));
+    params.sampling.top_p = static_cast<float>(numberOr(body, "top_p", 1.0));
+    params.sampling.top_k = static_cast<int>(numberOr(body, "top_k", 0));
+    params.sampling.seed = body["seed"].isNumber() ? static_cast<uint64_t>(body["seed"].asInt()) : std::random_device{}();
+    params.ignore_eos = body["ignore_eos"].isBool() && body["ignore_eos"].asBool();
+    params.sampling.grammar = _grammar(body);
+    std::string model_name = _model_name;
+    if (body["model"].isString() && body["model"].asString() != _model_name) {
+        const auto it = std::find(_adapters.begin(), _adapters.end(), body["model"].asString());
+        if (it != _adapters.end()) {
+            params.adapter = static_cast<int64_t>(it - _adapters.begin());
+            model_name = *it;
+        } else if (!_adapters.empty()) {
+            throw ApiError(404, "model '" + body["model"].asString() + "' not found");
+        }
+    }
+    const bool stream = body["stream"].isBool() && body["stream"].asBool();
+    const bool include_usage = body["stream_options"]["include_usage"].isBool() && body["stream_options"]["include_usage"].asBool();
+
+    auto request = _scheduler.submit(std::move(params));
+    if (!request) {
+        throw ApiError(429, "server is at capacity, retry later");
+    }
+
+    const std::string id = (chat ? "chatcmpl-" : "cmpl-") + std::to_string(request->id());
+    const int64_t created = static_cast<int64_t>(std::time(nullptr));
+    auto envelope = [&](const char *object) {
+        Json json = Json::object();
+        json["id"] = id;
+        json["object"] = object;
+        json["created"] = created;
+        json["model"] = model_name;
+        json["choices"] = Json::array();
+        return json;
+    };
+    const char *chunk_object = chat ? "chat.completion.chunk" : "text_completion";
+
+    std::vector<int64_t> tokens;
+    // Streamed chunks carry only complete UTF-8; bytes of a character still
+    // being generated wait for the next chunk.
+    auto text_stream = stream && _codec ? _codec->stream() : nullptr;
+    if (stream) {
+        response.beginEvents();
+        bool connected = true;
+        if (chat) {
+            Json first = envelope(chunk_object);
+            Json choice = _choice(true, {}, {}, nullptr, true);
+            choice["delta"]["role"] = "assistant";
+            first["choices"].push(std::move(choice));
+            connected = response.sendEvent(first.dump());
+        }
+        std::vector<int64_t> fresh;
+        while (connected && request->wait(fresh)) {
+            if (fresh.empty()) {
+                continue;
+            }
+            Json chunk = envelope(chunk_object);
+            chunk["choices"].push(_choice(chat, text_stream ? text_stream->push(fresh) : std::string(), fresh, nullptr, true));
+            connected = response.sendEvent(chunk.dump());
+            tokens.insert(tokens.end(), fresh.begin(), fresh.end());
+            fresh.clear();
+        }
+        if (!connected) {
+            request->cancel();
+            while (request->wait(fresh)) {
+            }
+        }
+    } else {
+        while (request->wait(tokens)) {
+        }
+    }
+
+    const auto reason = request->finishReason();
+    const auto metrics = request->metrics();
+    std::cerr << "[server] " << id << " prompt=" << metrics.prompt_tokens << " completion=" << metrics.completion_tokens
+              << " queue_ms=" << metrics.queueMs() << " ttft_ms=" << metrics.ttftMs() << " total_ms=" << metrics.totalMs()
+              << " decode_tok/s=" << metrics.decodeTokensPerSecond() << " finish=" << finishReasonName(reason) << std::endl;
+
+    if (reason == FinishReason::Cancelled) {
+        return;
+    }
+    if (reason == FinishReason::Error) {
+        if (stream) {
+            response.sendEvent(errorBody(request->error(), "server_error"));
+            response.sendEvent("[DONE]");
+        } else {
+            response.send(500, "application/json", errorBody(request->error(), "server_error"));
+        }
+        return;
+    }
+
+    if (stream) {
+        Json last = envelope(chunk_object);
+        last["choices"].push(_choice(chat, text_stream ? text_stream->flush() : std::string(), {}, finishReasonName(reason), true));
+        last["metrics"] = metricsJson(metrics);
+        response.sendEvent(last.dump());
+        if (include_usage) {
+            Json usage = envelope(chunk_object);
+            usage["usage"] = usageJson(metrics);
+            response.sendEvent(usage.dump());
+        }
+        response.sendEvent("[DONE]");
+    } else {
+        Json result = envelope(chat ? "chat.completion" : "text_completion");
+        result["choices"].push(_choice(chat, _codec ? _codec->decode(tokens) : std::string(), tokens, finishReasonName(reason), false));
+        result["usage"] = usageJson(metrics);
+        result["metrics"] = metricsJson(metrics);
+        response.send(200, "application/json", result.dump());
+    }
+}
+
+std::string OpenAIApi::_metricsText() const {
+    const auto stats = _scheduler.stats();
+    std::ostringstream out;
+    auto metric = [&](const char *name, const char *type, double value) {
+        out << "# TYPE llaisys_" << name << " " << type << "\n"
+            << "llaisys_" << name << " " << value << "\n";
+    };
+    metric("requests_submitted_total", "counter", static_cast<double>(stats.submitted));
+    metric("requests_rejected_total", "counter", static_cast<double>(stats.rejected));
+    metric("requests_finished_total", "counter", static_cast<double>(stats.finished));
+    metric("requests_waiting", "gauge", static_cast<double>(stats.waiting));
+    metric("requests_running", "gauge", static_cast<double>(stats.running));
+    metric("prompt_tokens_total", "counter", static_cast<double>(stats.prompt_tokens));
+    metric("generation_tokens_total", "counter", static_cast<double>(stats.generated_tokens));
+    metric("engine_steps_total", "counter", static_cast<double>(stats.steps));
+    metric("engine_step_sequences_total", "counter", static_cast<double>(stats.step_sequences));
+    metric("kv_blocks_total", "gauge", static_cast<double>(stats.kv_total_blocks));
+    metric("kv_blocks_reserved", "gauge", static_cast<double>(stats.kv_reserved_blocks));
+    metric("kv_blocks_free", "gauge", static_cast<double>(stats.kv_free_blocks));
+    return out.str();
+}
+
+} // namespace llaisys::server
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "http.hpp"
+#include "../utils/json.hpp"
+#include "scheduler.hpp"
+
+#include "../models/sampling/grammar.hpp"
+#include "../tokenizer/tokenizer.hpp"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llaisys::server {
+
+using utils::Json;
+
+// Incremental decoder for one streamed choice; see tokenizer::Detokenizer.
+class TextStream {
+public:
+    virtual ~TextStream() = default;
+    // Text completed by `tokens`; a character split across tokens is held back.
+    virtual std::string push(const std::vector<int64_t> &tokens) = 0;
+    virtual std::string flush() = 0;
+};
+
+// Text side of the API. Without a codec the server still works on token ids:
+// completions accept `prompt` as an array of ids and every choice carries
+// `token_ids` next to its text.
+class TextCodec {
+public:
+    virtual ~TextCodec() = default;
+    virtual std::vector<int64_t> encode(const std::string &text) = 0;
+    virtual std::string decode(const std::vector<int64_t> &tokens) = 0;
+    virtual std::unique_ptr<TextStream> stream() = 0;
+    // Bytes of every token id, empty for special tokens; what grammars are compiled against.
+    virtual const std::vector<std::string> &vocabulary() = 0;
+    // Render chat `messages` ([{role, content}]) into a prompt ending with the assistant turn.
+    virtual std::string chatPrompt(const Json &messages) = 0;
+};
+
+// TextCodec backed by the native tokenizer of the model directory.
+class TokenizerCodec : public TextCodec {
+public:
+    explicit TokenizerCodec(const std::string &path);
+
+    std::vector<int64_t> encode(const std::string &text) override;
+    std::string decode(const std::vector<int64_t> &tokens) override;
+    std::unique_ptr<TextStream> stream() override;
+    const std::vector<std::string> &vocabulary() override { return _vocabulary; }
+    std::string chatPrompt(const Json &messages) override;
+
+private:
+    tokenizer::Tokenizer _tokenizer;
+    std::vector<std::string> _vocabulary;
+};
+
+// OpenAI-compatible routes on top of the scheduler:
+//   POST /v1/completions, POST /v1/chat/completions (both with "stream": true for SSE),
+//   GET /v1/models, GET /health, GET /metrics (Prometheus text format).
+// "model" selects a LoRA adapter by name (slot i is `adapters[i]`); the base
+// model answers to `model_name`, and to any name when no adapters are loaded.
+// Structured output: "response_format" ({"type": "json_object"} or
+// {"type": "json_schema", "json_schema": {"schema": ...}}), or the
+// "guided_json" / "guided_regex" extensions.
+class OpenAIApi {
+public:
+    OpenAIApi(Scheduler &scheduler, std::string model_name, std::unique_ptr<TextCodec> codec = nullptr,
+              std::vector<std::string> adapters = {});
+
+    void handle(const HttpRequest &request, HttpResponse &response);
+
+private:
+    Scheduler &_scheduler;
+    std::string _model_name;
+    std::unique_ptr<TextCodec> _codec;
+    std::vector<std::string> _adapters;
+
+    // Recently compiled grammars, most recent first, keyed by their regex.
+    static constexpr size_t GRAMMAR_CACHE_SIZE = 16;
+    std::mutex _grammar_mutex;
+    std::list<std::pair<std::string, std::shared_ptr<const models::Grammar>>> _grammars;
+
+    std::shared_ptr<const models::Grammar> _grammar(const Json &body);
+    void _generate(const Json &body, bool chat, HttpResponse &response);
+    Json _choice(bool chat, const std::string &text, const std::vector<int64_t> &tokens, const char *finish_reason,
+                 bool delta) const;
+    std::string _metricsText() const;
+};
+
+} // namespace llaisys::server
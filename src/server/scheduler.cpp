@@ -0,0 +1,303 @@
+#include "scheduler.hpp"
+
+#include "../utils.hpp"
+
+#include <algorithm>
+
+namespace llaisys::server {
+
+const char *finishReasonName(FinishReason reason) {
+    switch (reason) {
+    case FinishReason::Stop: return "stop";
+    case FinishReason::Length: return "length";
+    case FinishReason::Cancelled: return "cancelled";
+    case FinishReason::Error: return "error";
+    default: return nullptr;
+    }
+}
+
+namespace {
+double millis(RequestMetrics::Clock::time_point from, RequestMetrics::Clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+} // namespace
+
+double RequestMetrics::queueMs() const {
+    return millis(arrival, admitted);
+}
+
+double RequestMetrics::ttftMs() const {
+    return millis(arrival, first_token);
+}
+
+double RequestMetrics::totalMs() const {
+    return millis(arrival, finished);
+}
+
+double RequestMetrics::decodeTokensPerSecond() const {
+    const double ms = millis(first_token, finished);
+    return completion_tokens > 1 && ms > 0.0 ? (completion_tokens - 1) * 1000.0 / ms : 0.0;
+}
+
+Request::Request(uint64_t id, GenerationParams params, size_t max_tokens)
+    : _id(id), _params(std::move(params)), _tokens(max_tokens) {
+    _metrics.arrival = RequestMetrics::Clock::now();
+    _metrics.prompt_tokens = _params.prompt.size();
+}
+
+void Request::_push(int64_t token) {
+    if (_metrics.completion_tokens++ == 0) {
+        _metrics.first_token = RequestMetrics::Clock::now();
+    }
+    const bool pushed = _tokens.tryPush(token);
+    ASSERT(pushed, "Request: more tokens than max_tokens");
+}
+
+void Request::_finish(FinishReason reason, const std::string &error) {
+    _metrics.finished = RequestMetrics::Clock::now();
+    if (_metrics.completion_tokens == 0) {
+        _metrics.first_token = _metrics.finished;
+    }
+    _finish_reason = reason;
+    _error = error;
+    _tokens.close();
+}
+
+Scheduler::Scheduler(models::Qwen2 &model, const Config &config) : _model(model), _config(config) {
+    CHECK_ARGUMENT(config.max_running > 0, "Scheduler: max_running must be positive");
+    CHECK_ARGUMENT(config.max_step_tokens > 0, "Scheduler: max_step_tokens must be positive");
+    auto &cache = _model.cache();
+    const size_t per_seq = cache.numBlocksFor(_model.meta().maxseq);
+    const size_t kv_blocks = _config.kv_blocks > 0 ? _config.kv_blocks : per_seq * _config.max_running;
+    cache.growMaxBlocks(kv_blocks);
+    _kv_total_blocks = cache.config().max_blocks;
+    _counters.kv_total_blocks = _kv_total_blocks;
+    _counters.kv_free_blocks = cache.numFreeBlocks();
+    _stats = _counters;
+    _engine = std::thread([this] { _loop(); });
+}
+
+Scheduler::~Scheduler() {
+    _incoming.close();
+    _engine.join();
+    // Submissions that raced with shutdown.
+    for (std::shared_ptr<Request> request; _incoming.pop(request);) {
+        request->_finish(FinishReason::Cancelled, "server shutting down");
+    }
+}
+
+size_t Scheduler::_blocksFor(const GenerationParams &params) const {
+    const size_t len = std::min(params.prompt.size() + params.max_tokens, _model.meta().maxseq);
+    return _model.cache().numBlocksFor(len);
+}
+
+std::shared_ptr<Request> Scheduler::submit(GenerationParams params) {
+    CHECK_ARGUMENT(!params.prompt.empty(), "prompt must not be empty");
+    CHECK_ARGUMENT(params.prompt.size() < _model.meta().maxseq, "prompt exceeds the model context length");
+    CHECK_ARGUMENT(params.max_tokens > 0, "max_tokens must be positive");
+    CHECK_ARGUMENT(params.adapter < static_cast<int64_t>(_model.loraAdapters()), "unknown LoRA adapter");
+    CHECK_ARGUMENT(_blocksFor(params) <= _kv_total_blocks, "request does not fit into the KV cache");
+
+    if (_queued.fetch_add(1) >= _config.max_waiting) {
+        _queued.fetch_sub(1);
+        _rejected.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    // Generation stops at maxseq, which bounds the tokens a request can hold.
+    const size_t max_tokens = std::min(params.max_tokens, _model.meta().maxseq - params.prompt.size());
+    std::shared_ptr<Request> request(new Request(_next_id.fetch_add(1), std::move(params), max_tokens));
+    _incoming.push(request);
+    return request;
+}
+
+SchedulerStats Scheduler::stats() const {
+    SchedulerStats stats;
+    {
+        std::lock_guard<std::mutex> lock(_stats_mutex);
+        stats = _stats;
+    }
+    stats.submitted = _next_id.load(std::memory_order_relaxed);
+    stats.rejected = _rejected.load(std::memory_order_relaxed);
+    stats.waiting = _queued.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void Scheduler::_publishStats() {
+    _counters.running = _running.size();
+    _counters.kv_reserved_blocks = _reserved_blocks;
+    _counters.kv_free_blocks = _model.cache().numFreeBlocks();
+    std::lock_guard<std::mutex> lock(_stats_mutex);
+    _stats = _counters;
+}
+
+void Scheduler::_drop(const std::shared_ptr<Request> &request, const std::string &error) {
+    request->_finish(FinishReason::Cancelled, error);
+    _queued.fetch_sub(1);
+    _counters.finished++;
+}
+
+void Scheduler::_loop() {
+    while (true) {
+        if (_waiting.empty() && _running.empty()) {
+            _incoming.wait();
+        }
+        if (_incoming.closed()) {
+            break;
+        }
+        for (std::shared_ptr<Request> request; _incoming.pop(request);) {
+            _waiting.push_back(std::move(request));
+        }
+        _admit();
+        _step();
+    }
+
+    for (auto &r : _running) {
+        _retire(r, FinishReason::Cancelled, "server shutting down");
+    }
+    _running.clear();
+    for (std::shared_ptr<Request> request; _incoming.pop(request);) {
+        _waiting.push_back(std::move(request));
+    }
+    for (auto &request : _waiting) {
+        _drop(request, "server shutting down");
+    }
+    _waiting.clear();
+    _publishStats();
+}
+
+void Scheduler::_admit() {
+    while (!_waiting.empty() && _running.size() < _config.max_running) {
+        auto &request = _waiting.front();
+        if (request->cancelled()) {
+            _drop(request);
+            _waiting.pop_front();
+            continue;
+        }
+        const size_t blocks = _blocksFor(request->params());
+        if (_reserved_blocks + blocks > _kv_total_blocks) {
+            break; // FIFO: wait until enough running requests finish
+        }
+        request->_metrics.admitted = RequestMetrics::Clock::now();
+        Running r{request, _model.cache().createSequence(), models::Sampler(request->params().sampling)};
+        r.reserved_blocks = blocks;
+        _reserved_blocks += blocks;
+        _running.push_back(std::move(r));
+        _waiting.pop_front();
+        _queued.fetch_sub(1);
+    }
+}
+
+void Scheduler::_retire(Running &r, FinishReason reason, const std::string &error) {
+    _model.cache().freeSequence(r.seq);
+    _reserved_blocks -= r.reserved_blocks;
+    r.request->_finish(reason, error);
+    _counters.finished++;
+}
+
+bool Scheduler::_emit(Running &r, int64_t token) {
+    r.generated++;
+    r.request->_push(token);
+    const auto &params = r.request->params();
+    if (!params.ignore_eos && token == _model.meta().end_token) {
+        _retire(r, FinishReason::Stop);
+        return false;
+    }
+    if (r.generated >= params.max_tokens || _model.cache().length(r.seq) + 1 >= _model.meta().maxseq) {
+        _retire(r, FinishReason::Length);
+        return false;
+    }
+    r.pending = token;
+    return true;
+}
+
+void Scheduler::_step() {
+    // Requests whose client went away free their slot before the next forward.
+    std::vector<Running> live;
+    for (auto &r : _running) {
+        if (r.request->cancelled()) {
+            _retire(r, FinishReason::Cancelled);
+        } else {
+            live.push_back(std::move(r));
+        }
+    }
+    _running.swap(live);
+
+    // Decode tokens first, then fill the rest of the token budget with prefill chunks.
+    std::vector<models::Qwen2::Chunk> chunks;
+    std::vector<size_t> owners;
+    size_t budget = _config.max_step_tokens;
+    for (size_t i = 0; i < _running.size(); i++) {
+        auto &r = _running[i];
+        if (r.pending >= 0) {
+            chunks.push_back({r.seq, &r.pending, 1, false, r.request->params().adapter});
+            owners.push_back(i);
+            budget -= std::min<size_t>(budget, 1);
+        }
+    }
+    size_t prefill_tokens = 0;
+    for (size_t i = 0; i < _running.size(); i++) {
+        auto &r = _running[i];
+        const auto &prompt = r.request->params().prompt;
+        if (r.pending >= 0 || (budget == 0 && !chunks.empty())) {
+            continue;
+        }
+        const size_t n = std::min(prompt.size() - r.prefilled, std::max<size_t>(budget, 1));
+        chunks.push_back({r.seq, prompt.data() + r.prefilled, n, false, r.request->params().adapter});
+        owners.push_back(i);
+        budget -= std::min(budget, n);
+        prefill_tokens += n;
+    }
+    if (chunks.empty()) {
+        _publishStats();
+        return;
+    }
+
+    size_t generated = 0;
+    try {
+        auto logits = _model.forward(chunks);
+        std::vector<float> row;
+        std::vector<bool> done(_running.size(), false);
+        for (size_t c = 0; c < chunks.size(); c++) {
+            auto &r = _running[owners[c]];
+            if (r.pending < 0) {
+                r.prefilled += chunks[c].ntoken;
+                if (r.prefilled < r.request->params().prompt.size()) {
+                    continue;
+                }
+            }
+            _model.logitsRow(logits, c, row);
+            generated++;
+            done[owners[c]] = !_emit(r, r.sampler.sample(row.data(), row.size()));
+        }
+        live.clear();
+        for (size_t i = 0; i < _running.size(); i++) {
+            if (!done[i]) {
+                live.push_back(std::move(_running[i]));
+            }
+        }
+        _running.swap(live);
+    } catch (const std::exception &e) {
+        // The batch is in an unknown state; fail everything that took part in it.
+        std::vector<bool> failed(_running.size(), false);
+        for (size_t i : owners) {
+            failed[i] = true;
+        }
+        live.clear();
+        for (size_t i = 0; i < _running.size(); i++) {
+            if (failed[i]) {
+                _retire(_running[i], FinishReason::Error, e.what());
+            } else {
+                live.push_back(std::move(_running[i]));
+            }
+        }
+        _running.swap(live);
+    }
+
+    _counters.steps++;
+    _counters.step_sequences += chunks.size();
+    _counters.prompt_tokens += prefill_tokens;
+    _counters.generated_tokens += generated;
+    _publishStats();
+}
+
+} // namespace llaisys::server
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "../models/qwen2/qwen2.hpp"
+#include "../utils/channel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace llaisys::server {
+
+struct GenerationParams {
+    std::vector<int64_t> prompt;
+    size_t max_tokens = 16;
+    models::SamplingConfig sampling;
+    bool ignore_eos = false;
+    int64_t adapter = -1; // LoRA slot, -1 for the base model
+};
+
+enum class FinishReason {
+    None,
+    Stop,      // end token
+    Length,    // max_tokens or maxseq
+    Cancelled, // client went away
+    Error,
+};
+
+const char *finishReasonName(FinishReason reason);
+
+struct RequestMetrics {
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point arrival;
+    Clock::time_point admitted;
+    Clock::time_point first_token;
+    Clock::time_point finished;
+    size_t prompt_tokens = 0;
+    size_t completion_tokens = 0;
+
+    double queueMs() const;
+    double ttftMs() const; // arrival to first token
+    double totalMs() const;
+    // Decode throughput after the first token.
+    double decodeTokensPerSecond() const;
+};
+
+// One submitted generation. The scheduler thread appends tokens to a lock-free
+// ring sized for max_tokens, so it never waits on the reader; the HTTP thread
+// drains them with wait() and may cancel at any time.
+class Request {
+public:
+    uint64_t id() const { return _id; }
+    const GenerationParams &params() const { return _params; }
+
+    // Block until new tokens arrive or the request finishes. Appends new tokens
+    // to `out`; returns false once the request has finished and been drained.
+    bool wait(std::vector<int64_t> &out) { return _tokens.wait(out); }
+    void cancel() { _cancelled = true; }
+    bool cancelled() const { return _cancelled; }
+
+    // Valid once wait() has returned false.
+    FinishReason finishReason() const { return _finish_reason; }
+    const std::string &error() const { return _error; }
+    const RequestMetrics &metrics() const { return _metrics; }
+
+private:
+    friend class Scheduler;
+
+    Request(uint64_t id, GenerationParams params, size_t max_tokens);
+
+    void _push(int64_t token);
+    void _finish(FinishReason reason, const std::string &error = "");
+
+    const uint64_t _id;
+    const GenerationParams _params;
+    std::atomic<bool> _cancelled{false};
+
+    utils::SpscChannel<int64_t> _tokens;
+    // Written by the scheduler thread only, published by closing _tokens.
+    FinishReason _finish_reason = FinishReason::None;
+    std::string _error;
+    RequestMetrics _metrics;
+};
+
+struct SchedulerStats {
+    size_t waiting = 0;
+    size_t running = 0;
+    uint64_t submitted = 0;
+    uint64_t rejected = 0;
+    uint64_t finished = 0;
+    uint64_t prompt_tokens = 0;
+    uint64_t generated_tokens = 0;
+    uint64_t steps = 0;
+    uint64_t step_sequences = 0; // sum of batch sizes over all steps
+    size_t kv_total_blocks = 0;
+    size_t kv_reserved_blocks = 0;
+    size_t kv_free_blocks = 0;
+};
+
+// Continuous-batching scheduler. A single engine thread owns the model; every
+// step it runs one forward over all running sequences (one decode token each)
+// plus as much chunked prefill of newly admitted requests as `max_step_tokens`
+// allows, so long prompts do not stall running streams.
+//
+// Admission control: a request is admitted only while the running set has
+// room and the KV pool can hold its worst case (prompt + max_tokens), so
+// admitted requests never need to be preempted. Waiting requests are kept in
+// FIFO order; submissions beyond `max_waiting` are rejected.
+//
+// Submitting threads and the engine share no lock: requests arrive through a
+// lock-free MPSC queue the engine sleeps on when idle, and tokens leave
+// through each request's SPSC ring.
+class Scheduler {
+public:
+    struct Config {
+        size_t max_running = 8;
+        size_t max_waiting = 64;
+        size_t max_step_tokens = 512;
+        size_t kv_blocks = 0; // KV pool size in blocks; 0 = room for max_running full sequences
+    };
+
+    Scheduler(models::Qwen2 &model, const Config &config);
+    ~Scheduler();
+
+    Scheduler(const Scheduler &) = delete;
+    Scheduler &operator=(const Scheduler &) = delete;
+
+    // Queue a request. Returns null when the queue is full. Throws std::invalid_argument
+    // for requests that could never be admitted. Any thread.
+    std::shared_ptr<Request> submit(GenerationParams params);
+    // Snapshot as of the last engine step. Any thread.
+    SchedulerStats stats() const;
+    const LlaisysQwen2Meta &meta() const { return _model.meta(); }
+
+private:
+    struct Running {
+        std::shared_ptr<Request> request;
+        models::KVCache::seq_t seq;
+        models::Sampler sampler;
+        size_t prefilled = 0;
+        int64_t pending = -1; // sampled token still to be fed, -1 during prefill
+        size_t generated = 0;
+        size_t reserved_blocks = 0;
+    };
+
+    models::Qwen2 &_model;
+    Config _config;
+
+    utils::MpscQueue<std::shared_ptr<Request>> _incoming; // closed to stop the engine
+    std::atomic<size_t> _queued{0}; // submitted but not yet admitted or dropped
+    std::atomic<uint64_t> _next_id{0};
+    std::atomic<uint64_t> _rejected{0};
+    size_t _kv_total_blocks = 0;
+
+    // Copied from _counters by the engine once per step.
+    mutable std::mutex _stats_mutex;
+    SchedulerStats _stats;
+
+    // Engine thread only
+    std::deque<std::shared_ptr<Request>> _waiting;
+    std::vector<Running> _running;
+    size_t _reserved_blocks = 0;
+    SchedulerStats _counters;
+    std::thread _engine;
+
+    size_t _blocksFor(const GenerationParams &params) const;
+    void _drop(const std::shared_ptr<Request> &request, const std::string &error = "");
+    void _publishStats();
+    void _loop();
+    void _admit();
+    void _step();
+    // Hand a sampled token to its request; returns false when the request is done.
+    bool _emit(Running &r, int64_t token);
+    void _retire(Running &r, FinishReason reason, const std::string &error = "");
+};
+
+} // namespace llaisys::server
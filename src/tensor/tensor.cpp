@@ -37,6 +37,33 @@ tensor_t Tensor::create(const std::vector<size_t> &shape,
     }
 }
 
+tensor_t Tensor::createHost(const std::vector<size_t> &shape, llaisysDataType_t dtype) {
+    size_t ndim_ = shape.size();
+    std::vector<ptrdiff_t> strides(ndim_);
+    size_t stride = 1;
+    for (size_t i = 1; i <= ndim_; i++) {
+        strides[ndim_ - i] = stride;
+        stride *= shape[ndim_ - i];
+    }
+    TensorMeta meta{dtype, shape, strides};
+    auto storage = core::context().runtime().allocateHostStorage(stride * utils::dsize(dtype));
+    return std::shared_ptr<Tensor>(new Tensor(meta, storage));
+}
+
+tensor_t Tensor::wrap(const std::vector<size_t> &shape, llaisysDataType_t dtype, std::byte *memory) {
+    size_t ndim_ = shape.size();
+    std::vector<ptrdiff_t> strides(ndim_);
+    size_t stride = 1;
+    for (size_t i = 1; i <= ndim_; i++) {
+        strides[ndim_ - i] = stride;
+        stride *= shape[ndim_ - i];
+    }
+    TensorMeta meta{dtype, shape, strides};
+    core::context().setDevice(LLAISYS_DEVICE_CPU, 0);
+    auto storage = core::context().runtime().wrapHostStorage(memory, stride * utils::dsize(dtype));
+    return std::shared_ptr<Tensor>(new Tensor(meta, storage));
+}
+
 std::byte *Tensor::data() {
     return _storage->memory() + _offset;
 }
@@ -154,11 +181,14 @@ void Tensor::debug() const {
     if (this->deviceType() == LLAISYS_DEVICE_CPU) {
         debug_print(this->data(), this->shape(), this->strides(), this->dtype());
     } else {
-        auto tmp_tensor = create({this->_storage->size()}, this->dtype());
+        // Everything from the first element to the end of the storage, so
+        // strided views read the same layout on the host.
+        const size_t bytes = _storage->size() - _offset;
+        auto tmp_tensor = createHost({bytes}, LLAISYS_DTYPE_BYTE);
         core::context().runtime().api()->memcpy_sync(
             tmp_tensor->data(),
             this->data(),
-            this->numel() * this->elementSize(),
+            bytes,
             LLAISYS_MEMCPY_D2H);
         debug_print(tmp_tensor->data(), this->shape(), this->strides(), this->dtype());
     }
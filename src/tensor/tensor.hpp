@@ -25,6 +25,11 @@ public:
         llaisysDataType_t dtype,
         llaisysDeviceType_t device_type = LLAISYS_DEVICE_CPU,
         int device = 0);
+    // Contiguous CPU tensor in pooled host staging memory of the current
+    // runtime's device (pinned where the device supports it), for transfers.
+    static tensor_t createHost(const std::vector<size_t> &shape, llaisysDataType_t dtype);
+    // Contiguous CPU tensor over caller-owned host memory, which must outlive it.
+    static tensor_t wrap(const std::vector<size_t> &shape, llaisysDataType_t dtype, std::byte *memory);
     ~Tensor() = default;
     // Info
     std::byte *data();
@@ -0,0 +1,599 @@
+#include "regex.hpp"
+
+#include "unicode.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace llaisys::tokenizer {
+
+namespace {
+
+uint32_t asciiLower(uint32_t cp) {
+    return (cp >= 'A' && cp <= 'Z') ? cp + ('a' - 'A') : cp;
+}
+
+uint32_t asciiSwapCase(uint32_t cp) {
+    if (cp >= 'A' && cp <= 'Z') {
+        return cp + ('a' - 'A');
+    }
+    if (cp >= 'a' && cp <= 'z') {
+        return cp - ('a' - 'A');
+    }
+    return cp;
+}
+
+struct Node {
+    enum class Kind {
+        Empty,
+        Char,
+        Class,
+        Any,
+        Begin,
+        End,
+        Concat,
+        Alt,
+        Repeat,
+        Look,
+    } kind;
+    uint32_t value = 0;   // code point or class index
+    bool flag = false;    // case-insensitive Char, lazy Repeat, negative Look
+    int min = 0, max = 0; // Repeat bounds; max < 0 is unbounded
+    std::vector<std::unique_ptr<Node>> children;
+
+    explicit Node(Kind k) : kind(k) {}
+};
+
+using NodePtr = std::unique_ptr<Node>;
+
+bool nullable(const Node &node) {
+    switch (node.kind) {
+    case Node::Kind::Empty:
+    case Node::Kind::Begin:
+    case Node::Kind::End:
+    case Node::Kind::Look:
+        return true;
+    case Node::Kind::Concat:
+        for (const auto &child : node.children) {
+            if (!nullable(*child)) {
+                return false;
+            }
+        }
+        return true;
+    case Node::Kind::Alt:
+        for (const auto &child : node.children) {
+            if (nullable(*child)) {
+                return true;
+            }
+        }
+        return false;
+    case Node::Kind::Repeat:
+        return node.min == 0 || nullable(*node.children[0]);
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+class RegexCompiler {
+public:
+    RegexCompiler(const std::string &pattern, Regex &re) : _pattern(pattern), _re(re) {
+        for (size_t i = 0; i < pattern.size();) {
+            uint32_t cp;
+            i += utf8Decode(pattern.data() + i, pattern.size() - i, cp);
+            _cps.push_back(cp);
+        }
+    }
+
+    void compile() {
+        NodePtr root = _parseAlt();
+        if (_pos != _cps.size()) {
+            _fail("unbalanced ')'");
+        }
+        _emit(*root);
+        _inst(Regex::Op::Match);
+        // Lookahead bodies live after the main program, each ending in Match.
+        for (size_t i = 0; i < _looks.size(); i++) {
+            _re._prog[_looks[i].first].x = _re._prog.size();
+            _emit(*_looks[i].second);
+            _inst(Regex::Op::Match);
+        }
+    }
+
+private:
+    const std::string &_pattern;
+    Regex &_re;
+    std::vector<uint32_t> _cps;
+    size_t _pos = 0;
+    bool _icase = false;
+    std::vector<std::pair<size_t, const Node *>> _looks;
+
+    [[noreturn]] void _fail(const std::string &what) const {
+        throw std::invalid_argument("regex: " + what + " in pattern " + _pattern);
+    }
+
+    bool _more() const { return _pos < _cps.size(); }
+    uint32_t _peek() const { return _cps[_pos]; }
+
+    bool _consume(uint32_t c) {
+        if (_more() && _peek() == c) {
+            _pos++;
+            return true;
+        }
+        return false;
+    }
+
+    bool _consume(const char *s) {
+        size_t p = _pos;
+        for (; *s; s++, p++) {
+            if (p >= _cps.size() || _cps[p] != static_cast<uint32_t>(*s)) {
+                return false;
+            }
+        }
+        _pos = p;
+        return true;
+    }
+
+    NodePtr _parseAlt() {
+        auto alt = std::make_unique<Node>(Node::Kind::Alt);
+        alt->children.push_back(_parseConcat());
+        while (_consume('|')) {
+            alt->children.push_back(_parseConcat());
+        }
+        if (alt->children.size() == 1) {
+            return std::move(alt->children[0]);
+        }
+        return alt;
+    }
+
+    NodePtr _parseConcat() {
+        auto concat = std::make_unique<Node>(Node::Kind::Concat);
+        while (_more() && _peek() != '|' && _peek() != ')') {
+            if (auto node = _parseRepeat()) {
+                concat->children.push_back(std::move(node));
+            }
+        }
+        if (concat->children.size() == 1) {
+            return std::move(concat->children[0]);
+        }
+        return concat;
+    }
+
+    int _parseInt() {
+        if (!_more() || _peek() < '0' || _peek() > '9') {
+            _fail("expected a number");
+        }
+        int value = 0;
+        while (_more() && _peek() >= '0' && _peek() <= '9') {
+            value = value * 10 + static_cast<int>(_cps[_pos++] - '0');
+            if (value > 1000) {
+                _fail("repetition count too large");
+            }
+        }
+        return value;
+    }
+
+    NodePtr _parseRepeat() {
+        NodePtr atom = _parseAtom();
+        if (!atom) {
+            return nullptr;
+        }
+        while (_more()) {
+            int min, max;
+            if (_consume('*')) {
+                min = 0, max = -1;
+            } else if (_consume('+')) {
+                min = 1, max = -1;
+            } else if (_consume('?')) {
+                min = 0, max = 1;
+            } else if (_peek() == '{') {
+                _pos++;
+                min = _parseInt();
+                max = min;
+                if (_consume(',')) {
+                    max = (_more() && _peek() == '}') ? -1 : _parseInt();
+                }
+                if (!_consume('}') || (max >= 0 && max < min)) {
+                    _fail("invalid {m,n} repetition");
+                }
+            } else {
+                break;
+            }
+            auto repeat = std::make_unique<Node>(Node::Kind::Repeat);
+            repeat->min = min;
+            repeat->max = max;
+            repeat->flag = _consume('?');
+            if (max < 0 && nullable(*atom)) {
+                _fail("unbounded repetition of an expression that can match empty");
+            }
+            repeat->children.push_back(std::move(atom));
+            atom = std::move(repeat);
+        }
+        return atom;
+    }
+
+    NodePtr _group() {
+        const bool saved = _icase;
+        NodePtr inner = _parseAlt();
+        if (!_consume(')')) {
+            _fail("missing ')'");
+        }
+        _icase = saved;
+        return inner;
+    }
+
+    NodePtr _parseAtom() {
+        const uint32_t c = _cps[_pos++];
+        switch (c) {
+        case '(': {
+            if (_consume("?:")) {
+                return _group();
+            }
+            if (_consume("?i:")) {
+                const bool saved = _icase;
+                _icase = true;
+                NodePtr inner = _group();
+                _icase = saved;
+                return inner;
+            }
+            if (_consume("?i)")) {
+                _icase = true; // until the end of the enclosing group
+                return nullptr;
+            }
+            if (_consume("?=") || _consume("?!")) {
+                auto look = std::make_unique<Node>(Node::Kind::Look);
+                look->flag = _cps[_pos - 1] == '!';
+                look->children.push_back(_group());
+                return look;
+            }
+            if (_more() && _peek() == '?') {
+                _fail("unsupported group syntax");
+            }
+            return _group();
+        }
+        case '[':
+            return _classNode(_parseClass());
+        case '.':
+            return std::make_unique<Node>(Node::Kind::Any);
+        case '^':
+            return std::make_unique<Node>(Node::Kind::Begin);
+        case '$':
+            return std::make_unique<Node>(Node::Kind::End);
+        case '\\': {
+            Regex::CharClass cls;
+            uint32_t literal;
+            if (_parseEscape(cls, literal)) {
+                return _classNode(std::move(cls));
+            }
+            return _charNode(literal);
+        }
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+            _fail("nothing to repeat");
+        default:
+            return _charNode(c);
+        }
+    }
+
+    NodePtr _charNode(uint32_t cp) {
+        auto node = std::make_unique<Node>(Node::Kind::Char);
+        node->value = _icase ? asciiLower(cp) : cp;
+        node->flag = _icase && asciiSwapCase(cp) != cp;
+        return node;
+    }
+
+    NodePtr _classNode(Regex::CharClass cls) {
+        cls.icase = _icase;
+        auto node = std::make_unique<Node>(Node::Kind::Class);
+        node->value = static_cast<uint32_t>(_re._classes.size());
+        _re._classes.push_back(std::move(cls));
+        return node;
+    }
+
+    // Parses the escape after '\'. Returns true and fills `cls` for class
+    // escapes, or returns false with a literal code point.
+    bool _parseEscape(Regex::CharClass &cls, uint32_t &literal) {
+        using Kind = Regex::ClassItem::Kind;
+        if (!_more()) {
+            _fail("trailing '\\'");
+        }
+        const uint32_t c = _cps[_pos++];
+        auto item = [&](Kind kind, bool negate, uint32_t lo, uint32_t hi = 0) {
+            cls.items.push_back({kind, negate, lo, hi});
+            return true;
+        };
+        switch (c) {
+        case 's': return item(Kind::Space, false, 0);
+        case 'S': return item(Kind::Space, true, 0);
+        case 'd': return item(Kind::Category, false, categoryBit(UnicodeCategory::Nd));
+        case 'D': return item(Kind::Category, true, categoryBit(UnicodeCategory::Nd));
+        case 'w':
+        case 'W': {
+            const uint32_t word = categoryMask("L") | categoryMask("M") | categoryBit(UnicodeCategory::Nd)
+                                | categoryBit(UnicodeCategory::Pc);
+            return item(Kind::Category, c == 'W', word);
+        }
+        case 'p':
+        case 'P': {
+            std::string name;
+            if (_consume('{')) {
+                while (_more() && _peek() != '}') {
+                    name += static_cast<char>(_cps[_pos++]);
+                }
+                if (!_consume('}')) {
+                    _fail("unterminated \\p{...}");
+                }
+            } else if (_more()) {
+                name = static_cast<char>(_cps[_pos++]);
+            }
+            const uint32_t m = categoryMask(name);
+            if (m == 0) {
+                _fail("unknown Unicode property " + name);
+            }
+            return item(Kind::Category, c == 'P', m);
+        }
+        case 'n': literal = '\n'; return false;
+        case 'r': literal = '\r'; return false;
+        case 't': literal = '\t'; return false;
+        case 'f': literal = '\f'; return false;
+        case 'v': literal = '\v'; return false;
+        case 'x': {
+            const bool braced = _consume('{');
+            uint32_t value = 0;
+            int digits = 0;
+            while (_more() && (braced || digits < 2)) {
+                const uint32_t h = _peek();
+                uint32_t d;
+                if (h >= '0' && h <= '9') {
+                    d = h - '0';
+                } else if ((h | 0x20) >= 'a' && (h | 0x20) <= 'f') {
+                    d = (h | 0x20) - 'a' + 10;
+                } else {
+                    break;
+                }
+                value = value * 16 + d;
+                digits++;
+                _pos++;
+            }
+            if (digits == 0 || (braced && !_consume('}')) || value > 0x10FFFF) {
+                _fail("invalid \\x escape");
+            }
+            literal = value;
+            return false;
+        }
+        default:
+            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+                _fail(std::string("unsupported escape \\") + static_cast<char>(c));
+            }
+            literal = c;
+            return false;
+        }
+    }
+
+    Regex::CharClass _parseClass() {
+        using Kind = Regex::ClassItem::Kind;
+        Regex::CharClass cls;
+        cls.negate = _consume('^');
+        bool first = true;
+        while (true) {
+            if (!_more()) {
+                _fail("unterminated character class");
+            }
+            uint32_t c = _cps[_pos++];
+            if (c == ']' && !first) {
+                break;
+            }
+            first = false;
+            if (c == '[') {
+                _fail("nested character classes are not supported");
+            }
+            if (c == '\\') {
+                Regex::CharClass sub;
+                if (_parseEscape(sub, c)) {
+                    cls.items.insert(cls.items.end(), sub.items.begin(), sub.items.end());
+                    continue;
+                }
+            }
+            uint32_t hi = c;
+            if (_pos + 1 < _cps.size() && _peek() == '-' && _cps[_pos + 1] != ']') {
+                _pos++;
+                hi = _cps[_pos++];
+                if (hi == '\\') {
+                    Regex::CharClass sub;
+                    if (_parseEscape(sub, hi)) {
+                        _fail("class escape as a range bound");
+                    }
+                }
+                if (hi < c) {
+                    _fail("inverted character range");
+                }
+            }
+            cls.items.push_back({Kind::Range, false, c, hi});
+        }
+        return cls;
+    }
+
+    size_t _inst(Regex::Op op, bool flag = false, uint32_t arg = 0, size_t x = 0, size_t y = 0) {
+        _re._prog.push_back({op, flag, arg, x, y});
+        return _re._prog.size() - 1;
+    }
+
+    void _emitRepeatTail(const Node &node) {
+        const Node &body = *node.children[0];
+        if (node.max < 0) {
+            const size_t split = _inst(Regex::Op::Split);
+            const size_t start = _re._prog.size();
+            _emit(body);
+            _inst(Regex::Op::Jump, false, 0, split);
+            const size_t out = _re._prog.size();
+            _re._prog[split].x = node.flag ? out : start;
+            _re._prog[split].y = node.flag ? start : out;
+            return;
+        }
+        std::vector<size_t> splits;
+        for (int i = node.min; i < node.max; i++) {
+            splits.push_back(_inst(Regex::Op::Split));
+            _emit(body);
+        }
+        const size_t out = _re._prog.size();
+        for (size_t split : splits) {
+            _re._prog[split].x = node.flag ? out : split + 1;
+            _re._prog[split].y = node.flag ? split + 1 : out;
+        }
+    }
+
+    void _emit(const Node &node) {
+        using Op = Regex::Op;
+        switch (node.kind) {
+        case Node::Kind::Empty:
+            break;
+        case Node::Kind::Char:
+            _inst(Op::Char, node.flag, node.value);
+            break;
+        case Node::Kind::Class:
+            _inst(Op::Class, false, node.value);
+            break;
+        case Node::Kind::Any:
+            _inst(Op::Any);
+            break;
+        case Node::Kind::Begin:
+            _inst(Op::Begin);
+            break;
+        case Node::Kind::End:
+            _inst(Op::End);
+            break;
+        case Node::Kind::Concat:
+            for (const auto &child : node.children) {
+                _emit(*child);
+            }
+            break;
+        case Node::Kind::Alt: {
+            std::vector<size_t> jumps;
+            for (size_t i = 0; i < node.children.size(); i++) {
+                if (i + 1 < node.children.size()) {
+                    const size_t split = _inst(Op::Split);
+                    _re._prog[split].x = split + 1;
+                    _emit(*node.children[i]);
+                    jumps.push_back(_inst(Op::Jump));
+                    _re._prog[split].y = _re._prog.size();
+                } else {
+                    _emit(*node.children[i]);
+                }
+            }
+            for (size_t jump : jumps) {
+                _re._prog[jump].x = _re._prog.size();
+            }
+            break;
+        }
+        case Node::Kind::Repeat:
+            for (int i = 0; i < node.min; i++) {
+                _emit(*node.children[0]);
+            }
+            _emitRepeatTail(node);
+            break;
+        case Node::Kind::Look:
+            _looks.emplace_back(_inst(Op::Look, node.flag), node.children[0].get());
+            break;
+        }
+    }
+};
+
+Regex::Regex(const std::string &pattern) {
+    RegexCompiler(pattern, *this).compile();
+}
+
+bool Regex::CharClass::matchesExact(uint32_t cp) const {
+    for (const auto &item : items) {
+        bool m;
+        switch (item.kind) {
+        case ClassItem::Kind::Range:
+            m = cp >= item.lo && cp <= item.hi;
+            break;
+        case ClassItem::Kind::Category:
+            m = (item.lo & categoryBit(unicodeCategory(cp))) != 0;
+            break;
+        default:
+            m = isWhitespace(cp);
+            break;
+        }
+        if (m != item.negate) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Regex::CharClass::matches(uint32_t cp) const {
+    bool m = matchesExact(cp) || (icase && asciiSwapCase(cp) != cp && matchesExact(asciiSwapCase(cp)));
+    return m != negate;
+}
+
+bool Regex::_run(size_t pc, const uint32_t *text, size_t n, size_t pos, size_t &end) const {
+    std::vector<std::pair<size_t, size_t>> stack;
+    while (true) {
+        const Inst &inst = _prog[pc];
+        bool ok = true;
+        switch (inst.op) {
+        case Op::Char:
+            ok = pos < n && (inst.flag ? asciiLower(text[pos]) : text[pos]) == inst.arg;
+            pos++, pc++;
+            break;
+        case Op::Class:
+            ok = pos < n && _classes[inst.arg].matches(text[pos]);
+            pos++, pc++;
+            break;
+        case Op::Any:
+            ok = pos < n && text[pos] != '\n';
+            pos++, pc++;
+            break;
+        case Op::Begin:
+            ok = pos == 0;
+            pc++;
+            break;
+        case Op::End:
+            ok = pos == n;
+            pc++;
+            break;
+        case Op::Split:
+            stack.emplace_back(inst.y, pos);
+            pc = inst.x;
+            break;
+        case Op::Jump:
+            pc = inst.x;
+            break;
+        case Op::Look: {
+            size_t ignored;
+            ok = _run(inst.x, text, n, pos, ignored) != inst.flag;
+            pc++;
+            break;
+        }
+        case Op::Match:
+            end = pos;
+            return true;
+        }
+        if (!ok) {
+            if (stack.empty()) {
+                return false;
+            }
+            pc = stack.back().first;
+            pos = stack.back().second;
+            stack.pop_back();
+        }
+    }
+}
+
+bool Regex::search(const uint32_t *text, size_t n, size_t start, size_t &begin, size_t &end) const {
+    for (size_t pos = start; pos < n; pos++) {
+        if (_run(0, text, n, pos, end) && end > pos) {
+            begin = pos;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace llaisys::tokenizer
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace llaisys::tokenizer {
+
+// Regular expressions for the pre-tokenizer patterns found in tokenizer.json.
+// Supports the syntax those patterns use: alternation, (non-)capturing groups,
+// (?i:...), lookahead (?=...) and (?!...), greedy and lazy quantifiers
+// including {m,n}, character classes with ranges, \s \d \w and their negations,
+// and Unicode properties \p{..}/\P{..}. Anything else throws
+// std::invalid_argument at construction.
+//
+// Matching is leftmost-first (the semantics of the Rust regex crate used by
+// HuggingFace tokenizers) over code points, with a backtracking VM.
+class Regex {
+public:
+    explicit Regex(const std::string &pattern);
+
+    // Find the first non-empty match in text[start, n); the pattern sees
+    // text[0, n) as the whole subject. On success sets [begin, end) in code
+    // point indices.
+    bool search(const uint32_t *text, size_t n, size_t start, size_t &begin, size_t &end) const;
+
+private:
+    struct ClassItem {
+        enum class Kind : uint8_t {
+            Range,
+            Category,
+            Space,
+        } kind;
+        bool negate;
+        uint32_t lo, hi; // code point range, or category mask in lo
+    };
+
+    struct CharClass {
+        std::vector<ClassItem> items;
+        bool negate = false;
+        bool icase = false;
+
+        bool matches(uint32_t cp) const;
+        bool matchesExact(uint32_t cp) const;
+    };
+
+    enum class Op : uint8_t {
+        Char,
+        Class,
+        Any,
+        Begin,
+        End,
+        Split, // try x first, then y
+        Jump,
+        Look, // lookahead program at x, negated when flag is set
+        Match,
+    };
+
+    struct Inst {
+        Op op;
+        bool flag; // case-insensitive Char, negative Look
+        uint32_t arg;
+        size_t x, y;
+    };
+
+    std::vector<Inst> _prog;
+    std::vector<CharClass> _classes;
+
+    friend class RegexCompiler;
+
+    bool _run(size_t pc, const uint32_t *text, size_t n, size_t pos, size_t &end) const;
+};
+
+} // namespace llaisys::tokenizer
@@ -0,0 +1,503 @@
+#include "tokenizer.hpp"
+
+#include "unicode.hpp"
+
+#include "../utils.hpp"
+#include "../utils/json.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <queue>
+#include <sstream>
+
+namespace llaisys::tokenizer {
+
+namespace {
+
+using utils::Json;
+
+// GPT-2's pre-tokenizer, used by ByteLevel when use_regex is set.
+const char *GPT2_PATTERN = "'s|'t|'re|'ve|'m|'ll|'d| ?\\p{L}+| ?\\p{N}+| ?[^\\s\\p{L}\\p{N}]+|\\s+(?!\\S)|\\s+";
+
+std::string readFile(const std::filesystem::path &path) {
+    std::ifstream file(path, std::ios::binary);
+    CHECK_ARGUMENT(file.good(), "cannot open " + path.string());
+    std::stringstream buf;
+    buf << file.rdbuf();
+    return buf.str();
+}
+
+// GPT-2's reversible byte -> code point map: printable bytes map to
+// themselves, the rest to U+0100 onwards.
+std::array<uint32_t, 256> byteToCodePoint() {
+    std::array<uint32_t, 256> map{};
+    uint32_t next = 256;
+    for (uint32_t b = 0; b < 256; b++) {
+        const bool printable = (b >= '!' && b <= '~') || (b >= 0xA1 && b <= 0xAC) || (b >= 0xAE);
+        map[b] = printable ? b : next++;
+    }
+    return map;
+}
+
+// Escape a literal for use inside a Regex pattern.
+std::string escapeRegex(const std::string &literal) {
+    std::string out;
+    for (char c : literal) {
+        if (std::string("\\^$.|?*+()[]{}").find(c) != std::string::npos) {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+std::string tokenContent(const Json &value) {
+    if (value.isString()) {
+        return value.asString();
+    }
+    if (value.isObject() && value["content"].isString()) {
+        return value["content"].asString();
+    }
+    return "";
+}
+
+} // namespace
+
+Tokenizer::Tokenizer(const std::string &path) {
+    std::filesystem::path file(path);
+    if (std::filesystem::is_directory(file)) {
+        file /= "tokenizer.json";
+    }
+    const Json root = Json::parse(readFile(file));
+
+    _loadModel(root["model"]);
+
+    static const Json no_tokens = Json::array();
+    const Json &added_tokens = root["added_tokens"].isArray() ? root["added_tokens"] : no_tokens;
+    for (const auto &token : added_tokens.asArray()) {
+        AddedToken added{token["content"].asString(), static_cast<int32_t>(token["id"].asInt()),
+                         token["special"].isBool() && token["special"].asBool()};
+        CHECK_ARGUMENT(!added.content.empty() && added.id >= 0, "invalid added token in " + file.string());
+        if (static_cast<size_t>(added.id) >= _pieces.size()) {
+            _pieces.resize(added.id + 1);
+            _special.resize(added.id + 1, false);
+        }
+        _pieces[added.id] = added.content;
+        _special[added.id] = added.special;
+        _vocab[added.content] = added.id;
+        _added.push_back(std::move(added));
+    }
+    for (size_t i = 0; i < _added.size(); i++) {
+        _added_by_byte[static_cast<unsigned char>(_added[i].content[0])].push_back(i);
+    }
+    for (auto &bucket : _added_by_byte) {
+        std::stable_sort(bucket.begin(), bucket.end(),
+                         [&](size_t a, size_t b) { return _added[a].content.size() > _added[b].content.size(); });
+    }
+
+    const Json &normalizer = root["normalizer"];
+    // NFC is a no-op on already-composed text, which is what clients send in practice.
+    CHECK_ARGUMENT(normalizer.isNull() || normalizer["type"].asString() == "NFC",
+                   "unsupported tokenizer normalizer " + normalizer.dump());
+    const Json &decoder = root["decoder"];
+    CHECK_ARGUMENT(decoder.isNull() || decoder["type"].asString() == "ByteLevel",
+                   "only byte-level tokenizers are supported");
+    _loadPreTokenizer(root["pre_tokenizer"]);
+    _loadPostProcessor(root["post_processor"]);
+    _loadChatConfig((file.parent_path() / "tokenizer_config.json").string());
+}
+
+void Tokenizer::_loadModel(const Json &model) {
+    CHECK_ARGUMENT(!model.contains("type") || model["type"].asString() == "BPE", "only BPE tokenizers are supported");
+    _ignore_merges = model["ignore_merges"].isBool() && model["ignore_merges"].asBool();
+
+    for (const auto &[token, id] : model["vocab"].items()) {
+        const int32_t i = static_cast<int32_t>(id.asInt());
+        CHECK_ARGUMENT(i >= 0, "negative token id for " + token);
+        _vocab.emplace(token, i);
+        if (static_cast<size_t>(i) >= _pieces.size()) {
+            _pieces.resize(i + 1);
+        }
+    }
+    _special.assign(_pieces.size(), false);
+
+    const auto byte_cp = byteToCodePoint();
+    std::unordered_map<uint32_t, char> cp_byte;
+    for (uint32_t b = 0; b < 256; b++) {
+        cp_byte[byte_cp[b]] = static_cast<char>(b);
+        utf8Append(_byte_chars[b], byte_cp[b]);
+        auto it = _vocab.find(_byte_chars[b]);
+        CHECK_ARGUMENT(it != _vocab.end(), "vocabulary lacks a byte-level token for every byte");
+        _byte_token[b] = it->second;
+    }
+    for (const auto &[token, id] : _vocab) {
+        std::string &bytes = _pieces[id];
+        for (size_t i = 0; i < token.size();) {
+            uint32_t cp;
+            const size_t len = utf8Decode(token.data() + i, token.size() - i, cp);
+            auto it = cp_byte.find(cp);
+            if (it != cp_byte.end()) {
+                bytes += it->second;
+            } else {
+                bytes.append(token, i, len);
+            }
+            i += len;
+        }
+    }
+
+    const auto &merges = model["merges"].asArray();
+    _merges.reserve(merges.size());
+    for (size_t rank = 0; rank < merges.size(); rank++) {
+        std::string left, right;
+        if (merges[rank].isString()) {
+            const std::string &merge = merges[rank].asString();
+            const size_t space = merge.find(' ', 1);
+            CHECK_ARGUMENT(space != std::string::npos, "malformed merge " + merge);
+            left = merge.substr(0, space);
+            right = merge.substr(space + 1);
+        } else {
+            left = merges[rank][0].asString();
+            right = merges[rank][1].asString();
+        }
+        auto l = _vocab.find(left), r = _vocab.find(right), m = _vocab.find(left + right);
+        if (l == _vocab.end() || r == _vocab.end() || m == _vocab.end()) {
+            continue; // unreachable merge
+        }
+        const uint64_t key = (static_cast<uint64_t>(l->second) << 32) | static_cast<uint32_t>(r->second);
+        _merges.emplace(key, Merge{static_cast<uint32_t>(rank), m->second});
+    }
+}
+
+void Tokenizer::_loadPreTokenizer(const Json &pre) {
+    if (pre.isNull()) {
+        return;
+    }
+    const std::string &type = pre["type"].asString();
+    if (type == "Sequence") {
+        for (const auto &child : pre["pretokenizers"].asArray()) {
+            _loadPreTokenizer(child);
+        }
+    } else if (type == "Split") {
+        const Json &pattern = pre["pattern"];
+        CHECK_ARGUMENT(pre["behavior"].asString() == "Isolated", "unsupported Split behavior " + pre["behavior"].asString());
+        CHECK_ARGUMENT(!(pre["invert"].isBool() && pre["invert"].asBool()), "inverted Split pre-tokenizers are not supported");
+        _splits.push_back(std::make_unique<Regex>(
+            pattern.contains("Regex") ? pattern["Regex"].asString() : escapeRegex(pattern["String"].asString())));
+    } else if (type == "Digits") {
+        const bool individual = pre["individual_digits"].isBool() && pre["individual_digits"].asBool();
+        _splits.push_back(std::make_unique<Regex>(individual ? "\\p{N}" : "\\p{N}+"));
+    } else if (type == "ByteLevel") {
+        _add_prefix_space = pre["add_prefix_space"].isBool() && pre["add_prefix_space"].asBool();
+        if (!pre["use_regex"].isBool() || pre["use_regex"].asBool()) {
+            _splits.push_back(std::make_unique<Regex>(GPT2_PATTERN));
+        }
+    } else {
+        CHECK_ARGUMENT(false, "unsupported pre-tokenizer " + type);
+    }
+}
+
+void Tokenizer::_loadPostProcessor(const Json &post) {
+    if (post.isNull() || post["type"].asString() != "TemplateProcessing") {
+        return; // ByteLevel post-processing only trims offsets
+    }
+    bool seen_sequence = false;
+    for (const auto &piece : post["single"].asArray()) {
+        if (piece.contains("Sequence")) {
+            seen_sequence = true;
+            continue;
+        }
+        const std::string &name = piece["SpecialToken"]["id"].asString();
+        for (const auto &id : post["special_tokens"][name]["ids"].asArray()) {
+            (seen_sequence ? _suffix_ids : _prefix_ids).push_back(static_cast<int32_t>(id.asInt()));
+        }
+    }
+}
+
+void Tokenizer::_loadChatConfig(const std::string &config_path) {
+    std::string chat_template;
+    if (std::filesystem::exists(config_path)) {
+        const Json config = Json::parse(readFile(config_path));
+        _bos_token = tokenContent(config["bos_token"]);
+        if (config["chat_template"].isString()) {
+            chat_template = config["chat_template"].asString();
+        }
+    }
+    if (chat_template.find("<｜User｜>") != std::string::npos
+        || (chat_template.empty() && tokenId("<｜User｜>") >= 0)) {
+        _chat_format = ChatFormat::DeepSeek;
+        _think_prefix = chat_template.find("<｜Assistant｜><think>") != std::string::npos;
+    } else if (chat_template.find("<|im_start|>") != std::string::npos
+               || (chat_template.empty() && tokenId("<|im_start|>") >= 0)) {
+        _chat_format = ChatFormat::ChatML;
+        const char *qwen25 = "You are Qwen, created by Alibaba Cloud. You are a helpful assistant.";
+        _default_system = chat_template.find(qwen25) != std::string::npos ? qwen25 : "You are a helpful assistant.";
+    }
+}
+
+const std::string &Tokenizer::tokenBytes(int64_t id) const {
+    static const std::string empty;
+    return (id >= 0 && static_cast<size_t>(id) < _pieces.size()) ? _pieces[id] : empty;
+}
+
+bool Tokenizer::isSpecial(int64_t id) const {
+    return id >= 0 && static_cast<size_t>(id) < _special.size() && _special[id];
+}
+
+int64_t Tokenizer::tokenId(const std::string &token) const {
+    auto it = _vocab.find(token);
+    return it == _vocab.end() ? -1 : it->second;
+}
+
+std::vector<int64_t> Tokenizer::encode(const std::string &text, bool add_special_tokens) const {
+    std::vector<int64_t> out;
+    if (add_special_tokens) {
+        out.insert(out.end(), _prefix_ids.begin(), _prefix_ids.end());
+    }
+    // Added tokens are matched verbatim before pre-tokenization, longest first.
+    size_t segment = 0;
+    for (size_t pos = 0; pos < text.size();) {
+        const AddedToken *match = nullptr;
+        for (size_t i : _added_by_byte[static_cast<unsigned char>(text[pos])]) {
+            if (text.compare(pos, _added[i].content.size(), _added[i].content) == 0) {
+                match = &_added[i];
+                break;
+            }
+        }
+        if (match == nullptr) {
+            pos++;
+            continue;
+        }
+        _encodeSegment(text, segment, pos, segment == 0, out);
+        out.push_back(match->id);
+        pos += match->content.size();
+        segment = pos;
+    }
+    _encodeSegment(text, segment, text.size(), segment == 0, out);
+    if (add_special_tokens) {
+        out.insert(out.end(), _suffix_ids.begin(), _suffix_ids.end());
+    }
+    return out;
+}
+
+void Tokenizer::_encodeSegment(const std::string &text, size_t begin, size_t end, bool first, std::vector<int64_t> &out) const {
+    if (begin == end) {
+        return;
+    }
+    std::string owned;
+    const std::string *segment = &text;
+    if (first && _add_prefix_space && text[begin] != ' ') {
+        owned = " " + text.substr(begin, end - begin);
+        segment = &owned;
+        begin = 0;
+        end = owned.size();
+    }
+
+    std::vector<uint32_t> cps;
+    std::vector<size_t> offsets;
+    for (size_t i = begin; i < end;) {
+        uint32_t cp;
+        offsets.push_back(i);
+        i += utf8Decode(segment->data() + i, end - i, cp);
+        cps.push_back(cp);
+    }
+    offsets.push_back(end);
+
+    // Each Split regex refines the pieces left by the previous one.
+    std::vector<std::pair<size_t, size_t>> pieces{{0, cps.size()}}, next;
+    for (const auto &split : _splits) {
+        next.clear();
+        for (const auto &[pb, pe] : pieces) {
+            size_t pos = 0, mb, me;
+            const size_t n = pe - pb;
+            while (pos < n && split->search(cps.data() + pb, n, pos, mb, me)) {
+                if (mb > pos) {
+                    next.emplace_back(pb + pos, pb + mb);
+                }
+                next.emplace_back(pb + mb, pb + me);
+                pos = me;
+            }
+            if (pos < n) {
+                next.emplace_back(pb + pos, pe);
+            }
+        }
+        pieces.swap(next);
+    }
+
+    std::string word;
+    for (const auto &[pb, pe] : pieces) {
+        word.assign(*segment, offsets[pb], offsets[pe] - offsets[pb]);
+        _encodeWord(word, out);
+    }
+}
+
+void Tokenizer::_encodeWord(const std::string &word, std::vector<int64_t> &out) const {
+    if (word.size() == 1) {
+        out.push_back(_byte_token[static_cast<unsigned char>(word[0])]);
+        return;
+    }
+    const bool cacheable = word.size() <= CACHE_MAX_WORD;
+    if (cacheable) {
+        std::shared_lock<std::shared_mutex> lock(_cache_mutex);
+        auto it = _cache.find(word);
+        if (it != _cache.end()) {
+            out.insert(out.end(), it->second.begin(), it->second.end());
+            return;
+        }
+    }
+    std::vector<int32_t> ids;
+    _bpe(word, ids);
+    out.insert(out.end(), ids.begin(), ids.end());
+    if (cacheable) {
+        std::unique_lock<std::shared_mutex> lock(_cache_mutex);
+        if (_cache.size() >= CACHE_CAPACITY) {
+            _cache.clear();
+        }
+        _cache.emplace(word, std::move(ids));
+    }
+}
+
+void Tokenizer::_bpe(const std::string &word, std::vector<int32_t> &ids) const {
+    if (_ignore_merges) {
+        std::string mapped;
+        for (char c : word) {
+            mapped += _byte_chars[static_cast<unsigned char>(c)];
+        }
+        auto it = _vocab.find(mapped);
+        if (it != _vocab.end()) {
+            ids.push_back(it->second);
+            return;
+        }
+    }
+
+    // Symbols form a linked list; candidate merges wait in a heap ordered by
+    // (rank, position) so equal ranks merge left to right. Stale entries are
+    // skipped when popped.
+    struct Symbol {
+        int32_t id;
+        int prev, next;
+    };
+    struct Candidate {
+        uint32_t rank;
+        int left;
+        int32_t left_id, right_id, merged;
+        bool operator>(const Candidate &o) const { return rank != o.rank ? rank > o.rank : left > o.left; }
+    };
+    std::vector<Symbol> symbols(word.size());
+    for (size_t i = 0; i < word.size(); i++) {
+        symbols[i] = {_byte_token[static_cast<unsigned char>(word[i])], static_cast<int>(i) - 1,
+                      i + 1 < word.size() ? static_cast<int>(i) + 1 : -1};
+    }
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> heap;
+    auto consider = [&](int left) {
+        if (left < 0 || symbols[left].next < 0) {
+            return;
+        }
+        const int32_t l = symbols[left].id, r = symbols[symbols[left].next].id;
+        auto it = _merges.find((static_cast<uint64_t>(l) << 32) | static_cast<uint32_t>(r));
+        if (it != _merges.end()) {
+            heap.push({it->second.rank, left, l, r, it->second.id});
+        }
+    };
+    for (int i = 0; i + 1 < static_cast<int>(symbols.size()); i++) {
+        consider(i);
+    }
+    while (!heap.empty()) {
+        const Candidate c = heap.top();
+        heap.pop();
+        Symbol &left = symbols[c.left];
+        if (left.id != c.left_id || left.next < 0 || symbols[left.next].id != c.right_id) {
+            continue;
+        }
+        Symbol &right = symbols[left.next];
+        left.id = c.merged;
+        right.id = -1;
+        left.next = right.next;
+        if (right.next >= 0) {
+            symbols[right.next].prev = c.left;
+        }
+        consider(left.prev);
+        consider(c.left);
+    }
+    for (int i = 0; i >= 0; i = symbols[i].next) {
+        ids.push_back(symbols[i].id);
+    }
+}
+
+std::string Tokenizer::decode(const int64_t *ids, size_t n, bool skip_special_tokens) const {
+    std::string bytes;
+    for (size_t i = 0; i < n; i++) {
+        if (!(skip_special_tokens && isSpecial(ids[i]))) {
+            bytes += tokenBytes(ids[i]);
+        }
+    }
+    std::string out;
+    utf8AppendLossy(out, bytes.data(), bytes.size(), false);
+    return out;
+}
+
+Detokenizer::Detokenizer(const Tokenizer &tokenizer, bool skip_special_tokens)
+    : _tokenizer(tokenizer), _skip_special_tokens(skip_special_tokens) {}
+
+const std::string &Detokenizer::push(int64_t token) {
+    _text.clear();
+    if (_skip_special_tokens && _tokenizer.isSpecial(token)) {
+        return _text;
+    }
+    _pending += _tokenizer.tokenBytes(token);
+    const size_t keep = utf8AppendLossy(_text, _pending.data(), _pending.size(), true);
+    _pending.erase(0, _pending.size() - keep);
+    return _text;
+}
+
+const std::string &Detokenizer::flush() {
+    _text.clear();
+    utf8AppendLossy(_text, _pending.data(), _pending.size(), false);
+    _pending.clear();
+    return _text;
+}
+
+std::string Tokenizer::applyChatTemplate(const std::vector<ChatMessage> &messages, bool add_generation_prompt) const {
+    std::string out;
+    switch (_chat_format) {
+    case ChatFormat::ChatML:
+        if (messages.empty() || messages[0].role != "system") {
+            out += "<|im_start|>system\n" + _default_system + "<|im_end|>\n";
+        }
+        for (const auto &m : messages) {
+            out += "<|im_start|>" + m.role + "\n" + m.content + "<|im_end|>\n";
+        }
+        if (add_generation_prompt) {
+            out += "<|im_start|>assistant\n";
+        }
+        break;
+    case ChatFormat::DeepSeek:
+        out += _bos_token;
+        for (auto it = messages.rbegin(); it != messages.rend(); ++it) {
+            if (it->role == "system") {
+                out += it->content; // the template keeps the last system prompt
+                break;
+            }
+        }
+        for (const auto &m : messages) {
+            if (m.role == "user") {
+                out += "<｜User｜>" + m.content;
+            } else if (m.role == "assistant") {
+                // Earlier turns keep only the answer, not the reasoning.
+                const size_t think_end = m.content.rfind("</think>");
+                out += "<｜Assistant｜>" + (think_end == std::string::npos ? m.content : m.content.substr(think_end + 8))
+                     + "<｜end▁of▁sentence｜>";
+            }
+        }
+        if (add_generation_prompt) {
+            out += _think_prefix ? "<｜Assistant｜><think>\n" : "<｜Assistant｜>";
+        }
+        break;
+    default:
+        CHECK_ARGUMENT(false, "tokenizer has no supported chat template");
+    }
+    return out;
+}
+
+} // namespace llaisys::tokenizer
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "regex.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace llaisys::utils {
+class Json;
+}
+
+namespace llaisys::tokenizer {
+
+struct ChatMessage {
+    std::string role;
+    std::string content;
+};
+
+// Byte-level BPE tokenizer (GPT-2/Qwen2 family) loaded from a HuggingFace
+// tokenizer.json. Encoding splits out added tokens, runs the pre-tokenizer
+// regexes, then merges each piece by rank; results for frequent pieces are
+// cached. Thread-safe after construction.
+class Tokenizer {
+public:
+    // `path` is a tokenizer.json file or a directory holding one. A
+    // tokenizer_config.json next to it selects the chat template and bos token.
+    explicit Tokenizer(const std::string &path);
+
+    std::vector<int64_t> encode(const std::string &text, bool add_special_tokens = true) const;
+    // Invalid UTF-8, e.g. a character cut short at the end, becomes U+FFFD.
+    std::string decode(const int64_t *ids, size_t n, bool skip_special_tokens = false) const;
+    std::string decode(const std::vector<int64_t> &ids, bool skip_special_tokens = false) const {
+        return decode(ids.data(), ids.size(), skip_special_tokens);
+    }
+
+    // Raw bytes a token decodes to; empty for unknown ids. Multi-byte UTF-8
+    // characters may be split across tokens.
+    const std::string &tokenBytes(int64_t id) const;
+    bool isSpecial(int64_t id) const;
+    // Id of a vocabulary entry or added token by its tokenizer.json spelling, or -1.
+    int64_t tokenId(const std::string &token) const;
+    size_t vocabSize() const { return _pieces.size(); }
+
+    // Render a conversation with the model's chat template, ending with the
+    // assistant prefix when `add_generation_prompt` is set. Supports the ChatML
+    // (Qwen) and DeepSeek-R1 templates.
+    std::string applyChatTemplate(const std::vector<ChatMessage> &messages, bool add_generation_prompt = true) const;
+
+private:
+    struct AddedToken {
+        std::string content;
+        int32_t id;
+        bool special;
+    };
+
+    struct Merge {
+        uint32_t rank;
+        int32_t id;
+    };
+
+    enum class ChatFormat {
+        None,
+        ChatML,
+        DeepSeek,
+    };
+
+    static constexpr size_t CACHE_CAPACITY = 1 << 16;
+    static constexpr size_t CACHE_MAX_WORD = 64;
+
+    std::unordered_map<std::string, int32_t> _vocab;
+    std::unordered_map<uint64_t, Merge> _merges;
+    std::vector<std::string> _pieces;
+    std::vector<bool> _special;
+    std::array<int32_t, 256> _byte_token{};
+    std::array<std::string, 256> _byte_chars; // byte-level alphabet, for ignore_merges lookups
+    bool _ignore_merges = false;
+
+    std::vector<AddedToken> _added;
+    std::array<std::vector<size_t>, 256> _added_by_byte; // longest first
+
+    std::vector<std::unique_ptr<Regex>> _splits;
+    bool _add_prefix_space = false;
+
+    std::vector<int32_t> _prefix_ids, _suffix_ids;
+
+    ChatFormat _chat_format = ChatFormat::None;
+    std::string _bos_token;
+    std::string _default_system;
+    bool _think_prefix = false;
+
+    mutable std::shared_mutex _cache_mutex;
+    mutable std::unordered_map<std::string, std::vector<int32_t>> _cache;
+
+    void _loadModel(const utils::Json &model);
+    void _loadPreTokenizer(const utils::Json &pre);
+    void _loadPostProcessor(const utils::Json &post);
+    void _loadChatConfig(const std::string &config_path);
+
+    void _encodeSegment(const std::string &text, size_t begin, size_t end, bool first, std::vector<int64_t> &out) const;
+    void _encodeWord(const std::string &word, std::vector<int64_t> &out) const;
+    void _bpe(const std::string &word, std::vector<int32_t> &ids) const;
+};
+
+// Incremental decoding for streaming: push() returns only the text completed
+// by one more token, holding back a trailing character whose bytes are still
+// arriving. The concatenation of all push() results and flush() equals
+// Tokenizer::decode of the whole sequence, at O(1) work per token.
+class Detokenizer {
+public:
+    explicit Detokenizer(const Tokenizer &tokenizer, bool skip_special_tokens = true);
+
+    // The returned text stays valid until the next call.
+    const std::string &push(int64_t token);
+    // Emit held-back bytes (as U+FFFD) at the end of the sequence.
+    const std::string &flush();
+
+private:
+    const Tokenizer &_tokenizer;
+    bool _skip_special_tokens;
+    std::string _pending;
+    std::string _text;
+};
+
+} // namespace llaisys::tokenizer
@@ -0,0 +1,190 @@
+#include "unicode.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace llaisys::tokenizer {
+
+namespace {
+
+using C = UnicodeCategory;
+
+uint32_t mask(std::initializer_list<C> categories) {
+    uint32_t m = 0;
+    for (C c : categories) {
+        m |= categoryBit(c);
+    }
+    return m;
+}
+
+// Categories of the ASCII range, which dominates tokenizer input.
+const std::array<UnicodeCategory, 128> &asciiCategories() {
+    static const std::array<UnicodeCategory, 128> table = [] {
+        std::array<UnicodeCategory, 128> t{};
+        for (uint32_t cp = 0; cp < 128; cp++) {
+            auto it = std::upper_bound(UNICODE_RANGES, UNICODE_RANGES + UNICODE_RANGE_COUNT, cp,
+                                       [](uint32_t v, const UnicodeRange &r) { return v < r.first; });
+            t[cp] = (it != UNICODE_RANGES && cp <= (it - 1)->last) ? (it - 1)->category : C::Cn;
+        }
+        return t;
+    }();
+    return table;
+}
+
+} // namespace
+
+UnicodeCategory unicodeCategory(uint32_t cp) {
+    if (cp < 128) {
+        return asciiCategories()[cp];
+    }
+    auto it = std::upper_bound(UNICODE_RANGES, UNICODE_RANGES + UNICODE_RANGE_COUNT, cp,
+                               [](uint32_t v, const UnicodeRange &r) { return v < r.first; });
+    if (it == UNICODE_RANGES || cp > (it - 1)->last) {
+        return C::Cn;
+    }
+    return (it - 1)->category;
+}
+
+uint32_t categoryMask(const std::string &name) {
+    static const std::pair<const char *, uint32_t> table[] = {
+        {"L", mask({C::Lu, C::Ll, C::Lt, C::Lm, C::Lo})},
+        {"Letter", mask({C::Lu, C::Ll, C::Lt, C::Lm, C::Lo})},
+        {"M", mask({C::Mn, C::Mc, C::Me})},
+        {"Mark", mask({C::Mn, C::Mc, C::Me})},
+        {"N", mask({C::Nd, C::Nl, C::No})},
+        {"Number", mask({C::Nd, C::Nl, C::No})},
+        {"P", mask({C::Pc, C::Pd, C::Ps, C::Pe, C::Pi, C::Pf, C::Po})},
+        {"Punctuation", mask({C::Pc, C::Pd, C::Ps, C::Pe, C::Pi, C::Pf, C::Po})},
+        {"S", mask({C::Sm, C::Sc, C::Sk, C::So})},
+        {"Symbol", mask({C::Sm, C::Sc, C::Sk, C::So})},
+        {"Z", mask({C::Zs, C::Zl, C::Zp})},
+        {"Separator", mask({C::Zs, C::Zl, C::Zp})},
+        {"C", mask({C::Cn, C::Cc, C::Cf, C::Cs, C::Co})},
+        {"Other", mask({C::Cn, C::Cc, C::Cf, C::Cs, C::Co})},
+    };
+    static const char *const names[] = {
+        "Cn", "Lu", "Ll", "Lt", "Lm", "Lo", "Mn", "Mc", "Me", "Nd", "Nl", "No", "Pc", "Pd", "Ps",
+        "Pe", "Pi", "Pf", "Po", "Sm", "Sc", "Sk", "So", "Zs", "Zl", "Zp", "Cc", "Cf", "Cs", "Co",
+    };
+    for (const auto &entry : table) {
+        if (name == entry.first) {
+            return entry.second;
+        }
+    }
+    for (unsigned i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (name == names[i]) {
+            return 1u << i;
+        }
+    }
+    return 0;
+}
+
+bool isWhitespace(uint32_t cp) {
+    if (cp < 128) {
+        return cp == ' ' || (cp >= '\t' && cp <= '\r');
+    }
+    return cp == 0x85 || cp == 0xA0 || cp == 0x1680 || (cp >= 0x2000 && cp <= 0x200A) || cp == 0x2028
+        || cp == 0x2029 || cp == 0x202F || cp == 0x205F || cp == 0x3000;
+}
+
+size_t utf8Decode(const char *s, size_t n, uint32_t &cp) {
+    const auto *u = reinterpret_cast<const unsigned char *>(s);
+    if (u[0] < 0x80) {
+        cp = u[0];
+        return 1;
+    }
+    size_t len;
+    uint32_t min;
+    if ((u[0] & 0xE0) == 0xC0) {
+        len = 2, min = 0x80, cp = u[0] & 0x1F;
+    } else if ((u[0] & 0xF0) == 0xE0) {
+        len = 3, min = 0x800, cp = u[0] & 0x0F;
+    } else if ((u[0] & 0xF8) == 0xF0) {
+        len = 4, min = 0x10000, cp = u[0] & 0x07;
+    } else {
+        cp = 0xFFFD;
+        return 1;
+    }
+    if (len > n) {
+        cp = 0xFFFD;
+        return 1;
+    }
+    for (size_t i = 1; i < len; i++) {
+        if ((u[i] & 0xC0) != 0x80) {
+            cp = 0xFFFD;
+            return 1;
+        }
+        cp = (cp << 6) | (u[i] & 0x3F);
+    }
+    if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+        cp = 0xFFFD;
+        return 1;
+    }
+    return len;
+}
+
+void utf8Append(std::string &out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+size_t utf8AppendLossy(std::string &out, const char *s, size_t n, bool keep_incomplete) {
+    const auto *u = reinterpret_cast<const unsigned char *>(s);
+    size_t i = 0;
+    while (i < n) {
+        const unsigned char lead = u[i];
+        if (lead < 0x80) {
+            out += static_cast<char>(lead);
+            i++;
+            continue;
+        }
+        // Sequence length and the allowed range of the second byte, which
+        // excludes overlongs, surrogates and code points above U+10FFFF.
+        size_t len = 0;
+        unsigned char lo = 0x80, hi = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            len = 2;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            len = 3;
+            lo = lead == 0xE0 ? 0xA0 : 0x80;
+            hi = lead == 0xED ? 0x9F : 0xBF;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            len = 4;
+            lo = lead == 0xF0 ? 0x90 : 0x80;
+            hi = lead == 0xF4 ? 0x8F : 0xBF;
+        }
+        size_t valid = len > 0 ? 1 : 0;
+        while (valid > 0 && valid < len && i + valid < n) {
+            const unsigned char c = u[i + valid];
+            if (c < (valid == 1 ? lo : 0x80) || c > (valid == 1 ? hi : 0xBF)) {
+                break;
+            }
+            valid++;
+        }
+        if (valid == len && len > 0) {
+            out.append(s + i, len);
+            i += len;
+        } else if (keep_incomplete && valid > 0 && i + valid == n) {
+            return n - i;
+        } else {
+            utf8Append(out, 0xFFFD);
+            i += valid > 0 ? valid : 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace llaisys::tokenizer
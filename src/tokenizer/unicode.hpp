@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace llaisys::tokenizer {
+
+// Unicode general categories. Cn (unassigned) is zero so gaps in the range
+// table need no entries.
+enum class UnicodeCategory : uint8_t {
+    Cn,
+    Lu,
+    Ll,
+    Lt,
+    Lm,
+    Lo,
+    Mn,
+    Mc,
+    Me,
+    Nd,
+    Nl,
+    No,
+    Pc,
+    Pd,
+    Ps,
+    Pe,
+    Pi,
+    Pf,
+    Po,
+    Sm,
+    Sc,
+    Sk,
+    So,
+    Zs,
+    Zl,
+    Zp,
+    Cc,
+    Cf,
+    Cs,
+    Co,
+};
+
+struct UnicodeRange {
+    uint32_t first, last;
+    UnicodeCategory category;
+};
+
+extern const UnicodeRange UNICODE_RANGES[];
+extern const size_t UNICODE_RANGE_COUNT;
+
+UnicodeCategory unicodeCategory(uint32_t cp);
+
+inline uint32_t categoryBit(UnicodeCategory category) {
+    return 1u << static_cast<unsigned>(category);
+}
+
+// Mask of the categories named by a \p{...} property: a major class ("L", "N",
+// ...), a single category ("Lu"), or a long name ("Letter", "Number", ...).
+// Returns 0 for unknown names.
+uint32_t categoryMask(const std::string &name);
+
+// The White_Space property, which is what \s matches.
+bool isWhitespace(uint32_t cp);
+
+// Decode one code point from s[0, n). Returns the number of bytes consumed (at
+// least 1 when n > 0). Invalid or truncated sequences decode to U+FFFD one
+// byte at a time.
+size_t utf8Decode(const char *s, size_t n, uint32_t &cp);
+
+void utf8Append(std::string &out, uint32_t cp);
+
+// Append s[0, n) to `out`, replacing each maximal invalid subpart with U+FFFD
+// (what Python's errors="replace" and Rust's from_utf8_lossy do). With
+// `keep_incomplete`, a trailing sequence that is valid so far but cut short is
+// not appended; its length is returned so the caller can retry once more bytes
+// arrive. Returns 0 otherwise.
+size_t utf8AppendLossy(std::string &out, const char *s, size_t n, bool keep_incomplete);
+
+} // namespace llaisys::tokenizer
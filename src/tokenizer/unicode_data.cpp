@@ -0,0 +1,1033 @@
+// Generated by scripts/gen_unicode_data.py from Unicode 15.0.0. Do not edit.
+
+#include "unicode.hpp"
+
+namespace llaisys::tokenizer {
+
+namespace {
+using C = UnicodeCategory;
+} // namespace
+
+// Maximal runs of code points sharing a general category; gaps are unassigned (Cn).
+const UnicodeRange UNICODE_RANGES[] = {
+    {0x0, 0x1F, C::Cc}, {0x20, 0x20, C::Zs}, {0x21, 0x23, C::Po}, {0x24, 0x24, C::Sc},
+    {0x25, 0x27, C::Po}, {0x28, 0x28, C::Ps}, {0x29, 0x29, C::Pe}, {0x2A, 0x2A, C::Po},
+    {0x2B, 0x2B, C::Sm}, {0x2C, 0x2C, C::Po}, {0x2D, 0x2D, C::Pd}, {0x2E, 0x2F, C::Po},
+    {0x30, 0x39, C::Nd}, {0x3A, 0x3B, C::Po}, {0x3C, 0x3E, C::Sm}, {0x3F, 0x40, C::Po},
+    {0x41, 0x5A, C::Lu}, {0x5B, 0x5B, C::Ps}, {0x5C, 0x5C, C::Po}, {0x5D, 0x5D, C::Pe},
+    {0x5E, 0x5E, C::Sk}, {0x5F, 0x5F, C::Pc}, {0x60, 0x60, C::Sk}, {0x61, 0x7A, C::Ll},
+    {0x7B, 0x7B, C::Ps}, {0x7C, 0x7C, C::Sm}, {0x7D, 0x7D, C::Pe}, {0x7E, 0x7E, C::Sm},
+    {0x7F, 0x9F, C::Cc}, {0xA0, 0xA0, C::Zs}, {0xA1, 0xA1, C::Po}, {0xA2, 0xA5, C::Sc},
+    {0xA6, 0xA6, C::So}, {0xA7, 0xA7, C::Po}, {0xA8, 0xA8, C::Sk}, {0xA9, 0xA9, C::So},
+    {0xAA, 0xAA, C::Lo}, {0xAB, 0xAB, C::Pi}, {0xAC, 0xAC, C::Sm}, {0xAD, 0xAD, C::Cf},
+    {0xAE, 0xAE, C::So}, {0xAF, 0xAF, C::Sk}, {0xB0, 0xB0, C::So}, {0xB1, 0xB1, C::Sm},
+    {0xB2, 0xB3, C::No}, {0xB4, 0xB4, C::Sk}, {0xB5, 0xB5, C::Ll}, {0xB6, 0xB7, C::Po},
+    {0xB8, 0xB8, C::Sk}, {0xB9, 0xB9, C::No}, {0xBA, 0xBA, C::Lo}, {0xBB, 0xBB, C::Pf},
+    {0xBC, 0xBE, C::No}, {0xBF, 0xBF, C::Po}, {0xC0, 0xD6, C::Lu}, {0xD7, 0xD7, C::Sm},
+    {0xD8, 0xDE, C::Lu}, {0xDF, 0xF6, C::Ll}, {0xF7, 0xF7, C::Sm}, {0xF8, 0xFF, C::Ll},
+    {0x100, 0x100, C::Lu}, {0x101, 0x101, C::Ll}, {0x102, 0x102, C::Lu}, {0x103, 0x103, C::Ll},
+    {0x104, 0x104, C::Lu}, {0x105, 0x105, C::Ll}, {0x106, 0x106, C::Lu}, {0x107, 0x107, C::Ll},
+    {0x108, 0x108, C::Lu}, {0x109, 0x109, C::Ll}, {0x10A, 0x10A, C::Lu}, {0x10B, 0x10B, C::Ll},
+    {0x10C, 0x10C, C::Lu}, {0x10D, 0x10D, C::Ll}, {0x10E, 0x10E, C::Lu}, {0x10F, 0x10F, C::Ll},
+    {0x110, 0x110, C::Lu}, {0x111, 0x111, C::Ll}, {0x112, 0x112, C::Lu}, {0x113, 0x113, C::Ll},
+    {0x114, 0x114, C::Lu}, {0x115, 0x115, C::Ll}, {0x116, 0x116, C::Lu}, {0x117, 0x117, C::Ll},
+    {0x118, 0x118, C::Lu}, {0x119, 0x119, C::Ll}, {0x11A, 0x11A, C::Lu}, {0x11B, 0x11B, C::Ll},
+    {0x11C, 0x11C, C::Lu}, {0x11D, 0x11D, C::Ll}, {0x11E, 0x11E, C::Lu}, {0x11F, 0x11F, C::Ll},
+    {0x120, 0x120, C::Lu}, {0x121, 0x121, C::Ll}, {0x122, 0x122, C::Lu}, {0x123, 0x123, C::Ll},
+    {0x124, 0x124, C::Lu}, {0x125, 0x125, C::Ll}, {0x126, 0x126, C::Lu}, {0x127, 0x127, C::Ll},
+    {0x128, 0x128, C::Lu}, {0x129, 0x129, C::Ll}, {0x12A, 0x12A, C::Lu}, {0x12B, 0x12B, C::Ll},
+    {0x12C, 0x12C, C::Lu}, {0x12D, 0x12D, C::Ll}, {0x12E, 0x12E, C::Lu}, {0x12F, 0x12F, C::Ll},
+    {0x130, 0x130, C::Lu}, {0x131, 0x131, C::Ll}, {0x132, 0x132, C::Lu}, {0x133, 0x133, C::Ll},
+    {0x134, 0x134, C::Lu}, {0x135, 0x135, C::Ll}, {0x136, 0x136, C::Lu}, {0x137, 0x138, C::Ll},
+    {0x139, 0x139, C::Lu}, {0x13A, 0x13A, C::Ll}, {0x13B, 0x13B, C::Lu}, {0x13C, 0x13C, C::Ll},
+    {0x13D, 0x13D, C::Lu}, {0x13E, 0x13E, C::Ll}, {0x13F, 0x13F, C::Lu}, {0x140, 0x140, C::Ll},
+    {0x141, 0x141, C::Lu}, {0x142, 0x142, C::Ll}, {0x143, 0x143, C::Lu}, {0x144, 0x144, C::Ll},
+    {0x145, 0x145, C::Lu}, {0x146, 0x146, C::Ll}, {0x147, 0x147, C::Lu}, {0x148, 0x149, C::Ll},
+    {0x14A, 0x14A, C::Lu}, {0x14B, 0x14B, C::Ll}, {0x14C, 0x14C, C::Lu}, {0x14D, 0x14D, C::Ll},
+    {0x14E, 0x14E, C::Lu}, {0x14F, 0x14F, C::Ll}, {0x150, 0x150, C::Lu}, {0x151, 0x151, C::Ll},
+    {0x152, 0x152, C::Lu}, {0x153, 0x153, C::Ll}, {0x154, 0x154, C::Lu}, {0x155, 0x155, C::Ll},
+    {0x156, 0x156, C::Lu}, {0x157, 0x157, C::Ll}, {0x158, 0x158, C::Lu}, {0x159, 0x159, C::Ll},
+    {0x15A, 0x15A, C::Lu}, {0x15B, 0x15B, C::Ll}, {0x15C, 0x15C, C::Lu}, {0x15D, 0x15D, C::Ll},
+    {0x15E, 0x15E, C::Lu}, {0x15F, 0x15F, C::Ll}, {0x160, 0x160, C::Lu}, {0x161, 0x161, C::Ll},
+    {0x162, 0x162, C::Lu}, {0x163, 0x163, C::Ll}, {0x164, 0x164, C::Lu}, {0x165, 0x165, C::Ll},
+    {0x166, 0x166, C::Lu}, {0x167, 0x167, C::Ll}, {0x168, 0x168, C::Lu}, {0x169, 0x169, C::Ll},
+    {0x16A, 0x16A, C::Lu}, {0x16B, 0x16B, C::Ll}, {0x16C, 0x16C, C::Lu}, {0x16D, 0x16D, C::Ll},
+    {0x16E, 0x16E, C::Lu}, {0x16F, 0x16F, C::Ll}, {0x170, 0x170, C::Lu}, {0x171, 0x171, C::Ll},
+    {0x172, 0x172, C::Lu}, {0x173, 0x173, C::Ll}, {0x174, 0x174, C::Lu}, {0x175, 0x175, C::Ll},
+    {0x176, 0x176, C::Lu}, {0x177, 0x177, C::Ll}, {0x178, 0x179, C::Lu}, {0x17A, 0x17A, C::Ll},
+    {0x17B, 0x17B, C::Lu}, {0x17C, 0x17C, C::Ll}, {0x17D, 0x17D, C::Lu}, {0x17E, 0x180, C::Ll},
+    {0x181, 0x182, C::Lu}, {0x183, 0x183, C::Ll}, {0x184, 0x184, C::Lu}, {0x185, 0x185, C::Ll},
+    {0x186, 0x187, C::Lu}, {0x188, 0x188, C::Ll}, {0x189, 0x18B, C::Lu}, {0x18C, 0x18D, C::Ll},
+    {0x18E, 0x191, C::Lu}, {0x192, 0x192, C::Ll}, {0x193, 0x194, C::Lu}, {0x195, 0x195, C::Ll},
+    {0x196, 0x198, C::Lu}, {0x199, 0x19B, C::Ll}, {0x19C, 0x19D, C::Lu}, {0x19E, 0x19E, C::Ll},
+    {0x19F, 0x1A0, C::Lu}, {0x1A1, 0x1A1, C::Ll}, {0x1A2, 0x1A2, C::Lu}, {0x1A3, 0x1A3, C::Ll},
+    {0x1A4, 0x1A4, C::Lu}, {0x1A5, 0x1A5, C::Ll}, {0x1A6, 0x1A7, C::Lu}, {0x1A8, 0x1A8, C::Ll},
+    {0x1A9, 0x1A9, C::Lu}, {0x1AA, 0x1AB, C::Ll}, {0x1AC, 0x1AC, C::Lu}, {0x1AD, 0x1AD, C::Ll},
+    {0x1AE, 0x1AF, C::Lu}, {0x1B0, 0x1B0, C::Ll}, {0x1B1, 0x1B3, C::Lu}, {0x1B4, 0x1B4, C::Ll},
+    {0x1B5, 0x1B5, C::Lu}, {0x1B6, 0x1B6, C::Ll}, {0x1B7, 0x1B8, C::Lu}, {0x1B9, 0x1BA, C::Ll},
+    {0x1BB, 0x1BB, C::Lo}, {0x1BC, 0x1BC, C::Lu}, {0x1BD, 0x1BF, C::Ll}, {0x1C0, 0x1C3, C::Lo},
+    {0x1C4, 0x1C4, C::Lu}, {0x1C5, 0x1C5, C::Lt}, {0x1C6, 0x1C6, C::Ll}, {0x1C7, 0x1C7, C::Lu},
+    {0x1C8, 0x1C8, C::Lt}, {0x1C9, 0x1C9, C::Ll}, {0x1CA, 0x1CA, C::Lu}, {0x1CB, 0x1CB, C::Lt},
+    {0x1CC, 0x1CC, C::Ll}, {0x1CD, 0x1CD, C::Lu}, {0x1CE, 0x1CE, C::Ll}, {0x1CF, 0x1CF, C::Lu},
+    {0x1D0, 0x1D0, C::Ll}, {0x1D1, 0x1D1, C::Lu}, {0x1D2, 0x1D2, C::Ll}, {0x1D3, 0x1D3, C::Lu},
+    {0x1D4, 0x1D4, C::Ll}, {0x1D5, 0x1D5, C::Lu}, {0x1D6, 0x1D6, C::Ll}, {0x1D7, 0x1D7, C::Lu},
+    {0x1D8, 0x1D8, C::Ll}, {0x1D9, 0x1D9, C::Lu}, {0x1DA, 0x1DA, C::Ll}, {0x1DB, 0x1DB, C::Lu},
+    {0x1DC, 0x1DD, C::Ll}, {0x1DE, 0x1DE, C::Lu}, {0x1DF, 0x1DF, C::Ll}, {0x1E0, 0x1E0, C::Lu},
+    {0x1E1, 0x1E1, C::Ll}, {0x1E2, 0x1E2, C::Lu}, {0x1E3, 0x1E3, C::Ll}, {0x1E4, 0x1E4, C::Lu},
+    {0x1E5, 0x1E5, C::Ll}, {0x1E6, 0x1E6, C::Lu}, {0x1E7, 0x1E7, C::Ll}, {0x1E8, 0x1E8, C::Lu},
+    {0x1E9, 0x1E9, C::Ll}, {0x1EA, 0x1EA, C::Lu}, {0x1EB, 0x1EB, C::Ll}, {0x1EC, 0x1EC, C::Lu},
+    {0x1ED, 0x1ED, C::Ll}, {0x1EE, 0x1EE, C::Lu}, {0x1EF, 0x1F0, C::Ll}, {0x1F1, 0x1F1, C::Lu},
+    {0x1F2, 0x1F2, C::Lt}, {0x1F3, 0x1F3, C::Ll}, {0x1F4, 0x1F4, C::Lu}, {0x1F5, 0x1F5, C::Ll},
+    {0x1F6, 0x1F8, C::Lu}, {0x1F9, 0x1F9, C::Ll}, {0x1FA, 0x1FA, C::Lu}, {0x1FB, 0x1FB, C::Ll},
+    {0x1FC, 0x1FC, C::Lu}, {0x1FD, 0x1FD, C::Ll}, {0x1FE, 0x1FE, C::Lu}, {0x1FF, 0x1FF, C::Ll},
+    {0x200, 0x200, C::Lu}, {0x201, 0x201, C::Ll}, {0x202, 0x202, C::Lu}, {0x203, 0x203, C::Ll},
+    {0x204, 0x204, C::Lu}, {0x205, 0x205, C::Ll}, {0x206, 0x206, C::Lu}, {0x207, 0x207, C::Ll},
+    {0x208, 0x208, C::Lu}, {0x209, 0x209, C::Ll}, {0x20A, 0x20A, C::Lu}, {0x20B, 0x20B, C::Ll},
+    {0x20C, 0x20C, C::Lu}, {0x20D, 0x20D, C::Ll}, {0x20E, 0x20E, C::Lu}, {0x20F, 0x20F, C::Ll},
+    {0x210, 0x210, C::Lu}, {0x211, 0x211, C::Ll}, {0x212, 0x212, C::Lu}, {0x213, 0x213, C::Ll},
+    {0x214, 0x214, C::Lu}, {0x215, 0x215, C::Ll}, {0x216, 0x216, C::Lu}, {0x217, 0x217, C::Ll},
+    {0x218, 0x218, C::Lu}, {0x219, 0x219, C::Ll}, {0x21A, 0x21A, C::Lu}, {0x21B, 0x21B, C::Ll},
+    {0x21C, 0x21C, C::Lu}, {0x21D, 0x21D, C::Ll}, {0x21E, 0x21E, C::Lu}, {0x21F, 0x21F, C::Ll},
+    {0x220, 0x220, C::Lu}, {0x221, 0x221, C::Ll}, {0x222, 0x222, C::Lu}, {0x223, 0x223, C::Ll},
+    {0x224, 0x224, C::Lu}, {0x225, 0x225, C::Ll}, {0x226, 0x226, C::Lu}, {0x227, 0x227, C::Ll},
+    {0x228, 0x228, C::Lu}, {0x229, 0x229, C::Ll}, {0x22A, 0x22A, C::Lu}, {0x22B, 0x22B, C::Ll},
+    {0x22C, 0x22C, C::Lu}, {0x22D, 0x22D, C::Ll}, {0x22E, 0x22E, C::Lu}, {0x22F, 0x22F, C::Ll},
+    {0x230, 0x230, C::Lu}, {0x231, 0x231, C::Ll}, {0x232, 0x232, C::Lu}, {0x233, 0x239, C::Ll},
+    {0x23A, 0x23B, C::Lu}, {0x23C, 0x23C, C::Ll}, {0x23D, 0x23E, C::Lu}, {0x23F, 0x240, C::Ll},
+    {0x241, 0x241, C::Lu}, {0x242, 0x242, C::Ll}, {0x243, 0x246, C::Lu}, {0x247, 0x247, C::Ll},
+    {0x248, 0x248, C::Lu}, {0x249, 0x249, C::Ll}, {0x24A, 0x24A, C::Lu}, {0x24B, 0x24B, C::Ll},
+    {0x24C, 0x24C, C::Lu}, {0x24D, 0x24D, C::Ll}, {0x24E, 0x24E, C::Lu}, {0x24F, 0x293, C::Ll},
+    {0x294, 0x294, C::Lo}, {0x295, 0x2AF, C::Ll}, {0x2B0, 0x2C1, C::Lm}, {0x2C2, 0x2C5, C::Sk},
+    {0x2C6, 0x2D1, C::Lm}, {0x2D2, 0x2DF, C::Sk}, {0x2E0, 0x2E4, C::Lm}, {0x2E5, 0x2EB, C::Sk},
+    {0x2EC, 0x2EC, C::Lm}, {0x2ED, 0x2ED, C::Sk}, {0x2EE, 0x2EE, C::Lm}, {0x2EF, 0x2FF, C::Sk},
+    {0x300, 0x36F, C::Mn}, {0x370, 0x370, C::Lu}, {0x371, 0x371, C::Ll}, {0x372, 0x372, C::Lu},
+    {0x373, 0x373, C::Ll}, {0x374, 0x374, C::Lm}, {0x375, 0x375, C::Sk}, {0x376, 0x376, C::Lu},
+    {0x377, 0x377, C::Ll}, {0x37A, 0x37A, C::Lm}, {0x37B, 0x37D, C::Ll}, {0x37E, 0x37E, C::Po},
+    {0x37F, 0x37F, C::Lu}, {0x384, 0x385, C::Sk}, {0x386, 0x386, C::Lu}, {0x387, 0x387, C::Po},
+    {0x388, 0x38A, C::Lu}, {0x38C, 0x38C, C::Lu}, {0x38E, 0x38F, C::Lu}, {0x390, 0x390, C::Ll},
+    {0x391, 0x3A1, C::Lu}, {0x3A3, 0x3AB, C::Lu}, {0x3AC, 0x3CE, C::Ll}, {0x3CF, 0x3CF, C::Lu},
+    {0x3D0, 0x3D1, C::Ll}, {0x3D2, 0x3D4, C::Lu}, {0x3D5, 0x3D7, C::Ll}, {0x3D8, 0x3D8, C::Lu},
+    {0x3D9, 0x3D9, C::Ll}, {0x3DA, 0x3DA, C::Lu}, {0x3DB, 0x3DB, C::Ll}, {0x3DC, 0x3DC, C::Lu},
+    {0x3DD, 0x3DD, C::Ll}, {0x3DE, 0x3DE, C::Lu}, {0x3DF, 0x3DF, C::Ll}, {0x3E0, 0x3E0, C::Lu},
+    {0x3E1, 0x3E1, C::Ll}, {0x3E2, 0x3E2, C::Lu}, {0x3E3, 0x3E3, C::Ll}, {0x3E4, 0x3E4, C::Lu},
+    {0x3E5, 0x3E5, C::Ll}, {0x3E6, 0x3E6, C::Lu}, {0x3E7, 0x3E7, C::Ll}, {0x3E8, 0x3E8, C::Lu},
+    {0x3E9, 0x3E9, C::Ll}, {0x3EA, 0x3EA, C::Lu}, {0x3EB, 0x3EB, C::Ll}, {0x3EC, 0x3EC, C::Lu},
+    {0x3ED, 0x3ED, C::Ll}, {0x3EE, 0x3EE, C::Lu}, {0x3EF, 0x3F3, C::Ll}, {0x3F4, 0x3F4, C::Lu},
+    {0x3F5, 0x3F5, C::Ll}, {0x3F6, 0x3F6, C::Sm}, {0x3F7, 0x3F7, C::Lu}, {0x3F8, 0x3F8, C::Ll},
+    {0x3F9, 0x3FA, C::Lu}, {0x3FB, 0x3FC, C::Ll}, {0x3FD, 0x42F, C::Lu}, {0x430, 0x45F, C::Ll},
+    {0x460, 0x460, C::Lu}, {0x461, 0x461, C::Ll}, {0x462, 0x462, C::Lu}, {0x463, 0x463, C::Ll},
+    {0x464, 0x464, C::Lu}, {0x465, 0x465, C::Ll}, {0x466, 0x466, C::Lu}, {0x467, 0x467, C::Ll},
+    {0x468, 0x468, C::Lu}, {0x469, 0x469, C::Ll}, {0x46A, 0x46A, C::Lu}, {0x46B, 0x46B, C::Ll},
+    {0x46C, 0x46C, C::Lu}, {0x46D, 0x46D, C::Ll}, {0x46E, 0x46E, C::Lu}, {0x46F, 0x46F, C::Ll},
+    {0x470, 0x470, C::Lu}, {0x471, 0x471, C::Ll}, {0x472, 0x472, C::Lu}, {0x473, 0x473, C::Ll},
+    {0x474, 0x474, C::Lu}, {0x475, 0x475, C::Ll}, {0x476, 0x476, C::Lu}, {0x477, 0x477, C::Ll},
+    {0x478, 0x478, C::Lu}, {0x479, 0x479, C::Ll}, {0x47A, 0x47A, C::Lu}, {0x47B, 0x47B, C::Ll},
+    {0x47C, 0x47C, C::Lu}, {0x47D, 0x47D, C::Ll}, {0x47E, 0x47E, C::Lu}, {0x47F, 0x47F, C::Ll},
+    {0x480, 0x480, C::Lu}, {0x481, 0x481, C::Ll}, {0x482, 0x482, C::So}, {0x483, 0x487, C::Mn},
+    {0x488, 0x489, C::Me}, {0x48A, 0x48A, C::Lu}, {0x48B, 0x48B, C::Ll}, {0x48C, 0x48C, C::Lu},
+    {0x48D, 0x48D, C::Ll}, {0x48E, 0x48E, C::Lu}, {0x48F, 0x48F, C::Ll}, {0x490, 0x490, C::Lu},
+    {0x491, 0x491, C::Ll}, {0x492, 0x492, C::Lu}, {0x493, 0x493, C::Ll}, {0x494, 0x494, C::Lu},
+    {0x495, 0x495, C::Ll}, {0x496, 0x496, C::Lu}, {0x497, 0x497, C::Ll}, {0x498, 0x498, C::Lu},
+    {0x499, 0x499, C::Ll}, {0x49A, 0x49A, C::Lu}, {0x49B, 0x49B, C::Ll}, {0x49C, 0x49C, C::Lu},
+    {0x49D, 0x49D, C::Ll}, {0x49E, 0x49E, C::Lu}, {0x49F, 0x49F, C::Ll}, {0x4A0, 0x4A0, C::Lu},
+    {0x4A1, 0x4A1, C::Ll}, {0x4A2, 0x4A2, C::Lu}, {0x4A3, 0x4A3, C::Ll}, {0x4A4, 0x4A4, C::Lu},
+    {0x4A5, 0x4A5, C::Ll}, {0x4A6, 0x4A6, C::Lu}, {0x4A7, 0x4A7, C::Ll}, {0x4A8, 0x4A8, C::Lu},
+    {0x4A9, 0x4A9, C::Ll}, {0x4AA, 0x4AA, C::Lu}, {0x4AB, 0x4AB, C::Ll}, {0x4AC, 0x4AC, C::Lu},
+    {0x4AD, 0x4AD, C::Ll}, {0x4AE, 0x4AE, C::Lu}, {0x4AF, 0x4AF, C::Ll}, {0x4B0, 0x4B0, C::Lu},
+    {0x4B1, 0x4B1, C::Ll}, {0x4B2, 0x4B2, C::Lu}, {0x4B3, 0x4B3, C::Ll}, {0x4B4, 0x4B4, C::Lu},
+    {0x4B5, 0x4B5, C::Ll}, {0x4B6, 0x4B6, C::Lu}, {0x4B7, 0x4B7, C::Ll}, {0x4B8, 0x4B8, C::Lu},
+    {0x4B9, 0x4B9, C::Ll}, {0x4BA, 0x4BA, C::Lu}, {0x4BB, 0x4BB, C::Ll}, {0x4BC, 0x4BC, C::Lu},
+    {0x4BD, 0x4BD, C::Ll}, {0x4BE, 0x4BE, C::Lu}, {0x4BF, 0x4BF, C::Ll}, {0x4C0, 0x4C1, C::Lu},
+    {0x4C2, 0x4C2, C::Ll}, {0x4C3, 0x4C3, C::Lu}, {0x4C4, 0x4C4, C::Ll}, {0x4C5, 0x4C5, C::Lu},
+    {0x4C6, 0x4C6, C::Ll}, {0x4C7, 0x4C7, C::Lu}, {0x4C8, 0x4C8, C::Ll}, {0x4C9, 0x4C9, C::Lu},
+    {0x4CA, 0x4CA, C::Ll}, {0x4CB, 0x4CB, C::Lu}, {0x4CC, 0x4CC, C::Ll}, {0x4CD, 0x4CD, C::Lu},
+    {0x4CE, 0x4CF, C::Ll}, {0x4D0, 0x4D0, C::Lu}, {0x4D1, 0x4D1, C::Ll}, {0x4D2, 0x4D2, C::Lu},
+    {0x4D3, 0x4D3, C::Ll}, {0x4D4, 0x4D4, C::Lu}, {0x4D5, 0x4D5, C::Ll}, {0x4D6, 0x4D6, C::Lu},
+    {0x4D7, 0x4D7, C::Ll}, {0x4D8, 0x4D8, C::Lu}, {0x4D9, 0x4D9, C::Ll}, {0x4DA, 0x4DA, C::Lu},
+    {0x4DB, 0x4DB, C::Ll}, {0x4DC, 0x4DC, C::Lu}, {0x4DD, 0x4DD, C::Ll}, {0x4DE, 0x4DE, C::Lu},
+    {0x4DF, 0x4DF, C::Ll}, {0x4E0, 0x4E0, C::Lu}, {0x4E1, 0x4E1, C::Ll}, {0x4E2, 0x4E2, C::Lu},
+    {0x4E3, 0x4E3, C::Ll}, {0x4E4, 0x4E4, C::Lu}, {0x4E5, 0x4E5, C::Ll}, {0x4E6, 0x4E6, C::Lu},
+    {0x4E7, 0x4E7, C::Ll}, {0x4E8, 0x4E8, C::Lu}, {0x4E9, 0x4E9, C::Ll}, {0x4EA, 0x4EA, C::Lu},
+    {0x4EB, 0x4EB, C::Ll}, {0x4EC, 0x4EC, C::Lu}, {0x4ED, 0x4ED, C::Ll}, {0x4EE, 0x4EE, C::Lu},
+    {0x4EF, 0x4EF, C::Ll}, {0x4F0, 0x4F0, C::Lu}, {0x4F1, 0x4F1, C::Ll}, {0x4F2, 0x4F2, C::Lu},
+    {0x4F3, 0x4F3, C::Ll}, {0x4F4, 0x4F4, C::Lu}, {0x4F5, 0x4F5, C::Ll}, {0x4F6, 0x4F6, C::Lu},
+    {0x4F7, 0x4F7, C::Ll}, {0x4F8, 0x4F8, C::Lu}, {0x4F9, 0x4F9, C::Ll}, {0x4FA, 0x4FA, C::Lu},
+    {0x4FB, 0x4FB, C::Ll}, {0x4FC, 0x4FC, C::Lu}, {0x4FD, 0x4FD, C::Ll}, {0x4FE, 0x4FE, C::Lu},
+    {0x4FF, 0x4FF, C::Ll}, {0x500, 0x500, C::Lu}, {0x501, 0x501, C::Ll}, {0x502, 0x502, C::Lu},
+    {0x503, 0x503, C::Ll}, {0x504, 0x504, C::Lu}, {0x505, 0x505, C::Ll}, {0x506, 0x506, C::Lu},
+    {0x507, 0x507, C::Ll}, {0x508, 0x508, C::Lu}, {0x509, 0x509, C::Ll}, {0x50A, 0x50A, C::Lu},
+    {0x50B, 0x50B, C::Ll}, {0x50C, 0x50C, C::Lu}, {0x50D, 0x50D, C::Ll}, {0x50E, 0x50E, C::Lu},
+    {0x50F, 0x50F, C::Ll}, {0x510, 0x510, C::Lu}, {0x511, 0x511, C::Ll}, {0x512, 0x512, C::Lu},
+    {0x513, 0x513, C::Ll}, {0x514, 0x514, C::Lu}, {0x515, 0x515, C::Ll}, {0x516, 0x516, C::Lu},
+    {0x517, 0x517, C::Ll}, {0x518, 0x518, C::Lu}, {0x519, 0x519, C::Ll}, {0x51A, 0x51A, C::Lu},
+    {0x51B, 0x51B, C::Ll}, {0x51C, 0x51C, C::Lu}, {0x51D, 0x51D, C::Ll}, {0x51E, 0x51E, C::Lu},
+    {0x51F, 0x51F, C::Ll}, {0x520, 0x520, C::Lu}, {0x521, 0x521, C::Ll}, {0x522, 0x522, C::Lu},
+    {0x523, 0x523, C::Ll}, {0x524, 0x524, C::Lu}, {0x525, 0x525, C::Ll}, {0x526, 0x526, C::Lu},
+    {0x527, 0x527, C::Ll}, {0x528, 0x528, C::Lu}, {0x529, 0x529, C::Ll}, {0x52A, 0x52A, C::Lu},
+    {0x52B, 0x52B, C::Ll}, {0x52C, 0x52C, C::Lu}, {0x52D, 0x52D, C::Ll}, {0x52E, 0x52E, C::Lu},
+    {0x52F, 0x52F, C::Ll}, {0x531, 0x556, C::Lu}, {0x559, 0x559, C::Lm}, {0x55A, 0x55F, C::Po},
+    {0x560, 0x588, C::Ll}, {0x589, 0x589, C::Po}, {0x58A, 0x58A, C::Pd}, {0x58D, 0x58E, C::So},
+    {0x58F, 0x58F, C::Sc}, {0x591, 0x5BD, C::Mn}, {0x5BE, 0x5BE, C::Pd}, {0x5BF, 0x5BF, C::Mn},
+    {0x5C0, 0x5C0, C::Po}, {0x5C1, 0x5C2, C::Mn}, {0x5C3, 0x5C3, C::Po}, {0x5C4, 0x5C5, C::Mn},
+    {0x5C6, 0x5C6, C::Po}, {0x5C7, 0x5C7, C::Mn}, {0x5D0, 0x5EA, C::Lo}, {0x5EF, 0x5F2, C::Lo},
+    {0x5F3, 0x5F4, C::Po}, {0x600, 0x605, C::Cf}, {0x606, 0x608, C::Sm}, {0x609, 0x60A, C::Po},
+    {0x60B, 0x60B, C::Sc}, {0x60C, 0x60D, C::Po}, {0x60E, 0x60F, C::So}, {0x610, 0x61A, C::Mn},
+    {0x61B, 0x61B, C::Po}, {0x61C, 0x61C, C::Cf}, {0x61D, 0x61F, C::Po}, {0x620, 0x63F, C::Lo},
+    {0x640, 0x640, C::Lm}, {0x641, 0x64A, C::Lo}, {0x64B, 0x65F, C::Mn}, {0x660, 0x669, C::Nd},
+    {0x66A, 0x66D, C::Po}, {0x66E, 0x66F, C::Lo}, {0x670, 0x670, C::Mn}, {0x671, 0x6D3, C::Lo},
+    {0x6D4, 0x6D4, C::Po}, {0x6D5, 0x6D5, C::Lo}, {0x6D6, 0x6DC, C::Mn}, {0x6DD, 0x6DD, C::Cf},
+    {0x6DE, 0x6DE, C::So}, {0x6DF, 0x6E4, C::Mn}, {0x6E5, 0x6E6, C::Lm}, {0x6E7, 0x6E8, C::Mn},
+    {0x6E9, 0x6E9, C::So}, {0x6EA, 0x6ED, C::Mn}, {0x6EE, 0x6EF, C::Lo}, {0x6F0, 0x6F9, C::Nd},
+    {0x6FA, 0x6FC, C::Lo}, {0x6FD, 0x6FE, C::So}, {0x6FF, 0x6FF, C::Lo}, {0x700, 0x70D, C::Po},
+    {0x70F, 0x70F, C::Cf}, {0x710, 0x710, C::Lo}, {0x711, 0x711, C::Mn}, {0x712, 0x72F, C::Lo},
+    {0x730, 0x74A, C::Mn}, {0x74D, 0x7A5, C::Lo}, {0x7A6, 0x7B0, C::Mn}, {0x7B1, 0x7B1, C::Lo},
+    {0x7C0, 0x7C9, C::Nd}, {0x7CA, 0x7EA, C::Lo}, {0x7EB, 0x7F3, C::Mn}, {0x7F4, 0x7F5, C::Lm},
+    {0x7F6, 0x7F6, C::So}, {0x7F7, 0x7F9, C::Po}, {0x7FA, 0x7FA, C::Lm}, {0x7FD, 0x7FD, C::Mn},
+    {0x7FE, 0x7FF, C::Sc}, {0x800, 0x815, C::Lo}, {0x816, 0x819, C::Mn}, {0x81A, 0x81A, C::Lm},
+    {0x81B, 0x823, C::Mn}, {0x824, 0x824, C::Lm}, {0x825, 0x827, C::Mn}, {0x828, 0x828, C::Lm},
+    {0x829, 0x82D, C::Mn}, {0x830, 0x83E, C::Po}, {0x840, 0x858, C::Lo}, {0x859, 0x85B, C::Mn},
+    {0x85E, 0x85E, C::Po}, {0x860, 0x86A, C::Lo}, {0x870, 0x887, C::Lo}, {0x888, 0x888, C::Sk},
+    {0x889, 0x88E, C::Lo}, {0x890, 0x891, C::Cf}, {0x898, 0x89F, C::Mn}, {0x8A0, 0x8C8, C::Lo},
+    {0x8C9, 0x8C9, C::Lm}, {0x8CA, 0x8E1, C::Mn}, {0x8E2, 0x8E2, C::Cf}, {0x8E3, 0x902, C::Mn},
+    {0x903, 0x903, C::Mc}, {0x904, 0x939, C::Lo}, {0x93A, 0x93A, C::Mn}, {0x93B, 0x93B, C::Mc},
+    {0x93C, 0x93C, C::Mn}, {0x93D, 0x93D, C::Lo}, {0x93E, 0x940, C::Mc}, {0x941, 0x948, C::Mn},
+    {0x949, 0x94C, C::Mc}, {0x94D, 0x94D, C::Mn}, {0x94E, 0x94F, C::Mc}, {0x950, 0x950, C::Lo},
+    {0x951, 0x957, C::Mn}, {0x958, 0x961, C::Lo}, {0x962, 0x963, C::Mn}, {0x964, 0x965, C::Po},
+    {0x966, 0x96F, C::Nd}, {0x970, 0x970, C::Po}, {0x971, 0x971, C::Lm}, {0x972, 0x980, C::Lo},
+    {0x981, 0x981, C::Mn}, {0x982, 0x983, C::Mc}, {0x985, 0x98C, C::Lo}, {0x98F, 0x990, C::Lo},
+    {0x993, 0x9A8, C::Lo}, {0x9AA, 0x9B0, C::Lo}, {0x9B2, 0x9B2, C::Lo}, {0x9B6, 0x9B9, C::Lo},
+    {0x9BC, 0x9BC, C::Mn}, {0x9BD, 0x9BD, C::Lo}, {0x9BE, 0x9C0, C::Mc}, {0x9C1, 0x9C4, C::Mn},
+    {0x9C7, 0x9C8, C::Mc}, {0x9CB, 0x9CC, C::Mc}, {0x9CD, 0x9CD, C::Mn}, {0x9CE, 0x9CE, C::Lo},
+    {0x9D7, 0x9D7, C::Mc}, {0x9DC, 0x9DD, C::Lo}, {0x9DF, 0x9E1, C::Lo}, {0x9E2, 0x9E3, C::Mn},
+    {0x9E6, 0x9EF, C::Nd}, {0x9F0, 0x9F1, C::Lo}, {0x9F2, 0x9F3, C::Sc}, {0x9F4, 0x9F9, C::No},
+    {0x9FA, 0x9FA, C::So}, {0x9FB, 0x9FB, C::Sc}, {0x9FC, 0x9FC, C::Lo}, {0x9FD, 0x9FD, C::Po},
+    {0x9FE, 0x9FE, C::Mn}, {0xA01, 0xA02, C::Mn}, {0xA03, 0xA03, C::Mc}, {0xA05, 0xA0A, C::Lo},
+    {0xA0F, 0xA10, C::Lo}, {0xA13, 0xA28, C::Lo}, {0xA2A, 0xA30, C::Lo}, {0xA32, 0xA33, C::Lo},
+    {0xA35, 0xA36, C::Lo}, {0xA38, 0xA39, C::Lo}, {0xA3C, 0xA3C, C::Mn}, {0xA3E, 0xA40, C::Mc},
+    {0xA41, 0xA42, C::Mn}, {0xA47, 0xA48, C::Mn}, {0xA4B, 0xA4D, C::Mn}, {0xA51, 0xA51, C::Mn},
+    {0xA59, 0xA5C, C::Lo}, {0xA5E, 0xA5E, C::Lo}, {0xA66, 0xA6F, C::Nd}, {0xA70, 0xA71, C::Mn},
+    {0xA72, 0xA74, C::Lo}, {0xA75, 0xA75, C::Mn}, {0xA76, 0xA76, C::Po}, {0xA81, 0xA82, C::Mn},
+    {0xA83, 0xA83, C::Mc}, {0xA85, 0xA8D, C::Lo}, {0xA8F, 0xA91, C::Lo}, {0xA93, 0xAA8, C::Lo},
+    {0xAAA, 0xAB0, C::Lo}, {0xAB2, 0xAB3, C::Lo}, {0xAB5, 0xAB9, C::Lo}, {0xABC, 0xABC, C::Mn},
+    {0xABD, 0xABD, C::Lo}, {0xABE, 0xAC0, C::Mc}, {0xAC1, 0xAC5, C::Mn}, {0xAC7, 0xAC8, C::Mn},
+    {0xAC9, 0xAC9, C::Mc}, {0xACB, 0xACC, C::Mc}, {0xACD, 0xACD, C::Mn}, {0xAD0, 0xAD0, C::Lo},
+    {0xAE0, 0xAE1, C::Lo}, {0xAE2, 0xAE3, C::Mn}, {0xAE6, 0xAEF, C::Nd}, {0xAF0, 0xAF0, C::Po},
+    {0xAF1, 0xAF1, C::Sc}, {0xAF9, 0xAF9, C::Lo}, {0xAFA, 0xAFF, C::Mn}, {0xB01, 0xB01, C::Mn},
+    {0xB02, 0xB03, C::Mc}, {0xB05, 0xB0C, C::Lo}, {0xB0F, 0xB10, C::Lo}, {0xB13, 0xB28, C::Lo},
+    {0xB2A, 0xB30, C::Lo}, {0xB32, 0xB33, C::Lo}, {0xB35, 0xB39, C::Lo}, {0xB3C, 0xB3C, C::Mn},
+    {0xB3D, 0xB3D, C::Lo}, {0xB3E, 0xB3E, C::Mc}, {0xB3F, 0xB3F, C::Mn}, {0xB40, 0xB40, C::Mc},
+    {0xB41, 0xB44, C::Mn}, {0xB47, 0xB48, C::Mc}, {0xB4B, 0xB4C, C::Mc}, {0xB4D, 0xB4D, C::Mn},
+    {0xB55, 0xB56, C::Mn}, {0xB57, 0xB57, C::Mc}, {0xB5C, 0xB5D, C::Lo}, {0xB5F, 0xB61, C::Lo},
+    {0xB62, 0xB63, C::Mn}, {0xB66, 0xB6F, C::Nd}, {0xB70, 0xB70, C::So}, {0xB71, 0xB71, C::Lo},
+    {0xB72, 0xB77, C::No}, {0xB82, 0xB82, C::Mn}, {0xB83, 0xB83, C::Lo}, {0xB85, 0xB8A, C::Lo},
+    {0xB8E, 0xB90, C::Lo}, {0xB92, 0xB95, C::Lo}, {0xB99, 0xB9A, C::Lo}, {0xB9C, 0xB9C, C::Lo},
+    {0xB9E, 0xB9F, C::Lo}, {0xBA3, 0xBA4, C::Lo}, {0xBA8, 0xBAA, C::Lo}, {0xBAE, 0xBB9, C::Lo},
+    {0xBBE, 0xBBF, C::Mc}, {0xBC0, 0xBC0, C::Mn}, {0xBC1, 0xBC2, C::Mc}, {0xBC6, 0xBC8, C::Mc},
+    {0xBCA, 0xBCC, C::Mc}, {0xBCD, 0xBCD, C::Mn}, {0xBD0, 0xBD0, C::Lo}, {0xBD7, 0xBD7, C::Mc},
+    {0xBE6, 0xBEF, C::Nd}, {0xBF0, 0xBF2, C::No}, {0xBF3, 0xBF8, C::So}, {0xBF9, 0xBF9, C::Sc},
+    {0xBFA, 0xBFA, C::So}, {0xC00, 0xC00, C::Mn}, {0xC01, 0xC03, C::Mc}, {0xC04, 0xC04, C::Mn},
+    {0xC05, 0xC0C, C::Lo}, {0xC0E, 0xC10, C::Lo}, {0xC12, 0xC28, C::Lo}, {0xC2A, 0xC39, C::Lo},
+    {0xC3C, 0xC3C, C::Mn}, {0xC3D, 0xC3D, C::Lo}, {0xC3E, 0xC40, C::Mn}, {0xC41, 0xC44, C::Mc},
+    {0xC46, 0xC48, C::Mn}, {0xC4A, 0xC4D, C::Mn}, {0xC55, 0xC56, C::Mn}, {0xC58, 0xC5A, C::Lo},
+    {0xC5D, 0xC5D, C::Lo}, {0xC60, 0xC61, C::Lo}, {0xC62, 0xC63, C::Mn}, {0xC66, 0xC6F, C::Nd},
+    {0xC77, 0xC77, C::Po}, {0xC78, 0xC7E, C::No}, {0xC7F, 0xC7F, C::So}, {0xC80, 0xC80, C::Lo},
+    {0xC81, 0xC81, C::Mn}, {0xC82, 0xC83, C::Mc}, {0xC84, 0xC84, C::Po}, {0xC85, 0xC8C, C::Lo},
+    {0xC8E, 0xC90, C::Lo}, {0xC92, 0xCA8, C::Lo}, {0xCAA, 0xCB3, C::Lo}, {0xCB5, 0xCB9, C::Lo},
+    {0xCBC, 0xCBC, C::Mn}, {0xCBD, 0xCBD, C::Lo}, {0xCBE, 0xCBE, C::Mc}, {0xCBF, 0xCBF, C::Mn},
+    {0xCC0, 0xCC4, C::Mc}, {0xCC6, 0xCC6, C::Mn}, {0xCC7, 0xCC8, C::Mc}, {0xCCA, 0xCCB, C::Mc},
+    {0xCCC, 0xCCD, C::Mn}, {0xCD5, 0xCD6, C::Mc}, {0xCDD, 0xCDE, C::Lo}, {0xCE0, 0xCE1, C::Lo},
+    {0xCE2, 0xCE3, C::Mn}, {0xCE6, 0xCEF, C::Nd}, {0xCF1, 0xCF2, C::Lo}, {0xCF3, 0xCF3, C::Mc},
+    {0xD00, 0xD01, C::Mn}, {0xD02, 0xD03, C::Mc}, {0xD04, 0xD0C, C::Lo}, {0xD0E, 0xD10, C::Lo},
+    {0xD12, 0xD3A, C::Lo}, {0xD3B, 0xD3C, C::Mn}, {0xD3D, 0xD3D, C::Lo}, {0xD3E, 0xD40, C::Mc},
+    {0xD41, 0xD44, C::Mn}, {0xD46, 0xD48, C::Mc}, {0xD4A, 0xD4C, C::Mc}, {0xD4D, 0xD4D, C::Mn},
+    {0xD4E, 0xD4E, C::Lo}, {0xD4F, 0xD4F, C::So}, {0xD54, 0xD56, C::Lo}, {0xD57, 0xD57, C::Mc},
+    {0xD58, 0xD5E, C::No}, {0xD5F, 0xD61, C::Lo}, {0xD62, 0xD63, C::Mn}, {0xD66, 0xD6F, C::Nd},
+    {0xD70, 0xD78, C::No}, {0xD79, 0xD79, C::So}, {0xD7A, 0xD7F, C::Lo}, {0xD81, 0xD81, C::Mn},
+    {0xD82, 0xD83, C::Mc}, {0xD85, 0xD96, C::Lo}, {0xD9A, 0xDB1, C::Lo}, {0xDB3, 0xDBB, C::Lo},
+    {0xDBD, 0xDBD, C::Lo}, {0xDC0, 0xDC6, C::Lo}, {0xDCA, 0xDCA, C::Mn}, {0xDCF, 0xDD1, C::Mc},
+    {0xDD2, 0xDD4, C::Mn}, {0xDD6, 0xDD6, C::Mn}, {0xDD8, 0xDDF, C::Mc}, {0xDE6, 0xDEF, C::Nd},
+    {0xDF2, 0xDF3, C::Mc}, {0xDF4, 0xDF4, C::Po}, {0xE01, 0xE30, C::Lo}, {0xE31, 0xE31, C::Mn},
+    {0xE32, 0xE33, C::Lo}, {0xE34, 0xE3A, C::Mn}, {0xE3F, 0xE3F, C::Sc}, {0xE40, 0xE45, C::Lo},
+    {0xE46, 0xE46, C::Lm}, {0xE47, 0xE4E, C::Mn}, {0xE4F, 0xE4F, C::Po}, {0xE50, 0xE59, C::Nd},
+    {0xE5A, 0xE5B, C::Po}, {0xE81, 0xE82, C::Lo}, {0xE84, 0xE84, C::Lo}, {0xE86, 0xE8A, C::Lo},
+    {0xE8C, 0xEA3, C::Lo}, {0xEA5, 0xEA5, C::Lo}, {0xEA7, 0xEB0, C::Lo}, {0xEB1, 0xEB1, C::Mn},
+    {0xEB2, 0xEB3, C::Lo}, {0xEB4, 0xEBC, C::Mn}, {0xEBD, 0xEBD, C::Lo}, {0xEC0, 0xEC4, C::Lo},
+    {0xEC6, 0xEC6, C::Lm}, {0xEC8, 0xECE, C::Mn}, {0xED0, 0xED9, C::Nd}, {0xEDC, 0xEDF, C::Lo},
+    {0xF00, 0xF00, C::Lo}, {0xF01, 0xF03, C::So}, {0xF04, 0xF12, C::Po}, {0xF13, 0xF13, C::So},
+    {0xF14, 0xF14, C::Po}, {0xF15, 0xF17, C::So}, {0xF18, 0xF19, C::Mn}, {0xF1A, 0xF1F, C::So},
+    {0xF20, 0xF29, C::Nd}, {0xF2A, 0xF33, C::No}, {0xF34, 0xF34, C::So}, {0xF35, 0xF35, C::Mn},
+    {0xF36, 0xF36, C::So}, {0xF37, 0xF37, C::Mn}, {0xF38, 0xF38, C::So}, {0xF39, 0xF39, C::Mn},
+    {0xF3A, 0xF3A, C::Ps}, {0xF3B, 0xF3B, C::Pe}, {0xF3C, 0xF3C, C::Ps}, {0xF3D, 0xF3D, C::Pe},
+    {0xF3E, 0xF3F, C::Mc}, {0xF40, 0xF47, C::Lo}, {0xF49, 0xF6C, C::Lo}, {0xF71, 0xF7E, C::Mn},
+    {0xF7F, 0xF7F, C::Mc}, {0xF80, 0xF84, C::Mn}, {0xF85, 0xF85, C::Po}, {0xF86, 0xF87, C::Mn},
+    {0xF88, 0xF8C, C::Lo}, {0xF8D, 0xF97, C::Mn}, {0xF99, 0xFBC, C::Mn}, {0xFBE, 0xFC5, C::So},
+    {0xFC6, 0xFC6, C::Mn}, {0xFC7, 0xFCC, C::So}, {0xFCE, 0xFCF, C::So}, {0xFD0, 0xFD4, C::Po},
+    {0xFD5, 0xFD8, C::So}, {0xFD9, 0xFDA, C::Po}, {0x1000, 0x102A, C::Lo}, {0x102B, 0x102C, C::Mc},
+    {0x102D, 0x1030, C::Mn}, {0x1031, 0x1031, C::Mc}, {0x1032, 0x1037, C::Mn},
+    {0x1038, 0x1038, C::Mc}, {0x1039, 0x103A, C::Mn}, {0x103B, 0x103C, C::Mc},
+    {0x103D, 0x103E, C::Mn}, {0x103F, 0x103F, C::Lo}, {0x1040, 0x1049, C::Nd},
+    {0x104A, 0x104F, C::Po}, {0x1050, 0x1055, C::Lo}, {0x1056, 0x1057, C::Mc},
+    {0x1058, 0x1059, C::Mn}, {0x105A, 0x105D, C::Lo}, {0x105E, 0x1060, C::Mn},
+    {0x1061, 0x1061, C::Lo}, {0x1062, 0x1064, C::Mc}, {0x1065, 0x1066, C::Lo},
+    {0x1067, 0x106D, C::Mc}, {0x106E, 0x1070, C::Lo}, {0x1071, 0x1074, C::Mn},
+    {0x1075, 0x1081, C::Lo}, {0x1082, 0x1082, C::Mn}, {0x1083, 0x1084, C::Mc},
+    {0x1085, 0x1086, C::Mn}, {0x1087, 0x108C, C::Mc}, {0x108D, 0x108D, C::Mn},
+    {0x108E, 0x108E, C::Lo}, {0x108F, 0x108F, C::Mc}, {0x1090, 0x1099, C::Nd},
+    {0x109A, 0x109C, C::Mc}, {0x109D, 0x109D, C::Mn}, {0x109E, 0x109F, C::So},
+    {0x10A0, 0x10C5, C::Lu}, {0x10C7, 0x10C7, C::Lu}, {0x10CD, 0x10CD, C::Lu},
+    {0x10D0, 0x10FA, C::Ll}, {0x10FB, 0x10FB, C::Po}, {0x10FC, 0x10FC, C::Lm},
+    {0x10FD, 0x10FF, C::Ll}, {0x1100, 0x1248, C::Lo}, {0x124A, 0x124D, C::Lo},
+    {0x1250, 0x1256, C::Lo}, {0x1258, 0x1258, C::Lo}, {0x125A, 0x125D, C::Lo},
+    {0x1260, 0x1288, C::Lo}, {0x128A, 0x128D, C::Lo}, {0x1290, 0x12B0, C::Lo},
+    {0x12B2, 0x12B5, C::Lo}, {0x12B8, 0x12BE, C::Lo}, {0x12C0, 0x12C0, C::Lo},
+    {0x12C2, 0x12C5, C::Lo}, {0x12C8, 0x12D6, C::Lo}, {0x12D8, 0x1310, C::Lo},
+    {0x1312, 0x1315, C::Lo}, {0x1318, 0x135A, C::Lo}, {0x135D, 0x135F, C::Mn},
+    {0x1360, 0x1368, C::Po}, {0x1369, 0x137C, C::No}, {0x1380, 0x138F, C::Lo},
+    {0x1390, 0x1399, C::So}, {0x13A0, 0x13F5, C::Lu}, {0x13F8, 0x13FD, C::Ll},
+    {0x1400, 0x1400, C::Pd}, {0x1401, 0x166C, C::Lo}, {0x166D, 0x166D, C::So},
+    {0x166E, 0x166E, C::Po}, {0x166F, 0x167F, C::Lo}, {0x1680, 0x1680, C::Zs},
+    {0x1681, 0x169A, C::Lo}, {0x169B, 0x169B, C::Ps}, {0x169C, 0x169C, C::Pe},
+    {0x16A0, 0x16EA, C::Lo}, {0x16EB, 0x16ED, C::Po}, {0x16EE, 0x16F0, C::Nl},
+    {0x16F1, 0x16F8, C::Lo}, {0x1700, 0x1711, C::Lo}, {0x1712, 0x1714, C::Mn},
+    {0x1715, 0x1715, C::Mc}, {0x171F, 0x1731, C::Lo}, {0x1732, 0x1733, C::Mn},
+    {0x1734, 0x1734, C::Mc}, {0x1735, 0x1736, C::Po}, {0x1740, 0x1751, C::Lo},
+    {0x1752, 0x1753, C::Mn}, {0x1760, 0x176C, C::Lo}, {0x176E, 0x1770, C::Lo},
+    {0x1772, 0x1773, C::Mn}, {0x1780, 0x17B3, C::Lo}, {0x17B4, 0x17B5, C::Mn},
+    {0x17B6, 0x17B6, C::Mc}, {0x17B7, 0x17BD, C::Mn}, {0x17BE, 0x17C5, C::Mc},
+    {0x17C6, 0x17C6, C::Mn}, {0x17C7, 0x17C8, C::Mc}, {0x17C9, 0x17D3, C::Mn},
+    {0x17D4, 0x17D6, C::Po}, {0x17D7, 0x17D7, C::Lm}, {0x17D8, 0x17DA, C::Po},
+    {0x17DB, 0x17DB, C::Sc}, {0x17DC, 0x17DC, C::Lo}, {0x17DD, 0x17DD, C::Mn},
+    {0x17E0, 0x17E9, C::Nd}, {0x17F0, 0x17F9, C::No}, {0x1800, 0x1805, C::Po},
+    {0x1806, 0x1806, C::Pd}, {0x1807, 0x180A, C::Po}, {0x180B, 0x180D, C::Mn},
+    {0x180E, 0x180E, C::Cf}, {0x180F, 0x180F, C::Mn}, {0x1810, 0x1819, C::Nd},
+    {0x1820, 0x1842, C::Lo}, {0x1843, 0x1843, C::Lm}, {0x1844, 0x1878, C::Lo},
+    {0x1880, 0x1884, C::Lo}, {0x1885, 0x1886, C::Mn}, {0x1887, 0x18A8, C::Lo},
+    {0x18A9, 0x18A9, C::Mn}, {0x18AA, 0x18AA, C::Lo}, {0x18B0, 0x18F5, C::Lo},
+    {0x1900, 0x191E, C::Lo}, {0x1920, 0x1922, C::Mn}, {0x1923, 0x1926, C::Mc},
+    {0x1927, 0x1928, C::Mn}, {0x1929, 0x192B, C::Mc}, {0x1930, 0x1931, C::Mc},
+    {0x1932, 0x1932, C::Mn}, {0x1933, 0x1938, C::Mc}, {0x1939, 0x193B, C::Mn},
+    {0x1940, 0x1940, C::So}, {0x1944, 0x1945, C::Po}, {0x1946, 0x194F, C::Nd},
+    {0x1950, 0x196D, C::Lo}, {0x1970, 0x1974, C::Lo}, {0x1980, 0x19AB, C::Lo},
+    {0x19B0, 0x19C9, C::Lo}, {0x19D0, 0x19D9, C::Nd}, {0x19DA, 0x19DA, C::No},
+    {0x19DE, 0x19FF, C::So}, {0x1A00, 0x1A16, C::Lo}, {0x1A17, 0x1A18, C::Mn},
+    {0x1A19, 0x1A1A, C::Mc}, {0x1A1B, 0x1A1B, C::Mn}, {0x1A1E, 0x1A1F, C::Po},
+    {0x1A20, 0x1A54, C::Lo}, {0x1A55, 0x1A55, C::Mc}, {0x1A56, 0x1A56, C::Mn},
+    {0x1A57, 0x1A57, C::Mc}, {0x1A58, 0x1A5E, C::Mn}, {0x1A60, 0x1A60, C::Mn},
+    {0x1A61, 0x1A61, C::Mc}, {0x1A62, 0x1A62, C::Mn}, {0x1A63, 0x1A64, C::Mc},
+    {0x1A65, 0x1A6C, C::Mn}, {0x1A6D, 0x1A72, C::Mc}, {0x1A73, 0x1A7C, C::Mn},
+    {0x1A7F, 0x1A7F, C::Mn}, {0x1A80, 0x1A89, C::Nd}, {0x1A90, 0x1A99, C::Nd},
+    {0x1AA0, 0x1AA6, C::Po}, {0x1AA7, 0x1AA7, C::Lm}, {0x1AA8, 0x1AAD, C::Po},
+    {0x1AB0, 0x1ABD, C::Mn}, {0x1ABE, 0x1ABE, C::Me}, {0x1ABF, 0x1ACE, C::Mn},
+    {0x1B00, 0x1B03, C::Mn}, {0x1B04, 0x1B04, C::Mc}, {0x1B05, 0x1B33, C::Lo},
+    {0x1B34, 0x1B34, C::Mn}, {0x1B35, 0x1B35, C::Mc}, {0x1B36, 0x1B3A, C::Mn},
+    {0x1B3B, 0x1B3B, C::Mc}, {0x1B3C, 0x1B3C, C::Mn}, {0x1B3D, 0x1B41, C::Mc},
+    {0x1B42, 0x1B42, C::Mn}, {0x1B43, 0x1B44, C::Mc}, {0x1B45, 0x1B4C, C::Lo},
+    {0x1B50, 0x1B59, C::Nd}, {0x1B5A, 0x1B60, C::Po}, {0x1B61, 0x1B6A, C::So},
+    {0x1B6B, 0x1B73, C::Mn}, {0x1B74, 0x1B7C, C::So}, {0x1B7D, 0x1B7E, C::Po},
+    {0x1B80, 0x1B81, C::Mn}, {0x1B82, 0x1B82, C::Mc}, {0x1B83, 0x1BA0, C::Lo},
+    {0x1BA1, 0x1BA1, C::Mc}, {0x1BA2, 0x1BA5, C::Mn}, {0x1BA6, 0x1BA7, C::Mc},
+    {0x1BA8, 0x1BA9, C::Mn}, {0x1BAA, 0x1BAA, C::Mc}, {0x1BAB, 0x1BAD, C::Mn},
+    {0x1BAE, 0x1BAF, C::Lo}, {0x1BB0, 0x1BB9, C::Nd}, {0x1BBA, 0x1BE5, C::Lo},
+    {0x1BE6, 0x1BE6, C::Mn}, {0x1BE7, 0x1BE7, C::Mc}, {0x1BE8, 0x1BE9, C::Mn},
+    {0x1BEA, 0x1BEC, C::Mc}, {0x1BED, 0x1BED, C::Mn}, {0x1BEE, 0x1BEE, C::Mc},
+    {0x1BEF, 0x1BF1, C::Mn}, {0x1BF2, 0x1BF3, C::Mc}, {0x1BFC, 0x1BFF, C::Po},
+    {0x1C00, 0x1C23, C::Lo}, {0x1C24, 0x1C2B, C::Mc}, {0x1C2C, 0x1C33, C::Mn},
+    {0x1C34, 0x1C35, C::Mc}, {0x1C36, 0x1C37, C::Mn}, {0x1C3B, 0x1C3F, C::Po},
+    {0x1C40, 0x1C49, C::Nd}, {0x1C4D, 0x1C4F, C::Lo}, {0x1C50, 0x1C59, C::Nd},
+    {0x1C5A, 0x1C77, C::Lo}, {0x1C78, 0x1C7D, C::Lm}, {0x1C7E, 0x1C7F, C::Po},
+    {0x1C80, 0x1C88, C::Ll}, {0x1C90, 0x1CBA, C::Lu}, {0x1CBD, 0x1CBF, C::Lu},
+    {0x1CC0, 0x1CC7, C::Po}, {0x1CD0, 0x1CD2, C::Mn}, {0x1CD3, 0x1CD3, C::Po},
+    {0x1CD4, 0x1CE0, C::Mn}, {0x1CE1, 0x1CE1, C::Mc}, {0x1CE2, 0x1CE8, C::Mn},
+    {0x1CE9, 0x1CEC, C::Lo}, {0x1CED, 0x1CED, C::Mn}, {0x1CEE, 0x1CF3, C::Lo},
+    {0x1CF4, 0x1CF4, C::Mn}, {0x1CF5, 0x1CF6, C::Lo}, {0x1CF7, 0x1CF7, C::Mc},
+    {0x1CF8, 0x1CF9, C::Mn}, {0x1CFA, 0x1CFA, C::Lo}, {0x1D00, 0x1D2B, C::Ll},
+    {0x1D2C, 0x1D6A, C::Lm}, {0x1D6B, 0x1D77, C::Ll}, {0x1D78, 0x1D78, C::Lm},
+    {0x1D79, 0x1D9A, C::Ll}, {0x1D9B, 0x1DBF, C::Lm}, {0x1DC0, 0x1DFF, C::Mn},
+    {0x1E00, 0x1E00, C::Lu}, {0x1E01, 0x1E01, C::Ll}, {0x1E02, 0x1E02, C::Lu},
+    {0x1E03, 0x1E03, C::Ll}, {0x1E04, 0x1E04, C::Lu}, {0x1E05, 0x1E05, C::Ll},
+    {0x1E06, 0x1E06, C::Lu}, {0x1E07, 0x1E07, C::Ll}, {0x1E08, 0x1E08, C::Lu},
+    {0x1E09, 0x1E09, C::Ll}, {0x1E0A, 0x1E0A, C::Lu}, {0x1E0B, 0x1E0B, C::Ll},
+    {0x1E0C, 0x1E0C, C::Lu}, {0x1E0D, 0x1E0D, C::Ll}, {0x1E0E, 0x1E0E, C::Lu},
+    {0x1E0F, 0x1E0F, C::Ll}, {0x1E10, 0x1E10, C::Lu}, {0x1E11, 0x1E11, C::Ll},
+    {0x1E12, 0x1E12, C::Lu}, {0x1E13, 0x1E13, C::Ll}, {0x1E14, 0x1E14, C::Lu},
+    {0x1E15, 0x1E15, C::Ll}, {0x1E16, 0x1E16, C::Lu}, {0x1E17, 0x1E17, C::Ll},
+    {0x1E18, 0x1E18, C::Lu}, {0x1E19, 0x1E19, C::Ll}, {0x1E1A, 0x1E1A, C::Lu},
+    {0x1E1B, 0x1E1B, C::Ll}, {0x1E1C, 0x1E1C, C::Lu}, {0x1E1D, 0x1E1D, C::Ll},
+    {0x1E1E, 0x1E1E, C::Lu}, {0x1E1F, 0x1E1F, C::Ll}, {0x1E20, 0x1E20, C::Lu},
+    {0x1E21, 0x1E21, C::Ll}, {0x1E22, 0x1E22, C::Lu}, {0x1E23, 0x1E23, C::Ll},
+    {0x1E24, 0x1E24, C::Lu}, {0x1E25, 0x1E25, C::Ll}, {0x1E26, 0x1E26, C::Lu},
+    {0x1E27, 0x1E27, C::Ll}, {0x1E28, 0x1E28, C::Lu}, {0x1E29, 0x1E29, C::Ll},
+    {0x1E2A, 0x1E2A, C::Lu}, {0x1E2B, 0x1E2B, C::Ll}, {0x1E2C, 0x1E2C, C::Lu},
+    {0x1E2D, 0x1E2D, C::Ll}, {0x1E2E, 0x1E2E, C::Lu}, {0x1E2F, 0x1E2F, C::Ll},
+    {0x1E30, 0x1E30, C::Lu}, {0x1E31, 0x1E31, C::Ll}, {0x1E32, 0x1E32, C::Lu},
+    {0x1E33, 0x1E33, C::Ll}, {0x1E34, 0x1E34, C::Lu}, {0x1E35, 0x1E35, C::Ll},
+    {0x1E36, 0x1E36, C::Lu}, {0x1E37, 0x1E37, C::Ll}, {0x1E38, 0x1E38, C::Lu},
+    {0x1E39, 0x1E39, C::Ll}, {0x1E3A, 0x1E3A, C::Lu}, {0x1E3B, 0x1E3B, C::Ll},
+    {0x1E3C, 0x1E3C, C::Lu}, {0x1E3D, 0x1E3D, C::Ll}, {0x1E3E, 0x1E3E, C::Lu},
+    {0x1E3F, 0x1E3F, C::Ll}, {0x1E40, 0x1E40, C::Lu}, {0x1E41, 0x1E41, C::Ll},
+    {0x1E42, 0x1E42, C::Lu}, {0x1E43, 0x1E43, C::Ll}, {0x1E44, 0x1E44, C::Lu},
+    {0x1E45, 0x1E45, C::Ll}, {0x1E46, 0x1E46, C::Lu}, {0x1E47, 0x1E47, C::Ll},
+    {0x1E48, 0x1E48, C::Lu}, {0x1E49, 0x1E49, C::Ll}, {0x1E4A, 0x1E4A, C::Lu},
+    {0x1E4B, 0x1E4B, C::Ll}, {0x1E4C, 0x1E4C, C::Lu}, {0x1E4D, 0x1E4D, C::Ll},
+    {0x1E4E, 0x1E4E, C::Lu}, {0x1E4F, 0x1E4F, C::Ll}, {0x1E50, 0x1E50, C::Lu},
+    {0x1E51, 0x1E51, C::Ll}, {0x1E52, 0x1E52, C::Lu}, {0x1E53, 0x1E53, C::Ll},
+    {0x1E54, 0x1E54, C::Lu}, {0x1E55, 0x1E55, C::Ll}, {0x1E56, 0x1E56, C::Lu},
+    {0x1E57, 0x1E57, C::Ll}, {0x1E58, 0x1E58, C::Lu}, {0x1E59, 0x1E59, C::Ll},
+    {0x1E5A, 0x1E5A, C::Lu}, {0x1E5B, 0x1E5B, C::Ll}, {0x1E5C, 0x1E5C, C::Lu},
+    {0x1E5D, 0x1E5D, C::Ll}, {0x1E5E, 0x1E5E, C::Lu}, {0x1E5F, 0x1E5F, C::Ll},
+    {0x1E60, 0x1E60, C::Lu}, {0x1E61, 0x1E61, C::Ll}, {0x1E62, 0x1E62, C::Lu},
+    {0x1E63, 0x1E63, C::Ll}, {0x1E64, 0x1E64, C::Lu}, {0x1E65, 0x1E65, C::Ll},
+    {0x1E66, 0x1E66, C::Lu}, {0x1E67, 0x1E67, C::Ll}, {0x1E68, 0x1E68, C::Lu},
+    {0x1E69, 0x1E69, C::Ll}, {0x1E6A, 0x1E6A, C::Lu}, {0x1E6B, 0x1E6B, C::Ll},
+    {0x1E6C, 0x1E6C, C::Lu}, {0x1E6D, 0x1E6D, C::Ll}, {0x1E6E, 0x1E6E, C::Lu},
+    {0x1E6F, 0x1E6F, C::Ll}, {0x1E70, 0x1E70, C::Lu}, {0x1E71, 0x1E71, C::Ll},
+    {0x1E72, 0x1E72, C::Lu}, {0x1E73, 0x1E73, C::Ll}, {0x1E74, 0x1E74, C::Lu},
+    {0x1E75, 0x1E75, C::Ll}, {0x1E76, 0x1E76, C::Lu}, {0x1E77, 0x1E77, C::Ll},
+    {0x1E78, 0x1E78, C::Lu}, {0x1E79, 0x1E79, C::Ll}, {0x1E7A, 0x1E7A, C::Lu},
+    {0x1E7B, 0x1E7B, C::Ll}, {0x1E7C, 0x1E7C, C::Lu}, {0x1E7D, 0x1E7D, C::Ll},
+    {0x1E7E, 0x1E7E, C::Lu}, {0x1E7F, 0x1E7F, C::Ll}, {0x1E80, 0x1E80, C::Lu},
+    {0x1E81, 0x1E81, C::Ll}, {0x1E82, 0x1E82, C::Lu}, {0x1E83, 0x1E83, C::Ll},
+    {0x1E84, 0x1E84, C::Lu}, {0x1E85, 0x1E85, C::Ll}, {0x1E86, 0x1E86, C::Lu},
+    {0x1E87, 0x1E87, C::Ll}, {0x1E88, 0x1E88, C::Lu}, {0x1E89, 0x1E89, C::Ll},
+    {0x1E8A, 0x1E8A, C::Lu}, {0x1E8B, 0x1E8B, C::Ll}, {0x1E8C, 0x1E8C, C::Lu},
+    {0x1E8D, 0x1E8D, C::Ll}, {0x1E8E, 0x1E8E, C::Lu}, {0x1E8F, 0x1E8F, C::Ll},
+    {0x1E90, 0x1E90, C::Lu}, {0x1E91, 0x1E91, C::Ll}, {0x1E92, 0x1E92, C::Lu},
+    {0x1E93, 0x1E93, C::Ll}, {0x1E94, 0x1E94, C::Lu}, {0x1E95, 0x1E9D, C::Ll},
+    {0x1E9E, 0x1E9E, C::Lu}, {0x1E9F, 0x1E9F, C::Ll}, {0x1EA0, 0x1EA0, C::Lu},
+    {0x1EA1, 0x1EA1, C::Ll}, {0x1EA2, 0x1EA2, C::Lu}, {0x1EA3, 0x1EA3, C::Ll},
+    {0x1EA4, 0x1EA4, C::Lu}, {0x1EA5, 0x1EA5, C::Ll}, {0x1EA6, 0x1EA6, C::Lu},
+    {0x1EA7, 0x1EA7, C::Ll}, {0x1EA8, 0x1EA8, C::Lu}, {0x1EA9, 0x1EA9, C::Ll},
+    {0x1EAA, 0x1EAA, C::Lu}, {0x1EAB, 0x1EAB, C::Ll}, {0x1EAC, 0x1EAC, C::Lu},
+    {0x1EAD, 0x1EAD, C::Ll}, {0x1EAE, 0x1EAE, C::Lu}, {0x1EAF, 0x1EAF, C::Ll},
+    {0x1EB0, 0x1EB0, C::Lu}, {0x1EB1, 0x1EB1, C::Ll}, {0x1EB2, 0x1EB2, C::Lu},
+    {0x1EB3, 0x1EB3, C::Ll}, {0x1EB4, 0x1EB4, C::Lu}, {0x1EB5, 0x1EB5, C::Ll},
+    {0x1EB6, 0x1EB6, C::Lu}, {0x1EB7, 0x1EB7, C::Ll}, {0x1EB8, 0x1EB8, C::Lu},
+    {0x1EB9, 0x1EB9, C::Ll}, {0x1EBA, 0x1EBA, C::Lu}, {0x1EBB, 0x1EBB, C::Ll},
+    {0x1EBC, 0x1EBC, C::Lu}, {0x1EBD, 0x1EBD, C::Ll}, {0x1EBE, 0x1EBE, C::Lu},
+    {0x1EBF, 0x1EBF, C::Ll}, {0x1EC0, 0x1EC0, C::Lu}, {0x1EC1, 0x1EC1, C::Ll},
+    {0x1EC2, 0x1EC2, C::Lu}, {0x1EC3, 0x1EC3, C::Ll}, {0x1EC4, 0x1EC4, C::Lu},
+    {0x1EC5, 0x1EC5, C::Ll}, {0x1EC6, 0x1EC6, C::Lu}, {0x1EC7, 0x1EC7, C::Ll},
+    {0x1EC8, 0x1EC8, C::Lu}, {0x1EC9, 0x1EC9, C::Ll}, {0x1ECA, 0x1ECA, C::Lu},
+    {0x1ECB, 0x1ECB, C::Ll}, {0x1ECC, 0x1ECC, C::Lu}, {0x1ECD, 0x1ECD, C::Ll},
+    {0x1ECE, 0x1ECE, C::Lu}, {0x1ECF, 0x1ECF, C::Ll}, {0x1ED0, 0x1ED0, C::Lu},
+    {0x1ED1, 0x1ED1, C::Ll}, {0x1ED2, 0x1ED2, C::Lu}, {0x1ED3, 0x1ED3, C::Ll},
+    {0x1ED4, 0x1ED4, C::Lu}, {0x1ED5, 0x1ED5, C::Ll}, {0x1ED6, 0x1ED6, C::Lu},
+    {0x1ED7, 0x1ED7, C::Ll}, {0x1ED8, 0x1ED8, C::Lu}, {0x1ED9, 0x1ED9, C::Ll},
+    {0x1EDA, 0x1EDA, C::Lu}, {0x1EDB, 0x1EDB, C::Ll}, {0x1EDC, 0x1EDC, C::Lu},
+    {0x1EDD, 0x1EDD, C::Ll}, {0x1EDE, 0x1EDE, C::Lu}, {0x1EDF, 0x1EDF, C::Ll},
+    {0x1EE0, 0x1EE0, C::Lu}, {0x1EE1, 0x1EE1, C::Ll}, {0x1EE2, 0x1EE2, C::Lu},
+    {0x1EE3, 0x1EE3, C::Ll}, {0x1EE4, 0x1EE4, C::Lu}, {0x1EE5, 0x1EE5, C::Ll},
+    {0x1EE6, 0x1EE6, C::Lu}, {0x1EE7, 0x1EE7, C::Ll}, {0x1EE8, 0x1EE8, C::Lu},
+    {0x1EE9, 0x1EE9, C::Ll}, {0x1EEA, 0x1EEA, C::Lu}, {0x1EEB, 0x1EEB, C::Ll},
+    {0x1EEC, 0x1EEC, C::Lu}, {0x1EED, 0x1EED, C::Ll}, {0x1EEE, 0x1EEE, C::Lu},
+    {0x1EEF, 0x1EEF, C::Ll}, {0x1EF0, 0x1EF0, C::Lu}, {0x1EF1, 0x1EF1, C::Ll},
+    {0x1EF2, 0x1EF2, C::Lu}, {0x1EF3, 0x1EF3, C::Ll}, {0x1EF4, 0x1EF4, C::Lu},
+    {0x1EF5, 0x1EF5, C::Ll}, {0x1EF6, 0x1EF6, C::Lu}, {0x1EF7, 0x1EF7, C::Ll},
+    {0x1EF8, 0x1EF8, C::Lu}, {0x1EF9, 0x1EF9, C::Ll}, {0x1EFA, 0x1EFA, C::Lu},
+    {0x1EFB, 0x1EFB, C::Ll}, {0x1EFC, 0x1EFC, C::Lu}, {0x1EFD, 0x1EFD, C::Ll},
+    {0x1EFE, 0x1EFE, C::Lu}, {0x1EFF, 0x1F07, C::Ll}, {0x1F08, 0x1F0F, C::Lu},
+    {0x1F10, 0x1F15, C::Ll}, {0x1F18, 0x1F1D, C::Lu}, {0x1F20, 0x1F27, C::Ll},
+    {0x1F28, 0x1F2F, C::Lu}, {0x1F30, 0x1F37, C::Ll}, {0x1F38, 0x1F3F, C::Lu},
+    {0x1F40, 0x1F45, C::Ll}, {0x1F48, 0x1F4D, C::Lu}, {0x1F50, 0x1F57, C::Ll},
+    {0x1F59, 0x1F59, C::Lu}, {0x1F5B, 0x1F5B, C::Lu}, {0x1F5D, 0x1F5D, C::Lu},
+    {0x1F5F, 0x1F5F, C::Lu}, {0x1F60, 0x1F67, C::Ll}, {0x1F68, 0x1F6F, C::Lu},
+    {0x1F70, 0x1F7D, C::Ll}, {0x1F80, 0x1F87, C::Ll}, {0x1F88, 0x1F8F, C::Lt},
+    {0x1F90, 0x1F97, C::Ll}, {0x1F98, 0x1F9F, C::Lt}, {0x1FA0, 0x1FA7, C::Ll},
+    {0x1FA8, 0x1FAF, C::Lt}, {0x1FB0, 0x1FB4, C::Ll}, {0x1FB6, 0x1FB7, C::Ll},
+    {0x1FB8, 0x1FBB, C::Lu}, {0x1FBC, 0x1FBC, C::Lt}, {0x1FBD, 0x1FBD, C::Sk},
+    {0x1FBE, 0x1FBE, C::Ll}, {0x1FBF, 0x1FC1, C::Sk}, {0x1FC2, 0x1FC4, C::Ll},
+    {0x1FC6, 0x1FC7, C::Ll}, {0x1FC8, 0x1FCB, C::Lu}, {0x1FCC, 0x1FCC, C::Lt},
+    {0x1FCD, 0x1FCF, C::Sk}, {0x1FD0, 0x1FD3, C::Ll}, {0x1FD6, 0x1FD7, C::Ll},
+    {0x1FD8, 0x1FDB, C::Lu}, {0x1FDD, 0x1FDF, C::Sk}, {0x1FE0, 0x1FE7, C::Ll},
+    {0x1FE8, 0x1FEC, C::Lu}, {0x1FED, 0x1FEF, C::Sk}, {0x1FF2, 0x1FF4, C::Ll},
+    {0x1FF6, 0x1FF7, C::Ll}, {0x1FF8, 0x1FFB, C::Lu}, {0x1FFC, 0x1FFC, C::Lt},
+    {0x1FFD, 0x1FFE, C::Sk}, {0x2000, 0x200A, C::Zs}, {0x200B, 0x200F, C::Cf},
+    {0x2010, 0x2015, C::Pd}, {0x2016, 0x2017, C::Po}, {0x2018, 0x2018, C::Pi},
+    {0x2019, 0x2019, C::Pf}, {0x201A, 0x201A, C::Ps}, {0x201B, 0x201C, C::Pi},
+    {0x201D, 0x201D, C::Pf}, {0x201E, 0x201E, C::Ps}, {0x201F, 0x201F, C::Pi},
+    {0x2020, 0x2027, C::Po}, {0x2028, 0x2028, C::Zl}, {0x2029, 0x2029, C::Zp},
+    {0x202A, 0x202E, C::Cf}, {0x202F, 0x202F, C::Zs}, {0x2030, 0x2038, C::Po},
+    {0x2039, 0x2039, C::Pi}, {0x203A, 0x203A, C::Pf}, {0x203B, 0x203E, C::Po},
+    {0x203F, 0x2040, C::Pc}, {0x2041, 0x2043, C::Po}, {0x2044, 0x2044, C::Sm},
+    {0x2045, 0x2045, C::Ps}, {0x2046, 0x2046, C::Pe}, {0x2047, 0x2051, C::Po},
+    {0x2052, 0x2052, C::Sm}, {0x2053, 0x2053, C::Po}, {0x2054, 0x2054, C::Pc},
+    {0x2055, 0x205E, C::Po}, {0x205F, 0x205F, C::Zs}, {0x2060, 0x2064, C::Cf},
+    {0x2066, 0x206F, C::Cf}, {0x2070, 0x2070, C::No}, {0x2071, 0x2071, C::Lm},
+    {0x2074, 0x2079, C::No}, {0x207A, 0x207C, C::Sm}, {0x207D, 0x207D, C::Ps},
+    {0x207E, 0x207E, C::Pe}, {0x207F, 0x207F, C::Lm}, {0x2080, 0x2089, C::No},
+    {0x208A, 0x208C, C::Sm}, {0x208D, 0x208D, C::Ps}, {0x208E, 0x208E, C::Pe},
+    {0x2090, 0x209C, C::Lm}, {0x20A0, 0x20C0, C::Sc}, {0x20D0, 0x20DC, C::Mn},
+    {0x20DD, 0x20E0, C::Me}, {0x20E1, 0x20E1, C::Mn}, {0x20E2, 0x20E4, C::Me},
+    {0x20E5, 0x20F0, C::Mn}, {0x2100, 0x2101, C::So}, {0x2102, 0x2102, C::Lu},
+    {0x2103, 0x2106, C::So}, {0x2107, 0x2107, C::Lu}, {0x2108, 0x2109, C::So},
+    {0x210A, 0x210A, C::Ll}, {0x210B, 0x210D, C::Lu}, {0x210E, 0x210F, C::Ll},
+    {0x2110, 0x2112, C::Lu}, {0x2113, 0x2113, C::Ll}, {0x2114, 0x2114, C::So},
+    {0x2115, 0x2115, C::Lu}, {0x2116, 0x2117, C::So}, {0x2118, 0x2118, C::Sm},
+    {0x2119, 0x211D, C::Lu}, {0x211E, 0x2123, C::So}, {0x2124, 0x2124, C::Lu},
+    {0x2125, 0x2125, C::So}, {0x2126, 0x2126, C::Lu}, {0x2127, 0x2127, C::So},
+    {0x2128, 0x2128, C::Lu}, {0x2129, 0x2129, C::So}, {0x212A, 0x212D, C::Lu},
+    {0x212E, 0x212E, C::So}, {0x212F, 0x212F, C::Ll}, {0x2130, 0x2133, C::Lu},
+    {0x2134, 0x2134, C::Ll}, {0x2135, 0x2138, C::Lo}, {0x2139, 0x2139, C::Ll},
+    {0x213A, 0x213B, C::So}, {0x213C, 0x213D, C::Ll}, {0x213E, 0x213F, C::Lu},
+    {0x2140, 0x2144, C::Sm}, {0x2145, 0x2145, C::Lu}, {0x2146, 0x2149, C::Ll},
+    {0x214A, 0x214A, C::So}, {0x214B, 0x214B, C::Sm}, {0x214C, 0x214D, C::So},
+    {0x214E, 0x214E, C::Ll}, {0x214F, 0x214F, C::So}, {0x2150, 0x215F, C::No},
+    {0x2160, 0x2182, C::Nl}, {0x2183, 0x2183, C::Lu}, {0x2184, 0x2184, C::Ll},
+    {0x2185, 0x2188, C::Nl}, {0x2189, 0x2189, C::No}, {0x218A, 0x218B, C::So},
+    {0x2190, 0x2194, C::Sm}, {0x2195, 0x2199, C::So}, {0x219A, 0x219B, C::Sm},
+    {0x219C, 0x219F, C::So}, {0x21A0, 0x21A0, C::Sm}, {0x21A1, 0x21A2, C::So},
+    {0x21A3, 0x21A3, C::Sm}, {0x21A4, 0x21A5, C::So}, {0x21A6, 0x21A6, C::Sm},
+    {0x21A7, 0x21AD, C::So}, {0x21AE, 0x21AE, C::Sm}, {0x21AF, 0x21CD, C::So},
+    {0x21CE, 0x21CF, C::Sm}, {0x21D0, 0x21D1, C::So}, {0x21D2, 0x21D2, C::Sm},
+    {0x21D3, 0x21D3, C::So}, {0x21D4, 0x21D4, C::Sm}, {0x21D5, 0x21F3, C::So},
+    {0x21F4, 0x22FF, C::Sm}, {0x2300, 0x2307, C::So}, {0x2308, 0x2308, C::Ps},
+    {0x2309, 0x2309, C::Pe}, {0x230A, 0x230A, C::Ps}, {0x230B, 0x230B, C::Pe},
+    {0x230C, 0x231F, C::So}, {0x2320, 0x2321, C::Sm}, {0x2322, 0x2328, C::So},
+    {0x2329, 0x2329, C::Ps}, {0x232A, 0x232A, C::Pe}, {0x232B, 0x237B, C::So},
+    {0x237C, 0x237C, C::Sm}, {0x237D, 0x239A, C::So}, {0x239B, 0x23B3, C::Sm},
+    {0x23B4, 0x23DB, C::So}, {0x23DC, 0x23E1, C::Sm}, {0x23E2, 0x2426, C::So},
+    {0x2440, 0x244A, C::So}, {0x2460, 0x249B, C::No}, {0x249C, 0x24E9, C::So},
+    {0x24EA, 0x24FF, C::No}, {0x2500, 0x25B6, C::So}, {0x25B7, 0x25B7, C::Sm},
+    {0x25B8, 0x25C0, C::So}, {0x25C1, 0x25C1, C::Sm}, {0x25C2, 0x25F7, C::So},
+    {0x25F8, 0x25FF, C::Sm}, {0x2600, 0x266E, C::So}, {0x266F, 0x266F, C::Sm},
+    {0x2670, 0x2767, C::So}, {0x2768, 0x2768, C::Ps}, {0x2769, 0x2769, C::Pe},
+    {0x276A, 0x276A, C::Ps}, {0x276B, 0x276B, C::Pe}, {0x276C, 0x276C, C::Ps},
+    {0x276D, 0x276D, C::Pe}, {0x276E, 0x276E, C::Ps}, {0x276F, 0x276F, C::Pe},
+    {0x2770, 0x2770, C::Ps}, {0x2771, 0x2771, C::Pe}, {0x2772, 0x2772, C::Ps},
+    {0x2773, 0x2773, C::Pe}, {0x2774, 0x2774, C::Ps}, {0x2775, 0x2775, C::Pe},
+    {0x2776, 0x2793, C::No}, {0x2794, 0x27BF, C::So}, {0x27C0, 0x27C4, C::Sm},
+    {0x27C5, 0x27C5, C::Ps}, {0x27C6, 0x27C6, C::Pe}, {0x27C7, 0x27E5, C::Sm},
+    {0x27E6, 0x27E6, C::Ps}, {0x27E7, 0x27E7, C::Pe}, {0x27E8, 0x27E8, C::Ps},
+    {0x27E9, 0x27E9, C::Pe}, {0x27EA, 0x27EA, C::Ps}, {0x27EB, 0x27EB, C::Pe},
+    {0x27EC, 0x27EC, C::Ps}, {0x27ED, 0x27ED, C::Pe}, {0x27EE, 0x27EE, C::Ps},
+    {0x27EF, 0x27EF, C::Pe}, {0x27F0, 0x27FF, C::Sm}, {0x2800, 0x28FF, C::So},
+    {0x2900, 0x2982, C::Sm}, {0x2983, 0x2983, C::Ps}, {0x2984, 0x2984, C::Pe},
+    {0x2985, 0x2985, C::Ps}, {0x2986, 0x2986, C::Pe}, {0x2987, 0x2987, C::Ps},
+    {0x2988, 0x2988, C::Pe}, {0x2989, 0x2989, C::Ps}, {0x298A, 0x298A, C::Pe},
+    {0x298B, 0x298B, C::Ps}, {0x298C, 0x298C, C::Pe}, {0x298D, 0x298D, C::Ps},
+    {0x298E, 0x298E, C::Pe}, {0x298F, 0x298F, C::Ps}, {0x2990, 0x2990, C::Pe},
+    {0x2991, 0x2991, C::Ps}, {0x2992, 0x2992, C::Pe}, {0x2993, 0x2993, C::Ps},
+    {0x2994, 0x2994, C::Pe}, {0x2995, 0x2995, C::Ps}, {0x2996, 0x2996, C::Pe},
+    {0x2997, 0x2997, C::Ps}, {0x2998, 0x2998, C::Pe}, {0x2999, 0x29D7, C::Sm},
+    {0x29D8, 0x29D8, C::Ps}, {0x29D9, 0x29D9, C::Pe}, {0x29DA, 0x29DA, C::Ps},
+    {0x29DB, 0x29DB, C::Pe}, {0x29DC, 0x29FB, C::Sm}, {0x29FC, 0x29FC, C::Ps},
+    {0x29FD, 0x29FD, C::Pe}, {0x29FE, 0x2AFF, C::Sm}, {0x2B00, 0x2B2F, C::So},
+    {0x2B30, 0x2B44, C::Sm}, {0x2B45, 0x2B46, C::So}, {0x2B47, 0x2B4C, C::Sm},
+    {0x2B4D, 0x2B73, C::So}, {0x2B76, 0x2B95, C::So}, {0x2B97, 0x2BFF, C::So},
+    {0x2C00, 0x2C2F, C::Lu}, {0x2C30, 0x2C5F, C::Ll}, {0x2C60, 0x2C60, C::Lu},
+    {0x2C61, 0x2C61, C::Ll}, {0x2C62, 0x2C64, C::Lu}, {0x2C65, 0x2C66, C::Ll},
+    {0x2C67, 0x2C67, C::Lu}, {0x2C68, 0x2C68, C::Ll}, {0x2C69, 0x2C69, C::Lu},
+    {0x2C6A, 0x2C6A, C::Ll}, {0x2C6B, 0x2C6B, C::Lu}, {0x2C6C, 0x2C6C, C::Ll},
+    {0x2C6D, 0x2C70, C::Lu}, {0x2C71, 0x2C71, C::Ll}, {0x2C72, 0x2C72, C::Lu},
+    {0x2C73, 0x2C74, C::Ll}, {0x2C75, 0x2C75, C::Lu}, {0x2C76, 0x2C7B, C::Ll},
+    {0x2C7C, 0x2C7D, C::Lm}, {0x2C7E, 0x2C80, C::Lu}, {0x2C81, 0x2C81, C::Ll},
+    {0x2C82, 0x2C82, C::Lu}, {0x2C83, 0x2C83, C::Ll}, {0x2C84, 0x2C84, C::Lu},
+    {0x2C85, 0x2C85, C::Ll}, {0x2C86, 0x2C86, C::Lu}, {0x2C87, 0x2C87, C::Ll},
+    {0x2C88, 0x2C88, C::Lu}, {0x2C89, 0x2C89, C::Ll}, {0x2C8A, 0x2C8A, C::Lu},
+    {0x2C8B, 0x2C8B, C::Ll}, {0x2C8C, 0x2C8C, C::Lu}, {0x2C8D, 0x2C8D, C::Ll},
+    {0x2C8E, 0x2C8E, C::Lu}, {0x2C8F, 0x2C8F, C::Ll}, {0x2C90, 0x2C90, C::Lu},
+    {0x2C91, 0x2C91, C::Ll}, {0x2C92, 0x2C92, C::Lu}, {0x2C93, 0x2C93, C::Ll},
+    {0x2C94, 0x2C94, C::Lu}, {0x2C95, 0x2C95, C::Ll}, {0x2C96, 0x2C96, C::Lu},
+    {0x2C97, 0x2C97, C::Ll}, {0x2C98, 0x2C98, C::Lu}, {0x2C99, 0x2C99, C::Ll},
+    {0x2C9A, 0x2C9A, C::Lu}, {0x2C9B, 0x2C9B, C::Ll}, {0x2C9C, 0x2C9C, C::Lu},
+    {0x2C9D, 0x2C9D, C::Ll}, {0x2C9E, 0x2C9E, C::Lu}, {0x2C9F, 0x2C9F, C::Ll},
+    {0x2CA0, 0x2CA0, C::Lu}, {0x2CA1, 0x2CA1, C::Ll}, {0x2CA2, 0x2CA2, C::Lu},
+    {0x2CA3, 0x2CA3, C::Ll}, {0x2CA4, 0x2CA4, C::Lu}, {0x2CA5, 0x2CA5, C::Ll},
+    {0x2CA6, 0x2CA6, C::Lu}, {0x2CA7, 0x2CA7, C::Ll}, {0x2CA8, 0x2CA8, C::Lu},
+    {0x2CA9, 0x2CA9, C::Ll}, {0x2CAA, 0x2CAA, C::Lu}, {0x2CAB, 0x2CAB, C::Ll},
+    {0x2CAC, 0x2CAC, C::Lu}, {0x2CAD, 0x2CAD, C::Ll}, {0x2CAE, 0x2CAE, C::Lu},
+    {0x2CAF, 0x2CAF, C::Ll}, {0x2CB0, 0x2CB0, C::Lu}, {0x2CB1, 0x2CB1, C::Ll},
+    {0x2CB2, 0x2CB2, C::Lu}, {0x2CB3, 0x2CB3, C::Ll}, {0x2CB4, 0x2CB4, C::Lu},
+    {0x2CB5, 0x2CB5, C::Ll}, {0x2CB6, 0x2CB6, C::Lu}, {0x2CB7, 0x2CB7, C::Ll},
+    {0x2CB8, 0x2CB8, C::Lu}, {0x2CB9, 0x2CB9, C::Ll}, {0x2CBA, 0x2CBA, C::Lu},
+    {0x2CBB, 0x2CBB, C::Ll}, {0x2CBC, 0x2CBC, C::Lu}, {0x2CBD, 0x2CBD, C::Ll},
+    {0x2CBE, 0x2CBE, C::Lu}, {0x2CBF, 0x2CBF, C::Ll}, {0x2CC0, 0x2CC0, C::Lu},
+    {0x2CC1, 0x2CC1, C::Ll}, {0x2CC2, 0x2CC2, C::Lu}, {0x2CC3, 0x2CC3, C::Ll},
+    {0x2CC4, 0x2CC4, C::Lu}, {0x2CC5, 0x2CC5, C::Ll}, {0x2CC6, 0x2CC6, C::Lu},
+    {0x2CC7, 0x2CC7, C::Ll}, {0x2CC8, 0x2CC8, C::Lu}, {0x2CC9, 0x2CC9, C::Ll},
+    {0x2CCA, 0x2CCA, C::Lu}, {0x2CCB, 0x2CCB, C::Ll}, {0x2CCC, 0x2CCC, C::Lu},
+    {0x2CCD, 0x2CCD, C::Ll}, {0x2CCE, 0x2CCE, C::Lu}, {0x2CCF, 0x2CCF, C::Ll},
+    {0x2CD0, 0x2CD0, C::Lu}, {0x2CD1, 0x2CD1, C::Ll}, {0x2CD2, 0x2CD2, C::Lu},
+    {0x2CD3, 0x2CD3, C::Ll}, {0x2CD4, 0x2CD4, C::Lu}, {0x2CD5, 0x2CD5, C::Ll},
+    {0x2CD6, 0x2CD6, C::Lu}, {0x2CD7, 0x2CD7, C::Ll}, {0x2CD8, 0x2CD8, C::Lu},
+    {0x2CD9, 0x2CD9, C::Ll}, {0x2CDA, 0x2CDA, C::Lu}, {0x2CDB, 0x2CDB, C::Ll},
+    {0x2CDC, 0x2CDC, C::Lu}, {0x2CDD, 0x2CDD, C::Ll}, {0x2CDE, 0x2CDE, C::Lu},
+    {0x2CDF, 0x2CDF, C::Ll}, {0x2CE0, 0x2CE0, C::Lu}, {0x2CE1, 0x2CE1, C::Ll},
+    {0x2CE2, 0x2CE2, C::Lu}, {0x2CE3, 0x2CE4, C::Ll}, {0x2CE5, 0x2CEA, C::So},
+    {0x2CEB, 0x2CEB, C::Lu}, {0x2CEC, 0x2CEC, C::Ll}, {0x2CED, 0x2CED, C::Lu},
+    {0x2CEE, 0x2CEE, C::Ll}, {0x2CEF, 0x2CF1, C::Mn}, {0x2CF2, 0x2CF2, C::Lu},
+    {0x2CF3, 0x2CF3, C::Ll}, {0x2CF9, 0x2CFC, C::Po}, {0x2CFD, 0x2CFD, C::No},
+    {0x2CFE, 0x2CFF, C::Po}, {0x2D00, 0x2D25, C::Ll}, {0x2D27, 0x2D27, C::Ll},
+    {0x2D2D, 0x2D2D, C::Ll}, {0x2D30, 0x2D67, C::Lo}, {0x2D6F, 0x2D6F, C::Lm},
+    {0x2D70, 0x2D70, C::Po}, {0x2D7F, 0x2D7F, C::Mn}, {0x2D80, 0x2D96, C::Lo},
+    {0x2DA0, 0x2DA6, C::Lo}, {0x2DA8, 0x2DAE, C::Lo}, {0x2DB0, 0x2DB6, C::Lo},
+    {0x2DB8, 0x2DBE, C::Lo}, {0x2DC0, 0x2DC6, C::Lo}, {0x2DC8, 0x2DCE, C::Lo},
+    {0x2DD0, 0x2DD6, C::Lo}, {0x2DD8, 0x2DDE, C::Lo}, {0x2DE0, 0x2DFF, C::Mn},
+    {0x2E00, 0x2E01, C::Po}, {0x2E02, 0x2E02, C::Pi}, {0x2E03, 0x2E03, C::Pf},
+    {0x2E04, 0x2E04, C::Pi}, {0x2E05, 0x2E05, C::Pf}, {0x2E06, 0x2E08, C::Po},
+    {0x2E09, 0x2E09, C::Pi}, {0x2E0A, 0x2E0A, C::Pf}, {0x2E0B, 0x2E0B, C::Po},
+    {0x2E0C, 0x2E0C, C::Pi}, {0x2E0D, 0x2E0D, C::Pf}, {0x2E0E, 0x2E16, C::Po},
+    {0x2E17, 0x2E17, C::Pd}, {0x2E18, 0x2E19, C::Po}, {0x2E1A, 0x2E1A, C::Pd},
+    {0x2E1B, 0x2E1B, C::Po}, {0x2E1C, 0x2E1C, C::Pi}, {0x2E1D, 0x2E1D, C::Pf},
+    {0x2E1E, 0x2E1F, C::Po}, {0x2E20, 0x2E20, C::Pi}, {0x2E21, 0x2E21, C::Pf},
+    {0x2E22, 0x2E22, C::Ps}, {0x2E23, 0x2E23, C::Pe}, {0x2E24, 0x2E24, C::Ps},
+    {0x2E25, 0x2E25, C::Pe}, {0x2E26, 0x2E26, C::Ps}, {0x2E27, 0x2E27, C::Pe},
+    {0x2E28, 0x2E28, C::Ps}, {0x2E29, 0x2E29, C::Pe}, {0x2E2A, 0x2E2E, C::Po},
+    {0x2E2F, 0x2E2F, C::Lm}, {0x2E30, 0x2E39, C::Po}, {0x2E3A, 0x2E3B, C::Pd},
+    {0x2E3C, 0x2E3F, C::Po}, {0x2E40, 0x2E40, C::Pd}, {0x2E41, 0x2E41, C::Po},
+    {0x2E42, 0x2E42, C::Ps}, {0x2E43, 0x2E4F, C::Po}, {0x2E50, 0x2E51, C::So},
+    {0x2E52, 0x2E54, C::Po}, {0x2E55, 0x2E55, C::Ps}, {0x2E56, 0x2E56, C::Pe},
+    {0x2E57, 0x2E57, C::Ps}, {0x2E58, 0x2E58, C::Pe}, {0x2E59, 0x2E59, C::Ps},
+    {0x2E5A, 0x2E5A, C::Pe}, {0x2E5B, 0x2E5B, C::Ps}, {0x2E5C, 0x2E5C, C::Pe},
+    {0x2E5D, 0x2E5D, C::Pd}, {0x2E80, 0x2E99, C::So}, {0x2E9B, 0x2EF3, C::So},
+    {0x2F00, 0x2FD5, C::So}, {0x2FF0, 0x2FFB, C::So}, {0x3000, 0x3000, C::Zs},
+    {0x3001, 0x3003, C::Po}, {0x3004, 0x3004, C::So}, {0x3005, 0x3005, C::Lm},
+    {0x3006, 0x3006, C::Lo}, {0x3007, 0x3007, C::Nl}, {0x3008, 0x3008, C::Ps},
+    {0x3009, 0x3009, C::Pe}, {0x300A, 0x300A, C::Ps}, {0x300B, 0x300B, C::Pe},
+    {0x300C, 0x300C, C::Ps}, {0x300D, 0x300D, C::Pe}, {0x300E, 0x300E, C::Ps},
+    {0x300F, 0x300F, C::Pe}, {0x3010, 0x3010, C::Ps}, {0x3011, 0x3011, C::Pe},
+    {0x3012, 0x3013, C::So}, {0x3014, 0x3014, C::Ps}, {0x3015, 0x3015, C::Pe},
+    {0x3016, 0x3016, C::Ps}, {0x3017, 0x3017, C::Pe}, {0x3018, 0x3018, C::Ps},
+    {0x3019, 0x3019, C::Pe}, {0x301A, 0x301A, C::Ps}, {0x301B, 0x301B, C::Pe},
+    {0x301C, 0x301C, C::Pd}, {0x301D, 0x301D, C::Ps}, {0x301E, 0x301F, C::Pe},
+    {0x3020, 0x3020, C::So}, {0x3021, 0x3029, C::Nl}, {0x302A, 0x302D, C::Mn},
+    {0x302E, 0x302F, C::Mc}, {0x3030, 0x3030, C::Pd}, {0x3031, 0x3035, C::Lm},
+    {0x3036, 0x3037, C::So}, {0x3038, 0x303A, C::Nl}, {0x303B, 0x303B, C::Lm},
+    {0x303C, 0x303C, C::Lo}, {0x303D, 0x303D, C::Po}, {0x303E, 0x303F, C::So},
+    {0x3041, 0x3096, C::Lo}, {0x3099, 0x309A, C::Mn}, {0x309B, 0x309C, C::Sk},
+    {0x309D, 0x309E, C::Lm}, {0x309F, 0x309F, C::Lo}, {0x30A0, 0x30A0, C::Pd},
+    {0x30A1, 0x30FA, C::Lo}, {0x30FB, 0x30FB, C::Po}, {0x30FC, 0x30FE, C::Lm},
+    {0x30FF, 0x30FF, C::Lo}, {0x3105, 0x312F, C::Lo}, {0x3131, 0x318E, C::Lo},
+    {0x3190, 0x3191, C::So}, {0x3192, 0x3195, C::No}, {0x3196, 0x319F, C::So},
+    {0x31A0, 0x31BF, C::Lo}, {0x31C0, 0x31E3, C::So}, {0x31F0, 0x31FF, C::Lo},
+    {0x3200, 0x321E, C::So}, {0x3220, 0x3229, C::No}, {0x322A, 0x3247, C::So},
+    {0x3248, 0x324F, C::No}, {0x3250, 0x3250, C::So}, {0x3251, 0x325F, C::No},
+    {0x3260, 0x327F, C::So}, {0x3280, 0x3289, C::No}, {0x328A, 0x32B0, C::So},
+    {0x32B1, 0x32BF, C::No}, {0x32C0, 0x33FF, C::So}, {0x3400, 0x4DBF, C::Lo},
+    {0x4DC0, 0x4DFF, C::So}, {0x4E00, 0xA014, C::Lo}, {0xA015, 0xA015, C::Lm},
+    {0xA016, 0xA48C, C::Lo}, {0xA490, 0xA4C6, C::So}, {0xA4D0, 0xA4F7, C::Lo},
+    {0xA4F8, 0xA4FD, C::Lm}, {0xA4FE, 0xA4FF, C::Po}, {0xA500, 0xA60B, C::Lo},
+    {0xA60C, 0xA60C, C::Lm}, {0xA60D, 0xA60F, C::Po}, {0xA610, 0xA61F, C::Lo},
+    {0xA620, 0xA629, C::Nd}, {0xA62A, 0xA62B, C::Lo}, {0xA640, 0xA640, C::Lu},
+    {0xA641, 0xA641, C::Ll}, {0xA642, 0xA642, C::Lu}, {0xA643, 0xA643, C::Ll},
+    {0xA644, 0xA644, C::Lu}, {0xA645, 0xA645, C::Ll}, {0xA646, 0xA646, C::Lu},
+    {0xA647, 0xA647, C::Ll}, {0xA648, 0xA648, C::Lu}, {0xA649, 0xA649, C::Ll},
+    {0xA64A, 0xA64A, C::Lu}, {0xA64B, 0xA64B, C::Ll}, {0xA64C, 0xA64C, C::Lu},
+    {0xA64D, 0xA64D, C::Ll}, {0xA64E, 0xA64E, C::Lu}, {0xA64F, 0xA64F, C::Ll},
+    {0xA650, 0xA650, C::Lu}, {0xA651, 0xA651, C::Ll}, {0xA652, 0xA652, C::Lu},
+    {0xA653, 0xA653, C::Ll}, {0xA654, 0xA654, C::Lu}, {0xA655, 0xA655, C::Ll},
+    {0xA656, 0xA656, C::Lu}, {0xA657, 0xA657, C::Ll}, {0xA658, 0xA658, C::Lu},
+    {0xA659, 0xA659, C::Ll}, {0xA65A, 0xA65A, C::Lu}, {0xA65B, 0xA65B, C::Ll},
+    {0xA65C, 0xA65C, C::Lu}, {0xA65D, 0xA65D, C::Ll}, {0xA65E, 0xA65E, C::Lu},
+    {0xA65F, 0xA65F, C::Ll}, {0xA660, 0xA660, C::Lu}, {0xA661, 0xA661, C::Ll},
+    {0xA662, 0xA662, C::Lu}, {0xA663, 0xA663, C::Ll}, {0xA664, 0xA664, C::Lu},
+    {0xA665, 0xA665, C::Ll}, {0xA666, 0xA666, C::Lu}, {0xA667, 0xA667, C::Ll},
+    {0xA668, 0xA668, C::Lu}, {0xA669, 0xA669, C::Ll}, {0xA66A, 0xA66A, C::Lu},
+    {0xA66B, 0xA66B, C::Ll}, {0xA66C, 0xA66C, C::Lu}, {0xA66D, 0xA66D, C::Ll},
+    {0xA66E, 0xA66E, C::Lo}, {0xA66F, 0xA66F, C::Mn}, {0xA670, 0xA672, C::Me},
+    {0xA673, 0xA673, C::Po}, {0xA674, 0xA67D, C::Mn}, {0xA67E, 0xA67E, C::Po},
+    {0xA67F, 0xA67F, C::Lm}, {0xA680, 0xA680, C::Lu}, {0xA681, 0xA681, C::Ll},
+    {0xA682, 0xA682, C::Lu}, {0xA683, 0xA683, C::Ll}, {0xA684, 0xA684, C::Lu},
+    {0xA685, 0xA685, C::Ll}, {0xA686, 0xA686, C::Lu}, {0xA687, 0xA687, C::Ll},
+    {0xA688, 0xA688, C::Lu}, {0xA689, 0xA689, C::Ll}, {0xA68A, 0xA68A, C::Lu},
+    {0xA68B, 0xA68B, C::Ll}, {0xA68C, 0xA68C, C::Lu}, {0xA68D, 0xA68D, C::Ll},
+    {0xA68E, 0xA68E, C::Lu}, {0xA68F, 0xA68F, C::Ll}, {0xA690, 0xA690, C::Lu},
+    {0xA691, 0xA691, C::Ll}, {0xA692, 0xA692, C::Lu}, {0xA693, 0xA693, C::Ll},
+    {0xA694, 0xA694, C::Lu}, {0xA695, 0xA695, C::Ll}, {0xA696, 0xA696, C::Lu},
+    {0xA697, 0xA697, C::Ll}, {0xA698, 0xA698, C::Lu}, {0xA699, 0xA699, C::Ll},
+    {0xA69A, 0xA69A, C::Lu}, {0xA69B, 0xA69B, C::Ll}, {0xA69C, 0xA69D, C::Lm},
+    {0xA69E, 0xA69F, C::Mn}, {0xA6A0, 0xA6E5, C::Lo}, {0xA6E6, 0xA6EF, C::Nl},
+    {0xA6F0, 0xA6F1, C::Mn}, {0xA6F2, 0xA6F7, C::Po}, {0xA700, 0xA716, C::Sk},
+    {0xA717, 0xA71F, C::Lm}, {0xA720, 0xA721, C::Sk}, {0xA722, 0xA722, C::Lu},
+    {0xA723, 0xA723, C::Ll}, {0xA724, 0xA724, C::Lu}, {0xA725, 0xA725, C::Ll},
+    {0xA726, 0xA726, C::Lu}, {0xA727, 0xA727, C::Ll}, {0xA728, 0xA728, C::Lu},
+    {0xA729, 0xA729, C::Ll}, {0xA72A, 0xA72A, C::Lu}, {0xA72B, 0xA72B, C::Ll},
+    {0xA72C, 0xA72C, C::Lu}, {0xA72D, 0xA72D, C::Ll}, {0xA72E, 0xA72E, C::Lu},
+    {0xA72F, 0xA731, C::Ll}, {0xA732, 0xA732, C::Lu}, {0xA733, 0xA733, C::Ll},
+    {0xA734, 0xA734, C::Lu}, {0xA735, 0xA735, C::Ll}, {0xA736, 0xA736, C::Lu},
+    {0xA737, 0xA737, C::Ll}, {0xA738, 0xA738, C::Lu}, {0xA739, 0xA739, C::Ll},
+    {0xA73A, 0xA73A, C::Lu}, {0xA73B, 0xA73B, C::Ll}, {0xA73C, 0xA73C, C::Lu},
+    {0xA73D, 0xA73D, C::Ll}, {0xA73E, 0xA73E, C::Lu}, {0xA73F, 0xA73F, C::Ll},
+    {0xA740, 0xA740, C::Lu}, {0xA741, 0xA741, C::Ll}, {0xA742, 0xA742, C::Lu},
+    {0xA743, 0xA743, C::Ll}, {0xA744, 0xA744, C::Lu}, {0xA745, 0xA745, C::Ll},
+    {0xA746, 0xA746, C::Lu}, {0xA747, 0xA747, C::Ll}, {0xA748, 0xA748, C::Lu},
+    {0xA749, 0xA749, C::Ll}, {0xA74A, 0xA74A, C::Lu}, {0xA74B, 0xA74B, C::Ll},
+    {0xA74C, 0xA74C, C::Lu}, {0xA74D, 0xA74D, C::Ll}, {0xA74E, 0xA74E, C::Lu},
+    {0xA74F, 0xA74F, C::Ll}, {0xA750, 0xA750, C::Lu}, {0xA751, 0xA751, C::Ll},
+    {0xA752, 0xA752, C::Lu}, {0xA753, 0xA753, C::Ll}, {0xA754, 0xA754, C::Lu},
+    {0xA755, 0xA755, C::Ll}, {0xA756, 0xA756, C::Lu}, {0xA757, 0xA757, C::Ll},
+    {0xA758, 0xA758, C::Lu}, {0xA759, 0xA759, C::Ll}, {0xA75A, 0xA75A, C::Lu},
+    {0xA75B, 0xA75B, C::Ll}, {0xA75C, 0xA75C, C::Lu}, {0xA75D, 0xA75D, C::Ll},
+    {0xA75E, 0xA75E, C::Lu}, {0xA75F, 0xA75F, C::Ll}, {0xA760, 0xA760, C::Lu},
+    {0xA761, 0xA761, C::Ll}, {0xA762, 0xA762, C::Lu}, {0xA763, 0xA763, C::Ll},
+    {0xA764, 0xA764, C::Lu}, {0xA765, 0xA765, C::Ll}, {0xA766, 0xA766, C::Lu},
+    {0xA767, 0xA767, C::Ll}, {0xA768, 0xA768, C::Lu}, {0xA769, 0xA769, C::Ll},
+    {0xA76A, 0xA76A, C::Lu}, {0xA76B, 0xA76B, C::Ll}, {0xA76C, 0xA76C, C::Lu},
+    {0xA76D, 0xA76D, C::Ll}, {0xA76E, 0xA76E, C::Lu}, {0xA76F, 0xA76F, C::Ll},
+    {0xA770, 0xA770, C::Lm}, {0xA771, 0xA778, C::Ll}, {0xA779, 0xA779, C::Lu},
+    {0xA77A, 0xA77A, C::Ll}, {0xA77B, 0xA77B, C::Lu}, {0xA77C, 0xA77C, C::Ll},
+    {0xA77D, 0xA77E, C::Lu}, {0xA77F, 0xA77F, C::Ll}, {0xA780, 0xA780, C::Lu},
+    {0xA781, 0xA781, C::Ll}, {0xA782, 0xA782, C::Lu}, {0xA783, 0xA783, C::Ll},
+    {0xA784, 0xA784, C::Lu}, {0xA785, 0xA785, C::Ll}, {0xA786, 0xA786, C::Lu},
+    {0xA787, 0xA787, C::Ll}, {0xA788, 0xA788, C::Lm}, {0xA789, 0xA78A, C::Sk},
+    {0xA78B, 0xA78B, C::Lu}, {0xA78C, 0xA78C, C::Ll}, {0xA78D, 0xA78D, C::Lu},
+    {0xA78E, 0xA78E, C::Ll}, {0xA78F, 0xA78F, C::Lo}, {0xA790, 0xA790, C::Lu},
+    {0xA791, 0xA791, C::Ll}, {0xA792, 0xA792, C::Lu}, {0xA793, 0xA795, C::Ll},
+    {0xA796, 0xA796, C::Lu}, {0xA797, 0xA797, C::Ll}, {0xA798, 0xA798, C::Lu},
+    {0xA799, 0xA799, C::Ll}, {0xA79A, 0xA79A, C::Lu}, {0xA79B, 0xA79B, C::Ll},
+    {0xA79C, 0xA79C, C::Lu}, {0xA79D, 0xA79D, C::Ll}, {0xA79E, 0xA79E, C::Lu},
+    {0xA79F, 0xA79F, C::Ll}, {0xA7A0, 0xA7A0, C::Lu}, {0xA7A1, 0xA7A1, C::Ll},
+    {0xA7A2, 0xA7A2, C::Lu}, {0xA7A3, 0xA7A3, C::Ll}, {0xA7A4, 0xA7A4, C::Lu},
+    {0xA7A5, 0xA7A5, C::Ll}, {0xA7A6, 0xA7A6, C::Lu}, {0xA7A7, 0xA7A7, C::Ll},
+    {0xA7A8, 0xA7A8, C::Lu}, {0xA7A9, 0xA7A9, C::Ll}, {0xA7AA, 0xA7AE, C::Lu},
+    {0xA7AF, 0xA7AF, C::Ll}, {0xA7B0, 0xA7B4, C::Lu}, {0xA7B5, 0xA7B5, C::Ll},
+    {0xA7B6, 0xA7B6, C::Lu}, {0xA7B7, 0xA7B7, C::Ll}, {0xA7B8, 0xA7B8, C::Lu},
+    {0xA7B9, 0xA7B9, C::Ll}, {0xA7BA, 0xA7BA, C::Lu}, {0xA7BB, 0xA7BB, C::Ll},
+    {0xA7BC, 0xA7BC, C::Lu}, {0xA7BD, 0xA7BD, C::Ll}, {0xA7BE, 0xA7BE, C::Lu},
+    {0xA7BF, 0xA7BF, C::Ll}, {0xA7C0, 0xA7C0, C::Lu}, {0xA7C1, 0xA7C1, C::Ll},
+    {0xA7C2, 0xA7C2, C::Lu}, {0xA7C3, 0xA7C3, C::Ll}, {0xA7C4, 0xA7C7, C::Lu},
+    {0xA7C8, 0xA7C8, C::Ll}, {0xA7C9, 0xA7C9, C::Lu}, {0xA7CA, 0xA7CA, C::Ll},
+    {0xA7D0, 0xA7D0, C::Lu}, {0xA7D1, 0xA7D1, C::Ll}, {0xA7D3, 0xA7D3, C::Ll},
+    {0xA7D5, 0xA7D5, C::Ll}, {0xA7D6, 0xA7D6, C::Lu}, {0xA7D7, 0xA7D7, C::Ll},
+    {0xA7D8, 0xA7D8, C::Lu}, {0xA7D9, 0xA7D9, C::Ll}, {0xA7F2, 0xA7F4, C::Lm},
+    {0xA7F5, 0xA7F5, C::Lu}, {0xA7F6, 0xA7F6, C::Ll}, {0xA7F7, 0xA7F7, C::Lo},
+    {0xA7F8, 0xA7F9, C::Lm}, {0xA7FA, 0xA7FA, C::Ll}, {0xA7FB, 0xA801, C::Lo},
+    {0xA802, 0xA802, C::Mn}, {0xA803, 0xA805, C::Lo}, {0xA806, 0xA806, C::Mn},
+    {0xA807, 0xA80A, C::Lo}, {0xA80B, 0xA80B, C::Mn}, {0xA80C, 0xA822, C::Lo},
+    {0xA823, 0xA824, C::Mc}, {0xA825, 0xA826, C::Mn}, {0xA827, 0xA827, C::Mc},
+    {0xA828, 0xA82B, C::So}, {0xA82C, 0xA82C, C::Mn}, {0xA830, 0xA835, C::No},
+    {0xA836, 0xA837, C::So}, {0xA838, 0xA838, C::Sc}, {0xA839, 0xA839, C::So},
+    {0xA840, 0xA873, C::Lo}, {0xA874, 0xA877, C::Po}, {0xA880, 0xA881, C::Mc},
+    {0xA882, 0xA8B3, C::Lo}, {0xA8B4, 0xA8C3, C::Mc}, {0xA8C4, 0xA8C5, C::Mn},
+    {0xA8CE, 0xA8CF, C::Po}, {0xA8D0, 0xA8D9, C::Nd}, {0xA8E0, 0xA8F1, C::Mn},
+    {0xA8F2, 0xA8F7, C::Lo}, {0xA8F8, 0xA8FA, C::Po}, {0xA8FB, 0xA8FB, C::Lo},
+    {0xA8FC, 0xA8FC, C::Po}, {0xA8FD, 0xA8FE, C::Lo}, {0xA8FF, 0xA8FF, C::Mn},
+    {0xA900, 0xA909, C::Nd}, {0xA90A, 0xA925, C::Lo}, {0xA926, 0xA92D, C::Mn},
+    {0xA92E, 0xA92F, C::Po}, {0xA930, 0xA946, C::Lo}, {0xA947, 0xA951, C::Mn},
+    {0xA952, 0xA953, C::Mc}, {0xA95F, 0xA95F, C::Po}, {0xA960, 0xA97C, C::Lo},
+    {0xA980, 0xA982, C::Mn}, {0xA983, 0xA983, C::Mc}, {0xA984, 0xA9B2, C::Lo},
+    {0xA9B3, 0xA9B3, C::Mn}, {0xA9B4, 0xA9B5, C::Mc}, {0xA9B6, 0xA9B9, C::Mn},
+    {0xA9BA, 0xA9BB, C::Mc}, {0xA9BC, 0xA9BD, C::Mn}, {0xA9BE, 0xA9C0, C::Mc},
+    {0xA9C1, 0xA9CD, C::Po}, {0xA9CF, 0xA9CF, C::Lm}, {0xA9D0, 0xA9D9, C::Nd},
+    {0xA9DE, 0xA9DF, C::Po}, {0xA9E0, 0xA9E4, C::Lo}, {0xA9E5, 0xA9E5, C::Mn},
+    {0xA9E6, 0xA9E6, C::Lm}, {0xA9E7, 0xA9EF, C::Lo}, {0xA9F0, 0xA9F9, C::Nd},
+    {0xA9FA, 0xA9FE, C::Lo}, {0xAA00, 0xAA28, C::Lo}, {0xAA29, 0xAA2E, C::Mn},
+    {0xAA2F, 0xAA30, C::Mc}, {0xAA31, 0xAA32, C::Mn}, {0xAA33, 0xAA34, C::Mc},
+    {0xAA35, 0xAA36, C::Mn}, {0xAA40, 0xAA42, C::Lo}, {0xAA43, 0xAA43, C::Mn},
+    {0xAA44, 0xAA4B, C::Lo}, {0xAA4C, 0xAA4C, C::Mn}, {0xAA4D, 0xAA4D, C::Mc},
+    {0xAA50, 0xAA59, C::Nd}, {0xAA5C, 0xAA5F, C::Po}, {0xAA60, 0xAA6F, C::Lo},
+    {0xAA70, 0xAA70, C::Lm}, {0xAA71, 0xAA76, C::Lo}, {0xAA77, 0xAA79, C::So},
+    {0xAA7A, 0xAA7A, C::Lo}, {0xAA7B, 0xAA7B, C::Mc}, {0xAA7C, 0xAA7C, C::Mn},
+    {0xAA7D, 0xAA7D, C::Mc}, {0xAA7E, 0xAAAF, C::Lo}, {0xAAB0, 0xAAB0, C::Mn},
+    {0xAAB1, 0xAAB1, C::Lo}, {0xAAB2, 0xAAB4, C::Mn}, {0xAAB5, 0xAAB6, C::Lo},
+    {0xAAB7, 0xAAB8, C::Mn}, {0xAAB9, 0xAABD, C::Lo}, {0xAABE, 0xAABF, C::Mn},
+    {0xAAC0, 0xAAC0, C::Lo}, {0xAAC1, 0xAAC1, C::Mn}, {0xAAC2, 0xAAC2, C::Lo},
+    {0xAADB, 0xAADC, C::Lo}, {0xAADD, 0xAADD, C::Lm}, {0xAADE, 0xAADF, C::Po},
+    {0xAAE0, 0xAAEA, C::Lo}, {0xAAEB, 0xAAEB, C::Mc}, {0xAAEC, 0xAAED, C::Mn},
+    {0xAAEE, 0xAAEF, C::Mc}, {0xAAF0, 0xAAF1, C::Po}, {0xAAF2, 0xAAF2, C::Lo},
+    {0xAAF3, 0xAAF4, C::Lm}, {0xAAF5, 0xAAF5, C::Mc}, {0xAAF6, 0xAAF6, C::Mn},
+    {0xAB01, 0xAB06, C::Lo}, {0xAB09, 0xAB0E, C::Lo}, {0xAB11, 0xAB16, C::Lo},
+    {0xAB20, 0xAB26, C::Lo}, {0xAB28, 0xAB2E, C::Lo}, {0xAB30, 0xAB5A, C::Ll},
+    {0xAB5B, 0xAB5B, C::Sk}, {0xAB5C, 0xAB5F, C::Lm}, {0xAB60, 0xAB68, C::Ll},
+    {0xAB69, 0xAB69, C::Lm}, {0xAB6A, 0xAB6B, C::Sk}, {0xAB70, 0xABBF, C::Ll},
+    {0xABC0, 0xABE2, C::Lo}, {0xABE3, 0xABE4, C::Mc}, {0xABE5, 0xABE5, C::Mn},
+    {0xABE6, 0xABE7, C::Mc}, {0xABE8, 0xABE8, C::Mn}, {0xABE9, 0xABEA, C::Mc},
+    {0xABEB, 0xABEB, C::Po}, {0xABEC, 0xABEC, C::Mc}, {0xABED, 0xABED, C::Mn},
+    {0xABF0, 0xABF9, C::Nd}, {0xAC00, 0xD7A3, C::Lo}, {0xD7B0, 0xD7C6, C::Lo},
+    {0xD7CB, 0xD7FB, C::Lo}, {0xD800, 0xDFFF, C::Cs}, {0xE000, 0xF8FF, C::Co},
+    {0xF900, 0xFA6D, C::Lo}, {0xFA70, 0xFAD9, C::Lo}, {0xFB00, 0xFB06, C::Ll},
+    {0xFB13, 0xFB17, C::Ll}, {0xFB1D, 0xFB1D, C::Lo}, {0xFB1E, 0xFB1E, C::Mn},
+    {0xFB1F, 0xFB28, C::Lo}, {0xFB29, 0xFB29, C::Sm}, {0xFB2A, 0xFB36, C::Lo},
+    {0xFB38, 0xFB3C, C::Lo}, {0xFB3E, 0xFB3E, C::Lo}, {0xFB40, 0xFB41, C::Lo},
+    {0xFB43, 0xFB44, C::Lo}, {0xFB46, 0xFBB1, C::Lo}, {0xFBB2, 0xFBC2, C::Sk},
+    {0xFBD3, 0xFD3D, C::Lo}, {0xFD3E, 0xFD3E, C::Pe}, {0xFD3F, 0xFD3F, C::Ps},
+    {0xFD40, 0xFD4F, C::So}, {0xFD50, 0xFD8F, C::Lo}, {0xFD92, 0xFDC7, C::Lo},
+    {0xFDCF, 0xFDCF, C::So}, {0xFDF0, 0xFDFB, C::Lo}, {0xFDFC, 0xFDFC, C::Sc},
+    {0xFDFD, 0xFDFF, C::So}, {0xFE00, 0xFE0F, C::Mn}, {0xFE10, 0xFE16, C::Po},
+    {0xFE17, 0xFE17, C::Ps}, {0xFE18, 0xFE18, C::Pe}, {0xFE19, 0xFE19, C::Po},
+    {0xFE20, 0xFE2F, C::Mn}, {0xFE30, 0xFE30, C::Po}, {0xFE31, 0xFE32, C::Pd},
+    {0xFE33, 0xFE34, C::Pc}, {0xFE35, 0xFE35, C::Ps}, {0xFE36, 0xFE36, C::Pe},
+    {0xFE37, 0xFE37, C::Ps}, {0xFE38, 0xFE38, C::Pe}, {0xFE39, 0xFE39, C::Ps},
+    {0xFE3A, 0xFE3A, C::Pe}, {0xFE3B, 0xFE3B, C::Ps}, {0xFE3C, 0xFE3C, C::Pe},
+    {0xFE3D, 0xFE3D, C::Ps}, {0xFE3E, 0xFE3E, C::Pe}, {0xFE3F, 0xFE3F, C::Ps},
+    {0xFE40, 0xFE40, C::Pe}, {0xFE41, 0xFE41, C::Ps}, {0xFE42, 0xFE42, C::Pe},
+    {0xFE43, 0xFE43, C::Ps}, {0xFE44, 0xFE44, C::Pe}, {0xFE45, 0xFE46, C::Po},
+    {0xFE47, 0xFE47, C::Ps}, {0xFE48, 0xFE48, C::Pe}, {0xFE49, 0xFE4C, C::Po},
+    {0xFE4D, 0xFE4F, C::Pc}, {0xFE50, 0xFE52, C::Po}, {0xFE54, 0xFE57, C::Po},
+    {0xFE58, 0xFE58, C::Pd}, {0xFE59, 0xFE59, C::Ps}, {0xFE5A, 0xFE5A, C::Pe},
+    {0xFE5B, 0xFE5B, C::Ps}, {0xFE5C, 0xFE5C, C::Pe}, {0xFE5D, 0xFE5D, C::Ps},
+    {0xFE5E, 0xFE5E, C::Pe}, {0xFE5F, 0xFE61, C::Po}, {0xFE62, 0xFE62, C::Sm},
+    {0xFE63, 0xFE63, C::Pd}, {0xFE64, 0xFE66, C::Sm}, {0xFE68, 0xFE68, C::Po},
+    {0xFE69, 0xFE69, C::Sc}, {0xFE6A, 0xFE6B, C::Po}, {0xFE70, 0xFE74, C::Lo},
+    {0xFE76, 0xFEFC, C::Lo}, {0xFEFF, 0xFEFF, C::Cf}, {0xFF01, 0xFF03, C::Po},
+    {0xFF04, 0xFF04, C::Sc}, {0xFF05, 0xFF07, C::Po}, {0xFF08, 0xFF08, C::Ps},
+    {0xFF09, 0xFF09, C::Pe}, {0xFF0A, 0xFF0A, C::Po}, {0xFF0B, 0xFF0B, C::Sm},
+    {0xFF0C, 0xFF0C, C::Po}, {0xFF0D, 0xFF0D, C::Pd}, {0xFF0E, 0xFF0F, C::Po},
+    {0xFF10, 0xFF19, C::Nd}, {0xFF1A, 0xFF1B, C::Po}, {0xFF1C, 0xFF1E, C::Sm},
+    {0xFF1F, 0xFF20, C::Po}, {0xFF21, 0xFF3A, C::Lu}, {0xFF3B, 0xFF3B, C::Ps},
+    {0xFF3C, 0xFF3C, C::Po}, {0xFF3D, 0xFF3D, C::Pe}, {0xFF3E, 0xFF3E, C::Sk},
+    {0xFF3F, 0xFF3F, C::Pc}, {0xFF40, 0xFF40, C::Sk}, {0xFF41, 0xFF5A, C::Ll},
+    {0xFF5B, 0xFF5B, C::Ps}, {0xFF5C, 0xFF5C, C::Sm}, {0xFF5D, 0xFF5D, C::Pe},
+    {0xFF5E, 0xFF5E, C::Sm}, {0xFF5F, 0xFF5F, C::Ps}, {0xFF60, 0xFF60, C::Pe},
+    {0xFF61, 0xFF61, C::Po}, {0xFF62, 0xFF62, C::Ps}, {0xFF63, 0xFF63, C::Pe},
+    {0xFF64, 0xFF65, C::Po}, {0xFF66, 0xFF6F, C::Lo}, {0xFF70, 0xFF70, C::Lm},
+    {0xFF71, 0xFF9D, C::Lo}, {0xFF9E, 0xFF9F, C::Lm}, {0xFFA0, 0xFFBE, C::Lo},
+    {0xFFC2, 0xFFC7, C::Lo}, {0xFFCA, 0xFFCF, C::Lo}, {0xFFD2, 0xFFD7, C::Lo},
+    {0xFFDA, 0xFFDC, C::Lo}, {0xFFE0, 0xFFE1, C::Sc}, {0xFFE2, 0xFFE2, C::Sm},
+    {0xFFE3, 0xFFE3, C::Sk}, {0xFFE4, 0xFFE4, C::So}, {0xFFE5, 0xFFE6, C::Sc},
+    {0xFFE8, 0xFFE8, C::So}, {0xFFE9, 0xFFEC, C::Sm}, {0xFFED, 0xFFEE, C::So},
+    {0xFFF9, 0xFFFB, C::Cf}, {0xFFFC, 0xFFFD, C::So}, {0x10000, 0x1000B, C::Lo},
+    {0x1000D, 0x10026, C::Lo}, {0x10028, 0x1003A, C::Lo}, {0x1003C, 0x1003D, C::Lo},
+    {0x1003F, 0x1004D, C::Lo}, {0x10050, 0x1005D, C::Lo}, {0x10080, 0x100FA, C::Lo},
+    {0x10100, 0x10102, C::Po}, {0x10107, 0x10133, C::No}, {0x10137, 0x1013F, C::So},
+    {0x10140, 0x10174, C::Nl}, {0x10175, 0x10178, C::No}, {0x10179, 0x10189, C::So},
+    {0x1018A, 0x1018B, C::No}, {0x1018C, 0x1018E, C::So}, {0x10190, 0x1019C, C::So},
+    {0x101A0, 0x101A0, C::So}, {0x101D0, 0x101FC, C::So}, {0x101FD, 0x101FD, C::Mn},
+    {0x10280, 0x1029C, C::Lo}, {0x102A0, 0x102D0, C::Lo}, {0x102E0, 0x102E0, C::Mn},
+    {0x102E1, 0x102FB, C::No}, {0x10300, 0x1031F, C::Lo}, {0x10320, 0x10323, C::No},
+    {0x1032D, 0x10340, C::Lo}, {0x10341, 0x10341, C::Nl}, {0x10342, 0x10349, C::Lo},
+    {0x1034A, 0x1034A, C::Nl}, {0x10350, 0x10375, C::Lo}, {0x10376, 0x1037A, C::Mn},
+    {0x10380, 0x1039D, C::Lo}, {0x1039F, 0x1039F, C::Po}, {0x103A0, 0x103C3, C::Lo},
+    {0x103C8, 0x103CF, C::Lo}, {0x103D0, 0x103D0, C::Po}, {0x103D1, 0x103D5, C::Nl},
+    {0x10400, 0x10427, C::Lu}, {0x10428, 0x1044F, C::Ll}, {0x10450, 0x1049D, C::Lo},
+    {0x104A0, 0x104A9, C::Nd}, {0x104B0, 0x104D3, C::Lu}, {0x104D8, 0x104FB, C::Ll},
+    {0x10500, 0x10527, C::Lo}, {0x10530, 0x10563, C::Lo}, {0x1056F, 0x1056F, C::Po},
+    {0x10570, 0x1057A, C::Lu}, {0x1057C, 0x1058A, C::Lu}, {0x1058C, 0x10592, C::Lu},
+    {0x10594, 0x10595, C::Lu}, {0x10597, 0x105A1, C::Ll}, {0x105A3, 0x105B1, C::Ll},
+    {0x105B3, 0x105B9, C::Ll}, {0x105BB, 0x105BC, C::Ll}, {0x10600, 0x10736, C::Lo},
+    {0x10740, 0x10755, C::Lo}, {0x10760, 0x10767, C::Lo}, {0x10780, 0x10785, C::Lm},
+    {0x10787, 0x107B0, C::Lm}, {0x107B2, 0x107BA, C::Lm}, {0x10800, 0x10805, C::Lo},
+    {0x10808, 0x10808, C::Lo}, {0x1080A, 0x10835, C::Lo}, {0x10837, 0x10838, C::Lo},
+    {0x1083C, 0x1083C, C::Lo}, {0x1083F, 0x10855, C::Lo}, {0x10857, 0x10857, C::Po},
+    {0x10858, 0x1085F, C::No}, {0x10860, 0x10876, C::Lo}, {0x10877, 0x10878, C::So},
+    {0x10879, 0x1087F, C::No}, {0x10880, 0x1089E, C::Lo}, {0x108A7, 0x108AF, C::No},
+    {0x108E0, 0x108F2, C::Lo}, {0x108F4, 0x108F5, C::Lo}, {0x108FB, 0x108FF, C::No},
+    {0x10900, 0x10915, C::Lo}, {0x10916, 0x1091B, C::No}, {0x1091F, 0x1091F, C::Po},
+    {0x10920, 0x10939, C::Lo}, {0x1093F, 0x1093F, C::Po}, {0x10980, 0x109B7, C::Lo},
+    {0x109BC, 0x109BD, C::No}, {0x109BE, 0x109BF, C::Lo}, {0x109C0, 0x109CF, C::No},
+    {0x109D2, 0x109FF, C::No}, {0x10A00, 0x10A00, C::Lo}, {0x10A01, 0x10A03, C::Mn},
+    {0x10A05, 0x10A06, C::Mn}, {0x10A0C, 0x10A0F, C::Mn}, {0x10A10, 0x10A13, C::Lo},
+    {0x10A15, 0x10A17, C::Lo}, {0x10A19, 0x10A35, C::Lo}, {0x10A38, 0x10A3A, C::Mn},
+    {0x10A3F, 0x10A3F, C::Mn}, {0x10A40, 0x10A48, C::No}, {0x10A50, 0x10A58, C::Po},
+    {0x10A60, 0x10A7C, C::Lo}, {0x10A7D, 0x10A7E, C::No}, {0x10A7F, 0x10A7F, C::Po},
+    {0x10A80, 0x10A9C, C::Lo}, {0x10A9D, 0x10A9F, C::No}, {0x10AC0, 0x10AC7, C::Lo},
+    {0x10AC8, 0x10AC8, C::So}, {0x10AC9, 0x10AE4, C::Lo}, {0x10AE5, 0x10AE6, C::Mn},
+    {0x10AEB, 0x10AEF, C::No}, {0x10AF0, 0x10AF6, C::Po}, {0x10B00, 0x10B35, C::Lo},
+    {0x10B39, 0x10B3F, C::Po}, {0x10B40, 0x10B55, C::Lo}, {0x10B58, 0x10B5F, C::No},
+    {0x10B60, 0x10B72, C::Lo}, {0x10B78, 0x10B7F, C::No}, {0x10B80, 0x10B91, C::Lo},
+    {0x10B99, 0x10B9C, C::Po}, {0x10BA9, 0x10BAF, C::No}, {0x10C00, 0x10C48, C::Lo},
+    {0x10C80, 0x10CB2, C::Lu}, {0x10CC0, 0x10CF2, C::Ll}, {0x10CFA, 0x10CFF, C::No},
+    {0x10D00, 0x10D23, C::Lo}, {0x10D24, 0x10D27, C::Mn}, {0x10D30, 0x10D39, C::Nd},
+    {0x10E60, 0x10E7E, C::No}, {0x10E80, 0x10EA9, C::Lo}, {0x10EAB, 0x10EAC, C::Mn},
+    {0x10EAD, 0x10EAD, C::Pd}, {0x10EB0, 0x10EB1, C::Lo}, {0x10EFD, 0x10EFF, C::Mn},
+    {0x10F00, 0x10F1C, C::Lo}, {0x10F1D, 0x10F26, C::No}, {0x10F27, 0x10F27, C::Lo},
+    {0x10F30, 0x10F45, C::Lo}, {0x10F46, 0x10F50, C::Mn}, {0x10F51, 0x10F54, C::No},
+    {0x10F55, 0x10F59, C::Po}, {0x10F70, 0x10F81, C::Lo}, {0x10F82, 0x10F85, C::Mn},
+    {0x10F86, 0x10F89, C::Po}, {0x10FB0, 0x10FC4, C::Lo}, {0x10FC5, 0x10FCB, C::No},
+    {0x10FE0, 0x10FF6, C::Lo}, {0x11000, 0x11000, C::Mc}, {0x11001, 0x11001, C::Mn},
+    {0x11002, 0x11002, C::Mc}, {0x11003, 0x11037, C::Lo}, {0x11038, 0x11046, C::Mn},
+    {0x11047, 0x1104D, C::Po}, {0x11052, 0x11065, C::No}, {0x11066, 0x1106F, C::Nd},
+    {0x11070, 0x11070, C::Mn}, {0x11071, 0x11072, C::Lo}, {0x11073, 0x11074, C::Mn},
+    {0x11075, 0x11075, C::Lo}, {0x1107F, 0x11081, C::Mn}, {0x11082, 0x11082, C::Mc},
+    {0x11083, 0x110AF, C::Lo}, {0x110B0, 0x110B2, C::Mc}, {0x110B3, 0x110B6, C::Mn},
+    {0x110B7, 0x110B8, C::Mc}, {0x110B9, 0x110BA, C::Mn}, {0x110BB, 0x110BC, C::Po},
+    {0x110BD, 0x110BD, C::Cf}, {0x110BE, 0x110C1, C::Po}, {0x110C2, 0x110C2, C::Mn},
+    {0x110CD, 0x110CD, C::Cf}, {0x110D0, 0x110E8, C::Lo}, {0x110F0, 0x110F9, C::Nd},
+    {0x11100, 0x11102, C::Mn}, {0x11103, 0x11126, C::Lo}, {0x11127, 0x1112B, C::Mn},
+    {0x1112C, 0x1112C, C::Mc}, {0x1112D, 0x11134, C::Mn}, {0x11136, 0x1113F, C::Nd},
+    {0x11140, 0x11143, C::Po}, {0x11144, 0x11144, C::Lo}, {0x11145, 0x11146, C::Mc},
+    {0x11147, 0x11147, C::Lo}, {0x11150, 0x11172, C::Lo}, {0x11173, 0x11173, C::Mn},
+    {0x11174, 0x11175, C::Po}, {0x11176, 0x11176, C::Lo}, {0x11180, 0x11181, C::Mn},
+    {0x11182, 0x11182, C::Mc}, {0x11183, 0x111B2, C::Lo}, {0x111B3, 0x111B5, C::Mc},
+    {0x111B6, 0x111BE, C::Mn}, {0x111BF, 0x111C0, C::Mc}, {0x111C1, 0x111C4, C::Lo},
+    {0x111C5, 0x111C8, C::Po}, {0x111C9, 0x111CC, C::Mn}, {0x111CD, 0x111CD, C::Po},
+    {0x111CE, 0x111CE, C::Mc}, {0x111CF, 0x111CF, C::Mn}, {0x111D0, 0x111D9, C::Nd},
+    {0x111DA, 0x111DA, C::Lo}, {0x111DB, 0x111DB, C::Po}, {0x111DC, 0x111DC, C::Lo},
+    {0x111DD, 0x111DF, C::Po}, {0x111E1, 0x111F4, C::No}, {0x11200, 0x11211, C::Lo},
+    {0x11213, 0x1122B, C::Lo}, {0x1122C, 0x1122E, C::Mc}, {0x1122F, 0x11231, C::Mn},
+    {0x11232, 0x11233, C::Mc}, {0x11234, 0x11234, C::Mn}, {0x11235, 0x11235, C::Mc},
+    {0x11236, 0x11237, C::Mn}, {0x11238, 0x1123D, C::Po}, {0x1123E, 0x1123E, C::Mn},
+    {0x1123F, 0x11240, C::Lo}, {0x11241, 0x11241, C::Mn}, {0x11280, 0x11286, C::Lo},
+    {0x11288, 0x11288, C::Lo}, {0x1128A, 0x1128D, C::Lo}, {0x1128F, 0x1129D, C::Lo},
+    {0x1129F, 0x112A8, C::Lo}, {0x112A9, 0x112A9, C::Po}, {0x112B0, 0x112DE, C::Lo},
+    {0x112DF, 0x112DF, C::Mn}, {0x112E0, 0x112E2, C::Mc}, {0x112E3, 0x112EA, C::Mn},
+    {0x112F0, 0x112F9, C::Nd}, {0x11300, 0x11301, C::Mn}, {0x11302, 0x11303, C::Mc},
+    {0x11305, 0x1130C, C::Lo}, {0x1130F, 0x11310, C::Lo}, {0x11313, 0x11328, C::Lo},
+    {0x1132A, 0x11330, C::Lo}, {0x11332, 0x11333, C::Lo}, {0x11335, 0x11339, C::Lo},
+    {0x1133B, 0x1133C, C::Mn}, {0x1133D, 0x1133D, C::Lo}, {0x1133E, 0x1133F, C::Mc},
+    {0x11340, 0x11340, C::Mn}, {0x11341, 0x11344, C::Mc}, {0x11347, 0x11348, C::Mc},
+    {0x1134B, 0x1134D, C::Mc}, {0x11350, 0x11350, C::Lo}, {0x11357, 0x11357, C::Mc},
+    {0x1135D, 0x11361, C::Lo}, {0x11362, 0x11363, C::Mc}, {0x11366, 0x1136C, C::Mn},
+    {0x11370, 0x11374, C::Mn}, {0x11400, 0x11434, C::Lo}, {0x11435, 0x11437, C::Mc},
+    {0x11438, 0x1143F, C::Mn}, {0x11440, 0x11441, C::Mc}, {0x11442, 0x11444, C::Mn},
+    {0x11445, 0x11445, C::Mc}, {0x11446, 0x11446, C::Mn}, {0x11447, 0x1144A, C::Lo},
+    {0x1144B, 0x1144F, C::Po}, {0x11450, 0x11459, C::Nd}, {0x1145A, 0x1145B, C::Po},
+    {0x1145D, 0x1145D, C::Po}, {0x1145E, 0x1145E, C::Mn}, {0x1145F, 0x11461, C::Lo},
+    {0x11480, 0x114AF, C::Lo}, {0x114B0, 0x114B2, C::Mc}, {0x114B3, 0x114B8, C::Mn},
+    {0x114B9, 0x114B9, C::Mc}, {0x114BA, 0x114BA, C::Mn}, {0x114BB, 0x114BE, C::Mc},
+    {0x114BF, 0x114C0, C::Mn}, {0x114C1, 0x114C1, C::Mc}, {0x114C2, 0x114C3, C::Mn},
+    {0x114C4, 0x114C5, C::Lo}, {0x114C6, 0x114C6, C::Po}, {0x114C7, 0x114C7, C::Lo},
+    {0x114D0, 0x114D9, C::Nd}, {0x11580, 0x115AE, C::Lo}, {0x115AF, 0x115B1, C::Mc},
+    {0x115B2, 0x115B5, C::Mn}, {0x115B8, 0x115BB, C::Mc}, {0x115BC, 0x115BD, C::Mn},
+    {0x115BE, 0x115BE, C::Mc}, {0x115BF, 0x115C0, C::Mn}, {0x115C1, 0x115D7, C::Po},
+    {0x115D8, 0x115DB, C::Lo}, {0x115DC, 0x115DD, C::Mn}, {0x11600, 0x1162F, C::Lo},
+    {0x11630, 0x11632, C::Mc}, {0x11633, 0x1163A, C::Mn}, {0x1163B, 0x1163C, C::Mc},
+    {0x1163D, 0x1163D, C::Mn}, {0x1163E, 0x1163E, C::Mc}, {0x1163F, 0x11640, C::Mn},
+    {0x11641, 0x11643, C::Po}, {0x11644, 0x11644, C::Lo}, {0x11650, 0x11659, C::Nd},
+    {0x11660, 0x1166C, C::Po}, {0x11680, 0x116AA, C::Lo}, {0x116AB, 0x116AB, C::Mn},
+    {0x116AC, 0x116AC, C::Mc}, {0x116AD, 0x116AD, C::Mn}, {0x116AE, 0x116AF, C::Mc},
+    {0x116B0, 0x116B5, C::Mn}, {0x116B6, 0x116B6, C::Mc}, {0x116B7, 0x116B7, C::Mn},
+    {0x116B8, 0x116B8, C::Lo}, {0x116B9, 0x116B9, C::Po}, {0x116C0, 0x116C9, C::Nd},
+    {0x11700, 0x1171A, C::Lo}, {0x1171D, 0x1171F, C::Mn}, {0x11720, 0x11721, C::Mc},
+    {0x11722, 0x11725, C::Mn}, {0x11726, 0x11726, C::Mc}, {0x11727, 0x1172B, C::Mn},
+    {0x11730, 0x11739, C::Nd}, {0x1173A, 0x1173B, C::No}, {0x1173C, 0x1173E, C::Po},
+    {0x1173F, 0x1173F, C::So}, {0x11740, 0x11746, C::Lo}, {0x11800, 0x1182B, C::Lo},
+    {0x1182C, 0x1182E, C::Mc}, {0x1182F, 0x11837, C::Mn}, {0x11838, 0x11838, C::Mc},
+    {0x11839, 0x1183A, C::Mn}, {0x1183B, 0x1183B, C::Po}, {0x118A0, 0x118BF, C::Lu},
+    {0x118C0, 0x118DF, C::Ll}, {0x118E0, 0x118E9, C::Nd}, {0x118EA, 0x118F2, C::No},
+    {0x118FF, 0x11906, C::Lo}, {0x11909, 0x11909, C::Lo}, {0x1190C, 0x11913, C::Lo},
+    {0x11915, 0x11916, C::Lo}, {0x11918, 0x1192F, C::Lo}, {0x11930, 0x11935, C::Mc},
+    {0x11937, 0x11938, C::Mc}, {0x1193B, 0x1193C, C::Mn}, {0x1193D, 0x1193D, C::Mc},
+    {0x1193E, 0x1193E, C::Mn}, {0x1193F, 0x1193F, C::Lo}, {0x11940, 0x11940, C::Mc},
+    {0x11941, 0x11941, C::Lo}, {0x11942, 0x11942, C::Mc}, {0x11943, 0x11943, C::Mn},
+    {0x11944, 0x11946, C::Po}, {0x11950, 0x11959, C::Nd}, {0x119A0, 0x119A7, C::Lo},
+    {0x119AA, 0x119D0, C::Lo}, {0x119D1, 0x119D3, C::Mc}, {0x119D4, 0x119D7, C::Mn},
+    {0x119DA, 0x119DB, C::Mn}, {0x119DC, 0x119DF, C::Mc}, {0x119E0, 0x119E0, C::Mn},
+    {0x119E1, 0x119E1, C::Lo}, {0x119E2, 0x119E2, C::Po}, {0x119E3, 0x119E3, C::Lo},
+    {0x119E4, 0x119E4, C::Mc}, {0x11A00, 0x11A00, C::Lo}, {0x11A01, 0x11A0A, C::Mn},
+    {0x11A0B, 0x11A32, C::Lo}, {0x11A33, 0x11A38, C::Mn}, {0x11A39, 0x11A39, C::Mc},
+    {0x11A3A, 0x11A3A, C::Lo}, {0x11A3B, 0x11A3E, C::Mn}, {0x11A3F, 0x11A46, C::Po},
+    {0x11A47, 0x11A47, C::Mn}, {0x11A50, 0x11A50, C::Lo}, {0x11A51, 0x11A56, C::Mn},
+    {0x11A57, 0x11A58, C::Mc}, {0x11A59, 0x11A5B, C::Mn}, {0x11A5C, 0x11A89, C::Lo},
+    {0x11A8A, 0x11A96, C::Mn}, {0x11A97, 0x11A97, C::Mc}, {0x11A98, 0x11A99, C::Mn},
+    {0x11A9A, 0x11A9C, C::Po}, {0x11A9D, 0x11A9D, C::Lo}, {0x11A9E, 0x11AA2, C::Po},
+    {0x11AB0, 0x11AF8, C::Lo}, {0x11B00, 0x11B09, C::Po}, {0x11C00, 0x11C08, C::Lo},
+    {0x11C0A, 0x11C2E, C::Lo}, {0x11C2F, 0x11C2F, C::Mc}, {0x11C30, 0x11C36, C::Mn},
+    {0x11C38, 0x11C3D, C::Mn}, {0x11C3E, 0x11C3E, C::Mc}, {0x11C3F, 0x11C3F, C::Mn},
+    {0x11C40, 0x11C40, C::Lo}, {0x11C41, 0x11C45, C::Po}, {0x11C50, 0x11C59, C::Nd},
+    {0x11C5A, 0x11C6C, C::No}, {0x11C70, 0x11C71, C::Po}, {0x11C72, 0x11C8F, C::Lo},
+    {0x11C92, 0x11CA7, C::Mn}, {0x11CA9, 0x11CA9, C::Mc}, {0x11CAA, 0x11CB0, C::Mn},
+    {0x11CB1, 0x11CB1, C::Mc}, {0x11CB2, 0x11CB3, C::Mn}, {0x11CB4, 0x11CB4, C::Mc},
+    {0x11CB5, 0x11CB6, C::Mn}, {0x11D00, 0x11D06, C::Lo}, {0x11D08, 0x11D09, C::Lo},
+    {0x11D0B, 0x11D30, C::Lo}, {0x11D31, 0x11D36, C::Mn}, {0x11D3A, 0x11D3A, C::Mn},
+    {0x11D3C, 0x11D3D, C::Mn}, {0x11D3F, 0x11D45, C::Mn}, {0x11D46, 0x11D46, C::Lo},
+    {0x11D47, 0x11D47, C::Mn}, {0x11D50, 0x11D59, C::Nd}, {0x11D60, 0x11D65, C::Lo},
+    {0x11D67, 0x11D68, C::Lo}, {0x11D6A, 0x11D89, C::Lo}, {0x11D8A, 0x11D8E, C::Mc},
+    {0x11D90, 0x11D91, C::Mn}, {0x11D93, 0x11D94, C::Mc}, {0x11D95, 0x11D95, C::Mn},
+    {0x11D96, 0x11D96, C::Mc}, {0x11D97, 0x11D97, C::Mn}, {0x11D98, 0x11D98, C::Lo},
+    {0x11DA0, 0x11DA9, C::Nd}, {0x11EE0, 0x11EF2, C::Lo}, {0x11EF3, 0x11EF4, C::Mn},
+    {0x11EF5, 0x11EF6, C::Mc}, {0x11EF7, 0x11EF8, C::Po}, {0x11F00, 0x11F01, C::Mn},
+    {0x11F02, 0x11F02, C::Lo}, {0x11F03, 0x11F03, C::Mc}, {0x11F04, 0x11F10, C::Lo},
+    {0x11F12, 0x11F33, C::Lo}, {0x11F34, 0x11F35, C::Mc}, {0x11F36, 0x11F3A, C::Mn},
+    {0x11F3E, 0x11F3F, C::Mc}, {0x11F40, 0x11F40, C::Mn}, {0x11F41, 0x11F41, C::Mc},
+    {0x11F42, 0x11F42, C::Mn}, {0x11F43, 0x11F4F, C::Po}, {0x11F50, 0x11F59, C::Nd},
+    {0x11FB0, 0x11FB0, C::Lo}, {0x11FC0, 0x11FD4, C::No}, {0x11FD5, 0x11FDC, C::So},
+    {0x11FDD, 0x11FE0, C::Sc}, {0x11FE1, 0x11FF1, C::So}, {0x11FFF, 0x11FFF, C::Po},
+    {0x12000, 0x12399, C::Lo}, {0x12400, 0x1246E, C::Nl}, {0x12470, 0x12474, C::Po},
+    {0x12480, 0x12543, C::Lo}, {0x12F90, 0x12FF0, C::Lo}, {0x12FF1, 0x12FF2, C::Po},
+    {0x13000, 0x1342F, C::Lo}, {0x13430, 0x1343F, C::Cf}, {0x13440, 0x13440, C::Mn},
+    {0x13441, 0x13446, C::Lo}, {0x13447, 0x13455, C::Mn}, {0x14400, 0x14646, C::Lo},
+    {0x16800, 0x16A38, C::Lo}, {0x16A40, 0x16A5E, C::Lo}, {0x16A60, 0x16A69, C::Nd},
+    {0x16A6E, 0x16A6F, C::Po}, {0x16A70, 0x16ABE, C::Lo}, {0x16AC0, 0x16AC9, C::Nd},
+    {0x16AD0, 0x16AED, C::Lo}, {0x16AF0, 0x16AF4, C::Mn}, {0x16AF5, 0x16AF5, C::Po},
+    {0x16B00, 0x16B2F, C::Lo}, {0x16B30, 0x16B36, C::Mn}, {0x16B37, 0x16B3B, C::Po},
+    {0x16B3C, 0x16B3F, C::So}, {0x16B40, 0x16B43, C::Lm}, {0x16B44, 0x16B44, C::Po},
+    {0x16B45, 0x16B45, C::So}, {0x16B50, 0x16B59, C::Nd}, {0x16B5B, 0x16B61, C::No},
+    {0x16B63, 0x16B77, C::Lo}, {0x16B7D, 0x16B8F, C::Lo}, {0x16E40, 0x16E5F, C::Lu},
+    {0x16E60, 0x16E7F, C::Ll}, {0x16E80, 0x16E96, C::No}, {0x16E97, 0x16E9A, C::Po},
+    {0x16F00, 0x16F4A, C::Lo}, {0x16F4F, 0x16F4F, C::Mn}, {0x16F50, 0x16F50, C::Lo},
+    {0x16F51, 0x16F87, C::Mc}, {0x16F8F, 0x16F92, C::Mn}, {0x16F93, 0x16F9F, C::Lm},
+    {0x16FE0, 0x16FE1, C::Lm}, {0x16FE2, 0x16FE2, C::Po}, {0x16FE3, 0x16FE3, C::Lm},
+    {0x16FE4, 0x16FE4, C::Mn}, {0x16FF0, 0x16FF1, C::Mc}, {0x17000, 0x187F7, C::Lo},
+    {0x18800, 0x18CD5, C::Lo}, {0x18D00, 0x18D08, C::Lo}, {0x1AFF0, 0x1AFF3, C::Lm},
+    {0x1AFF5, 0x1AFFB, C::Lm}, {0x1AFFD, 0x1AFFE, C::Lm}, {0x1B000, 0x1B122, C::Lo},
+    {0x1B132, 0x1B132, C::Lo}, {0x1B150, 0x1B152, C::Lo}, {0x1B155, 0x1B155, C::Lo},
+    {0x1B164, 0x1B167, C::Lo}, {0x1B170, 0x1B2FB, C::Lo}, {0x1BC00, 0x1BC6A, C::Lo},
+    {0x1BC70, 0x1BC7C, C::Lo}, {0x1BC80, 0x1BC88, C::Lo}, {0x1BC90, 0x1BC99, C::Lo},
+    {0x1BC9C, 0x1BC9C, C::So}, {0x1BC9D, 0x1BC9E, C::Mn}, {0x1BC9F, 0x1BC9F, C::Po},
+    {0x1BCA0, 0x1BCA3, C::Cf}, {0x1CF00, 0x1CF2D, C::Mn}, {0x1CF30, 0x1CF46, C::Mn},
+    {0x1CF50, 0x1CFC3, C::So}, {0x1D000, 0x1D0F5, C::So}, {0x1D100, 0x1D126, C::So},
+    {0x1D129, 0x1D164, C::So}, {0x1D165, 0x1D166, C::Mc}, {0x1D167, 0x1D169, C::Mn},
+    {0x1D16A, 0x1D16C, C::So}, {0x1D16D, 0x1D172, C::Mc}, {0x1D173, 0x1D17A, C::Cf},
+    {0x1D17B, 0x1D182, C::Mn}, {0x1D183, 0x1D184, C::So}, {0x1D185, 0x1D18B, C::Mn},
+    {0x1D18C, 0x1D1A9, C::So}, {0x1D1AA, 0x1D1AD, C::Mn}, {0x1D1AE, 0x1D1EA, C::So},
+    {0x1D200, 0x1D241, C::So}, {0x1D242, 0x1D244, C::Mn}, {0x1D245, 0x1D245, C::So},
+    {0x1D2C0, 0x1D2D3, C::No}, {0x1D2E0, 0x1D2F3, C::No}, {0x1D300, 0x1D356, C::So},
+    {0x1D360, 0x1D378, C::No}, {0x1D400, 0x1D419, C::Lu}, {0x1D41A, 0x1D433, C::Ll},
+    {0x1D434, 0x1D44D, C::Lu}, {0x1D44E, 0x1D454, C::Ll}, {0x1D456, 0x1D467, C::Ll},
+    {0x1D468, 0x1D481, C::Lu}, {0x1D482, 0x1D49B, C::Ll}, {0x1D49C, 0x1D49C, C::Lu},
+    {0x1D49E, 0x1D49F, C::Lu}, {0x1D4A2, 0x1D4A2, C::Lu}, {0x1D4A5, 0x1D4A6, C::Lu},
+    {0x1D4A9, 0x1D4AC, C::Lu}, {0x1D4AE, 0x1D4B5, C::Lu}, {0x1D4B6, 0x1D4B9, C::Ll},
+    {0x1D4BB, 0x1D4BB, C::Ll}, {0x1D4BD, 0x1D4C3, C::Ll}, {0x1D4C5, 0x1D4CF, C::Ll},
+    {0x1D4D0, 0x1D4E9, C::Lu}, {0x1D4EA, 0x1D503, C::Ll}, {0x1D504, 0x1D505, C::Lu},
+    {0x1D507, 0x1D50A, C::Lu}, {0x1D50D, 0x1D514, C::Lu}, {0x1D516, 0x1D51C, C::Lu},
+    {0x1D51E, 0x1D537, C::Ll}, {0x1D538, 0x1D539, C::Lu}, {0x1D53B, 0x1D53E, C::Lu},
+    {0x1D540, 0x1D544, C::Lu}, {0x1D546, 0x1D546, C::Lu}, {0x1D54A, 0x1D550, C::Lu},
+    {0x1D552, 0x1D56B, C::Ll}, {0x1D56C, 0x1D585, C::Lu}, {0x1D586, 0x1D59F, C::Ll},
+    {0x1D5A0, 0x1D5B9, C::Lu}, {0x1D5BA, 0x1D5D3, C::Ll}, {0x1D5D4, 0x1D5ED, C::Lu},
+    {0x1D5EE, 0x1D607, C::Ll}, {0x1D608, 0x1D621, C::Lu}, {0x1D622, 0x1D63B, C::Ll},
+    {0x1D63C, 0x1D655, C::Lu}, {0x1D656, 0x1D66F, C::Ll}, {0x1D670, 0x1D689, C::Lu},
+    {0x1D68A, 0x1D6A5, C::Ll}, {0x1D6A8, 0x1D6C0, C::Lu}, {0x1D6C1, 0x1D6C1, C::Sm},
+    {0x1D6C2, 0x1D6DA, C::Ll}, {0x1D6DB, 0x1D6DB, C::Sm}, {0x1D6DC, 0x1D6E1, C::Ll},
+    {0x1D6E2, 0x1D6FA, C::Lu}, {0x1D6FB, 0x1D6FB, C::Sm}, {0x1D6FC, 0x1D714, C::Ll},
+    {0x1D715, 0x1D715, C::Sm}, {0x1D716, 0x1D71B, C::Ll}, {0x1D71C, 0x1D734, C::Lu},
+    {0x1D735, 0x1D735, C::Sm}, {0x1D736, 0x1D74E, C::Ll}, {0x1D74F, 0x1D74F, C::Sm},
+    {0x1D750, 0x1D755, C::Ll}, {0x1D756, 0x1D76E, C::Lu}, {0x1D76F, 0x1D76F, C::Sm},
+    {0x1D770, 0x1D788, C::Ll}, {0x1D789, 0x1D789, C::Sm}, {0x1D78A, 0x1D78F, C::Ll},
+    {0x1D790, 0x1D7A8, C::Lu}, {0x1D7A9, 0x1D7A9, C::Sm}, {0x1D7AA, 0x1D7C2, C::Ll},
+    {0x1D7C3, 0x1D7C3, C::Sm}, {0x1D7C4, 0x1D7C9, C::Ll}, {0x1D7CA, 0x1D7CA, C::Lu},
+    {0x1D7CB, 0x1D7CB, C::Ll}, {0x1D7CE, 0x1D7FF, C::Nd}, {0x1D800, 0x1D9FF, C::So},
+    {0x1DA00, 0x1DA36, C::Mn}, {0x1DA37, 0x1DA3A, C::So}, {0x1DA3B, 0x1DA6C, C::Mn},
+    {0x1DA6D, 0x1DA74, C::So}, {0x1DA75, 0x1DA75, C::Mn}, {0x1DA76, 0x1DA83, C::So},
+    {0x1DA84, 0x1DA84, C::Mn}, {0x1DA85, 0x1DA86, C::So}, {0x1DA87, 0x1DA8B, C::Po},
+    {0x1DA9B, 0x1DA9F, C::Mn}, {0x1DAA1, 0x1DAAF, C::Mn}, {0x1DF00, 0x1DF09, C::Ll},
+    {0x1DF0A, 0x1DF0A, C::Lo}, {0x1DF0B, 0x1DF1E, C::Ll}, {0x1DF25, 0x1DF2A, C::Ll},
+    {0x1E000, 0x1E006, C::Mn}, {0x1E008, 0x1E018, C::Mn}, {0x1E01B, 0x1E021, C::Mn},
+    {0x1E023, 0x1E024, C::Mn}, {0x1E026, 0x1E02A, C::Mn}, {0x1E030, 0x1E06D, C::Lm},
+    {0x1E08F, 0x1E08F, C::Mn}, {0x1E100, 0x1E12C, C::Lo}, {0x1E130, 0x1E136, C::Mn},
+    {0x1E137, 0x1E13D, C::Lm}, {0x1E140, 0x1E149, C::Nd}, {0x1E14E, 0x1E14E, C::Lo},
+    {0x1E14F, 0x1E14F, C::So}, {0x1E290, 0x1E2AD, C::Lo}, {0x1E2AE, 0x1E2AE, C::Mn},
+    {0x1E2C0, 0x1E2EB, C::Lo}, {0x1E2EC, 0x1E2EF, C::Mn}, {0x1E2F0, 0x1E2F9, C::Nd},
+    {0x1E2FF, 0x1E2FF, C::Sc}, {0x1E4D0, 0x1E4EA, C::Lo}, {0x1E4EB, 0x1E4EB, C::Lm},
+    {0x1E4EC, 0x1E4EF, C::Mn}, {0x1E4F0, 0x1E4F9, C::Nd}, {0x1E7E0, 0x1E7E6, C::Lo},
+    {0x1E7E8, 0x1E7EB, C::Lo}, {0x1E7ED, 0x1E7EE, C::Lo}, {0x1E7F0, 0x1E7FE, C::Lo},
+    {0x1E800, 0x1E8C4, C::Lo}, {0x1E8C7, 0x1E8CF, C::No}, {0x1E8D0, 0x1E8D6, C::Mn},
+    {0x1E900, 0x1E921, C::Lu}, {0x1E922, 0x1E943, C::Ll}, {0x1E944, 0x1E94A, C::Mn},
+    {0x1E94B, 0x1E94B, C::Lm}, {0x1E950, 0x1E959, C::Nd}, {0x1E95E, 0x1E95F, C::Po},
+    {0x1EC71, 0x1ECAB, C::No}, {0x1ECAC, 0x1ECAC, C::So}, {0x1ECAD, 0x1ECAF, C::No},
+    {0x1ECB0, 0x1ECB0, C::Sc}, {0x1ECB1, 0x1ECB4, C::No}, {0x1ED01, 0x1ED2D, C::No},
+    {0x1ED2E, 0x1ED2E, C::So}, {0x1ED2F, 0x1ED3D, C::No}, {0x1EE00, 0x1EE03, C::Lo},
+    {0x1EE05, 0x1EE1F, C::Lo}, {0x1EE21, 0x1EE22, C::Lo}, {0x1EE24, 0x1EE24, C::Lo},
+    {0x1EE27, 0x1EE27, C::Lo}, {0x1EE29, 0x1EE32, C::Lo}, {0x1EE34, 0x1EE37, C::Lo},
+    {0x1EE39, 0x1EE39, C::Lo}, {0x1EE3B, 0x1EE3B, C::Lo}, {0x1EE42, 0x1EE42, C::Lo},
+    {0x1EE47, 0x1EE47, C::Lo}, {0x1EE49, 0x1EE49, C::Lo}, {0x1EE4B, 0x1EE4B, C::Lo},
+    {0x1EE4D, 0x1EE4F, C::Lo}, {0x1EE51, 0x1EE52, C::Lo}, {0x1EE54, 0x1EE54, C::Lo},
+    {0x1EE57, 0x1EE57, C::Lo}, {0x1EE59, 0x1EE59, C::Lo}, {0x1EE5B, 0x1EE5B, C::Lo},
+    {0x1EE5D, 0x1EE5D, C::Lo}, {0x1EE5F, 0x1EE5F, C::Lo}, {0x1EE61, 0x1EE62, C::Lo},
+    {0x1EE64, 0x1EE64, C::Lo}, {0x1EE67, 0x1EE6A, C::Lo}, {0x1EE6C, 0x1EE72, C::Lo},
+    {0x1EE74, 0x1EE77, C::Lo}, {0x1EE79, 0x1EE7C, C::Lo}, {0x1EE7E, 0x1EE7E, C::Lo},
+    {0x1EE80, 0x1EE89, C::Lo}, {0x1EE8B, 0x1EE9B, C::Lo}, {0x1EEA1, 0x1EEA3, C::Lo},
+    {0x1EEA5, 0x1EEA9, C::Lo}, {0x1EEAB, 0x1EEBB, C::Lo}, {0x1EEF0, 0x1EEF1, C::Sm},
+    {0x1F000, 0x1F02B, C::So}, {0x1F030, 0x1F093, C::So}, {0x1F0A0, 0x1F0AE, C::So},
+    {0x1F0B1, 0x1F0BF, C::So}, {0x1F0C1, 0x1F0CF, C::So}, {0x1F0D1, 0x1F0F5, C::So},
+    {0x1F100, 0x1F10C, C::No}, {0x1F10D, 0x1F1AD, C::So}, {0x1F1E6, 0x1F202, C::So},
+    {0x1F210, 0x1F23B, C::So}, {0x1F240, 0x1F248, C::So}, {0x1F250, 0x1F251, C::So},
+    {0x1F260, 0x1F265, C::So}, {0x1F300, 0x1F3FA, C::So}, {0x1F3FB, 0x1F3FF, C::Sk},
+    {0x1F400, 0x1F6D7, C::So}, {0x1F6DC, 0x1F6EC, C::So}, {0x1F6F0, 0x1F6FC, C::So},
+    {0x1F700, 0x1F776, C::So}, {0x1F77B, 0x1F7D9, C::So}, {0x1F7E0, 0x1F7EB, C::So},
+    {0x1F7F0, 0x1F7F0, C::So}, {0x1F800, 0x1F80B, C::So}, {0x1F810, 0x1F847, C::So},
+    {0x1F850, 0x1F859, C::So}, {0x1F860, 0x1F887, C::So}, {0x1F890, 0x1F8AD, C::So},
+    {0x1F8B0, 0x1F8B1, C::So}, {0x1F900, 0x1FA53, C::So}, {0x1FA60, 0x1FA6D, C::So},
+    {0x1FA70, 0x1FA7C, C::So}, {0x1FA80, 0x1FA88, C::So}, {0x1FA90, 0x1FABD, C::So},
+    {0x1FABF, 0x1FAC5, C::So}, {0x1FACE, 0x1FADB, C::So}, {0x1FAE0, 0x1FAE8, C::So},
+    {0x1FAF0, 0x1FAF8, C::So}, {0x1FB00, 0x1FB92, C::So}, {0x1FB94, 0x1FBCA, C::So},
+    {0x1FBF0, 0x1FBF9, C::Nd}, {0x20000, 0x2A6DF, C::Lo}, {0x2A700, 0x2B739, C::Lo},
+    {0x2B740, 0x2B81D, C::Lo}, {0x2B820, 0x2CEA1, C::Lo}, {0x2CEB0, 0x2EBE0, C::Lo},
+    {0x2F800, 0x2FA1D, C::Lo}, {0x30000, 0x3134A, C::Lo}, {0x31350, 0x323AF, C::Lo},
+    {0xE0001, 0xE0001, C::Cf}, {0xE0020, 0xE007F, C::Cf}, {0xE0100, 0xE01EF, C::Mn},
+    {0xF0000, 0xFFFFD, C::Co}, {0x100000, 0x10FFFD, C::Co},
+};
+
+const size_t UNICODE_RANGE_COUNT = sizeof(UNICODE_RANGES) / sizeof(UNICODE_RANGES[0]);
+
+} // namespace llaisys::tokenizer
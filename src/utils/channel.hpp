@@ -0,0 +1,188 @@
+#pragma once
+
+#include "shm.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace llaisys::utils {
+
+// Lock-free queues for handing work between threads of one process. Neither
+// side ever takes a lock: producers publish with a single atomic, and only a
+// consumer with nothing to do sleeps, on a futex word that producers bump
+// (and wake, if someone sleeps there) after publishing.
+//
+// The sleep protocol is the one of ProcessBarrier: the consumer announces
+// itself in `sleeping` and re-checks before sleeping, producers bump `events`
+// and then look at `sleeping`, all seq_cst, so a wake-up is never lost.
+
+namespace detail {
+struct Waiter {
+    std::atomic<uint32_t> events{0};
+    std::atomic<uint32_t> sleeping{0};
+
+    void notify() {
+        events.fetch_add(1);
+        if (sleeping.load() > 0) {
+            futexWake(&events);
+        }
+    }
+
+    // Sleep until `ready()`; spurious returns are fine for callers that loop.
+    template <typename Ready>
+    void wait(const Ready &ready) {
+        for (;;) {
+            const uint32_t seen = events.load();
+            if (ready()) {
+                return;
+            }
+            sleeping.fetch_add(1);
+            if (events.load() == seen && !ready()) {
+                futexWait(&events, seen);
+            }
+            sleeping.fetch_sub(1);
+        }
+    }
+};
+} // namespace detail
+
+// Unbounded multi-producer single-consumer FIFO (Vyukov's node-based queue).
+// push() is wait-free apart from the node allocation; pop() and wait() belong
+// to the single consumer.
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : _head(new Node), _tail(_head) {}
+    ~MpscQueue() {
+        while (_head != nullptr) {
+            Node *next = _head->next.load(std::memory_order_relaxed);
+            delete _head;
+            _head = next;
+        }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    // Any thread.
+    void push(T value) {
+        Node *node = new Node;
+        node->value = std::move(value);
+        Node *prev = _tail.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+        _waiter.notify();
+    }
+
+    // Any thread: wake the consumer for good; pop() still drains what is queued.
+    void close() {
+        _closed.store(true);
+        _waiter.notify();
+    }
+    bool closed() const { return _closed.load(); }
+
+    // Consumer. A push still in progress may be missed; its notify follows.
+    bool pop(T &out) {
+        Node *next = _head->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+        out = std::move(next->value);
+        delete _head;
+        _head = next; // the new stub; its value has been moved out
+        return true;
+    }
+
+    // Consumer: block until the queue is non-empty or closed.
+    void wait() {
+        _waiter.wait([this] { return closed() || _head->next.load(std::memory_order_acquire) != nullptr; });
+    }
+
+private:
+    struct Node {
+        std::atomic<Node *> next{nullptr};
+        T value{};
+    };
+
+    Node *_head; // consumer side
+    alignas(64) std::atomic<Node *> _tail;
+    alignas(64) std::atomic<bool> _closed{false};
+    detail::Waiter _waiter;
+};
+
+// Bounded single-producer single-consumer ring. The producer never blocks:
+// tryPush() fails on a full ring, so size it for the most values that can
+// ever be outstanding (e.g. a request's max_tokens). close() ends the stream.
+template <typename T>
+class SpscChannel {
+public:
+    // Capacity is rounded up to a power of two.
+    explicit SpscChannel(size_t capacity) {
+        size_t n = 1;
+        while (n < capacity) {
+            n <<= 1;
+        }
+        _mask = n - 1;
+        _slots.reset(new T[n]);
+    }
+
+    SpscChannel(const SpscChannel &) = delete;
+    SpscChannel &operator=(const SpscChannel &) = delete;
+
+    size_t capacity() const { return _mask + 1; }
+
+    // Producer.
+    bool tryPush(T value) {
+        const size_t h = _head.load(std::memory_order_relaxed);
+        if (h - _tail.load(std::memory_order_acquire) > _mask) {
+            return false;
+        }
+        _slots[h & _mask] = std::move(value);
+        _head.store(h + 1, std::memory_order_release);
+        _waiter.notify();
+        return true;
+    }
+
+    // Producer: no more values. Everything written before close() (values
+    // and anything else) is visible to the consumer once it sees the close.
+    void close() {
+        _closed.store(true, std::memory_order_release);
+        _waiter.notify();
+    }
+
+    // Consumer: append everything available to `out`; returns the count.
+    size_t drain(std::vector<T> &out) {
+        const size_t t = _tail.load(std::memory_order_relaxed);
+        const size_t h = _head.load(std::memory_order_acquire);
+        for (size_t i = t; i != h; i++) {
+            out.push_back(std::move(_slots[i & _mask]));
+        }
+        _tail.store(h, std::memory_order_release);
+        return h - t;
+    }
+
+    // Consumer: block until values arrive or the channel is closed, then
+    // drain them into `out`. Returns false once closed and fully drained.
+    bool wait(std::vector<T> &out) {
+        _waiter.wait([this] {
+            return _closed.load(std::memory_order_acquire)
+                || _head.load(std::memory_order_acquire) != _tail.load(std::memory_order_relaxed);
+        });
+        // Values pushed before close() are drained first.
+        const bool closed = _closed.load(std::memory_order_acquire);
+        return drain(out) > 0 || !closed;
+    }
+
+private:
+    std::unique_ptr<T[]> _slots;
+    size_t _mask;
+    alignas(64) std::atomic<size_t> _head{0}; // producer
+    alignas(64) std::atomic<size_t> _tail{0}; // consumer
+    alignas(64) std::atomic<bool> _closed{false};
+    detail::Waiter _waiter;
+};
+
+} // namespace llaisys::utils
@@ -0,0 +1,412 @@
+#include "json.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace llaisys::utils {
+
+class JsonParser {
+public:
+    JsonParser(const std::string &text) : _text(text) {}
+
+    Json parseDocument() {
+        Json value = _parseValue(0);
+        _skipSpace();
+        if (_pos != _text.size()) {
+            _fail("trailing characters");
+        }
+        return value;
+    }
+
+private:
+    static constexpr int MAX_DEPTH = 128;
+
+    const std::string &_text;
+    size_t _pos = 0;
+
+    [[noreturn]] void _fail(const std::string &what) const {
+        throw std::invalid_argument("json: " + what + " at offset " + std::to_string(_pos));
+    }
+
+    void _skipSpace() {
+        while (_pos < _text.size() && (_text[_pos] == ' ' || _text[_pos] == '\t' || _text[_pos] == '\n' || _text[_pos] == '\r')) {
+            _pos++;
+        }
+    }
+
+    bool _consume(char c) {
+        _skipSpace();
+        if (_pos < _text.size() && _text[_pos] == c) {
+            _pos++;
+            return true;
+        }
+        return false;
+    }
+
+    void _expect(char c) {
+        if (!_consume(c)) {
+            _fail(std::string("expected '") + c + "'");
+        }
+    }
+
+    void _literal(const char *word) {
+        for (const char *p = word; *p; p++, _pos++) {
+            if (_pos >= _text.size() || _text[_pos] != *p) {
+                _fail("invalid literal");
+            }
+        }
+    }
+
+    Json _parseValue(int depth) {
+        if (depth > MAX_DEPTH) {
+            _fail("nesting too deep");
+        }
+        _skipSpace();
+        if (_pos >= _text.size()) {
+            _fail("unexpected end of input");
+        }
+        switch (_text[_pos]) {
+        case '{': {
+            _pos++;
+            Json obj = Json::object();
+            if (_consume('}')) {
+                return obj;
+            }
+            do {
+                _skipSpace();
+                std::string key = _parseString();
+                _expect(':');
+                // Appended without a duplicate-key lookup: tokenizer vocabularies have 100k+ keys.
+                obj._object.emplace_back(std::move(key), _parseValue(depth + 1));
+            } while (_consume(','));
+            _expect('}');
+            return obj;
+        }
+        case '[': {
+            _pos++;
+            Json arr = Json::array();
+            if (_consume(']')) {
+                return arr;
+            }
+            do {
+                arr.push(_parseValue(depth + 1));
+            } while (_consume(','));
+            _expect(']');
+            return arr;
+        }
+        case '"':
+            return Json(_parseString());
+        case 't':
+            _literal("true");
+            return Json(true);
+        case 'f':
+            _literal("false");
+            return Json(false);
+        case 'n':
+            _literal("null");
+            return Json();
+        default:
+            return Json(_parseNumber());
+        }
+    }
+
+    double _parseNumber() {
+        const char *begin = _text.c_str() + _pos;
+        char *end = nullptr;
+        double value = std::strtod(begin, &end);
+        if (end == begin) {
+            _fail("invalid value");
+        }
+        _pos += static_cast<size_t>(end - begin);
+        return value;
+    }
+
+    unsigned _parseHex4() {
+        if (_pos + 4 > _text.size()) {
+            _fail("truncated escape");
+        }
+        unsigned code = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = _text[_pos++];
+            code <<= 4;
+            if (c >= '0' && c <= '9') {
+                code |= static_cast<unsigned>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                code |= static_cast<unsigned>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                code |= static_cast<unsigned>(c - 'A' + 10);
+            } else {
+                _fail("invalid escape");
+            }
+        }
+        return code;
+    }
+
+    static void _appendUtf8(std::string &out, unsigned code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    std::string _parseString() {
+        if (_pos >= _text.size() || _text[_pos] != '"') {
+            _fail("expected string");
+        }
+        _pos++;
+        std::string out;
+        while (true) {
+            if (_pos >= _text.size()) {
+                _fail("unterminated string");
+            }
+            char c = _text[_pos++];
+            if (c == '"') {
+                return out;
+            }
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (_pos >= _text.size()) {
+                _fail("unterminated string");
+            }
+            switch (_text[_pos++]) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                unsigned code = _parseHex4();
+                // Surrogate pair
+                if (code >= 0xD800 && code < 0xDC00 && _pos + 1 < _text.size() && _text[_pos] == '\\' && _text[_pos + 1] == 'u') {
+                    _pos += 2;
+                    unsigned low = _parseHex4();
+                    if (low < 0xDC00 || low >= 0xE000) {
+                        _fail("invalid surrogate pair");
+                    }
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                _appendUtf8(out, code);
+                break;
+            }
+            default:
+                _fail("invalid escape");
+            }
+        }
+    }
+};
+
+namespace {
+
+void dumpString(std::string &out, const std::string &s) {
+    out += '"';
+    for (char c : s) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                out += buf;
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+Json Json::array() {
+    Json value;
+    value._type = Type::Array;
+    return value;
+}
+
+Json Json::object() {
+    Json value;
+    value._type = Type::Object;
+    return value;
+}
+
+Json Json::parse(const std::string &text) {
+    return JsonParser(text).parseDocument();
+}
+
+bool Json::asBool() const {
+    if (_type != Type::Bool) {
+        throw std::invalid_argument("json: expected a boolean");
+    }
+    return _bool;
+}
+
+double Json::asNumber() const {
+    if (_type != Type::Number) {
+        throw std::invalid_argument("json: expected a number");
+    }
+    return _number;
+}
+
+int64_t Json::asInt() const {
+    double value = asNumber();
+    if (value != std::floor(value)) {
+        throw std::invalid_argument("json: expected an integer");
+    }
+    return static_cast<int64_t>(value);
+}
+
+const std::string &Json::asString() const {
+    if (_type != Type::String) {
+        throw std::invalid_argument("json: expected a string");
+    }
+    return _string;
+}
+
+const std::vector<Json> &Json::asArray() const {
+    if (_type != Type::Array) {
+        throw std::invalid_argument("json: expected an array");
+    }
+    return _array;
+}
+
+bool Json::contains(const std::string &key) const {
+    for (const auto &item : _object) {
+        if (item.first == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const Json &Json::operator[](const std::string &key) const {
+    static const Json null_value;
+    for (const auto &item : _object) {
+        if (item.first == key) {
+            return item.second;
+        }
+    }
+    return null_value;
+}
+
+Json &Json::operator[](const std::string &key) {
+    if (_type == Type::Null) {
+        _type = Type::Object;
+    }
+    if (_type != Type::Object) {
+        throw std::invalid_argument("json: expected an object");
+    }
+    for (auto &item : _object) {
+        if (item.first == key) {
+            return item.second;
+        }
+    }
+    _object.emplace_back(key, Json());
+    return _object.back().second;
+}
+
+const std::vector<std::pair<std::string, Json>> &Json::items() const {
+    if (_type != Type::Object) {
+        throw std::invalid_argument("json: expected an object");
+    }
+    return _object;
+}
+
+size_t Json::size() const {
+    return _type == Type::Array ? _array.size() : _object.size();
+}
+
+const Json &Json::operator[](size_t index) const {
+    return asArray().at(index);
+}
+
+void Json::push(Json value) {
+    if (_type == Type::Null) {
+        _type = Type::Array;
+    }
+    if (_type != Type::Array) {
+        throw std::invalid_argument("json: expected an array");
+    }
+    _array.push_back(std::move(value));
+}
+
+std::string Json::dump() const {
+    std::string out;
+    _dump(out);
+    return out;
+}
+
+void Json::_dump(std::string &out) const {
+    switch (_type) {
+    case Type::Null:
+        out += "null";
+        break;
+    case Type::Bool:
+        out += _bool ? "true" : "false";
+        break;
+    case Type::Number: {
+        char buf[32];
+        if (!std::isfinite(_number)) {
+            out += "null";
+            break;
+        }
+        if (_number == std::floor(_number) && std::fabs(_number) < 9007199254740992.0) {
+            std::snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(_number));
+        } else {
+            std::snprintf(buf, sizeof(buf), "%.17g", _number);
+        }
+        out += buf;
+        break;
+    }
+    case Type::String:
+        dumpString(out, _string);
+        break;
+    case Type::Array:
+        out += '[';
+        for (size_t i = 0; i < _array.size(); i++) {
+            if (i > 0) {
+                out += ',';
+            }
+            _array[i]._dump(out);
+        }
+        out += ']';
+        break;
+    case Type::Object:
+        out += '{';
+        for (size_t i = 0; i < _object.size(); i++) {
+            if (i > 0) {
+                out += ',';
+            }
+            dumpString(out, _object[i].first);
+            out += ':';
+            _object[i].second._dump(out);
+        }
+        out += '}';
+        break;
+    }
+}
+
+} // namespace llaisys::utils
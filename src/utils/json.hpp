@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llaisys::utils {
+
+// Minimal JSON value for config files and the HTTP API. Objects keep insertion
+// order so responses serialize the way they are built. Parse errors throw
+// std::invalid_argument.
+class Json {
+public:
+    enum class Type {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object,
+    };
+
+    Json() = default;
+    Json(std::nullptr_t) {}
+    Json(bool value) : _type(Type::Bool), _bool(value) {}
+    Json(double value) : _type(Type::Number), _number(value) {}
+    Json(int value) : Json(static_cast<double>(value)) {}
+    Json(int64_t value) : Json(static_cast<double>(value)) {}
+    Json(uint64_t value) : Json(static_cast<double>(value)) {}
+    Json(const char *value) : _type(Type::String), _string(value) {}
+    Json(std::string value) : _type(Type::String), _string(std::move(value)) {}
+
+    static Json array();
+    static Json object();
+    static Json parse(const std::string &text);
+
+    std::string dump() const;
+
+    Type type() const { return _type; }
+    bool isNull() const { return _type == Type::Null; }
+    bool isBool() const { return _type == Type::Bool; }
+    bool isNumber() const { return _type == Type::Number; }
+    bool isString() const { return _type == Type::String; }
+    bool isArray() const { return _type == Type::Array; }
+    bool isObject() const { return _type == Type::Object; }
+
+    // Typed access; throw std::invalid_argument on a type mismatch.
+    bool asBool() const;
+    double asNumber() const;
+    int64_t asInt() const;
+    const std::string &asString() const;
+    const std::vector<Json> &asArray() const;
+
+    // Object access. The const lookup returns a null value for missing keys.
+    bool contains(const std::string &key) const;
+    const Json &operator[](const std::string &key) const;
+    Json &operator[](const std::string &key);
+    const std::vector<std::pair<std::string, Json>> &items() const;
+
+    // Array access
+    size_t size() const;
+    const Json &operator[](size_t index) const;
+    void push(Json value);
+
+private:
+    Type _type = Type::Null;
+    bool _bool = false;
+    double _number = 0.0;
+    std::string _string;
+    std::vector<Json> _array;
+    std::vector<std::pair<std::string, Json>> _object;
+
+    void _dump(std::string &out) const;
+
+    friend class JsonParser;
+};
+
+} // namespace llaisys::utils
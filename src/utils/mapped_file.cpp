@@ -0,0 +1,112 @@
+#include "mapped_file.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace llaisys::utils {
+
+namespace {
+[[noreturn]] void fail(const std::string &what, const std::string &path, int error) {
+    throw std::runtime_error("MappedFile: " + what + " " + path + ": " + std::strerror(error));
+}
+} // namespace
+
+MappedFile::MappedFile(const std::string &path, size_t size) : _size(size) {
+#ifdef _WIN32
+    (void)path;
+    throw std::runtime_error("MappedFile: file-backed weights need POSIX");
+#else
+    _fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (_fd < 0) {
+        fail("cannot create", path, errno);
+    }
+    unlink(path.c_str());
+#ifdef __linux__
+    const int error = size > 0 ? posix_fallocate(_fd, 0, static_cast<off_t>(size)) : 0;
+#else
+    const int error = ftruncate(_fd, static_cast<off_t>(size)) == 0 ? 0 : errno;
+#endif
+    if (error != 0) {
+        close(_fd);
+        fail("cannot reserve " + std::to_string(size) + " bytes in", path, error);
+    }
+    if (size > 0) {
+        void *base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+        if (base == MAP_FAILED) {
+            const int map_error = errno;
+            close(_fd);
+            fail("cannot map", path, map_error);
+        }
+        _base = static_cast<std::byte *>(base);
+    }
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (_base != nullptr) {
+        munmap(_base, _size);
+    }
+    if (_fd >= 0) {
+        close(_fd);
+    }
+#endif
+}
+
+size_t MappedFile::pageSize() {
+#ifdef _WIN32
+    return 4096;
+#else
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+void MappedFile::prefetch(size_t offset, size_t bytes) const {
+#ifndef _WIN32
+    const size_t page = pageSize();
+    const size_t begin = offset / page * page;
+    const size_t end = std::min(offset + bytes, _size);
+    if (begin >= end) {
+        return;
+    }
+    // Queues the reads; populating then waits for them and fills the page tables.
+    madvise(_base + begin, end - begin, MADV_WILLNEED);
+#ifdef MADV_POPULATE_READ
+    madvise(_base + begin, end - begin, MADV_POPULATE_READ);
+#endif
+#else
+    (void)offset;
+    (void)bytes;
+#endif
+}
+
+void MappedFile::release(size_t offset, size_t bytes) const {
+#ifndef _WIN32
+    const size_t page = pageSize();
+    const size_t begin = offset / page * page;
+    const size_t end = std::min((offset + bytes + page - 1) / page * page, _size);
+    if (begin >= end) {
+        return;
+    }
+    // Unmapping leaves the pages in the page cache; once written back they can
+    // be dropped from there too.
+    msync(_base + begin, end - begin, MS_SYNC);
+    madvise(_base + begin, end - begin, MADV_DONTNEED);
+#ifdef __linux__
+    posix_fadvise(_fd, static_cast<off_t>(begin), static_cast<off_t>(end - begin), POSIX_FADV_DONTNEED);
+#endif
+#else
+    (void)offset;
+    (void)bytes;
+#endif
+}
+
+} // namespace llaisys::utils
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace llaisys::utils {
+
+// Read-write shared mapping of a scratch file, for data that should live on
+// disk rather than in memory: pages are read in on first access, and clean
+// pages may be dropped again by release() or by the kernel under memory
+// pressure. The file is created (or truncated) at `path`, its blocks are
+// reserved up front so a full disk fails here rather than on a later store,
+// and it is unlinked right away, so it disappears with the mapping even if
+// the process dies. POSIX only.
+class MappedFile {
+public:
+    MappedFile(const std::string &path, size_t size);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    std::byte *data() const { return _base; }
+    size_t size() const { return _size; }
+
+    // Read [offset, offset + bytes) from disk and map it into this process, so
+    // later accesses neither wait for I/O nor fault. Blocks until the pages are
+    // in (where the kernel can populate mappings, else until the reads are
+    // queued), so callers run it off the compute thread. Best effort: failures
+    // only mean the pages are read on demand instead.
+    void prefetch(size_t offset, size_t bytes) const;
+    // Write back dirty pages of [offset, offset + bytes) and drop the range from
+    // memory; the next access reads it from the file again. Offsets are rounded
+    // out to whole pages.
+    void release(size_t offset, size_t bytes) const;
+
+    static size_t pageSize();
+
+private:
+    std::byte *_base = nullptr;
+    size_t _size = 0;
+    int _fd = -1;
+};
+
+} // namespace llaisys::utils
@@ -0,0 +1,219 @@
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+namespace llaisys::utils {
+
+namespace {
+
+thread_local bool in_task = false;
+
+size_t defaultThreads() {
+#if defined(__linux__)
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0 && CPU_COUNT(&set) > 0) {
+        return static_cast<size_t>(CPU_COUNT(&set));
+    }
+#endif
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+long processId() {
+#if defined(_WIN32)
+    return 0;
+#else
+    return static_cast<long>(getpid());
+#endif
+}
+
+class Pool {
+public:
+    explicit Pool(size_t nthread) {
+        for (size_t i = 1; i < nthread; i++) {
+            _threads.emplace_back([this] { _work(); });
+        }
+    }
+
+    ~Pool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _cv.notify_all();
+        for (auto &thread : _threads) {
+            thread.join();
+        }
+    }
+
+    size_t size() const {
+        return _threads.size() + 1;
+    }
+
+    // One job at a time; parallelFor falls back to running inline when busy.
+    std::mutex busy;
+
+    void run(size_t ntask, const std::function<void(size_t)> &fn) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _fn = &fn;
+            _ntask = ntask;
+            _next.store(0);
+            _error = nullptr;
+            _active = _threads.size();
+            _generation++;
+        }
+        _cv.notify_all();
+        _drain();
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [&] { return _active == 0; });
+            _fn = nullptr;
+            error = _error;
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    void _work() {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (;;) {
+            _cv.wait(lock, [&] { return _stopping || _generation != seen; });
+            if (_stopping) {
+                return;
+            }
+            seen = _generation;
+            lock.unlock();
+            _drain();
+            lock.lock();
+            if (--_active == 0) {
+                _done.notify_all();
+            }
+        }
+    }
+
+    // Claims and runs tasks until none are left.
+    void _drain() {
+        in_task = true;
+        for (;;) {
+            const size_t task = _next.fetch_add(1);
+            if (task >= _ntask) {
+                break;
+            }
+            try {
+                (*_fn)(task);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_error) {
+                    _error = std::current_exception();
+                }
+            }
+        }
+        in_task = false;
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::condition_variable _done;
+    std::vector<std::thread> _threads;
+    bool _stopping = false;
+    uint64_t _generation = 0;
+    const std::function<void(size_t)> *_fn = nullptr;
+    size_t _ntask = 0;
+    std::atomic<size_t> _next{0};
+    size_t _active = 0;
+    std::exception_ptr _error;
+};
+
+// Never destroyed: a forked child may exit with the parent's pool installed,
+// whose threads it does not have.
+struct State {
+    std::mutex mutex;
+    std::shared_ptr<Pool> pool;
+    size_t requested = 0;
+    long pid = 0;
+};
+
+State &state() {
+    static State *s = new State;
+    return *s;
+}
+
+size_t wantedThreads(const State &s) {
+    return s.requested > 0 ? s.requested : defaultThreads();
+}
+
+std::shared_ptr<Pool> acquirePool() {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (s.pool && s.pid != processId()) {
+        // The pool's threads did not survive a fork: leak it rather than join them.
+        new std::shared_ptr<Pool>(std::move(s.pool));
+    }
+    if (!s.pool) {
+        s.pool = std::make_shared<Pool>(wantedThreads(s));
+        s.pid = processId();
+    }
+    return s.pool;
+}
+
+} // namespace
+
+size_t numThreads() {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (s.pool && s.pid == processId()) {
+        return s.pool->size();
+    }
+    return wantedThreads(s);
+}
+
+void setNumThreads(size_t n) {
+    std::shared_ptr<Pool> old;
+    {
+        auto &s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.requested = n;
+        if (s.pool && s.pid == processId() && s.pool->size() != wantedThreads(s)) {
+            // Joined once the last parallelFor using it returns.
+            old = std::move(s.pool);
+        }
+    }
+}
+
+void parallelFor(size_t ntask, const std::function<void(size_t)> &fn) {
+    auto serial = [&] {
+        for (size_t task = 0; task < ntask; task++) {
+            fn(task);
+        }
+    };
+    if (ntask <= 1 || in_task) {
+        return serial();
+    }
+    const auto pool = acquirePool();
+    std::unique_lock<std::mutex> busy(pool->busy, std::try_to_lock);
+    if (pool->size() == 1 || !busy.owns_lock()) {
+        return serial();
+    }
+    pool->run(ntask, fn);
+}
+
+} // namespace llaisys::utils
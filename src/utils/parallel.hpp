@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace llaisys::utils {
+
+// Fork-join parallelism inside one CPU op. A process-wide pool of worker
+// threads, started on first use, runs the tasks of a parallelFor together with
+// the calling thread.
+//
+// The pool size defaults to the CPUs this process may run on (its affinity
+// mask where the platform has one), so a worker pinned to one NUMA node uses
+// that node's cores. A process forked after the pool started gets a fresh one.
+
+// Threads a parallelFor uses, the caller included.
+size_t numThreads();
+// Resize the pool; 0 restores the default.
+void setNumThreads(size_t n);
+
+// Runs fn(task) for every task in [0, ntask) and returns when all are done.
+// Tasks are claimed one at a time in index order, so callers with uneven
+// tasks list the costliest first. The first exception thrown by a task is
+// rethrown here once the others have finished. Nested calls, and calls made
+// while another thread's parallelFor holds the pool, run inline.
+void parallelFor(size_t ntask, const std::function<void(size_t)> &fn);
+
+} // namespace llaisys::utils
@@ -0,0 +1,180 @@
+#include "shm.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define LLAISYS_CPU_RELAX() _mm_pause()
+#else
+#define LLAISYS_CPU_RELAX() std::this_thread::yield()
+#endif
+
+namespace llaisys::utils {
+
+namespace {
+constexpr int SPIN_ITERATIONS = 1 << 14;
+constexpr int TIMEOUT_MS = 100;
+
+// Wait until `ready()`, which turns true once the other side advances `word`.
+// `sleeping` tells that side to wake us; seq_cst on both sides, as in
+// ProcessBarrier::wait, so either we see the advance or it sees the sleeper.
+template <typename Ready>
+void waitUntil(std::atomic<uint32_t> &word, std::atomic<uint32_t> &sleeping, const Ready &ready,
+               const std::function<void()> &on_timeout) {
+    for (int i = 0; i < SPIN_ITERATIONS; i++) {
+        if (ready()) {
+            return;
+        }
+        LLAISYS_CPU_RELAX();
+    }
+    sleeping.fetch_add(1);
+    for (;;) {
+        const uint32_t seen = word.load();
+        if (ready()) {
+            break;
+        }
+        futexWait(&word, seen, TIMEOUT_MS);
+        if (on_timeout && !ready()) {
+            try {
+                on_timeout();
+            } catch (...) {
+                sleeping.fetch_sub(1, std::memory_order_acq_rel);
+                throw;
+            }
+        }
+    }
+    sleeping.fetch_sub(1, std::memory_order_acq_rel);
+}
+} // namespace
+
+void futexWait(std::atomic<uint32_t> *word, uint32_t expected, int timeout_ms) {
+#ifdef __linux__
+    // Not FUTEX_PRIVATE: waiters and wakers may live in different processes.
+    struct timespec timeout;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = (timeout_ms % 1000) * 1000000L;
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT, expected,
+            timeout_ms < 0 ? nullptr : &timeout, nullptr, 0);
+#else
+    if (word->load(std::memory_order_acquire) == expected) {
+        std::this_thread::sleep_for(std::chrono::microseconds(timeout_ms < 0 ? 200 : std::min(timeout_ms * 1000, 200)));
+    }
+#endif
+}
+
+void futexWake(std::atomic<uint32_t> *word, int count) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE, count, nullptr, nullptr, 0);
+#else
+    (void)word;
+    (void)count;
+#endif
+}
+
+size_t physicalMemory() {
+#ifdef _WIN32
+    return 0;
+#else
+    return static_cast<size_t>(sysconf(_SC_PHYS_PAGES)) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+SharedRegion::SharedRegion(size_t capacity) : _capacity(capacity) {
+#ifdef _WIN32
+    throw std::runtime_error("SharedRegion: shared memory across processes needs POSIX");
+#else
+    void *base = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("SharedRegion: mmap of " + std::to_string(capacity) + " bytes failed");
+    }
+    _base = static_cast<std::byte *>(base);
+#endif
+}
+
+SharedRegion::~SharedRegion() {
+#ifndef _WIN32
+    if (_base != nullptr) {
+        munmap(_base, _capacity);
+    }
+#endif
+}
+
+std::byte *SharedRegion::allocate(size_t bytes, size_t align) {
+    const size_t begin = (_used + align - 1) / align * align;
+    if (begin + bytes > _capacity) {
+        throw std::runtime_error("SharedRegion: out of shared memory");
+    }
+    _used = begin + bytes;
+    return _base + begin;
+}
+
+void ProcessBarrier::wait(const std::function<void()> &on_timeout) {
+    const uint32_t gen = generation.load(std::memory_order_acquire);
+    if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+        arrived.store(0, std::memory_order_relaxed);
+        // seq_cst on both sides: either the sleeper sees the new generation or we see the sleeper.
+        generation.fetch_add(1);
+        if (sleepers.load() > 0) {
+            futexWake(&generation);
+        }
+        return;
+    }
+    for (int i = 0; i < SPIN_ITERATIONS; i++) {
+        if (generation.load(std::memory_order_acquire) != gen) {
+            return;
+        }
+        LLAISYS_CPU_RELAX();
+    }
+    sleepers.fetch_add(1);
+    while (generation.load() == gen) {
+        futexWait(&generation, gen, TIMEOUT_MS);
+        if (on_timeout && generation.load(std::memory_order_acquire) == gen) {
+            try {
+                on_timeout();
+            } catch (...) {
+                sleepers.fetch_sub(1, std::memory_order_acq_rel);
+                throw;
+            }
+        }
+    }
+    sleepers.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void SpscRing::push(uint32_t value, const std::function<void()> &on_timeout) {
+    const uint32_t h = head.load(std::memory_order_relaxed);
+    waitUntil(tail, producer_sleeping, [&] { return h - tail.load() < CAPACITY; }, on_timeout);
+    slots[h % CAPACITY] = value;
+    head.store(h + 1);
+    if (consumer_sleeping.load() > 0) {
+        futexWake(&head);
+    }
+}
+
+uint32_t SpscRing::pop(const std::function<void()> &on_timeout) {
+    const uint32_t t = tail.load(std::memory_order_relaxed);
+    waitUntil(head, consumer_sleeping, [&] { return head.load() != t; }, on_timeout);
+    const uint32_t value = slots[t % CAPACITY];
+    tail.store(t + 1);
+    if (producer_sleeping.load() > 0) {
+        futexWake(&tail);
+    }
+    return value;
+}
+
+} // namespace llaisys::utils
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace llaisys::utils {
+
+// Sleep while `*word == expected`, for at most `timeout_ms` (< 0: no limit).
+// Spurious wake-ups are possible, so callers re-check their condition. Works
+// across processes for words in shared mappings: a futex on Linux, a short
+// sleep elsewhere.
+void futexWait(std::atomic<uint32_t> *word, uint32_t expected, int timeout_ms = -1);
+// Wake up to `count` waiters sleeping on `word`.
+void futexWake(std::atomic<uint32_t> *word, int count = INT_MAX);
+
+// Installed physical memory in bytes, a natural capacity for a SharedRegion.
+size_t physicalMemory();
+
+// Anonymous shared mapping, inherited at the same address by processes forked
+// after it is created, so plain pointers into it stay valid in every process.
+// Only address space is reserved up front; pages are committed on first touch,
+// which also places them on the NUMA node of the process that touches them.
+// The bump allocator belongs to the creating process: children must not
+// allocate. Memory is released all at once with the region. POSIX only.
+class SharedRegion {
+public:
+    explicit SharedRegion(size_t capacity);
+    ~SharedRegion();
+
+    SharedRegion(const SharedRegion &) = delete;
+    SharedRegion &operator=(const SharedRegion &) = delete;
+
+    // Throws std::runtime_error when the region is exhausted.
+    std::byte *allocate(size_t bytes, size_t align = 64);
+    size_t capacity() const { return _capacity; }
+    size_t used() const { return _used; }
+
+private:
+    std::byte *_base = nullptr;
+    size_t _capacity = 0;
+    size_t _used = 0;
+};
+
+// Sense-reversing barrier for `count` participants (processes or threads) in
+// shared memory. Waiters spin for a short while, which keeps per-layer
+// synchronization in the microseconds, and then sleep on a futex so idle
+// processes do not burn a core. Construct it in place inside a SharedRegion.
+struct alignas(64) ProcessBarrier {
+    std::atomic<uint32_t> arrived{0};
+    std::atomic<uint32_t> generation{0};
+    std::atomic<uint32_t> sleepers{0};
+    uint32_t count;
+
+    explicit ProcessBarrier(uint32_t n) : count(n) {}
+
+    // `on_timeout` runs every ~100ms of sleeping, e.g. to notice a dead peer;
+    // it may throw to abandon the wait.
+    void wait(const std::function<void()> &on_timeout = nullptr);
+};
+
+// Lock-free single-producer single-consumer ring of 32-bit values in shared
+// memory, e.g. indices of buffers handed from one process to the next. Each
+// index is written by one side only; a full (push) or empty (pop) ring is
+// waited out like ProcessBarrier: spin first, then sleep on a futex. Construct
+// it in place inside a SharedRegion.
+struct SpscRing {
+    static constexpr uint32_t CAPACITY = 64;
+
+    alignas(64) std::atomic<uint32_t> head{0}; // producer: values pushed so far
+    std::atomic<uint32_t> consumer_sleeping{0};
+    alignas(64) std::atomic<uint32_t> tail{0}; // consumer: values popped so far
+    std::atomic<uint32_t> producer_sleeping{0};
+    alignas(64) uint32_t slots[CAPACITY];
+
+    // `on_timeout` as in ProcessBarrier::wait.
+    void push(uint32_t value, const std::function<void()> &on_timeout = nullptr);
+    uint32_t pop(const std::function<void()> &on_timeout = nullptr);
+};
+
+} // namespace llaisys::utils
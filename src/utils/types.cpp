@@ -75,24 +75,4 @@ fp16_t _f32_to_f16(float val) {
         return fp16_t{(uint16_t)sign};
     }
 }
-
-float _bf16_to_f32(bf16_t val) {
-    uint32_t bits32 = static_cast<uint32_t>(val._v) << 16;
-
-    float out;
-    std::memcpy(&out, &bits32, sizeof(out));
-    return out;
-}
-
-bf16_t _f32_to_bf16(float val) {
-    uint32_t bits32;
-    std::memcpy(&bits32, &val, sizeof(bits32));
-
-    const uint32_t rounding_bias = 0x00007FFF + // 0111 1111 1111 1111
-                                   ((bits32 >> 16) & 1);
-
-    uint16_t bf16_bits = static_cast<uint16_t>((bits32 + rounding_bias) >> 16);
-
-    return bf16_t{bf16_bits};
-}
 } // namespace llaisys::utils
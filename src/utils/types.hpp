@@ -2,6 +2,7 @@
 
 #include "llaisys.h"
 
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 
@@ -112,8 +113,27 @@ inline const char *dtype_to_str(llaisysDataType_t dtype) {
 float _f16_to_f32(fp16_t val);
 fp16_t _f32_to_f16(float val);
 
-float _bf16_to_f32(bf16_t val);
-bf16_t _f32_to_bf16(float val);
+// bf16 conversions are inline: they are a shift and a rounding add, and the
+// kernels call them per element.
+inline float _bf16_to_f32(bf16_t val) {
+    uint32_t bits32 = static_cast<uint32_t>(val._v) << 16;
+
+    float out;
+    std::memcpy(&out, &bits32, sizeof(out));
+    return out;
+}
+
+inline bf16_t _f32_to_bf16(float val) {
+    uint32_t bits32;
+    std::memcpy(&bits32, &val, sizeof(bits32));
+
+    const uint32_t rounding_bias = 0x00007FFF + // 0111 1111 1111 1111
+                                   ((bits32 >> 16) & 1);
+
+    uint16_t bf16_bits = static_cast<uint16_t>((bits32 + rounding_bias) >> 16);
+
+    return bf16_t{bf16_bits};
+}
 
 template <typename TypeTo, typename TypeFrom>
 TypeTo cast(TypeFrom val) {
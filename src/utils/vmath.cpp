@@ -0,0 +1,1237 @@
+// Intrinsics first: llaisys.h (through vmath.hpp) defines a __C macro that
+// collides with parameter names in the intrinsic headers.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define LLAISYS_VMATH_X86
+#include <immintrin.h>
+#define LLAISYS_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define LLAISYS_TARGET_AVX512 __attribute__((target("avx512f")))
+#define LLAISYS_TARGET_AVX512_BF16 __attribute__((target("avx512f,avx512bw,avx512bf16")))
+#define LLAISYS_TARGET_AVX512_VNNI __attribute__((target("avx512f,avx512bw,avx512vnni")))
+// The VEX encoding of vpdpbusd is only known to newer compilers.
+#if (defined(__clang__) && __clang_major__ >= 16) || (!defined(__clang__) && __GNUC__ >= 11)
+#define LLAISYS_VMATH_AVX_VNNI
+#define LLAISYS_TARGET_AVX2_VNNI __attribute__((target("avx2,fma,avxvnni")))
+#endif
+#endif
+
+#include "vmath.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace llaisys::utils::vmath {
+
+namespace {
+
+// exp(x) = 2^n * exp(r), n = round(x / ln2), r = x - n * ln2 in [-ln2/2, ln2/2],
+// with ln2 split in two (Cody-Waite) and a degree-7 polynomial for exp(r)
+// (Cephes expf). 2^n is applied as 2^(n/2) * 2^(n - n/2) so that both
+// factors stay normal over the whole clamped input range.
+constexpr float EXP_LO = -104.0f; // exp() rounds to 0 below this
+constexpr float EXP_HI = 88.8f;   // and overflows to +inf above this
+constexpr float LOG2E = 1.44269504088896341f;
+constexpr float LN2_HI = 0.693359375f;
+constexpr float LN2_LO = -2.12194440e-4f;
+constexpr float P0 = 1.9875691500e-4f;
+constexpr float P1 = 1.3981999507e-3f;
+constexpr float P2 = 8.3334519073e-3f;
+constexpr float P3 = 4.1665795894e-2f;
+constexpr float P4 = 1.6666665459e-1f;
+constexpr float P5 = 5.0000001201e-1f;
+
+// tanh(x) = x + x^3 * T(x^2) for |x| < TANH_SMALL (Cephes tanhf), and
+// sign(x) * (1 - 2 / (exp(2|x|) + 1)) above, where it does not cancel.
+constexpr float TANH_SMALL = 0.625f;
+constexpr float T0 = -5.70498872745e-3f;
+constexpr float T1 = 2.06390887954e-2f;
+constexpr float T2 = -5.37397155531e-2f;
+constexpr float T3 = 1.33314422036e-1f;
+constexpr float T4 = -3.33332819422e-1f;
+
+float pow2(int32_t n) {
+    const uint32_t bits = static_cast<uint32_t>(n + 127) << 23;
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+namespace scalar {
+float exp(float x) {
+    if (std::isnan(x)) {
+        return x;
+    }
+    x = std::min(std::max(x, EXP_LO), EXP_HI);
+    const float n = std::nearbyint(x * LOG2E);
+    float r = x - n * LN2_HI;
+    r = r - n * LN2_LO;
+    float p = P0;
+    p = p * r + P1;
+    p = p * r + P2;
+    p = p * r + P3;
+    p = p * r + P4;
+    p = p * r + P5;
+    const float y = p * (r * r) + r + 1.0f;
+    const int32_t ni = static_cast<int32_t>(n);
+    const int32_t n1 = ni >> 1;
+    return y * pow2(n1) * pow2(ni - n1);
+}
+
+// exp(-|x|) never overflows, so tiny sigmoids (x << 0) keep their precision.
+float sigmoid(float x) {
+    const float e = exp(-std::fabs(x));
+    const float s = 1.0f / (1.0f + e);
+    return x < 0.0f ? e * s : s;
+}
+
+float silu(float x) {
+    return x * sigmoid(x);
+}
+
+float tanh(float x) {
+    const float a = std::fabs(x);
+    if (a < TANH_SMALL) {
+        const float z = x * x;
+        float p = T0;
+        p = p * z + T1;
+        p = p * z + T2;
+        p = p * z + T3;
+        p = p * z + T4;
+        return x + x * z * p;
+    }
+    return std::copysign(1.0f - 2.0f / (exp(2.0f * a) + 1.0f), x);
+}
+
+float rsqrt(float x) {
+    return 1.0f / std::sqrt(x);
+}
+} // namespace scalar
+
+// A kernel applies f to the n elements of x; n need not fill a vector.
+using Kernel = void (*)(float *, const float *, size_t);
+using ExpSumKernel = float (*)(float *, const float *, size_t, float, float);
+using DotsKernel = void (*)(float *, const float *, const float *, size_t, size_t, size_t);
+using DotsBf16Kernel = void (*)(float *, const bf16_t *, const bf16_t *, size_t, size_t, size_t);
+using Sparse24Kernel = void (*)(float *, const float *, const uint8_t *, const float *, size_t, size_t, size_t);
+using Sparse24Bf16Kernel = void (*)(float *, const bf16_t *, const uint8_t *, const float *, size_t, size_t, size_t);
+using DotsI8Kernel = void (*)(int32_t *, const int8_t *, const int8_t *, const int32_t *, size_t, size_t, size_t);
+using ToF32Kernel = void (*)(float *, const bf16_t *, size_t);
+using ToBf16Kernel = void (*)(bf16_t *, const float *, size_t);
+
+struct Kernels {
+    Kernel exp;
+    Kernel sigmoid;
+    Kernel silu;
+    Kernel tanh;
+    Kernel rsqrt;
+    ExpSumKernel exp_sum;
+    DotsKernel dots;
+    DotsBf16Kernel dots_bf16;
+    Sparse24Kernel sparse24_dots;
+    Sparse24Bf16Kernel sparse24_dots_bf16;
+    DotsI8Kernel dots_i8;
+    ToF32Kernel bf16_to_f32;
+    ToBf16Kernel f32_to_bf16;
+};
+
+// Rows of dots() that share one pass over w.
+constexpr size_t DOT_ROWS = 4;
+
+// dots() for any row count from kernels for 1, 2 and DOT_ROWS rows.
+template <typename E, void (*K1)(float *, const E *, const E *, size_t, size_t),
+          void (*K2)(float *, const E *, const E *, size_t, size_t),
+          void (*K4)(float *, const E *, const E *, size_t, size_t)>
+void splitRows(float *y, const E *w, const E *x, size_t rows, size_t ldx, size_t n) {
+    size_t r = 0;
+    for (; r + DOT_ROWS <= rows; r += DOT_ROWS) {
+        K4(y + r, w, x + r * ldx, ldx, n);
+    }
+    switch (rows - r) {
+    case 3:
+        K1(y + r + 2, w, x + (r + 2) * ldx, ldx, n);
+        [[fallthrough]];
+    case 2:
+        K2(y + r, w, x + r * ldx, ldx, n);
+        break;
+    case 1:
+        K1(y + r, w, x + r * ldx, ldx, n);
+        break;
+    default:
+        break;
+    }
+}
+
+// sparse24Dots() for any row count from kernels for 1 and DOT_ROWS rows.
+template <typename E, void (*K1)(float *, const E *, const uint8_t *, const float *, size_t, size_t),
+          void (*K4)(float *, const E *, const uint8_t *, const float *, size_t, size_t)>
+void splitSparseRows(float *y, const E *values, const uint8_t *idx, const float *x, size_t rows, size_t ldx, size_t n) {
+    size_t r = 0;
+    for (; r + DOT_ROWS <= rows; r += DOT_ROWS) {
+        K4(y + r, values, idx, x + r * ldx, ldx, n);
+    }
+    for (; r < rows; r++) {
+        K1(y + r, values, idx, x + r * ldx, ldx, n);
+    }
+}
+
+// dotsI8() for any row count from kernels for 1 and DOT_ROWS rows.
+using DotsI8Rows = void (*)(int32_t *, const int8_t *, const int8_t *, const int32_t *, size_t, size_t);
+template <DotsI8Rows K1, DotsI8Rows K4>
+void splitI8Rows(int32_t *y, const int8_t *w, const int8_t *x, const int32_t *xsum, size_t rows, size_t ldx, size_t n) {
+    size_t r = 0;
+    for (; r + DOT_ROWS <= rows; r += DOT_ROWS) {
+        K4(y + r, w, x + r * ldx, xsum + r, ldx, n);
+    }
+    for (; r < rows; r++) {
+        K1(y + r, w, x + r * ldx, xsum + r, ldx, n);
+    }
+}
+
+// Sums the kept values [j, n / 2) of a sparse row against R rows into y, for
+// the tails the vector kernels leave.
+template <typename E, size_t R>
+void sparse24Tail(float *y, const E *values, const uint8_t *idx, const float *x, size_t ldx, size_t j, size_t n) {
+    for (; j < n / 2; j++) {
+        const float w = cast<float>(values[j]);
+        const size_t i = sparse24Index(idx, j);
+        for (size_t r = 0; r < R; r++) {
+            y[r] += w * x[r * ldx + i];
+        }
+    }
+}
+
+template <float (*F)(float)>
+void scalarMap(float *y, const float *x, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        y[i] = F(x[i]);
+    }
+}
+
+float scalarExpSum(float *y, const float *x, size_t n, float shift, float scale) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        y[i] = scalar::exp((x[i] - shift) * scale);
+        sum += y[i];
+    }
+    return sum;
+}
+
+template <typename E>
+void scalarDots(float *y, const E *w, const E *x, size_t rows, size_t ldx, size_t n) {
+    for (size_t r = 0; r < rows; r++) {
+        const E *xr = x + r * ldx;
+        float total = 0.0f;
+        for (size_t b = 0; b < n; b += DOT_BLOCK) {
+            const size_t e = std::min(n, b + DOT_BLOCK);
+            float acc[4] = {};
+            size_t i = b;
+            for (; i + 4 <= e; i += 4) {
+                for (size_t k = 0; k < 4; k++) {
+                    acc[k] += cast<float>(w[i + k]) * cast<float>(xr[i + k]);
+                }
+            }
+            for (; i < e; i++) {
+                acc[0] += cast<float>(w[i]) * cast<float>(xr[i]);
+            }
+            total += (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        }
+        y[r] = total;
+    }
+}
+
+template <typename E>
+void scalarSparse24Dots(float *y, const E *values, const uint8_t *idx, const float *x, size_t rows, size_t ldx, size_t n) {
+    for (size_t r = 0; r < rows; r++) {
+        const float *xr = x + r * ldx;
+        float acc[4] = {};
+        for (size_t j = 0; j < n / 2; j++) {
+            acc[j % 4] += cast<float>(values[j]) * xr[sparse24Index(idx, j)];
+        }
+        y[r] = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    }
+}
+
+void scalarDotsI8(int32_t *y, const int8_t *w, const int8_t *x, const int32_t *, size_t rows, size_t ldx, size_t n) {
+    for (size_t r = 0; r < rows; r++) {
+        const int8_t *xr = x + r * ldx;
+        int32_t acc = 0;
+        for (size_t i = 0; i < n; i++) {
+            acc += static_cast<int32_t>(w[i]) * xr[i];
+        }
+        y[r] = acc;
+    }
+}
+
+void scalarBf16ToF32(float *y, const bf16_t *x, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        y[i] = cast<float>(x[i]);
+    }
+}
+
+void scalarF32ToBf16(bf16_t *y, const float *x, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        y[i] = cast<bf16_t>(x[i]);
+    }
+}
+
+const Kernels SCALAR_KERNELS = {
+    &scalarMap<scalar::exp>, &scalarMap<scalar::sigmoid>, &scalarMap<scalar::silu>,
+    &scalarMap<scalar::tanh>, &scalarMap<scalar::rsqrt>, &scalarExpSum,
+    &scalarDots<float>, &scalarDots<bf16_t>, &scalarSparse24Dots<float>, &scalarSparse24Dots<bf16_t>,
+    &scalarDotsI8, &scalarBf16ToF32, &scalarF32ToBf16,
+};
+
+#ifdef LLAISYS_VMATH_X86
+namespace avx2 {
+constexpr size_t W = 8;
+
+LLAISYS_TARGET_AVX2 inline __m256 exp(__m256 x) {
+    // min/max return their second operand for NaN, so NaN flows through.
+    x = _mm256_max_ps(_mm256_set1_ps(EXP_LO), _mm256_min_ps(_mm256_set1_ps(EXP_HI), x));
+    const __m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(LN2_HI), x);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(LN2_LO), r);
+    __m256 p = _mm256_set1_ps(P0);
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(P1));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(P2));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(P3));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(P4));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(P5));
+    const __m256 y = _mm256_add_ps(_mm256_fmadd_ps(p, _mm256_mul_ps(r, r), r), _mm256_set1_ps(1.0f));
+    const __m256i ni = _mm256_cvtps_epi32(n);
+    const __m256i n1 = _mm256_srai_epi32(ni, 1);
+    const __m256i n2 = _mm256_sub_epi32(ni, n1);
+    const __m256i bias = _mm256_set1_epi32(127);
+    const __m256 s1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n1, bias), 23));
+    const __m256 s2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n2, bias), 23));
+    return _mm256_mul_ps(_mm256_mul_ps(y, s1), s2);
+}
+
+LLAISYS_TARGET_AVX2 inline __m256 sigmoid(__m256 x) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 e = exp(_mm256_or_ps(x, _mm256_set1_ps(-0.0f))); // exp(-|x|)
+    const __m256 s = _mm256_div_ps(one, _mm256_add_ps(one, e));
+    return _mm256_blendv_ps(s, _mm256_mul_ps(e, s), x);
+}
+
+LLAISYS_TARGET_AVX2 inline __m256 silu(__m256 x) {
+    return _mm256_mul_ps(x, sigmoid(x));
+}
+
+LLAISYS_TARGET_AVX2 inline __m256 tanh(__m256 x) {
+    const __m256 sign = _mm256_and_ps(x, _mm256_set1_ps(-0.0f));
+    const __m256 a = _mm256_xor_ps(x, sign);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 e = exp(_mm256_add_ps(a, a));
+    const __m256 large = _mm256_or_ps(
+        _mm256_sub_ps(one, _mm256_div_ps(_mm256_set1_ps(2.0f), _mm256_add_ps(e, one))), sign);
+    const __m256 z = _mm256_mul_ps(x, x);
+    __m256 p = _mm256_set1_ps(T0);
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(T1));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(T2));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(T3));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(T4));
+    const __m256 small = _mm256_fmadd_ps(_mm256_mul_ps(x, z), p, x);
+    return _mm256_blendv_ps(large, small, _mm256_cmp_ps(a, _mm256_set1_ps(TANH_SMALL), _CMP_LT_OQ));
+}
+
+// 12-bit estimate plus one Newton-Raphson step.
+LLAISYS_TARGET_AVX2 inline __m256 rsqrt(__m256 x) {
+    const __m256 r = _mm256_rsqrt_ps(x);
+    const __m256 h = _mm256_mul_ps(_mm256_set1_ps(0.5f), x);
+    return _mm256_fmadd_ps(r, _mm256_fnmadd_ps(_mm256_mul_ps(h, r), r, _mm256_set1_ps(0.5f)), r);
+}
+
+template <__m256 (*F)(__m256)>
+LLAISYS_TARGET_AVX2 void map(float *y, const float *x, size_t n) {
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+        _mm256_storeu_ps(y + i, F(_mm256_loadu_ps(x + i)));
+    }
+    if (i < n) {
+        alignas(32) float tail[W] = {};
+        std::copy(x + i, x + n, tail);
+        _mm256_store_ps(tail, F(_mm256_load_ps(tail)));
+        std::copy(tail, tail + (n - i), y + i);
+    }
+}
+
+LLAISYS_TARGET_AVX2 float expSum(float *y, const float *x, size_t n, float shift, float scale) {
+    const __m256 vshift = _mm256_set1_ps(shift);
+    const __m256 vscale = _mm256_set1_ps(scale);
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+        const __m256 e = exp(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(x + i), vshift), vscale));
+        _mm256_storeu_ps(y + i, e);
+        acc = _mm256_add_ps(acc, e);
+    }
+    alignas(32) float lanes[W];
+    _mm256_store_ps(lanes, acc);
+    float sum = 0.0f;
+    for (float lane : lanes) {
+        sum += lane;
+    }
+    if (i < n) {
+        alignas(32) float tail[W];
+        std::fill(tail, tail + W, -std::numeric_limits<float>::infinity());
+        std::copy(x + i, x + n, tail);
+        _mm256_store_ps(tail, exp(_mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(tail), vshift), vscale)));
+        for (size_t j = 0; j < n - i; j++) {
+            y[i + j] = tail[j];
+            sum += tail[j];
+        }
+    }
+    return sum;
+}
+
+LLAISYS_TARGET_AVX2 inline __m256 load(const float *p) {
+    return _mm256_loadu_ps(p);
+}
+
+// bf16 widens to float exactly: its bits are the high half of the float's.
+LLAISYS_TARGET_AVX2 inline __m256 load(const bf16_t *p) {
+    const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16));
+}
+
+// The first count < W elements, zeros after.
+LLAISYS_TARGET_AVX2 inline __m256 loadPartial(const float *p, size_t count) {
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    return _mm256_maskload_ps(p, _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count)), lane));
+}
+
+LLAISYS_TARGET_AVX2 inline __m256 loadPartial(const bf16_t *p, size_t count) {
+    alignas(16) bf16_t tail[W] = {};
+    std::copy(p, p + count, tail);
+    return load(tail);
+}
+
+// R rows against one w; U independent accumulators per row keep 4 FMA chains
+// in flight whatever R is. The last partial vector of a block is zero-filled.
+template <typename E, size_t R>
+LLAISYS_TARGET_AVX2 void dotRows(float *y, const E *w, const E *x, size_t ldx, size_t n) {
+    constexpr size_t U = DOT_ROWS / R;
+    __m256 total[R];
+    for (size_t r = 0; r < R; r++) {
+        total[r] = _mm256_setzero_ps();
+    }
+    for (size_t b = 0; b < n; b += DOT_BLOCK) {
+        const size_t e = std::min(n, b + DOT_BLOCK);
+        __m256 acc[R][U];
+        for (size_t r = 0; r < R; r++) {
+            for (size_t u = 0; u < U; u++) {
+                acc[r][u] = _mm256_setzero_ps();
+            }
+        }
+        size_t i = b;
+        for (; i + U * W <= e; i += U * W) {
+            for (size_t u = 0; u < U; u++) {
+                const __m256 wv = load(w + i + u * W);
+                for (size_t r = 0; r < R; r++) {
+                    acc[r][u] = _mm256_fmadd_ps(wv, load(x + r * ldx + i + u * W), acc[r][u]);
+                }
+            }
+        }
+        for (; i < e; i += W) {
+            const size_t count = std::min(W, e - i);
+            const __m256 wv = count == W ? load(w + i) : loadPartial(w + i, count);
+            for (size_t r = 0; r < R; r++) {
+                const E *xr = x + r * ldx + i;
+                acc[r][0] = _mm256_fmadd_ps(wv, count == W ? load(xr) : loadPartial(xr, count), acc[r][0]);
+            }
+        }
+        for (size_t r = 0; r < R; r++) {
+            for (size_t step = 1; step < U; step *= 2) {
+                for (size_t u = 0; u + step < U; u += 2 * step) {
+                    acc[r][u] = _mm256_add_ps(acc[r][u], acc[r][u + step]);
+                }
+            }
+            total[r] = _mm256_add_ps(total[r], acc[r][0]);
+        }
+    }
+    for (size_t r = 0; r < R; r++) {
+        alignas(32) float lanes[W];
+        _mm256_store_ps(lanes, total[r]);
+        y[r] = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+    }
+}
+
+template <typename E>
+void dots(float *y, const E *w, const E *x, size_t rows, size_t ldx, size_t n) {
+    splitRows<E, &dotRows<E, 1>, &dotRows<E, 2>, &dotRows<E, DOT_ROWS>>(y, w, x, rows, ldx, n);
+}
+
+// Each vector of W kept values covers 2 * W inputs; their positions come from
+// 2 index bytes, and the inputs are picked from two vectors of x by a permute
+// of each plus a blend on bit 3 of the position.
+template <typename E, size_t R, size_t U>
+LLAISYS_TARGET_AVX2 inline void sparse24Step(__m256 (&acc)[R][U], size_t u, const E *values, const uint8_t *idx,
+                                             const float *x, size_t ldx, size_t j) {
+    const __m256i shifts = _mm256_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14);
+    const __m256i groups = _mm256_setr_epi32(0, 0, 4, 4, 8, 8, 12, 12);
+    uint16_t bits;
+    std::memcpy(&bits, idx + j / 4, sizeof(bits));
+    const __m256i pos = _mm256_add_epi32(
+        _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(bits), shifts), _mm256_set1_epi32(3)), groups);
+    const __m256 high = _mm256_castsi256_ps(_mm256_slli_epi32(pos, 28));
+    const __m256 wv = load(values + j);
+    for (size_t r = 0; r < R; r++) {
+        const float *xr = x + r * ldx + 2 * j;
+        const __m256 lo = _mm256_permutevar8x32_ps(_mm256_loadu_ps(xr), pos);
+        const __m256 hi = _mm256_permutevar8x32_ps(_mm256_loadu_ps(xr + W), pos);
+        acc[r][u] = _mm256_fmadd_ps(wv, _mm256_blendv_ps(lo, hi, high), acc[r][u]);
+    }
+}
+
+template <typename E, size_t R>
+LLAISYS_TARGET_AVX2 void sparse24Rows(float *y, const E *values, const uint8_t *idx, const float *x, size_t ldx, size_t n) {
+    constexpr size_t U = DOT_ROWS / R;
+    __m256 acc[R][U];
+    for (size_t r = 0; r < R; r++) {
+        for (size_t u = 0; u < U; u++) {
+            acc[r][u] = _mm256_setzero_ps();
+        }
+    }
+    const size_t nv = n / 2;
+    size_t j = 0;
+    for (; j + U * W <= nv; j += U * W) {
+        // Unrolled so the accumulators stay in registers.
+#pragma GCC unroll 4
+        for (size_t u = 0; u < U; u++) {
+            sparse24Step<E, R, U>(acc, u, values, idx, x, ldx, j + u * W);
+        }
+    }
+    for (; j + W <= nv; j += W) {
+        sparse24Step<E, R, U>(acc, 0, values, idx, x, ldx, j);
+    }
+    float sums[R];
+    for (size_t r = 0; r < R; r++) {
+        for (size_t u = 1; u < U; u++) {
+            acc[r][0] = _mm256_add_ps(acc[r][0], acc[r][u]);
+        }
+        alignas(32) float lanes[W];
+        _mm256_store_ps(lanes, acc[r][0]);
+        sums[r] = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+    }
+    sparse24Tail<E, R>(sums, values, idx, x, ldx, j, n);
+    std::copy(sums, sums + R, y);
+}
+
+template <typename E>
+void sparse24Dots(float *y, const E *values, const uint8_t *idx, const float *x, size_t rows, size_t ldx, size_t n) {
+    splitSparseRows<E, &sparse24Rows<E, 1>, &sparse24Rows<E, DOT_ROWS>>(y, values, idx, x, rows, ldx, n);
+}
+
+constexpr size_t W_I8 = 16; // int8 elements widened to one vector of int16
+
+LLAISYS_TARGET_AVX2 inline __m256i loadI8(const int8_t *p) {
+    return _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+}
+
+LLAISYS_TARGET_AVX2 inline __m256i loadI8Partial(const int8_t *p, size_t count) {
+    alignas(16) int8_t tail[W_I8] = {};
+    std::copy(p, p + count, tail);
+    return loadI8(tail);
+}
+
+// Without VNNI: bytes are sign-extended to int16 and vpmaddwd adds pairs of
+// products into int32 lanes, which no partial sum of an exact result can
+// overflow.
+template <size_t R>
+LLAISYS_TARGET_AVX2 void dotI8Rows(int32_t *y, const int8_t *w, const int8_t *x, const int32_t *, size_t ldx, size_t n) {
+    constexpr size_t U = DOT_ROWS / R;
+    __m256i acc[R][U];
+    for (size_t r = 0; r < R; r++) {
+        for (size_t u = 0; u < U; u++) {
+            acc[r][u] = _mm256_setzero_si256();
+        }
+    }
+    size_t i = 0;
+    for (; i + U * W_I8 <= n; i += U * W_I8) {
+#pragma GCC unroll 4
+        for (size_t u = 0; u < U; u++) {
+            const __m256i wv = loadI8(w + i + u * W_I8);
+            for (size_t r = 0; r < R; r++) {
+                const __m256i xv = loadI8(x + r * ldx + i + u * W_I8);
+                acc[r][u] = _mm256_add_epi32(acc[r][u], _mm256_madd_epi16(wv, xv));
+            }
+        }
+    }
+    for (; i < n; i += W_I8) {
+        const size_t count = std::min(W_I8, n - i);
+        const __m256i wv = count == W_I8 ? loadI8(w + i) : loadI8Partial(w + i, count);
+        for (size_t r = 0; r < R; r++) {
+            const int8_t *xr = x + r * ldx + i;
+            const __m256i xv = count == W_I8 ? loadI8(xr) : loadI8Partial(xr, count);
+            acc[r][0] = _mm256_add_epi32(acc[r][0], _mm256_madd_epi16(wv, xv));
+        }
+    }
+    for (size_t r = 0; r < R; r++) {
+        for (size_t u = 1; u < U; u++) {
+            acc[r][0] = _mm256_add_epi32(acc[r][0], acc[r][u]);
+        }
+        alignas(32) int32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc[r][0]);
+        y[r] = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+    }
+}
+
+void dotsI8(int32_t *y, const int8_t *w, const int8_t *x, const int32_t *xsum, size_t rows, size_t ldx, size_t n) {
+    splitI8Rows<&dotI8Rows<1>, &dotI8Rows<DOT_ROWS>>(y, w, x, xsum, rows, ldx, n);
+}
+
+LLAISYS_TARGET_AVX2 void bf16ToF32(float *y, const bf16_t *x, size_t n) {
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+        _mm256_storeu_ps(y + i, load(x + i));
+    }
+    for (; i < n; i++) {
+        y[i] = cast<float>(x[i]);
+    }
+}
+
+LLAISYS_TARGET_AVX2 void f32ToBf16(bf16_t *y, const float *x, size_t n) {
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+        __m256i bits = _mm256_castps_si256(_mm256_loadu_ps(x + i));
+        const __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+        bits = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(bits, _mm256_set1_epi32(0x7fff)), lsb), 16);
+        const __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(bits), _mm256_extracti128_si256(bits, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(y + i), packed);
+    }
+    for (; i < n; i++) {
+        y[i] = cast<bf16_t>(x[i]);
+    }
+}
+
+const Kernels KERNELS = {&map<exp>, &map<sigmoid>, &map<silu>, &map<tanh>, &map<rsqrt>, &expSum,
+                         &dots<float>, &dots<bf16_t>, &sparse24Dots<float>, &sparse24Dots<bf16_t>,
+                         &dotsI8, &bf16ToF32, &f32ToBf16};
+} // namespace avx2
+
+// vpdpbusd adds four u8 * s8 products into each int32 lane. w goes in as the
+// unsigned operand, offset by 128 (a flip of its sign bit), which adds
+// 128 * sum(x) to every row; that is taken off after the lanes are summed.
+// Lanes and sums wrap modulo 2^32, so the result is exact whenever the true
+// sum fits in int32, whatever the offset sums reach on the way.
+inline int32_t unoffsetI8(const uint32_t *lanes, size_t count, int32_t xsum) {
+    uint32_t sum = 0;
+    for (size_t l = 0; l < count; l++) {
+        sum += lanes[l];
+    }
+    return static_cast<int32_t>(sum - 128u * static_cast<uint32_t>(xsum));
+}
+
+#ifdef LLAISYS_VMATH_AVX_VNNI
+namespace avx2_vnni {
+constexpr size_t W = 32; // int8 elements per vector
+
+LLAISYS_TARGET_AVX2_VNNI inline __m256i load(const int8_t *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+LLAISYS_TARGET_AVX2_VNNI inline __m256i loadPartial(const int8_t *p, size_t count) {
+    alignas(32) int8_t tail[W] = {};
+    std::copy(p, p + count, tail);
+    return load(tail);
+}
+
+// Zero padding of a partial vector stays zero: the offset w there meets x = 0.
+template <size_t R>
+LLAISYS_TARGET_AVX2_VNNI void dotRows(int32_t *y, const int8_t *w, const int8_t *x, const int32_t *xsum, size_t ldx, size_t n) {
+    constexpr size_t U = DOT_ROWS / R;
+    const __m256i flip = _mm256_set1_epi8(-128);
+    __m256i acc[R][U];
+    for (size_t r = 0; r < R; r++) {
+        for (size_t u = 0; u < U; u++) {
+            acc[r][u] = _mm256_setzero_si256();
+        }
+    }
+    size_t i = 0;
+    for (; i + U * W <= n; i += U * W) {
+#pragma GCC unroll 4
+        for (size_t u = 0; u < U; u++) {
+            const __m256i wv = _mm256_xor_si256(load(w + i + u * W), flip);
+            for (size_t r = 0; r < R; r++) {
+                acc[r][u] = _mm256_dpbusd_avx_epi32(acc[r][u], wv, load(x + r * ldx + i + u * W));
+            }
+        }
+    }
+    for (; i < n; i += W) {
+        const size_t count = std::min(W, n - i);
+        const __m256i wv = _mm256_xor_si256(count == W ? load(w + i) : loadPartial(w + i, count), flip);
+        for (size_t r = 0; r < R; r++) {
+            const int8_t *xr = x + r * ldx + i;
+            acc[r][0] = _mm256_dpbusd_avx_epi32(acc[r][0], wv, count == W ? load(xr) : loadPartial(xr, count));
+        }
+    }
+    for (size_t r = 0; r < R; r++) {
+        for (size_t u = 1; u < U; u++) {
+            acc[r][0] = _mm256_add_epi32(acc[r][0], acc[r][u]);
+        }
+        alignas(32) uint32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc[r][0]);
+        y[r] = unoffsetI8(lanes, 8, xsum[r]);
+    }
+}
+
+void dotsI8(int32_t *y, const int8_t *w, const int8_t *x, const int32_t *xsum, size_t rows, size_t ldx, size_t n) {
+    splitI8Rows<&dotRows<1>, &dotRows<DOT_ROWS>>(y, w, x, xsum, rows, ldx, n);
+}
+
+const Kernels KERNELS = {&avx2::map<avx2::exp>, &avx2::map<avx2::sigmoid>, &avx2::map<avx2::silu>,
+                         &avx2::map<avx2::tanh>, &avx2::map<avx2::rsqrt>, &avx2::expSum,
+                         &avx2::dots<float>, &avx2::dots<bf16_t>, &avx2::sparse24Dots<float>, &avx2::sparse24Dots<bf16_t>,
+                         &dotsI8, &avx2::bf16ToF32, &avx2::f32ToBf16};
+} // namespace avx2_vnni
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC 12 takes the deliberately undefined pass-through operand of unmasked
+// AVX-512 intrinsics for an uninitialized read.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+namespace avx512 {
+constexpr size_t W = 16;
+
+LLAISYS_TARGET_AVX512 inline __m512 exp(__m512 x) {
+    x = _mm512_max_ps(_mm512_set1_ps(EXP_LO), _mm512_min_ps(_mm512_set1_ps(EXP_HI), x));
+    const __m512 n = _mm512_roundscale_ps(_mm512_mul_ps(x, _mm512_set1_ps(LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512 r = _mm512_fnmadd_ps(n, _mm512_set1_ps(LN2_HI), x);
+    r = _mm512_fnmadd_ps(n, _mm512_set1_ps(LN2_LO), r);
+    __m512 p = _mm512_set1_ps(P0);
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(P1));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(P2));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(P3));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(P4));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(P5));
+    const __m512 y = _mm512_add_ps(_mm512_fmadd_ps(p, _mm512_mul_ps(r, r), r), _mm512_set1_ps(1.0f));
+    const __m512i ni = _mm512_cvtps_epi32(n);
+    const __m512i n1 = _mm512_srai_epi32(ni, 1);
+    const __m512i n2 = _mm512_sub_epi32(ni, n1);
+    const __m512i bias = _mm512_set1_epi32(127);
+    const __m512 s1 = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(n1, bias), 23));
+    const __m512 s2 = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(n2, bias), 23));
+    return _mm512_mul_ps(_mm512_mul_ps(y, s1), s2);
+}
+
+LLAISYS_TARGET_AVX512 inline __m512 sigmoid(__m512 x) {
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const __m512i bits = _mm512_castps_si512(x);
+    const __m512 e = exp(_mm512_castsi512_ps(_mm512_or_si512(bits, _mm512_set1_epi32(INT32_MIN)))); // exp(-|x|)
+    const __m512 s = _mm512_div_ps(one, _mm512_add_ps(one, e));
+    const __mmask16 negative = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ);
+    return _mm512_mask_mul_ps(s, negative, e, s);
+}
+
+LLAISYS_TARGET_AVX512 inline __m512 silu(__m512 x) {
+    return _mm512_mul_ps(x, sigmoid(x));
+}
+
+LLAISYS_TARGET_AVX512 inline __m512 tanh(__m512 x) {
+    const __m512i sign = _mm512_and_si512(_mm512_castps_si512(x), _mm512_set1_epi32(INT32_MIN));
+    const __m512 a = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(x), sign));
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const __m512 e = exp(_mm512_add_ps(a, a));
+    const __m512 large = _mm512_castsi512_ps(_mm512_or_si512(
+        _mm512_castps_si512(_mm512_sub_ps(one, _mm512_div_ps(_mm512_set1_ps(2.0f), _mm512_add_ps(e, one)))), sign));
+    const __m512 z = _mm512_mul_ps(x, x);
+    __m512 p = _mm512_set1_ps(T0);
+    p = _mm512_fmadd_ps(p, z, _mm512_set1_ps(T1));
+    p = _mm512_fmadd_ps(p, z, _mm512_set1_ps(T2));
+    p = _mm512_fmadd_ps(p, z, _mm512_set1_ps(T3));
+    p = _mm512_fmadd_ps(p, z, _mm512_set1_ps(T4));
+    const __m512 small = _mm512_fmadd_ps(_mm512_mul_ps(x, z), p, x);
+    return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, _mm512_set1_ps(TANH_SMALL), _CMP_LT_OQ), large, small);
+}
+
+// 14-bit estimate plus one Newton-Raphson step.
+LLAISYS_TARGET_AVX512 inline __m512 rsqrt(__m512 x) {
+    const __m512 r = _mm512_rsqrt14_ps(x);
+    const __m512 h = _mm512_mul_ps(_mm512_set1_ps(0.5f), x);
+    return _mm512_fmadd_ps(r, _mm512_fnmadd_ps(_mm512_mul_ps(h, r), r, _mm512_set1_ps(0.5f)), r);
+}
+
+template <__m512 (*F)(__m512)>
+LLAISYS_TARGET_AVX512 void map(float *y, const float *x, size_t n) {
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+        _mm512_storeu_ps(y + i, F(_mm512_loadu_ps(x + i)));
+    }
+    if (i < n) {
+        // Masked lanes load 1.0f, which is in every function's domain.
+        const __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+        _mm512_mask_storeu_ps(y + i, mask, F(_mm512_mask_loadu_ps(_mm512_set1_ps(1.0f), mask, x + i)));
+    }
+}
+
+LLAISYS_TARGET_AVX512 float expSum(float *y, const float *x, size_t n, float shift, float scale) {
+    const __m512 vshift = _mm512_set1_ps(shift);
+    const __m512 vscale = _mm512_set1_ps(scale);
+    __m512 acc = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+        const __m512 e = exp(_mm512_mul_ps(_mm512_sub_ps(_mm512_loadu_ps(x + i), vshift), vscale));
+        _mm512_storeu_ps(y + i, e);
+        acc = _mm512_add_ps(acc, e);
+    }
+    if (i < n) {
+        const __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+        const __m512 e = exp(_mm512_mul_ps(_mm512_sub_ps(_mm512_maskz_loadu_ps(mask, x + i), vshift), vscale));
+        _mm512_mask_storeu_ps(y + i, mask, e);
+        acc = _mm512_add_ps(acc, _mm512_maskz_mov_ps(mask, e));
+    }
+    return _mm512_reduce_add_ps(acc);
+}
+
+LLAISYS_TARGET_AVX512 inline __m512 load(const float *p) {
+    return _mm512_loadu_ps(p);
+}
+
+LLAISYS_TARGET_AVX512 inline __m512 load(const bf16_t *p) {
+    const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(h), 16));
+}
+
+LLAISYS_TARGET_AVX512 inline __m512 loadPartial(const float *p, size_t count) {
+    return _mm512_maskz_loadu_ps(static_cast<__mmask16>((1u << count) - 1), p);
+}
+
+// 16-bit masked loads need AVX512BW; go through a zero-filled copy instead.
+LLAISYS_TARGET_AVX512 inline __m512 loadPartial(const bf16_t *p, size_t count) {
+    alignas(32) bf16_t tail[W] = {};
+    std::copy(p, p + count, tail);
+    return load(tail);
+}
+
+template <typename E, size_t R>
+LLAISYS_TARGET_AVX512 void dotRows(float *y, const E *w, const E *x, size_t ldx, size_t n) {
+    constexpr size_t U = DOT_ROWS / R;
+    __m512 total[R];
+    for (size_t r = 0; r < R; r++) {
+        total[r] = _mm512_setzero_ps();
+    }
+    for (size_t b = 0; b < n; b += DOT_BLOCK) {
+        const size_t e = std::min(n, b + DOT_BLOCK);
+        __m512 acc[R][U];
+        for (size_t r = 0; r < R; r++) {
+            for (size_t u = 0; u < U; u++) {
+                acc[r][u] = _mm512_setzero_ps();
+            }
+        }
+        size_t i = b;
+        for (; i + U * W <= e; i += U * W) {
+            for (size_t u = 0; u < U; u++) {
+                const __m512 wv = load(w + i + u * W);
+                for (size_t r = 0; r < R; r++) {
+                    acc[r][u] = _mm512_fmadd_ps(wv, load(x + r * ldx + i + u * W), acc[r][u]);
+                }
+            }
+        }
+        for (; i < e; i += W) {
+            const size_t count = std::min(W, e - i);
+            const __m512 wv = count == W ? load(w + i) : loadPartial(w + i, count);
+            for (size_t r = 0; r < R; r++) {
+                const E *xr = x + r * ldx + i;
+                acc[r][0] = _mm512_fmadd_ps(wv, count == W ? load(xr) : loadPartial(xr, count), acc[r][0]);
+            }
+        }
+        for (size_t r = 0; r < R; r++) {
+            for (size_t step = 1; step < U; step *= 2) {
+                for (size_t u = 0; u + step < U; u += 2 * step) {
+                    acc[r][u] = _mm512_add_ps(acc[r][u], acc[r][u + step]);
+                }
+            }
+            total[r] = _mm512_add_ps(total[r], acc[r][0]);
+        }
+    }
+    for (size_t r = 0; r < R; r++) {
+        y[r] = _mm512_reduce_add_ps(total[r]);
+    }
+}
+
+template <typename E>
+void dots(float *y, const E *w, const E *x, size_t rows, size_t ldx, size_t n) {
+    splitRows<E, &dotRows<E, 1>, &dotRows<E, 2>, &dotRows<E, DOT_ROWS>>(y, w, x, rows, ldx, n);
+}
+
+// Each vector of W kept values covers 2 * W inputs, picked from two vectors
+// of x with one two-source permute; their positions come from 4 index bytes.
+template <typename E, size_t R, size_t U>
+LLAISYS_TARGET_AVX512 inline void sparse24Step(__m512 (&acc)[R][U], size_t u, const E *values, const uint8_t *idx,
+                                               const float *x, size_t ldx, size_t j) {
+    const __m512i shifts = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const __m512i groups = _mm512_setr_epi32(0, 0, 4, 4, 8, 8, 12, 12, 16, 16, 20, 20, 24, 24, 28, 28);
+    uint32_t bits;
+    std::memcpy(&bits, idx + j / 4, sizeof(bits));
+    const __m512i pos = _mm512_add_epi32(
+        _mm512_and_si512(_mm512_srlv_epi32(_mm512_set1_epi32(static_cast<int>(bits)), shifts), _mm512_set1_epi32(3)), groups);
+    const __m512 wv = load(values + j);
+    for (size_t r = 0; r < R; r++) {
+        const float *xr = x + r * ldx + 2 * j;
+        const __m512 xv = _mm512_permutex2var_ps(_mm512_loadu_ps(xr), pos, _mm512_loadu_ps(xr + W));
+        acc[r][u] = _mm512_fmadd_ps(wv, xv, acc[r][u]);
+    }
+}
+
+template <typename E, size_t R>
+LLAISYS_TARGET_AVX512 void sparse24Rows(float *y, const E *values, const uint8_t *idx, const float *x, size_t ldx, size_t n) {
+    constexpr size_t U = DOT_ROWS / R;
+    __m512 acc[R][U];
+    for (size_t r = 0; r < R; r++) {
+        for (size_t u = 0; u < U; u++) {
+            acc[r][u] = _mm512_setzero_ps();
+        }
+    }
+    const size_t nv = n / 2;
+    size_t j = 0;
+    for (; j + U * W <= nv; j += U * W) {
+        // Unrolled so the accumulators stay in registers.
+#pragma GCC unroll 4
+        for (size_t u = 0; u < U; u++) {
+            sparse24Step<E, R, U>(acc, u, values, idx, x, ldx, j + u * W);
+        }
+    }
+    for (; j + W <= nv; j += W) {
+        sparse24Step<E, R, U>(acc, 0, values, idx, x, ldx, j);
+    }
+    float sums[R];
+    for (size_t r = 0; r < R; r++) {
+        for (size_t u = 1; u < U; u++) {
+            acc[r][0] = _mm512_add_ps(acc[r][0], acc[r][u]);
+        }
+        sums[r] = _mm512_reduce_add_ps(acc[r][0]);
+    }
+    sparse24Tail<E, R>(sums, values, idx, x, ldx, j, n);
+    std::copy(sums, sums + R, y);
+}
+
+template <typename E>
+void sparse24Dots(float *y, const E *values, const uint8_t *idx, const float *x, size_t rows, size_t ldx, size_t n) {
+    splitSparseRows<E, &sparse24Rows<E, 1>, &sparse24Rows<E, DOT_ROWS>>(y, values, idx, x, rows, ldx, n);
+}
+
+LLAISYS_TARGET_AVX512 void bf16ToF32(float *y, const bf16_t *x, size_t n) {
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+        _mm512_storeu_ps(y + i, load(x + i));
+    }
+    if (i < n) {
+        _mm512_mask_storeu_ps(y + i, static_cast<__mmask16>((1u << (n - i)) - 1), loadPartial(x + i, n - i));
+    }
+}
+
+LLAISYS_TARGET_AVX512 inline __m512i bf16Bits(__m512 x) {
+    const __m512i bits = _mm512_castps_si512(x);
+    const __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(1));
+    return _mm512_srli_epi32(_mm512_add_epi32(_mm512_add_epi32(bits, _mm512_set1_epi32(0x7fff)), lsb), 16);
+}
+
+LLAISYS_TARGET_AVX512 void f32ToBf16(bf16_t *y, const float *x, size_t n) {
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(y + i), _mm512_cvtepi32_epi16(bf16Bits(_mm512_loadu_ps(x + i))));
+    }
+    if (i < n) {
+        const __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+        _mm512_mask_cvtepi32_storeu_epi16(y + i, mask, bf16Bits(_mm512_maskz_loadu_ps(mask, x + i)));
+    }
+}
+
+const Kernels KERNELS = {&map<exp>, &map<sigmoid>, &map<silu>, &map<tanh>, &map<rsqrt>, &expSum,
+                         &dots<float>, &dots<bf16_t>, &sparse24Dots<float>, &sparse24Dots<bf16_t>,
+                         &avx2::dotsI8, &bf16ToF32, &f32ToBf16};
+} // namespace avx512
+
+namespace avx512_vnni {
+constexpr size_t W = 64; // int8 elements per vector
+
+LLAISYS_TARGET_AVX512_VNNI inline __m512i load(const int8_t *p) {
+    return _mm512_loadu_si512(p);
+}
+
+LLAISYS_TARGET_AVX512_VNNI inline __m512i loadPartial(const int8_t *p, size_t count) {
+    return _mm512_maskz_loadu_epi8(static_cast<__mmask64>((1ull << count) - 1), p);
+}
+
+template <size_t R>
+LLAISYS_TARGET_AVX512_VNNI void dotRows(int32_t *y, const int8_t *w, const int8_t *x, const int32_t *xsum, size_t ldx, size_t n) {
+    constexpr size_t U = DOT_ROWS / R;
+    const __m512i flip = _mm512_set1_epi8(-128);
+    __m512i acc[R][U];
+    for (size_t r = 0; r < R; r++) {
+        for (size_t u = 0; u < U; u++) {
+            acc[r][u] = _mm512_setzero_si512();
+        }
+    }
+    size_t i = 0;
+    for (; i + U * W <= n; i += U * W) {
+#pragma GCC unroll 4
+        for (size_t u = 0; u < U; u++) {
+            const __m512i wv = _mm512_xor_si512(load(w + i + u * W), flip);
+            for (size_t r = 0; r < R; r++) {
+                acc[r][u] = _mm512_dpbusd_epi32(acc[r][u], wv, load(x + r * ldx + i + u * W));
+            }
+        }
+    }
+    for (; i < n; i += W) {
+        const size_t count = std::min(W, n - i);
+        const __m512i wv = _mm512_xor_si512(count == W ? load(w + i) : loadPartial(w + i, count), flip);
+        for (size_t r = 0; r < R; r++) {
+            const int8_t *xr = x + r * ldx + i;
+            acc[r][0] = _mm512_dpbusd_epi32(acc[r][0], wv, count == W ? load(xr) : loadPartial(xr, count));
+        }
+    }
+    for (size_t r = 0; r < R; r++) {
+        for (size_t u = 1; u < U; u++) {
+            acc[r][0] = _mm512_add_epi32(acc[r][0], acc[r][u]);
+        }
+        alignas(64) uint32_t lanes[16];
+        _mm512_store_si512(lanes, acc[r][0]);
+        y[r] = unoffsetI8(lanes, 16, xsum[r]);
+    }
+}
+
+void dotsI8(int32_t *y, const int8_t *w, const int8_t *x, const int32_t *xsum, size_t rows, size_t ldx, size_t n) {
+    splitI8Rows<&dotRows<1>, &dotRows<DOT_ROWS>>(y, w, x, xsum, rows, ldx, n);
+}
+
+const Kernels KERNELS = {&avx512::map<avx512::exp>, &avx512::map<avx512::sigmoid>, &avx512::map<avx512::silu>,
+                         &avx512::map<avx512::tanh>, &avx512::map<avx512::rsqrt>, &avx512::expSum,
+                         &avx512::dots<float>, &avx512::dots<bf16_t>, &avx512::sparse24Dots<float>,
+                         &avx512::sparse24Dots<bf16_t>, &dotsI8, &avx512::bf16ToF32, &avx512::f32ToBf16};
+} // namespace avx512_vnni
+
+namespace avx512_bf16 {
+constexpr size_t W = 32; // bf16 elements per vector
+
+LLAISYS_TARGET_AVX512_BF16 inline __m512bh load(const bf16_t *p) {
+    return (__m512bh)_mm512_loadu_si512(p);
+}
+
+LLAISYS_TARGET_AVX512_BF16 inline __m512bh loadPartial(const bf16_t *p, size_t count) {
+    return (__m512bh)_mm512_maskz_loadu_epi16(static_cast<__mmask32>((1ull << count) - 1), p);
+}
+
+// Same blocking as the emulated kernels; vdpbf16ps adds two products per
+// float lane, so a vector covers W bf16 elements.
+template <size_t R>
+LLAISYS_TARGET_AVX512_BF16 void dotRows(float *y, const bf16_t *w, const bf16_t *x, size_t ldx, size_t n) {
+    constexpr size_t U = DOT_ROWS / R;
+    __m512 total[R];
+    for (size_t r = 0; r < R; r++) {
+        total[r] = _mm512_setzero_ps();
+    }
+    for (size_t b = 0; b < n; b += DOT_BLOCK) {
+        const size_t e = std::min(n, b + DOT_BLOCK);
+        __m512 acc[R][U];
+        for (size_t r = 0; r < R; r++) {
+            for (size_t u = 0; u < U; u++) {
+                acc[r][u] = _mm512_setzero_ps();
+            }
+        }
+        size_t i = b;
+        for (; i + U * W <= e; i += U * W) {
+            for (size_t u = 0; u < U; u++) {
+                const __m512bh wv = load(w + i + u * W);
+                for (size_t r = 0; r < R; r++) {
+                    acc[r][u] = _mm512_dpbf16_ps(acc[r][u], wv, load(x + r * ldx + i + u * W));
+                }
+            }
+        }
+        for (; i < e; i += W) {
+            const size_t count = std::min(W, e - i);
+            const __m512bh wv = count == W ? load(w + i) : loadPartial(w + i, count);
+            for (size_t r = 0; r < R; r++) {
+                const bf16_t *xr = x + r * ldx + i;
+                acc[r][0] = _mm512_dpbf16_ps(acc[r][0], wv, count == W ? load(xr) : loadPartial(xr, count));
+            }
+        }
+        for (size_t r = 0; r < R; r++) {
+            for (size_t step = 1; step < U; step *= 2) {
+                for (size_t u = 0; u + step < U; u += 2 * step) {
+                    acc[r][u] = _mm512_add_ps(acc[r][u], acc[r][u + step]);
+                }
+            }
+            total[r] = _mm512_add_ps(total[r], acc[r][0]);
+        }
+    }
+    for (size_t r = 0; r < R; r++) {
+        y[r] = _mm512_reduce_add_ps(total[r]);
+    }
+}
+
+void dots(float *y, const bf16_t *w, const bf16_t *x, size_t rows, size_t ldx, size_t n) {
+    splitRows<bf16_t, &dotRows<1>, &dotRows<2>, &dotRows<DOT_ROWS>>(y, w, x, rows, ldx, n);
+}
+
+const Kernels KERNELS = {&avx512::map<avx512::exp>, &avx512::map<avx512::sigmoid>, &avx512::map<avx512::silu>,
+                         &avx512::map<avx512::tanh>, &avx512::map<avx512::rsqrt>, &avx512::expSum,
+                         &avx512::dots<float>, &dots, &avx512::sparse24Dots<float>, &avx512::sparse24Dots<bf16_t>,
+                         &avx512_vnni::dotsI8, &avx512::bf16ToF32, &avx512::f32ToBf16};
+} // namespace avx512_bf16
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+bool supported(Isa isa) {
+    switch (isa) {
+    case Isa::SCALAR:
+        return true;
+#ifdef LLAISYS_VMATH_X86
+    case Isa::AVX2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case Isa::AVX512:
+        return __builtin_cpu_supports("avx512f");
+    case Isa::AVX512_BF16:
+        return supported(Isa::AVX512_VNNI) && __builtin_cpu_supports("avx512bf16");
+    case Isa::AVX512_VNNI:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+               && __builtin_cpu_supports("avx512vnni");
+#endif
+#ifdef LLAISYS_VMATH_AVX_VNNI
+    case Isa::AVX2_VNNI:
+        return supported(Isa::AVX2) && __builtin_cpu_supports("avxvnni");
+#endif
+    default:
+        return false;
+    }
+}
+
+const Kernels &kernelsFor(Isa isa) {
+    switch (isa) {
+#ifdef LLAISYS_VMATH_X86
+    case Isa::AVX2:
+        return avx2::KERNELS;
+    case Isa::AVX512:
+        return avx512::KERNELS;
+    case Isa::AVX512_BF16:
+        return avx512_bf16::KERNELS;
+    case Isa::AVX512_VNNI:
+        return avx512_vnni::KERNELS;
+#endif
+#ifdef LLAISYS_VMATH_AVX_VNNI
+    case Isa::AVX2_VNNI:
+        return avx2_vnni::KERNELS;
+#endif
+    default:
+        return SCALAR_KERNELS;
+    }
+}
+
+std::atomic<const Kernels *> &active() {
+    static std::atomic<const Kernels *> kernels{&kernelsFor(bestIsa())};
+    return kernels;
+}
+
+std::atomic<Isa> &activeIsa() {
+    static std::atomic<Isa> isa{bestIsa()};
+    return isa;
+}
+
+const Kernels &kernels() {
+    return *active().load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+Isa bestIsa() {
+    static const Isa best = supported(Isa::AVX512_BF16)   ? Isa::AVX512_BF16
+                            : supported(Isa::AVX512_VNNI) ? Isa::AVX512_VNNI
+                            : supported(Isa::AVX512)      ? Isa::AVX512
+                            : supported(Isa::AVX2_VNNI)   ? Isa::AVX2_VNNI
+                            : supported(Isa::AVX2)        ? Isa::AVX2
+                                                          : Isa::SCALAR;
+    return best;
+}
+
+Isa isa() {
+    return activeIsa().load();
+}
+
+bool setIsa(Isa isa) {
+    if (!supported(isa)) {
+        return false;
+    }
+    activeIsa().store(isa);
+    active().store(&kernelsFor(isa));
+    return true;
+}
+
+void exp(float *y, const float *x, size_t n) {
+    kernels().exp(y, x, n);
+}
+
+void sigmoid(float *y, const float *x, size_t n) {
+    kernels().sigmoid(y, x, n);
+}
+
+void silu(float *y, const float *x, size_t n) {
+    kernels().silu(y, x, n);
+}
+
+void tanh(float *y, const float *x, size_t n) {
+    kernels().tanh(y, x, n);
+}
+
+void rsqrt(float *y, const float *x, size_t n) {
+    kernels().rsqrt(y, x, n);
+}
+
+float rsqrt(float x) {
+    float y;
+    kernels().rsqrt(&y, &x, 1);
+    return y;
+}
+
+float expSum(float *y, const float *x, size_t n, float shift, float scale) {
+    return kernels().exp_sum(y, x, n, shift, scale);
+}
+
+void softmax(float *y, const float *x, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    const float max = *std::max_element(x, x + n);
+    const float inv = 1.0f / expSum(y, x, n, max, 1.0f);
+    for (size_t i = 0; i < n; i++) {
+        y[i] *= inv;
+    }
+}
+
+void dots(float *y, const float *w, const float *x, size_t rows, size_t ldx, size_t n) {
+    kernels().dots(y, w, x, rows, ldx, n);
+}
+
+void dotsBf16(float *y, const bf16_t *w, const bf16_t *x, size_t rows, size_t ldx, size_t n) {
+    kernels().dots_bf16(y, w, x, rows, ldx, n);
+}
+
+void sparse24Dots(float *y, const float *values, const uint8_t *idx, const float *x, size_t rows, size_t ldx, size_t n) {
+    kernels().sparse24_dots(y, values, idx, x, rows, ldx, n);
+}
+
+void sparse24DotsBf16(float *y, const bf16_t *values, const uint8_t *idx, const float *x, size_t rows, size_t ldx, size_t n) {
+    kernels().sparse24_dots_bf16(y, values, idx, x, rows, ldx, n);
+}
+
+void dotsI8(int32_t *y, const int8_t *w, const int8_t *x, const int32_t *xsum, size_t rows, size_t ldx, size_t n) {
+    kernels().dots_i8(y, w, x, xsum, rows, ldx, n);
+}
+
+void bf16ToF32(float *y, const bf16_t *x, size_t n) {
+    kernels().bf16_to_f32(y, x, n);
+}
+
+void f32ToBf16(bf16_t *y, const float *x, size_t n) {
+    kernels().f32_to_bf16(y, x, n);
+}
+
+} // namespace llaisys::utils::vmath
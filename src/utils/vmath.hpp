@@ -0,0 +1,128 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace llaisys::utils::vmath {
+
+// Vectorized float32 transcendental functions for the non-GEMM kernels, plus
+// the dot-product kernels behind linear and bulk bf16 <-> float conversion.
+//
+// Every function has a portable scalar path plus AVX2+FMA and AVX-512 paths
+// compiled with per-function target attributes (no special build flags) and
+// picked once at runtime from the host CPU. All paths use the same algorithms,
+// so they agree to within the bounds below; tails shorter than a vector go
+// through the vector code too (masked, or on a padded copy), so results do
+// not depend on an element's position.
+//
+// Error bounds, measured exhaustively over every float input in the stated
+// range against a double-precision reference, in ULP of the float result
+// (scalar / AVX2 / AVX-512 where they differ):
+//   exp      x in [-87.33, 88.72]   1.01
+//   sigmoid  all x                  2.83
+//   silu     x >= -87               3.65 (below, sigmoid(x) is subnormal)
+//   tanh     all x                  1.33
+//   rsqrt    x >= FLT_MIN           1.49 / 4.07 / 2.02
+// exp flushes to 0 below -104 and overflows to +inf above 88.72; NaN
+// propagates through it. The other functions only specify finite input.
+
+enum class Isa {
+    SCALAR,
+    AVX2,
+    AVX512,
+    AVX512_BF16, // AVX512 plus native bf16 and int8 dot products (vdpbf16ps, vpdpbusd)
+    AVX2_VNNI,   // AVX2 plus VEX int8 dot products (AVX-VNNI vpdpbusd)
+    AVX512_VNNI, // AVX512 plus int8 dot products (vpdpbusd)
+};
+
+// Best instruction set the host supports.
+Isa bestIsa();
+// Instruction set in use (bestIsa() unless overridden).
+Isa isa();
+// Override the path in use, e.g. to test every path against the scalar one.
+// Returns false, changing nothing, if the host does not support `isa`.
+bool setIsa(Isa isa);
+
+// Elementwise y[i] = f(x[i]); y may alias x.
+void exp(float *y, const float *x, size_t n);
+void sigmoid(float *y, const float *x, size_t n);
+// x * sigmoid(x), the SwiGLU gate activation.
+void silu(float *y, const float *x, size_t n);
+void tanh(float *y, const float *x, size_t n);
+void rsqrt(float *y, const float *x, size_t n);
+
+float rsqrt(float x);
+
+// y[i] = exp((x[i] - shift) * scale); returns the sum of y.
+float expSum(float *y, const float *x, size_t n, float shift, float scale);
+// Numerically stable softmax of x into y (may alias).
+void softmax(float *y, const float *x, size_t n);
+
+// y[r] = sum_i w[i] * x[r * ldx + i] for r < rows, accumulated in float with
+// FMA. Each row's sum is blocked: DOT_BLOCK products at a time go into
+// several vector accumulators that are added pairwise into a running total,
+// so the rounding error grows with n / DOT_BLOCK rather than n. Rows are
+// processed four at a time, sharing every load of w.
+constexpr size_t DOT_BLOCK = 256;
+void dots(float *y, const float *w, const float *x, size_t rows, size_t ldx, size_t n);
+// The same over bf16 operands with float accumulators. AVX512_BF16 multiplies
+// pairs with vdpbf16ps (denormal inputs read as zero); the other paths widen
+// to float, which is exact, and use the float kernels' FMA.
+void dotsBf16(float *y, const bf16_t *w, const bf16_t *x, size_t rows, size_t ldx, size_t n);
+
+// y[r] = sum_i w[i] * x[r * ldx + i] for r < rows over int8 operands, exact
+// in int32 as long as every partial sum fits (n * 127 * 127 < 2^31 for the
+// symmetric [-127, 127] quantization linear uses). xsum[r] must be the sum of
+// row r of x: vpdpbusd multiplies unsigned by signed bytes, so the VNNI paths
+// offset w by 128 and subtract 128 * xsum[r] afterwards. The other paths
+// widen to int16 and use vpmaddwd (AVX2, AVX512) or plain int32 (scalar);
+// all of them return the same integers.
+void dotsI8(int32_t *y, const int8_t *w, const int8_t *x, const int32_t *xsum, size_t rows, size_t ldx, size_t n);
+
+// 2:4 structured sparse rows: of every aligned group of 4 dense weights at
+// most 2 are nonzero, stored as the 2 kept values in input order plus each
+// one's 2-bit position in its group, four positions per index byte from the
+// low bits up. Kept value j sits at dense index sparse24Index(idx, j).
+inline size_t sparse24Index(const uint8_t *idx, size_t j) {
+    return 4 * (j / 2) + ((idx[j / 4] >> (2 * (j % 4))) & 3);
+}
+// y[r] = sum_j values[j] * x[r * ldx + sparse24Index(idx, j)] for r < rows,
+// accumulated in float with FMA. n is the dense length, a multiple of 8: the
+// row holds n / 2 values and n / 8 index bytes. The vector paths gather the
+// inputs of 8 (AVX2) or 16 (AVX-512) values with in-register permutes.
+void sparse24Dots(float *y, const float *values, const uint8_t *idx, const float *x, size_t rows, size_t ldx, size_t n);
+// The same with bf16 values, widened to float as they are loaded.
+void sparse24DotsBf16(float *y, const bf16_t *values, const uint8_t *idx, const float *x, size_t rows, size_t ldx, size_t n);
+
+// Bulk conversions for tiles of bf16 data, bit-identical to utils::cast
+// (round to nearest even).
+void bf16ToF32(float *y, const bf16_t *x, size_t n);
+void f32ToBf16(bf16_t *y, const float *x, size_t n);
+
+// y = float(x) / x = T(y) for a tile; vectorized for bf16, cast otherwise.
+template <typename T>
+void toF32(float *y, const T *x, size_t n) {
+    if constexpr (std::is_same_v<T, bf16_t>) {
+        bf16ToF32(y, x, n);
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            y[i] = cast<float>(x[i]);
+        }
+    }
+}
+
+template <typename T>
+void fromF32(T *y, const float *x, size_t n) {
+    if constexpr (std::is_same_v<T, bf16_t>) {
+        f32ToBf16(y, x, n);
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            y[i] = cast<T>(x[i]);
+        }
+    }
+}
+
+} // namespace llaisys::utils::vmath
@@ -22,8 +22,9 @@ def test_op_linear(
     rtol=1e-5,
     device_name="cpu",
     profile=False,
+    accumulation=None,
 ):
-    print(f"   out {out_shape}, x {x_shape}, w {w_shape}, bias {use_bias}, dtype <{dtype_name}>")
+    print(f"   out {out_shape}, x {x_shape}, w {w_shape}, bias {use_bias}, dtype <{dtype_name}>, accumulation {accumulation}")
     x, x_ = random_tensor(x_shape, dtype_name, device_name, scale=0.1)
     w, w_ = random_tensor(w_shape, dtype_name, device_name, scale=0.01)
 
@@ -33,18 +34,53 @@ def test_op_linear(
 
     out, out_ = random_tensor(out_shape, dtype_name, device_name)
     torch_linear(out, x, w, bias)
-    llaisys.Ops.linear(out_, x_, w_, bias_)
+    llaisys.Ops.linear(out_, x_, w_, bias_, accumulation)
 
     assert check_equal(out_, out, atol=atol, rtol=rtol)
 
     if profile:
         benchmark(
             lambda: torch_linear(out, x, w, bias),
-            lambda: llaisys.Ops.linear(out_, x_, w_, bias_),
+            lambda: llaisys.Ops.linear(out_, x_, w_, bias_, accumulation),
             device_name,
         )
 
 
+def test_op_linear_accumulation(in_features=4096, device_name="cpu"):
+    # Large terms that cancel, so the result is far smaller than the partial sums.
+    print(f"   accumulation modes, In {in_features}")
+    x, x_ = random_tensor((3, in_features), "f32", device_name)
+    w, w_ = random_tensor((5, in_features), "f32", device_name)
+    x[:, 0] = 1e4
+    w[:, 0] = 1e4
+    x[:, 1] = 1e4
+    w[:, 1] = -1e4
+    x_.load(x.data_ptr())
+    w_.load(w.data_ptr())
+    ref = (x.double() @ w.double().T).float()
+
+    out, out_ = random_tensor((3, 5), "f32", device_name)
+    # per-call mode wins over the process-wide one
+    llaisys.Ops.set_linear_accumulation("f32")
+    llaisys.Ops.linear(out_, x_, w_, None, "kahan")
+    assert check_equal(out_, ref, atol=1e-6, rtol=1e-6)
+
+    llaisys.Ops.linear(out_, x_, w_, None)
+    fast = torch.empty_like(ref)
+    llaisys.RuntimeAPI(llaisys.DeviceType.CPU).memcpy_sync(
+        fast.data_ptr(), out_.data_ptr(), fast.numel() * 4, llaisys.MemcpyKind.H2H
+    )
+
+    llaisys.Ops.set_linear_accumulation("kahan")
+    assert llaisys.Ops.linear_accumulation() == "kahan"
+    llaisys.Ops.linear(out_, x_, w_, None, "f32")
+    assert check_equal(out_, fast, atol=0, rtol=0)
+    # the process-wide mode applies to plain calls
+    llaisys.Ops.linear(out_, x_, w_, None)
+    assert check_equal(out_, ref, atol=1e-6, rtol=1e-6)
+    llaisys.Ops.set_linear_accumulation("f32")
+
+
 if __name__ == "__main__":
     import argparse
 
@@ -66,5 +102,9 @@ if __name__ == "__main__":
     for shapes in testShapes:
         for dtype_name, atol, rtol in testDtypePrec:
             test_op_linear(*shapes, dtype_name, atol, rtol, args.device, args.profile)
+    # the validation mode on the small shape only; it is scalar and slow
+    for dtype_name, atol, rtol in testDtypePrec:
+        test_op_linear(*testShapes[0], dtype_name, atol, rtol, args.device, accumulation="kahan")
+    test_op_linear_accumulation(device_name=args.device)
 
     print("\033[92mTest passed!\033[0m\n")
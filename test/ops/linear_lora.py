@@ -0,0 +1,78 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import random_int_tensor, random_tensor, check_equal, benchmark
+
+
+def torch_linear_lora(out, x, w, bias, lora_a, lora_b, adapter_ids):
+    torch.nn.functional.linear(x, w, bias, out=out)
+    for row, adapter in enumerate(adapter_ids.tolist()):
+        if adapter >= 0:
+            delta = (x[row].float() @ lora_a[adapter].float().T) @ lora_b[adapter].float().T
+            out[row] = (out[row].float() + delta).to(out.dtype)
+
+
+def test_op_linear_lora(
+    batch,
+    in_features,
+    out_features,
+    nadapter,
+    rank,
+    dtype_name="f32",
+    atol=1e-5,
+    rtol=1e-5,
+    device_name="cpu",
+    profile=False,
+):
+    print(f"   batch {batch}, in {in_features}, out {out_features}, "
+          f"adapters {nadapter} x rank {rank}, dtype <{dtype_name}>")
+    x, x_ = random_tensor((batch, in_features), dtype_name, device_name, scale=0.1)
+    w, w_ = random_tensor((out_features, in_features), dtype_name, device_name, scale=0.01)
+    bias, bias_ = random_tensor((out_features,), dtype_name, device_name)
+    lora_a, lora_a_ = random_tensor((nadapter, rank, in_features), dtype_name, device_name, scale=0.1)
+    lora_b, lora_b_ = random_tensor((nadapter, out_features, rank), dtype_name, device_name, scale=0.1)
+    # -1 rows use the base weights only; the rest mix adapters within the batch.
+    ids, ids_ = random_int_tensor((batch,), device_name, low=-1, high=nadapter)
+
+    out, out_ = random_tensor((batch, out_features), dtype_name, device_name)
+    torch_linear_lora(out, x, w, bias, lora_a, lora_b, ids)
+    llaisys.Ops.linear_lora(out_, x_, w_, bias_, lora_a_, lora_b_, ids_)
+
+    assert check_equal(out_, out, atol=atol, rtol=rtol)
+
+    if profile:
+        benchmark(
+            lambda: torch_linear_lora(out, x, w, bias, lora_a, lora_b, ids),
+            lambda: llaisys.Ops.linear_lora(out_, x_, w_, bias_, lora_a_, lora_b_, ids_),
+            device_name,
+        )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    testShapes = [
+        # batch, in, out, adapters, rank
+        (4, 8, 6, 2, 2),
+        (64, 1536, 256, 4, 16),
+    ]
+    testDtypePrec = [
+        # type, atol, rtol
+        ("f32", 1e-4, 1e-4),
+        ("f16", 1e-3, 1e-3),
+        ("bf16", 1e-2, 1e-2),
+    ]
+    print(f"Testing Ops.linear_lora on {args.device}")
+    for shapes in testShapes:
+        for dtype_name, atol, rtol in testDtypePrec:
+            test_op_linear_lora(*shapes, dtype_name, atol, rtol, args.device, args.profile)
+
+    print("\033[92mTest passed!\033[0m\n")
@@ -0,0 +1,97 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import random_tensor, zero_tensor, check_equal, benchmark
+
+
+def torch_sparse24_compress(w):
+    out_features, in_features = w.shape
+    groups = w.reshape(out_features, in_features // 4, 4)
+    # two largest magnitudes per group, the lower position first on ties
+    order = torch.sort(groups.float().abs(), dim=-1, descending=True, stable=True).indices
+    kept = torch.sort(order[..., :2], dim=-1).values
+    values = torch.gather(groups, -1, kept).reshape(out_features, in_features // 2)
+    pos = kept.reshape(out_features, in_features // 8, 4)
+    indices = pos[..., 0] | pos[..., 1] << 2 | pos[..., 2] << 4 | pos[..., 3] << 6
+    pruned = torch.zeros_like(groups).scatter_(-1, kept, torch.gather(groups, -1, kept))
+    return values, indices.to(torch.uint8), pruned.reshape(out_features, in_features)
+
+
+def test_op_linear_sparse24(
+    batch,
+    in_features,
+    out_features,
+    use_bias=True,
+    dtype_name="f32",
+    atol=1e-5,
+    rtol=1e-5,
+    device_name="cpu",
+    profile=False,
+):
+    print(f"   batch {batch}, in {in_features}, out {out_features}, "
+          f"bias {use_bias}, dtype <{dtype_name}>")
+    x, x_ = random_tensor((batch, in_features), dtype_name, device_name, scale=0.1, bias=-0.05)
+    w, w_ = random_tensor((out_features, in_features), dtype_name, device_name, scale=0.02, bias=-0.01)
+    bias, bias_ = None, None
+    if use_bias:
+        bias, bias_ = random_tensor((out_features,), dtype_name, device_name)
+
+    values, indices, pruned = torch_sparse24_compress(w)
+    values_ = zero_tensor((out_features, in_features // 2), dtype_name, device_name)[1]
+    indices_ = zero_tensor((out_features, in_features // 8), "u8", device_name)[1]
+    llaisys.Ops.sparse24_compress(values_, indices_, w_)
+    assert check_equal(values_, values, strict=True)
+    assert check_equal(indices_, indices, strict=True)
+
+    out, out_ = random_tensor((batch, out_features), dtype_name, device_name)
+    torch.nn.functional.linear(x, pruned, bias, out=out)
+    llaisys.Ops.linear_sparse24(out_, x_, values_, indices_, bias_)
+    assert check_equal(out_, out, atol=atol, rtol=rtol)
+
+    if profile:
+        out_dense_ = zero_tensor((batch, out_features), dtype_name, device_name)[1]
+        print("      dense:")
+        benchmark(
+            lambda: torch.nn.functional.linear(x, w, bias, out=out),
+            lambda: llaisys.Ops.linear(out_dense_, x_, w_, bias_),
+            device_name,
+        )
+        print("      2:4 sparse:")
+        benchmark(
+            lambda: torch.nn.functional.linear(x, pruned, bias, out=out),
+            lambda: llaisys.Ops.linear_sparse24(out_, x_, values_, indices_, bias_),
+            device_name,
+        )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    testShapes = [
+        # batch, in, out
+        (1, 8, 3),
+        (5, 40, 7),
+        (9, 200, 33),
+        (16, 1536, 512),
+    ]
+    testDtypePrec = [
+        # type, atol, rtol
+        ("f32", 1e-5, 1e-5),
+        ("f16", 1e-3, 1e-3),
+        ("bf16", 1e-2, 1e-2),
+    ]
+    print(f"Testing Ops.linear_sparse24 on {args.device}")
+    for shapes in testShapes:
+        for use_bias in [True, False]:
+            for dtype_name, atol, rtol in testDtypePrec:
+                test_op_linear_sparse24(*shapes, use_bias, dtype_name, atol, rtol, args.device, args.profile)
+
+    print("\033[92mTest passed!\033[0m\n")
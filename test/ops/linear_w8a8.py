@@ -0,0 +1,103 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import random_tensor, zero_tensor, check_equal, benchmark
+
+
+def torch_quantize_i8(x):
+    # symmetric per row, rounded half to even like nearbyint
+    x = x.float()
+    absmax = x.abs().amax(dim=-1, keepdim=True)
+    inv = torch.where(absmax > 0, 127.0 / absmax, torch.zeros_like(absmax))
+    q = torch.round(x * inv).clamp(-127, 127).to(torch.int8)
+    return q, (absmax / 127.0).squeeze(-1)
+
+
+def torch_linear_w8a8(x, qweight, scales, bias, out):
+    qx, x_scales = torch_quantize_i8(x)
+    # exact integer sums: every partial sum fits in a double's mantissa
+    acc = (qx.double() @ qweight.double().T).float()
+    y = acc * (x_scales[:, None] * scales[None, :])
+    if bias is not None:
+        y = y + bias.float()
+    out.copy_(y.to(out.dtype))
+
+
+def test_op_linear_w8a8(
+    batch,
+    in_features,
+    out_features,
+    use_bias=True,
+    dtype_name="f32",
+    atol=1e-5,
+    rtol=1e-5,
+    device_name="cpu",
+    profile=False,
+):
+    print(f"   batch {batch}, in {in_features}, out {out_features}, "
+          f"bias {use_bias}, dtype <{dtype_name}>")
+    x, x_ = random_tensor((batch, in_features), dtype_name, device_name, scale=0.1, bias=-0.05)
+    w, w_ = random_tensor((out_features, in_features), dtype_name, device_name, scale=0.02, bias=-0.01)
+    bias, bias_ = None, None
+    if use_bias:
+        bias, bias_ = random_tensor((out_features,), dtype_name, device_name)
+
+    qweight, scales = torch_quantize_i8(w)
+    qweight_ = zero_tensor((out_features, in_features), "i8", device_name)[1]
+    scales_ = zero_tensor((out_features,), "f32", device_name)[1]
+    llaisys.Ops.w8a8_quantize(qweight_, scales_, w_)
+    assert check_equal(qweight_, qweight, strict=True)
+    assert check_equal(scales_, scales, strict=True)
+
+    out, out_ = random_tensor((batch, out_features), dtype_name, device_name)
+    torch_linear_w8a8(x, qweight, scales, bias, out)
+    llaisys.Ops.linear_w8a8(out_, x_, qweight_, scales_, bias_)
+    assert check_equal(out_, out, atol=atol, rtol=rtol)
+
+    if profile:
+        out_dense_ = zero_tensor((batch, out_features), dtype_name, device_name)[1]
+        print("      dense:")
+        benchmark(
+            lambda: torch.nn.functional.linear(x, w, bias, out=out),
+            lambda: llaisys.Ops.linear(out_dense_, x_, w_, bias_),
+            device_name,
+        )
+        print("      w8a8:")
+        benchmark(
+            lambda: torch_linear_w8a8(x, qweight, scales, bias, out),
+            lambda: llaisys.Ops.linear_w8a8(out_, x_, qweight_, scales_, bias_),
+            device_name,
+        )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    testShapes = [
+        # batch, in, out
+        (1, 7, 3),
+        (5, 40, 7),
+        (9, 200, 33),
+        (64, 1536, 512),
+    ]
+    testDtypePrec = [
+        # type, atol, rtol
+        ("f32", 1e-5, 1e-5),
+        ("f16", 1e-3, 1e-3),
+        ("bf16", 1e-2, 1e-2),
+    ]
+    print(f"Testing Ops.linear_w8a8 on {args.device}")
+    for shapes in testShapes:
+        for use_bias in [True, False]:
+            for dtype_name, atol, rtol in testDtypePrec:
+                test_op_linear_w8a8(*shapes, use_bias, dtype_name, atol, rtol, args.device, args.profile)
+
+    print("\033[92mTest passed!\033[0m\n")
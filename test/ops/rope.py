@@ -68,7 +68,10 @@ if __name__ == "__main__":
     args = parser.parse_args()
     testShapes = [
         ((2, 1, 4), (0, 2)), 
-        ((512, 4, 4096), (512, 1024))]
+        ((512, 4, 4096), (512, 1024)),
+        # specialized head dims
+        ((7, 12, 128), (3, 10)),
+        ((7, 14, 64), (0, 7))]
     testDtypePrec = [
         # type, atol, rtol
         ("f32", 1e-4, 1e-4),
@@ -5,10 +5,10 @@ parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
 sys.path.insert(0, parent_dir)
 import llaisys
 import torch
-from test_utils import random_tensor, check_equal, benchmark
+from test_utils import random_tensor, random_int_tensor, check_equal, benchmark
 
 
-def torch_self_attention(attn_val, query, key, value, scale):
+def torch_self_attention(attn_val, query, key, value, scale, window=0, sink=0):
     query = query.transpose(-2, -3)
     key = key.transpose(-2, -3)
     value = value.transpose(-2, -3)
@@ -16,6 +16,11 @@ def torch_self_attention(attn_val, query, key, value, scale):
     attn_bias = torch.zeros(L, S, dtype=query.dtype, device=query.device)
 
     temp_mask = torch.ones(L, S, dtype=torch.bool).tril(diagonal=S-L)
+    if window > 0:
+        # Keys older than the window stay visible only if they are among the first `sink`.
+        recent = torch.ones(L, S, dtype=torch.bool).triu(diagonal=S - L - window + 1)
+        recent[:, :sink] = True
+        temp_mask &= recent
     attn_bias.masked_fill_(temp_mask.logical_not(), float("-inf"))
     attn_bias.to(query.dtype)
 
@@ -28,12 +33,43 @@ def torch_self_attention(attn_val, query, key, value, scale):
     attn_val.copy_((attn_weight @ value).transpose(-2, -3))
 
 
+def tree_visibility(parents, kvlen):
+    # Query s sees the shared prefix, its ancestors and itself.
+    qlen = len(parents)
+    prefix = kvlen - qlen
+    visible = torch.zeros(qlen, kvlen, dtype=torch.bool)
+    visible[:, :prefix] = True
+    for s in range(qlen):
+        node = s
+        while node >= 0:
+            visible[s, prefix + node] = True
+            node = parents[node]
+    return visible
+
+
+def torch_tree_attention(attn_val, query, key, value, scale, parents):
+    query = query.transpose(-2, -3)
+    key = key.transpose(-2, -3)
+    value = value.transpose(-2, -3)
+    visible = tree_visibility(parents, key.size(-2))
+
+    key = key.repeat_interleave(query.size(-3) // key.size(-3), -3)
+    value = value.repeat_interleave(query.size(-3) // value.size(-3), -3)
+
+    attn_weight = query @ key.transpose(-2, -1) * scale
+    attn_weight.masked_fill_(visible.logical_not(), float("-inf"))
+    attn_weight = torch.softmax(attn_weight, dim=-1)
+    attn_val.copy_((attn_weight @ value).transpose(-2, -3))
+
+
 def test_op_self_attention(
     qlen,
     kvlen,
     nh,
     nkvh,
     hd,
+    window=0,
+    sink=0,
     dtype_name="f32",
     atol=1e-5,
     rtol=1e-5,
@@ -41,7 +77,7 @@ def test_op_self_attention(
     profile=False,
 ):
     print(
-        f"   qlen={qlen} kvlen={kvlen} nh={nh} nkvh={nkvh} hd={hd} dtype <{dtype_name}>"
+        f"   qlen={qlen} kvlen={kvlen} nh={nh} nkvh={nkvh} hd={hd} window={window} sink={sink} dtype <{dtype_name}>"
     )
     q, q_ = random_tensor((qlen, nh, hd), dtype_name, device_name)
     k, k_ = random_tensor((kvlen, nkvh, hd), dtype_name, device_name)
@@ -49,18 +85,79 @@ def test_op_self_attention(
     scale = 1.0 / (hd**0.5)
 
     attn_val, attn_val_ = random_tensor((qlen, nh, hd), dtype_name, device_name)
-    torch_self_attention(attn_val, q, k, v, scale)
-    llaisys.Ops.self_attention(attn_val_, q_, k_, v_, scale)
+    torch_self_attention(attn_val, q, k, v, scale, window, sink)
+    llaisys.Ops.self_attention(attn_val_, q_, k_, v_, scale, window, sink)
     assert check_equal(attn_val_, attn_val, atol=atol, rtol=rtol)
 
     if profile:
         benchmark(
-            lambda: torch_self_attention(attn_val, q, k, v, scale),
-            lambda: llaisys.Ops.self_attention(attn_val_, q_, k_, v_, scale),
+            lambda: torch_self_attention(attn_val, q, k, v, scale, window, sink),
+            lambda: llaisys.Ops.self_attention(attn_val_, q_, k_, v_, scale, window, sink),
             device_name,
         )
 
 
+def test_op_self_attention_tree(
+    prefix,
+    parents,
+    nh,
+    nkvh,
+    hd,
+    dtype_name="f32",
+    atol=1e-5,
+    rtol=1e-5,
+    device_name="cpu",
+):
+    qlen = len(parents)
+    kvlen = prefix + qlen
+    print(f"   tree prefix={prefix} qlen={qlen} nh={nh} nkvh={nkvh} hd={hd} dtype <{dtype_name}>")
+    q, q_ = random_tensor((qlen, nh, hd), dtype_name, device_name)
+    k, k_ = random_tensor((kvlen, nkvh, hd), dtype_name, device_name)
+    v, v_ = random_tensor((kvlen, nkvh, hd), dtype_name, device_name)
+    parent_ids, parent_ids_ = random_int_tensor((qlen,), device_name)
+    parent_ids.copy_(torch.tensor(parents, dtype=torch.int64))
+    parent_ids_.load(parent_ids.data_ptr())
+    scale = 1.0 / (hd**0.5)
+
+    attn_val, attn_val_ = random_tensor((qlen, nh, hd), dtype_name, device_name)
+    torch_tree_attention(attn_val, q, k, v, scale, parents)
+    llaisys.Ops.self_attention_tree(attn_val_, q_, k_, v_, parent_ids_, scale)
+    assert check_equal(attn_val_, attn_val, atol=atol, rtol=rtol)
+
+    # Each token sits one position past its parent.
+    pos_ids, pos_ids_ = random_int_tensor((qlen,), device_name)
+    llaisys.Ops.tree_position_ids(pos_ids_, parent_ids_, prefix)
+    for s_ in range(qlen):
+        pos_ids[s_] = prefix if parents[s_] < 0 else pos_ids[parents[s_]] + 1
+    assert check_equal(pos_ids_, pos_ids, atol=0, rtol=0)
+
+
+def test_op_self_attention_threads(qlen, kvlen, nh, nkvh, hd, window=0, sink=0, device_name="cpu"):
+    # The query blocks are split across threads without changing any sum.
+    print(f"   qlen={qlen} kvlen={kvlen} nh={nh} nkvh={nkvh} hd={hd} window={window} sink={sink} thread counts")
+    q, q_ = random_tensor((qlen, nh, hd), "f32", device_name)
+    k, k_ = random_tensor((kvlen, nkvh, hd), "f32", device_name)
+    v, v_ = random_tensor((kvlen, nkvh, hd), "f32", device_name)
+    scale = 1.0 / (hd**0.5)
+
+    attn_val, attn_val_ = random_tensor((qlen, nh, hd), "f32", device_name)
+    llaisys.RuntimeAPI.set_cpu_threads(1)
+    assert llaisys.RuntimeAPI.cpu_threads() == 1
+    llaisys.Ops.self_attention(attn_val_, q_, k_, v_, scale, window, sink)
+    serial = torch.empty_like(attn_val)
+    llaisys.RuntimeAPI(llaisys.DeviceType.CPU).memcpy_sync(
+        serial.data_ptr(), attn_val_.data_ptr(), serial.numel() * 4, llaisys.MemcpyKind.H2H
+    )
+    torch_self_attention(attn_val, q, k, v, scale, window, sink)
+    assert torch.allclose(serial, attn_val, atol=1e-5, rtol=1e-5)
+
+    for nthread in [3, 0]:
+        llaisys.RuntimeAPI.set_cpu_threads(nthread)
+        llaisys.Ops.self_attention(attn_val_, q_, k_, v_, scale, window, sink)
+        assert check_equal(attn_val_, serial, atol=0, rtol=0)
+    llaisys.RuntimeAPI.set_cpu_threads(0)
+
+
 if __name__ == "__main__":
     import argparse
 
@@ -69,9 +166,20 @@ if __name__ == "__main__":
     parser.add_argument("--profile", action="store_true")
     args = parser.parse_args()
     testShapes = [
-        # qlen, kvlen, nh, nkvh, hd
-        (2, 2, 1, 1, 4),
-        (5, 11, 4, 2, 8),
+        # qlen, kvlen, nh, nkvh, hd, window, sink
+        (2, 2, 1, 1, 4, 0, 0),
+        (5, 11, 4, 2, 8, 0, 0),
+        (5, 11, 4, 2, 8, 4, 0),
+        (5, 11, 4, 2, 8, 3, 2),
+        (1, 20, 4, 2, 8, 6, 4),
+        # specialized kernels: Qwen2 1.5B and 7B layouts, head dims 128 and 64
+        (3, 9, 12, 2, 128, 0, 0),
+        (2, 7, 28, 4, 128, 5, 1),
+        (4, 6, 6, 2, 128, 0, 0),
+        (3, 8, 14, 2, 64, 0, 0),
+        # prefill over several query blocks; the window skips whole K/V tiles
+        (40, 100, 4, 2, 8, 0, 0),
+        (37, 300, 4, 2, 16, 70, 3),
     ]
     testDtypePrec = [
         # type, atol, rtol
@@ -85,5 +193,21 @@ if __name__ == "__main__":
             test_op_self_attention(
                 *shape, dtype_name, atol, rtol, args.device, args.profile
             )
+    testTrees = [
+        # prefix, parents, nh, nkvh, hd
+        (0, [-1], 2, 1, 8),
+        # two draft branches after a shared prefix
+        (5, [-1, 0, 1, 0, 3, 4], 4, 2, 8),
+        # three packed sequences, no prefix
+        (0, [-1, 0, 1, -1, 3, -1, 5, 6, 7], 4, 2, 8),
+        # a 16-token draft chain plus a 24-token branch off its 3rd token,
+        # spanning several query blocks
+        (70, list(range(-1, 15)) + [2] + list(range(16, 39)), 12, 2, 128),
+    ]
+    for tree in testTrees:
+        for dtype_name, atol, rtol in testDtypePrec:
+            test_op_self_attention_tree(*tree, dtype_name, atol, rtol, args.device)
+    if args.device == "cpu":
+        test_op_self_attention_threads(70, 90, 4, 2, 16, 40, 2)
 
     print("\033[92mTest passed!\033[0m\n")
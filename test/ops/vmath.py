@@ -0,0 +1,112 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import zero_tensor, benchmark
+
+# Documented bounds (src/utils/vmath.hpp), in ULP of the float32 result.
+MAX_ULP = {
+    "exp": {"scalar": 1.5, "avx2": 1.5, "avx512": 1.5, "avx512_bf16": 1.5, "avx2_vnni": 1.5, "avx512_vnni": 1.5},
+    "sigmoid": {"scalar": 3, "avx2": 3, "avx512": 3, "avx512_bf16": 3, "avx2_vnni": 3, "avx512_vnni": 3},
+    "silu": {"scalar": 4, "avx2": 4, "avx512": 4, "avx512_bf16": 4, "avx2_vnni": 4, "avx512_vnni": 4},
+    "tanh": {"scalar": 1.5, "avx2": 1.5, "avx512": 1.5, "avx512_bf16": 1.5, "avx2_vnni": 1.5, "avx512_vnni": 1.5},
+    "rsqrt": {"scalar": 1.5, "avx2": 4.5, "avx512": 2.5, "avx512_bf16": 2.5, "avx2_vnni": 4.5, "avx512_vnni": 2.5},
+}
+
+# Inputs within each function's specified domain.
+DOMAINS = {
+    "exp": (-87.0, 88.0),
+    "sigmoid": (-100.0, 100.0),
+    "silu": (-80.0, 80.0),
+    "tanh": (-12.0, 12.0),
+    "rsqrt": (1e-6, 1e6),
+}
+
+
+def reference(fn, x):
+    x = x.double()
+    if fn == "exp":
+        return torch.exp(x)
+    if fn == "sigmoid":
+        return torch.sigmoid(x)
+    if fn == "silu":
+        return x * torch.sigmoid(x)
+    if fn == "tanh":
+        return torch.tanh(x)
+    return torch.rsqrt(x)
+
+
+def sample_inputs(fn, n):
+    lo, hi = DOMAINS[fn]
+    if fn == "rsqrt":
+        # log-uniform, so every binade is covered
+        x = torch.exp(torch.empty(n, dtype=torch.float64).uniform_(torch.log(torch.tensor(lo)), torch.log(torch.tensor(hi))))
+    else:
+        x = torch.empty(n, dtype=torch.float64).uniform_(lo, hi)
+    # include small magnitudes, where tanh and silu switch formulas
+    x[: n // 8] *= 1e-3
+    return x.float()
+
+
+def ulp_error(result, ref):
+    ref32 = ref.float()
+    spacing = torch.nextafter(ref32.abs(), torch.tensor(float("inf"))) - ref32.abs()
+    return ((result.double() - ref).abs() / spacing.double()).max().item()
+
+
+def run(fn, isa, x):
+    x_ = zero_tensor(tuple(x.shape), "f32", "cpu")[1]
+    y_ = zero_tensor(tuple(x.shape), "f32", "cpu")[1]
+    api = llaisys.RuntimeAPI(llaisys.DeviceType.CPU)
+    api.memcpy_sync(x_.data_ptr(), x.data_ptr(), x.numel() * 4, llaisys.MemcpyKind.H2H)
+    if not llaisys.Ops.vmath(y_, x_, fn, isa):
+        return None
+    y = torch.empty_like(x)
+    api.memcpy_sync(y.data_ptr(), y_.data_ptr(), y.numel() * 4, llaisys.MemcpyKind.H2H)
+    return y
+
+
+def test_vmath(fn, n=1 << 20, profile=False):
+    print(f"   {fn}")
+    x = sample_inputs(fn, n)
+    ref = reference(fn, x)
+    scalar = run(fn, "scalar", x)
+    for isa in ["scalar", "avx2", "avx512", "avx512_bf16", "avx2_vnni", "avx512_vnni"]:
+        y = run(fn, isa, x)
+        if y is None:
+            print(f"      {isa}: not supported, skipped")
+            continue
+        err = ulp_error(y, ref)
+        print(f"      {isa}: max {err:.2f} ulp")
+        assert err <= MAX_ULP[fn][isa], f"{fn}/{isa}: {err} ulp"
+        # vector paths agree with the scalar one up to both bounds
+        assert ulp_error(y, scalar.double()) <= MAX_ULP[fn][isa] + MAX_ULP[fn]["scalar"]
+        # tails shorter than a vector give the same result as full vectors
+        tail = run(fn, isa, x[:13].clone())
+        assert torch.equal(tail, y[:13]), f"{fn}/{isa}: tail differs"
+
+    if profile:
+        x_t = x.clone()
+        benchmark(
+            lambda: reference(fn, x_t),
+            lambda: run(fn, "avx512", x_t) or run(fn, "avx2", x_t),
+            "cpu",
+        )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    torch.manual_seed(0)
+    print("Testing vectorized math")
+    for fn in ["exp", "sigmoid", "silu", "tanh", "rsqrt"]:
+        test_vmath(fn, profile=args.profile)
+
+    print("\033[92mTest passed!\033[0m\n")
@@ -0,0 +1,90 @@
+import argparse
+import json
+import os
+import re
+import time
+
+from huggingface_hub import snapshot_download
+
+import llaisys
+from test_utils import llaisys_device
+
+SCHEMA = {
+    "type": "object",
+    "properties": {
+        "name": {"type": "string", "maxLength": 32},
+        "age": {"type": "integer"},
+        "languages": {"type": "array", "items": {"enum": ["Python", "C++", "Rust"]}, "maxItems": 3},
+        "height": {"type": ["number", "null"]},
+        "student": {"type": "boolean"},
+    },
+    "required": ["name", "age", "student"],
+}
+
+PATTERN = r"(19|20)[0-9]{2}-(0[1-9]|1[0-2])-(0[1-9]|[12][0-9]|3[01])"
+
+
+def check_schema(value):
+    assert isinstance(value, dict) and set(value) <= set(SCHEMA["properties"]), value
+    assert isinstance(value["name"], str) and len(value["name"]) <= 32
+    assert isinstance(value["age"], int) and isinstance(value["student"], bool)
+    assert all(lang in ["Python", "C++", "Rust"] for lang in value.get("languages", []))
+    assert value.get("height") is None or isinstance(value["height"], (int, float))
+    # Properties come out in declaration order.
+    assert list(value) == [k for k in SCHEMA["properties"] if k in value]
+
+
+def generate(model, tokenizer, prompt, max_steps, grammar=None, **sampling):
+    inputs = tokenizer.encode(tokenizer.apply_chat_template([{"role": "user", "content": prompt}]))
+    start = time.perf_counter()
+    tokens = model.generate(inputs, max_new_tokens=max_steps, grammar=grammar, **sampling)[len(inputs):]
+    elapsed = time.perf_counter() - start
+    return tokenizer.decode(tokens, skip_special_tokens=True), tokens, elapsed
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--model", default=None, type=str)
+    parser.add_argument("--max_steps", default=96, type=int)
+    args = parser.parse_args()
+
+    model_path = args.model
+    if not (model_path and os.path.isdir(model_path)):
+        model_path = snapshot_download("deepseek-ai/DeepSeek-R1-Distill-Qwen-1.5B")
+
+    tokenizer = llaisys.Tokenizer(model_path)
+    model = llaisys.models.Qwen2(model_path, llaisys_device(args.device))
+    end_token = model.meta.end_token
+
+    start = time.perf_counter()
+    schema = llaisys.Grammar.json_schema(tokenizer, SCHEMA, end_token)
+    print(f"schema grammar: {schema.num_states()} states, compiled in {time.perf_counter() - start:.2f}s")
+    regex = llaisys.Grammar.regex(tokenizer, PATTERN, end_token)
+
+    prompt = "Describe a fictional programmer as JSON with name, age, languages, height and student."
+    greedy = dict(top_k=1, top_p=1.0, temperature=1.0)
+    text, tokens, constrained = generate(model, tokenizer, prompt, args.max_steps, schema, **greedy)
+    constrained_per_token = constrained / len(tokens)
+    print(text)
+    assert tokens[-1] == end_token, "constrained output did not complete within max_steps"
+    check_schema(json.loads(text))
+
+    # Sampling stays inside the language as well.
+    for seed in range(3):
+        text, tokens, _ = generate(model, tokenizer, prompt, args.max_steps, schema,
+                                   top_k=50, top_p=0.9, temperature=1.0, seed=seed)
+        if tokens[-1] == end_token:
+            check_schema(json.loads(text))
+
+    text, tokens, _ = generate(model, tokenizer, "When did the first Moon landing happen? Answer with a date.",
+                               32, regex, **greedy)
+    print(text)
+    assert re.fullmatch(PATTERN, text), text
+
+    # Masking cost per token next to the forward pass.
+    _, free_tokens, free = generate(model, tokenizer, prompt, args.max_steps, **greedy)
+    print(f"unconstrained: {free / len(free_tokens) * 1e3:.1f} ms/token, "
+          f"constrained: {constrained_per_token * 1e3:.1f} ms/token")
+
+    print("\033[92mTest passed!\033[0m\n")
@@ -83,12 +83,18 @@ if __name__ == "__main__":
     parser = argparse.ArgumentParser()
     parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
     parser.add_argument("--model", default=None, type=str)
+    parser.add_argument("--draft_model", default=None, type=str)
+    parser.add_argument("--ndraft", default=4, type=int)
+    parser.add_argument("--prompt_lookup", default=0, type=int, help="max n-gram for prompt-lookup drafting")
+    parser.add_argument("--n", default=1, type=int, help="also sample n completions from one prefill")
     parser.add_argument("--prompt", default="Who are you?", type=str)
     parser.add_argument("--max_steps", default=128, type=int)
     parser.add_argument("--top_p", default=0.8, type=float)
     parser.add_argument("--top_k", default=50, type=int)
     parser.add_argument("--temperature", default=1.0, type=float)
     parser.add_argument("--test", action="store_true")
+    parser.add_argument("--self_check", action="store_true",
+                        help="also check speculative and n-way decoding against plain decoding")
 
     args = parser.parse_args()
 
@@ -123,6 +129,11 @@ if __name__ == "__main__":
     print(f"Time elapsed: {(end_time - start_time):.2f}s\n")
 
     model = load_llaisys_model(model_path, args.device)
+    if args.draft_model:
+        draft_model = load_llaisys_model(args.draft_model, args.device)
+        model.set_draft_model(draft_model, args.ndraft)
+    elif args.prompt_lookup > 0:
+        model.set_prompt_lookup(args.prompt_lookup, args.ndraft)
     start_time = time.time()
     llaisys_tokens, llaisys_output = llaisys_infer(
         args.prompt,
@@ -146,4 +157,72 @@ if __name__ == "__main__":
 
     if args.test:
         assert llaisys_tokens == tokens
+        # Streaming hands over the same tokens from the native decode thread.
+        inputs = tokenizer.encode(
+            tokenizer.apply_chat_template(
+                conversation=[{"role": "user", "content": args.prompt}],
+                add_generation_prompt=True,
+                tokenize=False,
+            )
+        )
+        streamed = list(model.generate_stream(
+            inputs, max_new_tokens=args.max_steps, top_k=top_k, top_p=top_p, temperature=temperature
+        ))
+        assert inputs + streamed == llaisys_tokens
         print("\033[92mTest passed!\033[0m\n")
+
+    if args.n > 1:
+        inputs = tokenizer.encode(
+            tokenizer.apply_chat_template(
+                conversation=[{"role": "user", "content": args.prompt}],
+                add_generation_prompt=True,
+                tokenize=False,
+            )
+        )
+        start_time = time.time()
+        samples = model.generate(
+            inputs,
+            max_new_tokens=args.max_steps,
+            top_k=top_k,
+            top_p=top_p,
+            temperature=temperature,
+            n=args.n,
+        )
+        end_time = time.time()
+        print(f"\n=== {args.n} Samples ===\n")
+        for sample in samples:
+            print(tokenizer.decode(sample, skip_special_tokens=True))
+            print("")
+        print(f"Time elapsed: {(end_time - start_time):.2f}s\n")
+        if args.test:
+            # Greedy branches all reproduce the single-sequence result.
+            assert all(sample == llaisys_tokens for sample in samples)
+
+    # Speculative decoding and n-way sampling only change how tokens are produced,
+    # so --self_check compares them with plain decoding of the same model.
+    if args.self_check:
+        inputs = tokenizer.encode(
+            tokenizer.apply_chat_template(
+                conversation=[{"role": "user", "content": args.prompt}],
+                add_generation_prompt=True,
+                tokenize=False,
+            )
+        )
+        greedy = dict(max_new_tokens=args.max_steps, top_k=1, top_p=1.0, temperature=1.0)
+        model.set_draft_model(None)
+        reference = model.generate(inputs, **greedy)
+
+        if args.draft_model:
+            model.set_draft_model(draft_model, args.ndraft)
+            assert model.generate(inputs, **greedy) == reference
+            model.set_draft_model(None)
+
+        model.set_prompt_lookup(args.prompt_lookup or 3, args.ndraft)
+        assert model.generate(inputs, **greedy) == reference
+        model.set_prompt_lookup(ndraft=0)
+
+        # Branch 0 of an n-way sample reuses the base seed; greedy branches never diverge.
+        sampled = dict(max_new_tokens=args.max_steps, top_k=50, top_p=0.8, temperature=0.8, seed=1234)
+        assert model.generate(inputs, n=3, **sampled)[0] == model.generate(inputs, **sampled)
+        assert all(branch == reference for branch in model.generate(inputs, n=3, **greedy))
+        print("\033[92mSelf-consistency passed!\033[0m\n")
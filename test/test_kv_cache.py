@@ -0,0 +1,87 @@
+import argparse
+import os
+import tempfile
+
+from huggingface_hub import snapshot_download
+
+import llaisys
+from test_utils import sample_tokens
+
+
+def assert_close(actual, expected, what):
+    # Prefill and step-by-step decode only differ in summation order.
+    scale = max(abs(x) for x in expected)
+    error = max(abs(a - b) for a, b in zip(actual, expected))
+    print(f"{what}: max logits error {error:.3g} (max |logit| {scale:.3g})")
+    assert error <= 1e-2 * scale, (what, error)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--model", default=None, type=str)
+    args = parser.parse_args()
+
+    model_path = args.model
+    if not (model_path and os.path.isdir(model_path)):
+        model_path = snapshot_download("deepseek-ai/DeepSeek-R1-Distill-Qwen-1.5B")
+    model = llaisys.models.Qwen2(model_path)
+
+    # 45 tokens end inside the second 32-token KV block, so forks share a
+    # partly filled block and copy it on their first write.
+    inputs = sample_tokens(53)
+    prompt, suffix = inputs[:45], inputs[45:]
+
+    fresh = model.seq_create()
+    expected = model.seq_infer(fresh, inputs, return_logits=True)[1]
+    model.seq_free(fresh)
+
+    parent = model.seq_create()
+    model.seq_infer(parent, prompt)
+    child = model.seq_fork(parent)
+    assert model.seq_length(child) == len(prompt)
+    child_logits = model.seq_infer(child, suffix, return_logits=True)[1]
+    assert model.seq_length(child) == len(inputs)
+    assert model.seq_length(parent) == len(prompt)
+    assert_close(child_logits, expected, "fork")
+
+    # Truncate inside the shared block, then refill it.
+    truncated = model.seq_fork(parent)
+    model.seq_truncate(truncated, 40)
+    assert model.seq_length(truncated) == 40
+    refilled = model.seq_infer(truncated, inputs[40:], return_logits=True)[1]
+    assert_close(refilled, expected, "truncate and refill")
+
+    # Neither fork wrote into the parent's blocks: the parent continues
+    # exactly like the first child did.
+    model.seq_free(child)
+    model.seq_free(truncated)
+    parent_logits = model.seq_infer(parent, suffix, return_logits=True)[1]
+    assert parent_logits == child_logits
+    model.seq_free(parent)
+
+    # Swap round trip, through host memory and through a spill file: another
+    # sequence reuses the freed blocks meanwhile, and the swapped one continues
+    # exactly like one that stayed resident.
+    resident = model.seq_create()
+    model.seq_infer(resident, prompt)
+    expected = model.seq_infer(resident, suffix, return_logits=True)[1]
+    model.seq_free(resident)
+    for spill_file in (None, os.path.join(tempfile.gettempdir(), f"llaisys-spill-{os.getpid()}.bin")):
+        if spill_file:
+            model.set_spill_file(spill_file, 64 << 20)
+            # Scratch space only: unlinked as soon as it is mapped.
+            assert not os.path.exists(spill_file)
+        seq = model.seq_create()
+        model.seq_infer(seq, prompt)
+        assert model.seq_swap_out(seq)
+        assert model.seq_is_swapped(seq)
+        assert model.seq_length(seq) == len(prompt)
+        other = model.seq_create()
+        model.seq_infer(other, inputs)
+        assert model.seq_swap_in(seq)
+        assert not model.seq_is_swapped(seq)
+        assert model.seq_infer(seq, suffix, return_logits=True)[1] == expected
+        model.seq_free(seq)
+        model.seq_free(other)
+
+    print("\033[92mTest passed!\033[0m\n")
@@ -0,0 +1,91 @@
+import argparse
+import json
+import os
+import shutil
+import tempfile
+
+import torch
+from huggingface_hub import snapshot_download
+from safetensors.torch import load_file, save_file
+
+import llaisys
+from test_utils import last_logits, llaisys_device
+
+# PEFT module name -> checkpoint weight suffix of the projection it adapts.
+TARGETS = {
+    "self_attn.q_proj": "self_attn.q_proj.weight",
+    "self_attn.v_proj": "self_attn.v_proj.weight",
+    "mlp.down_proj": "mlp.down_proj.weight",
+}
+
+
+def make_adapter(directory, weights, nlayer, rank, alpha, seed):
+    """Write a random PEFT adapter; returns {weight name: merged weight}."""
+    gen = torch.Generator().manual_seed(seed)
+    tensors, merged = {}, {}
+    for layer in range(nlayer):
+        for module, suffix in TARGETS.items():
+            name = f"model.layers.{layer}.{suffix}"
+            base = weights[name].float()
+            a = torch.randn(rank, base.shape[1], generator=gen) * 0.05
+            b = torch.randn(base.shape[0], rank, generator=gen) * 0.05
+            prefix = f"base_model.model.model.layers.{layer}.{module}"
+            tensors[prefix + ".lora_A.weight"] = a
+            tensors[prefix + ".lora_B.weight"] = b
+            merged[name] = base + (alpha / rank) * (b @ a)
+    save_file(tensors, os.path.join(directory, "adapter_model.safetensors"))
+    with open(os.path.join(directory, "adapter_config.json"), "w") as f:
+        json.dump({"r": rank, "lora_alpha": alpha, "target_modules": ["q_proj", "v_proj", "down_proj"]}, f)
+    return merged
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--model", default=None, type=str)
+    args = parser.parse_args()
+
+    model_path = args.model
+    if not (model_path and os.path.isdir(model_path)):
+        model_path = snapshot_download("deepseek-ai/DeepSeek-R1-Distill-Qwen-1.5B")
+    weights = {}
+    for file in sorted(os.listdir(model_path)):
+        if file.endswith(".safetensors"):
+            weights.update(load_file(os.path.join(model_path, file)))
+
+    device = llaisys_device(args.device)
+    model = llaisys.models.Qwen2(model_path, device)
+    nlayer = model.meta.nlayer
+    inputs = [1, 2, 3, 4, 5, 6, 7, 8]
+    base = torch.tensor(last_logits(model, inputs))
+
+    with tempfile.TemporaryDirectory() as small, tempfile.TemporaryDirectory() as large:
+        # Adapters of different ranks share zero-padded slots.
+        merged = [make_adapter(small, weights, nlayer, 4, 8, 0), make_adapter(large, weights, nlayer, 8, 16, 1)]
+        model.enable_lora(max_adapters=2, max_rank=8)
+        model.load_lora(small, 0)
+        model.load_lora(large, 1)
+
+        for slot in range(2):
+            # Reference: a checkpoint with the adapter merged into its weights.
+            with tempfile.TemporaryDirectory() as merged_path:
+                shutil.copy(os.path.join(model_path, "config.json"), merged_path)
+                checkpoint = {name: merged[slot].get(name, weight).to(weight.dtype).contiguous()
+                              for name, weight in weights.items()}
+                save_file(checkpoint, os.path.join(merged_path, "model.safetensors"))
+                reference = llaisys.models.Qwen2(merged_path, device)
+                expected = torch.tensor(last_logits(reference, inputs))
+                del reference
+
+            model.set_adapter(slot)
+            logits = torch.tensor(last_logits(model, inputs))
+            # Merging rounds W + BA to the model dtype, so compare against the adapter's effect.
+            error = (logits - expected).abs().max().item()
+            effect = (base - expected).abs().max().item()
+            print(f"adapter {slot}: max |lora - merged| {error:.4f}, max |base - merged| {effect:.4f}")
+            assert effect > 0 and error < 0.1 * effect
+
+        model.set_adapter(-1)
+        assert torch.equal(torch.tensor(last_logits(model, inputs)), base), "base model changed after loading adapters"
+
+    print("\033[92mTest passed!\033[0m\n")
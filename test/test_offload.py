@@ -0,0 +1,53 @@
+import argparse
+import os
+import tempfile
+
+from huggingface_hub import snapshot_download
+
+import llaisys
+from test_utils import last_logits, sample_tokens, timed_generate
+
+
+def resident_mb():
+    with open("/proc/self/status") as f:
+        for line in f:
+            if line.startswith("VmRSS:"):
+                return int(line.split()[1]) / 1024
+    return float("nan")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--model", default=None, type=str)
+    parser.add_argument("--offload_dir", default=tempfile.gettempdir(), type=str,
+                        help="where the scratch weight file is created")
+    parser.add_argument("--prefetch", default=2, type=int, help="layers read ahead of compute")
+    parser.add_argument("--max_steps", default=32, type=int)
+    args = parser.parse_args()
+
+    model_path = args.model
+    if not (model_path and os.path.isdir(model_path)):
+        model_path = snapshot_download("deepseek-ai/DeepSeek-R1-Distill-Qwen-1.5B")
+
+    offload_file = os.path.join(args.offload_dir, f"llaisys-offload-{os.getpid()}.bin")
+    before = resident_mb()
+    streamed = llaisys.models.Qwen2(model_path, offload=offload_file, prefetch=args.prefetch)
+    # The scratch file is unlinked as soon as it is mapped.
+    assert not os.path.exists(offload_file)
+
+    inputs = sample_tokens(64)
+    actual = last_logits(streamed, inputs)
+    print(f"resident after a forward with offload: {resident_mb() - before:.0f} MB")
+
+    single = llaisys.models.Qwen2(model_path)
+    # Same kernels over the same bytes: streaming must not change a single bit.
+    expected = last_logits(single, inputs)
+    assert actual == expected
+
+    prompt = inputs[:16]
+    reference, single_time = timed_generate(single, prompt, args.max_steps)
+    tokens, streamed_time = timed_generate(streamed, prompt, args.max_steps)
+    print(f"in memory: {single_time:.2f}s, offloaded (prefetch {args.prefetch}): {streamed_time:.2f}s")
+    assert tokens == reference, (tokens, reference)
+
+    print("\033[92mTest passed!\033[0m\n")
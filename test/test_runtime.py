@@ -18,6 +18,8 @@ def test_basic_runtime_api(device_name: str = "cpu"):
         print("Testing device {i}...")
         api.set_device(i)
         test_memcpy(api, 1024 * 1024)
+        test_async_events(api, 16 * 1024 * 1024)
+        test_host_pool(api)
 
         print("     Passed")
 
@@ -53,6 +55,47 @@ def test_memcpy(api, size_bytes: int):
     torch.testing.assert_close(a, b)
 
 
+def test_async_events(api, size_bytes: int):
+    a = torch.randint(0, 255, (size_bytes,), dtype=torch.uint8, device=torch_device("cpu"))
+    b = torch.zeros_like(a)
+    device_a = api.malloc_device(size_bytes)
+    copy_stream = api.create_stream()
+    compute_stream = api.create_stream()
+    event = api.create_event()
+    assert api.event_query(event), "an event never recorded is complete"
+
+    # a -> device_a on one stream; device_a -> b on another, ordered by the event
+    api.memcpy_async(device_a, a.data_ptr(), size_bytes, llaisys.MemcpyKind.H2D, copy_stream)
+    api.event_record(event, copy_stream)
+    api.stream_wait_event(compute_stream, event)
+    api.memcpy_async(b.data_ptr(), device_a, size_bytes, llaisys.MemcpyKind.D2H, compute_stream)
+    api.stream_synchronize(compute_stream)
+    assert api.event_query(event)
+    torch.testing.assert_close(a, b)
+
+    # the host waits on the event alone
+    b.zero_()
+    api.memcpy_async(b.data_ptr(), a.data_ptr(), size_bytes, llaisys.MemcpyKind.H2H, copy_stream)
+    api.event_record(event, copy_stream)
+    api.event_synchronize(event)
+    assert api.event_query(event)
+    torch.testing.assert_close(a, b)
+
+    api.destroy_event(event)
+    api.destroy_stream(compute_stream)
+    api.destroy_stream(copy_stream)
+    api.free_device(device_a)
+
+
+def test_host_pool(api):
+    # Staging buffers come from the pool; configuring and trimming it must
+    # leave transfers working.
+    api.configure_host_pool(64 * 1024 * 1024, lock_pages=True)
+    test_async_events(api, 1024 * 1024)
+    api.trim_host_pool()
+    test_memcpy(api, 1024 * 1024)
+
+
 if __name__ == "__main__":
     parser = argparse.ArgumentParser()
     parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
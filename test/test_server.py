@@ -0,0 +1,130 @@
+import argparse
+import http.client
+import json
+import os
+import subprocess
+import sys
+import threading
+
+from huggingface_hub import snapshot_download
+from transformers import AutoTokenizer
+
+
+def find_server():
+    for root, _, files in os.walk("build"):
+        if "llaisys-server" in files:
+            return os.path.join(root, "llaisys-server")
+    return None
+
+
+def start_server(binary, model_path, device_name, max_running):
+    proc = subprocess.Popen(
+        [binary, "--model", model_path, "--port", "0", "--device", device_name,
+         "--max-running", str(max_running)],
+        stdout=subprocess.PIPE,
+        text=True,
+    )
+    line = proc.stdout.readline()
+    assert "listening on" in line, f"server did not start: {line!r}"
+    return proc, int(line.strip().rsplit(":", 1)[1])
+
+
+def post(port, path, body):
+    conn = http.client.HTTPConnection("127.0.0.1", port, timeout=600)
+    conn.request("POST", path, json.dumps(body), {"Content-Type": "application/json"})
+    resp = conn.getresponse()
+    data = resp.read().decode()
+    conn.close()
+    return resp.status, data
+
+
+def complete(port, prompt, max_tokens, **extra):
+    body = {"prompt": prompt, "max_tokens": max_tokens, "temperature": 1.0, "top_k": 1}
+    body.update(extra)
+    status, data = post(port, "/v1/completions", body)
+    assert status == 200, data
+    choice = json.loads(data)["choices"][0]
+    return choice["token_ids"], choice["finish_reason"], choice["text"]
+
+
+def complete_stream(port, prompt, max_tokens):
+    body = {"prompt": prompt, "max_tokens": max_tokens, "temperature": 1.0, "top_k": 1,
+            "stream": True, "stream_options": {"include_usage": True}}
+    status, data = post(port, "/v1/completions", body)
+    assert status == 200, data
+    events = [line[len("data: "):] for line in data.split("\n") if line.startswith("data: ")]
+    assert events[-1] == "[DONE]"
+    chunks = [json.loads(e) for e in events[:-1]]
+    tokens = [t for c in chunks for choice in c["choices"] for t in choice["token_ids"]]
+    # Text deltas hold whole characters only and add up to the full completion.
+    text = "".join(choice["text"] for c in chunks for choice in c["choices"])
+    usage = chunks[-1]["usage"]
+    assert usage["completion_tokens"] == len(tokens)
+    return tokens, chunks[-2]["choices"][0]["finish_reason"], text
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--model", default=None, type=str)
+    parser.add_argument("--server", default=None, type=str, help="path to the llaisys-server binary")
+    parser.add_argument("--max_steps", default=32, type=int)
+    args = parser.parse_args()
+
+    model_path = args.model
+    if not (model_path and os.path.isdir(model_path)):
+        model_path = snapshot_download("deepseek-ai/DeepSeek-R1-Distill-Qwen-1.5B")
+    binary = args.server or find_server()
+    if binary is None:
+        sys.exit("llaisys-server not found; build it with xmake or pass --server")
+
+    tokenizer = AutoTokenizer.from_pretrained(model_path, trust_remote_code=True)
+    prompts = [
+        tokenizer.encode(
+            tokenizer.apply_chat_template(
+                conversation=[{"role": "user", "content": text}],
+                add_generation_prompt=True,
+                tokenize=False,
+            )
+        )
+        for text in ["Who are you?", "Write a haiku about the sea.", "What is 17 * 23?", "Name three colors."]
+    ]
+
+    proc, port = start_server(binary, model_path, args.device, max_running=len(prompts))
+    try:
+        conn = http.client.HTTPConnection("127.0.0.1", port)
+        conn.request("GET", "/health")
+        assert conn.getresponse().status == 200
+        conn.close()
+
+        # Sequential greedy baseline; streaming must produce the same tokens.
+        expected = [complete(port, p, args.max_steps) for p in prompts]
+        for p, (tokens, reason, text) in zip(prompts, expected):
+            assert complete_stream(port, p, args.max_steps) == (tokens, reason, text)
+            print(text)
+
+        # Concurrent requests are batched by the scheduler and must not change the result.
+        results = [None] * len(prompts)
+
+        def worker(i):
+            results[i] = complete(port, prompts[i], args.max_steps)
+
+        threads = [threading.Thread(target=worker, args=(i,)) for i in range(len(prompts))]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        assert results == expected
+
+        # Malformed requests are rejected without disturbing the engine.
+        assert post(port, "/v1/completions", {"prompt": [], "max_tokens": 4})[0] == 400
+        assert post(port, "/v1/completions", {"prompt": prompts[0], "max_tokens": 0})[0] == 400
+        assert post(port, "/v1/completions", {"prompt": prompts[0], "n": 2})[0] == 400
+        status, _ = post(port, "/v1/completions", {"prompt": [10**9]})
+        assert status == 400
+        assert complete(port, prompts[0], args.max_steps) == expected[0]
+    finally:
+        proc.terminate()
+        proc.wait()
+
+    print("\033[92mTest passed!\033[0m\n")
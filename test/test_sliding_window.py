@@ -0,0 +1,70 @@
+import argparse
+import os
+
+from huggingface_hub import snapshot_download
+
+import llaisys
+from test_utils import sample_tokens
+
+
+def chunked_logits(model, inputs, chunk):
+    """Logits after each `chunk` tokens, feeding them `chunk` at a time."""
+    seq = model.seq_create()
+    try:
+        return [
+            model.seq_infer(seq, inputs[i : i + chunk], return_logits=True)[1]
+            for i in range(0, len(inputs), chunk)
+        ]
+    finally:
+        model.seq_free(seq)
+
+
+def stepped_logits(model, inputs, chunk):
+    """The same rows as chunked_logits, feeding one token at a time."""
+    seq = model.seq_create()
+    try:
+        rows = []
+        for i, token in enumerate(inputs):
+            logits = model.seq_infer(seq, [token], return_logits=True)[1]
+            if (i + 1) % chunk == 0 or i + 1 == len(inputs):
+                rows.append(logits)
+        return rows
+    finally:
+        model.seq_free(seq)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--model", default=None, type=str)
+    parser.add_argument("--max_steps", default=64, type=int)
+    args = parser.parse_args()
+
+    model_path = args.model
+    if not (model_path and os.path.isdir(model_path)):
+        model_path = snapshot_download("deepseek-ai/DeepSeek-R1-Distill-Qwen-1.5B")
+    model = llaisys.models.Qwen2(model_path)
+
+    # Long enough to evict several KV blocks past the window.
+    inputs = sample_tokens(200)
+    for window, sink in [(40, 1), (48, 4), (40, 33)]:
+        model.set_sliding_window(window, sink)
+        for chunk in (37, 64):
+            # Chunks evict at different points than single tokens; the sinks'
+            # positions must not depend on that.
+            chunked = chunked_logits(model, inputs, chunk)
+            stepped = stepped_logits(model, inputs, chunk)
+            scale = max(abs(x) for row in stepped for x in row)
+            error = max(abs(a - b) for ra, rb in zip(chunked, stepped) for a, b in zip(ra, rb))
+            print(f"window {window} sink {sink} chunk {chunk}: max logits error {error:.3g} (max |logit| {scale:.3g})")
+            assert error <= 1e-2 * scale, error
+
+    # Prompt-lookup drafts verify several tokens per forward: same greedy stream.
+    model.set_sliding_window(40, 1)
+    prompt = inputs[:48]
+    greedy = dict(max_new_tokens=args.max_steps, top_k=1, top_p=1.0, temperature=1.0)
+    reference = model.generate(prompt, **greedy)
+    model.set_prompt_lookup(3, 8)
+    tokens = model.generate(prompt, **greedy)
+    assert tokens == reference, (tokens, reference)
+
+    print("\033[92mTest passed!\033[0m\n")
@@ -0,0 +1,43 @@
+import argparse
+import os
+
+from huggingface_hub import snapshot_download
+
+import llaisys
+from test_utils import last_logits, sample_tokens, timed_generate
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--model", default=None, type=str)
+    parser.add_argument("--device-ids", default="0,0", type=str,
+                        help="NUMA node of each tensor-parallel rank or pipeline stage")
+    parser.add_argument("--parallel", default="tensor", choices=["tensor", "pipeline"], type=str)
+    parser.add_argument("--max_steps", default=32, type=int)
+    args = parser.parse_args()
+
+    model_path = args.model
+    if not (model_path and os.path.isdir(model_path)):
+        model_path = snapshot_download("deepseek-ai/DeepSeek-R1-Distill-Qwen-1.5B")
+    device_ids = [int(i) for i in args.device_ids.split(",")]
+
+    single = llaisys.models.Qwen2(model_path)
+    parallel = llaisys.models.Qwen2(model_path, device_ids=device_ids, parallel=args.parallel)
+
+    # Long enough to span several tensor-parallel rounds or pipeline micro-batches.
+    inputs = sample_tokens(600 if single.meta.maxseq > 700 else 64)
+    expected = last_logits(single, inputs)
+    actual = last_logits(parallel, inputs)
+    # Only the summation order of o_proj / down_proj differs (tensor parallel).
+    scale = max(abs(x) for x in expected)
+    error = max(abs(a - b) for a, b in zip(actual, expected))
+    print(f"max logits error {error:.3g} (max |logit| {scale:.3g})")
+    assert error <= 1e-2 * scale, error
+
+    prompt = inputs[:16]
+    reference, single_time = timed_generate(single, prompt, args.max_steps)
+    tokens, parallel_time = timed_generate(parallel, prompt, args.max_steps)
+    print(f"1 device: {single_time:.2f}s, {len(device_ids)} devices ({args.parallel}): {parallel_time:.2f}s")
+    assert tokens == reference, (tokens, reference)
+
+    print("\033[92mTest passed!\033[0m\n")
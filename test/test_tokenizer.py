@@ -0,0 +1,94 @@
+import argparse
+import os
+import time
+from pathlib import Path
+
+from huggingface_hub import snapshot_download
+from transformers import AutoTokenizer
+
+import llaisys
+
+SAMPLES = [
+    "Who are you?",
+    "Hello, world! I'm fine; you'll see. WE'VE DONE IT.",
+    "  leading spaces, trailing spaces   \n\n\ttabs\r\nand CRLF\n",
+    "数字 12345 和 3.14159，还有中文标点。",
+    "Здравствуй, мир! Ünïcödé façade — “quotes” … ½ Ⅻ",
+    "emoji 🙂🚀👩‍👩‍👧 and combining é",
+    "def f(x):\n    return x ** 2  # comment\n",
+    "<|im_start|>user\nspecial tokens inline<|im_end|>\n<|endoftext|>",
+    "",
+]
+
+
+def corpus():
+    # Real-world text: the repository's own docs and sources.
+    root = Path(__file__).resolve().parent.parent
+    texts = list(SAMPLES)
+    for pattern in ["*.md", "src/**/*.hpp", "src/**/*.cpp", "python/**/*.py"]:
+        for path in sorted(root.glob(pattern)):
+            texts.append(path.read_text(encoding="utf-8", errors="replace"))
+    return texts
+
+
+def throughput(encode, texts, repeat):
+    nbytes = sum(len(t.encode()) for t in texts) * repeat
+    start = time.perf_counter()
+    for _ in range(repeat):
+        for text in texts:
+            encode(text)
+    return nbytes / (time.perf_counter() - start) / 1e6
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--model", default=None, type=str)
+    parser.add_argument("--repeat", default=3, type=int)
+    args = parser.parse_args()
+
+    model_path = args.model
+    if not (model_path and os.path.isdir(model_path)):
+        model_path = snapshot_download("deepseek-ai/DeepSeek-R1-Distill-Qwen-1.5B")
+
+    hf = AutoTokenizer.from_pretrained(model_path, trust_remote_code=True)
+    native = llaisys.Tokenizer(model_path)
+
+    texts = corpus()
+    for text in texts:
+        expected = hf.encode(text)
+        tokens = native.encode(text)
+        assert tokens == expected, f"encode mismatch on {text[:60]!r}"
+        assert native.decode(tokens) == hf.decode(expected)
+        assert native.decode(tokens, skip_special_tokens=True) == hf.decode(expected, skip_special_tokens=True)
+
+        # Streaming: pieces are whole characters and add up to the full decode.
+        detokenizer = llaisys.Detokenizer(native)
+        pieces = [detokenizer.push(t) for t in tokens] + [detokenizer.flush()]
+        assert "".join(pieces) == hf.decode(expected, skip_special_tokens=True)
+        assert "\ufffd" not in "".join(pieces) or "\ufffd" in text
+
+    conversation = [
+        {"role": "system", "content": "Answer briefly."},
+        {"role": "user", "content": "Who are you?"},
+        {"role": "assistant", "content": "<think>\nthinking\n</think>\n\nAn assistant."},
+        {"role": "user", "content": "What is 17 * 23?"},
+    ]
+    for messages in [conversation[1:2], conversation]:
+        expected = hf.apply_chat_template(conversation=messages, add_generation_prompt=True, tokenize=False)
+        assert native.apply_chat_template(messages) == expected, native.apply_chat_template(messages)
+    # A multi-byte character whose bytes arrive over several tokens.
+    detokenizer = llaisys.Detokenizer(native)
+    pieces = [detokenizer.push(t) for t in native.encode("🙂🚀 中文")]
+    assert "".join(pieces) + detokenizer.flush() == "🙂🚀 中文"
+    truncated = native.encode("🙂")[:-1]
+    if truncated:
+        assert [detokenizer.push(t) for t in truncated] == [""] * len(truncated)
+        assert detokenizer.flush() == "\ufffd"
+    print(f"{len(texts)} texts and chat templates match the HuggingFace tokenizer")
+
+    hf_mbps = throughput(hf.encode, texts, args.repeat)
+    native_mbps = throughput(native.encode, texts, args.repeat)
+    print(f"HuggingFace encode: {hf_mbps:.2f} MB/s")
+    print(f"llaisys encode:     {native_mbps:.2f} MB/s ({native_mbps / hf_mbps:.1f}x)")
+
+    print("\033[92mTest passed!\033[0m\n")
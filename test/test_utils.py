@@ -183,6 +183,29 @@ def benchmark(torch_func, llaisys_func, device_name, warmup=10, repeat=100):
     )
 
 
+def last_logits(model, inputs):
+    """Logits after prefilling `inputs` into a fresh sequence of a Qwen2 model."""
+    seq = model.seq_create()
+    try:
+        return model.seq_infer(seq, inputs, return_logits=True)[1]
+    finally:
+        model.seq_free(seq)
+
+
+def sample_tokens(n):
+    """`n` deterministic token ids spread over [1, 5000], as model test inputs."""
+    return [(i * 7919) % 5000 + 1 for i in range(n)]
+
+
+def timed_generate(model, inputs, max_steps):
+    """Greedy generate; returns (tokens, seconds)."""
+    import time
+
+    start = time.perf_counter()
+    tokens = model.generate(inputs, max_new_tokens=max_steps, top_k=1, top_p=1.0, temperature=1.0)
+    return tokens, time.perf_counter() - start
+
+
 def torch_device(device_name: str, device_id=0):
     if device_name == "cpu":
         return torch.device("cpu")
@@ -219,10 +242,14 @@ def torch_dtype(dtype_name: str):
         return torch.float64
     elif dtype_name == "bf16":
         return torch.bfloat16
+    elif dtype_name == "i8":
+        return torch.int8
     elif dtype_name == "i32":
         return torch.int32
     elif dtype_name == "i64":
         return torch.int64
+    elif dtype_name == "u8":
+        return torch.uint8
     elif dtype_name == "u32":
         return torch.uint32
     elif dtype_name == "u64":
@@ -242,10 +269,14 @@ def llaisys_dtype(dtype_name: str):
         return llaisys.DataType.F64
     elif dtype_name == "bf16":
         return llaisys.DataType.BF16
+    elif dtype_name == "i8":
+        return llaisys.DataType.I8
     elif dtype_name == "i32":
         return llaisys.DataType.I32
     elif dtype_name == "i64":
         return llaisys.DataType.I64
+    elif dtype_name == "u8":
+        return llaisys.DataType.U8
     elif dtype_name == "u32":
         return llaisys.DataType.U32
     elif dtype_name == "u64":
@@ -265,10 +296,14 @@ def dtype_name(llaisys_dtype: llaisys.DataType):
         return "f64"
     elif llaisys_dtype == llaisys.DataType.BF16:
         return "bf16"
+    elif llaisys_dtype == llaisys.DataType.I8:
+        return "i8"
     elif llaisys_dtype == llaisys.DataType.I32:
         return "i32"
     elif llaisys_dtype == llaisys.DataType.I64:
         return "i64"
+    elif llaisys_dtype == llaisys.DataType.U8:
+        return "u8"
     elif llaisys_dtype == llaisys.DataType.U32:
         return "u32"
     elif llaisys_dtype == llaisys.DataType.U64:
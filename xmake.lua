@@ -95,6 +95,37 @@ target("llaisys-ops")
     on_install(function (target) end)
 target_end()
 
+target("llaisys-tokenizer")
+    set_kind("static")
+    add_deps("llaisys-utils")
+
+    set_languages("cxx17")
+    set_warnings("all", "error")
+    if not is_plat("windows") then
+        add_cxflags("-fPIC", "-Wno-unknown-pragmas")
+    end
+
+    add_files("src/tokenizer/*.cpp")
+
+    on_install(function (target) end)
+target_end()
+
+target("llaisys-models")
+    set_kind("static")
+    add_deps("llaisys-tensor")
+    add_deps("llaisys-ops")
+
+    set_languages("cxx17")
+    set_warnings("all", "error")
+    if not is_plat("windows") then
+        add_cxflags("-fPIC", "-Wno-unknown-pragmas")
+    end
+
+    add_files("src/models/*/*.cpp")
+
+    on_install(function (target) end)
+target_end()
+
 target("llaisys")
     set_kind("shared")
     add_deps("llaisys-utils")
@@ -102,10 +133,13 @@ target("llaisys")
     add_deps("llaisys-core")
     add_deps("llaisys-tensor")
     add_deps("llaisys-ops")
+    add_deps("llaisys-models")
+    add_deps("llaisys-tokenizer")
 
     set_languages("cxx17")
     set_warnings("all", "error")
     add_files("src/llaisys/*.cc")
+    add_files("src/llaisys/*/*.cc")
     set_installdir(".")
 
     
@@ -122,4 +156,25 @@ target("llaisys")
             os.cp("lib/*.dylib", "python/llaisys/libllaisys/")
         end
     end)
-target_end()
\ No newline at end of file
+target_end()
+-- OpenAI-compatible HTTP server (POSIX sockets) --
+if not is_plat("windows") then
+    target("llaisys-server")
+        set_kind("binary")
+        add_deps("llaisys-utils")
+        add_deps("llaisys-device")
+        add_deps("llaisys-core")
+        add_deps("llaisys-tensor")
+        add_deps("llaisys-ops")
+        add_deps("llaisys-models")
+        add_deps("llaisys-tokenizer")
+
+        set_languages("cxx17")
+        set_warnings("all", "error")
+        add_syslinks("pthread")
+
+        add_files("src/server/*.cpp")
+
+        on_install(function (target) end)
+    target_end()
+end